@@ -39,6 +39,16 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    18/06/2023      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           the drone board link is received by DMA and the communication   |
+ * |                                                                    task sleeps until it has work.                                  |
+ * |    17/10/2026      1.2.0           agent                           messages to and from the drone board are COBS frames with       |
+ * |                                                                    sequence number and CRC sent by DMA.                            |
+ * |    17/10/2026      1.3.0           agent                           the messages to and from the drone board are packed in scaled   |
+ * |                                                                    integers with comm_pack.h                                       |
+ * |    17/10/2026      1.4.0           agent                           Task_RCComm sleeps until the radio or the telemetry queue       |
+ * |                                                                    notifies it.                                                    |
+ * |    17/10/2026      1.5.0           agent                           the remote control communication task sends the quality of the  |
+ * |                                                                    link every RC_COMM_LINK_PERIOD_MS.                              |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -146,6 +156,38 @@
 */
 #define QUEUE_DRONE_TO_APP_DATA_LEN   40
 
+/************************************************************************/
+/**
+ * @brief: longest time the drone board communication task sleeps without being notified in milli seconds
+*/
+#define DRONE_COMM_MAX_SLEEP_MS   1000
+
+/**
+ * @brief: longest time the remote control communication task sleeps without being notified in milli seconds, it bounds
+ *         the delay of a missed edge of the IRQ pin of the radio
+*/
+#define RC_COMM_MAX_SLEEP_MS   20
+
+/**
+ * @brief: period of the link quality messages sent to the remote control in milli seconds
+*/
+#define RC_COMM_LINK_PERIOD_MS   1000
+
+/**
+ * @brief: size of the chunks the received bytes are read in
+*/
+#define DRONE_COMM_REC_CHUNK_LEN   32
+
+/**
+ * @brief: number of messages handed to the DMA transmitter at once, must not be more than its queue (MCAL_UART_TX_QUEUE_LEN)
+*/
+#define DRONE_COMM_TX_FRAMES   3
+
+/**
+ * @brief: window over which the idle time of the CPU is measured in micro seconds (refer to 'global_u16IdlePermille')
+*/
+#define CPU_LOAD_WINDOW_US   1000000
+
 /******************************************************************************
  * Module Preprocessor Macros
  *******************************************************************************/
@@ -199,15 +241,37 @@ RTOS_TaskHandle_t task_DroneComm_Handle_t;
 
 /************************************************************************/
 /**
- * @brief: strcut through which we will communicate with Drone board 
+ * @brief: decoder of the frames received from the drone board (refer to "comm_frame.h")
 */
-HAL_WRAPPER_AppCommMsg_t global_DroneCommMsg_t = {0};
+LIB_COMM_FRAME_Decoder_t global_CommRxDecoder_t = {0};
+
+/**
+ * @brief: last keyframe of the telemetry received from the drone board, applies the messages carrying only what changed (refer to "comm_pack.h")
+*/
+LIB_COMM_PACK_InfoState_t global_CommRxInfo_t = {0};
 
 /**
  * @brief: actual place where the received data will be placed
  */
 DroneToAppDataItem_t global_MsgToRec_t = {0};
 
+/**
+ * @brief: time spent in the idle task over the last CPU_LOAD_WINDOW_US in 1/1000 (from the RTOS run time stats)
+ */
+volatile uint16_t global_u16IdlePermille = 0;
+
+/**
+ * @brief: encoded messages to the drone board and the frames sending them, the DMA sends each message from here while the next ones are
+ *         taken from the queue, a frame is free again when it's not HAL_WRAPPER_CommFrame_t::status MCAL_UART_STAT_PENDING
+ */
+uint8_t global_u8CommTxBuffer[DRONE_COMM_TX_FRAMES][COMM_FRAME_MOVE_LEN] = {0};
+HAL_WRAPPER_CommFrame_t global_CommTxFrame_t[DRONE_COMM_TX_FRAMES] = {0};
+
+/**
+ * @brief: bytes sent to the drone board per second over the last CPU_LOAD_WINDOW_US
+ */
+volatile uint32_t global_u32CommTxBytesPerSec = 0;
+
 /******************************************************************************
  * Function Prototypes
  *******************************************************************************/
@@ -217,52 +281,58 @@ DroneToAppDataItem_t global_MsgToRec_t = {0};
  *******************************************************************************/
 
 /************************************************************************/
-void UARTReceivedISR(void)
+void UARTReceivedFrames(void)
 {
-    static uint8_t local_u8MsgType = DATA_TYPE_INVALID;
-    static uint16_t local_u16CurrentItem = 0;
-    static HAL_WRAPPER_ErrStat_t local_errState = HAL_WRAPPER_STAT_OK;
-    static uint8_t local_u8Dummy = 0;
-
-    // see if there is anything to receive
-    local_errState = HAL_WRAPPER_GetCommMessage(&local_u8Dummy);
-
-    if(HAL_WRAPPER_STAT_OK == local_errState)
+    uint8_t local_u8Chunk[DRONE_COMM_REC_CHUNK_LEN] = {0};
+    uint16_t local_u16ChunkLen = 0;
+    const uint8_t* local_pu8Payload = NULL;
+    uint16_t local_u16PayloadLen = 0;
+    LIB_COMM_PACK_Info_t local_Info_t = {0};
+    uint16_t i = 0;
+
+    // take everything the DMA received up to the end of the last burst
+    while(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_GetCommFrame(local_u8Chunk, sizeof(local_u8Chunk), &local_u16ChunkLen))
     {
-        if(0 == global_DroneCommMsg_t.dataIsToReceive)
+        for(i = 0; i < local_u16ChunkLen; i++)
         {
-            // check if the received byte is of correct type
-            local_u8MsgType = local_u8Dummy;
-            if(DATA_TYPE_INFO == local_u8MsgType)
-            {
-                local_u16CurrentItem = 1;
-                global_DroneCommMsg_t.dataIsToReceive = 1;
-                *global_DroneCommMsg_t.dataToReceive = local_u8MsgType;
-            }
-            else
+            // the frames are checked by their CRC, a corrupted one is dropped and the next one is received normally
+            if(0 == LIB_COMM_FRAME_u8Decode(&global_CommRxDecoder_t, local_u8Chunk[i]))
             {
-                // invalid header, discard
+                continue;
             }
 
-        }
-        else
-        {
-            // stare data in the variable
-            *(global_DroneCommMsg_t.dataToReceive + local_u16CurrentItem) = local_u8Dummy;
-            local_u16CurrentItem++;
-
-            // check if we reached the correct length of the message to receive
-            if(local_u16CurrentItem == global_DroneCommMsg_t.dataToReceiveLen)
+            local_pu8Payload = LIB_COMM_FRAME_pu8Payload(&global_CommRxDecoder_t, &local_u16PayloadLen);
+            if(0 == LIB_COMM_PACK_u8UnpackInfo(&global_CommRxInfo_t, local_pu8Payload, local_u16PayloadLen, &local_Info_t))
             {
-                global_DroneCommMsg_t.IsDataReceived = 1;
+                // valid frame of a message this board doesn't expect or of a keyframe that was lost, discard
+                continue;
             }
+
+            // append the new received message to the queue
+            global_MsgToRec_t.data.type = DATA_TYPE_INFO;
+            global_MsgToRec_t.data.data.info.distanceToOrigin = local_Info_t.distanceToOrigin;
+            global_MsgToRec_t.data.data.info.altitude = local_Info_t.altitude;
+            global_MsgToRec_t.data.data.info.temperature = local_Info_t.temperature;
+            global_MsgToRec_t.data.data.info.batteryCharge = local_Info_t.batteryCharge;
+            SERVICE_RTOS_AppendToBlockingQueue(0, (const void *) &global_MsgToRec_t, queue_DroneCommToApp_Handle_t);
+            SERVICE_RTOS_Notify(task_RCComm_Handle_t, LIB_CONSTANTS_DISABLED);
         }
     }
 }
 
+/************************************************************************/
+/**
+ * @brief: called from the DMA interrupt when a message is sent, wakes the communication task to send the next ones
+*/
+void UARTFrameSent(HAL_WRAPPER_CommFrame_t* arg_pFrame)
+{
+    SERVICE_RTOS_Notify(task_DroneComm_Handle_t, LIB_CONSTANTS_ENABLED);
+}
+
 /************************************************************************/
 /**
  * @brief: this task is responsible for the communication with the remote control
+ * @note: it sleeps until the radio needs it or telemetry is queued to be sent
 */
 void Task_RCComm(void)
 {   
@@ -271,14 +341,22 @@ void Task_RCComm(void)
     uint8_t local_u8LenOfRemaining = 0;
     AppToDroneDataItem_t local_itemToRec_t = {0};
     DroneToAppDataItem_t local_itemToSend_t = {0};
+    uint32_t local_u32Now = 0;
+    uint32_t local_u32LastLink = 0;
+
+    // the IRQ pin of the radio wakes this task when a packet is received, sent or lost
+    HAL_WRAPPER_SetRCTask(task_RCComm_Handle_t);
 
     while (1)
     {
         // TODO: make a timer every 10 seconds to check if we received anything to switch to landing mode 
 
-        // check if there is anything to receive from nrf module
-        local_errState = HAL_WRAPPER_RCReceive(&local_RCData_t);
-        if(HAL_WRAPPER_STAT_OK == local_errState)
+        // wait for the radio or the drone communication task having telemetry to send
+        SERVICE_RTOS_WaitForNotification(RC_COMM_MAX_SLEEP_MS);
+        HAL_WRAPPER_RCService();
+
+        // take all the commands received from nrf module
+        while(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_RCReceive(&local_RCData_t))
         {
             // TODO: comment the below line
              printf("Roll: %d, Pitch: %d, Thrust: %d, Yaw: %d, LEDs: %d, Music: %d\r\n",
@@ -332,83 +410,107 @@ void Task_RCComm(void)
             HAL_WRAPPER_RCSend(&local_RCData_t);
         }
 
-
-        // sleep for 5 ms
-//        SERVICE_RTOS_BlockFor(1);
+        // report the quality of the link to the remote control
+        SERVICE_RTOS_CurrentUSTime(&local_u32Now);
+        if((uint32_t)(local_u32Now - local_u32LastLink) >= (RC_COMM_LINK_PERIOD_MS * 1000UL))
+        {
+            if(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_RCSendLink())
+                local_u32LastLink = local_u32Now;
+        }
     }
 }
 
 /************************************************************************/
 /**
  * @brief: this task is responsible for communication with the drone board 
- * @note: it has no delay so it will running instead of the idle task
+ * @note: it sleeps until a message is queued to be sent or the drone board sends something
 */
 void Task_DroneComm(void)
 {
     
     SERVICE_RTOS_ErrStat_t local_RTOSErrStatus = SERVICE_RTOS_STAT_OK;
-    AppToDroneDataItem_t local_MsgToSend_t = {0};
+    
     uint8_t local_u8LenOfRemaining = 0;
+    uint8_t local_u8NextFrame = 0;
+    uint8_t local_u8TxSeq = 0;
+    AppToDroneDataItem_t local_MsgToSend_t = {0};
+    LIB_COMM_PACK_Move_t local_Move_t = {0};
+    uint8_t local_u8Payload[LIB_COMM_PACK_MOVE_LEN] = {0};
+    HAL_WRAPPER_CommFrame_t* local_pFrame = NULL;
+    HAL_WRAPPER_CommTxStats_t local_TxStats_t = {0};
+    uint32_t local_u32WindowTxBytes = 0;
+
+    // idle time measurement
+    uint32_t local_u32IdleUS = 0;
+    uint32_t local_u32TotalUS = 0;
+    uint32_t local_u32WindowIdleUS = 0;
+    uint32_t local_u32WindowStartUS = 0;
+
+    // each frame always sends its own buffer
+    for(local_u8NextFrame = 0; local_u8NextFrame < DRONE_COMM_TX_FRAMES; local_u8NextFrame++)
+    {
+        global_CommTxFrame_t[local_u8NextFrame].data = global_u8CommTxBuffer[local_u8NextFrame];
+        global_CommTxFrame_t[local_u8NextFrame].callBack = UARTFrameSent;
+    }
+    local_u8NextFrame = 0;
 
-    // assign pointers and lengths of data to be always sent
-    global_DroneCommMsg_t.dataToSend = (uint8_t*)&local_MsgToSend_t;
-    global_DroneCommMsg_t.dataToSendLen = sizeof(local_MsgToSend_t);
+    // the DMA receiver wakes this task when the drone board stops sending
+    HAL_WRAPPER_SetAppCommRecTask(task_DroneComm_Handle_t);
+
+    SERVICE_RTOS_GetIdleTime(&local_u32WindowIdleUS, &local_u32WindowStartUS);
 
     while (1)
     {
-        // // wait for notification
-        // SERVICE_RTOS_WaitForNotification(1000);
-
-        // check if there is anything in the queue to be sent
-        local_RTOSErrStatus = SERVICE_RTOS_ReadFromBlockingQueue(0, (void *) &local_MsgToSend_t, queue_AppCommToDrone_Handle_t, &local_u8LenOfRemaining);
+        // wait for notification from the task producing the messages to send, the receiver or the transmitter
+        SERVICE_RTOS_WaitForNotification(DRONE_COMM_MAX_SLEEP_MS);
 
-        // loop until all message are sent
-        while (local_u8LenOfRemaining && SERVICE_RTOS_STAT_OK == local_RTOSErrStatus)
+        // hand the queued messages to the transmitter while it has free frames, they are used in order so the messages are sent in order
+        local_pFrame = &global_CommTxFrame_t[local_u8NextFrame];
+        while (MCAL_UART_STAT_PENDING != local_pFrame->status)
         {
+            local_RTOSErrStatus = SERVICE_RTOS_ReadFromBlockingQueue(0, (void *) &local_MsgToSend_t, queue_AppCommToDrone_Handle_t, &local_u8LenOfRemaining);
+            if(SERVICE_RTOS_STAT_OK != local_RTOSErrStatus || 0 == local_u8LenOfRemaining)
+            {
+                break;
+            }
+
+            // pack the setpoints in scaled integers and encode the message straight into the buffer of the frame
+            local_Move_t.roll = local_MsgToSend_t.roll;
+            local_Move_t.pitch = local_MsgToSend_t.pitch;
+            local_Move_t.thrust = local_MsgToSend_t.thrust;
+            local_Move_t.yaw = local_MsgToSend_t.yaw;
+            local_Move_t.flags = local_MsgToSend_t.startDrone ? LIB_COMM_PACK_FLAG_START : 0;
+            LIB_COMM_PACK_u8PackMove(&local_Move_t, local_u8Payload);
+            local_pFrame->dataLen = LIB_COMM_FRAME_u16Encode(local_u8TxSeq++, local_u8Payload, LIB_COMM_PACK_MOVE_LEN, global_u8CommTxBuffer[local_u8NextFrame]);
 
-            // send the message
-            size_t i = 0;
-            while (i < global_DroneCommMsg_t.dataToSendLen)
+            if(HAL_WRAPPER_STAT_OK != HAL_WRAPPER_SendCommFrame(local_pFrame))
             {
-                if(HAL_WRAPPER_SendCommMessage(*(global_DroneCommMsg_t.dataToSend + i)) == HAL_WRAPPER_STAT_OK)
-                {
-                    i++;
-                }
-                else
-                {
-                    // check if there anything Drone board is sending in case of failure of sending, it maybe due receive buffer not empty
-                    UARTReceivedISR();
-                    if(global_DroneCommMsg_t.IsDataReceived)
-                    {   
-                        // append the new received message to the queue
-                        SERVICE_RTOS_AppendToBlockingQueue(0, (const void *) &global_MsgToRec_t, queue_DroneCommToApp_Handle_t);
-                        SERVICE_RTOS_Notify(task_RCComm_Handle_t, LIB_CONSTANTS_DISABLED);  
-
-                        global_DroneCommMsg_t.dataIsToReceive = 0;
-                        global_DroneCommMsg_t.IsDataReceived = 0;
-                    }
-                }
+                // can't happen while there are less frames than the transmit queue, the message is dropped
+                break;
             }
 
-            // read next message
-            local_RTOSErrStatus = SERVICE_RTOS_ReadFromBlockingQueue(0, (void *) &local_MsgToSend_t, queue_AppCommToDrone_Handle_t, &local_u8LenOfRemaining);
+            local_u8NextFrame = (local_u8NextFrame + 1) % DRONE_COMM_TX_FRAMES;
+            local_pFrame = &global_CommTxFrame_t[local_u8NextFrame];
         }
         
-        // check if there anything Drone board is sending
-        UARTReceivedISR();
-        if(global_DroneCommMsg_t.IsDataReceived)
-        {   
-             // append the new received message to the queue
-            SERVICE_RTOS_AppendToBlockingQueue(0, (const void *) &global_MsgToRec_t, queue_DroneCommToApp_Handle_t);
-            SERVICE_RTOS_Notify(task_RCComm_Handle_t, LIB_CONSTANTS_DISABLED);  
-            
-             global_DroneCommMsg_t.dataIsToReceive = 0;
-             global_DroneCommMsg_t.IsDataReceived = 0;
-        }
+        // check if there anything the drone board sent
+        UARTReceivedFrames();
+
+        // share of the CPU left to the idle task and load of the link
+        SERVICE_RTOS_GetIdleTime(&local_u32IdleUS, &local_u32TotalUS);
+        if(local_u32TotalUS - local_u32WindowStartUS >= CPU_LOAD_WINDOW_US)
+        {
+            global_u16IdlePermille = (uint16_t)((local_u32IdleUS - local_u32WindowIdleUS) / ((local_u32TotalUS - local_u32WindowStartUS) / 1000));
 
-       
+            HAL_WRAPPER_GetCommTxStats(&local_TxStats_t);
+            global_u32CommTxBytesPerSec = (uint32_t)((uint64_t)(local_TxStats_t.bytes - local_u32WindowTxBytes) * 1000000 / (local_u32TotalUS - local_u32WindowStartUS));
+            local_u32WindowTxBytes = local_TxStats_t.bytes;
 
+            local_u32WindowIdleUS = local_u32IdleUS;
+            local_u32WindowStartUS = local_u32TotalUS;
 
+            // printf("idle: %d.%d%%, tx: %lu B/s, latency: %lu us\r\n", global_u16IdlePermille / 10, global_u16IdlePermille % 10, global_u32CommTxBytesPerSec, local_TxStats_t.maxLatencyUS);
+        }
     }
 }
 
@@ -418,17 +520,6 @@ void Task_DroneComm(void)
 */
 void Task_TakeAction(void)
 {
-    //                      SOME INITIALIZATION 
-    // INITIALIZATION CAN'T BE DONE IN MAIN AS SCHEDULAR HAS TO START FIRST BEFORE DOING 
-    // ANYTHING (RECEIVING INTERRUPTS HAS TO WAIT BEFORE INITIALIZING)
-    /************************************************************************/
-    // assign pointers and lengths of data to be always received
-    global_DroneCommMsg_t.dataToReceive = (uint8_t*) &global_MsgToRec_t.data;
-    global_DroneCommMsg_t.dataToReceiveLen = sizeof(global_MsgToRec_t.data);
-    global_DroneCommMsg_t.dataIsToReceive = 0;
-    global_DroneCommMsg_t.IsDataReceived = 0;
-    /************************************************************************/
-
     // Configure/enable Clock and all needed peripherals 
     SystemInit();
     SystemCoreClockUpdate();
@@ -436,9 +527,6 @@ void Task_TakeAction(void)
     // configure NVIC
     NVIC_PriorityGroupConfig(NVIC_PriorityGroup_2);
 
-    // // set call back for board receive
-    // HAL_WRAPPER_SetAppCommRecCallBack(UARTReceivedISR);
-
     // configure all pins and peripherals 
     MCAL_Config_ConfigAllPins();
 
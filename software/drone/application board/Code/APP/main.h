@@ -39,6 +39,8 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    18/06/2023      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           the messages between the boards are framed by "comm_frame.h".   |
+ * |    17/10/2026      1.2.0           agent                           sizes of the frames follow the packed messages of comm_pack.h   |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -60,6 +62,16 @@
  */
 #include "stdint.h"
 
+/**
+ * @reason: contains the framing of the messages between the boards
+ */
+#include "comm_frame.h"
+
+/**
+ * @reason: contains the packing of the messages between the boards
+ */
+#include "comm_pack.h"
+
 /******************************************************************************
  * Module Preprocessor Constants
  *******************************************************************************/
@@ -69,6 +81,13 @@
  * Module Preprocessor Macros
  *******************************************************************************/
 
+/**
+ * @brief: size of the encoded frames of the messages between the boards (refer to "comm_frame.h"), the messages are packed
+ *         with "comm_pack.h" and both boards must use the same LIB_COMM_FRAME_VERSION
+ */
+#define COMM_FRAME_MOVE_LEN LIB_COMM_FRAME_ENCODED_LEN(LIB_COMM_PACK_MOVE_LEN)
+#define COMM_FRAME_INFO_LEN LIB_COMM_FRAME_ENCODED_LEN(LIB_COMM_PACK_INFO_LEN)
+
 /******************************************************************************
  * Module Typedefs
  *******************************************************************************/
@@ -39,6 +39,7 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    18/06/2023      1.0.0           Abdelrahman Mohamed Salem       Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           the radio is left listening after its pipes are opened.         |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
  
@@ -108,6 +109,9 @@ HAL_Config_ErrStat_t HAL_Config_ConfigAllHW(void)
 	NRF_openWritingPipe(addresses[1]);
 	NRF_openReadingPipe(1, addresses[0]);
 
+    // the packets are taken when the IRQ pin of the module fires (refer to HAL_WRAPPER_RCService)
+    NRF_start_listening();
+
     return HAL_Config_STAT_OK;
 }
 
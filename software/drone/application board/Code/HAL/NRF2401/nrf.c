@@ -39,6 +39,15 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    18/06/2023      1.0.0           Ahmed Fawzy                     Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           payload size set by NRF_PAYLOAD_LEN instead of 32 bytes         |
+ * |    17/10/2026      1.2.0           agent                           packets are sent and received by 'NRF_process' when the IRQ pin |
+ * |                                                                    fires instead of blocking and polling.                          |
+ * |    17/10/2026      1.3.0           agent                           the module never leaves listening, the queued packets ride on   |
+ * |                                                                    the acknowledges (ACK payloads).                                |
+ * |    17/10/2026      1.4.0           agent                           only the real bytes of the packets are clocked, the widths come |
+ * |                                                                    from R_RX_PL_WID.                                               |
+ * |    17/10/2026      1.5.0           agent                           RF channel and retransmits set by NRF_RF_CHANNEL and            |
+ * |                                                                    NRF_SETUP_RETR.                                                 |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -79,6 +88,65 @@
  */
 #include "Service_RTOS_wrapper.h"
 
+/******************************************************************************
+ * Module Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: states of the radio kept by NRF_process
+ */
+#define NRF_STATE_STANDBY   0
+#define NRF_STATE_RX        1
+
+/**
+ * @brief: all the interrupt flags of the STATUS register, writing them clears them
+ */
+#define NRF_IRQ_FLAGS       (SHIFT_LEFT(RX_DR) | SHIFT_LEFT(TX_DS) | SHIFT_LEFT(MAX_RT))
+
+/**
+ * @brief: depth of the RX FIFO of the module
+ */
+#define NRF_RX_FIFO_DEPTH   3
+
+/**
+ * @brief: longest payload the module takes, a wider R_RX_PL_WID means a corrupted packet
+ */
+#define NRF_MAX_PAYLOAD_WIDTH   32
+
+/******************************************************************************
+ * Module Variable Definitions
+ *******************************************************************************/
+
+/**
+ * @brief: packets moved from the RX FIFO by NRF_process waiting for NRF_read
+ */
+uint8_t global_NRFRxQueue[NRF_RX_QUEUE_LEN][NRF_PAYLOAD_LEN];
+uint8_t global_NRFRxLen[NRF_RX_QUEUE_LEN];
+uint8_t global_NRFRxHead = 0;
+uint8_t global_NRFRxCount = 0;
+
+/**
+ * @brief: packets given to NRF_write waiting to be loaded in the TX FIFO as ACK payloads
+ */
+uint8_t global_NRFTxQueue[NRF_TX_QUEUE_LEN][NRF_PAYLOAD_LEN];
+uint8_t global_NRFTxLen[NRF_TX_QUEUE_LEN];
+uint8_t global_NRFTxHead = 0;
+uint8_t global_NRFTxCount = 0;
+
+/**
+ * @brief: state of the radio (NRF_STATE_xxx)
+ */
+uint8_t global_NRFState = NRF_STATE_STANDBY;
+
+/**
+ * @brief: counters of the radio link since boot
+ */
+NRF_stats_t global_NRFStats = {0};
+
+/******************************************************************************
+ * Function Definitions
+ *******************************************************************************/
+
 
 /**
  * @brief: Write a value to an NRF register
@@ -133,32 +201,51 @@ uint8_t NRF_read_register(uint8_t reg) {
 }
 
 /**
- * @brief: Write data to the NRF module
+ * @brief: Queue data to be sent by NRF_process
  */
-void NRF_write(const void* buf, uint8_t data_len) {
+uint8_t NRF_write(const void* buf, uint8_t data_len) {
     const uint8_t* current = (const uint8_t*)buf;
-    uint8_t blank_len = 32 - data_len;
+    uint8_t* slot;
+    uint8_t i;
 
-    CSN_LOW();
-    SPI_transfer(0xA0);
+    if ((0 == data_len) || (data_len > NRF_PAYLOAD_LEN)) {
+        return 0;
+    }
+    if (global_NRFTxCount >= NRF_TX_QUEUE_LEN) {
+        global_NRFStats.tx_queue_full++;
+        return 0;
+    }
+
+    // only the real bytes are kept, the payload width goes over the air with the packet (dynamic payload length)
+    i = (global_NRFTxHead + global_NRFTxCount) % NRF_TX_QUEUE_LEN;
+    slot = global_NRFTxQueue[i];
+    global_NRFTxLen[i] = data_len;
     while (data_len--) {
-        SPI_transfer(*current++);
+        *slot++ = *current++;
     }
-    while (blank_len--) {
-        SPI_transfer(0);
+    global_NRFTxCount++;
+
+    // loaded right away if the TX FIFO has room, else when an ACK payload in it is sent
+    NRF_process();
+    return 1;
+}
+
+/**
+ * @brief: Load the oldest queued packet in the TX FIFO, it's sent in the next acknowledge on NRF_ACK_PIPE
+ */
+static void NRF_load_ack_payload() {
+    const uint8_t* current = global_NRFTxQueue[global_NRFTxHead];
+    uint8_t len = global_NRFTxLen[global_NRFTxHead];
+
+    CSN_LOW();
+    SPI_transfer(W_ACK_PAYLOAD | NRF_ACK_PIPE);
+    while (len--) {
+        SPI_transfer(*current++);
     }
     CSN_HIGH();
 
-    CE_HIGH();
-    SERVICE_RTOS_BlockFor(5);
-    CE_LOW();
-
-    //uint8_t status = NRF_write_register(STATUS, SHIFT_LEFT(6) | SHIFT_LEFT(5) | SHIFT_LEFT(4));
-   /* if (status & SHIFT_LEFT(4)) {
-        NRF_send_command(FLUSH_TX);
-        return 0;
-    }*/
-    return ;
+    global_NRFTxHead = (global_NRFTxHead + 1) % NRF_TX_QUEUE_LEN;
+    global_NRFTxCount--;
 }
 
 /**
@@ -186,8 +273,8 @@ void NRF_init() {
 
     MCAL_WRAPPER_DelayUS(110000); // Delay to ensure the NRF module is properly reset
 
-    // Set auto-retransmit delay to 1500us and up to 15 retransmit attempts
-    NRF_write_register(SETUP_RETR, 0x5F);
+    // Set the auto-retransmit delay and attempts
+    NRF_write_register(SETUP_RETR, NRF_SETUP_RETR);
 
     // Read the RF setup register, mask out unnecessary bits, and write back the data rate settings
     uint8_t data_rate = NRF_read_register(RF_SETUP);
@@ -201,16 +288,20 @@ void NRF_init() {
     // Enable RX addresses for data pipes 0 and 1
     NRF_write_register(EN_RXADDR, 0x03);
 
-    // Set the payload size to 32 bytes for all pipes
+    // Set the payload size for the pipes without dynamic payload length (pipes 0 and 1 take the width sent with each packet)
     for (uint8_t pipe = 0; pipe <= 5; pipe++) {
-        NRF_write_register(RX_PW_P0 + pipe, 32);
+        NRF_write_register(RX_PW_P0 + pipe, NRF_PAYLOAD_LEN);
     }
 
     // Set the address width to 5 bytes
     NRF_write_register(SETUP_AW, 0x03);
 
-    // Set the RF channel to 115
-    NRF_write_register(RF_CH, 115);
+    // Set the RF channel
+    NRF_write_register(RF_CH, NRF_RF_CHANNEL);
+
+    // Enable the payloads in the acknowledges, they need the dynamic payload length on the pipes of both ends
+    NRF_write_register(FEATURE, SHIFT_LEFT(EN_DPL) | SHIFT_LEFT(EN_ACK_PAY));
+    NRF_write_register(DYNPD, SHIFT_LEFT(DPL_P0) | SHIFT_LEFT(DPL_P1));
 
     // Clear the status register
     NRF_write_register(STATUS, SHIFT_LEFT(6) | SHIFT_LEFT(5) | SHIFT_LEFT(4));
@@ -232,16 +323,16 @@ void NRF_init() {
  */
 void NRF_start_listening() {
     uint8_t config_value = NRF_read_register(CONFIG);
-    config_value |= SHIFT_LEFT(0);
+    config_value |= SHIFT_LEFT(PRIM_RX);
 
     NRF_write_register(CONFIG, config_value);
-    NRF_write_register(STATUS, (SHIFT_LEFT(4) | SHIFT_LEFT(5) | SHIFT_LEFT(6)));
+    NRF_write_register(STATUS, NRF_IRQ_FLAGS);
 
     CE_HIGH();
     NRF_write_register(EN_RXADDR, (NRF_read_register(EN_RXADDR) & ~SHIFT_LEFT(0)));
 
-    // delay for allowing NRF to detect if anything received
-    SERVICE_RTOS_BlockFor(20);
+    // the received packets are taken by NRF_process when the IRQ pin fires
+    global_NRFState = NRF_STATE_RX;
 }
 
 /**
@@ -250,8 +341,9 @@ void NRF_start_listening() {
 void NRF_stop_listening() {
     CE_LOW();
     MCAL_WRAPPER_DelayUS(100);
-    NRF_write_register(CONFIG, (NRF_read_register(CONFIG) & ~(0x01)));
+    NRF_write_register(CONFIG, (NRF_read_register(CONFIG) & ~SHIFT_LEFT(PRIM_RX)));
     NRF_write_register(EN_RXADDR, (NRF_read_register(EN_RXADDR) | SHIFT_LEFT(0)));
+    global_NRFState = NRF_STATE_STANDBY;
 }
 
 /**
@@ -271,44 +363,135 @@ uint8_t NRF_read_data_register(uint8_t reg, uint8_t *buf, uint8_t len) {
 }
 
 
+/**
+ * @brief: Get the width of the payload at the top of the RX FIFO
+ */
+uint8_t NRF_read_payload_width() {
+    CSN_LOW();
+    SPI_transfer(R_RX_PL_WID);
+    uint8_t width = SPI_transfer(NOP);
+    CSN_HIGH();
+
+    // a width over 32 is a corrupted packet, the datasheet asks for the RX FIFO to be flushed
+    if (width > NRF_MAX_PAYLOAD_WIDTH) {
+        NRF_send_command(FLUSH_RX);
+        return 0;
+    }
+    return width;
+}
+
 /**
  * @brief: Read payload data from the NRF module
  */
 uint8_t NRF_read_payload(void *buf, uint8_t len) {
     uint8_t status;
     uint8_t *current = (uint8_t *)buf;
-    uint8_t data_len = len;
-    uint8_t blank_len = 32 - data_len;
 
     CSN_LOW();
-    status = SPI_transfer(0x61);
-    while (data_len--) {
+    status = SPI_transfer(R_RX_PAYLOAD);
+    while (len--) {
         *current++ = SPI_transfer(NOP);
     }
-    while (blank_len--) {
-        SPI_transfer(NOP);
-    }
     CSN_HIGH();
 
     return status;
 }
 
 /**
- * @brief: Read data from the NRF module into a buffer
+ * @brief: Take the oldest received packet into a buffer
  */
-void NRF_read(void *buf, uint8_t len) {
-    NRF_read_payload(buf, len);
-    NRF_write_register(STATUS, SHIFT_LEFT(6));
+uint8_t NRF_read(void *buf, uint8_t len) {
+    const uint8_t* current;
+    uint8_t* out = (uint8_t*)buf;
+    uint8_t width;
+
+    if (0 == global_NRFRxCount) {
+        return 0;
+    }
+    if (len > NRF_PAYLOAD_LEN) {
+        len = NRF_PAYLOAD_LEN;
+    }
+
+    if (len > global_NRFRxLen[global_NRFRxHead]) {
+        len = global_NRFRxLen[global_NRFRxHead];
+    }
+    width = len;
+
+    current = global_NRFRxQueue[global_NRFRxHead];
+    while (len--) {
+        *out++ = *current++;
+    }
+    global_NRFRxHead = (global_NRFRxHead + 1) % NRF_RX_QUEUE_LEN;
+    global_NRFRxCount--;
+    return width;
 }
 
 /**
- * @brief: Check if data is available in the NRF module
+ * @brief: Check if a received packet is waiting for NRF_read
  */
 uint8_t NRF_data_available() {
-    if (NRF_read_register(FIFO_STATUS) & 1) {
-        return 0;
+    return (0 != global_NRFRxCount);
+}
+
+/**
+ * @brief: Serve the interrupts of the NRF module then send the next packet or listen
+ */
+uint8_t NRF_process(void) {
+    uint8_t discard[NRF_MAX_PAYLOAD_WIDTH];
+    uint8_t count = 0;
+    uint8_t width = 0;
+    uint8_t slot = 0;
+
+    // the flags are cleared first so a packet coming while the FIFO is drained fires the IRQ pin again
+    uint8_t status = NRF_write_register(STATUS, NRF_IRQ_FLAGS);
+    if (status & NRF_IRQ_FLAGS) {
+        global_NRFStats.irqs++;
     }
-    return 1;
+
+    // move the received packets to the queue, only their real bytes are clocked, the ones that don't fit are read out to free the FIFO
+    while ((count++ < NRF_RX_FIFO_DEPTH) && !(NRF_read_register(FIFO_STATUS) & SHIFT_LEFT(RX_EMPTY))) {
+        width = NRF_read_payload_width();
+        if (0 == width) {
+            // corrupted packet, the FIFO is already flushed
+            global_NRFStats.rx_invalid++;
+            break;
+        } else if (width > NRF_PAYLOAD_LEN) {
+            NRF_read_payload(discard, width);
+            global_NRFStats.rx_invalid++;
+        } else if (global_NRFRxCount < NRF_RX_QUEUE_LEN) {
+            slot = (global_NRFRxHead + global_NRFRxCount) % NRF_RX_QUEUE_LEN;
+            NRF_read_payload(global_NRFRxQueue[slot], width);
+            global_NRFRxLen[slot] = width;
+            global_NRFRxCount++;
+            global_NRFStats.rx_packets++;
+        } else {
+            NRF_read_payload(discard, width);
+            global_NRFStats.rx_overflows++;
+        }
+    }
+
+    // TX_DS is set when an acknowledge carried the ACK payload
+    if (status & SHIFT_LEFT(TX_DS)) {
+        global_NRFStats.tx_packets++;
+    }
+
+    // the queued packets fill the TX FIFO so every acknowledge carries one, the oldest goes in the next acknowledge
+    while (global_NRFTxCount && !(NRF_read_register(FIFO_STATUS) & SHIFT_LEFT(TX_FULL))) {
+        NRF_load_ack_payload();
+    }
+
+    if (NRF_STATE_RX != global_NRFState) {
+        NRF_start_listening();
+    }
+
+    return status;
+}
+
+/**
+ * @brief: Copy the counters of the radio link
+ */
+void NRF_get_stats(NRF_stats_t *stats) {
+    *stats = global_NRFStats;
 }
 
 /*************** END OF FUNCTIONS ***************************************************************************/
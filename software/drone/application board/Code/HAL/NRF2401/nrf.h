@@ -39,6 +39,13 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    18/06/2023      1.0.0           Ahmed Fawzy                     Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           added NRF_PAYLOAD_LEN                                           |
+ * |    17/10/2026      1.2.0           agent                           NRF_write/NRF_read go through software queues served by         |
+ * |                                                                    'NRF_process' on the IRQ pin, added 'NRF_get_stats'.            |
+ * |    17/10/2026      1.3.0           agent                           queued packets are sent as ACK payloads, added NRF_ACK_PIPE.    |
+ * |    17/10/2026      1.4.0           agent                           dynamic payload length, added 'NRF_read_payload_width',         |
+ * |                                                                    NRF_read returns the width.                                     |
+ * |    17/10/2026      1.5.0           agent                           added NRF_RF_CHANNEL and NRF_SETUP_RETR.                        |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -63,6 +70,38 @@
  * Configuration Constants
  *******************************************************************************/
 
+/**
+ * @brief: longest payload of a packet in bytes (at most 32), it's the longest message of the radio link (LIB_COMM_PACK_RADIO_LEN
+ *         in "comm_pack.h"), the packets carry their own width (dynamic payload length) so only the real bytes are sent
+ */
+#define NRF_PAYLOAD_LEN     (9)
+
+/**
+ * @brief: number of received packets kept until NRF_read takes them, the packets coming while it's full are dropped
+ */
+#define NRF_RX_QUEUE_LEN    (4)
+
+/**
+ * @brief: number of packets NRF_write keeps until they are loaded in the TX FIFO one at a time
+ */
+#define NRF_TX_QUEUE_LEN    (4)
+
+/**
+ * @brief: pipe the other end sends on (opened by NRF_openReadingPipe), the queued packets ride on its acknowledges
+ */
+#define NRF_ACK_PIPE        (1)
+
+/**
+ * @brief: RF channel of the link, the remote control uses the same one (2400 + 115 MHz)
+ */
+#define NRF_RF_CHANNEL      (115)
+
+/**
+ * @brief: auto retransmit setup (delay 500us, 3 retransmits), it only applies to the packets this end sends and not to the
+ *         acknowledges it gives, the remote control sends the commands and adapts its own one to the link
+ */
+#define NRF_SETUP_RETR      (0x13)
+
 /******************************************************************************
  * Macros
  *******************************************************************************/
@@ -71,6 +110,19 @@
  * Typedefs
  *******************************************************************************/
 
+/**
+ * @brief: counters of the radio link since boot
+ */
+typedef struct
+{
+    uint32_t rx_packets;        /**< packets received and queued for NRF_read */
+    uint32_t rx_overflows;      /**< packets dropped as the receive queue was full */
+    uint32_t rx_invalid;        /**< packets dropped for a width over NRF_PAYLOAD_LEN or a corrupted width */
+    uint32_t tx_packets;        /**< packets sent in the acknowledge of a received packet */
+    uint32_t tx_queue_full;     /**< packets refused by NRF_write as the transmit queue was full */
+    uint32_t irqs;              /**< times NRF_process found a pending interrupt */
+} NRF_stats_t;
+
 /******************************************************************************
  * Variables
  *******************************************************************************/
@@ -218,13 +270,16 @@ uint8_t NRF_read_register(uint8_t reg);
 
 /**
  *  \b function                                 :       None
- *  \b Description                              :       Writes data to the NRF module.
+ *  \b Description                              :       Queues a packet to be sent to the other end, NRF_process loads it in the TX FIFO as the payload
+ *                                                      of the acknowledge of the next packet received on NRF_ACK_PIPE so the radio never leaves listening.
  *  @param  buf [IN]                            :       The buffer containing the data to write.
  *  @param  data_len [IN]                       :       The length of the data.
- *  @note                                       :       None.
+ *  @note                                       :       it doesn't wait for the packet to be sent, it goes out when the other end sends something.
+ *                                                      only 'data_len' bytes are sent, the width goes with the packet.
+ *                                                      must be called from the task that calls NRF_process.
  *  \b PRE-CONDITION                            :       None
  *  \b POST-CONDITION                           :       None.
- *  @return                                     :       True if the write was successful, false otherwise.
+ *  @return                                     :       1 if the packet was queued, 0 if the queue is full or 'data_len' is 0 or more than NRF_PAYLOAD_LEN.
  *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
  *
  *  \b Example:
@@ -238,10 +293,13 @@ uint8_t NRF_read_register(uint8_t reg);
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
  * <tr><td> 18/06/2024 </td><td> 1.0.0            </td><td> AF      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.2.0            </td><td> agent    </td><td> queued instead of blocking for the send </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.3.0            </td><td> agent    </td><td> sent as an ACK payload </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.4.0            </td><td> agent    </td><td> only the real bytes are sent </td></tr>
  * </table><br><br>
  * <hr>
  */
-void NRF_write(const void* buf, uint8_t data_len);
+uint8_t NRF_write(const void* buf, uint8_t data_len);
 
 /**
  *  \b function                                 :       None
@@ -281,7 +339,8 @@ void NRF_init();
  *  @param  arg_u16TaskStackDepth [IN]          :       None
  *  @param  arg_u32TaskPriority [IN]            :       None
  *  @param  arg_pTaskHandle [OUT]               :       None
- *  @note                                       :       None.
+ *  @note                                       :       it returns right away, the packets are taken by NRF_process when the IRQ pin of the module
+ *                                                      fires, the queued packets are sent in the acknowledges so it stays listening.
  *  \b PRE-CONDITION                            :       None
  *  \b POST-CONDITION                           :       None.
  *  @return                                     :       None
@@ -298,6 +357,8 @@ void NRF_init();
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
  * <tr><td> 18/06/2024 </td><td> 1.0.0            </td><td> AF      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.2.0            </td><td> agent    </td><td> listens without blocking </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.3.0            </td><td> agent    </td><td> enables the ACK payloads </td></tr>
  * </table><br><br>
  * <hr>
  */
@@ -419,8 +480,8 @@ void NRF_openReadingPipe(uint8_t child, const uint8_t *address);
  *  \b function                                 :       None
  *  \b Description                              :       Reads payload data from the NRF module.
  *  @param  buf [IN]                            :       The buffer to store the data.
- *  @param  len [IN]                            :       The length of the buffer.
- *  @note                                       :       None.
+ *  @param  len [IN]                            :       The width of the payload (refer to NRF_read_payload_width).
+ *  @note                                       :       only 'len' bytes are clocked, the payload leaves the RX FIFO even if it's wider.
  *  \b PRE-CONDITION                            :       None
  *  \b POST-CONDITION                           :       None.
  *  @return                                     :       The status byte returned by the NRF module.
@@ -437,20 +498,52 @@ void NRF_openReadingPipe(uint8_t child, const uint8_t *address);
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
  * <tr><td> 18/06/2024 </td><td> 1.0.0            </td><td> AF      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.4.0            </td><td> agent    </td><td> clocks only the payload width </td></tr>
  * </table><br><br>
  * <hr>
  */
 uint8_t NRF_read_payload(void *buf, uint8_t len);
 
+/**
+ *  \b function                                 :       uint8_t NRF_read_payload_width();
+ *  \b Description                              :       Reads the width of the payload at the top of the RX FIFO (R_RX_PL_WID).
+ *  @param  void [IN]                           :       None.
+ *  @note                                       :       a width over 32 means a corrupted packet, the RX FIFO is flushed and 0 is returned.
+ *  \b PRE-CONDITION                            :       the dynamic payload length is enabled on the pipe and the RX FIFO isn't empty.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       The width of the payload in bytes, 0 if it was corrupted.
+ *  @see                                        :       uint8_t NRF_read_payload(void *buf, uint8_t len)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * uint8_t buf[32];
+ * uint8_t width = NRF_read_payload_width();
+ * if (width) {
+ *     NRF_read_payload(buf, width);
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.4.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+uint8_t NRF_read_payload_width();
+
 /**
  *  \b function                                 :       None
- *  \b Description                              :       Reads data from the NRF module into a buffer.
+ *  \b Description                              :       Takes the oldest packet NRF_process received into a buffer.
  *  @param  buf [IN]                            :       The buffer to store the data.
  *  @param  len [IN]                            :       The length of the buffer.
- *  @note                                       :       None.
+ *  @note                                       :       at most 'len' bytes of the packet are copied.
+ *                                                      must be called from the task that calls NRF_process.
  *  \b PRE-CONDITION                            :       None
  *  \b POST-CONDITION                           :       None.
- *  @return                                     :       None
+ *  @return                                     :       The number of bytes copied, 0 if there is nothing received.
  *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
  *
  *  \b Example:
@@ -464,14 +557,16 @@ uint8_t NRF_read_payload(void *buf, uint8_t len);
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
  * <tr><td> 18/06/2024 </td><td> 1.0.0            </td><td> AF      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.2.0            </td><td> agent    </td><td> reads the packets queued by NRF_process </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.4.0            </td><td> agent    </td><td> returns the width of the packet </td></tr>
  * </table><br><br>
  * <hr>
  */
-void NRF_read(void *buf, uint8_t len);
+uint8_t NRF_read(void *buf, uint8_t len);
 
 /**
  *  \b function                                 :       None
- *  \b Description                              :       Checks if data is available in the NRF module.
+ *  \b Description                              :       Checks if NRF_process queued a received packet for NRF_read.
  *  @param  void [IN]                           :       None.
  *  @note                                       :       None.
  *  \b PRE-CONDITION                            :       None
@@ -490,9 +585,74 @@ void NRF_read(void *buf, uint8_t len);
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
  * <tr><td> 18/06/2024 </td><td> 1.0.0            </td><td> AF      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.2.0            </td><td> agent    </td><td> checks the receive queue </td></tr>
  * </table><br><br>
  * <hr>
  */
 uint8_t NRF_data_available();
 
+/**
+ *  \b function                                 :       uint8_t NRF_process(void);
+ *  \b Description                              :       Serves the interrupts of the module: clears them, moves the received packets from the RX FIFO to
+ *                                                      the receive queue, counts the sent ACK payloads (TX_DS) then loads the queued packets in the
+ *                                                      TX FIFO while it has room, the oldest one goes in the next acknowledge.
+ *  @param  void [IN]                           :       None.
+ *  @note                                       :       it's called by the task woken by the IRQ pin of the module (refer to MCAL_WRAPPER_SetRadioTask in
+ *                                                      "MCAL_wrapper.h") and when that task times out, so a missed edge only delays the packets.
+ *  \b PRE-CONDITION                            :       the module is initialized and the pipes are opened.
+ *  \b POST-CONDITION                           :       the module is listening.
+ *  @return                                     :       The status byte of the module before its interrupts were cleared.
+ *  @see                                        :       uint8_t NRF_write(const void* buf, uint8_t data_len)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * uint8_t buf[NRF_PAYLOAD_LEN];
+ * uint8_t len;
+ * SERVICE_RTOS_WaitForNotification(20);
+ * NRF_process();
+ * while ((len = NRF_read(buf, sizeof(buf)))) {
+ *     // use the packet
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.2.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.3.0            </td><td> agent    </td><td> sends the queued packets as ACK payloads </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+uint8_t NRF_process(void);
+
+/**
+ *  \b function                                 :       void NRF_get_stats(NRF_stats_t *stats);
+ *  \b Description                              :       Copies the counters of the radio link since boot.
+ *  @param  stats [OUT]                         :       The structure to store the counters in.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       None
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None
+ *  @see                                        :       uint8_t NRF_process(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * NRF_stats_t stats;
+ * NRF_get_stats(&stats);
+ * printf("received %lu, dropped %lu\r\n", stats.rx_packets, stats.rx_overflows);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.2.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void NRF_get_stats(NRF_stats_t *stats);
+
 #endif /* USER_NRF_H_ */
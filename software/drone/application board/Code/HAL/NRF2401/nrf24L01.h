@@ -39,6 +39,9 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    18/06/2023      1.0.0           Ahmed Fawzy                     Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           added the bits of CONFIG, STATUS and FIFO_STATUS.               |
+ * |    17/10/2026      1.2.0           agent                           added W_ACK_PAYLOAD, FEATURE and their bits.                    |
+ * |    17/10/2026      1.3.0           agent                           added R_RX_PL_WID.                                              |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -55,9 +58,11 @@
 
 /*--------- Instructions ------------*/
 #define READ_REG 0x00
+#define R_RX_PL_WID 0x60
 #define WRITE_REG 0x20
 #define R_RX_PAYLOAD 0x61
 #define W_TX_PAYLOAD 0xA0
+#define W_ACK_PAYLOAD 0xA8
 #define FLUSH_TX 0xE1
 #define FLUSH_RX 0xE2
 #define NOP 0xFF
@@ -85,6 +90,23 @@
 #define RX_PW_P0 0x11
 #define FIFO_STATUS 0x17
 #define DYNPD 0x1C
+#define FEATURE 0x1D
+
+
+/*--------register bits -------------*/
+#define PRIM_RX 0
+#define PWR_UP 1
+#define MAX_RT 4
+#define TX_DS 5
+#define RX_DR 6
+#define RX_EMPTY 0
+#define TX_EMPTY 4
+#define TX_FULL 5
+#define DPL_P0 0
+#define DPL_P1 1
+#define EN_DYN_ACK 0
+#define EN_ACK_PAY 1
+#define EN_DPL 2
 
 
 // Define the macros for the child pipe enable
@@ -39,6 +39,19 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    18/06/2023      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           replaced the UART4 receive callback functions and               |
+ * |                                                                    'HAL_WRAPPER_GetCommMessage' by 'HAL_WRAPPER_SetAppCommRecTask' |
+ * |                                                                    and 'HAL_WRAPPER_GetCommFrame'.                                 |
+ * |    17/10/2026      1.2.0           agent                           replaced 'HAL_WRAPPER_SendCommMessage' by the DMA frame         |
+ * |                                                                    transmitter 'HAL_WRAPPER_SendCommFrame' and added               |
+ * |                                                                    'HAL_WRAPPER_GetCommTxStats'.                                   |
+ * |    17/10/2026      1.3.0           agent                           the messages of the remote control are packed with comm_pack.h  |
+ * |    17/10/2026      1.4.0           agent                           the remote control is served from the IRQ pin of the radio      |
+ * |                                                                    instead of polling.                                             |
+ * |    17/10/2026      1.5.0           agent                           the sticks are unpacked with the width of the packet.           |
+ * |    17/10/2026      1.6.0           agent                           counts the link with the remote control from the link byte of   |
+ * |                                                                    the commands, added 'HAL_WRAPPER_GetRCLinkStats' and            |
+ * |                                                                    'HAL_WRAPPER_RCSendLink'.                                       |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
  
@@ -57,6 +70,11 @@
 */
 #include "MCAL_wrapper.h"
 
+/**
+ * @reason: contains the DMA driven receiver of the comm port
+ */
+#include "MCAL_UART.h"
+
 /**
  * @reason: contains common definitions
  */
@@ -68,6 +86,11 @@
  */
 #include "nrf.h"
 
+/**
+ * @reason: contains the packing of the messages of the remote control
+ */
+#include "comm_pack.h"
+
 /******************************************************************************
  * Module Preprocessor Constants
  *******************************************************************************/
@@ -84,6 +107,22 @@
  * Module Variable Definitions
  *******************************************************************************/
 
+/**
+ * @brief: last keyframe of the telemetry sent to the remote control (refer to "comm_pack.h")
+ */
+LIB_COMM_PACK_InfoState_t global_RCInfoState_t = {.keyframePeriod = HAL_WRAPPER_RC_INFO_KEYFRAME_PERIOD};
+
+/**
+ * @brief: counters of the radio link and their values at the last link message
+ */
+HAL_WRAPPER_RCLinkStats_t global_RCLinkStats_t = {0};
+HAL_WRAPPER_RCLinkStats_t global_RCLinkSent_t = {0};
+
+/**
+ * @brief: number of the last command received from the link byte, -1 before the first one
+ */
+int16_t global_s16RCLinkNumber = -1;
+
 
 /******************************************************************************
  * Function Prototypes
@@ -93,79 +132,53 @@
  * Function Definitions
  *******************************************************************************/
 
+
 /**
  * 
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_DisableEnableAppCommRecCallBack(LIB_CONSTANTS_DriverStates_t arg_Enable_Disable_t)
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecTask(RTOS_TaskHandle_t arg_Task_t)
 {
-    // configure interrupt
-    MCAL_WRAPPER_UART4RecITConfig(arg_Enable_Disable_t);
-
+    MCAL_UART_SetRxTask(arg_Task_t);
     return HAL_WRAPPER_STAT_OK;
 }
 
-
 /**
  * 
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecCallBack(functionCallBack_t arg_pUARTCallBack)
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommFrame(uint8_t* arg_pu8Frame, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len)
 {
-    MCAL_WRAPPER_SetUART4RecCallBack(arg_pUARTCallBack);
+    MCAL_UART_ErrStat_t local_errState_t = MCAL_UART_Read(arg_pu8Frame, arg_u16MaxLen, arg_pu16Len);
+
+    if(MCAL_UART_STAT_INVALID_PARAMS == local_errState_t)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+    else if(MCAL_UART_STAT_OK != local_errState_t)
+        return HAL_WRAPPER_STAT_DRONE_DIDNT_SND;
+
     return HAL_WRAPPER_STAT_OK;
 }
 
 /**
  * 
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReceiveSendAppCommMessage(HAL_WRAPPER_AppCommMsg_t* arg_AppCommMsg_t)
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommFrame(HAL_WRAPPER_CommFrame_t* arg_pFrame)
 {
-    // temp variables to allow synchronous send and receive at the same time
-    uint16_t local_u16LenOfDataToSend = 0;
-    uint16_t local_u16LenOfDataToReceive = 0;
+    MCAL_UART_ErrStat_t local_errState_t = MCAL_UART_Send(arg_pFrame);
 
-    // to detect if there is anything in the receiver buffer (as by writing to UART data register clears the RXNE flag)
-    MCAL_WRAPPER_ErrStat_t local_writeSuccess_t = MCAL_WRAPPER_STAT_OK;
+    if(MCAL_UART_STAT_INVALID_PARAMS == local_errState_t)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+    else if(MCAL_UART_STAT_OK != local_errState_t)
+        return HAL_WRAPPER_STAT_DRONE_BOARD_BSY;
 
-    // loop until we send or received all messages
-    while (arg_AppCommMsg_t->dataIsToSend || arg_AppCommMsg_t->dataIsToReceive)
-    {
-        // check if to send
-        if(arg_AppCommMsg_t->dataIsToSend)
-        {
-            // send 1 byte
-            local_writeSuccess_t = MCAL_WRAPPER_SendDataThroughUART4(arg_AppCommMsg_t->dataToSend + local_u16LenOfDataToSend, 1);
-            
-            if(MCAL_WRAPPER_STAT_OK == local_writeSuccess_t)
-            {
-                local_u16LenOfDataToSend++;
-                
-                // check if sending is done
-                if(local_u16LenOfDataToSend == arg_AppCommMsg_t->dataToSendLen)
-                {
-                    
-                    arg_AppCommMsg_t->dataIsToSend = 0;
-                }  
-            }
-        }
-
-        // check if to receive
-        if(arg_AppCommMsg_t->dataIsToReceive)
-        {
-            // receive 1 byte
-            MCAL_WRAPPER_ReceiveDataThroughUART4(arg_AppCommMsg_t->dataToReceive + local_u16LenOfDataToReceive, 1);
-            local_u16LenOfDataToReceive++;
-
-            // check if receiving is done
-            if(local_u16LenOfDataToReceive == arg_AppCommMsg_t->dataToReceiveLen)
-            {
-                arg_AppCommMsg_t->dataIsToReceive = 0;
+    return HAL_WRAPPER_STAT_OK;
+}
 
-               // enable receuve interrupt
-                HAL_WRAPPER_DisableEnableAppCommRecCallBack(LIB_CONSTANTS_ENABLED);
-            }
-        }
-    }
-    
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommTxStats(HAL_WRAPPER_CommTxStats_t* arg_pStats)
+{
+    if(MCAL_UART_STAT_OK != MCAL_UART_GetTxStats(arg_pStats))
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
 
     return HAL_WRAPPER_STAT_OK;
 }
@@ -173,70 +186,154 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReceiveSendAppCommMessage(HAL_WRAPPER_AppCommM
 /**
  * 
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommMessage(uint8_t* arg_pu8Msg)
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCSend(HAL_WRAPPER_RCMsg_t* arg_pMsg_t)
 {
-    // receive 1 byte
-    MCAL_WRAPPER_ErrStat_t local_errState_t = MCAL_WRAPPER_ReceiveDataThroughUART4(arg_pu8Msg, 1);
-    
-    if(MCAL_WRAPPER_STAT_OK != local_errState_t)
-    {
-        local_errState_t = HAL_WRAPPER_STAT_DRONE_DIDNT_SND;
-    }
-    else
+    HAL_WRAPPER_ErrStat_t local_errState_t = HAL_WRAPPER_STAT_OK;
+    LIB_COMM_PACK_Info_t local_Info_t = {0};
+    uint8_t local_u8Payload[LIB_COMM_PACK_RADIO_LEN] = {0};
+    uint8_t local_u8PayloadLen = 0;
+
+    if(DATA_TYPE_INFO != arg_pMsg_t->MsgToSend.type)
     {
-        local_errState_t = HAL_WRAPPER_STAT_OK;
+        // the remote control only takes the telemetry
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
     }
 
-    return local_errState_t;
+    // pack the telemetry in scaled integers, only what changed since the last keyframe is sent
+    local_Info_t.distanceToOrigin = arg_pMsg_t->MsgToSend.data.info.distanceToOrigin;
+    local_Info_t.altitude = arg_pMsg_t->MsgToSend.data.info.altitude;
+    local_Info_t.temperature = arg_pMsg_t->MsgToSend.data.info.temperature;
+    local_Info_t.batteryCharge = arg_pMsg_t->MsgToSend.data.info.batteryCharge;
+    local_u8PayloadLen = LIB_COMM_PACK_u8PackInfo(&global_RCInfoState_t, &local_Info_t, local_u8Payload);
+
+    // the packet is sent by HAL_WRAPPER_RCService once the radio is done with the one before
+    if(!NRF_write((void*)local_u8Payload, local_u8PayloadLen))
+        local_errState_t = HAL_WRAPPER_STAT_RC_BSY;
+
+    return local_errState_t; 
 }
 
 /**
  * 
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommMessage(uint8_t arg_pu8Msg)
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCReceive(HAL_WRAPPER_RCMsg_t* arg_pMsg_t)
 {
-    MCAL_WRAPPER_ErrStat_t local_errState_t = MCAL_WRAPPER_SendDataThroughUART4(&arg_pu8Msg, 1);
-    if(MCAL_WRAPPER_STAT_OK != local_errState_t)
+    HAL_WRAPPER_ErrStat_t local_errState_t = HAL_WRAPPER_STAT_OK;
+    LIB_COMM_PACK_Sticks_t local_Sticks_t = {0};
+    uint8_t local_u8Payload[NRF_PAYLOAD_LEN] = {0};
+    uint8_t local_u8PayloadLen = 0;
+    uint8_t local_u8Number = 0;
+    uint8_t local_u8Gap = 1;
+
+    // the packets are moved from the module by HAL_WRAPPER_RCService when its IRQ pin fires
+    local_u8PayloadLen = NRF_read((void*)local_u8Payload, sizeof(local_u8Payload));
+    if (local_u8PayloadLen) 
     {
-        local_errState_t = HAL_WRAPPER_STAT_DRONE_BOARD_BSY;
+        if(LIB_COMM_PACK_u8UnpackSticks(local_u8Payload, local_u8PayloadLen, &local_Sticks_t))
+        {
+            arg_pMsg_t->MsgToReceive.type = DATA_TYPE_MOVE;
+            arg_pMsg_t->MsgToReceive.data.move.roll = local_Sticks_t.roll;
+            arg_pMsg_t->MsgToReceive.data.move.pitch = local_Sticks_t.pitch;
+            arg_pMsg_t->MsgToReceive.data.move.thrust = local_Sticks_t.thrust;
+            arg_pMsg_t->MsgToReceive.data.move.yaw = local_Sticks_t.yaw;
+            arg_pMsg_t->MsgToReceive.data.move.turnOnLeds = (0 != (local_Sticks_t.flags & LIB_COMM_PACK_FLAG_LEDS));
+            arg_pMsg_t->MsgToReceive.data.move.playMusic = (0 != (local_Sticks_t.flags & LIB_COMM_PACK_FLAG_MUSIC));
+            arg_pMsg_t->MsgToReceive.data.move.startDrone = (0 != (local_Sticks_t.flags & LIB_COMM_PACK_FLAG_START));
+
+            // the gap to the number of the last received command is the commands sent since then, 0 is a full wrap as the radio
+            // drops the copies of a received command
+            local_u8Number = (local_Sticks_t.link >> LIB_COMM_PACK_LINK_NUMBER_SHIFT) & LIB_COMM_PACK_LINK_NUMBER_MASK;
+            if(global_s16RCLinkNumber >= 0)
+            {
+                local_u8Gap = (local_u8Number - global_s16RCLinkNumber) & LIB_COMM_PACK_LINK_NUMBER_MASK;
+                if(0 == local_u8Gap)
+                    local_u8Gap = LIB_COMM_PACK_LINK_NUMBER_MASK + 1;
+            }
+            global_s16RCLinkNumber = local_u8Number;
+
+            // the remote control reports the retransmits of the command before this one
+            global_RCLinkStats_t.acked++;
+            global_RCLinkStats_t.retransmits += local_Sticks_t.link & LIB_COMM_PACK_LINK_RETRANSMITS_MASK;
+            global_RCLinkStats_t.sent += local_u8Gap;
+            global_RCLinkStats_t.lost += local_u8Gap - 1;
+        }
+        else
+        {
+            // a packet of another message, nothing to take
+            local_errState_t = HAL_WRAPPER_STAT_RC_DIDNT_SND;
+        }
     }
     else
     {
-        local_errState_t = HAL_WRAPPER_STAT_OK;
+        local_errState_t = HAL_WRAPPER_STAT_RC_DIDNT_SND;
     }
-
+    
     return local_errState_t;
 }
 
 /**
  * 
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCSend(HAL_WRAPPER_RCMsg_t* arg_pMsg_t)
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetRCTask(RTOS_TaskHandle_t arg_Task_t)
 {
-    HAL_WRAPPER_ErrStat_t local_errState_t = HAL_WRAPPER_STAT_OK;
-    NRF_write((void*)&arg_pMsg_t->MsgToSend, sizeof(arg_pMsg_t->MsgToSend));
-    return local_errState_t; 
+    MCAL_WRAPPER_SetRadioTask(arg_Task_t);
+    return HAL_WRAPPER_STAT_OK;
 }
 
 /**
  * 
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCReceive(HAL_WRAPPER_RCMsg_t* arg_pMsg_t)
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCService(void)
 {
-    HAL_WRAPPER_ErrStat_t local_errState_t = HAL_WRAPPER_STAT_OK;
+    NRF_process();
+    return HAL_WRAPPER_STAT_OK;
+}
 
-    NRF_start_listening();
-    if (NRF_data_available()) 
-    {
-        NRF_read((void*)&arg_pMsg_t->MsgToReceive, sizeof(arg_pMsg_t->MsgToReceive));
-    }
-    else
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetRCLinkStats(HAL_WRAPPER_RCLinkStats_t* arg_pStats)
+{
+    NRF_stats_t local_Radio_t = {0};
+
+    if(NULL == arg_pStats)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+
+    NRF_get_stats(&local_Radio_t);
+    global_RCLinkStats_t.telemetrySent = local_Radio_t.tx_packets;
+    global_RCLinkStats_t.rxOverflows = local_Radio_t.rx_overflows;
+    *arg_pStats = global_RCLinkStats_t;
+
+    return HAL_WRAPPER_STAT_OK;
+}
+
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCSendLink(void)
+{
+    LIB_COMM_PACK_Link_t local_Link_t = {0};
+    uint8_t local_u8Payload[LIB_COMM_PACK_LINK_LEN] = {0};
+    uint32_t local_u32Sent = global_RCLinkStats_t.sent - global_RCLinkSent_t.sent;
+    uint32_t local_u32Acked = global_RCLinkStats_t.acked - global_RCLinkSent_t.acked;
+    uint32_t local_u32Value = 0;
+
+    // quality over the window since the last link message
+    if(local_u32Sent)
+        local_Link_t.quality = (uint8_t)((local_u32Acked * 100) / local_u32Sent);
+    if(local_u32Acked)
     {
-        local_errState_t = HAL_WRAPPER_STAT_RC_DIDNT_SND;
+        local_u32Value = ((global_RCLinkStats_t.retransmits - global_RCLinkSent_t.retransmits) * 10) / local_u32Acked;
+        local_Link_t.retransmits = (local_u32Value > 255) ? 255 : (uint8_t)local_u32Value;
     }
-    NRF_stop_listening();
-    
-    return local_errState_t;
+    local_u32Value = global_RCLinkStats_t.lost - global_RCLinkSent_t.lost;
+    local_Link_t.lost = (local_u32Value > 255) ? 255 : (uint8_t)local_u32Value;
+    global_RCLinkSent_t = global_RCLinkStats_t;
+
+    if(!NRF_write((void*)local_u8Payload, LIB_COMM_PACK_u8PackLink(&local_Link_t, local_u8Payload)))
+        return HAL_WRAPPER_STAT_RC_BSY;
+
+    return HAL_WRAPPER_STAT_OK;
 }
 
 /*************** END OF FUNCTIONS ***************************************************************************/
@@ -41,6 +41,19 @@
  * |    18/06/2023      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
  * |    20/06/2023      1.0.0           Abdelrahman Mohamed Salem       added 'HAL_WRAPPER_DisableEnableAppCommRecCallBack'.            |
  * |    20/06/2023      1.0.0           Abdelrahman Mohamed Salem       added 'HAL_WRAPPER_GetCommMessage'.                             |    
+ * |    17/10/2026      1.1.0           agent                           replaced the UART4 receive callback functions and               |
+ * |                                                                    'HAL_WRAPPER_GetCommMessage' by 'HAL_WRAPPER_SetAppCommRecTask' |
+ * |                                                                    and 'HAL_WRAPPER_GetCommFrame'.                                 |
+ * |    17/10/2026      1.2.0           agent                           replaced 'HAL_WRAPPER_SendCommMessage' by the DMA frame         |
+ * |                                                                    transmitter 'HAL_WRAPPER_SendCommFrame' and added               |
+ * |                                                                    'HAL_WRAPPER_GetCommTxStats'.                                   |
+ * |    17/10/2026      1.3.0           agent                           the messages of the remote control are packed with comm_pack.h  |
+ * |    17/10/2026      1.4.0           agent                           added 'HAL_WRAPPER_SetRCTask' and 'HAL_WRAPPER_RCService', the  |
+ * |                                                                    remote control is served from the IRQ pin of the radio.         |
+ * |    17/10/2026      1.5.0           agent                           the telemetry is sent in the acknowledges of the remote         |
+ * |                                                                    control.                                                        |
+ * |    17/10/2026      1.6.0           agent                           added 'HAL_WRAPPER_RCLinkStats_t', 'HAL_WRAPPER_GetRCLinkStats' |
+ * |                                                                    and 'HAL_WRAPPER_RCSendLink'.                                   |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -67,6 +80,16 @@
  */
 #include "common.h"
 
+/**
+ * @reason: contains definition of the task handle notified by the comm port
+ */
+#include "Service_RTOS_wrapper.h"
+
+/**
+ * @reason: contains the frames and counters of the DMA transmitter of the comm port
+ */
+#include "MCAL_UART.h"
+
 /**
  * @reason: contains some constants definitions
  */
@@ -86,6 +109,12 @@
  * Configuration Constants
  *******************************************************************************/
 
+/**
+ * @brief: a message with all the telemetry is sent to the remote control every HAL_WRAPPER_RC_INFO_KEYFRAME_PERIOD messages,
+ *         the others only carry what changed since (refer to 'LIB_COMM_PACK_u8PackInfo'), 1 sends all the telemetry every time
+ */
+#define HAL_WRAPPER_RC_INFO_KEYFRAME_PERIOD     (4)
+
 /******************************************************************************
  * Macros
  *******************************************************************************/
@@ -103,8 +132,19 @@ typedef enum {
   HAL_WRAPPER_STAT_DRONE_BOARD_BSY,
   HAL_WRAPPER_STAT_DRONE_DIDNT_SND,
   HAL_WRAPPER_STAT_RC_DIDNT_SND,
+  HAL_WRAPPER_STAT_RC_BSY,
 } HAL_WRAPPER_ErrStat_t;
 
+/**
+ * @brief: a frame sent to the other board, refer to @MCAL_UART_TxFrame_t in "MCAL_UART.h"
+ */
+typedef MCAL_UART_TxFrame_t HAL_WRAPPER_CommFrame_t;
+
+/**
+ * @brief: counters of the frames sent to the other board, refer to @MCAL_UART_TxStats_t in "MCAL_UART.h"
+ */
+typedef MCAL_UART_TxStats_t HAL_WRAPPER_CommTxStats_t;
+
 /**
  * @brief: contains definitions to be used with communication with app board
  */
@@ -128,6 +168,19 @@ typedef struct
   data_t MsgToReceive;                  /**< to indicate we received something */
 } HAL_WRAPPER_RCMsg_t;
 
+/**
+ * @brief: counters of the radio link with the remote control since boot, the retransmits and losses are the ones the remote
+ *         control reports in its commands as only the sending end sees them
+ */
+typedef struct {
+  uint32_t sent;                    /**< commands the remote control sent, from their numbers */
+  uint32_t acked;                   /**< commands received */
+  uint32_t retransmits;             /**< retransmits of the commands before the received ones (OBSERVE_TX of the remote control) */
+  uint32_t lost;                    /**< commands that didn't arrive */
+  uint32_t telemetrySent;           /**< telemetry and link messages sent in the acknowledges */
+  uint32_t rxOverflows;             /**< commands dropped as the receive queue of the radio was full */
+} HAL_WRAPPER_RCLinkStats_t;
+
 /******************************************************************************
  * Variables
  *******************************************************************************/
@@ -136,77 +189,31 @@ typedef struct
  * Function Prototypes
  *******************************************************************************/
 
-/**
- *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecCallBack(functionCallBack_t *arg_pUARTCallBack);
- *  \b Description                              :       this functions is used as a wrapper function to set callback function to execute when board receives anything on its uart interface with App board.
- *  @param  arg_pUARTCallBack [INT]             :       base address of function to be executed when board receives anything.
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       Callback function is assigned to be executed whenever board receives anything.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
- *
- *  \b Example:
- * @code
- * 
- * #include "HAL_wrapper.h"
- * 
- * void func(void)
- * {
- *  // callback code
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllPins();
- *  if(HAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = HAL_WRAPPER_SetAppCommRecCallBack(func);
- *    if(HAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *    
- *    }
- *  }
- * }
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 18/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecCallBack(functionCallBack_t arg_pUARTCallBack);
 
 /**
- *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_DisableEnableAppCommRecCallBack(LIB_CONSTANTS_DriverStates_t arg_Enable_Disable_t);
- *  \b Description                              :       this functions is used as a wrapper function to set callback function to enable/disable app board byte received interrupt.
- *  @param arg_Enable_Disable_t [IN]            :       to enable or disable the interrupt, refer to @LIB_CONSTANTS_DriverStates_t in "constants.h".
- *  @note                                       :       None.
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecTask(RTOS_TaskHandle_t arg_Task_t);
+ *  \b Description                              :       this functions is used as a wrapper function to set the task notified when the other board sends something.
+ *  @param  arg_Task_t [IN]                     :       handle of the task to notify, it's notified once a burst of bytes ends (idle line on the comm port).
+ *  @note                                       :       the bytes are received by DMA, the task can sleep until it's notified.
  *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       app board receive interrupt is enabled/disabled.
+ *  \b POST-CONDITION                           :       None.
  *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommFrame(uint8_t* arg_pu8Frame, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len)
  *
  *  \b Example:
  * @code
  * 
  * #include "HAL_wrapper.h"
  * 
- * void func(void)
+ * void task(void)
  * {
- *  // callback code
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllPins();
- *  if(HAL_Config_STAT_OK == local_errState)
+ *  RTOS_TaskHandle_t local_task_t = NULL;
+ *  SERVICE_RTOS_GetCurrentTaskHandle(&local_task_t);
+ *  HAL_WRAPPER_SetAppCommRecTask(local_task_t);
+ *  while(1)
  *  {
- *    local_errState = HAL_WRAPPER_DisableEnableAppCommRecCallBack(LIB_CONSTANTS_ENABLED);
- *    if(HAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *    
- *    }
+ *    SERVICE_RTOS_WaitForNotification(1000);
+ *    // read the received bytes with HAL_WRAPPER_GetCommFrame
  *  }
  * }
  * @endcode
@@ -214,167 +221,127 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecCallBack(functionCallBack_t arg_p
  * <br><b> - HISTORY OF CHANGES - </b>
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 20/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
  * </table><br><br>
  * <hr>
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_DisableEnableAppCommRecCallBack(LIB_CONSTANTS_DriverStates_t arg_Enable_Disable_t);
-
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecTask(RTOS_TaskHandle_t arg_Task_t);
 
 /**
- *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReceiveSendAppCommMessage(HAL_WRAPPER_AppCommMsg_t* arg_AppCommMsg_t);
- *  \b Description                              :       this functions is used as a wrapper function to set receive and send messages with App board.
- *  @param  arg_AppCommMsg_t [IN][OUT]          :       base address of function to be executed when board receives anything, refer to @HAL_WRAPPER_AppCommMsg_t in "HAL_wrapper.h".
- *  @note                                       :       None.
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommFrame(uint8_t* arg_pu8Frame, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len);
+ *  \b Description                              :       this functions is used as a wrapper function to get the bytes received from the other board up to the
+ *                                                      end of the last burst.
+ *  @param  arg_pu8Frame [OUT]                  :       base address to copy the received bytes to.
+ *  @param  arg_u16MaxLen [IN]                  :       size of 'arg_pu8Frame', the rest is returned by the next call.
+ *  @param  arg_pu16Len [OUT]                   :       number of copied bytes.
+ *  @note                                       :       a message may be split over two calls if it's sent with a pause in the middle.
  *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       a message is exchanged between the 2 boards.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       HAL_WRAPPER_STAT_APP_DIDNT_SND if nothing was received, else HAL_WRAPPER_STAT_OK (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecTask(RTOS_TaskHandle_t arg_Task_t)
  *
  *  \b Example:
  * @code
  * 
  * #include "HAL_wrapper.h"
  * 
- * void func(void)
+ * uint8_t local_u8Frame[32];
+ * uint16_t local_u16Len = 0;
+ * while(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_GetCommFrame(local_u8Frame, sizeof(local_u8Frame), &local_u16Len))
  * {
- *  // callback code
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllPins();
- *  if(HAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = HAL_WRAPPER_SetAppCommRecCallBack(func);
- *    if(HAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *      uint8_t dataSend[] = [3, 4];
- *      uint8_t dataRec[] = [1, 2];
- *      HAL_WRAPPER_AppCommMsg_t temp = {
- *        .dataToSend=dataSend,
- *        .dataToReceive=dataRec, 
- *        .dataToSendLen=2,
- *        .dataToReceiveLen=2,
- *        .dataIsToReceive=1
- *        .dataIsToSend=1
- *      };
- *      local_errState = HAL_WRAPPER_ReceiveSendAppCommMessage(&temp);
- *    }
- *  }
+ *   // parse local_u16Len bytes
  * }
  * @endcode
  *
  * <br><b> - HISTORY OF CHANGES - </b>
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 18/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
  * </table><br><br>
  * <hr>
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReceiveSendAppCommMessage(HAL_WRAPPER_AppCommMsg_t* arg_AppCommMsg_t);
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommFrame(uint8_t* arg_pu8Frame, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len);
 
 /**
- *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommMessage(uint8_t* arg_pu8Msg);
- *  \b Description                              :       this functions is used as a wrapper function to get  of received message.
- *  @param  arg_pu8Msg [OUT]                    :       base address of variable to put inside it the  of message received.
- *  @note                                       :       it reads a byte from UART to know if it's a valid message header or not.
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommFrame(HAL_WRAPPER_CommFrame_t* arg_pFrame);
+ *  \b Description                              :       this functions is used as a wrapper function to queue a frame to the other board, the frame is sent by DMA
+ *                                                      from its own memory and its callback is called once it's sent.
+ *  @param  arg_pFrame [IN/OUT]                 :       the frame to send (refer to @MCAL_UART_TxFrame_t in "MCAL_UART.h").
+ *  @note                                       :       the frame and its data must stay untouched until its callback is called, the callback runs in an interrupt.
  *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
  *  \b POST-CONDITION                           :       None.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
+ *  @return                                     :       HAL_WRAPPER_STAT_DRONE_BOARD_BSY if the transmit queue is full, else one of error states (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommTxStats(HAL_WRAPPER_CommTxStats_t* arg_pStats)
  *
  *  \b Example:
  * @code
  * 
  * #include "HAL_wrapper.h"
  * 
- * void func(void)
+ * void sent(HAL_WRAPPER_CommFrame_t* frame)
  * {
- *  // callback code
- *  uint8_t message;
- *  HAL_WRAPPER_GetCommMessage(&message);
- *  if(DATA_TYPE_INFO == message)
- *  {
- *    // a info message header is received
- *  }
+ *   // the buffer of the frame can be filled again
  * }
  * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllPins();
- *  if(HAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = HAL_WRAPPER_SetAppCommRecCallBack(func);
- *    if(HAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *    
- *    }
- *  }
+ * uint8_t message[8];
+ * HAL_WRAPPER_CommFrame_t frame = {.data = message, .dataLen = sizeof(message), .callBack = sent};
+ * HAL_WRAPPER_ErrStat_t local_errState = HAL_WRAPPER_SendCommFrame(&frame);
+ * if(HAL_WRAPPER_STAT_OK == local_errState)
+ * {
+ *   // message is being sent
  * }
  * @endcode
  *
  * <br><b> - HISTORY OF CHANGES - </b>
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 20/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
  * </table><br><br>
  * <hr>
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommMessage(uint8_t* arg_pu8Msg);
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommFrame(HAL_WRAPPER_CommFrame_t* arg_pFrame);
 
 /**
- *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommMessage(uint8_t arg_pu8Msg);
- *  \b Description                              :       this functions is used as a wrapper function to send 1 byte of message.
- *  @param  arg_pu8Msg [IN]                     :       value of data to send to the comm gateway with the other board.
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommTxStats(HAL_WRAPPER_CommTxStats_t* arg_pStats);
+ *  \b Description                              :       this functions is used as a wrapper function to get the counters of the frames sent to the other board
+ *                                                      (count, bytes, time the link was busy and latency).
+ *  @param  arg_pStats [OUT]                    :       base address to store the counters in.
  *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
+ *  \b PRE-CONDITION                            :       None.
  *  \b POST-CONDITION                           :       None.
  *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommFrame(HAL_WRAPPER_CommFrame_t* arg_pFrame)
  *
  *  \b Example:
  * @code
  * 
  * #include "HAL_wrapper.h"
  * 
- * void func(void)
- * {
- *  // callback code
- *  uint8_t message = 22;
- *  HAL_WRAPPER_ErrStat_t local_errState = HAL_WRAPPER_SendCommMessage(message);
- *  if(HAL_WRAPPER_STAT_OK == local_errState)
- *  {
- *    // message is send
- *  }
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllPins();
- *  if(HAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = HAL_WRAPPER_SetAppCommRecCallBack(func);
- *    if(HAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *    
- *    }
- *  }
- * }
+ * HAL_WRAPPER_CommTxStats_t stats = {0};
+ * HAL_WRAPPER_GetCommTxStats(&stats);
+ * printf("sent %lu bytes, max latency %lu us\r\n", stats.bytes, stats.maxLatencyUS);
  * @endcode
  *
  * <br><b> - HISTORY OF CHANGES - </b>
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 20/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
  * </table><br><br>
  * <hr>
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommMessage(uint8_t arg_pu8Msg);
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommTxStats(HAL_WRAPPER_CommTxStats_t* arg_pStats);
 
 
 /**
  *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommMessage(uint8_t arg_pu8Msg);
  *  \b Description                              :       this functions is used as a wrapper function to send data to the remote control.
  *  @param  arg_pMsg_t [IN]                     :       value of data to send to the RC via RF interface. refer to @HAL_WRAPPER_RCMsg_t in "HAL_wrapper.h"
- *  @note                                       :       None.
+ *  @note                                       :       only the telemetry (type DATA_TYPE_INFO) is sent, packed with LIB_COMM_PACK_u8PackInfo in
+ *                                                      a full message every HAL_WRAPPER_RC_INFO_KEYFRAME_PERIOD messages and the fields
+ *                                                      that changed in the others.
+ *                                                      the packet is queued and sent by HAL_WRAPPER_RCService in the acknowledge of the next command
+ *                                                      of the remote control (ACK payload), HAL_WRAPPER_STAT_RC_BSY is returned if the transmit
+ *                                                      queue of the radio is full.
  *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
  *  \b POST-CONDITION                           :       None.
  *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
@@ -392,6 +359,7 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommMessage(uint8_t arg_pu8Msg);
  *  {
  *    HAL_WRAPPER_RCMsg_t temp = {
  *      .MsgToSend={
+ *        .type=DATA_TYPE_INFO,
  *        .data={
  *          .info={
  *            .distanceToOrigin=12.2,
@@ -415,6 +383,9 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommMessage(uint8_t arg_pu8Msg);
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
  * <tr><td> 24/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.1.0            </td><td> agent    </td><td> Telemetry sent packed </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.2.0            </td><td> agent    </td><td> Queued without blocking </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.3.0            </td><td> agent    </td><td> Sent as an ACK payload </td></tr>
  * </table><br><br>
  * <hr>
  */
@@ -425,7 +396,9 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCSend(HAL_WRAPPER_RCMsg_t* arg_pMsg_t);
  *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCReceive(HAL_WRAPPER_RCMsg_t* arg_pMsg_t);
  *  \b Description                              :       this functions is used as a wrapper function to receive data from the remote control.
  *  @param  arg_pMsg_t [OUT]                    :       value of data to receive from the RC via RF interface. refer to @HAL_WRAPPER_RCMsg_t in "HAL_wrapper.h"
- *  @note                                       :       None.
+ *  @note                                       :       the packet is unpacked with LIB_COMM_PACK_u8UnpackSticks, a packet of another message
+ *                                                      returns HAL_WRAPPER_STAT_RC_DIDNT_SND.
+ *                                                      it takes the packets already received by HAL_WRAPPER_RCService and doesn't wait.
  *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
  *  \b POST-CONDITION                           :       None.
  *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
@@ -455,11 +428,149 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCSend(HAL_WRAPPER_RCMsg_t* arg_pMsg_t);
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
  * <tr><td> 24/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.1.0            </td><td> agent    </td><td> Sticks received packed </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.2.0            </td><td> agent    </td><td> Reads the receive queue </td></tr>
  * </table><br><br>
  * <hr>
  */
 HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCReceive(HAL_WRAPPER_RCMsg_t* arg_pMsg_t);
 
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetRCTask(RTOS_TaskHandle_t arg_Task_t);
+ *  \b Description                              :       this functions is used as a wrapper function to set the task notified when the radio received, sent or
+ *                                                      lost a packet (the IRQ pin of the NRF24L01).
+ *  @param  arg_Task_t [IN]                     :       handle of the task to notify, it must be the task that calls HAL_WRAPPER_RCService.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCService(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * void task(void)
+ * {
+ *  HAL_WRAPPER_RCMsg_t local_msg_t;
+ *  RTOS_TaskHandle_t local_task_t = NULL;
+ *  SERVICE_RTOS_GetCurrentTaskHandle(&local_task_t);
+ *  HAL_WRAPPER_SetRCTask(local_task_t);
+ *  while(1)
+ *  {
+ *    SERVICE_RTOS_WaitForNotification(20);
+ *    HAL_WRAPPER_RCService();
+ *    while(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_RCReceive(&local_msg_t))
+ *    {
+ *      // use the command
+ *    }
+ *  }
+ * }
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetRCTask(RTOS_TaskHandle_t arg_Task_t);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCService(void);
+ *  \b Description                              :       this functions is used as a wrapper function to serve the radio: the received packets are queued for
+ *                                                      HAL_WRAPPER_RCReceive and the next queued packet is sent (refer to NRF_process in "nrf.h").
+ *  @param  void [IN]                           :       None.
+ *  @note                                       :       it's called when the task set by HAL_WRAPPER_SetRCTask is notified and when its wait times out.
+ *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
+ *  \b POST-CONDITION                           :       the radio is sending or listening.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetRCTask(RTOS_TaskHandle_t arg_Task_t)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * SERVICE_RTOS_WaitForNotification(20);
+ * HAL_WRAPPER_RCService();
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCService(void);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetRCLinkStats(HAL_WRAPPER_RCLinkStats_t* arg_pStats);
+ *  \b Description                              :       this functions is used as a wrapper function to get the counters of the radio link with the remote control.
+ *  @param  arg_pStats [OUT]                    :       base address to store the counters in.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCSendLink(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * HAL_WRAPPER_RCLinkStats_t stats = {0};
+ * if(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_GetRCLinkStats(&stats))
+ * {
+ *   printf("lost %lu of %lu, retransmits %lu\r\n", stats.lost, stats.sent, stats.retransmits);
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetRCLinkStats(HAL_WRAPPER_RCLinkStats_t* arg_pStats);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCSendLink(void);
+ *  \b Description                              :       this functions is used as a wrapper function to send the quality of the radio link since the last call to the
+ *                                                      remote control in a link message (refer to LIB_COMM_PACK_Link_t in "comm_pack.h").
+ *  @param  void [IN]                           :       None.
+ *  @note                                       :       it's queued with the telemetry and sent in the acknowledge of a command, the remote control shows
+ *                                                      it and the window is the time between the calls.
+ *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       HAL_WRAPPER_STAT_RC_BSY if the transmit queue of the radio is full, else HAL_WRAPPER_STAT_OK
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetRCLinkStats(HAL_WRAPPER_RCLinkStats_t* arg_pStats)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * // every second
+ * HAL_WRAPPER_RCSendLink();
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_RCSendLink(void);
+
 
 /*** End of File **************************************************************/
 #endif /*HAL_WRAPPER_HEADER_H_*/
@@ -0,0 +1,620 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   compact messages of the drone links                                                                         |
+ * |    @file           :   comm_pack.h                                                                                                 |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   commands and telemetry packed in scaled integers and bit flags, shared by the boards and the remote         |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           the sticks carry the retransmits and losses seen by the remote  |
+ * |                                                                    control, added the link message.                                |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef LIB_COMM_PACK_H_
+#define LIB_COMM_PACK_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains standard integer types
+ */
+#include "stdint.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: first byte of every message, tells the receiver how to unpack the rest
+ */
+#define LIB_COMM_PACK_TYPE_STICKS           (0x5A)  /**< stick positions, from the remote control to the app board */
+#define LIB_COMM_PACK_TYPE_MOVE             (0x55)  /**< setpoints, from the app board to the drone board */
+#define LIB_COMM_PACK_TYPE_INFO             (0xA8)  /**< all the telemetry fields (a keyframe), from the drone to the remote control */
+#define LIB_COMM_PACK_TYPE_INFO_DELTA       (0xA4)  /**< the telemetry fields that changed since the last keyframe */
+#define LIB_COMM_PACK_TYPE_LINK             (0xB0)  /**< quality of the radio link seen by the app board, to the remote control */
+
+/**
+ * @brief: bits of the flags byte of the sticks and move messages
+ */
+#define LIB_COMM_PACK_FLAG_START            (0x01)
+#define LIB_COMM_PACK_FLAG_LEDS             (0x02)
+#define LIB_COMM_PACK_FLAG_MUSIC            (0x04)
+
+/**
+ * @brief: fields of the link byte of the sticks message, the remote control reports the retransmits as it's the only end
+ *         that sees them (OBSERVE_TX) and numbers the commands, the gaps in the numbers are the commands that didn't arrive
+ *         (a command that arrives with all its acknowledges lost is only lost for the remote control)
+ *         - retransmits : retransmits the command before this one needed (ARC_CNT)
+ *         - number      : number of the command, wrapping at 16
+ */
+#define LIB_COMM_PACK_LINK_RETRANSMITS_MASK (0x0F)
+#define LIB_COMM_PACK_LINK_NUMBER_SHIFT     (4)
+#define LIB_COMM_PACK_LINK_NUMBER_MASK      (0x0F)
+
+/**
+ * @brief: length of the messages in bytes
+ *         - sticks     : [type, flags, roll, pitch, thrust, yaw] as int8 then [link]
+ *         - move       : [type, flags, roll, pitch, thrust, yaw] as int16 little endian in 1/LIB_COMM_PACK_MOVE_SCALE
+ *         - info       : [type, keyframe, distance (uint16), altitude (int16), temperature (int16), battery (uint8)]
+ *         - info delta : [type, keyframe, mask, changed fields], bit 'i' of the mask is set if field 'i' is sent and bit 'i + 4'
+ *                        if it's sent as an int8 difference from its value in the last keyframe instead of its full width
+ *         - link       : [type, quality, retransmits, lost]
+ *         'keyframe' is the number (modulo 256) of the keyframe the info message is or belongs to, a receiver that lost
+ *         keyframes drops the delta messages of the next one instead of applying them to an older one
+ */
+#define LIB_COMM_PACK_STICKS_LEN            (7)
+#define LIB_COMM_PACK_MOVE_LEN              (10)
+#define LIB_COMM_PACK_INFO_LEN              (9)
+#define LIB_COMM_PACK_INFO_DELTA_MIN_LEN    (3)
+#define LIB_COMM_PACK_LINK_LEN              (4)
+
+/**
+ * @brief: longest message sent over the radio link (sticks, info or link), the payload size of both ends of the radio link
+ */
+#define LIB_COMM_PACK_RADIO_LEN             (LIB_COMM_PACK_INFO_LEN)
+
+/**
+ * @brief: fields of the telemetry in the order they are packed, index of their bit in the mask of the info delta message
+ */
+#define LIB_COMM_PACK_INFO_DISTANCE         (0)
+#define LIB_COMM_PACK_INFO_ALTITUDE         (1)
+#define LIB_COMM_PACK_INFO_TEMPERATURE      (2)
+#define LIB_COMM_PACK_INFO_BATTERY          (3)
+#define LIB_COMM_PACK_INFO_FIELDS           (4)
+
+/**
+ * @brief: range of the packed fields, "stdint.h" of the boards doesn't have the minimum values
+ */
+#define LIB_COMM_PACK_S8_MIN                (-128)
+#define LIB_COMM_PACK_S8_MAX                (127)
+#define LIB_COMM_PACK_S16_MIN               (-32768)
+#define LIB_COMM_PACK_S16_MAX               (32767)
+#define LIB_COMM_PACK_U16_MAX               (65535)
+
+/******************************************************************************
+ * Configuration Constants
+ *******************************************************************************/
+
+/**
+ * @brief: resolution of the fields, a value is sent as round(value * scale) so the error of a field within its range is at
+ *         most 0.5 / scale
+ *         - move        : roll, pitch, yaw in 0.01 degree and thrust in 0.01 unit, range +/-327.67
+ *         - distance    : 0.01 m, range 0 to 655.35 m
+ *         - altitude    : 0.01 m, range +/-327.67 m
+ *         - temperature : 0.01 degree celsius, range +/-327.67
+ */
+#define LIB_COMM_PACK_MOVE_SCALE            (100.0f)
+#define LIB_COMM_PACK_DISTANCE_SCALE        (100.0f)
+#define LIB_COMM_PACK_ALTITUDE_SCALE        (100.0f)
+#define LIB_COMM_PACK_TEMPERATURE_SCALE     (100.0f)
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/**
+ * @brief: the remote control builds this file without "common.h"
+ */
+#ifndef __in
+#define __in inline
+#endif
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: positions of the sticks of the remote control, from -64 to 64
+ */
+typedef struct {
+  int8_t roll;
+  int8_t pitch;
+  int8_t thrust;
+  int8_t yaw;
+  uint8_t flags;                    /**< LIB_COMM_PACK_FLAG_x bits */
+  uint8_t link;                     /**< LIB_COMM_PACK_LINK_x fields */
+} LIB_COMM_PACK_Sticks_t;
+
+/**
+ * @brief: setpoints sent to the drone, angles in degrees
+ */
+typedef struct {
+  float roll;
+  float pitch;
+  float thrust;
+  float yaw;
+  uint8_t flags;                    /**< LIB_COMM_PACK_FLAG_x bits */
+} LIB_COMM_PACK_Move_t;
+
+/**
+ * @brief: telemetry of the drone
+ */
+typedef struct {
+  float distanceToOrigin;           /**< in m */
+  float altitude;                   /**< in m */
+  float temperature;                /**< in degree celsius */
+  uint8_t batteryCharge;            /**< in percent */
+} LIB_COMM_PACK_Info_t;
+
+/**
+ * @brief: quality of the radio link over the last window
+ */
+typedef struct {
+  uint8_t quality;                  /**< percent of the commands that were acknowledged */
+  uint8_t retransmits;              /**< retransmits per acknowledged command in tenths, saturated */
+  uint8_t lost;                     /**< commands lost, saturated */
+} LIB_COMM_PACK_Link_t;
+
+/**
+ * @brief: state of one end of a telemetry stream, the sender and the receiver each keep the values of the last keyframe
+ *         to build or apply the info delta messages
+ */
+typedef struct {
+  int32_t keyframe[LIB_COMM_PACK_INFO_FIELDS];  /**< values of the fields in the last keyframe in their packed units */
+  uint8_t valid;                    /**< 'keyframe' holds the values of a full info message */
+  uint8_t keyframeId;               /**< number of the last keyframe, modulo 256 */
+  uint8_t keyframePeriod;           /**< sender: a full info message is sent every 'keyframePeriod' messages, 1 disables the deltas */
+  uint8_t sinceKeyframe;            /**< sender: messages sent since the last keyframe */
+  uint32_t dropped;                 /**< receiver: info delta messages dropped as the keyframe they belong to wasn't received */
+} LIB_COMM_PACK_InfoState_t;
+
+/******************************************************************************
+ * Variables
+ *******************************************************************************/
+
+/**
+ * @brief: width in bytes of the telemetry fields in their full form
+ */
+static const uint8_t LIB_COMM_PACK_InfoWidth[LIB_COMM_PACK_INFO_FIELDS] = {2, 2, 2, 1};
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                     :       static __in int32_t LIB_COMM_PACK_s32Quantize(float args_f32Value, float args_f32Scale, int32_t args_s32Min, int32_t args_s32Max)
+ *  \b Description                  :       rounds 'value * scale' to the nearest integer and saturates it to the range of the field, the
+ *                                          range must hold 0.
+ *  @param    args_f32Value         :       the value to quantize.
+ *  @param    args_f32Scale         :       steps per unit of the value.
+ *  @param    args_s32Min           :       lowest value of the field.
+ *  @param    args_s32Max           :       highest value of the field.
+ *  @return                         :       the quantized value.
+ */
+static __in int32_t LIB_COMM_PACK_s32Quantize(float args_f32Value, float args_f32Scale, int32_t args_s32Min, int32_t args_s32Max)
+{
+    float local_f32Scaled = args_f32Value * args_f32Scale;
+
+    // a NaN fails every comparison, send it as 0 rather than one of the ends of the range
+    if(local_f32Scaled != local_f32Scaled)
+    {
+        return 0;
+    }
+    if(local_f32Scaled <= (float)args_s32Min)
+    {
+        return args_s32Min;
+    }
+    if(local_f32Scaled >= (float)args_s32Max)
+    {
+        return args_s32Max;
+    }
+    return (int32_t)(local_f32Scaled + (local_f32Scaled >= 0 ? 0.5f : -0.5f));
+}
+
+/**
+ *  \b function                     :       static __in void LIB_COMM_PACK_vidPut16(uint8_t* args_pu8Buffer, int32_t args_s32Value)
+ *  \b Description                  :       writes the low 16 bits of a value in little endian.
+ *  @param    args_pu8Buffer        :       where to write the 2 bytes.
+ *  @param    args_s32Value         :       the value.
+ */
+static __in void LIB_COMM_PACK_vidPut16(uint8_t* args_pu8Buffer, int32_t args_s32Value)
+{
+    args_pu8Buffer[0] = (uint8_t)(args_s32Value & 0xFF);
+    args_pu8Buffer[1] = (uint8_t)((args_s32Value >> 8) & 0xFF);
+}
+
+/**
+ *  \b function                     :       static __in int16_t LIB_COMM_PACK_s16Get16(const uint8_t* args_pu8Buffer)
+ *  \b Description                  :       reads a signed 16 bits value written by LIB_COMM_PACK_vidPut16.
+ *  @param    args_pu8Buffer        :       where to read the 2 bytes from.
+ *  @return                         :       the value.
+ */
+static __in int16_t LIB_COMM_PACK_s16Get16(const uint8_t* args_pu8Buffer)
+{
+    return (int16_t)((uint16_t)args_pu8Buffer[0] | ((uint16_t)args_pu8Buffer[1] << 8));
+}
+
+/**
+ *  \b function                     :       static __in uint8_t LIB_COMM_PACK_u8PackSticks(const LIB_COMM_PACK_Sticks_t* args_pSticks, uint8_t* args_pu8Buffer)
+ *  \b Description                  :       packs the positions of the sticks in a sticks message.
+ *  @param    args_pSticks          :       the positions of the sticks.
+ *  @param    args_pu8Buffer        :       buffer of at least LIB_COMM_PACK_STICKS_LEN bytes for the message.
+ *  @return                         :       length of the message.
+ */
+static __in uint8_t LIB_COMM_PACK_u8PackSticks(const LIB_COMM_PACK_Sticks_t* args_pSticks, uint8_t* args_pu8Buffer)
+{
+    args_pu8Buffer[0] = LIB_COMM_PACK_TYPE_STICKS;
+    args_pu8Buffer[1] = args_pSticks->flags;
+    args_pu8Buffer[2] = (uint8_t)args_pSticks->roll;
+    args_pu8Buffer[3] = (uint8_t)args_pSticks->pitch;
+    args_pu8Buffer[4] = (uint8_t)args_pSticks->thrust;
+    args_pu8Buffer[5] = (uint8_t)args_pSticks->yaw;
+    args_pu8Buffer[6] = args_pSticks->link;
+
+    return LIB_COMM_PACK_STICKS_LEN;
+}
+
+/**
+ *  \b function                     :       static __in uint8_t LIB_COMM_PACK_u8UnpackSticks(const uint8_t* args_pu8Buffer, uint16_t args_u16Len, LIB_COMM_PACK_Sticks_t* args_pSticks)
+ *  \b Description                  :       unpacks a sticks message.
+ *  @param    args_pu8Buffer        :       the received message.
+ *  @param    args_u16Len           :       number of received bytes, the bytes after the message (padding of the radio payload) are ignored.
+ *  @param    args_pSticks          :       where to store the positions of the sticks, left untouched if the message isn't a sticks one.
+ *  @return                         :       1 if a sticks message was unpacked, else 0.
+ */
+static __in uint8_t LIB_COMM_PACK_u8UnpackSticks(const uint8_t* args_pu8Buffer, uint16_t args_u16Len, LIB_COMM_PACK_Sticks_t* args_pSticks)
+{
+    if(LIB_COMM_PACK_STICKS_LEN > args_u16Len || LIB_COMM_PACK_TYPE_STICKS != args_pu8Buffer[0])
+    {
+        return 0;
+    }
+
+    args_pSticks->flags = args_pu8Buffer[1];
+    args_pSticks->roll = (int8_t)args_pu8Buffer[2];
+    args_pSticks->pitch = (int8_t)args_pu8Buffer[3];
+    args_pSticks->thrust = (int8_t)args_pu8Buffer[4];
+    args_pSticks->yaw = (int8_t)args_pu8Buffer[5];
+    args_pSticks->link = args_pu8Buffer[6];
+
+    return 1;
+}
+
+/**
+ *  \b function                     :       static __in uint8_t LIB_COMM_PACK_u8PackMove(const LIB_COMM_PACK_Move_t* args_pMove, uint8_t* args_pu8Buffer)
+ *  \b Description                  :       packs the setpoints in a move message, each one is rounded to 1/LIB_COMM_PACK_MOVE_SCALE.
+ *  @param    args_pMove            :       the setpoints.
+ *  @param    args_pu8Buffer        :       buffer of at least LIB_COMM_PACK_MOVE_LEN bytes for the message.
+ *  @return                         :       length of the message.
+ */
+static __in uint8_t LIB_COMM_PACK_u8PackMove(const LIB_COMM_PACK_Move_t* args_pMove, uint8_t* args_pu8Buffer)
+{
+    args_pu8Buffer[0] = LIB_COMM_PACK_TYPE_MOVE;
+    args_pu8Buffer[1] = args_pMove->flags;
+    LIB_COMM_PACK_vidPut16(&args_pu8Buffer[2], LIB_COMM_PACK_s32Quantize(args_pMove->roll, LIB_COMM_PACK_MOVE_SCALE, LIB_COMM_PACK_S16_MIN, LIB_COMM_PACK_S16_MAX));
+    LIB_COMM_PACK_vidPut16(&args_pu8Buffer[4], LIB_COMM_PACK_s32Quantize(args_pMove->pitch, LIB_COMM_PACK_MOVE_SCALE, LIB_COMM_PACK_S16_MIN, LIB_COMM_PACK_S16_MAX));
+    LIB_COMM_PACK_vidPut16(&args_pu8Buffer[6], LIB_COMM_PACK_s32Quantize(args_pMove->thrust, LIB_COMM_PACK_MOVE_SCALE, LIB_COMM_PACK_S16_MIN, LIB_COMM_PACK_S16_MAX));
+    LIB_COMM_PACK_vidPut16(&args_pu8Buffer[8], LIB_COMM_PACK_s32Quantize(args_pMove->yaw, LIB_COMM_PACK_MOVE_SCALE, LIB_COMM_PACK_S16_MIN, LIB_COMM_PACK_S16_MAX));
+
+    return LIB_COMM_PACK_MOVE_LEN;
+}
+
+/**
+ *  \b function                     :       static __in uint8_t LIB_COMM_PACK_u8UnpackMove(const uint8_t* args_pu8Buffer, uint16_t args_u16Len, LIB_COMM_PACK_Move_t* args_pMove)
+ *  \b Description                  :       unpacks a move message.
+ *  @param    args_pu8Buffer        :       the received message.
+ *  @param    args_u16Len           :       number of received bytes, must be the length of a move message.
+ *  @param    args_pMove            :       where to store the setpoints, left untouched if the message isn't a move one.
+ *  @return                         :       1 if a move message was unpacked, else 0.
+ */
+static __in uint8_t LIB_COMM_PACK_u8UnpackMove(const uint8_t* args_pu8Buffer, uint16_t args_u16Len, LIB_COMM_PACK_Move_t* args_pMove)
+{
+    if(LIB_COMM_PACK_MOVE_LEN != args_u16Len || LIB_COMM_PACK_TYPE_MOVE != args_pu8Buffer[0])
+    {
+        return 0;
+    }
+
+    args_pMove->flags = args_pu8Buffer[1];
+    args_pMove->roll = LIB_COMM_PACK_s16Get16(&args_pu8Buffer[2]) / LIB_COMM_PACK_MOVE_SCALE;
+    args_pMove->pitch = LIB_COMM_PACK_s16Get16(&args_pu8Buffer[4]) / LIB_COMM_PACK_MOVE_SCALE;
+    args_pMove->thrust = LIB_COMM_PACK_s16Get16(&args_pu8Buffer[6]) / LIB_COMM_PACK_MOVE_SCALE;
+    args_pMove->yaw = LIB_COMM_PACK_s16Get16(&args_pu8Buffer[8]) / LIB_COMM_PACK_MOVE_SCALE;
+
+    return 1;
+}
+
+/**
+ *  \b function                     :       static __in void LIB_COMM_PACK_vidInfoInit(LIB_COMM_PACK_InfoState_t* args_pState, uint8_t args_u8KeyframePeriod)
+ *  \b Description                  :       clears the state of a telemetry stream.
+ *  @param    args_pState           :       the state.
+ *  @param    args_u8KeyframePeriod :       used by the sender only, a full info message is sent every 'args_u8KeyframePeriod' messages
+ *                                          and the others are info delta ones, 0 or 1 sends only full messages.
+ *  @note                           :       the deltas are taken from the last keyframe so a lost delta message doesn't affect the next
+ *                                          ones, a lost keyframe drops the delta messages until the next one, so the period bounds how
+ *                                          long a loss is visible.
+ */
+static __in void LIB_COMM_PACK_vidInfoInit(LIB_COMM_PACK_InfoState_t* args_pState, uint8_t args_u8KeyframePeriod)
+{
+    uint8_t i = 0;
+
+    for(i = 0; i < LIB_COMM_PACK_INFO_FIELDS; i++)
+    {
+        args_pState->keyframe[i] = 0;
+    }
+    args_pState->valid = 0;
+    args_pState->keyframeId = 0;
+    args_pState->keyframePeriod = args_u8KeyframePeriod;
+    args_pState->sinceKeyframe = 0;
+    args_pState->dropped = 0;
+}
+
+/**
+ *  \b function                     :       static __in uint8_t LIB_COMM_PACK_u8PackInfo(LIB_COMM_PACK_InfoState_t* args_pState, const LIB_COMM_PACK_Info_t* args_pInfo, uint8_t* args_pu8Buffer)
+ *  \b Description                  :       packs the telemetry in a full info message (a keyframe) or, between keyframes, in an info delta
+ *                                          message holding only the fields that changed since the keyframe, as int8 differences when they fit.
+ *  @param    args_pState           :       state of the sender.
+ *  @param    args_pInfo            :       the telemetry.
+ *  @param    args_pu8Buffer        :       buffer of at least LIB_COMM_PACK_INFO_LEN bytes for the message.
+ *  @note                           :       the differences are taken between the packed values so the receiver rebuilds exactly what a
+ *                                          full message would give, a delta message that isn't shorter than a full one is sent as a new
+ *                                          keyframe.
+ *  @return                         :       length of the message, from LIB_COMM_PACK_INFO_DELTA_MIN_LEN to LIB_COMM_PACK_INFO_LEN.
+ */
+static __in uint8_t LIB_COMM_PACK_u8PackInfo(LIB_COMM_PACK_InfoState_t* args_pState, const LIB_COMM_PACK_Info_t* args_pInfo, uint8_t* args_pu8Buffer)
+{
+    int32_t local_s32Values[LIB_COMM_PACK_INFO_FIELDS] = {0};
+    int32_t local_s32Delta = 0;
+    uint8_t local_u8Mask = 0;
+    uint8_t local_u8Len = LIB_COMM_PACK_INFO_LEN;
+    uint8_t i = 0;
+
+    local_s32Values[LIB_COMM_PACK_INFO_DISTANCE] = LIB_COMM_PACK_s32Quantize(args_pInfo->distanceToOrigin, LIB_COMM_PACK_DISTANCE_SCALE, 0, LIB_COMM_PACK_U16_MAX);
+    local_s32Values[LIB_COMM_PACK_INFO_ALTITUDE] = LIB_COMM_PACK_s32Quantize(args_pInfo->altitude, LIB_COMM_PACK_ALTITUDE_SCALE, LIB_COMM_PACK_S16_MIN, LIB_COMM_PACK_S16_MAX);
+    local_s32Values[LIB_COMM_PACK_INFO_TEMPERATURE] = LIB_COMM_PACK_s32Quantize(args_pInfo->temperature, LIB_COMM_PACK_TEMPERATURE_SCALE, LIB_COMM_PACK_S16_MIN, LIB_COMM_PACK_S16_MAX);
+    local_s32Values[LIB_COMM_PACK_INFO_BATTERY] = args_pInfo->batteryCharge;
+
+    // between keyframes, try a delta message, a message where nothing changed is only [type, keyframe, mask]
+    if(args_pState->valid && args_pState->sinceKeyframe + 1 < args_pState->keyframePeriod)
+    {
+        local_u8Len = LIB_COMM_PACK_INFO_DELTA_MIN_LEN;
+        for(i = 0; i < LIB_COMM_PACK_INFO_FIELDS && LIB_COMM_PACK_INFO_LEN > local_u8Len; i++)
+        {
+            local_s32Delta = local_s32Values[i] - args_pState->keyframe[i];
+            if(0 == local_s32Delta)
+            {
+                continue;
+            }
+
+            local_u8Mask |= (uint8_t)(1 << i);
+            if(1 == LIB_COMM_PACK_InfoWidth[i])
+            {
+                args_pu8Buffer[local_u8Len++] = (uint8_t)local_s32Values[i];
+            }
+            else if(LIB_COMM_PACK_S8_MIN <= local_s32Delta && LIB_COMM_PACK_S8_MAX >= local_s32Delta)
+            {
+                local_u8Mask |= (uint8_t)(1 << (i + LIB_COMM_PACK_INFO_FIELDS));
+                args_pu8Buffer[local_u8Len++] = (uint8_t)(int8_t)local_s32Delta;
+            }
+            else
+            {
+                LIB_COMM_PACK_vidPut16(&args_pu8Buffer[local_u8Len], local_s32Values[i]);
+                local_u8Len += 2;
+            }
+        }
+    }
+
+    if(LIB_COMM_PACK_INFO_LEN > local_u8Len)
+    {
+        args_pu8Buffer[0] = LIB_COMM_PACK_TYPE_INFO_DELTA;
+        args_pu8Buffer[1] = args_pState->keyframeId;
+        args_pu8Buffer[2] = local_u8Mask;
+        args_pState->sinceKeyframe++;
+    }
+    else
+    {
+        args_pState->keyframeId++;
+        args_pu8Buffer[0] = LIB_COMM_PACK_TYPE_INFO;
+        args_pu8Buffer[1] = args_pState->keyframeId;
+        LIB_COMM_PACK_vidPut16(&args_pu8Buffer[2], local_s32Values[LIB_COMM_PACK_INFO_DISTANCE]);
+        LIB_COMM_PACK_vidPut16(&args_pu8Buffer[4], local_s32Values[LIB_COMM_PACK_INFO_ALTITUDE]);
+        LIB_COMM_PACK_vidPut16(&args_pu8Buffer[6], local_s32Values[LIB_COMM_PACK_INFO_TEMPERATURE]);
+        args_pu8Buffer[8] = (uint8_t)local_s32Values[LIB_COMM_PACK_INFO_BATTERY];
+        local_u8Len = LIB_COMM_PACK_INFO_LEN;
+        args_pState->sinceKeyframe = 0;
+        args_pState->valid = 1;
+        for(i = 0; i < LIB_COMM_PACK_INFO_FIELDS; i++)
+        {
+            args_pState->keyframe[i] = local_s32Values[i];
+        }
+    }
+
+    return local_u8Len;
+}
+
+/**
+ *  \b function                     :       static __in uint8_t LIB_COMM_PACK_u8UnpackInfo(LIB_COMM_PACK_InfoState_t* args_pState, const uint8_t* args_pu8Buffer, uint16_t args_u16Len, LIB_COMM_PACK_Info_t* args_pInfo)
+ *  \b Description                  :       unpacks a full or delta info message and gives the whole telemetry.
+ *  @param    args_pState           :       state of the receiver.
+ *  @param    args_pu8Buffer        :       the received message.
+ *  @param    args_u16Len           :       number of received bytes, the bytes after the message (padding of the radio payload) are ignored.
+ *  @param    args_pInfo            :       where to store the telemetry, left untouched if the message isn't unpacked.
+ *  @note                           :       info delta messages are dropped until the keyframe they belong to is received.
+ *  @return                         :       1 if an info message was unpacked, else 0.
+ */
+static __in uint8_t LIB_COMM_PACK_u8UnpackInfo(LIB_COMM_PACK_InfoState_t* args_pState, const uint8_t* args_pu8Buffer, uint16_t args_u16Len, LIB_COMM_PACK_Info_t* args_pInfo)
+{
+    int32_t local_s32Values[LIB_COMM_PACK_INFO_FIELDS] = {0};
+    uint8_t local_u8Mask = 0;
+    uint16_t local_u16Index = LIB_COMM_PACK_INFO_DELTA_MIN_LEN;
+    uint8_t i = 0;
+
+    if(LIB_COMM_PACK_INFO_DELTA_MIN_LEN > args_u16Len)
+    {
+        return 0;
+    }
+
+    if(LIB_COMM_PACK_TYPE_INFO == args_pu8Buffer[0])
+    {
+        if(LIB_COMM_PACK_INFO_LEN > args_u16Len)
+        {
+            return 0;
+        }
+        local_s32Values[LIB_COMM_PACK_INFO_DISTANCE] = (uint16_t)LIB_COMM_PACK_s16Get16(&args_pu8Buffer[2]);
+        local_s32Values[LIB_COMM_PACK_INFO_ALTITUDE] = LIB_COMM_PACK_s16Get16(&args_pu8Buffer[4]);
+        local_s32Values[LIB_COMM_PACK_INFO_TEMPERATURE] = LIB_COMM_PACK_s16Get16(&args_pu8Buffer[6]);
+        local_s32Values[LIB_COMM_PACK_INFO_BATTERY] = args_pu8Buffer[8];
+
+        for(i = 0; i < LIB_COMM_PACK_INFO_FIELDS; i++)
+        {
+            args_pState->keyframe[i] = local_s32Values[i];
+        }
+        args_pState->keyframeId = args_pu8Buffer[1];
+        args_pState->valid = 1;
+    }
+    else if(LIB_COMM_PACK_TYPE_INFO_DELTA == args_pu8Buffer[0])
+    {
+        local_u8Mask = args_pu8Buffer[2];
+        if(0 == args_pState->valid || args_pState->keyframeId != args_pu8Buffer[1])
+        {
+            args_pState->dropped++;
+            return 0;
+        }
+
+        for(i = 0; i < LIB_COMM_PACK_INFO_FIELDS; i++)
+        {
+            local_s32Values[i] = args_pState->keyframe[i];
+            if(0 == (local_u8Mask & (1 << i)))
+            {
+                continue;
+            }
+
+            if(local_u8Mask & (1 << (i + LIB_COMM_PACK_INFO_FIELDS)))
+            {
+                if(local_u16Index + 1 > args_u16Len)
+                {
+                    return 0;
+                }
+                local_s32Values[i] += (int8_t)args_pu8Buffer[local_u16Index++];
+            }
+            else if(1 == LIB_COMM_PACK_InfoWidth[i])
+            {
+                if(local_u16Index + 1 > args_u16Len)
+                {
+                    return 0;
+                }
+                local_s32Values[i] = args_pu8Buffer[local_u16Index++];
+            }
+            else
+            {
+                if(local_u16Index + 2 > args_u16Len)
+                {
+                    return 0;
+                }
+                local_s32Values[i] = LIB_COMM_PACK_s16Get16(&args_pu8Buffer[local_u16Index]);
+                if(LIB_COMM_PACK_INFO_DISTANCE == i)
+                {
+                    local_s32Values[i] = (uint16_t)local_s32Values[i];
+                }
+                local_u16Index += 2;
+            }
+        }
+    }
+    else
+    {
+        return 0;
+    }
+
+    args_pInfo->distanceToOrigin = local_s32Values[LIB_COMM_PACK_INFO_DISTANCE] / LIB_COMM_PACK_DISTANCE_SCALE;
+    args_pInfo->altitude = local_s32Values[LIB_COMM_PACK_INFO_ALTITUDE] / LIB_COMM_PACK_ALTITUDE_SCALE;
+    args_pInfo->temperature = local_s32Values[LIB_COMM_PACK_INFO_TEMPERATURE] / LIB_COMM_PACK_TEMPERATURE_SCALE;
+    args_pInfo->batteryCharge = (uint8_t)local_s32Values[LIB_COMM_PACK_INFO_BATTERY];
+
+    return 1;
+}
+
+/**
+ *  \b function                     :       static __in uint8_t LIB_COMM_PACK_u8PackLink(const LIB_COMM_PACK_Link_t* args_pLink, uint8_t* args_pu8Buffer)
+ *  \b Description                  :       packs the quality of the radio link in a link message.
+ *  @param    args_pLink            :       the quality of the link.
+ *  @param    args_pu8Buffer        :       buffer of at least LIB_COMM_PACK_LINK_LEN bytes for the message.
+ *  @return                         :       length of the message.
+ */
+static __in uint8_t LIB_COMM_PACK_u8PackLink(const LIB_COMM_PACK_Link_t* args_pLink, uint8_t* args_pu8Buffer)
+{
+    args_pu8Buffer[0] = LIB_COMM_PACK_TYPE_LINK;
+    args_pu8Buffer[1] = args_pLink->quality;
+    args_pu8Buffer[2] = args_pLink->retransmits;
+    args_pu8Buffer[3] = args_pLink->lost;
+
+    return LIB_COMM_PACK_LINK_LEN;
+}
+
+/**
+ *  \b function                     :       static __in uint8_t LIB_COMM_PACK_u8UnpackLink(const uint8_t* args_pu8Buffer, uint16_t args_u16Len, LIB_COMM_PACK_Link_t* args_pLink)
+ *  \b Description                  :       unpacks a link message.
+ *  @param    args_pu8Buffer        :       the received message.
+ *  @param    args_u16Len           :       number of received bytes.
+ *  @param    args_pLink            :       where to store the quality of the link, left untouched if the message isn't a link one.
+ *  @return                         :       1 if a link message was unpacked, else 0.
+ */
+static __in uint8_t LIB_COMM_PACK_u8UnpackLink(const uint8_t* args_pu8Buffer, uint16_t args_u16Len, LIB_COMM_PACK_Link_t* args_pLink)
+{
+    if(LIB_COMM_PACK_LINK_LEN > args_u16Len || LIB_COMM_PACK_TYPE_LINK != args_pu8Buffer[0])
+    {
+        return 0;
+    }
+
+    args_pLink->quality = args_pu8Buffer[1];
+    args_pLink->retransmits = args_pu8Buffer[2];
+    args_pLink->lost = args_pu8Buffer[3];
+
+    return 1;
+}
+
+/*** End of File **************************************************************/
+#endif /*LIB_COMM_PACK_H_*/
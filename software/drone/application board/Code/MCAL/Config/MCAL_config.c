@@ -39,6 +39,8 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    18/06/2023      1.0.0           Abdelrahman Mohamed Salem       Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           UART4 receives by DMA through 'MCAL_UART_Init'.                 |
+ * |    17/10/2026      1.2.0           agent                           AFIO is clocked, PB5 is the IRQ pin of NRF24L01 (EXTI5).        |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
  
@@ -79,6 +81,16 @@
  */
 #include "ch32v20x_usart.h"
 
+/**
+ * @reason: contains the DMA driven receiver of UART4
+ */
+#include "MCAL_UART.h"
+
+/**
+ * @reason: contains definitions for external interrupts
+ */
+#include "ch32v20x_exti.h"
+
 /******************************************************************************
  * Module Preprocessor Constants
  *******************************************************************************/
@@ -106,13 +118,13 @@
 MCAL_Config_ErrStat_t MCAL_Config_ConfigAllPins(void)
 {   
     // enable clock for all needed peripherals
-    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, DISABLE);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
     RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA2, DISABLE);
     RCC_AHBPeriphClockCmd(RCC_AHBPeriph_SRAM, DISABLE);
     RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, DISABLE);
     RCC_AHBPeriphClockCmd(RCC_AHBPeriph_OTG_FS, DISABLE);
 
-    RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, DISABLE);
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, ENABLE);
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE);
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOC, ENABLE);
@@ -361,17 +373,27 @@ MCAL_Config_ErrStat_t MCAL_Config_ConfigAllPins(void)
     local_usart4_t.USART_Mode = USART_Mode_Tx | USART_Mode_Rx;
     USART_Init(UART4, &local_usart4_t);
 
-    // USART_ITConfig(UART4, USART_IT_RXNE, ENABLE);
-    // interrupt is causing Systick timer interrupt to stop which is in return responsible for stopping freeRTOS kernal from work
-    // // configure NVIC for uart4 interrupt channel
-    // NVIC_InitTypeDef  uart_nvic_t = {0};
-    // uart_nvic_t.NVIC_IRQChannel = UART4_IRQn;
-    // uart_nvic_t.NVIC_IRQChannelPreemptionPriority = 1;
-    // uart_nvic_t.NVIC_IRQChannelSubPriority = 1;
-    // uart_nvic_t.NVIC_IRQChannelCmd = ENABLE;
-    // NVIC_Init(&uart_nvic_t);
-
+    // the received bytes are moved by DMA into a circular buffer, the idle line interrupt tells when the other board
+    // stopped sending (refer to "MCAL_UART.h")
     USART_Cmd(UART4, ENABLE);
+    MCAL_UART_Init();
+
+    /******************************************/
+    // falling edge on PB5 when NRF24L01 raises one of its interrupts (its IRQ pin is active low)
+    GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource5);
+    EXTI_InitTypeDef local_radioIrqEXTI_t = {0};
+    local_radioIrqEXTI_t.EXTI_Line = EXTI_Line5;
+    local_radioIrqEXTI_t.EXTI_Mode = EXTI_Mode_Interrupt;
+    local_radioIrqEXTI_t.EXTI_Trigger = EXTI_Trigger_Falling;
+    local_radioIrqEXTI_t.EXTI_LineCmd = ENABLE;
+    EXTI_Init(&local_radioIrqEXTI_t);
+
+    NVIC_InitTypeDef local_radioIrqNVIC_t = {0};
+    local_radioIrqNVIC_t.NVIC_IRQChannel = EXTI9_5_IRQn;
+    local_radioIrqNVIC_t.NVIC_IRQChannelPreemptionPriority = 1;
+    local_radioIrqNVIC_t.NVIC_IRQChannelSubPriority = 0;
+    local_radioIrqNVIC_t.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&local_radioIrqNVIC_t);
 
 
     return MCAL_Config_STAT_OK;
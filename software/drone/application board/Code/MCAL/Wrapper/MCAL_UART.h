@@ -0,0 +1,391 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   DMA driven UART                                                                                             |
+ * |    @file           :   MCAL_UART.h                                                                                                 |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file contains the circular DMA receiver of UART4 with idle line detection and its queued DMA           |
+ * |                        transmitter                                                                                                 |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           added the queued DMA transmitter 'MCAL_UART_Send' and           |
+ * |                                                                    'MCAL_UART_GetTxStats'.                                         |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+
+#ifndef MCAL_UART_HEADER_H_
+#define MCAL_UART_HEADER_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains standard definitions for int
+ */
+#include "stdint.h"
+
+/**
+ * @reason: contains common definitions
+ */
+#include "common.h"
+
+/**
+ * @reason: contains DMA channels definitions
+ */
+#include "ch32v20x_dma.h"
+
+/**
+ * @reason: contains definition of the task handle to notify
+ */
+#include "Service_RTOS_wrapper.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: size of the circular buffer the DMA writes the received bytes into, the received bytes have to be read
+ *         before the DMA wraps around them (~11 ms at 115200 baud)
+ */
+#define MCAL_UART_RX_RING_LEN               (128)
+
+/**
+ * @brief: maximum number of frames handed to the transmitter and not sent yet
+ */
+#define MCAL_UART_TX_QUEUE_LEN              (4)
+
+/******************************************************************************
+ * Configuration Constants
+ *******************************************************************************/
+
+/**
+ * @brief: the UART linking the two boards and the DMA1 channels of its receiver and transmitter (fixed by the hardware for UART4)
+ */
+#define MCAL_UART_PERIPHERAL                UART4
+#define MCAL_UART_IRQ                       UART4_IRQn
+#define MCAL_UART_DMA_RX_CHANNEL            DMA1_Channel8
+#define MCAL_UART_DMA_RX_IRQ                DMA1_Channel8_IRQn
+#define MCAL_UART_DMA_RX_IT_HT              DMA1_IT_HT8
+#define MCAL_UART_DMA_RX_IT_TC              DMA1_IT_TC8
+#define MCAL_UART_DMA_TX_CHANNEL            DMA1_Channel1
+#define MCAL_UART_DMA_TX_IRQ                DMA1_Channel1_IRQn
+#define MCAL_UART_DMA_TX_IT_TC              DMA1_IT_TC1
+#define MCAL_UART_DMA_TX_IT_GL              DMA1_IT_GL1
+
+/**
+ * @brief: priority of the idle line and DMA interrupts, all must be equal as the receive interrupts share the receive state
+ *         and a transmit completion must not preempt another one
+ */
+#define MCAL_UART_IRQ_PREEMPTION_PRIO       (2)
+#define MCAL_UART_IRQ_SUB_PRIO              (0)
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: contains error states for this module
+*/
+typedef enum {
+  MCAL_UART_STAT_OK,                /**< function executed successfully */
+  MCAL_UART_STAT_INVALID_PARAMS,    /**< invalid arguments */
+  MCAL_UART_STAT_EMPTY,             /**< nothing was received since the last read */
+  MCAL_UART_STAT_PENDING,           /**< the frame is waiting in the queue or being sent */
+  MCAL_UART_STAT_QUEUE_FULL,        /**< the transmit queue can't take one more frame */
+} MCAL_UART_ErrStat_t;
+
+/**
+ * @brief: counters of the receiver, read with MCAL_UART_GetRxStats
+ */
+typedef struct {
+  uint32_t frames;                  /**< bursts of bytes ended by an idle line */
+  uint32_t bytes;                   /**< bytes written by the DMA into the circular buffer */
+  uint32_t lost;                    /**< bytes overwritten by the DMA before they were read */
+  uint32_t overruns;                /**< bytes lost by the UART itself as the DMA didn't take them in time */
+} MCAL_UART_Stats_t;
+
+/**
+ * @brief: counters of the transmitter, read with MCAL_UART_GetTxStats
+ */
+typedef struct {
+  uint32_t frames;                  /**< frames fully handed to the UART */
+  uint32_t bytes;                   /**< bytes of these frames */
+  uint32_t queueFull;               /**< frames refused because the queue was full */
+  uint32_t busyUS;                  /**< time the DMA spent sending in micro seconds, over the elapsed time it's the link load */
+  uint32_t lastLatencyUS;           /**< time from queuing to the end of the DMA transfer of the last frame in micro seconds */
+  uint32_t maxLatencyUS;            /**< largest of these times since boot */
+} MCAL_UART_TxStats_t;
+
+typedef struct MCAL_UART_TxFrame_t MCAL_UART_TxFrame_t;
+
+/**
+ * @brief: function called from the DMA interrupt when a frame is sent, the frame memory can be reused from then on
+ */
+typedef void (*MCAL_UART_TxCallBack_t)(MCAL_UART_TxFrame_t* arg_pFrame);
+
+/**
+ * @brief: a frame to send, the memory of the frame and of its data is owned by the transmitter until the frame isn't
+ *         MCAL_UART_STAT_PENDING anymore, the data is sent from where it is without being copied
+ */
+struct MCAL_UART_TxFrame_t {
+  const uint8_t* data;                      /**< bytes to send */
+  uint16_t dataLen;                         /**< number of bytes to send */
+  MCAL_UART_TxCallBack_t callBack;          /**< called when the frame is sent, can be NULL */
+  void* context;                            /**< free for the user of the frame (e.g. its buffer) */
+  volatile MCAL_UART_ErrStat_t status;      /**< MCAL_UART_STAT_PENDING until the frame is sent then MCAL_UART_STAT_OK */
+  uint32_t queuedTimeUS;                    /**< time the frame was queued, set by the transmitter */
+};
+
+/******************************************************************************
+ * Variables
+ *******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       MCAL_UART_ErrStat_t MCAL_UART_Init(void);
+ *  \b Description                              :       starts the DMA1 channel of UART4 receiver in circular mode and enables the idle line interrupt of UART4
+ *                                                      and the half/full transfer interrupts of the channel, then prepares the DMA1 channel of the
+ *                                                      transmitter.
+ *  @note                                       :       the UART itself is configured by the caller, the receiver only owns its DMA request.
+ *  \b PRE-CONDITION                            :       clock of DMA1 is enabled, UART4 is configured and enabled.
+ *  \b POST-CONDITION                           :       the received bytes are written to the circular buffer without the CPU and frames can be sent.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_UART_ErrStat_t in "MCAL_UART.h")
+ *  @see                                        :       MCAL_Config_ErrStat_t MCAL_Config_ConfigAllPins(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_UART.h"
+ * 
+ * int main() {
+ *  USART_Init(UART4, &local_usart4_t);
+ *  USART_Cmd(UART4, ENABLE);
+ *  MCAL_UART_Init();
+ * }
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_UART_ErrStat_t MCAL_UART_Init(void);
+
+/**
+ *  \b function                                 :       MCAL_UART_ErrStat_t MCAL_UART_SetRxTask(RTOS_TaskHandle_t arg_Task_t);
+ *  \b Description                              :       sets the task notified when a burst of bytes ends with an idle line or when the circular buffer is half full.
+ *  @param  arg_Task_t [IN]                     :       the task to notify, NULL to stop the notifications.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       the task can sleep until something is received.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_UART_ErrStat_t in "MCAL_UART.h")
+ *  @see                                        :       MCAL_UART_ErrStat_t MCAL_UART_Read(uint8_t* arg_pu8Data, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_UART.h"
+ * 
+ * RTOS_TaskHandle_t local_task_t = NULL;
+ * SERVICE_RTOS_GetCurrentTaskHandle(&local_task_t);
+ * MCAL_UART_SetRxTask(local_task_t);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_UART_ErrStat_t MCAL_UART_SetRxTask(RTOS_TaskHandle_t arg_Task_t);
+
+/**
+ *  \b function                                 :       MCAL_UART_ErrStat_t MCAL_UART_Read(uint8_t* arg_pu8Data, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len);
+ *  \b Description                              :       copies the bytes received up to the last idle line (or half/full buffer event) out of the circular buffer.
+ *  @param  arg_pu8Data [OUT]                   :       base address to copy the received bytes to.
+ *  @param  arg_u16MaxLen [IN]                  :       size of 'arg_pu8Data', the rest is left for the next read.
+ *  @param  arg_pu16Len [OUT]                   :       number of copied bytes.
+ *  @note                                       :       the bytes of a burst still on the line are left in the buffer until its idle line, the bytes overwritten
+ *                                                      by the DMA before they were read are skipped and counted in 'lost'.
+ *                                                      must be called from one task only.
+ *  \b PRE-CONDITION                            :       MCAL_UART_Init is called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       MCAL_UART_STAT_EMPTY if nothing was received, else MCAL_UART_STAT_OK (refer to @MCAL_UART_ErrStat_t in "MCAL_UART.h")
+ *  @see                                        :       MCAL_UART_ErrStat_t MCAL_UART_SetRxTask(RTOS_TaskHandle_t arg_Task_t)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_UART.h"
+ * 
+ * uint8_t local_u8Data[32];
+ * uint16_t local_u16Len = 0;
+ * SERVICE_RTOS_WaitForNotification(1000);
+ * while(MCAL_UART_STAT_OK == MCAL_UART_Read(local_u8Data, sizeof(local_u8Data), &local_u16Len))
+ * {
+ *   // parse local_u16Len bytes
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_UART_ErrStat_t MCAL_UART_Read(uint8_t* arg_pu8Data, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len);
+
+/**
+ *  \b function                                 :       MCAL_UART_ErrStat_t MCAL_UART_GetRxStats(MCAL_UART_Stats_t* arg_pStats);
+ *  \b Description                              :       returns the counters of the receiver since boot.
+ *  @param  arg_pStats [OUT]                    :       base address to store the counters in.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_UART_ErrStat_t in "MCAL_UART.h")
+ *  @see                                        :       MCAL_UART_ErrStat_t MCAL_UART_Read(uint8_t* arg_pu8Data, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_UART.h"
+ * 
+ * MCAL_UART_Stats_t stats = {0};
+ * MCAL_UART_GetRxStats(&stats);
+ * printf("frames %lu, lost %lu\r\n", stats.frames, stats.lost);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_UART_ErrStat_t MCAL_UART_GetRxStats(MCAL_UART_Stats_t* arg_pStats);
+
+/**
+ *  \b function                                 :       MCAL_UART_ErrStat_t MCAL_UART_Send(MCAL_UART_TxFrame_t* arg_pFrame);
+ *  \b Description                              :       queues a frame to be sent by the DMA after the frames queued before it, the call doesn't wait for the
+ *                                                      frame to be sent.
+ *  @param  arg_pFrame [IN/OUT]                 :       the frame to send, 'data', 'dataLen', 'callBack' and 'context' are set by the caller.
+ *  @note                                       :       the frame and its data must stay untouched until its status isn't MCAL_UART_STAT_PENDING or its
+ *                                                      callback is called, the callback runs in the DMA interrupt.
+ *                                                      can be called from any task while the receiver is working (full duplex).
+ *  \b PRE-CONDITION                            :       MCAL_UART_Init is called.
+ *  \b POST-CONDITION                           :       the frame is MCAL_UART_STAT_PENDING if it was queued.
+ *  @return                                     :       MCAL_UART_STAT_QUEUE_FULL if MCAL_UART_TX_QUEUE_LEN frames are waiting, else one of error states
+ *                                                      (refer to @MCAL_UART_ErrStat_t in "MCAL_UART.h")
+ *  @see                                        :       MCAL_UART_ErrStat_t MCAL_UART_GetTxStats(MCAL_UART_TxStats_t* arg_pStats)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_UART.h"
+ * 
+ * void sent(MCAL_UART_TxFrame_t* frame)
+ * {
+ *   // frame->data can be filled again
+ * }
+ * 
+ * uint8_t buffer[16];
+ * MCAL_UART_TxFrame_t frame = {0};
+ * frame.data = buffer;
+ * frame.dataLen = sizeof(buffer);
+ * frame.callBack = sent;
+ * if(MCAL_UART_STAT_OK == MCAL_UART_Send(&frame))
+ * {
+ *   // the DMA sends the buffer
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_UART_ErrStat_t MCAL_UART_Send(MCAL_UART_TxFrame_t* arg_pFrame);
+
+/**
+ *  \b function                                 :       MCAL_UART_ErrStat_t MCAL_UART_GetTxStats(MCAL_UART_TxStats_t* arg_pStats);
+ *  \b Description                              :       returns the counters of the transmitter since boot.
+ *  @param  arg_pStats [OUT]                    :       base address to store the counters in.
+ *  @note                                       :       the throughput is the difference of 'bytes' between two calls over the time between them.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_UART_ErrStat_t in "MCAL_UART.h")
+ *  @see                                        :       MCAL_UART_ErrStat_t MCAL_UART_Send(MCAL_UART_TxFrame_t* arg_pFrame)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_UART.h"
+ * 
+ * MCAL_UART_TxStats_t stats = {0};
+ * MCAL_UART_GetTxStats(&stats);
+ * printf("frames %lu, max latency %lu us\r\n", stats.frames, stats.maxLatencyUS);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_UART_ErrStat_t MCAL_UART_GetTxStats(MCAL_UART_TxStats_t* arg_pStats);
+
+/*** End of File **************************************************************/
+#endif /*MCAL_UART_HEADER_H_*/
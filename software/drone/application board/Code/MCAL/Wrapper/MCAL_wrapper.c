@@ -39,6 +39,12 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    18/06/2023      1.0.0           Abdelrahman Mohamed Salem       Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           removed the polling and RXNE interrupt UART4 receive functions, |
+ * |                                                                    replaced by "MCAL_UART.h".                                      |
+ * |    17/10/2026      1.2.0           agent                           removed the polling 'MCAL_WRAPPER_SendDataThroughUART4',        |
+ * |                                                                    replaced by "MCAL_UART.h".                                      |
+ * |    17/10/2026      1.3.0           agent                           the IRQ pin of NRF24L01 notifies the task set by                |
+ * |                                                                    'MCAL_WRAPPER_SetRadioTask'.                                    |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
  
@@ -83,6 +89,11 @@
  */
 #include "nrf_config.h"
 
+/**
+ * @reason: contains definitions for external interrupts
+ */
+#include "ch32v20x_exti.h"
+
 /******************************************************************************
  * Module Preprocessor Constants
  *******************************************************************************/
@@ -98,16 +109,17 @@
 /******************************************************************************
  * Module Variable Definitions
  *******************************************************************************/
-functionCallBack_t global_UART4RecCallback = NULL;
+
+/**
+ * @brief: task notified when the IRQ pin of the NRF24L01 falls
+ */
+RTOS_TaskHandle_t global_RadioIrqTask_t = NULL;
 
 /******************************************************************************
  * Function Prototypes
  *******************************************************************************/
 
-/**
- * @brief: USART4 IRQ handler
- */
- void UART4_IRQHandler(void); // __attribute__((interrupt("WCH-Interrupt-fast")));  
+void EXTI9_5_IRQHandler(void) __attribute__((interrupt()));
 
 /******************************************************************************
  * Function Definitions
@@ -147,137 +159,6 @@ functionCallBack_t global_UART4RecCallback = NULL;
 //     return MCAL_WRAPPER_STAT_OK;
 // }
 
-/**
- * 
- */
-void UART4_IRQHandler(void)
-{
-    if(USART_GetITStatus(UART4, USART_IT_RXNE) != RESET && NULL != global_UART4RecCallback)
-    {
-		global_UART4RecCallback();
-    }
-}
-
-
-/**
- * 
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SetUART4RecCallBack(functionCallBack_t arg_pUARTCallBack)
-{
-    if(arg_pUARTCallBack == NULL)
-    {
-        return MCAL_WRAPPER_STAT_INVALID_PARAMS;
-    }
-
-    global_UART4RecCallback = arg_pUARTCallBack;
-
-    return MCAL_WRAPPER_STAT_OK;
-}
-
-/**
- * 
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_UART4RecITConfig(LIB_CONSTANTS_DriverStates_t arg_Enable_Disable_t)
-{
-
-
-	NVIC_InitTypeDef  uart_nvic_t = {0};
-    uart_nvic_t.NVIC_IRQChannel = UART4_IRQn;
-    uart_nvic_t.NVIC_IRQChannelPreemptionPriority = 1;
-    uart_nvic_t.NVIC_IRQChannelSubPriority = 1;
-
-    switch (arg_Enable_Disable_t)
-    {
-    case LIB_CONSTANTS_DISABLED:
-            // disable receive interrupt
-            USART_ITConfig(UART4, USART_IT_RXNE, DISABLE);
-            // configure NVIC for uart4 interrupt channel
-            uart_nvic_t.NVIC_IRQChannelCmd = DISABLE;
-            NVIC_Init(&uart_nvic_t);
-        break;
-
-    case LIB_CONSTANTS_ENABLED:
-            // enable receive interrupt
-            USART_ITConfig(UART4, USART_IT_RXNE, ENABLE);
-            // configure NVIC for uart4 interrupt channel
-            uart_nvic_t.NVIC_IRQChannelCmd = ENABLE;
-            NVIC_Init(&uart_nvic_t);
-        break;
-
-    default:
-        break;
-    }
-    
-    return MCAL_WRAPPER_STAT_OK;
-}
-
-
-/**
- * 
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SendDataThroughUART4(uint8_t* arg_pu8Data, uint16_t arg_u16DataLen)
-{
-    MCAL_WRAPPER_ErrStat_t local_errState_t = MCAL_WRAPPER_STAT_OK;
-
-    if(NULL == arg_pu8Data)
-    {
-        return MCAL_WRAPPER_STAT_INVALID_PARAMS;
-    }
-
-    while (arg_u16DataLen > 0)
-    {
-        // check if we can send
-        if(USART_GetFlagStatus(UART4, USART_FLAG_TXE) == SET && USART_GetFlagStatus(UART4, USART_FLAG_RXNE) == RESET)
-        {
-            USART_SendData(UART4, (uint16_t) *arg_pu8Data);
-            arg_pu8Data++;
-            arg_u16DataLen--;
-        }
-        else
-        {
-            local_errState_t = MCAL_WRAPPER_STAT_UART_BUSY;
-            break;
-        }
-
-    }
-    
-    return local_errState_t;
-}
-
-/**
- * 
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_ReceiveDataThroughUART4(uint8_t* arg_pu8Data, uint16_t arg_u16DataLen)
-{
-    MCAL_WRAPPER_ErrStat_t local_errState_t = MCAL_WRAPPER_STAT_OK;
-
-    if(NULL == arg_pu8Data)
-    {
-        return MCAL_WRAPPER_STAT_INVALID_PARAMS;
-    }
-
-
-    while (arg_u16DataLen > 0)
-    {
-        if(USART_GetFlagStatus(UART4, USART_FLAG_RXNE) == SET)
-        {
-            *arg_pu8Data = USART_ReceiveData(UART4);
-            arg_pu8Data++;
-            arg_u16DataLen--;
-            // clear the interrupt by writing 0 
-            USART_ClearFlag(UART4, USART_FLAG_RXNE);
-        }
-        else
-        {
-            local_errState_t = MCAL_WRAPPER_STAT_UART_EMPTY;
-            break;
-        }
-
-    }
-
-    return local_errState_t;
-}
-
 /**
  * @brief: Set CSN pin low
  */
@@ -347,4 +228,29 @@ MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_DelayUS(uint32_t arg_u16US)
 }
 
 
+/**
+ * 
+ */
+void EXTI9_5_IRQHandler(void)
+{
+    if(EXTI_GetITStatus(MCAL_WRAPPER_NRF_IRQ_EXTI_LINE) != RESET)
+    {
+        // the pin stays low until the task clears the interrupts of the module, only the edge is taken here
+        EXTI_ClearITPendingBit(MCAL_WRAPPER_NRF_IRQ_EXTI_LINE);
+
+        if(NULL != global_RadioIrqTask_t)
+            SERVICE_RTOS_Notify(global_RadioIrqTask_t, LIB_CONSTANTS_ENABLED);
+    }
+}
+
+/**
+ * 
+ */
+MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SetRadioTask(RTOS_TaskHandle_t arg_Task_t)
+{
+    global_RadioIrqTask_t = arg_Task_t;
+
+    return MCAL_WRAPPER_STAT_OK;
+}
+
 /*************** END OF FUNCTIONS ***************************************************************************/
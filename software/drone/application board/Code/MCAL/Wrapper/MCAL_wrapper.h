@@ -40,6 +40,11 @@
  * |    Date            Version         Author                          Description                                                     |
  * |    18/06/2023      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
  * |    20/06/2023      1.0.0           Abdelrahman Mohamed Salem       created 'MCAL_WRAPPER_UART4RecITConfig'.                        |
+ * |    17/10/2026      1.1.0           agent                           removed the polling and RXNE interrupt UART4 receive functions, |
+ * |                                                                    replaced by "MCAL_UART.h".                                      |
+ * |    17/10/2026      1.2.0           agent                           removed the polling 'MCAL_WRAPPER_SendDataThroughUART4',        |
+ * |                                                                    replaced by "MCAL_UART.h".                                      |
+ * |    17/10/2026      1.3.0           agent                           added 'MCAL_WRAPPER_SetRadioTask'.                              |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -71,6 +76,11 @@
  */
 #include "constants.h"
 
+/**
+ * @reason: contains definition of the task handle to notify
+ */
+#include "Service_RTOS_wrapper.h"
+
 
 /******************************************************************************
  * Preprocessor Constants
@@ -80,6 +90,11 @@
  * Configuration Constants
  *******************************************************************************/
 
+/**
+ * @brief: EXTI line of the pin connected to the IRQ pin of the NRF24L01 (PB5)
+ */
+#define MCAL_WRAPPER_NRF_IRQ_EXTI_LINE          EXTI_Line5
+
 /******************************************************************************
  * Macros
  *******************************************************************************/
@@ -158,174 +173,6 @@ typedef enum {
  */
 // MCAL_WRAPPER_ErrStat_t MCAL_WRAPEPR_TIM4_PWM_OUT(MCAL_WRAPPER_TIM_CH_t arg_channel_t, uint8_t arg_u8DutyPercent);
 
-/**
- *  \b function                                 :       MCAL_WRAPPER_SetUART4RecCallBack HAL_WRAPPER_SetUART4CallBack(functionCallBack_t *arg_pUARTCallBack);
- *  \b Description                              :       this functions is used as a wrapper function to set callback function to execute when UART4 receives anything.
- *  @param  arg_pUARTCallBack [IN]              :       base address of function to be executed when UART4 receives anything.
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       Callback function is assigned to be executed whenever UART4 receives anything.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
- *
- *  \b Example:
- * @code
- * 
- * #include "MCAL_wrapper.h"
- * 
- * void func(void)
- * {
- *  // callback code
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = MCAL_Config_ConfigAllPins();
- *  if(MCAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = MCAL_WRAPPER_SetUART4RecCallBack(func);
- *    if(MCAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *    
- *    }
- *  }
- * }
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 17/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SetUART4RecCallBack(functionCallBack_t arg_pUARTCallBack);
-
-/**
- *  \b function                                 :       MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_UART4RecITConfig(LIB_CONSTANTS_DriverStates_t arg_Enable_Disable_t);
- *  \b Description                              :       this functions is used as a wrapper function to enable/disable uart4 byte received interrupt.
- *  @param arg_Enable_Disable_t [IN]            :       to enable or disable the interrupt, refer to @LIB_CONSTANTS_DriverStates_t in "constants.h".
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       UART receive interrupt is enabled
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
- *
- *  \b Example:
- * @code
- * 
- * #include "MCAL_wrapper.h"
- * 
- * void func(void)
- * {
- *  // callback code
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = MCAL_Config_ConfigAllPins();
- *  if(MCAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = MCAL_WRAPPER_UART4RecITConfig(LIB_CONSTANTS_ENABLED);
- *    if(MCAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *      // interrupt is enabled
- *    }
- *  }
- * }
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 20/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_UART4RecITConfig(LIB_CONSTANTS_DriverStates_t arg_Enable_Disable_t);
-
-/**
- *  \b function                                 :       MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SendDataThroughUART4(uint8_t* arg_pu8Data, uint16_t arg_u16DataLen);
- *  \b Description                              :       this functions is used as a wrapper function to send data through UART4.
- *  @param  arg_pu8Data [IN]                    :       base address of data to be send over UART4.
- *  @param  arg_u16DataLen [IN]                 :       length of data in bytes to be send over UART4.
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       data is sent over UART4.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
- *
- *  \b Example:
- * @code
- * 
- * #include "MCAL_wrapper.h"
- * 
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = MCAL_Config_ConfigAllPins();
- *  uint8_t data[] = [0, 1, 2, 4];
- *  if(MCAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = MCAL_WRAPPER_SendDataThroughUART4(data, 4);
- *    if(HAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *      // data is sent successfully
- *    }
- *  }
- * }
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 18/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SendDataThroughUART4(uint8_t* arg_pu8Data, uint16_t arg_u16DataLen);
-
-
-/**
- *  \b function                                 :       MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SendDataThroughUART4(uint8_t* arg_pu8Data, uint16_t arg_u16DataLen);
- *  \b Description                              :       this functions is used as a wrapper function to send receive through UART4.
- *  @param  arg_pu8Data [IN]                    :       base address of data to be received over UART4.
- *  @param  arg_u16DataLen [IN]                 :       length of data in bytes to be received over UART4.
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       data is received over UART4.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
- *
- *  \b Example:
- * @code
- * 
- * #include "MCAL_wrapper.h"
- * 
- * void func(void)
- * {
- *    SERVICE_RTOS_Notify(task_AppComm_Handle_t, LIB_CONSTANTS_ENABLED);
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = MCAL_Config_ConfigAllPins();
- *  uint8_t data[4];
- *  if(MCAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = MCAL_WRAPPER_ReceiveDataThroughUART4(data, 4);
- *    if(HAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *      // data is sent successfully
- *    }
- *  }
- * }
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 18/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_ReceiveDataThroughUART4(uint8_t* arg_pu8Data, uint16_t arg_u16DataLen);
 
 
 /**
@@ -503,5 +350,35 @@ uint8_t SPI_transfer(uint8_t data);
  */
 MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_DelayUS(uint32_t arg_u16US);
 
+/**
+ *  \b function                                 :       MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SetRadioTask(RTOS_TaskHandle_t arg_Task_t);
+ *  \b Description                              :       sets the task notified when the IRQ pin of the NRF24L01 falls (a packet is received, sent or lost).
+ *  @param  arg_Task_t [IN]                     :       the task to notify, NULL to stop the notifications.
+ *  @note                                       :       the interrupts of the module are cleared by the notified task (refer to NRF_process in "nrf.h").
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       the task can sleep until the radio needs it.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_WRAPPER_ErrStat_t in "MCAL_wrapper.h")
+ *  @see                                        :       MCAL_Config_ErrStat_t MCAL_Config_ConfigAllPins(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_wrapper.h"
+ * 
+ * RTOS_TaskHandle_t local_task_t = NULL;
+ * SERVICE_RTOS_GetCurrentTaskHandle(&local_task_t);
+ * MCAL_WRAPPER_SetRadioTask(local_task_t);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SetRadioTask(RTOS_TaskHandle_t arg_Task_t);
+
 /*** End of File **************************************************************/
 #endif /*MCAL_WRAPPER_HEADER_H_*/
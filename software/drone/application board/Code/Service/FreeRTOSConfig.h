@@ -114,7 +114,7 @@
 #define configUSE_MALLOC_FAILED_HOOK	0   /* if configUSE_MALLOC_FAILED_HOOK is set to 1 then the application must define a malloc() failed hook function. If configUSE_MALLOC_FAILED_HOOK is set to 0 then the malloc() failed hook function will not be called, even if one is defined. Malloc() failed hook functions must have the name and prototype shown below.*/
 #define configUSE_APPLICATION_TASK_TAG	0   /* Setting configUSE_APPLICATION_TASK_TAG to 1 will include task tagging functionality and its associated API in the build. A 'tag' value can be assigned to each task.*/
 #define configUSE_COUNTING_SEMAPHORES	1   /* Set to 1 to include counting semaphore functionality in the build, or 0 to omit counting semaphore functionality from the build.*/
-#define configGENERATE_RUN_TIME_STATS	0   /* The Run Time Stats page (https://www.freertos.org/rtos-run-time-stats.html) describes the use of this parameter.*/
+#define configGENERATE_RUN_TIME_STATS	1   /* The Run Time Stats page (https://www.freertos.org/rtos-run-time-stats.html) describes the use of this parameter.*/
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION 0   /* Some FreeRTOS ports have two methods of selecting the next task to execute - a generic method, and a method that is specific to that port.*/
 
 /* Co-routine definitions. */
@@ -144,6 +144,13 @@ to exclude the API function. */
 #define INCLUDE_xTaskGetHandle				1
 #define INCLUDE_xSemaphoreGetMutexHolder	1
 #define configSUPPORT_DYNAMIC_ALLOCATION    1   /* to include xQueueCreate function in the build*/
+#define INCLUDE_xTaskGetIdleTaskHandle      1
+
+/* the run time stats are counted in micro seconds from the RTOS tick and the systick counter that drives it, so there
+is no timer to configure (refer to 'SERVICE_RTOS_GetIdleTime') */
+uint32_t SERVICE_RTOS_RunTimeCounter(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()    SERVICE_RTOS_RunTimeCounter()
 
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
@@ -45,6 +45,12 @@
  * |    14/06/2023      1.0.0           Abdelrahman Mohamed Salem       added the function 'SERVICE_RTOS_ReadFromBlockingQueue'.        |
  * |    18/06/2023      1.0.0           Abdelrahman Mohamed Salem       added support for getting remaining messages in queue in the.   |
  * |                                                                    function 'SERVICE_RTOS_ReadFromBlockingQueue'.                  |
+ * |    17/10/2026      1.1.0           agent                           added 'SERVICE_RTOS_CurrentUSTime',                             |
+ * |                                                                    'SERVICE_RTOS_EnterCritical', 'SERVICE_RTOS_ExitCritical' and   |
+ * |                                                                    'SERVICE_RTOS_GetIdleTime'.                                     |
+ * |    17/10/2026      1.1.0           agent                           made 'SERVICE_RTOS_Notify' yield from ISR.                      |
+ * |    17/10/2026      1.1.1           agent                           'SERVICE_RTOS_CurrentUSTime' counts a tick whose interrupt is   |
+ * |                                                                    still pending.                                                  |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
  
@@ -98,6 +104,11 @@
  * Module Preprocessor Constants
  *******************************************************************************/
 
+/**
+ * @brief: the count flag of the systick status register, set when the counter restarts and cleared by the tick interrupt
+ */
+#define SERVICE_RTOS_SYSTICK_CNTIF          (0x1UL)
+
 /******************************************************************************
  * Module Preprocessor Macros
  *******************************************************************************/
@@ -274,7 +285,11 @@ SERVICE_RTOS_ErrStat_t SERVICE_RTOS_Notify(RTOS_TaskHandle_t arg_TaskToNotify_t,
         } 
         else if(LIB_CONSTANTS_ENABLED == arg_u8IsFromISR)
         {
-            vTaskNotifyGiveFromISR(arg_TaskToNotify_t, NULL);
+            BaseType_t local_HigherPriorityTaskWoken = pdFALSE;
+            vTaskNotifyGiveFromISR(arg_TaskToNotify_t, &local_HigherPriorityTaskWoken);
+
+            // switch to the notified task as soon as the ISR returns instead of waiting for the next tick
+            portYIELD_FROM_ISR(local_HigherPriorityTaskWoken);
         }
         else
         {
@@ -287,6 +302,96 @@ SERVICE_RTOS_ErrStat_t SERVICE_RTOS_Notify(RTOS_TaskHandle_t arg_TaskToNotify_t,
 }
 
 
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentUSTime(uint32_t* arg_pu32CurrentTime)
+{
+    SERVICE_RTOS_ErrStat_t local_ErrStatus = SERVICE_RTOS_STAT_OK;
+    TickType_t local_TickCount = 0;
+    uint32_t local_u32SysTickCount = 0;
+    uint32_t local_u32PendingTicks = 0;
+
+    if(NULL != arg_pu32CurrentTime)
+    {
+        // the systick counter is reset every tick, read it again if a tick happened in between
+        do
+        {
+            local_TickCount = xTaskGetTickCount();
+            local_u32SysTickCount = (uint32_t)SysTick->CNT;
+            local_u32PendingTicks = 0;
+
+            // the counter restarted but the tick interrupt didn't run yet (called from an ISR or a critical section),
+            // the counter is read again as the first read may be from before the restart
+            if(SysTick->SR & SERVICE_RTOS_SYSTICK_CNTIF)
+            {
+                local_u32SysTickCount = (uint32_t)SysTick->CNT;
+                local_u32PendingTicks = 1;
+            }
+        } while (local_TickCount != xTaskGetTickCount());
+
+        *arg_pu32CurrentTime = (local_TickCount + local_u32PendingTicks) * (1000000 / configTICK_RATE_HZ) + local_u32SysTickCount / (configCPU_CLOCK_HZ / 1000000);
+    }
+    else
+    {
+        local_ErrStatus = SERVICE_RTOS_STAT_INVALID_PARAMS;
+    }
+
+    return local_ErrStatus;
+}
+
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_EnterCritical(void)
+{
+    taskENTER_CRITICAL();
+
+    return SERVICE_RTOS_STAT_OK;
+}
+
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ExitCritical(void)
+{
+    taskEXIT_CRITICAL();
+
+    return SERVICE_RTOS_STAT_OK;
+}
+
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetIdleTime(uint32_t* arg_pu32IdleTimeUS, uint32_t* arg_pu32TotalTimeUS)
+{
+    SERVICE_RTOS_ErrStat_t local_ErrStatus = SERVICE_RTOS_STAT_OK;
+
+    if(NULL != arg_pu32IdleTimeUS && NULL != arg_pu32TotalTimeUS)
+    {
+        *arg_pu32IdleTimeUS = ulTaskGetIdleRunTimeCounter();
+        *arg_pu32TotalTimeUS = SERVICE_RTOS_RunTimeCounter();
+    }
+    else
+    {
+        local_ErrStatus = SERVICE_RTOS_STAT_INVALID_PARAMS;
+    }
+
+    return local_ErrStatus;
+}
+
+/**
+ * 
+ */
+uint32_t SERVICE_RTOS_RunTimeCounter(void)
+{
+    uint32_t local_u32Time = 0;
+
+    SERVICE_RTOS_CurrentUSTime(&local_u32Time);
+
+    return local_u32Time;
+}
+
 /*************** END OF FUNCTIONS ***************************************************************************/
  
 // to be the IdleTask (called when no other tasks are running)
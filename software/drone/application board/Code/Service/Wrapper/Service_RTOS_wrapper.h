@@ -48,6 +48,10 @@
  * |                                                                    'SERVICE_RTOS_Notify'                                           |
  * |    18/06/2023      1.0.0           Abdelrahman Mohamed Salem       added support for getting remaining messages in queue in the.   |
  * |                                                                    function 'SERVICE_RTOS_ReadFromBlockingQueue'.                  |
+ * |    17/10/2026      1.1.0           agent                           added 'SERVICE_RTOS_CurrentUSTime',                             |
+ * |                                                                    'SERVICE_RTOS_EnterCritical', 'SERVICE_RTOS_ExitCritical' and   |
+ * |                                                                    'SERVICE_RTOS_GetIdleTime'.                                     |
+ * |    17/10/2026      1.1.0           agent                           made 'SERVICE_RTOS_Notify' yield from ISR.                      |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -540,5 +544,142 @@ SERVICE_RTOS_ErrStat_t SERVICE_RTOS_Notify(RTOS_TaskHandle_t arg_TaskToNotify_t,
 
 
 
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentUSTime(uint32_t* arg_pu32CurrentTime);
+ *  \b Description                              :       this functions is used as a wrapper function to get how many Microseconds passed since the schedular start running.
+ *  @param  arg_pu32CurrentTime [OUT]           :       The amount of time in Microsecond the schedular has been running for.
+ *  @note                                       :       the sub tick part is taken from the systick counter that drives the RTOS tick, the value wraps around every ~71 minutes.
+ *                                                      safe to call from an ISR or a critical section as long as the tick interrupt isn't held back for more than a tick.
+ *  \b PRE-CONDITION                            :       schedular is running.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentMSTime(uint32_t* arg_pu32CurrentTime)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "Service_RTOS_wrapper.h"
+ * 
+ * void task2_task(void *pvParameters)
+ * {
+ *   while (1)
+ *   {
+ *       uint32_t currentTime = 0;
+ *       SERVICE_RTOS_CurrentUSTime(&currentTime);
+ *      
+ *   }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentUSTime(uint32_t* arg_pu32CurrentTime);
+
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_EnterCritical(void);
+ *  \b Description                              :       this functions is used as a wrapper function to enter a critical section where neither interrupts nor context switches can happen.
+ *  @note                                       :       must be paired with SERVICE_RTOS_ExitCritical, keep the section as short as possible, calls can be nested.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       interrupts are disabled.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ExitCritical(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "Service_RTOS_wrapper.h"
+ * 
+ * void task2_task(void *pvParameters)
+ * {
+ *   while (1)
+ *   {
+ *       SERVICE_RTOS_EnterCritical();
+ *       // access data shared with an ISR
+ *       SERVICE_RTOS_ExitCritical();
+ *   }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_EnterCritical(void);
+
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ExitCritical(void);
+ *  \b Description                              :       this functions is used as a wrapper function to leave a critical section entered by SERVICE_RTOS_EnterCritical.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       SERVICE_RTOS_EnterCritical is called before.
+ *  \b POST-CONDITION                           :       interrupts are enabled again when leaving the outermost section.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_EnterCritical(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ *          refer to SERVICE_RTOS_EnterCritical
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ExitCritical(void);
+
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetIdleTime(uint32_t* arg_pu32IdleTimeUS, uint32_t* arg_pu32TotalTimeUS);
+ *  \b Description                              :       this functions is used as a wrapper function to get the time spent in the idle task and the total run time
+ *                                                      from the RTOS run time stats, both in Microsecond.
+ *  @param  arg_pu32IdleTimeUS [OUT]            :       the time the idle task has been running for.
+ *  @param  arg_pu32TotalTimeUS [OUT]           :       the time the schedular has been running for.
+ *  @note                                       :       the load over a window is the difference of two calls, both values wrap around every ~71 minutes.
+ *  \b PRE-CONDITION                            :       schedular is running.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentUSTime(uint32_t* arg_pu32CurrentTime)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "Service_RTOS_wrapper.h"
+ * 
+ * uint32_t idleBefore = 0, totalBefore = 0, idle = 0, total = 0;
+ * SERVICE_RTOS_GetIdleTime(&idleBefore, &totalBefore);
+ * SERVICE_RTOS_BlockFor(1000);
+ * SERVICE_RTOS_GetIdleTime(&idle, &total);
+ * printf("idle %lu%%\r\n", 100 * (idle - idleBefore) / (total - totalBefore));
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetIdleTime(uint32_t* arg_pu32IdleTimeUS, uint32_t* arg_pu32TotalTimeUS);
+
+/**
+ * @brief: clock of the RTOS run time stats in Microsecond (portGET_RUN_TIME_COUNTER_VALUE in "FreeRTOSConfig.h"), not to
+ *         be called by the application
+ */
+uint32_t SERVICE_RTOS_RunTimeCounter(void);
+
 /*** End of File **************************************************************/
 #endif /*SERVICE_RTOS_WRAPPER_H_*/
@@ -41,6 +41,29 @@
  * |    20/05/2023      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
  * |    21/05/2023      1.0.0           Abdelrahman Mohamed Salem       created the initial blueprint for tasks.                        |
  * |    22/05/2023      1.0.0           Abdelrahman Mohamed Salem       created the Queues for the IPC.                                 |
+ * |    17/10/2026      1.1.0           agent                           added fixed point build of the control loop.                    |
+ * |    17/10/2026      1.2.0           agent                           read the imu in one burst with its timestamp and temperature.   |
+ * |    17/10/2026      1.3.0           agent                           sensors collection is paced by the data ready pin of the        |
+ * |                                                                    MPU6050.                                                        |
+ * |    17/10/2026      1.4.0           agent                           the imu is drained from the FIFO of the MPU6050 in batches.     |
+ * |    17/10/2026      1.5.0           agent                           sensors are read at their own output rate by the sensors        |
+ * |                                                                    scheduler.                                                      |
+ * |    17/10/2026      1.6.0           agent                           the barometer is read in one transaction.                       |
+ * |    17/10/2026      1.7.0           agent                           the app board link is received by DMA and the communication     |
+ * |                                                                    task sleeps until it has work.                                  |
+ * |    17/10/2026      1.8.0           agent                           messages to and from the app board are COBS frames with         |
+ * |                                                                    sequence number and CRC sent by DMA.                            |
+ * |    17/10/2026      1.9.0           agent                           the messages to and from the app board are packed in scaled     |
+ * |                                                                    integers with comm_pack.h, the telemetry only sends what        |
+ * |                                                                    changed between keyframes                                       |
+ * |    17/10/2026      1.10.0          agent                           the gyroscope samples of the FIFO batch go through notches that |
+ * |                                                                    follow the motors speeds.                                       |
+ * |    17/10/2026      1.11.0          agent                           the collection and the fusion of the sensors are steps called   |
+ * |                                                                    by their tasks, or by the master task on the ticks of a         |
+ * |                                                                    hardware timer with 'CONTROL_LOOP_TIMER_DRIVEN'.                |
+ * |    17/10/2026      1.12.0          agent                           the sensor fusion task hands the newest state to the master     |
+ * |                                                                    task through a mailbox instead of a queue with                  |
+ * |                                                                    'SENSOR_HANDOFF_MAILBOX'.                                       |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -83,6 +106,16 @@
  */
 #include "SensorFusion.h"
 
+/**
+ * @reason: contains the scheduler picking the sensors to read in each collection
+ */
+#include "SensorScheduler.h"
+
+/**
+ * @reason: contains the notches that follow the motors speeds
+ */
+#include "RPMFilter.h"
+
 /**
  * @reason: contains pid ctrl block
  */
@@ -115,8 +148,13 @@
 
 /**
  * @brief: size of stack for master task in words
+ * @note: the master task also collects and fuses the sensors with CONTROL_LOOP_TIMER_DRIVEN
 */
+#if CONTROL_LOOP_TIMER_DRIVEN
+#define TASK_MASTER_STACK_SIZE 512
+#else
 #define TASK_MASTER_STACK_SIZE 256
+#endif
 
 
 
@@ -144,8 +182,23 @@
 /************************************************************************/
 /**
  * @brief: Queue length for 'queue_RawSensorData_Handle_t'
+ * @note: an item carries a whole IMU batch with SENSOR_IMU_FIFO_BATCH, the FIFO of the sensor does the buffering then
 */
+#if SENSOR_IMU_FIFO_BATCH
+#define QUEUE_RAW_SENSOR_DATA_LEN   4
+#else
 #define QUEUE_RAW_SENSOR_DATA_LEN   30
+#endif
+
+/**
+ * @brief: time in ms the collection task waits for room in 'queue_RawSensorData_Handle_t' instead of dropping the item
+ * @note: the 1 kHz FIFO of the MPU6050 keeps sampling meanwhile, the wait stops before it has no room for a whole batch
+*/
+#if SENSOR_IMU_FIFO_BATCH
+#define QUEUE_RAW_SENSOR_DATA_WAIT_MS   (MPU6050_FIFO_MAX_FRAMES - HAL_WRAPPER_IMU_BATCH_MAX)
+#else
+#define QUEUE_RAW_SENSOR_DATA_WAIT_MS   SENSOR_SAMPLE_PERIOD
+#endif
 
 /**
  * @brief: Queue length for 'queue_FusedSensorData_Handle_t'
@@ -162,6 +215,39 @@
 */
 #define QUEUE_DRONE_TO_APP_DATA_LEN   30
 
+/************************************************************************/
+/**
+ * @brief: longest time the app board communication task sleeps without being notified in milli seconds
+*/
+#define APP_COMM_MAX_SLEEP_MS   1000
+
+/**
+ * @brief: size of the chunks the received bytes are read in
+*/
+#define APP_COMM_REC_CHUNK_LEN   32
+
+/**
+ * @brief: number of messages handed to the DMA transmitter at once, must not be more than its queue (MCAL_UART_TX_QUEUE_LEN)
+*/
+#define APP_COMM_TX_FRAMES   3
+
+/**
+ * @brief: a message with all the telemetry is sent every APP_COMM_INFO_KEYFRAME_PERIOD messages, the others only carry what
+ *         changed since (refer to 'LIB_COMM_PACK_u8PackInfo'), 1 sends all the telemetry every time
+*/
+#define APP_COMM_INFO_KEYFRAME_PERIOD   8
+
+/**
+ * @brief: window over which the idle time of the CPU is measured in micro seconds (refer to 'global_u16IdlePermille')
+*/
+#define CPU_LOAD_WINDOW_US   1000000
+
+/**
+ * @brief: longest time the master task waits for a tick of the control loop in milli seconds, a timeout is counted as an
+ *         overrun
+*/
+#define CONTROL_LOOP_TICK_TIMEOUT_MS   ((CONTROL_LOOP_PERIOD_US / 1000) + 2)
+
 /************************************************************************/
 /**
  * @brief: maximum speed for motors to prevent damage
@@ -192,10 +278,60 @@
  * Module Preprocessor Macros
  *******************************************************************************/
 
+/**
+ * @brief: helpers to write the control loop once for both the floating point and the fixed point (Q16.16) builds
+*/
+#if SENSOR_FUSION_FIXED_POINT
+#define CONTROL_CONST(X)        LIB_MATH_FIXED_FLOAT_TO_Q16(X)
+#define CONTROL_FROM_FLOAT(X)   LIB_MATH_FIXED_q16FromFloat(X)
+#define CONTROL_TO_FLOAT(X)     LIB_MATH_FIXED_Q16_TO_FLOAT(X)
+#define CONTROL_TO_INT(X)       LIB_MATH_FIXED_Q16_TO_INT(X)
+#define CONTROL_PID(X)          pid_ctrl_fixed(X)
+#else
+#define CONTROL_CONST(X)        (X)
+#define CONTROL_FROM_FLOAT(X)   (X)
+#define CONTROL_TO_FLOAT(X)     (X)
+#define CONTROL_TO_INT(X)       (X)
+#define CONTROL_PID(X)          pid_ctrl(X)
+#endif
+
+/**
+ * @brief: average of N raw IMU samples given their sum, in the units of 'RawSensorDataItem_t'
+*/
+#if SENSOR_FUSION_FIXED_POINT
+#define IMU_BATCH_ACC_AVG(SUM, N)   ((int16_t)((SUM) / (N)))
+#define IMU_BATCH_GYRO_AVG(SUM, N)  ((int16_t)((SUM) / (N)))
+#else
+#define IMU_BATCH_ACC_AVG(SUM, N)   ((float)(SUM) / ((N) * HAL_WRAPPER_ACC_RAW_LSB_PER_G))
+#define IMU_BATCH_GYRO_AVG(SUM, N)  ((float)(SUM) / ((N) * HAL_WRAPPER_GYRO_RAW_LSB_PER_DPS))
+#endif
+
 /******************************************************************************
  * Module Typedefs
  *******************************************************************************/
 
+/**
+ * @brief: type of the values and pid blocks of the control loop
+*/
+typedef SensorFusionAngle_t control_value_t;
+#if SENSOR_FUSION_FIXED_POINT
+typedef pid_fixed_obj_t control_pid_t;
+#else
+typedef pid_obj_t control_pid_t;
+#endif
+
+/**
+ * @brief: timing of the control loop run by the master task on the ticks of the hardware timer (CONTROL_LOOP_TIMER_DRIVEN)
+*/
+typedef struct {
+    uint32_t periods;               /**< number of periods run */
+    uint32_t overruns;              /**< number of ticks missed because a period took longer than CONTROL_LOOP_PERIOD_US */
+    uint32_t busyUS;                /**< time from the tick to the end of the work of the last period */
+    uint32_t busyMaxUS;             /**< longest busyUS since boot */
+    uint32_t sensorToMotorUS;       /**< time from the newest IMU sample to the write of the ESCs in the last period that flew */
+    uint32_t sensorToMotorMaxUS;    /**< longest sensorToMotorUS since boot */
+} ControlLoopStats_t;
+
 /******************************************************************************
  * Module Variable Definitions
  *******************************************************************************/
@@ -222,6 +358,14 @@ RTOS_QueueHandle_t queue_AppCommToDrone_Handle_t;
 */
 RTOS_QueueHandle_t queue_DroneCommToApp_Handle_t;
 
+#if !CONTROL_LOOP_TIMER_DRIVEN && SENSOR_HANDOFF_MAILBOX
+/**
+ * @brief: mailbox of the newest fused state of the drone (SENSOR_HANDOFF_MAILBOX) and the storage of its items
+*/
+SensorFusionDataItem_t mailbox_FusedSensorDataItems_t[SERVICE_RTOS_MAILBOX_BUFFERS] = {0};
+RTOS_Mailbox_t mailbox_FusedSensorData_t;
+#endif
+
 /************************************************************************/
 /**
  * @brief: handler which act as identifier for the sensor data collection task through which we will deal with anything related to this task 
@@ -246,15 +390,60 @@ RTOS_TaskHandle_t task_Master_Handle_t = NULL;
 /************************************************************************/
 
 /**
- * @brief: strcut through which we will communicate with app board 
+ * @brief: decoder of the frames received from the app board (refer to "comm_frame.h")
 */
-HAL_WRAPPER_AppCommMsg_t global_AppCommMsg_t = {0};
+LIB_COMM_FRAME_Decoder_t global_CommRxDecoder_t = {0};
 
 /**
  * @brief: actual place where the received data will be placed
  */
 AppToDroneDataItem_t global_MsgToRec_t = {0};
 
+/**
+ * @brief: time spent in the idle task over the last CPU_LOAD_WINDOW_US in 1/1000 (from the RTOS run time stats)
+ */
+volatile uint16_t global_u16IdlePermille = 0;
+
+/**
+ * @brief: encoded messages to the app board and the frames sending them, the DMA sends each message from here while the next ones are
+ *         taken from the queue, a frame is free again when it's not HAL_WRAPPER_CommFrame_t::status MCAL_UART_STAT_PENDING
+ */
+uint8_t global_u8CommTxBuffer[APP_COMM_TX_FRAMES][COMM_FRAME_INFO_LEN] = {0};
+HAL_WRAPPER_CommFrame_t global_CommTxFrame_t[APP_COMM_TX_FRAMES] = {0};
+
+/**
+ * @brief: bytes sent to the app board per second over the last CPU_LOAD_WINDOW_US
+ */
+volatile uint32_t global_u32CommTxBytesPerSec = 0;
+
+/**
+ * @brief: output period and deadline of each sensor read by the collection task (indexed by @SENSOR_ID_t), the IMU is
+ *         read in every collection. the counters of the entries tell how often each sensor was read, deferred or late
+ */
+sensor_sched_entry_t global_SensorSched_t[SENSOR_ID_COUNT] = {
+    [SENSOR_ID_IMU]     = {.periodUS = 0,                        .deadlineUS = 0},
+    [SENSOR_ID_MAGNET]  = {.periodUS = SENSOR_MAGNET_PERIOD_US,  .deadlineUS = SENSOR_MAGNET_DEADLINE_US},
+    [SENSOR_ID_BARO]    = {.periodUS = SENSOR_BARO_PERIOD_US,    .deadlineUS = SENSOR_BARO_DEADLINE_US},
+    [SENSOR_ID_BATTERY] = {.periodUS = SENSOR_BATTERY_PERIOD_US, .deadlineUS = SENSOR_BATTERY_DEADLINE_US},
+};
+
+#if SENSOR_GYRO_RPM_FILTER
+/**
+ * @brief: notches on the harmonics of the motors applied to every gyroscope sample of the batch
+ */
+rpm_filter_t global_RpmFilter_t;
+#endif
+
+/**
+ * @brief: pressure at the start, reference of the altitude from the barometer
+ */
+HAL_WRAPPER_Pressure_t global_RefPressure_t = {0};
+
+/**
+ * @brief: timing of the control loop, only updated with CONTROL_LOOP_TIMER_DRIVEN
+ */
+volatile ControlLoopStats_t global_ControlLoopStats_t = {0};
+
 
 /******************************************************************************
  * Function Prototypes
@@ -265,118 +454,283 @@ AppToDroneDataItem_t global_MsgToRec_t = {0};
  *******************************************************************************/
 
 /************************************************************************/
-void UARTReceivedISR(void)
+void UARTReceivedFrames(void)
 {
-    
-    static uint8_t local_u8MsgType = DATA_TYPE_INVALID;
-    static uint16_t local_u16CurrentItem = 0;
-    static HAL_WRAPPER_ErrStat_t local_errState = HAL_WRAPPER_STAT_OK;
-    static uint8_t local_u8Dummy = 0;
-
-    // see if there is anything to receive
-    local_errState = HAL_WRAPPER_GetCommMessage(&local_u8Dummy);
-
-    if(HAL_WRAPPER_STAT_OK == local_errState)
+    uint8_t local_u8Chunk[APP_COMM_REC_CHUNK_LEN] = {0};
+    uint16_t local_u16ChunkLen = 0;
+    const uint8_t* local_pu8Payload = NULL;
+    uint16_t local_u16PayloadLen = 0;
+    LIB_COMM_PACK_Move_t local_Move_t = {0};
+    uint16_t i = 0;
+
+    // take everything the DMA received up to the end of the last burst
+    while(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_GetCommFrame(local_u8Chunk, sizeof(local_u8Chunk), &local_u16ChunkLen))
     {
-        if(0 == global_AppCommMsg_t.dataIsToReceive)
+        for(i = 0; i < local_u16ChunkLen; i++)
         {
-            // check if the received byte is of correct type
-            local_u8MsgType = local_u8Dummy;
-            if(DATA_TYPE_MOVE == local_u8MsgType)
-            {
-                local_u16CurrentItem = 1;
-                global_AppCommMsg_t.dataIsToReceive = 1;
-                *global_AppCommMsg_t.dataToReceive = local_u8MsgType;
-            }
-            else
+            // the frames are checked by their CRC, a corrupted one is dropped and the next one is received normally
+            if(0 == LIB_COMM_FRAME_u8Decode(&global_CommRxDecoder_t, local_u8Chunk[i]))
             {
-                // invalid header, discard
+                continue;
             }
 
-        }
-        else
-        {
-            // stare data in the variable
-            *(global_AppCommMsg_t.dataToReceive + local_u16CurrentItem) = local_u8Dummy;
-            local_u16CurrentItem++;
-
-            // check if we reached the correct length of the message to receive
-            if(local_u16CurrentItem == global_AppCommMsg_t.dataToReceiveLen)
+            local_pu8Payload = LIB_COMM_FRAME_pu8Payload(&global_CommRxDecoder_t, &local_u16PayloadLen);
+            if(0 == LIB_COMM_PACK_u8UnpackMove(local_pu8Payload, local_u16PayloadLen, &local_Move_t))
             {
-                global_AppCommMsg_t.IsDataReceived = 1;
+                // valid frame of a message this board doesn't expect, discard
+                continue;
             }
+
+            // append the new received message to the queue
+            global_MsgToRec_t.type = DATA_TYPE_MOVE;
+            global_MsgToRec_t.startDrone = (0 != (local_Move_t.flags & LIB_COMM_PACK_FLAG_START));
+            global_MsgToRec_t.roll = local_Move_t.roll;
+            global_MsgToRec_t.pitch = local_Move_t.pitch;
+            global_MsgToRec_t.thrust = local_Move_t.thrust;
+            global_MsgToRec_t.yaw = local_Move_t.yaw;
+            SERVICE_RTOS_AppendToBlockingQueue(0, (const void *) &global_MsgToRec_t, queue_AppCommToDrone_Handle_t);
+            SERVICE_RTOS_Notify(task_Master_Handle_t, LIB_CONSTANTS_DISABLED);
         }
     }
+}
 
+/************************************************************************/
+/**
+ * @brief: called from the DMA interrupt when a message is sent, wakes the communication task to send the next ones
+*/
+void UARTFrameSent(HAL_WRAPPER_CommFrame_t* arg_pFrame)
+{
+    SERVICE_RTOS_Notify(task_AppComm_Handle_t, LIB_CONSTANTS_ENABLED);
 }
 
 /************************************************************************/
 /**
- * @brief: this task is responsible for the collection of sensor data
+ * @brief: prepares the sensors collection, every sensor is due in the first collection
 */
-void Task_CollectSensorData(void)
-{   
-    HAL_WRAPPER_Acc_t local_Acc_t = {0};
-    HAL_WRAPPER_Gyro_t local_gyro_t = {0};
-    HAL_WRAPPER_Magnet_t local_magnet_t = {0};
-    HAL_WRAPPER_Pressure_t local_pressure_t = {0};
-    HAL_WRAPPER_Pressure_t ref_pressure_t = {0};
-    HAL_WRAPPER_Temperature_t local_temperature_t = {0};
-    HAL_WRAPPER_Altitude_t local_altitude_t = {0};
-    HAL_WRAPPER_Battery_t local_battery_t = {0};
-
-    // the item to push into the queue
-    RawSensorDataItem_t local_out_t = {0};
+void SensorCollectionInit(void)
+{
+    uint32_t local_u32NowUS = 0;
 
     // read the start pressure
-    HAL_WRAPPER_ReadPressure(&ref_pressure_t);
+    HAL_WRAPPER_ReadPressure(&global_RefPressure_t);
 
-    while (1)
-    {
-        // read accelerometer data
-        HAL_WRAPPER_ReadAcc(&local_Acc_t);
-        
-        // read gyroscope data
-        HAL_WRAPPER_ReadGyro(&local_gyro_t);
+    // every sensor is due in the first collection
+    SERVICE_RTOS_CurrentUSTime(&local_u32NowUS);
+    SensorSched_Init(global_SensorSched_t, SENSOR_ID_COUNT, local_u32NowUS);
 
-        // read magnetometer data
-        HAL_WRAPPER_ReadMagnet(&local_magnet_t);
+#if SENSOR_GYRO_RPM_FILTER
+    RpmFilter_Init(&global_RpmFilter_t, HAL_WRAPPER_IMU_SAMPLE_PERIOD_US);
+#endif
+}
 
-        // read barometer data
-         HAL_WRAPPER_ReadPressure(&local_pressure_t);
+/**
+ * @brief: reads the sensors that are due into the item, the others keep their previous reading in it
+*/
+void SensorCollectionStep(RawSensorDataItem_t* arg_pOut)
+{
+#if SENSOR_IMU_FIFO_BATCH
+    int32_t local_s32AccSum[3] = {0};
+    int32_t local_s32GyroSum[3] = {0};
+    uint8_t i = 0;
+#elif SENSOR_FUSION_FIXED_POINT
+    HAL_WRAPPER_ImuRaw_t local_imu_t = {0};
+#else
+    HAL_WRAPPER_Imu_t local_imu_t = {0};
+#endif
+#if SENSOR_GYRO_RPM_FILTER
+    HAL_WRAPPER_MotorRPM_t local_rpm_t = {0};
+#endif
+    uint32_t local_u32NowUS = 0;
+    uint32_t local_u32Due = 0;
+
+    // only the sensors that have a new output since their last read are read in this collection
+    SERVICE_RTOS_CurrentUSTime(&local_u32NowUS);
+    local_u32Due = SensorSched_GetDue(global_SensorSched_t, SENSOR_ID_COUNT, local_u32NowUS, SENSOR_SAMPLE_PERIOD * 1000);
+
+#if SENSOR_IMU_FIFO_BATCH
+    // drain the samples the MPU6050 pushed into its FIFO since the last collection
+    if(HAL_WRAPPER_STAT_OK != HAL_WRAPPER_ReadImuBatch(&arg_pOut->ImuBatch))
+        arg_pOut->ImuBatch.count = 0;
+
+#if SENSOR_GYRO_RPM_FILTER
+    // move the notches to the last speeds sent by the ESCs, a motor without a reply keeps its notches off
+    if(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_GetMotorRPM(&local_rpm_t))
+        RpmFilter_SetMotors(&global_RpmFilter_t, local_rpm_t.rpm, local_rpm_t.valid);
+#endif
+
+    // the estimators that don't use the batch take its average as one sample
+    if(0 != arg_pOut->ImuBatch.count)
+    {
+        for(i = 0; i < arg_pOut->ImuBatch.count; i++)
+        {
+#if SENSOR_GYRO_RPM_FILTER
+            // the batch is filtered in place so the fusion sees the same samples as the average
+            arg_pOut->ImuBatch.frames[i].gyro.roll = RpmFilter_Apply(&global_RpmFilter_t, RPM_FILTER_AXIS_ROLL, arg_pOut->ImuBatch.frames[i].gyro.roll);
+            arg_pOut->ImuBatch.frames[i].gyro.pitch = RpmFilter_Apply(&global_RpmFilter_t, RPM_FILTER_AXIS_PITCH, arg_pOut->ImuBatch.frames[i].gyro.pitch);
+            arg_pOut->ImuBatch.frames[i].gyro.yaw = RpmFilter_Apply(&global_RpmFilter_t, RPM_FILTER_AXIS_YAW, arg_pOut->ImuBatch.frames[i].gyro.yaw);
+#endif
+            local_s32AccSum[0] += arg_pOut->ImuBatch.frames[i].acc.x;
+            local_s32AccSum[1] += arg_pOut->ImuBatch.frames[i].acc.y;
+            local_s32AccSum[2] += arg_pOut->ImuBatch.frames[i].acc.z;
+            local_s32GyroSum[0] += arg_pOut->ImuBatch.frames[i].gyro.roll;
+            local_s32GyroSum[1] += arg_pOut->ImuBatch.frames[i].gyro.pitch;
+            local_s32GyroSum[2] += arg_pOut->ImuBatch.frames[i].gyro.yaw;
+        }
+        arg_pOut->Acc.x = IMU_BATCH_ACC_AVG(local_s32AccSum[0], arg_pOut->ImuBatch.count);
+        arg_pOut->Acc.y = IMU_BATCH_ACC_AVG(local_s32AccSum[1], arg_pOut->ImuBatch.count);
+        arg_pOut->Acc.z = IMU_BATCH_ACC_AVG(local_s32AccSum[2], arg_pOut->ImuBatch.count);
+        arg_pOut->Gyro.roll = IMU_BATCH_GYRO_AVG(local_s32GyroSum[0], arg_pOut->ImuBatch.count);
+        arg_pOut->Gyro.pitch = IMU_BATCH_GYRO_AVG(local_s32GyroSum[1], arg_pOut->ImuBatch.count);
+        arg_pOut->Gyro.yaw = IMU_BATCH_GYRO_AVG(local_s32GyroSum[2], arg_pOut->ImuBatch.count);
+        arg_pOut->ImuTimestamp = arg_pOut->ImuBatch.timestamp;
+    }
+#else
+    // read accelerometer, gyroscope and temperature data in one transaction, a failed read keeps the previous sample
+#if SENSOR_FUSION_FIXED_POINT
+    if(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_ReadImuRaw(&local_imu_t))
+#else
+    if(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_ReadImu(&local_imu_t))
+#endif
+    {
+        arg_pOut->Acc = local_imu_t.acc;
+        arg_pOut->Gyro = local_imu_t.gyro;
+        arg_pOut->ImuTemperature = local_imu_t.temperature;
+        arg_pOut->ImuTimestamp = local_imu_t.timestamp;
+    }
+#endif
 
-        // read temperature data
-         HAL_WRAPPER_ReadTemperature(&local_temperature_t);
+    // read magnetometer data
+    if(local_u32Due & SENSOR_FRESH(SENSOR_ID_MAGNET))
+    {
+#if SENSOR_FUSION_FIXED_POINT
+        HAL_WRAPPER_ReadMagnetRaw(&arg_pOut->Magnet);
+#else
+        HAL_WRAPPER_ReadMagnet(&arg_pOut->Magnet);
+#endif
+    }
 
-        // read altitude from barometer
-//         HAL_WRAPPER_ReadAltitude(&local_altitude_t, &ref_pressure_t);
+    // read barometer pressure and temperature data
+    if(local_u32Due & SENSOR_FRESH(SENSOR_ID_BARO))
+        HAL_WRAPPER_ReadBarometer(&arg_pOut->Pressure, &arg_pOut->Temperature);
 
-        // read battery charge
-         HAL_WRAPPER_GetBatteryCharge(&local_battery_t);
+    // read altitude from barometer
+//     HAL_WRAPPER_ReadAltitude(&arg_pOut->Altitude, &global_RefPressure_t);
+
+    // read battery charge
+    if(local_u32Due & SENSOR_FRESH(SENSOR_ID_BATTERY))
+        HAL_WRAPPER_GetBatteryCharge(&arg_pOut->Battery);
 
 // FOR SERIAL MONITOR
-//        printf("MPU6050 ACC: x: %f,  y: %f,  z: %f\r\n", local_Acc_t.x, local_Acc_t.y, local_Acc_t.z);
-//        printf("MPU6050 Gyro: roll: %f,  pitch: %f,  yaw: %f\r\n", local_gyro_t.roll, local_gyro_t.pitch, local_gyro_t.yaw);
-//        printf("MPU6050 ACC: x: %f,  y: %f,  z: %f\r\n", local_Acc_t.x, local_Acc_t.y, local_Acc_t.z);
-// printf("MPU6050 ACC: x: %f,  y: %f,  z: %f\r\n", local_Acc_t.x, local_Acc_t.y, local_Acc_t.z);
+//    printf("MPU6050 ACC: x: %f,  y: %f,  z: %f\r\n", arg_pOut->Acc.x, arg_pOut->Acc.y, arg_pOut->Acc.z);
+//    printf("MPU6050 Gyro: roll: %f,  pitch: %f,  yaw: %f\r\n", arg_pOut->Gyro.roll, arg_pOut->Gyro.pitch, arg_pOut->Gyro.yaw);
 
 // FOR SERIAL PLOTTER
-    //    printf("%d,%d,%d\r\n", local_magnet_t.x, local_magnet_t.y, local_magnet_t.z);
+//    printf("%d,%d,%d\r\n", arg_pOut->Magnet.x, arg_pOut->Magnet.y, arg_pOut->Magnet.z);
 
-        // assign variables
-        local_out_t.Acc = local_Acc_t;
-        local_out_t.Gyro = local_gyro_t;
-        local_out_t.Magnet = local_magnet_t;
-        local_out_t.Pressure = local_pressure_t;
-        local_out_t.Temperature = local_temperature_t;
-        local_out_t.Altitude = local_altitude_t;
-        local_out_t.Battery = local_battery_t;
+    arg_pOut->Fresh = (uint8_t)local_u32Due;
+}
+
+/************************************************************************/
+/**
+ * @brief: prepares the attitude and altitude estimators
+*/
+void SensorFusionInit(void)
+{
+    // Initialize 2d-kalman filter matrices
+    Altitude_Kalman_2D_init();
+
+#if SENSOR_FUSION_ESTIMATOR == SENSOR_FUSION_ESTIMATOR_MAHONY
+    // start the attitude estimator from the level attitude
+    Attitude_Mahony_init();
+#endif
+}
+
+/**
+ * @brief: fuses one collection of the sensors into the state of the drone, and sends some info to the app board every second
+*/
+void SensorFusionStep(RawSensorDataItem_t* arg_pIn, SensorFusionDataItem_t* arg_pOut)
+{
+    SensorFusionDataItem_t local_temp_t = {0};
+    DroneToAppDataItem_t local_DataToSendtoApp_t = {0};
+    uint32_t CurrentTimeMS = 0;
+    static uint32_t CurrentTimeCounterS = 0;
+
+#if SENSOR_FUSION_ESTIMATOR == SENSOR_FUSION_ESTIMATOR_MAHONY
+    // apply quaternion filter with sensor fusion
+    SensorFuseWithMahony(arg_pIn, &local_temp_t);
+#else
+    // apply kalman filter with sensor fusion
+    SensorFuseWithKalman(arg_pIn, &local_temp_t);
+#endif
+
+    // actual measurements showed that roll and pitch are reversed and pitch is in negative
+    arg_pOut->pitch = -local_temp_t.roll;
+    arg_pOut->roll = local_temp_t.pitch;
+    arg_pOut->yaw = local_temp_t.yaw;
+    arg_pOut->yaw_rate = local_temp_t.yaw_rate;
+    arg_pOut->altitude = local_temp_t.altitude;
+    arg_pOut->vertical_velocity = local_temp_t.vertical_velocity;
+
+    // check if a second passed to send some info to the application board
+    SERVICE_RTOS_CurrentMSTime(&CurrentTimeMS);
+    if(1000 < CurrentTimeMS - CurrentTimeCounterS)
+    {
+        // assign new time
+        CurrentTimeCounterS += 1000;
+
+        // set type of data to send
+        local_DataToSendtoApp_t.data.type = DATA_TYPE_INFO;
 
-        // push the data into the queue for fusion
-        SERVICE_RTOS_AppendToBlockingQueue(0, (const void *) &local_out_t, queue_RawSensorData_Handle_t);
+        // read temperature data
+        local_DataToSendtoApp_t.data.data.info.temperature = arg_pIn->Temperature.temperature;
+
+        // read battery charge
+        local_DataToSendtoApp_t.data.data.info.batteryCharge = arg_pIn->Battery.batteryCharge;
+
+        // assign current altitude
+        local_DataToSendtoApp_t.data.data.info.altitude = arg_pIn->Altitude.ultrasonic_altitude / 100.0;
+
+        // assign distanceToOrigin (TODO)
+        local_DataToSendtoApp_t.data.data.info.distanceToOrigin = 1.5;
+
+        // push data into queue to be sent to the app board and notify the AppComm with new data
+        SERVICE_RTOS_AppendToBlockingQueue(0, (const void *) &local_DataToSendtoApp_t, queue_DroneCommToApp_Handle_t);
+        SERVICE_RTOS_Notify(task_AppComm_Handle_t, LIB_CONSTANTS_DISABLED);
+    }
 
+    // TODO: move the below line
+//    if(arg_pOut->vertical_velocity >= 1)
+//    printf("%d,%d,%d,%d\n\r", (int)arg_pOut->pitch, (int)arg_pOut->roll, (int)arg_pOut->yaw, (int)arg_pOut->vertical_velocity);
+}
+
+#if !CONTROL_LOOP_TIMER_DRIVEN
+/************************************************************************/
+/**
+ * @brief: this task is responsible for the collection of sensor data
+*/
+void Task_CollectSensorData(void)
+{   
+    // the item to push into the queue, the sensors that aren't due keep their previous reading in it
+    RawSensorDataItem_t local_out_t = {0};
+
+    SensorCollectionInit();
+
+    while (1)
+    {
+#if SENSOR_DATA_READY_PACING
+        // wait for the MPU6050 to latch a new sample, the timeout keeps the loop running if the pulse doesn't come
+        HAL_WRAPPER_WaitImuDataReady(SENSOR_SAMPLE_PERIOD + 1);
+#endif
+
+        SensorCollectionStep(&local_out_t);
+
+        // push the data into the queue for fusion, a full queue holds the collection back instead of losing the batch
+        SERVICE_RTOS_AppendToBlockingQueue(QUEUE_RAW_SENSOR_DATA_WAIT_MS, (const void *) &local_out_t, queue_RawSensorData_Handle_t);
+
+#if !SENSOR_DATA_READY_PACING
         // sleep for 5 ms
         SERVICE_RTOS_BlockFor(SENSOR_SAMPLE_PERIOD);
+#endif
     }
 }
 
@@ -387,152 +741,145 @@ void Task_CollectSensorData(void)
 void Task_SensorFusion(void)
 {
     RawSensorDataItem_t local_in_t = {0};
-    SensorFusionDataItem_t local_temp_t = {0};
-    SensorFusionDataItem_t local_out_t = {0};
     SERVICE_RTOS_ErrStat_t local_ErrStatus = SERVICE_RTOS_STAT_OK;
-    DroneToAppDataItem_t local_DataToSendtoApp_t = {0};
     uint8_t local_u8LenOfRemaining = 0;
-    uint32_t CurrentTimeMS = 0;
-    uint32_t CurrentTimeCounterS = 0;
+#if SENSOR_HANDOFF_MAILBOX
+    SensorFusionDataItem_t* local_pOut = NULL;
+#else
+    SensorFusionDataItem_t local_out_t = {0};
+#endif
 
-    // Initialize 2d-kalman filter matrices
-    Altitude_Kalman_2D_init();
+    SensorFusionInit();
 
     while (1)
     {
-        // read item from raw sensor queue
+        // read item from raw sensor queue, every collection is fused as it carries IMU samples and fresh readings that
+        // aren't in the next one
         local_ErrStatus = SERVICE_RTOS_ReadFromBlockingQueue(1000, (void *) &local_in_t, queue_RawSensorData_Handle_t, &local_u8LenOfRemaining);
 
         // check if we got back a reading
         if(SERVICE_RTOS_STAT_OK == local_ErrStatus)
         {
-            // apply kalman filter with sensor fusion
-            SensorFuseWithKalman(&local_in_t, &local_temp_t);
-
-            // actual measurements showed that roll and pitch are reversed and pitch is in negative
-            local_out_t.pitch = -local_temp_t.roll;
-            local_out_t.roll = local_temp_t.pitch;
-            local_out_t.yaw = local_temp_t.yaw;
-            local_out_t.yaw_rate = local_temp_t.yaw_rate;
-            local_out_t.altitude = local_temp_t.altitude;
-            local_out_t.vertical_velocity = local_temp_t.vertical_velocity;
-
-            // check if a second passed to send some info to the application board
-            SERVICE_RTOS_CurrentMSTime(&CurrentTimeMS);
-            if(1000 < CurrentTimeMS - CurrentTimeCounterS)
-            {
-            	// assign new time
-            	CurrentTimeCounterS += 1000;
-
-                // set type of data to send
-                local_DataToSendtoApp_t.data.type = DATA_TYPE_INFO;
-
-                // read temperature data
-                local_DataToSendtoApp_t.data.data.info.temperature = local_in_t.Temperature.temperature;
-
-                // read battery charge
-                local_DataToSendtoApp_t.data.data.info.batteryCharge = local_in_t.Battery.batteryCharge;
-
-                // assign current altitude
-                local_DataToSendtoApp_t.data.data.info.altitude = local_in_t.Altitude.ultrasonic_altitude / 100.0;
-
-                // assign distanceToOrigin (TODO)
-                local_DataToSendtoApp_t.data.data.info.distanceToOrigin = 1.5;       
-
-                // push data into queue to be sent to the app board and notify the AppComm with new data
-                SERVICE_RTOS_AppendToBlockingQueue(0, (const void *) &local_DataToSendtoApp_t, queue_DroneCommToApp_Handle_t);
-                SERVICE_RTOS_Notify(task_AppComm_Handle_t, LIB_CONSTANTS_DISABLED);       
-            }
-
+#if SENSOR_HANDOFF_MAILBOX
+            // the state is written straight into the mailbox of the master task, the one it didn't take yet is overwritten
+            SERVICE_RTOS_GetMailboxWriteBuffer((void **) &local_pOut, &mailbox_FusedSensorData_t);
+            SensorFusionStep(&local_in_t, local_pOut);
+            SERVICE_RTOS_PublishMailbox(&mailbox_FusedSensorData_t);
+            SERVICE_RTOS_Notify(task_Master_Handle_t, LIB_CONSTANTS_DISABLED);
+#else
+            SensorFusionStep(&local_in_t, &local_out_t);
 
             // append to the queue the the current state
             SERVICE_RTOS_AppendToBlockingQueue(0, (const void *) &local_out_t, queue_FusedSensorData_Handle_t);
             SERVICE_RTOS_Notify(task_Master_Handle_t, LIB_CONSTANTS_DISABLED); 
-
-            // TODO: move the below line
-//            if(local_out_t.vertical_velocity >= 1)
-//            printf("%d,%d,%d,%d\n\r", (int)local_out_t.pitch, (int)local_out_t.roll, (int)local_out_t.yaw, (int)local_out_t.vertical_velocity);
-
+#endif
         }
     }
 }
+#endif
 
 /************************************************************************/
 /**
  * @brief: this task is responsible for communication with the application board 
- * @note: it has no delay so it will running instead of the idle task
+ * @note: it sleeps until a message is queued to be sent or the app board sends something
 */
 void Task_AppComm(void)
 {
     
     SERVICE_RTOS_ErrStat_t local_RTOSErrStatus = SERVICE_RTOS_STAT_OK;
     
-    DroneToAppDataItem_t local_MsgToSend_t = {0};
     uint8_t local_u8LenOfRemaining = 0;
+    uint8_t local_u8NextFrame = 0;
+    uint8_t local_u8TxSeq = 0;
+    DroneToAppDataItem_t local_MsgToSend_t = {0};
+    LIB_COMM_PACK_Info_t local_Info_t = {0};
+    LIB_COMM_PACK_InfoState_t local_InfoState_t = {0};
+    uint8_t local_u8Payload[LIB_COMM_PACK_INFO_LEN] = {0};
+    uint8_t local_u8PayloadLen = 0;
+    HAL_WRAPPER_CommFrame_t* local_pFrame = NULL;
+    HAL_WRAPPER_CommTxStats_t local_TxStats_t = {0};
+    uint32_t local_u32WindowTxBytes = 0;
+
+    // idle time measurement
+    uint32_t local_u32IdleUS = 0;
+    uint32_t local_u32TotalUS = 0;
+    uint32_t local_u32WindowIdleUS = 0;
+    uint32_t local_u32WindowStartUS = 0;
+
+    // each frame always sends its own buffer
+    for(local_u8NextFrame = 0; local_u8NextFrame < APP_COMM_TX_FRAMES; local_u8NextFrame++)
+    {
+        global_CommTxFrame_t[local_u8NextFrame].data = global_u8CommTxBuffer[local_u8NextFrame];
+        global_CommTxFrame_t[local_u8NextFrame].callBack = UARTFrameSent;
+    }
+    local_u8NextFrame = 0;
 
-    // assign pointers and lengths of data to be always send
-    global_AppCommMsg_t.dataToSend = (uint8_t*)&local_MsgToSend_t.data;
-    global_AppCommMsg_t.dataToSendLen = sizeof(local_MsgToSend_t.data);
+    LIB_COMM_PACK_vidInfoInit(&local_InfoState_t, APP_COMM_INFO_KEYFRAME_PERIOD);
+
+    // the DMA receiver wakes this task when the app board stops sending
+    HAL_WRAPPER_SetAppCommRecTask(task_AppComm_Handle_t);
+
+    SERVICE_RTOS_GetIdleTime(&local_u32WindowIdleUS, &local_u32WindowStartUS);
 
     while (1)
     {
-        // // wait for notification (this task will run instead of idle task)
-        // SERVICE_RTOS_WaitForNotification(1000);
-
-        // check if there is anything in the queue to be sent
-        local_RTOSErrStatus = SERVICE_RTOS_ReadFromBlockingQueue(0, (void *) &local_MsgToSend_t, queue_DroneCommToApp_Handle_t, &local_u8LenOfRemaining);
+        // wait for notification from the task producing the messages to send, the receiver or the transmitter
+        SERVICE_RTOS_WaitForNotification(APP_COMM_MAX_SLEEP_MS);
 
-        // loop until all message are sent
-        while (local_u8LenOfRemaining && SERVICE_RTOS_STAT_OK == local_RTOSErrStatus)
+        // hand the queued messages to the transmitter while it has free frames, they are used in order so the messages are sent in order
+        local_pFrame = &global_CommTxFrame_t[local_u8NextFrame];
+        while (MCAL_UART_STAT_PENDING != local_pFrame->status)
         {
-            // send the message
-            size_t i = 0;
-            while (i < global_AppCommMsg_t.dataToSendLen)
+            local_RTOSErrStatus = SERVICE_RTOS_ReadFromBlockingQueue(0, (void *) &local_MsgToSend_t, queue_DroneCommToApp_Handle_t, &local_u8LenOfRemaining);
+            if(SERVICE_RTOS_STAT_OK != local_RTOSErrStatus || 0 == local_u8LenOfRemaining)
             {
-                if(HAL_WRAPPER_SendCommMessage(*(global_AppCommMsg_t.dataToSend + i)) == HAL_WRAPPER_STAT_OK)
-                {
-                    i++;
-                }
-                else
-                {
-                    // check if there anything app board is sending as in case of failure of sending, it maybe due receive buffer not empty
-                    UARTReceivedISR();
-                    if(global_AppCommMsg_t.IsDataReceived)
-                    {   
-                        // append the new state received to the queue
-                        SERVICE_RTOS_AppendToBlockingQueue(0, (const void *) &global_MsgToRec_t, queue_AppCommToDrone_Handle_t);
-                        SERVICE_RTOS_Notify(task_Master_Handle_t, LIB_CONSTANTS_DISABLED);  
-
-                        global_AppCommMsg_t.dataIsToReceive = 0;
-                        global_AppCommMsg_t.IsDataReceived = 0;
-                    }
-                }
+                break;
+            }
 
+            if(DATA_TYPE_INFO != local_MsgToSend_t.data.type)
+            {
+                // the app board only takes the telemetry
+                continue;
             }
-            
-            // read next message
-            local_RTOSErrStatus = SERVICE_RTOS_ReadFromBlockingQueue(0, (void *) &local_MsgToSend_t, queue_DroneCommToApp_Handle_t, &local_u8LenOfRemaining);
+
+            // pack the telemetry in scaled integers, only what changed since the last keyframe is sent
+            local_Info_t.distanceToOrigin = local_MsgToSend_t.data.data.info.distanceToOrigin;
+            local_Info_t.altitude = local_MsgToSend_t.data.data.info.altitude;
+            local_Info_t.temperature = local_MsgToSend_t.data.data.info.temperature;
+            local_Info_t.batteryCharge = local_MsgToSend_t.data.data.info.batteryCharge;
+            local_u8PayloadLen = LIB_COMM_PACK_u8PackInfo(&local_InfoState_t, &local_Info_t, local_u8Payload);
+
+            // encode the message straight into the buffer of the frame
+            local_pFrame->dataLen = LIB_COMM_FRAME_u16Encode(local_u8TxSeq++, local_u8Payload, local_u8PayloadLen, global_u8CommTxBuffer[local_u8NextFrame]);
+
+            if(HAL_WRAPPER_STAT_OK != HAL_WRAPPER_SendCommFrame(local_pFrame))
+            {
+                // can't happen while there are less frames than the transmit queue, the message is dropped
+                break;
+            }
+
+            local_u8NextFrame = (local_u8NextFrame + 1) % APP_COMM_TX_FRAMES;
+            local_pFrame = &global_CommTxFrame_t[local_u8NextFrame];
         }
         
-        // check if there anything app board is sending
-        UARTReceivedISR();
-        if(global_AppCommMsg_t.IsDataReceived)
-        {   
-            // append the new state received to the queue
-            SERVICE_RTOS_AppendToBlockingQueue(0, (const void *) &global_MsgToRec_t, queue_AppCommToDrone_Handle_t);
-            SERVICE_RTOS_Notify(task_Master_Handle_t, LIB_CONSTANTS_DISABLED);  
+        // check if there anything the app board sent
+        UARTReceivedFrames();
 
-            // TODO: remove the below line
-            // printf("type = %d, roll = %d, pitch = %d, thrust = %d, yaw = %d, turnOnLeds = %d, playMusic = %d\r\n",
-            // global_MsgToRec_t.data.type, global_MsgToRec_t.data.data.move.roll, global_MsgToRec_t.data.data.move.pitch,
-            // global_MsgToRec_t.data.data.move.thrust, global_MsgToRec_t.data.data.move.yaw, global_MsgToRec_t.data.data.move.turnOnLeds,
-            // global_MsgToRec_t.data.data.move.playMusic);
+        // share of the CPU left to the idle task and load of the link
+        SERVICE_RTOS_GetIdleTime(&local_u32IdleUS, &local_u32TotalUS);
+        if(local_u32TotalUS - local_u32WindowStartUS >= CPU_LOAD_WINDOW_US)
+        {
+            global_u16IdlePermille = (uint16_t)((local_u32IdleUS - local_u32WindowIdleUS) / ((local_u32TotalUS - local_u32WindowStartUS) / 1000));
 
-            global_AppCommMsg_t.dataIsToReceive = 0;
-            global_AppCommMsg_t.IsDataReceived = 0;
-        }
+            HAL_WRAPPER_GetCommTxStats(&local_TxStats_t);
+            global_u32CommTxBytesPerSec = (uint32_t)((uint64_t)(local_TxStats_t.bytes - local_u32WindowTxBytes) * 1000000 / (local_u32TotalUS - local_u32WindowStartUS));
+            local_u32WindowTxBytes = local_TxStats_t.bytes;
 
-        
+            local_u32WindowIdleUS = local_u32IdleUS;
+            local_u32WindowStartUS = local_u32TotalUS;
+
+            // printf("idle: %d.%d%%, tx: %lu B/s, latency: %lu us\r\n", global_u16IdlePermille / 10, global_u16IdlePermille % 10, global_u32CommTxBytesPerSec, local_TxStats_t.maxLatencyUS);
+        }
     }
 }
 
@@ -549,10 +896,10 @@ void Task_Master(void)
 
     // to control motor speeds
     HAL_WRAPPER_MotorSpeeds_t local_MotorSpeeds = {0};
-    float local_f32TopLeftSpeed = 0;
-    float local_f32TopRightSpeed = 0;
-    float local_f32BottomLeftSpeed = 0;
-    float local_f32BottomRightSpeed = 0;
+    control_value_t local_TopLeftSpeed = 0;
+    control_value_t local_TopRightSpeed = 0;
+    control_value_t local_BottomLeftSpeed = 0;
+    control_value_t local_BottomRightSpeed = 0;
 
     // sensor readings
     SensorFusionDataItem_t local_SensorFusedReadings_t = {0};
@@ -567,34 +914,45 @@ void Task_Master(void)
     // for communication with app board.
     AppToDroneDataItem_t local_RCRequiredVal = {0};
 
+    // required state in the control loop representation
+    control_value_t local_RollSetPoint = 0;
+    control_value_t local_PitchSetPoint = 0;
+    control_value_t local_YawSetPoint = 0;
+    control_value_t local_ThrustSetPoint = 0;
+
     // pid objects
-    pid_obj_t roll_pid = {0};
-    pid_obj_t pitch_pid = {0};
-    pid_obj_t yaw_pid = {0};
-    pid_obj_t thrust_pid = {0};
+    control_pid_t roll_pid = {0};
+    control_pid_t pitch_pid = {0};
+    control_pid_t yaw_pid = {0};
+    control_pid_t thrust_pid = {0};
 
     // temp variable
     static uint8_t up = 0;
 
+#if CONTROL_LOOP_TIMER_DRIVEN
+    // the sensors collected in this task, the ones that aren't due keep their previous reading in it
+    RawSensorDataItem_t local_RawSensorData_t = {0};
+    uint32_t local_u32TickUS = 0;
+    uint32_t local_u32MissedTicks = 0;
+    uint32_t local_u32NowUS = 0;
+#elif SENSOR_HANDOFF_MAILBOX
+    // the newest state in the mailbox of the fusion
+    SensorFusionDataItem_t* local_pSensorFused_t = NULL;
+#endif
+
     
     //                      SOME INITIALIZATION 
     // INITIALIZATION CAN'T BE DONE IN MAIN AS SCHEDULAR HAS TO START FIRST BEFORE DOING 
     // ANYTHING (RECEIVING INTERRUPTS HAS TO WAIT BEFORE INITIALIZING)
     /************************************************************************/
-    // assign pointers and lengths of data to be always received
-    global_AppCommMsg_t.dataToReceive = (uint8_t*) &global_MsgToRec_t;
-    global_AppCommMsg_t.dataToReceiveLen = sizeof(global_MsgToRec_t);
-    global_AppCommMsg_t.dataIsToReceive = 0;
-    global_AppCommMsg_t.IsDataReceived = 0;
-    /************************************************************************/
     // initialize the pid controllers
-    roll_pid.kp = ROLL_KP;		pitch_pid.kp = PITCH_KP;		yaw_pid.kp = YAW_KP;		thrust_pid.kp = THRUST_KP;
-    roll_pid.ki = ROLL_KI;		pitch_pid.ki = PITCH_KI;       	yaw_pid.ki = YAW_KI;		thrust_pid.ki = THRUST_KI;
-    roll_pid.kd = ROLL_KD;		pitch_pid.kd = PITCH_KD;		yaw_pid.kd = YAW_KD;		thrust_pid.kd = THRUST_KD;
+    roll_pid.kp = CONTROL_CONST(ROLL_KP);		pitch_pid.kp = CONTROL_CONST(PITCH_KP);		yaw_pid.kp = CONTROL_CONST(YAW_KP);		thrust_pid.kp = CONTROL_CONST(THRUST_KP);
+    roll_pid.ki = CONTROL_CONST(ROLL_KI);		pitch_pid.ki = CONTROL_CONST(PITCH_KI);       	yaw_pid.ki = CONTROL_CONST(YAW_KI);		thrust_pid.ki = CONTROL_CONST(THRUST_KI);
+    roll_pid.kd = CONTROL_CONST(ROLL_KD);		pitch_pid.kd = CONTROL_CONST(PITCH_KD);		yaw_pid.kd = CONTROL_CONST(YAW_KD);		thrust_pid.kd = CONTROL_CONST(THRUST_KD);
     // add extra info for blocks
-    roll_pid.minIntegralVal = ROLL_INTEGRAL_MIN;		pitch_pid.minIntegralVal = PITCH_INTEGRAL_MIN;		yaw_pid.minIntegralVal = YAW_INTEGRAL_MIN;		thrust_pid.minIntegralVal = THRUST_INTEGRAL_MIN;
-    roll_pid.maxIntegralVal = ROLL_INTEGRAL_MAX;		pitch_pid.maxIntegralVal = PITCH_INTEGRAL_MAX;		yaw_pid.maxIntegralVal = YAW_INTEGRAL_MAX;		thrust_pid.maxIntegralVal = THRUST_INTEGRAL_MAX;
-    roll_pid.blockWeight = ROLL_BLOCK_WEIGHT;			pitch_pid.blockWeight = PITCH_BLOCK_WEIGHT;			yaw_pid.blockWeight = YAW_BLOCK_WEIGHT;			thrust_pid.blockWeight = THRUST_BLOCK_WEIGHT;
+    roll_pid.minIntegralVal = CONTROL_CONST(ROLL_INTEGRAL_MIN);		pitch_pid.minIntegralVal = CONTROL_CONST(PITCH_INTEGRAL_MIN);		yaw_pid.minIntegralVal = CONTROL_CONST(YAW_INTEGRAL_MIN);		thrust_pid.minIntegralVal = CONTROL_CONST(THRUST_INTEGRAL_MIN);
+    roll_pid.maxIntegralVal = CONTROL_CONST(ROLL_INTEGRAL_MAX);		pitch_pid.maxIntegralVal = CONTROL_CONST(PITCH_INTEGRAL_MAX);		yaw_pid.maxIntegralVal = CONTROL_CONST(YAW_INTEGRAL_MAX);		thrust_pid.maxIntegralVal = CONTROL_CONST(THRUST_INTEGRAL_MAX);
+    roll_pid.blockWeight = CONTROL_CONST(ROLL_BLOCK_WEIGHT);			pitch_pid.blockWeight = CONTROL_CONST(PITCH_BLOCK_WEIGHT);			yaw_pid.blockWeight = CONTROL_CONST(YAW_BLOCK_WEIGHT);			thrust_pid.blockWeight = CONTROL_CONST(THRUST_BLOCK_WEIGHT);
     /************************************************************************/
     
     // Configure/enable Clock and all needed peripherals 
@@ -604,9 +962,6 @@ void Task_Master(void)
     // configure NVIC
     NVIC_PriorityGroupConfig(NVIC_PriorityGroup_2);
 
-    // // set call back for board receive
-    // HAL_WRAPPER_SetAppCommRecCallBack(UARTReceivedISR);
-
     // configure all pins and peripherals 
     MCAL_Config_ConfigAllPins();
 
@@ -616,12 +971,28 @@ void Task_Master(void)
     // TODO: comment the below line
     USART_Printf_Init(115200);
 
-    
+#if CONTROL_LOOP_TIMER_DRIVEN
+    // sample, fuse, control and write the motors in this task on every tick of the hardware timer
+    SensorCollectionInit();
+    SensorFusionInit();
+    HAL_WRAPPER_StartControlTimer(CONTROL_LOOP_PERIOD_US);
+#endif
 
     while (1)
     {
+#if CONTROL_LOOP_TIMER_DRIVEN
+        // wait for the next period, the commands of the app board are only taken at its start
+        if(HAL_WRAPPER_STAT_OK != HAL_WRAPPER_WaitControlTick(CONTROL_LOOP_TICK_TIMEOUT_MS, &local_u32TickUS, &local_u32MissedTicks))
+        {
+            global_ControlLoopStats_t.overruns++;
+            continue;
+        }
+        global_ControlLoopStats_t.periods++;
+        global_ControlLoopStats_t.overruns += local_u32MissedTicks;
+#else
         // wait for notification
         SERVICE_RTOS_WaitForNotification(1000);
+#endif
 
         // read desired action from AppComm
         local_RTOSErrStatus = SERVICE_RTOS_ReadFromBlockingQueue(0, (void *) &local_RCRequiredVal, queue_AppCommToDrone_Handle_t, &local_u8LenOfRemaining);
@@ -650,6 +1021,10 @@ void Task_Master(void)
 
 
             // assign the required state
+            local_RollSetPoint   = CONTROL_FROM_FLOAT(local_RCRequiredVal.roll);
+            local_PitchSetPoint  = CONTROL_FROM_FLOAT(local_RCRequiredVal.pitch);
+            local_YawSetPoint    = CONTROL_FROM_FLOAT(local_RCRequiredVal.yaw);
+            local_ThrustSetPoint = CONTROL_FROM_FLOAT(local_RCRequiredVal.thrust);
         
             // TODO: remove the below line
             // printf("type = %d, roll = %f, pitch = %f, thrust = %f, yaw = %f,\r\n",
@@ -699,8 +1074,22 @@ void Task_Master(void)
 
         }
 
+#if CONTROL_LOOP_TIMER_DRIVEN
+        // the newest samples go straight to the control, there is no queue for them to wait in
+        SensorCollectionStep(&local_RawSensorData_t);
+        SensorFusionStep(&local_RawSensorData_t, &local_SensorFusedReadings_t);
+        local_RTOSErrStatus = SERVICE_RTOS_STAT_OK;
+#elif SENSOR_HANDOFF_MAILBOX
+        // take the newest fused state, the ones that came while the master task was busy are already overwritten
+        local_RTOSErrStatus = SERVICE_RTOS_ReadFromMailbox((void **) &local_pSensorFused_t, &mailbox_FusedSensorData_t, NULL);
+        if(SERVICE_RTOS_STAT_OK == local_RTOSErrStatus)
+        {
+            local_SensorFusedReadings_t = *local_pSensorFused_t;
+        }
+#else
         // read sensor fused readings
         local_RTOSErrStatus = SERVICE_RTOS_ReadFromBlockingQueue(0, (void *) &local_SensorFusedReadings_t, queue_FusedSensorData_Handle_t, &local_u8LenOfRemaining);
+#endif
 
         // get sensor fused readings with Kalman filter as long as the drone is commanded to start
         if(SERVICE_RTOS_STAT_OK == local_RTOSErrStatus && local_RCRequiredVal.startDrone)
@@ -740,53 +1129,53 @@ void Task_Master(void)
                 local_SensorFusedReadings_t.vertical_velocity -= local_SensorFusedInitReadings_t.vertical_velocity;
 
                 // Compute error
-                roll_pid.error      = local_RCRequiredVal.roll   - local_SensorFusedReadings_t.roll;
-                pitch_pid.error     = local_RCRequiredVal.pitch  - local_SensorFusedReadings_t.pitch;
-                yaw_pid.error       = 5 * local_RCRequiredVal.yaw 	 - local_SensorFusedReadings_t.yaw_rate;
-                thrust_pid.error    = local_RCRequiredVal.thrust - local_SensorFusedReadings_t.vertical_velocity;
+                roll_pid.error      = local_RollSetPoint   - local_SensorFusedReadings_t.roll;
+                pitch_pid.error     = local_PitchSetPoint  - local_SensorFusedReadings_t.pitch;
+                yaw_pid.error       = 5 * local_YawSetPoint 	 - local_SensorFusedReadings_t.yaw_rate;
+                thrust_pid.error    = local_ThrustSetPoint - CONTROL_FROM_FLOAT(local_SensorFusedReadings_t.vertical_velocity);
                 
                 // apply PID to compensate error
-                pid_ctrl(&roll_pid);
-                pid_ctrl(&pitch_pid);
-                pid_ctrl(&yaw_pid);
-//                pid_ctrl(&thrust_pid);
+                CONTROL_PID(&roll_pid);
+                CONTROL_PID(&pitch_pid);
+                CONTROL_PID(&yaw_pid);
+//                CONTROL_PID(&thrust_pid);
                 // thrust_pid.output += 0.0025 * (local_RCRequiredVal.thrust + 0.15625);
 //                printf("%f\r\n", local_RCRequiredVal.thrust);
                 if(up == 0)
                 {
-                	thrust_pid.output += 0.0025 * 10;
-                	if(thrust_pid.output > 40)
+                	thrust_pid.output += CONTROL_CONST(0.0025 * 10);
+                	if(thrust_pid.output > CONTROL_CONST(40))
                 	{
                 		up = 1;
                 	}
                 }
                 else
                 {
-                	thrust_pid.output += -0.0025 * 10;
+                	thrust_pid.output += CONTROL_CONST(-0.0025 * 10);
                 }
 
                 // Motor mixing algorithm
-                local_f32TopLeftSpeed     = MIN_MOTOR_SPEED_TL + (thrust_pid.output - roll_pid.output + pitch_pid.output + yaw_pid.output);
-                local_f32TopRightSpeed    = MIN_MOTOR_SPEED_TR + (thrust_pid.output + roll_pid.output + pitch_pid.output - yaw_pid.output);
-                local_f32BottomLeftSpeed  = MIN_MOTOR_SPEED_BL + (thrust_pid.output - roll_pid.output - pitch_pid.output - yaw_pid.output);
-                local_f32BottomRightSpeed = MIN_MOTOR_SPEED_BR + (thrust_pid.output + roll_pid.output - pitch_pid.output + yaw_pid.output);
+                local_TopLeftSpeed     = CONTROL_CONST(MIN_MOTOR_SPEED_TL) + (thrust_pid.output - roll_pid.output + pitch_pid.output + yaw_pid.output);
+                local_TopRightSpeed    = CONTROL_CONST(MIN_MOTOR_SPEED_TR) + (thrust_pid.output + roll_pid.output + pitch_pid.output - yaw_pid.output);
+                local_BottomLeftSpeed  = CONTROL_CONST(MIN_MOTOR_SPEED_BL) + (thrust_pid.output - roll_pid.output - pitch_pid.output - yaw_pid.output);
+                local_BottomRightSpeed = CONTROL_CONST(MIN_MOTOR_SPEED_BR) + (thrust_pid.output + roll_pid.output - pitch_pid.output + yaw_pid.output);
 
     //          local_f32TopLeftSpeed     = (thrust_pid.output - roll_pid.output - pitch_pid.output - yaw_pid.output);
     //			local_f32TopRig
                 // apply max limits to the motor speeds
-                if(local_f32TopLeftSpeed     > MAX_MOTOR_SPEED)  local_f32TopLeftSpeed     = MAX_MOTOR_SPEED;
-                if(local_f32TopRightSpeed    > MAX_MOTOR_SPEED)  local_f32TopRightSpeed    = MAX_MOTOR_SPEED;
-                if(local_f32BottomLeftSpeed  > MAX_MOTOR_SPEED)  local_f32BottomLeftSpeed  = MAX_MOTOR_SPEED;
-                if(local_f32BottomRightSpeed > MAX_MOTOR_SPEED)  local_f32BottomRightSpeed = MAX_MOTOR_SPEED;
+                if(local_TopLeftSpeed     > CONTROL_CONST(MAX_MOTOR_SPEED))  local_TopLeftSpeed     = CONTROL_CONST(MAX_MOTOR_SPEED);
+                if(local_TopRightSpeed    > CONTROL_CONST(MAX_MOTOR_SPEED))  local_TopRightSpeed    = CONTROL_CONST(MAX_MOTOR_SPEED);
+                if(local_BottomLeftSpeed  > CONTROL_CONST(MAX_MOTOR_SPEED))  local_BottomLeftSpeed  = CONTROL_CONST(MAX_MOTOR_SPEED);
+                if(local_BottomRightSpeed > CONTROL_CONST(MAX_MOTOR_SPEED))  local_BottomRightSpeed = CONTROL_CONST(MAX_MOTOR_SPEED);
                 
                 // apply min limits to the motor speedshtSpeed    = (thrust_pid.output + roll_pid.output - pitch_pid.output + yaw_pid.output);
     //			local_f32BottomLeftSpeed  = (thrust_pid.output - roll_pid.output + pitch_pid.output + yaw_pid.output);
     //			local_f32BottomRightSpeed = (thrust_pid.output + roll_pid.output + pitch_pid.output - yaw_pid.output);
 
-                if(local_f32TopLeftSpeed     < MIN_MOTOR_SPEED_TL)  local_f32TopLeftSpeed     = MIN_MOTOR_SPEED_TL;
-                if(local_f32TopRightSpeed    < MIN_MOTOR_SPEED_TR)  local_f32TopRightSpeed    = MIN_MOTOR_SPEED_TR;
-                if(local_f32BottomLeftSpeed  < MIN_MOTOR_SPEED_BL)  local_f32BottomLeftSpeed  = MIN_MOTOR_SPEED_BL;
-                if(local_f32BottomRightSpeed < MIN_MOTOR_SPEED_BR)  local_f32BottomRightSpeed = MIN_MOTOR_SPEED_BR;
+                if(local_TopLeftSpeed     < CONTROL_CONST(MIN_MOTOR_SPEED_TL))  local_TopLeftSpeed     = CONTROL_CONST(MIN_MOTOR_SPEED_TL);
+                if(local_TopRightSpeed    < CONTROL_CONST(MIN_MOTOR_SPEED_TR))  local_TopRightSpeed    = CONTROL_CONST(MIN_MOTOR_SPEED_TR);
+                if(local_BottomLeftSpeed  < CONTROL_CONST(MIN_MOTOR_SPEED_BL))  local_BottomLeftSpeed  = CONTROL_CONST(MIN_MOTOR_SPEED_BL);
+                if(local_BottomRightSpeed < CONTROL_CONST(MIN_MOTOR_SPEED_BR))  local_BottomRightSpeed = CONTROL_CONST(MIN_MOTOR_SPEED_BR);
                 
 //                printf("speeds: TL: %d, TR: %d, BL: %d, BR: %d\n\r", local_MotorSpeeds.topLeftSpeed, local_MotorSpeeds.topRightSpeed, local_MotorSpeeds.bottomLeftSpeed, local_MotorSpeeds.bottomRightSpeed );
 //                printf("%d,%d,%d,%d\n\r", local_MotorSpeeds.topLeftSpeed, local_MotorSpeeds.topRightSpeed, local_MotorSpeeds.bottomLeftSpeed, local_MotorSpeeds.bottomRightSpeed );
@@ -797,15 +1186,26 @@ void Task_Master(void)
 //                printf("%f,%f\r\n", local_SensorFusedReadings_t.yaw_rate, local_RCRequiredVal.yaw);
 
                 // assign values to motors
-                local_MotorSpeeds.topLeftSpeed     = (uint8_t) local_f32TopLeftSpeed;
-                local_MotorSpeeds.topRightSpeed    = (uint8_t) local_f32TopRightSpeed;
-                local_MotorSpeeds.bottomLeftSpeed  = (uint8_t) local_f32BottomLeftSpeed;
-                local_MotorSpeeds.bottomRightSpeed = (uint8_t) local_f32BottomRightSpeed;
+                local_MotorSpeeds.topLeftSpeed     = (uint8_t) CONTROL_TO_INT(local_TopLeftSpeed);
+                local_MotorSpeeds.topRightSpeed    = (uint8_t) CONTROL_TO_INT(local_TopRightSpeed);
+                local_MotorSpeeds.bottomLeftSpeed  = (uint8_t) CONTROL_TO_INT(local_BottomLeftSpeed);
+                local_MotorSpeeds.bottomRightSpeed = (uint8_t) CONTROL_TO_INT(local_BottomRightSpeed);
                 
                 // apply actions on the motors
                 HAL_WRAPPER_SetESCSpeeds(&local_MotorSpeeds);
 
-                printf("%f,%f\r\n", roll_pid.error, pitch_pid.error);
+#if CONTROL_LOOP_TIMER_DRIVEN
+                // age of the newest IMU sample when the motors got the output computed from it
+                SERVICE_RTOS_CurrentUSTime(&local_u32NowUS);
+                global_ControlLoopStats_t.sensorToMotorUS = local_u32NowUS - local_RawSensorData_t.ImuTimestamp;
+                if(global_ControlLoopStats_t.sensorToMotorUS > global_ControlLoopStats_t.sensorToMotorMaxUS)
+                    global_ControlLoopStats_t.sensorToMotorMaxUS = global_ControlLoopStats_t.sensorToMotorUS;
+#endif
+
+#if !CONTROL_LOOP_TIMER_DRIVEN
+                // the float print blocks the master task for longer than a tick of the timer, it's only kept with the tasks
+                printf("%f,%f\r\n", CONTROL_TO_FLOAT(roll_pid.error), CONTROL_TO_FLOAT(pitch_pid.error));
+#endif
 
 //                printf("%f,%f,%f,%f\n\r", local_RCRequiredVal.pitch, local_RCRequiredVal.roll, local_RCRequiredVal.yaw, local_RCRequiredVal.thrust);
 
@@ -821,6 +1221,15 @@ void Task_Master(void)
 
         }
 
+#if CONTROL_LOOP_TIMER_DRIVEN
+        // time taken by the period, it must stay below CONTROL_LOOP_PERIOD_US or ticks are missed
+        SERVICE_RTOS_CurrentUSTime(&local_u32NowUS);
+        global_ControlLoopStats_t.busyUS = local_u32NowUS - local_u32TickUS;
+        if(0 > (int32_t)global_ControlLoopStats_t.busyUS)
+            global_ControlLoopStats_t.busyUS = 0;
+        if(global_ControlLoopStats_t.busyUS > global_ControlLoopStats_t.busyMaxUS)
+            global_ControlLoopStats_t.busyMaxUS = global_ControlLoopStats_t.busyUS;
+#endif
     }
 }
 
@@ -831,15 +1240,24 @@ void Task_Master(void)
 int main(void)
 {
 
+#if !CONTROL_LOOP_TIMER_DRIVEN
     // create the Queue for sensor collection data task to put its data into it
     SERVICE_RTOS_CreateBlockingQueue(QUEUE_RAW_SENSOR_DATA_LEN,
                                     sizeof(RawSensorDataItem_t),
                                     &queue_RawSensorData_Handle_t);
-
+#endif
+
+#if !CONTROL_LOOP_TIMER_DRIVEN && SENSOR_HANDOFF_MAILBOX
+    // create the mailbox for sensor fusion task to put its data into it
+    SERVICE_RTOS_CreateMailbox(sizeof(SensorFusionDataItem_t),
+                                    mailbox_FusedSensorDataItems_t,
+                                    &mailbox_FusedSensorData_t);
+#elif !CONTROL_LOOP_TIMER_DRIVEN
     // create the Queue for sensor fusion task to put its data into it
     SERVICE_RTOS_CreateBlockingQueue(QUEUE_SENSOR_FUSION_DATA_LEN,
                                     sizeof(SensorFusionDataItem_t),
                                     &queue_FusedSensorData_Handle_t);
+#endif
 
     // create the Queue for sensor collection data to put its data into it
     SERVICE_RTOS_CreateBlockingQueue(QUEUE_APP_TO_DRONE_DATA_LEN,
@@ -852,6 +1270,7 @@ int main(void)
                                     &queue_DroneCommToApp_Handle_t);
 
 
+#if !CONTROL_LOOP_TIMER_DRIVEN
     // create a task for reading sensor data
     SERVICE_RTOS_TaskCreate((SERVICE_RTOS_TaskFunction_t)Task_CollectSensorData,
                 "Sensor Collection",
@@ -865,6 +1284,7 @@ int main(void)
                 TASK_SENSOR_FUSION_STACK_SIZE,
                 TASK_SENSOR_FUSION_PRIO,
                 &task_SensorFusion_Handle_t);
+#endif
 
    // create a task for communication with app board
    SERVICE_RTOS_TaskCreate((SERVICE_RTOS_TaskFunction_t)Task_AppComm,
@@ -40,6 +40,16 @@
  * |    Date            Version         Author                          Description                                                     |
  * |    14/06/2023      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
  * |    17/06/2023      1.0.0           Abdelrahman Mohamed Salem       added extra defs for structs to be sent over air.               |
+ * |    17/10/2026      1.1.0           agent                           added fixed point build mode for fusion and control.            |
+ * |    17/10/2026      1.2.0           agent                           added imu timestamp and die temperature to the raw sensor item. |
+ * |    17/10/2026      1.3.0           agent                           added 'SENSOR_DATA_READY_PACING'.                               |
+ * |    17/10/2026      1.4.0           agent                           the raw sensors item carries the batch of the MPU6050 FIFO.     |
+ * |    17/10/2026      1.5.0           agent                           the raw sensors item carries freshness flags of its readings.   |
+ * |    17/10/2026      1.6.0           agent                           the messages between the boards are framed by "comm_frame.h".   |
+ * |    17/10/2026      1.7.0           agent                           sizes of the frames follow the packed messages of comm_pack.h   |
+ * |    17/10/2026      1.8.0           agent                           added 'SENSOR_GYRO_RPM_FILTER'.                                 |
+ * |    17/10/2026      1.9.0           agent                           added 'CONTROL_LOOP_TIMER_DRIVEN' and 'CONTROL_LOOP_PERIOD_US'. |
+ * |    17/10/2026      1.10.0          agent                           added 'SENSOR_HANDOFF_MAILBOX'.                                 |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -62,20 +72,121 @@
  */
 #include "stdint.h"
 
+/**
+ * @reason: contains the framing of the messages between the boards
+ */
+#include "comm_frame.h"
+
+/**
+ * @reason: contains the packing of the messages between the boards
+ */
+#include "comm_pack.h"
+
+/**
+ * @reason: contains fixed point types used when SENSOR_FUSION_FIXED_POINT is enabled
+ */
+#include "math_fixed.h"
+
 /******************************************************************************
  * Module Preprocessor Constants
  *******************************************************************************/
 
 /**
  * @brief: this is how frequent we collect sensors data in MS
+ * @note: must match the sample rate of the MPU6050 (MPU6050_SAMPLE_PERIOD_US) when SENSOR_DATA_READY_PACING is enabled
  */
 #define SENSOR_SAMPLE_PERIOD 7
+
+/**
+ * @brief: 1 when the MPU6050 samples at 1 KHz into its FIFO and every collection drains it as one batch (set in "MPU6050.h")
+ */
+#define SENSOR_IMU_FIFO_BATCH HAL_WRAPPER_IMU_FIFO_BATCH
+
+/**
+ * @brief: 1 to run the whole control loop in the master task on every tick of a hardware timer: collect the sensors, fuse
+ *         them, run the PID controllers, mix and write the ESCs, one after the other. 0 to chain the sensors collection,
+ *         the sensor fusion and the master tasks with queues, where a sample can wait behind older ones
+ * @note: the timing of the loop is kept in 'global_ControlLoopStats_t'
+ */
+#define CONTROL_LOOP_TIMER_DRIVEN 0
+
+/**
+ * @brief: period of the control loop in micro seconds with CONTROL_LOOP_TIMER_DRIVEN, the sensors are collected once per period
+ */
+#define CONTROL_LOOP_PERIOD_US (SENSOR_SAMPLE_PERIOD * 1000)
+
+/**
+ * @brief: 1 to pace the sensors collection by the data ready pin of the MPU6050, 0 to sleep SENSOR_SAMPLE_PERIOD between
+ *         two collections (rounded to the RTOS tick so the period drifts and jitters)
+ * @note: the data ready pin would pulse at 1 KHz with the FIFO batch, so the collection sleeps in that mode, and the
+ *        hardware timer paces the collection with CONTROL_LOOP_TIMER_DRIVEN
+ */
+#define SENSOR_DATA_READY_PACING (!SENSOR_IMU_FIFO_BATCH && !CONTROL_LOOP_TIMER_DRIVEN)
+
+/**
+ * @brief: 1 to hand the fused state to the master task through a mailbox that only keeps the newest item (refer to
+ *         'RTOS_Mailbox_t'), 0 to go through a queue where a late reader goes through the older states first and a full
+ *         queue drops the newest one
+ * @note: the collections of the sensors always go through their queue, each one carries IMU samples and one shot
+ *        magnetometer and barometer readings the next one doesn't. not used with CONTROL_LOOP_TIMER_DRIVEN
+ */
+#define SENSOR_HANDOFF_MAILBOX 1
 // 144 MHz
 
+/**
+ * @brief: 1 to remove the vibration of the motors from the gyroscope with notches that follow the speed reported by the ESCs
+ * @note: needs the 1 KHz samples of the FIFO batch, the motors spin at 100 to 400 Hz which the 7 ms collection can't see
+ */
+#define SENSOR_GYRO_RPM_FILTER (SENSOR_IMU_FIFO_BATCH && HAL_WRAPPER_ESC_TELEMETRY)
+
+/**
+ * @brief: 1 to run the attitude fusion, the PID controllers and the motor mixer in fixed point (Q16.16) on the raw
+ *         sensor counts, 0 to use floating point. the MCU has no FPU so every float operation is a library call
+ * @note: the altitude estimation stays in floating point in both modes
+ */
+#define SENSOR_FUSION_FIXED_POINT 0
+
+/**
+ * @brief: time between two outputs of the HMC5883L in micro seconds
+ * @note: must match the output rate configured in "HMC5883.c" (HMC5883L_OUTPUT_RATE_15)
+ */
+#define SENSOR_MAGNET_PERIOD_US 66667
+
+/**
+ * @brief: time between two outputs of the BMP280 in micro seconds, x16 oversampling of pressure and temperature in
+ *         normal mode with 0.5 ms standby (refer to CTRL_MEAS and CONFIG in "bmp.c")
+ */
+#define SENSOR_BARO_PERIOD_US 77000
+
+/**
+ * @brief: time between two readings of the battery in micro seconds, the charge is sent to the app board every second
+ */
+#define SENSOR_BATTERY_PERIOD_US 1000000
+
+/**
+ * @brief: how late a due sensor can be read in micro seconds, a sensor within its deadline waits for a collection where
+ *         no other slow sensor is read so the bus time of a collection stays close to the IMU one
+ */
+#define SENSOR_MAGNET_DEADLINE_US   14000
+#define SENSOR_BARO_DEADLINE_US     21000
+#define SENSOR_BATTERY_DEADLINE_US  100000
+
 /******************************************************************************
  * Module Preprocessor Macros
  *******************************************************************************/
 
+/**
+ * @brief: size of the encoded frames of the messages between the boards (refer to "comm_frame.h"), the messages are packed
+ *         with "comm_pack.h" and both boards must use the same LIB_COMM_FRAME_VERSION
+ */
+#define COMM_FRAME_MOVE_LEN LIB_COMM_FRAME_ENCODED_LEN(LIB_COMM_PACK_MOVE_LEN)
+#define COMM_FRAME_INFO_LEN LIB_COMM_FRAME_ENCODED_LEN(LIB_COMM_PACK_INFO_LEN)
+
+/**
+ * @brief: bit of the sensor ID (refer to @SENSOR_ID_t) in 'RawSensorDataItem_t.Fresh'
+ */
+#define SENSOR_FRESH(ID) ((uint8_t)1 << (ID))
+
 /******************************************************************************
  * Module Typedefs
  *******************************************************************************/
@@ -130,39 +241,74 @@ typedef struct __attribute__((packed)){
 
 /************************************************************************/
 /**
- * @brief: this is the struct definition of the items of the 'queue_RawSensorData_Handle_t' elements
+ * @brief: identifies the sensors read by the collection task, their index in its schedule
+*/
+typedef enum {
+    SENSOR_ID_IMU = 0,
+    SENSOR_ID_MAGNET,
+    SENSOR_ID_BARO,
+    SENSOR_ID_BATTERY,
+    SENSOR_ID_COUNT,
+} SENSOR_ID_t;
+
+/**
+ * @brief: this is the struct definition of the items of the 'queue_RawSensorData_Handle_t' elements (or of 'mailbox_RawSensorData_t')
 */
 typedef struct {
+#if SENSOR_FUSION_FIXED_POINT
+    HAL_WRAPPER_AccRaw_t Acc;
+    HAL_WRAPPER_GyroRaw_t Gyro;
+    HAL_WRAPPER_MagnetRaw_t Magnet;
+    int16_t ImuTemperature;     /**< MPU6050 die temperature in LSB */
+#else
     HAL_WRAPPER_Acc_t Acc;
     HAL_WRAPPER_Gyro_t Gyro;
     HAL_WRAPPER_Magnet_t Magnet;
+    float ImuTemperature;       /**< MPU6050 die temperature in Degree Celsius */
+#endif
+    uint32_t ImuTimestamp;      /**< time in microseconds at which Acc and Gyro were sampled */
+#if SENSOR_IMU_FIFO_BATCH
+    HAL_WRAPPER_ImuBatch_t ImuBatch;    /**< the IMU samples since the previous item, Acc and Gyro are their average
+                                             and ImuTemperature isn't read */
+#endif
     HAL_WRAPPER_Pressure_t Pressure;
     HAL_WRAPPER_Temperature_t Temperature;
     HAL_WRAPPER_Altitude_t Altitude;
     HAL_WRAPPER_Battery_t Battery;
+    uint8_t Fresh;              /**< SENSOR_FRESH() bits of the readings taken for this item, the others hold the
+                                     previous reading */
 } RawSensorDataItem_t;
 
 /**
- * @brief: this is the struct definition of the items of the 'queue_FusedSensorData_Handle_t' elements
+ * @brief: type of the angles and rates in 'SensorFusionDataItem_t' (degrees and degrees/s)
+*/
+#if SENSOR_FUSION_FIXED_POINT
+typedef LIB_MATH_FIXED_q16_t SensorFusionAngle_t;
+#else
+typedef float SensorFusionAngle_t;
+#endif
+
+/**
+ * @brief: this is the struct definition of the items of the 'queue_FusedSensorData_Handle_t' elements (or of 'mailbox_FusedSensorData_t')
 */
 typedef struct {
 
     // rate of rotation
-    float yaw_rate;
+    SensorFusionAngle_t yaw_rate;
     
     // height from the ground
     float altitude;
     float vertical_velocity;
 
     // fused kalman angles
-    float roll;
-    float yaw;
-    float pitch;
+    SensorFusionAngle_t roll;
+    SensorFusionAngle_t yaw;
+    SensorFusionAngle_t pitch;
 
     // kalman uncertainty for each angle
-    float roll_uncertainty;
-    float yaw_uncertainty;
-    float pitch_uncertainty;
+    SensorFusionAngle_t roll_uncertainty;
+    SensorFusionAngle_t yaw_uncertainty;
+    SensorFusionAngle_t pitch_uncertainty;
 
 } SensorFusionDataItem_t;
 
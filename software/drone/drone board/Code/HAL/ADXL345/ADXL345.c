@@ -40,6 +40,7 @@
  * |    Date            Version         Author                          Description                                                     |
  * |    24/05/2024      1.0.0           Abdelrahman Mohamed Salem       Interface Created.                                              |
  * |    24/05/2024      1.0.0           Abdelrahman Mohamed Salem       added the initialization function.                              |
+ * |    17/10/2026      1.1.0           agent                           registers are moved through the DMA driven 'MCAL_SPI_Transfer'. |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -97,11 +98,21 @@
  */
 #include "MCAL_config.h"
 
+/**
+ * @reason: contains the DMA driven SPI transfers
+ */
+#include "MCAL_SPI.h"
+
 
 /******************************************************************************
  * Module Preprocessor Constants
  *******************************************************************************/
 
+/**
+ * @brief: most registers written by one HAL_ADXL345_Write_Mutliple(), the longest writable block (THRESH_TAP to TAP_AXES) is 14
+ */
+#define HAL_ADXL345_WRITE_MULTIPLE_MAX      (16)
+
 /******************************************************************************
  * Module Preprocessor Macros
  *******************************************************************************/
@@ -129,7 +140,7 @@
 void HAL_ADXL345_Write_Single(MCAL_CONFIG_SPI_t* arg_pADXLSPI, uint8_t arg_u8Register_Address, uint8_t arg_u8Data) {
 
   uint8_t local_pu8ArrData[] = {arg_u8Register_Address & 0x3F, arg_u8Data};
-  MCAL_WRAPEPR_SPI_POLL_TRANSFER(arg_pADXLSPI, (uint8_t*) local_pu8ArrData, 2, NULL);
+  MCAL_SPI_Transfer(arg_pADXLSPI, local_pu8ArrData, NULL, 2, MCAL_SPI_DEFAULT_TIMEOUT_MS);
 }
 
 /**
@@ -138,7 +149,7 @@ void HAL_ADXL345_Write_Single(MCAL_CONFIG_SPI_t* arg_pADXLSPI, uint8_t arg_u8Reg
 uint8_t HAL_ADXL345_Read_Single(MCAL_CONFIG_SPI_t* arg_pADXLSPI, uint8_t arg_u8RegisterAddress)
 {
   uint8_t local_pu8ArrData[] = {0x80 | arg_u8RegisterAddress, 0};
-  MCAL_WRAPEPR_SPI_POLL_TRANSFER(arg_pADXLSPI, (uint8_t*) &local_pu8ArrData, 2, (uint8_t*) &local_pu8ArrData);
+  MCAL_SPI_Transfer(arg_pADXLSPI, local_pu8ArrData, local_pu8ArrData, 2, MCAL_SPI_DEFAULT_TIMEOUT_MS);
   return local_pu8ArrData[1];
 }
 
@@ -147,9 +158,18 @@ uint8_t HAL_ADXL345_Read_Single(MCAL_CONFIG_SPI_t* arg_pADXLSPI, uint8_t arg_u8R
 */
 void HAL_ADXL345_Write_Mutliple(MCAL_CONFIG_SPI_t* arg_pADXLSPI, uint8_t arg_u8RegisterStartAddress, uint8_t* arg_pu8Data, uint8_t arg_u8Len) {
 
-  uint8_t local_8Temp = 0x40 | (arg_u8RegisterStartAddress & 0x3F); // write register adreess and make multiple by 1 to write to consecutive registers
-  MCAL_WRAPEPR_SPI_POLL_TRANSFER(arg_pADXLSPI, (uint8_t*) &local_8Temp, 1, NULL);
-  MCAL_WRAPEPR_SPI_POLL_TRANSFER(arg_pADXLSPI, arg_pu8Data, arg_u8Len, NULL);
+  uint8_t local_pu8ArrData[HAL_ADXL345_WRITE_MULTIPLE_MAX + 1];
+  uint8_t local_u8Index;
+
+  if(arg_u8Len > HAL_ADXL345_WRITE_MULTIPLE_MAX)
+    arg_u8Len = HAL_ADXL345_WRITE_MULTIPLE_MAX;
+
+  // the address and the data go in one chip select cycle, the multiple byte bit makes the registers consecutive
+  local_pu8ArrData[0] = 0x40 | (arg_u8RegisterStartAddress & 0x3F);
+  for(local_u8Index = 0; local_u8Index < arg_u8Len; local_u8Index++)
+    local_pu8ArrData[local_u8Index + 1] = arg_pu8Data[local_u8Index];
+
+  MCAL_SPI_Transfer(arg_pADXLSPI, local_pu8ArrData, NULL, arg_u8Len + 1, MCAL_SPI_DEFAULT_TIMEOUT_MS);
 }
 
 
@@ -219,7 +239,7 @@ HAL_ADXL345_ErrStates_t HAL_ADXL345_ReadAcc(MCAL_CONFIG_SPI_t* arg_pADXLSPI, HAL
 //  while (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_14) == 0x01);
   
   
-  MCAL_WRAPEPR_SPI_POLL_TRANSFER(arg_pADXLSPI, (uint8_t*) local_u8Dummy, 7, (uint8_t*) local_u8Dummy);
+  MCAL_SPI_Transfer(arg_pADXLSPI, local_u8Dummy, local_u8Dummy, 7, MCAL_SPI_DEFAULT_TIMEOUT_MS);
 
   arg_pReadings_t->x = local_u8Dummy[2] << 8 | local_u8Dummy[1];
   arg_pReadings_t->y = local_u8Dummy[4] << 8 | local_u8Dummy[3];
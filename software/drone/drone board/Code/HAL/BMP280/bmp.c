@@ -39,6 +39,8 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    22/06/2023      1.0.0           Ahmed Fawzy                     Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           registers are read in bursts, added 'BMP280_get_sample'.        |
+ * |    17/10/2026      1.2.0           agent                           registers are moved through the DMA driven 'MCAL_SPI_Transfer'. |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -72,6 +74,11 @@
  */
 #include "MCAL_config.h"
 
+/**
+ * @reason: contains the DMA driven SPI transfers
+ */
+#include "MCAL_SPI.h"
+
 
 /**
  * @reason: contains NULL definitions
@@ -82,10 +89,36 @@
  * Module Preprocessor Constants
  *******************************************************************************/
 
+/**
+ * @brief: number of bytes of the trimming parameters (DIG_T1 .. DIG_P9), the longest burst read from the sensor
+ */
+#define BMP280_TRIMMING_LEN     24
+
+/**
+ * @brief: number of bytes of the pressure and temperature results (PRESS_MSB .. TEMP_XLSB)
+ */
+#define BMP280_DATA_LEN         6
+
+/**
+ * @brief: number of bytes of one result (MSB, LSB, XLSB)
+ */
+#define BMP280_RESULT_LEN       3
+
 /******************************************************************************
  * Module Preprocessor Macros
  *******************************************************************************/
 
+/**
+ * @brief: trimming parameters are little endian, 'REG' is the address of the parameter
+ */
+#define BMP280_TRIM_U16(BUF, REG)   ((uint16_t)(((uint16_t)(BUF)[(REG) - DIG_T1 + 1] << 8) | (BUF)[(REG) - DIG_T1]))
+#define BMP280_TRIM_S16(BUF, REG)   ((int16_t)BMP280_TRIM_U16(BUF, REG))
+
+/**
+ * @brief: results are big endian and stored in the 20 most significant bits of MSB, LSB and XLSB
+ */
+#define BMP280_RESULT(BUF)          ((int32_t)(((uint32_t)(BUF)[0] << 12) | ((uint32_t)(BUF)[1] << 4) | ((uint32_t)(BUF)[2] >> 4)))
+
 /******************************************************************************
  * Module Typedefs
  *******************************************************************************/
@@ -111,7 +144,7 @@ int32_t t_fine;
 uint8_t BMP280_ReadRegister(uint8_t reg) {
     reg = reg & (~0x80);
     uint8_t value[2] = {reg | 0x80 , 0};
-    MCAL_WRAPEPR_SPI_POLL_TRANSFER(&MCAL_CFG_BMPSPI, value, 2, value);
+    MCAL_SPI_Transfer(&MCAL_CFG_BMPSPI, value, value, 2, MCAL_SPI_DEFAULT_TIMEOUT_MS);
     return value[1];
 }
 
@@ -121,87 +154,60 @@ uint8_t BMP280_ReadRegister(uint8_t reg) {
 void BMP280_WriteRegister(uint8_t reg, uint8_t value) {
     reg = reg & (~0x80);
     uint8_t data[2] = {reg & (~0x80) , value};
-    MCAL_WRAPEPR_SPI_POLL_TRANSFER(&MCAL_CFG_BMPSPI, data, 2, NULL);
+    MCAL_SPI_Transfer(&MCAL_CFG_BMPSPI, data, NULL, 2, MCAL_SPI_DEFAULT_TIMEOUT_MS);
 }
 
 /**
- * @brief: Read an unsigned 16-bit value from a BMP280 register
+ * @brief: Read consecutive BMP280 registers in one transaction, the sensor increments the address after every byte
  */
-uint16_t BMP280_ReadUnsignedShort(uint8_t reg) {
-    uint8_t msb, lsb;
-    uint16_t value;
+void BMP280_ReadRegisters(uint8_t reg, uint8_t* data, uint8_t len) {
+    uint8_t buffer[BMP280_TRIMMING_LEN + 1];
+    uint8_t i;
 
-    lsb = BMP280_ReadRegister(reg);
-    msb = BMP280_ReadRegister(reg + 1);
+    if (len > BMP280_TRIMMING_LEN)
+        len = BMP280_TRIMMING_LEN;
 
-    value = (msb << 8) | lsb;
-    return value;
-}
+    buffer[0] = reg | 0x80;
+    for (i = 1; i <= len; i++)
+        buffer[i] = 0;
+    MCAL_SPI_Transfer(&MCAL_CFG_BMPSPI, buffer, buffer, len + 1, MCAL_SPI_DEFAULT_TIMEOUT_MS);
 
-/**
- * @brief: Read a signed 16-bit value from a BMP280 register
- */
-int16_t BMP280_ReadSignedShort(uint8_t reg) {
-    uint8_t msb, lsb;
-    int16_t value;
-
-    lsb = BMP280_ReadRegister(reg);
-    msb = BMP280_ReadRegister(reg + 1);
-
-    value = (msb << 8) | lsb;
-    return value;
+    for (i = 0; i < len; i++)
+        data[i] = buffer[i + 1];
 }
 
-
 /**
  * @brief: Retrieve trimming parameters from the BMP280 sensor
  */
 void BMP280_get_trimming_parameters() {
-    trimmingParameter.dig_T1 = BMP280_ReadUnsignedShort(DIG_T1);
-    trimmingParameter.dig_P1 = BMP280_ReadUnsignedShort(DIG_P1);
-
-    trimmingParameter.dig_T2 = BMP280_ReadSignedShort(DIG_T2);
-    trimmingParameter.dig_T3 = BMP280_ReadSignedShort(DIG_T3);
-
-    trimmingParameter.dig_P2 = BMP280_ReadSignedShort(DIG_P2);
-    trimmingParameter.dig_P3 = BMP280_ReadSignedShort(DIG_P3);
-    trimmingParameter.dig_P4 = BMP280_ReadSignedShort(DIG_P4);
-    trimmingParameter.dig_P5 = BMP280_ReadSignedShort(DIG_P5);
-    trimmingParameter.dig_P6 = BMP280_ReadSignedShort(DIG_P6);
-    trimmingParameter.dig_P7 = BMP280_ReadSignedShort(DIG_P7);
-    trimmingParameter.dig_P8 = BMP280_ReadSignedShort(DIG_P8);
-    trimmingParameter.dig_P9 = BMP280_ReadSignedShort(DIG_P9);
-}
+    uint8_t data[BMP280_TRIMMING_LEN];
 
-/**
- * @brief: Read a 20-bit value from the BMP280 sensor
- */
-uint32_t BMP280_ReadDataRegisters(uint8_t reg) {
-    uint8_t msb, lsb, xlsb;
-    uint32_t value;
+    BMP280_ReadRegisters(DIG_T1, data, BMP280_TRIMMING_LEN);
+
+    trimmingParameter.dig_T1 = BMP280_TRIM_U16(data, DIG_T1);
+    trimmingParameter.dig_P1 = BMP280_TRIM_U16(data, DIG_P1);
 
-    msb = BMP280_ReadRegister(reg);
-    lsb = BMP280_ReadRegister(reg + 1);
-    xlsb = BMP280_ReadRegister(reg + 2);
+    trimmingParameter.dig_T2 = BMP280_TRIM_S16(data, DIG_T2);
+    trimmingParameter.dig_T3 = BMP280_TRIM_S16(data, DIG_T3);
 
-    value = ((uint32_t)msb << 16) | ((uint32_t)lsb << 8) | xlsb;
-    return value;
+    trimmingParameter.dig_P2 = BMP280_TRIM_S16(data, DIG_P2);
+    trimmingParameter.dig_P3 = BMP280_TRIM_S16(data, DIG_P3);
+    trimmingParameter.dig_P4 = BMP280_TRIM_S16(data, DIG_P4);
+    trimmingParameter.dig_P5 = BMP280_TRIM_S16(data, DIG_P5);
+    trimmingParameter.dig_P6 = BMP280_TRIM_S16(data, DIG_P6);
+    trimmingParameter.dig_P7 = BMP280_TRIM_S16(data, DIG_P7);
+    trimmingParameter.dig_P8 = BMP280_TRIM_S16(data, DIG_P8);
+    trimmingParameter.dig_P9 = BMP280_TRIM_S16(data, DIG_P9);
 }
 
 /**
  * @brief: Retrieve raw temperature data from the BMP280 sensor
  */
 void BMP280_GetTemperatureRawData(int32_t *adc_T) {
-    *adc_T = BMP280_ReadDataRegisters(TEMP_MSB);
-    *adc_T >>= 4; // The data is stored in the 20 most significant bits
-}
+    uint8_t data[BMP280_RESULT_LEN];
 
-/**
- * @brief: Retrieve raw pressure data from the BMP280 sensor
- */
-void BMP280_GetPressureRawData(int32_t *adc_P) {
-    *adc_P = BMP280_ReadDataRegisters(PRESS_MSB);
-    *adc_P >>= 4; // The data is stored in the 20 most significant bits
+    BMP280_ReadRegisters(TEMP_MSB, data, BMP280_RESULT_LEN);
+    *adc_T = BMP280_RESULT(data);
 }
 
 /**
@@ -265,14 +271,27 @@ float BMP280_get_temperature() {
     return BMP280_CompensateTemperature(adc_T);
 }
 
+/**
+ * @brief: Get the temperature and the pressure from the BMP280 sensor in one transaction
+ * @note: both results come from the same measurement as the sensor holds its data registers during a burst read
+ */
+void BMP280_get_sample(float* temperature, float* pressure) {
+    uint8_t data[BMP280_DATA_LEN];
+
+    BMP280_ReadRegisters(PRESS_MSB, data, BMP280_DATA_LEN);
+
+    // the temperature updates t_fine used by the pressure compensation
+    *temperature = BMP280_CompensateTemperature(BMP280_RESULT(&data[TEMP_MSB - PRESS_MSB]));
+    *pressure = BMP280_CompensatePressure(BMP280_RESULT(&data[0]));
+}
+
 /**
  * @brief: Get the pressure value from the BMP280 sensor
  */
 float BMP280_get_pressure() {
-    int32_t adc_P;
-    BMP280_get_temperature(); // Ensure t_fine is updated
-    BMP280_GetPressureRawData(&adc_P);
-    return BMP280_CompensatePressure(adc_P);
+    float temperature, pressure;
+    BMP280_get_sample(&temperature, &pressure);
+    return pressure;
 }
 
 /**
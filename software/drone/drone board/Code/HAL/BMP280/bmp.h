@@ -39,6 +39,7 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    22/06/2023      1.0.0           Ahmed Fawzy                     Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           added 'BMP280_get_sample'.                                      |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -207,6 +208,35 @@ float BMP280_get_temperature(void);
  */
 float BMP280_get_pressure(void);
 
+/**
+ *  \b function                                 :       void BMP280_get_sample(float* temperature, float* pressure);
+ *  \b Description                              :       reads the pressure and temperature results in one SPI burst and compensates them.
+ *  @param  temperature [OUT]                   :       base address to store the temperature in Degree Celsius.
+ *  @param  pressure [OUT]                      :       base address to store the pressure in hPa.
+ *  @note                                       :       both values come from the same measurement, prefer it over calling BMP280_get_temperature()
+ *                                                      and BMP280_get_pressure() which read the sensor again each.
+ *  \b PRE-CONDITION                            :       BMP280_Init() is called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None
+ *  @see                                        :       float BMP280_get_pressure(void)
+ *
+ *  \b Example:
+ * @code
+ *
+ * float temperature, pressure;
+ * BMP280_get_sample(&temperature, &pressure);
+ *
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void BMP280_get_sample(float* temperature, float* pressure);
+
 /**
  *  \b function                                 :       None
  *  \b Description                              :       None
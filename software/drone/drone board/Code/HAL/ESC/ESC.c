@@ -39,6 +39,13 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    15/06/2023      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           DShot frames sent by DMA bursts of TIM4, added                  |
+ * |                                                                    'HAL_ESC_update', 'HAL_ESC_sendCommand' and                     |
+ * |                                                                    'HAL_ESC_DShotPacket'.                                          |
+ * |    17/10/2026      1.2.0           agent                           OneShot125 and Multishot pulses started by 'HAL_ESC_update',    |
+ * |                                                                    command to pulse latency measured by every update.              |
+ * |    17/10/2026      1.3.0           agent                           added bidirectional DShot, the reply of one motor is captured   |
+ * |                                                                    after every frame and decoded.                                  |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -61,12 +68,119 @@
  */
 #include "MCAL_wrapper.h"
 
+/**
+ * @reason: contains the DMA bursts and the single pulses of TIM4 that send the DShot frames and the OneShot pulses
+ */
+#include "MCAL_TIM4.h"
+
+/**
+ * @reason: contains the micro seconds time used to measure the latency of the updates
+ */
+#include "Service_RTOS_wrapper.h"
+
 
 
 /******************************************************************************
  * Module Preprocessor Constants
  *******************************************************************************/
 
+/**
+ * @brief: 1 when the ESCs are driven with DShot
+ */
+#define HAL_ESC_DSHOT       ((HAL_ESC_PROTOCOL == HAL_ESC_PROTOCOL_DSHOT300) || (HAL_ESC_PROTOCOL == HAL_ESC_PROTOCOL_DSHOT600))
+
+/**
+ * @brief: 1 when the ESCs are driven with single pulses of TIM4 (OneShot125 or Multishot)
+ */
+#define HAL_ESC_ONESHOT     ((HAL_ESC_PROTOCOL == HAL_ESC_PROTOCOL_ONESHOT125) || (HAL_ESC_PROTOCOL == HAL_ESC_PROTOCOL_MULTISHOT))
+
+#if HAL_ESC_DSHOT
+
+/**
+ * @brief: bit rate of the DShot frames
+ */
+#if HAL_ESC_PROTOCOL == HAL_ESC_PROTOCOL_DSHOT600
+#define HAL_ESC_DSHOT_BITRATE               (600000UL)
+#else
+#define HAL_ESC_DSHOT_BITRATE               (300000UL)
+#endif
+
+/**
+ * @brief: timer ticks of a bit and of the high part of a 1 (75% of the bit) and of a 0 (37.5% of the bit)
+ */
+#define HAL_ESC_DSHOT_BIT_TICKS             (MCAL_TIM4_CLOCK_HZ / HAL_ESC_DSHOT_BITRATE)
+#define HAL_ESC_DSHOT_T1H_TICKS             ((HAL_ESC_DSHOT_BIT_TICKS * 3) / 4)
+#define HAL_ESC_DSHOT_T0H_TICKS             ((HAL_ESC_DSHOT_BIT_TICKS * 3) / 8)
+
+/**
+ * @brief: timer periods of a frame including the low periods after it
+ */
+#define HAL_ESC_DSHOT_FRAME_PERIODS         (HAL_ESC_DSHOT_FRAME_BITS + HAL_ESC_DSHOT_FRAME_GAP)
+
+/**
+ * @brief: timer ticks of a bit of the bidirectional replies (5/4 of the bit rate of the frames)
+ */
+#define HAL_ESC_DSHOT_REPLY_BIT_TICKS       ((HAL_ESC_DSHOT_BIT_TICKS * 4) / 5)
+
+#endif
+
+#if HAL_ESC_ONESHOT
+
+/**
+ * @brief: timer ticks of the pulses at 0% and 100% speed
+ */
+#if HAL_ESC_PROTOCOL == HAL_ESC_PROTOCOL_ONESHOT125
+#define HAL_ESC_PULSE_MIN_TICKS             (MCAL_TIM4_CLOCK_HZ / 8000UL)       // 125 us
+#define HAL_ESC_PULSE_MAX_TICKS             (MCAL_TIM4_CLOCK_HZ / 4000UL)       // 250 us
+#else
+#define HAL_ESC_PULSE_MIN_TICKS             (MCAL_TIM4_CLOCK_HZ / 200000UL)     // 5 us
+#define HAL_ESC_PULSE_MAX_TICKS             (MCAL_TIM4_CLOCK_HZ / 40000UL)      // 25 us
+#endif
+
+/**
+ * @brief: timer ticks of the low time before the longest pulse so every pulse starts with a rising edge (1 us)
+ */
+#define HAL_ESC_PULSE_LEAD_TICKS            (MCAL_TIM4_CLOCK_HZ / 1000000UL)
+
+/**
+ * @brief: timer ticks of the single period of TIM4, the pulses are right aligned and all end with it
+ */
+#define HAL_ESC_PULSE_PERIOD_TICKS          (HAL_ESC_PULSE_LEAD_TICKS + HAL_ESC_PULSE_MAX_TICKS)
+
+#endif
+
+#if HAL_ESC_DSHOT || HAL_ESC_ONESHOT
+
+/**
+ * @brief: timer ticks of TIM4 in a micro second
+ */
+#define HAL_ESC_TICKS_PER_US                (MCAL_TIM4_CLOCK_HZ / 1000000UL)
+
+#else
+
+/**
+ * @brief: TIM4 counts micro seconds with PWM and a frame is 20001 ticks (period of MCAL_Config_ConfigAllPins)
+ */
+#define HAL_ESC_TICKS_PER_US                (1)
+#define HAL_ESC_PWM_FRAME_TICKS             (20001)
+
+#endif
+
+/**
+ * @brief: time the stop frames or the shortest pulses are sent for at initialization so the ESCs arm, in milli seconds
+ */
+#define HAL_ESC_ARM_MS                      (1500)
+
+/**
+ * @brief: number of motors
+ */
+#define HAL_ESC_MOTORS                      (HAL_ESC_MOTOR_BOTTOM_RIGHT + 1)
+
+/**
+ * @brief: marks the 5 bits codes that aren't GCR in 'global_u8ESCGcrDecode'
+ */
+#define HAL_ESC_GCR_INVALID                 (0xFF)
+
 /******************************************************************************
  * Module Preprocessor Macros
  *******************************************************************************/
@@ -79,6 +193,79 @@
  * Module Variable Definitions
  *******************************************************************************/
 
+#if HAL_ESC_DSHOT
+
+/**
+ * @brief: the frame of every motor sent by the next update (a frame of zeros is the motor stop command)
+ */
+uint16_t global_u16ESCPackets[HAL_ESC_MOTORS] = {0};
+
+/**
+ * @brief: compare values of the four channels for every bit of the frames, the DMA reads one buffer while the next frames
+ *         are written in the other one, the low periods at the end are never written
+ */
+uint16_t global_u16ESCCompares[2][HAL_ESC_DSHOT_FRAME_PERIODS * MCAL_TIM4_CHANNELS] = {{0}};
+
+/**
+ * @brief: the buffer the next frames are written in
+ */
+uint8_t global_u8ESCNextBuffer = 0;
+
+#elif HAL_ESC_ONESHOT
+
+/**
+ * @brief: compare values of the four channels sent by the next update, the pulse of a motor is the period minus its
+ *         compare value
+ */
+uint16_t global_u16ESCPulseCompares[MCAL_TIM4_CHANNELS] = {0};
+
+#else
+
+/**
+ * @brief: pulses of the four channels in micro seconds set by HAL_ESC_setSpeed and the ones of the previous update, used
+ *         to know when the new speeds are out
+ */
+uint16_t global_u16ESCPulses[HAL_ESC_MOTORS] = {0};
+uint16_t global_u16ESCPrevPulses[HAL_ESC_MOTORS] = {0};
+
+#endif
+
+/**
+ * @brief: latency of the updates
+ */
+HAL_ESC_Latency_t global_ESCLatency_t = {0};
+
+/**
+ * @brief: the nibble of every 5 bits GCR code of the bidirectional DShot replies
+ */
+const uint8_t global_u8ESCGcrDecode[32] = {
+    HAL_ESC_GCR_INVALID, HAL_ESC_GCR_INVALID, HAL_ESC_GCR_INVALID, HAL_ESC_GCR_INVALID,
+    HAL_ESC_GCR_INVALID, HAL_ESC_GCR_INVALID, HAL_ESC_GCR_INVALID, HAL_ESC_GCR_INVALID,
+    HAL_ESC_GCR_INVALID, 0x9, 0xA, 0xB, HAL_ESC_GCR_INVALID, 0xD, 0xE, 0xF,
+    HAL_ESC_GCR_INVALID, HAL_ESC_GCR_INVALID, 0x2, 0x3, HAL_ESC_GCR_INVALID, 0x5, 0x6, 0x7,
+    HAL_ESC_GCR_INVALID, 0x0, 0x8, 0x1, HAL_ESC_GCR_INVALID, 0x4, 0xC, HAL_ESC_GCR_INVALID,
+};
+
+#if HAL_ESC_DSHOT_BIDIR
+
+/**
+ * @brief: times of the edges of the reply being captured
+ */
+uint16_t global_u16ESCReplyEdges[MCAL_TIM4_CAPTURE_MAX_EDGES] = {0};
+
+/**
+ * @brief: the motor whose reply is captured and 1 if a reply was asked for by the last frames
+ */
+uint8_t global_u8ESCReplyMotor = 0;
+uint8_t global_u8ESCReplyPending = 0;
+
+/**
+ * @brief: the decoded replies
+ */
+HAL_ESC_Telemetry_t global_ESCTelemetry_t = {0};
+
+#endif
+
 /******************************************************************************
  * Function Prototypes
  *******************************************************************************/
@@ -92,6 +279,39 @@
  */
 HAL_ESC_ErrStates_t HAL_ESC_init(void)
 {
+#if HAL_ESC_DSHOT
+    uint16_t i = 0;
+
+    // every period of TIM4 is one bit, the bidirectional signal idles high
+    MCAL_TIM4_InitBurst(HAL_ESC_DSHOT_BIT_TICKS, HAL_ESC_DSHOT_BIDIR);
+
+    // the ESCs arm after receiving stop frames for a while
+    for(i = 0; i < HAL_ESC_ARM_MS; i++)
+    {
+        HAL_ESC_update();
+        MCAL_WRAPPER_DelayUS(1000);
+    }
+
+    return HAL_ESC_OK;
+#elif HAL_ESC_ONESHOT
+    uint16_t i = 0;
+
+    // TIM4 leaves the 50 Hz PWM and sends one period of pulses when started
+    MCAL_TIM4_InitOnePulse(HAL_ESC_PULSE_PERIOD_TICKS);
+
+    // the ESCs arm after receiving the shortest pulses for a while
+    for(i = 0; i < HAL_ESC_MOTORS; i++)
+    {
+        global_u16ESCPulseCompares[i] = HAL_ESC_PULSE_PERIOD_TICKS - HAL_ESC_PULSE_MIN_TICKS;
+    }
+    for(i = 0; i < HAL_ESC_ARM_MS; i++)
+    {
+        HAL_ESC_update();
+        MCAL_WRAPPER_DelayUS(1000);
+    }
+
+    return HAL_ESC_OK;
+#else
 
     // set all the motors to low for a period of time
     MCAL_WRAPEPR_TIM4_PWM_OUT(MCAL_WRAPPER_TIM_CH1, 0);
@@ -126,6 +346,7 @@ HAL_ESC_ErrStates_t HAL_ESC_init(void)
     // MCAL_WRAPEPR_TIM4_PWM_OUT(MCAL_WRAPPER_TIM_CH4, 50);
 
     return HAL_ESC_OK;
+#endif
 }
 
 /**
@@ -138,7 +359,26 @@ HAL_ESC_ErrStates_t HAL_ESC_setSpeed(HAL_ESC_MotorNum_t arg_MotorNum_t, float mo
         return HAL_ESC_ERR_INVALID_PARAMS;
     }
 
+#if HAL_ESC_DSHOT
+    uint16_t local_u16Throttle = 0;
+
+    // 0 stops the motor, the rest of the range is spread on the 2000 throttle steps
+    if(motorSpeed > 0)
+    {
+        local_u16Throttle = HAL_ESC_DSHOT_THROTTLE_MIN + (uint16_t)(motorSpeed * ((HAL_ESC_DSHOT_THROTTLE_MAX - HAL_ESC_DSHOT_THROTTLE_MIN) / 100.0f) + 0.5f);
+    }
+    global_u16ESCPackets[arg_MotorNum_t] = HAL_ESC_DShotPacket(local_u16Throttle, 0);
+#elif HAL_ESC_ONESHOT
+    if(motorSpeed < 0)
+    {
+        motorSpeed = 0;
+    }
+
+    // the pulse starts at the compare value and ends with the period
+    global_u16ESCPulseCompares[arg_MotorNum_t] = HAL_ESC_PULSE_PERIOD_TICKS - (HAL_ESC_PULSE_MIN_TICKS + (uint16_t)(motorSpeed * ((HAL_ESC_PULSE_MAX_TICKS - HAL_ESC_PULSE_MIN_TICKS) / 100.0f) + 0.5f));
+#else
     motorSpeed *= 10;
+    global_u16ESCPulses[arg_MotorNum_t] = 1000 + (uint16_t)motorSpeed;
 
     switch (arg_MotorNum_t)
     {
@@ -157,8 +397,297 @@ HAL_ESC_ErrStates_t HAL_ESC_setSpeed(HAL_ESC_MotorNum_t arg_MotorNum_t, float mo
     default:
         break;
     }
+#endif
+
+    return HAL_ESC_OK;
+}
+
+/**
+ * 
+ */
+HAL_ESC_ErrStates_t HAL_ESC_update(void)
+{
+    uint32_t local_u32StartUS = 0;
+    uint32_t local_u32EndUS = 0;
+    uint32_t local_u32PulseTicks = 0;
+    uint16_t local_u16Counter = 0;
+
+    SERVICE_RTOS_CurrentUSTime(&local_u32StartUS);
+
+#if HAL_ESC_DSHOT
+    uint16_t* local_pu16Compare = global_u16ESCCompares[global_u8ESCNextBuffer];
+    uint16_t local_u16Mask = 0;
+    uint8_t local_u8Motor = 0;
+#if HAL_ESC_DSHOT_BIDIR
+    uint32_t local_u32ERPM = 0;
+    uint8_t local_u8Edges = 0;
+    uint8_t local_u8Armed = 0;
+
+    // the pins are given back to the outputs once the reply to the previous frames is in
+    if(MCAL_TIM4_STAT_OK != MCAL_TIM4_StopCapture(&local_u8Edges))
+    {
+        global_ESCLatency_t.busy++;
+        return HAL_ESC_ERR_BUSY;
+    }
+    if(global_u8ESCReplyPending)
+    {
+        global_u8ESCReplyPending = 0;
+        local_u32ERPM = HAL_ESC_DecodeERPM(global_u16ESCReplyEdges, local_u8Edges, HAL_ESC_DSHOT_REPLY_BIT_TICKS);
+        if(HAL_ESC_ERPM_INVALID != local_u32ERPM)
+        {
+            global_ESCTelemetry_t.eRPM[global_u8ESCReplyMotor] = local_u32ERPM;
+            global_ESCTelemetry_t.valid |= (uint8_t)(1 << global_u8ESCReplyMotor);
+            global_ESCTelemetry_t.replies++;
+        }
+        else
+        {
+            global_ESCTelemetry_t.valid &= (uint8_t)~(1 << global_u8ESCReplyMotor);
+            global_ESCTelemetry_t.errors++;
+        }
+        global_u8ESCReplyMotor = (global_u8ESCReplyMotor + 1) % HAL_ESC_MOTORS;
+    }
+#endif
+
+    // one set of four compare values per bit, most significant bit first
+    for(local_u16Mask = 0x8000; local_u16Mask; local_u16Mask >>= 1)
+    {
+        for(local_u8Motor = 0; local_u8Motor < HAL_ESC_MOTORS; local_u8Motor++)
+        {
+            *local_pu16Compare++ = (global_u16ESCPackets[local_u8Motor] & local_u16Mask) ? HAL_ESC_DSHOT_T1H_TICKS : HAL_ESC_DSHOT_T0H_TICKS;
+        }
+    }
+
+#if HAL_ESC_DSHOT_BIDIR
+    // all the ESCs answer, one is listened to after these frames
+    local_u8Armed = (MCAL_TIM4_STAT_OK == MCAL_TIM4_ArmCapture(global_u8ESCReplyMotor, global_u16ESCReplyEdges, MCAL_TIM4_CAPTURE_MAX_EDGES));
+#endif
+
+    // the buffer being sent is the other one so it's untouched if the previous frames aren't done
+    if(MCAL_TIM4_STAT_OK != MCAL_TIM4_StartBurst(global_u16ESCCompares[global_u8ESCNextBuffer], HAL_ESC_DSHOT_FRAME_PERIODS))
+    {
+        global_ESCLatency_t.busy++;
+        return HAL_ESC_ERR_BUSY;
+    }
+    global_u8ESCNextBuffer ^= 1;
+#if HAL_ESC_DSHOT_BIDIR
+    global_u8ESCReplyPending = local_u8Armed;
+#endif
+    MCAL_TIM4_GetCounter(&local_u16Counter);
+
+    // the first bit is loaded by the request of the next update event and the frames end 16 bits after it
+    local_u32PulseTicks = (HAL_ESC_DSHOT_BIT_TICKS - local_u16Counter) + (HAL_ESC_DSHOT_FRAME_BITS * HAL_ESC_DSHOT_BIT_TICKS);
+#elif HAL_ESC_ONESHOT
+    if(MCAL_TIM4_STAT_OK != MCAL_TIM4_StartPulses(global_u16ESCPulseCompares))
+    {
+        global_ESCLatency_t.busy++;
+        return HAL_ESC_ERR_BUSY;
+    }
+    MCAL_TIM4_GetCounter(&local_u16Counter);
+
+    // the pulses end with the period
+    local_u32PulseTicks = HAL_ESC_PULSE_PERIOD_TICKS - local_u16Counter;
+#else
+    uint32_t local_u32MotorTicks = 0;
+    uint8_t local_u8Motor = 0;
+
+    MCAL_TIM4_GetCounter(&local_u16Counter);
+
+    // the compare values apply right away without the preload, a pulse still high with the old and the new value ends
+    // with the new one in this frame, else the output glitches and the new pulse is the one of the next frame
+    for(local_u8Motor = 0; local_u8Motor < HAL_ESC_MOTORS; local_u8Motor++)
+    {
+        if(local_u16Counter < global_u16ESCPulses[local_u8Motor] && local_u16Counter < global_u16ESCPrevPulses[local_u8Motor])
+        {
+            local_u32MotorTicks = global_u16ESCPulses[local_u8Motor] - local_u16Counter;
+        }
+        else
+        {
+            local_u32MotorTicks = (HAL_ESC_PWM_FRAME_TICKS - local_u16Counter) + global_u16ESCPulses[local_u8Motor];
+        }
+
+        if(local_u32MotorTicks > local_u32PulseTicks)
+        {
+            local_u32PulseTicks = local_u32MotorTicks;
+        }
+        global_u16ESCPrevPulses[local_u8Motor] = global_u16ESCPulses[local_u8Motor];
+    }
+#endif
+
+    SERVICE_RTOS_CurrentUSTime(&local_u32EndUS);
+    global_ESCLatency_t.lastUS = (local_u32EndUS - local_u32StartUS) + (local_u32PulseTicks + HAL_ESC_TICKS_PER_US - 1) / HAL_ESC_TICKS_PER_US;
+    if(global_ESCLatency_t.lastUS > global_ESCLatency_t.maxUS)
+    {
+        global_ESCLatency_t.maxUS = global_ESCLatency_t.lastUS;
+    }
+    global_ESCLatency_t.updates++;
+
+    return HAL_ESC_OK;
+}
+
+/**
+ * 
+ */
+HAL_ESC_ErrStates_t HAL_ESC_sendCommand(HAL_ESC_MotorNum_t arg_MotorNum_t, HAL_ESC_DShotCmd_t arg_Cmd_t)
+{
+#if HAL_ESC_DSHOT
+    uint8_t i = 0;
+
+    if(arg_MotorNum_t > HAL_ESC_MOTOR_BOTTOM_RIGHT || (uint16_t)arg_Cmd_t >= HAL_ESC_DSHOT_THROTTLE_MIN)
+    {
+        return HAL_ESC_ERR_INVALID_PARAMS;
+    }
+
+    for(i = 0; i < HAL_ESC_MOTORS; i++)
+    {
+        global_u16ESCPackets[i] = HAL_ESC_DShotPacket(HAL_ESC_DSHOT_CMD_MOTOR_STOP, 0);
+    }
+
+    // the ESCs only act on a command received several times in a row with the telemetry bit set
+    global_u16ESCPackets[arg_MotorNum_t] = HAL_ESC_DShotPacket((uint16_t)arg_Cmd_t, 1);
+    for(i = 0; i < HAL_ESC_DSHOT_CMD_REPEAT; i++)
+    {
+        HAL_ESC_update();
+        MCAL_WRAPPER_DelayUS(1000);
+    }
+    global_u16ESCPackets[arg_MotorNum_t] = HAL_ESC_DShotPacket(HAL_ESC_DSHOT_CMD_MOTOR_STOP, 0);
+
+    return HAL_ESC_OK;
+#else
+    (void)arg_MotorNum_t;
+    (void)arg_Cmd_t;
+
+    return HAL_ESC_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * 
+ */
+uint16_t HAL_ESC_DShotPacket(uint16_t arg_u16Value, uint8_t arg_u8Telemetry)
+{
+    uint16_t local_u16Packet = (uint16_t)(((arg_u16Value & 0x07FF) << 1) | (arg_u8Telemetry ? 1 : 0));
+    uint16_t local_u16Crc = 0;
+
+    // the CRC is the XOR of the three nibbles of the value and the telemetry bit
+    local_u16Crc = (uint16_t)(local_u16Packet ^ (local_u16Packet >> 4) ^ (local_u16Packet >> 8));
+#if HAL_ESC_DSHOT_BIDIR
+    // the ESCs tell the bidirectional frames by their inverted CRC
+    local_u16Crc = (uint16_t)~local_u16Crc;
+#endif
+
+    return (uint16_t)((local_u16Packet << 4) | (local_u16Crc & 0x0F));
+}
+
+/**
+ * 
+ */
+HAL_ESC_ErrStates_t HAL_ESC_getLatency(HAL_ESC_Latency_t* arg_pLatency_t)
+{
+    if(NULL == arg_pLatency_t)
+    {
+        return HAL_ESC_ERR_INVALID_PARAMS;
+    }
+
+    *arg_pLatency_t = global_ESCLatency_t;
 
     return HAL_ESC_OK;
 }
 
+/**
+ * 
+ */
+HAL_ESC_ErrStates_t HAL_ESC_getTelemetry(HAL_ESC_Telemetry_t* arg_pTelemetry_t)
+{
+    if(NULL == arg_pTelemetry_t)
+    {
+        return HAL_ESC_ERR_INVALID_PARAMS;
+    }
+
+#if HAL_ESC_DSHOT_BIDIR
+    // the telemetry is rewritten by 'HAL_ESC_update' in the task sending the speeds, copy it in one piece
+    SERVICE_RTOS_EnterCritical();
+    *arg_pTelemetry_t = global_ESCTelemetry_t;
+    SERVICE_RTOS_ExitCritical();
+
+    return HAL_ESC_OK;
+#else
+    return HAL_ESC_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * NOTE: every edge starts a 1 followed by as many 0 as the bits until the next edge, the bits after the last edge up to
+ *       the 21st are 0 as the line may already be back to idle, the edges after the 21st bit are ignored
+ */
+uint32_t HAL_ESC_DecodeERPM(const uint16_t* arg_pu16Edges, uint8_t arg_u8Count, uint16_t arg_u16BitTicks)
+{
+    uint32_t local_u32Gcr = 0;
+    uint16_t local_u16Frame = 0;
+    uint16_t local_u16Period = 0;
+    uint8_t local_u8Bits = 0;
+    uint8_t local_u8Len = 0;
+    uint8_t local_u8Nibble = 0;
+    uint8_t i = 0;
+
+    if(NULL == arg_pu16Edges || 0 == arg_u8Count || 0 == arg_u16BitTicks)
+    {
+        return HAL_ESC_ERPM_INVALID;
+    }
+
+    for(i = 1; i <= arg_u8Count && local_u8Bits < HAL_ESC_DSHOT_REPLY_BITS; i++)
+    {
+        if(i < arg_u8Count)
+        {
+            local_u8Len = (uint8_t)(((uint16_t)(arg_pu16Edges[i] - arg_pu16Edges[i - 1]) + arg_u16BitTicks / 2) / arg_u16BitTicks);
+        }
+        else
+        {
+            local_u8Len = HAL_ESC_DSHOT_REPLY_BITS - local_u8Bits;
+        }
+
+        if(0 == local_u8Len)
+        {
+            return HAL_ESC_ERPM_INVALID;
+        }
+        // the line going back to idle may come after the 21st bit
+        if(local_u8Bits + local_u8Len > HAL_ESC_DSHOT_REPLY_BITS)
+        {
+            local_u8Len = HAL_ESC_DSHOT_REPLY_BITS - local_u8Bits;
+        }
+        local_u32Gcr = (local_u32Gcr << local_u8Len) | (1UL << (local_u8Len - 1));
+        local_u8Bits += local_u8Len;
+    }
+
+    // four 5 bits codes after the start bit, most significant first
+    for(i = 0; i < 4; i++)
+    {
+        local_u8Nibble = global_u8ESCGcrDecode[(local_u32Gcr >> (15 - 5 * i)) & 0x1F];
+        if(HAL_ESC_GCR_INVALID == local_u8Nibble)
+        {
+            return HAL_ESC_ERPM_INVALID;
+        }
+        local_u16Frame = (uint16_t)((local_u16Frame << 4) | local_u8Nibble);
+    }
+
+    // the XOR of the four nibbles of a good frame is 0xF (inverted CRC)
+    if(0x0F != ((local_u16Frame ^ (local_u16Frame >> 4) ^ (local_u16Frame >> 8) ^ (local_u16Frame >> 12)) & 0x0F))
+    {
+        return HAL_ESC_ERPM_INVALID;
+    }
+
+    // period of an electrical revolution in micro seconds: 9 bits shifted by 3 bits, all ones when stopped
+    local_u16Frame >>= 4;
+    if(0x0FFF == local_u16Frame)
+    {
+        return 0;
+    }
+    local_u16Period = (uint16_t)((local_u16Frame & 0x01FF) << (local_u16Frame >> 9));
+    if(0 == local_u16Period)
+    {
+        return HAL_ESC_ERPM_INVALID;
+    }
+
+    return (60000000UL + local_u16Period / 2) / local_u16Period;
+}
+
 /*************** END OF FUNCTIONS ***************************************************************************/
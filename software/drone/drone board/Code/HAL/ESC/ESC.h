@@ -39,6 +39,12 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    15/06/2023      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           added DShot300/DShot600 (HAL_ESC_PROTOCOL), 'HAL_ESC_update',   |
+ * |                                                                    'HAL_ESC_sendCommand' and 'HAL_ESC_DShotPacket'.                |
+ * |    17/10/2026      1.2.0           agent                           added OneShot125 and Multishot sent by single pulses of TIM4    |
+ * |                                                                    and 'HAL_ESC_getLatency'.                                       |
+ * |    17/10/2026      1.3.0           agent                           added bidirectional DShot, the ESCs send their eRPM back and    |
+ * |                                                                    'HAL_ESC_getTelemetry' returns it.                              |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -59,10 +65,71 @@
  * Preprocessor Constants
  *******************************************************************************/
 
+/**
+ * @brief: protocols the ESCs can be driven with (refer to HAL_ESC_PROTOCOL)
+ */
+#define HAL_ESC_PROTOCOL_PWM                (0)     /**< 1000 to 2000 us pulses at 50 Hz */
+#define HAL_ESC_PROTOCOL_DSHOT300           (1)     /**< 16 bits DShot frames at 300 Kbit/s */
+#define HAL_ESC_PROTOCOL_DSHOT600           (2)     /**< 16 bits DShot frames at 600 Kbit/s */
+#define HAL_ESC_PROTOCOL_ONESHOT125         (3)     /**< 125 to 250 us single pulses sent by every HAL_ESC_update */
+#define HAL_ESC_PROTOCOL_MULTISHOT          (4)     /**< 5 to 25 us single pulses sent by every HAL_ESC_update */
+
+/**
+ * @brief: throttle values of a DShot frame, the values below HAL_ESC_DSHOT_THROTTLE_MIN are the commands (refer to
+ *         @HAL_ESC_DShotCmd_t) so the throttle has 2000 steps
+ */
+#define HAL_ESC_DSHOT_THROTTLE_MIN          (48)
+#define HAL_ESC_DSHOT_THROTTLE_MAX          (2047)
+
+/**
+ * @brief: bits of a DShot frame (11 bits value, telemetry request and 4 bits CRC) and the low bit periods sent after them
+ *         so two frames are never back to back
+ */
+#define HAL_ESC_DSHOT_FRAME_BITS            (16)
+#define HAL_ESC_DSHOT_FRAME_GAP             (2)
+
+/**
+ * @brief: times a special command is sent, the ESCs only act on the settings commands after 6 of them
+ */
+#define HAL_ESC_DSHOT_CMD_REPEAT            (10)
+
+/**
+ * @brief: bits of a bidirectional DShot reply, the 16 bits eRPM frame is GCR encoded in 20 bits and sent after a start bit
+ *         at 5/4 of the bit rate of the frames
+ */
+#define HAL_ESC_DSHOT_REPLY_BITS            (21)
+
+/**
+ * @brief: returned by HAL_ESC_DecodeERPM when the reply is missing or corrupted
+ */
+#define HAL_ESC_ERPM_INVALID                (0xFFFFFFFFUL)
+
 /******************************************************************************
  * Configuration Constants
  *******************************************************************************/
 
+/**
+ * @brief: the protocol of the ESCs, with DShot, OneShot125 and Multishot the motors are updated by every HAL_ESC_update
+ *         (every control loop) instead of every 20 ms PWM frame
+ */
+#define HAL_ESC_PROTOCOL                    HAL_ESC_PROTOCOL_PWM
+
+/**
+ * @brief: 1 to have the ESCs answer every DShot frame with their eRPM on the same wire (bidirectional DShot), the signal
+ *         is inverted and the reply of one motor is captured after every HAL_ESC_update, so every motor is heard once
+ *         every 4 updates. the ESC firmware must support it (BLHeli_32, Bluejay, AM32)
+ */
+#define HAL_ESC_DSHOT_BIDIR                 (0)
+
+/**
+ * @brief: number of magnet poles of the motors, the mechanical RPM is the eRPM divided by the pairs of poles
+ */
+#define HAL_ESC_MOTOR_POLES                 (14)
+
+#if HAL_ESC_DSHOT_BIDIR && (HAL_ESC_PROTOCOL != HAL_ESC_PROTOCOL_DSHOT300) && (HAL_ESC_PROTOCOL != HAL_ESC_PROTOCOL_DSHOT600)
+#error "bidirectional DShot (HAL_ESC_DSHOT_BIDIR) needs HAL_ESC_PROTOCOL_DSHOT300 or HAL_ESC_PROTOCOL_DSHOT600"
+#endif
+
 /******************************************************************************
  * Macros
  *******************************************************************************/
@@ -79,6 +146,8 @@ typedef enum
 {
     HAL_ESC_OK,                 /**< it means everything has gone as intended so no errors*/
     HAL_ESC_ERR_INVALID_PARAMS, /**< it means that the supplied parameters of the function are invalid*/
+    HAL_ESC_ERR_BUSY,           /**< the previous frame or pulses are still being sent */
+    HAL_ESC_ERR_NOT_SUPPORTED,  /**< the request needs a digital protocol (DShot) */
 } HAL_ESC_ErrStates_t;
 
 
@@ -90,6 +159,53 @@ typedef enum
     HAL_ESC_MOTOR_BOTTOM_RIGHT,     /**< BOTTOM RIGHT motor*/
 } HAL_ESC_MotorNum_t;
 
+/**
+ * @enum: HAL_ESC_DShotCmd_t
+ * @brief: special commands of DShot, sent in place of the throttle while the motors are stopped
+ */
+typedef enum
+{
+    HAL_ESC_DSHOT_CMD_MOTOR_STOP = 0,               /**< stops the motor */
+    HAL_ESC_DSHOT_CMD_BEEP1 = 1,                    /**< beeps, wait at least 260 ms before the next command */
+    HAL_ESC_DSHOT_CMD_BEEP2 = 2,
+    HAL_ESC_DSHOT_CMD_BEEP3 = 3,
+    HAL_ESC_DSHOT_CMD_BEEP4 = 4,
+    HAL_ESC_DSHOT_CMD_BEEP5 = 5,
+    HAL_ESC_DSHOT_CMD_ESC_INFO = 6,                 /**< the ESC answers with its information on the telemetry wire */
+    HAL_ESC_DSHOT_CMD_SPIN_DIRECTION_1 = 7,         /**< spin direction 1 (needs HAL_ESC_DSHOT_CMD_SAVE_SETTINGS to stay) */
+    HAL_ESC_DSHOT_CMD_SPIN_DIRECTION_2 = 8,         /**< spin direction 2 (needs HAL_ESC_DSHOT_CMD_SAVE_SETTINGS to stay) */
+    HAL_ESC_DSHOT_CMD_3D_MODE_OFF = 9,
+    HAL_ESC_DSHOT_CMD_3D_MODE_ON = 10,
+    HAL_ESC_DSHOT_CMD_SETTINGS_REQUEST = 11,
+    HAL_ESC_DSHOT_CMD_SAVE_SETTINGS = 12,           /**< saves the settings in the ESC, wait at least 35 ms before the next command */
+    HAL_ESC_DSHOT_CMD_SPIN_DIRECTION_NORMAL = 20,   /**< spin in the direction of the settings of the ESC */
+    HAL_ESC_DSHOT_CMD_SPIN_DIRECTION_REVERSED = 21, /**< spin in the opposite direction of the settings of the ESC */
+} HAL_ESC_DShotCmd_t;
+
+/**
+ * @struct: HAL_ESC_Latency_t
+ * @brief: time from the start of HAL_ESC_update to the end of the pulses or frames carrying the new speeds
+ */
+typedef struct
+{
+    uint32_t lastUS;            /**< latency of the last update in micro seconds */
+    uint32_t maxUS;             /**< longest latency since the initialization in micro seconds */
+    uint32_t updates;           /**< updates sent to the ESCs */
+    uint32_t busy;              /**< updates dropped because the previous pulses or frames were still being sent */
+} HAL_ESC_Latency_t;
+
+/**
+ * @struct: HAL_ESC_Telemetry_t
+ * @brief: the eRPM replies of bidirectional DShot
+ */
+typedef struct
+{
+    uint32_t eRPM[HAL_ESC_MOTOR_BOTTOM_RIGHT + 1];  /**< last eRPM of every motor (refer to @HAL_ESC_MotorNum_t), 0 when stopped */
+    uint8_t valid;                                  /**< bit n is set if the last reply of motor n was decoded */
+    uint32_t replies;                               /**< decoded replies */
+    uint32_t errors;                                /**< missing or corrupted replies */
+} HAL_ESC_Telemetry_t;
+
 /******************************************************************************
  * Variables
  *******************************************************************************/
@@ -138,7 +254,9 @@ HAL_ESC_ErrStates_t HAL_ESC_init(void);
  *  \b Description                              :       this functions is used change speed of motor connected to ESC.
  *  @param  arg_MotorNum_t [IN]                 :       which motor to change its speed.
  *  @param  motorSpeed [IN]                     :       percent of speed of the motor, possible values are from 0.0 to 100.0.
- *  @note                                       :       None.
+ *  @note                                       :       with DShot the speed is mapped on the 2000 throttle steps and only sent by HAL_ESC_update,
+ *                                                      0 stops the motor. with OneShot125 and Multishot it is mapped on the pulse width and also
+ *                                                      only sent by HAL_ESC_update.
  *  \b PRE-CONDITION                            :       make sure to call configure the configuration file in the current directory and initialized the motor.
  *  \b POST-CONDITION                           :       motor speed is changed.
  *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_ESC_ErrStates_t in "ESC.h")
@@ -168,11 +286,212 @@ HAL_ESC_ErrStates_t HAL_ESC_init(void);
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
  * <tr><td> 15/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.1.0            </td><td> agent    </td><td> DShot speeds are sent by HAL_ESC_update </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.2.0            </td><td> agent    </td><td> OneShot125 and Multishot pulse widths </td></tr>
  * </table><br><br>
  * <hr>
  */
 HAL_ESC_ErrStates_t HAL_ESC_setSpeed(HAL_ESC_MotorNum_t arg_MotorNum_t, float motorSpeed);
 
+/**
+ *  \b function                                 :       HAL_ESC_ErrStates_t HAL_ESC_update(void);
+ *  \b Description                              :       this functions is used to send the speeds set by HAL_ESC_setSpeed to the four motors at once.
+ *  @param  -                                   :       None.
+ *  @note                                       :       with DShot the four frames are sent by DMA in ~30 us (DShot600), with OneShot125 and
+ *                                                      Multishot TIM4 sends one pulse per motor ending together (~251 us / ~26 us), in both cases
+ *                                                      the function returns right away. with PWM the speeds are already applied so it only
+ *                                                      measures the latency (refer to HAL_ESC_getLatency).
+ *  \b PRE-CONDITION                            :       HAL_ESC_init is called.
+ *  \b POST-CONDITION                           :       the ESCs receive the new speeds.
+ *  @return                                     :       HAL_ESC_ERR_BUSY if the previous frames are still being sent, else HAL_ESC_OK
+ *  @see                                        :       HAL_ESC_ErrStates_t HAL_ESC_setSpeed(HAL_ESC_MotorNum_t arg_MotorNum_t, float motorSpeed)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "ESC.h"
+ * 
+ * HAL_ESC_setSpeed(HAL_ESC_MOTOR_TOP_LEFT, 50);
+ * HAL_ESC_setSpeed(HAL_ESC_MOTOR_TOP_RIGHT, 50);
+ * HAL_ESC_setSpeed(HAL_ESC_MOTOR_BOTTOM_LEFT, 50);
+ * HAL_ESC_setSpeed(HAL_ESC_MOTOR_BOTTOM_RIGHT, 50);
+ * HAL_ESC_update();
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.2.0            </td><td> agent    </td><td> OneShot125, Multishot and latency measurement </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_ESC_ErrStates_t HAL_ESC_update(void);
+
+/**
+ *  \b function                                 :       HAL_ESC_ErrStates_t HAL_ESC_sendCommand(HAL_ESC_MotorNum_t arg_MotorNum_t, HAL_ESC_DShotCmd_t arg_Cmd_t);
+ *  \b Description                              :       this functions is used to send a DShot special command (beep, spin direction, save settings, ...) to
+ *                                                      one ESC, the other motors are sent a stop.
+ *  @param  arg_MotorNum_t [IN]                 :       which ESC to send the command to.
+ *  @param  arg_Cmd_t [IN]                      :       the command, refer to @HAL_ESC_DShotCmd_t in "ESC.h".
+ *  @note                                       :       the command is sent HAL_ESC_DSHOT_CMD_REPEAT times 1 ms apart with the telemetry bit set
+ *                                                      and the function blocks for that time, only send commands while the motors are stopped.
+ *  \b PRE-CONDITION                            :       HAL_ESC_init is called and the protocol is DShot.
+ *  \b POST-CONDITION                           :       the speeds of all the motors are set to 0.
+ *  @return                                     :       HAL_ESC_ERR_NOT_SUPPORTED with PWM, else one of error states (refer to @HAL_ESC_ErrStates_t in "ESC.h")
+ *  @see                                        :       HAL_ESC_ErrStates_t HAL_ESC_update(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "ESC.h"
+ * 
+ * // reverse the top left motor for good
+ * HAL_ESC_sendCommand(HAL_ESC_MOTOR_TOP_LEFT, HAL_ESC_DSHOT_CMD_SPIN_DIRECTION_2);
+ * HAL_ESC_sendCommand(HAL_ESC_MOTOR_TOP_LEFT, HAL_ESC_DSHOT_CMD_SAVE_SETTINGS);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_ESC_ErrStates_t HAL_ESC_sendCommand(HAL_ESC_MotorNum_t arg_MotorNum_t, HAL_ESC_DShotCmd_t arg_Cmd_t);
+
+/**
+ *  \b function                                 :       uint16_t HAL_ESC_DShotPacket(uint16_t arg_u16Value, uint8_t arg_u8Telemetry);
+ *  \b Description                              :       this functions is used to build a DShot frame: 11 bits throttle or command, the telemetry request bit and
+ *                                                      the 4 bits CRC (XOR of the three nibbles of the first 12 bits, inverted with HAL_ESC_DSHOT_BIDIR).
+ *  @param  arg_u16Value [IN]                   :       throttle (HAL_ESC_DSHOT_THROTTLE_MIN to HAL_ESC_DSHOT_THROTTLE_MAX) or command (refer to @HAL_ESC_DShotCmd_t).
+ *  @param  arg_u8Telemetry [IN]                :       1 to request telemetry (must be set for the commands), else 0.
+ *  @note                                       :       the frame is sent from its most significant bit.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       the 16 bits frame.
+ *  @see                                        :       HAL_ESC_ErrStates_t HAL_ESC_update(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "ESC.h"
+ * 
+ * uint16_t frame = HAL_ESC_DShotPacket(1046, 0);   // 0x82C6 (0x82C9 with HAL_ESC_DSHOT_BIDIR)
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.3.0            </td><td> agent    </td><td> inverted CRC of bidirectional DShot </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+uint16_t HAL_ESC_DShotPacket(uint16_t arg_u16Value, uint8_t arg_u8Telemetry);
+
+/**
+ *  \b function                                 :       HAL_ESC_ErrStates_t HAL_ESC_getLatency(HAL_ESC_Latency_t* arg_pLatency_t);
+ *  \b Description                              :       this functions is used to get the command to pulse latency of the motor updates, the time from
+ *                                                      the start of HAL_ESC_update to the end of the pulses or frames carrying the new speeds.
+ *  @param  arg_pLatency_t [OUT]                :       where to store the latency, refer to @HAL_ESC_Latency_t in "ESC.h".
+ *  @note                                       :       the time taken by HAL_ESC_update is measured and the rest is computed from the counter of
+ *                                                      TIM4 when it returns, with PWM it includes the wait for the next 20 ms frame.
+ *  \b PRE-CONDITION                            :       HAL_ESC_init is called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_ESC_ErrStates_t in "ESC.h")
+ *  @see                                        :       HAL_ESC_ErrStates_t HAL_ESC_update(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "ESC.h"
+ * 
+ * HAL_ESC_Latency_t latency;
+ * HAL_ESC_getLatency(&latency);
+ * printf("%lu us (max %lu us)\r\n", latency.lastUS, latency.maxUS);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_ESC_ErrStates_t HAL_ESC_getLatency(HAL_ESC_Latency_t* arg_pLatency_t);
+
+/**
+ *  \b function                                 :       HAL_ESC_ErrStates_t HAL_ESC_getTelemetry(HAL_ESC_Telemetry_t* arg_pTelemetry_t);
+ *  \b Description                              :       this functions is used to get the eRPM of the four motors decoded from their bidirectional DShot replies.
+ *  @param  arg_pTelemetry_t [OUT]              :       where to store the telemetry, refer to @HAL_ESC_Telemetry_t in "ESC.h".
+ *  @note                                       :       every HAL_ESC_update decodes the reply of one motor to the frames of the previous update,
+ *                                                      the RPM of a motor is its eRPM divided by HAL_ESC_MOTOR_POLES / 2.
+ *                                                      the copy is taken in a critical section, it may be called from another task than HAL_ESC_update.
+ *  \b PRE-CONDITION                            :       HAL_ESC_init is called and HAL_ESC_DSHOT_BIDIR is enabled.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       HAL_ESC_ERR_NOT_SUPPORTED without HAL_ESC_DSHOT_BIDIR, else one of error states (refer to @HAL_ESC_ErrStates_t in "ESC.h")
+ *  @see                                        :       uint32_t HAL_ESC_DecodeERPM(const uint16_t* arg_pu16Edges, uint8_t arg_u8Count, uint16_t arg_u16BitTicks)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "ESC.h"
+ * 
+ * HAL_ESC_Telemetry_t telemetry;
+ * if(HAL_ESC_OK == HAL_ESC_getTelemetry(&telemetry) && (telemetry.valid & (1 << HAL_ESC_MOTOR_TOP_LEFT)))
+ * {
+ *  uint32_t rpm = telemetry.eRPM[HAL_ESC_MOTOR_TOP_LEFT] / (HAL_ESC_MOTOR_POLES / 2);
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_ESC_ErrStates_t HAL_ESC_getTelemetry(HAL_ESC_Telemetry_t* arg_pTelemetry_t);
+
+/**
+ *  \b function                                 :       uint32_t HAL_ESC_DecodeERPM(const uint16_t* arg_pu16Edges, uint8_t arg_u8Count, uint16_t arg_u16BitTicks);
+ *  \b Description                              :       this functions is used to decode a bidirectional DShot reply from the times of its edges: the
+ *                                                      distances between the edges give the 21 bits (a transition starts every 1 bit), the 20 bits
+ *                                                      after the start bit are GCR decoded to 16 bits and checked with their CRC, then the 12 bits
+ *                                                      period (3 bits shift, 9 bits micro seconds) is turned into eRPM.
+ *  @param  arg_pu16Edges [IN]                  :       times of the edges in timer ticks, the first one is the falling edge of the start bit.
+ *  @param  arg_u8Count [IN]                    :       number of edges.
+ *  @param  arg_u16BitTicks [IN]                :       timer ticks of one bit of the reply.
+ *  @note                                       :       the times may wrap around 16 bits, only their differences are used.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       the eRPM (0 if the motor is stopped) or HAL_ESC_ERPM_INVALID if the reply is corrupted.
+ *  @see                                        :       HAL_ESC_ErrStates_t HAL_ESC_getTelemetry(HAL_ESC_Telemetry_t* arg_pTelemetry_t)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "ESC.h"
+ * 
+ * uint32_t erpm = HAL_ESC_DecodeERPM(edges, count, MCAL_TIM4_CLOCK_HZ / 750000);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+uint32_t HAL_ESC_DecodeERPM(const uint16_t* arg_pu16Edges, uint8_t arg_u8Count, uint16_t arg_u16BitTicks);
+
 
 /*** End of File **************************************************************/
 #endif /*HAL_ESC_H_*/
\ No newline at end of file
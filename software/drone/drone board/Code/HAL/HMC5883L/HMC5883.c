@@ -39,6 +39,7 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    14/06/2023      1.0.0           Mohab Zaghloul                  file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           moved to the interrupt driven I2C driver.                       |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -59,7 +60,7 @@
 /**
  * 
  */
-#include "MCAL_wrapper.h"
+#include "MCAL_I2C.h"
 
 /**
  * 
@@ -86,35 +87,15 @@
 /******************************************************************************
  * Function Prototypes
  *******************************************************************************/
-void hmc5883l_write(uint8_t reg, uint8_t data);
-void hmc5883l_setptr(uint8_t reg);
-void mpu6050_write(uint8_t reg, uint8_t data);
+MCAL_I2C_ErrStat_t hmc5883l_write(uint8_t reg, uint8_t data);
 
 /******************************************************************************
  * Function Definitions
  *******************************************************************************/
 
-void hmc5883l_write(uint8_t reg, uint8_t data)
+MCAL_I2C_ErrStat_t hmc5883l_write(uint8_t reg, uint8_t data)
 {
-    I2C_start_transmission(HMC5883L_SLAVE_ADDRESS, MASTER_TRANSMIT_MODE);
-    I2C_write(reg);
-    I2C_write(data);
-    I2C_stop();
-}
-
-void hmc5883l_setptr(uint8_t reg)
-{
-    I2C_start_transmission(HMC5883L_SLAVE_ADDRESS, MASTER_TRANSMIT_MODE);
-    I2C_write(reg);
-    I2C_stop();
-}
-
-void mpu6050_write(uint8_t reg, uint8_t data)
-{
-    I2C_start_transmission(MPU6050_SLAVE_ADDRESS, MASTER_TRANSMIT_MODE);
-    I2C_write(reg);
-    I2C_write(data);
-    I2C_stop();
+    return MCAL_I2C_WriteReg(HMC5883L_SLAVE_ADDRESS, reg, data, MCAL_I2C_DEFAULT_TIMEOUT_MS);
 }
 
 /**
@@ -128,19 +109,19 @@ void hmc5883l_init()
     Register: USER_CTRL (0x6A)
     *  Disable the MPU6050 master mode. This is a prerequisite for the next step
     **/
-    mpu6050_write(MPU6050_REG_USER_CTRL, MPU6050_DISABLE_MASTER);
+    MCAL_I2C_WriteReg(MPU6050_SLAVE_ADDRESS, MPU6050_REG_USER_CTRL, MPU6050_DISABLE_MASTER, MCAL_I2C_DEFAULT_TIMEOUT_MS);
     /**
     Register: BYPASS_CTRL (0x37)
     *  Enables bypass mode. This connects the main I2C bus to the auxiliary one.
     **/
-    mpu6050_write(MPU6050_REG_BYPASS, MPU6050_ENABLE_BYPASS);
+    MCAL_I2C_WriteReg(MPU6050_SLAVE_ADDRESS, MPU6050_REG_BYPASS, MPU6050_ENABLE_BYPASS, MCAL_I2C_DEFAULT_TIMEOUT_MS);
     /**
     Register: PWR_MGMT_1 (0x6B = 107)
     *  Selects the clock source: 8MHz oscillator
     *  Disables the following bits: Reset, Sleep, Cycle
     *  Does not disable Temperature sensor.
     **/
-    mpu6050_write(MPU6050_REG_PWR_MGMT_1, 0);
+    MCAL_I2C_WriteReg(MPU6050_SLAVE_ADDRESS, MPU6050_REG_PWR_MGMT_1, 0, MCAL_I2C_DEFAULT_TIMEOUT_MS);
     #endif
 
     /**
@@ -169,14 +150,15 @@ void hmc5883l_read(hmc5883l_packet* data)
     /**
      * Registers: Magnetometer measurements (0x03 to 0x08)
     */
-    hmc5883l_setptr(HMC5883L_REG_DATA);
+    uint8_t buffer[HMC5883L_DATA_LEN];
 
-    // Get sensor readings
-    I2C_requestFrom(HMC5883L_SLAVE_ADDRESS, I2C_Rx_BUFFER_SIZE);
+    // Get sensor readings, the previous readings are kept if the bus failed
+    if(MCAL_I2C_STAT_OK != MCAL_I2C_ReadRegs(HMC5883L_SLAVE_ADDRESS, HMC5883L_REG_DATA, buffer, HMC5883L_DATA_LEN, MCAL_I2C_DEFAULT_TIMEOUT_MS))
+        return;
 
-    data->magnetometer_raw_x = (I2C_read()<<8 | I2C_read());
-    data->magnetometer_raw_z = (I2C_read()<<8 | I2C_read());
-    data->magnetometer_raw_y = (I2C_read()<<8 | I2C_read());
+    data->magnetometer_raw_x = (buffer[0]<<8 | buffer[1]);
+    data->magnetometer_raw_z = (buffer[2]<<8 | buffer[3]);
+    data->magnetometer_raw_y = (buffer[4]<<8 | buffer[5]);
 }
 
 
@@ -39,6 +39,7 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    14/06/2023      1.0.0           Mohab Zaghloul                  file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           moved to the interrupt driven I2C driver.                       |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -59,12 +60,8 @@
  * Preprocessor Constants
  *******************************************************************************/
 
-/* I2C master mode flag */
-#define MASTER_TRANSMIT_MODE 0
-#define MASTER_RECEIVER_MODE 1
-
-/* Receiver buffer size */
-#define I2C_Rx_BUFFER_SIZE   6
+/* number of bytes of one measurement (x, z, y) */
+#define HMC5883L_DATA_LEN        (6)
 
 /* HMC5883L Constants */
 #define HMC5883L_SLAVE_ADDRESS   (0x1E)
@@ -39,6 +39,13 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    12/06/2023      1.0.0           Mohab Zaghloul                  file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           added raw integer reads for the fixed point fusion.             |
+ * |    17/10/2026      1.2.0           agent                           added single transaction read of acc, temperature and gyro.     |
+ * |    17/10/2026      1.3.0           agent                           moved to the interrupt driven I2C driver, reads return a        |
+ * |                                                                    status.                                                         |
+ * |    17/10/2026      1.4.0           agent                           the INT pin pulses when a new sample is ready.                  |
+ * |    17/10/2026      1.5.0           agent                           added FIFO batch reads at 1 KHz with overflow detection and     |
+ * |                                                                    counters.                                                       |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -61,6 +68,11 @@
  */
 #include "MCAL_wrapper.h"
 
+/**
+ * 
+ */
+#include "MCAL_I2C.h"
+
 
 /******************************************************************************
  * Module Preprocessor Constants
@@ -80,35 +92,73 @@
  * Module Variable Definitions
  *******************************************************************************/
 
-/* Receiver buffer */
-uint8_t RxData[I2C_Rx_BUFFER_SIZE];
-
 /* Calibration */
 float roll_calibration = 0, pitch_calibration = 0, yaw_calibration = 0;
 
+/* Calibration in LSB, used by the raw reads */
+int16_t roll_calibration_raw = 0, pitch_calibration_raw = 0, yaw_calibration_raw = 0;
+
+/* FIFO counters */
+mpu6050_fifo_stats_t fifo_stats = {0};
+
+/* FIFO burst buffer, kept off the stack of the calling task */
+uint8_t fifo_data[MPU6050_FIFO_READ_MAX_FRAMES * MPU6050_FIFO_FRAME_LEN];
+
 /******************************************************************************
  * Function Prototypes
  *******************************************************************************/
-void mpu6050_setptr(uint8_t reg);
-void mpu6050_write(uint8_t reg, uint8_t data);
+MCAL_I2C_ErrStat_t mpu6050_write(uint8_t reg, uint8_t data);
+MCAL_I2C_ErrStat_t mpu6050_read_xyz(uint8_t reg, int16_t* x, int16_t* y, int16_t* z);
+MCAL_I2C_ErrStat_t mpu6050_read_imu_burst(mpu6050_imu_raw_t* imu);
 
 /******************************************************************************
  * Function Definitions
  *******************************************************************************/
 
-void mpu6050_setptr(uint8_t reg)
+MCAL_I2C_ErrStat_t mpu6050_write(uint8_t reg, uint8_t data)
 {
-    I2C_start_transmission(MPU6050_SLAVE_ADDRESS, MASTER_TRANSMIT_MODE);
-    I2C_write(reg);
-    I2C_stop();
+    return MCAL_I2C_WriteReg(MPU6050_SLAVE_ADDRESS, reg, data, MCAL_I2C_DEFAULT_TIMEOUT_MS);
 }
 
-void mpu6050_write(uint8_t reg, uint8_t data)
+MCAL_I2C_ErrStat_t mpu6050_read_xyz(uint8_t reg, int16_t* x, int16_t* y, int16_t* z)
 {
-    I2C_start_transmission(MPU6050_SLAVE_ADDRESS, MASTER_TRANSMIT_MODE);
-    I2C_write(reg);
-    I2C_write(data);
-    I2C_stop();
+    uint8_t data[MPU6050_XYZ_LEN];
+    MCAL_I2C_ErrStat_t status;
+
+    // Get sensor readings, the outputs are left untouched if the bus failed
+    status = MCAL_I2C_ReadRegs(MPU6050_SLAVE_ADDRESS, reg, data, MPU6050_XYZ_LEN, MCAL_I2C_DEFAULT_TIMEOUT_MS);
+    if(MCAL_I2C_STAT_OK != status)
+        return status;
+
+    *x = data[0]<<8 | data[1];
+    *y = data[2]<<8 | data[3];
+    *z = data[4]<<8 | data[5];
+
+    return status;
+}
+
+MCAL_I2C_ErrStat_t mpu6050_read_imu_burst(mpu6050_imu_raw_t* imu)
+{
+    uint8_t data[MPU6050_IMU_BURST_LEN];
+    MCAL_I2C_ErrStat_t status;
+
+    /**
+    * Registers: Accelerometer, Temperature and Gyroscope measurements (0x3B to 0x48 = 59 to 72)
+    * read with a repeated start so the sensor doesn't update the registers in between
+    */
+    status = MCAL_I2C_ReadRegs(MPU6050_SLAVE_ADDRESS, MPU6050_REG_ACCEL_OUT, data, MPU6050_IMU_BURST_LEN, MCAL_I2C_DEFAULT_TIMEOUT_MS);
+    if(MCAL_I2C_STAT_OK != status)
+        return status;
+
+    imu->x_acc = data[0]<<8 | data[1];
+    imu->y_acc = data[2]<<8 | data[3];
+    imu->z_acc = data[4]<<8 | data[5];
+    imu->temperature = data[6]<<8 | data[7];
+    imu->roll_rate = data[8]<<8 | data[9];
+    imu->pitch_rate = data[10]<<8 | data[11];
+    imu->yaw_rate = data[12]<<8 | data[13];
+
+    return status;
 }
 
 /**
@@ -117,8 +167,8 @@ void mpu6050_write(uint8_t reg, uint8_t data)
 void mpu6050_gyro_setup()
 {
     int16_t calibration_iter = CALIBRATION_ITERATIONS;
-    float roll_rate, pitch_rate, yaw_rate;
-    float roll_local_calib = 0, pitch_local_calib = 0, yaw_local_calib = 0;
+    int16_t roll_rate = 0, pitch_rate = 0, yaw_rate = 0;
+    int32_t roll_local_calib = 0, pitch_local_calib = 0, yaw_local_calib = 0;
 
     /** 
     Register: PWR_MGMT_1 (0x6B = 107)
@@ -145,15 +195,20 @@ void mpu6050_gyro_setup()
      * Make the sensor aware of its physical reference
     */
     while(calibration_iter--){
-        mpu6050_gyro_read(&roll_rate, &pitch_rate, &yaw_rate);
+        mpu6050_read_xyz(MPU6050_REG_GYRO_OUT, &roll_rate, &pitch_rate, &yaw_rate);
         roll_local_calib += roll_rate;
         pitch_local_calib += pitch_rate;
         yaw_local_calib += yaw_rate;
         MCAL_WRAPPER_DelayUS(1000);
     }
-    roll_calibration = roll_local_calib / CALIBRATION_ITERATIONS;
-    pitch_calibration = pitch_local_calib / CALIBRATION_ITERATIONS;
-    yaw_calibration = yaw_local_calib / CALIBRATION_ITERATIONS;
+    roll_calibration = (float)roll_local_calib / (CALIBRATION_ITERATIONS * MPU6050_LSB_DPS);
+    pitch_calibration = (float)pitch_local_calib / (CALIBRATION_ITERATIONS * MPU6050_LSB_DPS);
+    yaw_calibration = (float)yaw_local_calib / (CALIBRATION_ITERATIONS * MPU6050_LSB_DPS);
+
+    // rounded average in LSB
+    roll_calibration_raw = (roll_local_calib + (roll_local_calib >= 0 ? CALIBRATION_ITERATIONS : -CALIBRATION_ITERATIONS) / 2) / CALIBRATION_ITERATIONS;
+    pitch_calibration_raw = (pitch_local_calib + (pitch_local_calib >= 0 ? CALIBRATION_ITERATIONS : -CALIBRATION_ITERATIONS) / 2) / CALIBRATION_ITERATIONS;
+    yaw_calibration_raw = (yaw_local_calib + (yaw_local_calib >= 0 ? CALIBRATION_ITERATIONS : -CALIBRATION_ITERATIONS) / 2) / CALIBRATION_ITERATIONS;
 }
 
 /**
@@ -189,6 +244,27 @@ void mpu6050_init()
 {
     mpu6050_gyro_setup();
     mpu6050_accel_setup();
+
+    /**
+    Register: SMPLRT_DIV (0x19 = 25)
+    * Sets the sample rate to 1KHz / (1 + MPU6050_SAMPLE_RATE_DIV)
+    */
+    mpu6050_write(MPU6050_REG_SMPLRT_DIV, MPU6050_SAMPLE_RATE_DIV);
+#if MPU6050_FIFO_BATCH
+    /**
+    Register: FIFO_EN (0x23 = 35)
+    * Pushes the accelerometer and the gyroscope (not the temperature) into the FIFO on every sample
+    */
+    mpu6050_write(MPU6050_REG_FIFO_EN, MPU6050_FIFO_EN_ACC_GYRO);
+    mpu6050_fifo_reset();
+#else
+    /**
+    Register: INT_ENABLE (0x38 = 56)
+    * Pulses the INT pin every time a new sample is written to the data registers,
+    * INT_PIN_CFG (0x37) is kept at active high, push pull, 50us pulse
+    */
+    mpu6050_write(MPU6050_REG_INT_ENABLE, MPU6050_DATA_RDY_EN);
+#endif
 }
 
 /**
@@ -201,14 +277,7 @@ void mpu6050_accel_read(float* x_acc, float* y_acc, float* z_acc)
     /**
     * Registers: Accelerometer measurements (0x3B to 0x40 = 59 to 64)
     */
-    mpu6050_setptr(MPU6050_REG_ACCEL_OUT);
-
-    // Get sensor readings
-    I2C_requestFrom(MPU6050_SLAVE_ADDRESS, I2C_Rx_BUFFER_SIZE);
-
-    x_reg= I2C_read()<<8 | I2C_read();
-    y_reg= I2C_read()<<8 | I2C_read();
-    z_reg= I2C_read()<<8 | I2C_read();
+    mpu6050_read_xyz(MPU6050_REG_ACCEL_OUT, &x_reg, &y_reg, &z_reg);
 
     *x_acc=(float)x_reg/MPU6050_LSB_G;
     *y_acc=(float)y_reg/MPU6050_LSB_G;
@@ -224,14 +293,7 @@ void mpu6050_gyro_read(float* roll_rate, float* pitch_rate, float* yaw_rate) {
     /**
     * Registers: Gyroscope measurements (0x43 to 0x48 = 67 to 72)
     */
-    mpu6050_setptr(MPU6050_REG_GYRO_OUT);
-
-    // Get sensor readings
-    I2C_requestFrom(MPU6050_SLAVE_ADDRESS, I2C_Rx_BUFFER_SIZE);
-
-    GyroX= I2C_read()<<8 | I2C_read();
-    GyroY= I2C_read()<<8 | I2C_read();
-    GyroZ= I2C_read()<<8 | I2C_read();
+    mpu6050_read_xyz(MPU6050_REG_GYRO_OUT, &GyroX, &GyroY, &GyroZ);
 
     *roll_rate=(float)GyroX/MPU6050_LSB_DPS - roll_calibration;
     *pitch_rate=(float)GyroY/MPU6050_LSB_DPS - pitch_calibration;
@@ -239,4 +301,173 @@ void mpu6050_gyro_read(float* roll_rate, float* pitch_rate, float* yaw_rate) {
 
 }
 
+/**
+ * 
+ */
+void mpu6050_accel_read_raw(int16_t* x_acc, int16_t* y_acc, int16_t* z_acc)
+{
+    /**
+    * Registers: Accelerometer measurements (0x3B to 0x40 = 59 to 64)
+    */
+    mpu6050_read_xyz(MPU6050_REG_ACCEL_OUT, x_acc, y_acc, z_acc);
+}
+
+/**
+ * 
+ */
+void mpu6050_gyro_read_raw(int16_t* roll_rate, int16_t* pitch_rate, int16_t* yaw_rate)
+{
+    int16_t GyroX, GyroY, GyroZ;
+
+    /**
+    * Registers: Gyroscope measurements (0x43 to 0x48 = 67 to 72)
+    */
+    mpu6050_read_xyz(MPU6050_REG_GYRO_OUT, &GyroX, &GyroY, &GyroZ);
+
+    *roll_rate = GyroX - roll_calibration_raw;
+    *pitch_rate = GyroY - pitch_calibration_raw;
+    *yaw_rate = GyroZ - yaw_calibration_raw;
+}
+
+/**
+ * 
+ */
+MCAL_I2C_ErrStat_t mpu6050_imu_read(mpu6050_imu_t* imu)
+{
+    mpu6050_imu_raw_t raw;
+    MCAL_I2C_ErrStat_t status;
+
+    status = mpu6050_read_imu_burst(&raw);
+    if(MCAL_I2C_STAT_OK != status)
+        return status;
+
+    imu->acc.x = (float)raw.x_acc/MPU6050_LSB_G;
+    imu->acc.y = (float)raw.y_acc/MPU6050_LSB_G;
+    imu->acc.z = (float)raw.z_acc/MPU6050_LSB_G;
+
+    imu->temperature = (float)raw.temperature/MPU6050_LSB_DEG_C + MPU6050_TEMP_OFFSET;
+
+    imu->gyro.roll = (float)raw.roll_rate/MPU6050_LSB_DPS - roll_calibration;
+    imu->gyro.pitch = (float)raw.pitch_rate/MPU6050_LSB_DPS - pitch_calibration;
+    imu->gyro.yaw = (float)raw.yaw_rate/MPU6050_LSB_DPS - yaw_calibration;
+
+    return status;
+}
+
+/**
+ * 
+ */
+MCAL_I2C_ErrStat_t mpu6050_imu_read_raw(mpu6050_imu_raw_t* imu)
+{
+    mpu6050_imu_raw_t raw;
+    MCAL_I2C_ErrStat_t status;
+
+    status = mpu6050_read_imu_burst(&raw);
+    if(MCAL_I2C_STAT_OK != status)
+        return status;
+
+    *imu = raw;
+
+    imu->roll_rate -= roll_calibration_raw;
+    imu->pitch_rate -= pitch_calibration_raw;
+    imu->yaw_rate -= yaw_calibration_raw;
+
+    return status;
+}
+
+/**
+ * 
+ */
+MCAL_I2C_ErrStat_t mpu6050_fifo_reset()
+{
+    MCAL_I2C_ErrStat_t status;
+
+    /**
+    Register: USER_CTRL (0x6A = 106)
+    * The FIFO is reset while it is disabled then enabled again, the reset bit clears itself
+    */
+    status = mpu6050_write(MPU6050_REG_USER_CTRL, MPU6050_USER_FIFO_RESET);
+    if(MCAL_I2C_STAT_OK != status)
+        return status;
+
+    return mpu6050_write(MPU6050_REG_USER_CTRL, MPU6050_USER_FIFO_EN);
+}
+
+/**
+ * 
+ */
+MCAL_I2C_ErrStat_t mpu6050_fifo_read_raw(mpu6050_fifo_frame_t* frames, uint8_t max_frames, uint8_t* count, uint8_t* overflow)
+{
+    uint8_t* frame;
+    uint16_t level;
+    uint8_t i;
+    MCAL_I2C_ErrStat_t status;
+
+    /**
+    * Registers: FIFO_COUNT (0x72 to 0x73 = 114 to 115), number of bytes waiting in the FIFO
+    */
+    status = MCAL_I2C_ReadRegs(MPU6050_SLAVE_ADDRESS, MPU6050_REG_FIFO_COUNT, fifo_data, 2, MCAL_I2C_DEFAULT_TIMEOUT_MS);
+    if(MCAL_I2C_STAT_OK != status)
+        return status;
+
+    level = (uint16_t)(fifo_data[0]<<8 | fifo_data[1]);
+
+    // a full FIFO drops its oldest bytes and 1024 isn't a multiple of the frame, the content can't be trusted
+    if(level > MPU6050_FIFO_MAX_FRAMES * MPU6050_FIFO_FRAME_LEN)
+    {
+        status = mpu6050_fifo_reset();
+        if(MCAL_I2C_STAT_OK != status)
+            return status;
+
+        fifo_stats.overflows++;
+        fifo_stats.dropped += level / MPU6050_FIFO_FRAME_LEN;
+        *count = 0;
+        *overflow = 1;
+        return status;
+    }
+
+    level /= MPU6050_FIFO_FRAME_LEN;
+    if(level > fifo_stats.max_level)
+        fifo_stats.max_level = level;
+
+    if(max_frames > MPU6050_FIFO_READ_MAX_FRAMES)
+        max_frames = MPU6050_FIFO_READ_MAX_FRAMES;
+    if(level > max_frames)
+        level = max_frames;
+
+    /**
+    * Register: FIFO_R_W (0x74 = 116), the address doesn't advance so a burst pops consecutive bytes
+    */
+    if(0 != level)
+    {
+        status = MCAL_I2C_ReadRegs(MPU6050_SLAVE_ADDRESS, MPU6050_REG_FIFO_R_W, fifo_data, (uint8_t)(level * MPU6050_FIFO_FRAME_LEN), MCAL_I2C_DEFAULT_TIMEOUT_MS);
+        if(MCAL_I2C_STAT_OK != status)
+            return status;
+    }
+
+    for(i = 0, frame = fifo_data; i < level; i++, frame += MPU6050_FIFO_FRAME_LEN)
+    {
+        frames[i].x_acc = frame[0]<<8 | frame[1];
+        frames[i].y_acc = frame[2]<<8 | frame[3];
+        frames[i].z_acc = frame[4]<<8 | frame[5];
+        frames[i].roll_rate = (int16_t)(frame[6]<<8 | frame[7]) - roll_calibration_raw;
+        frames[i].pitch_rate = (int16_t)(frame[8]<<8 | frame[9]) - pitch_calibration_raw;
+        frames[i].yaw_rate = (int16_t)(frame[10]<<8 | frame[11]) - yaw_calibration_raw;
+    }
+
+    fifo_stats.reads++;
+    fifo_stats.frames += level;
+    *count = (uint8_t)level;
+    *overflow = 0;
+
+    return status;
+}
+
+/**
+ * 
+ */
+void mpu6050_fifo_get_stats(mpu6050_fifo_stats_t* stats)
+{
+    *stats = fifo_stats;
+}
 /*************** END OF FUNCTIONS ***************************************************************************/
@@ -39,6 +39,13 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    12/06/2023      1.0.0           Mohab Zaghloul                  file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           added raw integer reads for the fixed point fusion.             |
+ * |    17/10/2026      1.2.0           agent                           added single transaction read of acc, temperature and gyro.     |
+ * |    17/10/2026      1.3.0           agent                           moved to the interrupt driven I2C driver, reads return a        |
+ * |                                                                    status.                                                         |
+ * |    17/10/2026      1.4.0           agent                           the INT pin pulses when a new sample is ready.                  |
+ * |    17/10/2026      1.5.0           agent                           added FIFO batch reads at 1 KHz with overflow detection and     |
+ * |                                                                    counters.                                                       |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -51,22 +58,16 @@
  *******************************************************************************/
 
 #include "stdint.h"
+#include "MCAL_I2C.h"
 
 /******************************************************************************
  * Preprocessor Constants
  *******************************************************************************/
 
-/* Receiver buffer size */
-#define I2C_Rx_BUFFER_SIZE   6
-
 /******************************************************************************
  * Configuration Constants
  *******************************************************************************/
 
-/* I2C master mode flag */
-#define MASTER_TRANSMIT_MODE 0
-#define MASTER_RECEIVER_MODE 1
-
 /* MPU6050 Constants */
 #define MPU6050_SLAVE_ADDRESS    (0x68)
 #define MPU6050_REG_PWR_MGMT_1   (0x6B)
@@ -77,6 +78,48 @@
 #define MPU6050_REG_ACCEL_CONFIG (0x1C)
 #define MPU6050_REG_ACCEL_OUT    (0x3B)
 #define MPU6050_LSB_G            (4096)
+#define MPU6050_REG_TEMP_OUT     (0x41)
+#define MPU6050_LSB_DEG_C        (340.0)
+#define MPU6050_TEMP_OFFSET      (36.53)
+#define MPU6050_REG_SMPLRT_DIV   (0x19)
+#define MPU6050_REG_INT_ENABLE   (0x38)
+#define MPU6050_DATA_RDY_EN      (0x01)
+#define MPU6050_REG_FIFO_EN      (0x23)
+#define MPU6050_FIFO_EN_ACC_GYRO (0x78)
+#define MPU6050_REG_USER_CTRL    (0x6A)
+#define MPU6050_USER_FIFO_EN     (0x40)
+#define MPU6050_USER_FIFO_RESET  (0x04)
+#define MPU6050_REG_FIFO_COUNT   (0x72)
+#define MPU6050_REG_FIFO_R_W     (0x74)
+
+/* 1 to sample at 1 KHz into the FIFO of the sensor and read it in batches, 0 to read the data registers once per sample */
+#define MPU6050_FIFO_BATCH       (1)
+
+/* sample rate = 1 KHz (gyroscope output rate with the DLPF enabled) / (1 + MPU6050_SAMPLE_RATE_DIV) */
+#if MPU6050_FIFO_BATCH
+#define MPU6050_SAMPLE_RATE_DIV  (0)
+#else
+#define MPU6050_SAMPLE_RATE_DIV  (6)
+#endif
+
+/* time between two data ready pulses in micro seconds */
+#define MPU6050_SAMPLE_PERIOD_US (1000 * (1 + MPU6050_SAMPLE_RATE_DIV))
+
+/* number of bytes of one accelerometer or gyroscope measurement (x, y, z) */
+#define MPU6050_XYZ_LEN          (6)
+
+/* number of bytes from ACCEL_XOUT_H to GYRO_ZOUT_L (accel, temperature, gyro) */
+#define MPU6050_IMU_BURST_LEN    (14)
+
+/* size of the FIFO and of one sample in it (accel then gyro, the temperature isn't pushed) in bytes */
+#define MPU6050_FIFO_SIZE        (1024)
+#define MPU6050_FIFO_FRAME_LEN   (12)
+
+/* number of whole samples the FIFO holds, one more sample overflows it */
+#define MPU6050_FIFO_MAX_FRAMES  (MPU6050_FIFO_SIZE / MPU6050_FIFO_FRAME_LEN)
+
+/* number of samples that fit in one I2C transaction (8 bits length) */
+#define MPU6050_FIFO_READ_MAX_FRAMES (255 / MPU6050_FIFO_FRAME_LEN)
 
 /******************************************************************************
  * Macros
@@ -100,13 +143,48 @@ typedef struct
     float yaw;
 } mpu6050_gyro_t;
 
+typedef struct
+{
+    mpu6050_acc_t acc;
+    mpu6050_gyro_t gyro;
+    float temperature;
+} mpu6050_imu_t;
+
+typedef struct
+{
+    int16_t x_acc;
+    int16_t y_acc;
+    int16_t z_acc;
+    int16_t temperature;
+    int16_t roll_rate;
+    int16_t pitch_rate;
+    int16_t yaw_rate;
+} mpu6050_imu_raw_t;
+
+typedef struct
+{
+    int16_t x_acc;
+    int16_t y_acc;
+    int16_t z_acc;
+    int16_t roll_rate;
+    int16_t pitch_rate;
+    int16_t yaw_rate;
+} mpu6050_fifo_frame_t;
+
+typedef struct
+{
+    uint32_t reads;         /* number of FIFO bursts */
+    uint32_t frames;        /* number of samples read from the FIFO */
+    uint32_t overflows;     /* number of times the FIFO was found full and reset */
+    uint32_t dropped;       /* number of samples thrown away by the resets (the overwritten ones aren't known) */
+    uint16_t max_level;     /* highest number of samples found waiting in the FIFO */
+} mpu6050_fifo_stats_t;
+
 
 /******************************************************************************
  * Variables
  *******************************************************************************/
 
-/* Receiver buffer */
-extern uint8_t RxData[I2C_Rx_BUFFER_SIZE];
 
 /******************************************************************************
  * Function Prototypes
@@ -115,6 +193,8 @@ extern uint8_t RxData[I2C_Rx_BUFFER_SIZE];
 /**
  * Initializes the MPU6050 gyroscope and accelerometer sensor. This function configures the sensor with default
  * settings for measurement. It must be called before any other operations are performed on the sensor.
+ * The sample rate is set to 1KHz / (1 + MPU6050_SAMPLE_RATE_DIV), when MPU6050_FIFO_BATCH is enabled the samples are
+ * pushed into the FIFO of the sensor, otherwise the INT pin pulses on every new sample.
  *
  * @note This function should be called only once at the start of the program.
  *
@@ -150,6 +230,96 @@ void mpu6050_gyro_read(float* roll_rate, float* pitch_rate, float* yaw_rate);
  */
 void mpu6050_accel_read(float* x_acc, float* y_acc, float* z_acc);
 
+/**
+ * Reads the gyroscope measurements from the MPU6050 sensor in LSB (MPU6050_LSB_DPS LSB = 1 deg/s)
+ * with the calibration offset already subtracted, no floating point operation is involved.
+ *
+ * @param roll_rate [OUT] Pointer to an int16_t where the roll rate will be stored.
+ * @param pitch_rate [OUT] Pointer to an int16_t where the pitch rate will be stored.
+ * @param yaw_rate [OUT] Pointer to an int16_t where the yaw rate will be stored.
+ *
+ * @note mpu6050_init must be called once in the program before using this function.
+ *
+ * @return void.
+ */
+void mpu6050_gyro_read_raw(int16_t* roll_rate, int16_t* pitch_rate, int16_t* yaw_rate);
+
+/**
+ * Reads the accelerometer measurements from the MPU6050 sensor in LSB (MPU6050_LSB_G LSB = 1 g),
+ * no floating point operation is involved.
+ *
+ * @param x_acc [OUT] Pointer to an int16_t where the acceleration on the X-axis will be stored.
+ * @param y_acc [OUT] Pointer to an int16_t where the acceleration on the Y-axis will be stored.
+ * @param z_acc [OUT] Pointer to an int16_t where the acceleration on the Z-axis will be stored.
+ *
+ * @note mpu6050_init must be called once in the program before using this function.
+ *
+ * @return void.
+ */
+void mpu6050_accel_read_raw(int16_t* x_acc, int16_t* y_acc, int16_t* z_acc);
+
+/**
+ * Reads the accelerometer, the die temperature and the gyroscope measurements from the MPU6050 sensor in a single
+ * I2C transaction (registers 0x3B to 0x48), so all of them belong to the same sample.
+ *
+ * @param imu [OUT] Pointer to the struct where the acceleration (g), the temperature (Degree Celsius)
+ *                  and the rates (deg/s, calibration offset subtracted) will be stored.
+ *
+ * @note mpu6050_init must be called once in the program before using this function.
+ *       imu is left untouched if the I2C transaction fails.
+ *
+ * @return MCAL_I2C_STAT_OK on success, otherwise the error of the I2C transaction.
+ */
+MCAL_I2C_ErrStat_t mpu6050_imu_read(mpu6050_imu_t* imu);
+
+/**
+ * Same as mpu6050_imu_read but the measurements are kept in LSB (MPU6050_LSB_G, MPU6050_LSB_DPS and MPU6050_LSB_DEG_C),
+ * the gyroscope calibration offset is already subtracted, no floating point operation is involved.
+ *
+ * @param imu [OUT] Pointer to the struct where the raw measurements will be stored.
+ *
+ * @note mpu6050_init must be called once in the program before using this function.
+ *       imu is left untouched if the I2C transaction fails.
+ *
+ * @return MCAL_I2C_STAT_OK on success, otherwise the error of the I2C transaction.
+ */
+MCAL_I2C_ErrStat_t mpu6050_imu_read_raw(mpu6050_imu_raw_t* imu);
+
+/**
+ * Reads the samples waiting in the FIFO of the MPU6050 (oldest first) in one I2C burst, the measurements are kept in LSB
+ * with the gyroscope calibration offset already subtracted. If the FIFO is found full it is reset as the frames
+ * aren't aligned any more once the sensor starts overwriting them, no sample is returned and overflow is set.
+ *
+ * @param frames [OUT] Pointer to the array where the samples will be stored.
+ * @param max_frames [IN] size of frames, at most MPU6050_FIFO_READ_MAX_FRAMES samples are read, the rest is left in the FIFO.
+ * @param count [OUT] Pointer to where the number of samples stored in frames will be written.
+ * @param overflow [OUT] Pointer to where 1 is written if the FIFO overflowed (0 otherwise).
+ *
+ * @note mpu6050_init must be called once in the program with MPU6050_FIFO_BATCH enabled before using this function.
+ *       the outputs are left untouched if an I2C transaction fails.
+ *
+ * @return MCAL_I2C_STAT_OK on success, otherwise the error of the I2C transaction.
+ */
+MCAL_I2C_ErrStat_t mpu6050_fifo_read_raw(mpu6050_fifo_frame_t* frames, uint8_t max_frames, uint8_t* count, uint8_t* overflow);
+
+/**
+ * Empties the FIFO of the MPU6050 and starts filling it again.
+ *
+ * @note mpu6050_init must be called once in the program before using this function.
+ *
+ * @return MCAL_I2C_STAT_OK on success, otherwise the error of the I2C transaction.
+ */
+MCAL_I2C_ErrStat_t mpu6050_fifo_reset();
+
+/**
+ * Copies the counters of the FIFO reads since boot.
+ *
+ * @param stats [OUT] Pointer to the struct where the counters will be stored.
+ *
+ * @return void.
+ */
+void mpu6050_fifo_get_stats(mpu6050_fifo_stats_t* stats);
+
 
 /*** End of File **************************************************************/
 #endif /*HAL_MPU6050_H_*/
@@ -39,6 +39,26 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    12/06/2023      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           added raw reads for acc, gyro and magnetometer.                 |
+ * |    17/10/2026      1.2.0           agent                           added 'HAL_WRAPPER_ReadImu' and 'HAL_WRAPPER_ReadImuRaw'.       |
+ * |    17/10/2026      1.3.0           agent                           IMU reads return 'HAL_WRAPPER_STAT_SENSOR_ERR' if the I2C       |
+ * |                                                                    transaction fails.                                              |
+ * |    17/10/2026      1.4.0           agent                           added 'HAL_WRAPPER_WaitImuDataReady' and                        |
+ * |                                                                    'HAL_WRAPPER_GetImuSampleJitter'.                               |
+ * |    17/10/2026      1.5.0           agent                           added 'HAL_WRAPPER_ReadImuBatch' and                            |
+ * |                                                                    'HAL_WRAPPER_GetImuFifoStats'.                                  |
+ * |    17/10/2026      1.6.0           agent                           added 'HAL_WRAPPER_ReadBarometer'.                              |
+ * |    17/10/2026      1.7.0           agent                           replaced the UART4 receive callback functions and               |
+ * |                                                                    'HAL_WRAPPER_GetCommMessage' by 'HAL_WRAPPER_SetAppCommRecTask' |
+ * |                                                                    and 'HAL_WRAPPER_GetCommFrame'.                                 |
+ * |    17/10/2026      1.8.0           agent                           replaced 'HAL_WRAPPER_SendCommMessage' by the DMA frame         |
+ * |                                                                    transmitter 'HAL_WRAPPER_SendCommFrame' and added               |
+ * |                                                                    'HAL_WRAPPER_GetCommTxStats'.                                   |
+ * |    17/10/2026      1.9.0           agent                           'HAL_WRAPPER_SetESCSpeeds' sends the four speeds at once with   |
+ * |                                                                    'HAL_ESC_update'.                                               |
+ * |    17/10/2026      1.10.0          agent                           added 'HAL_WRAPPER_GetMotorRPM'.                                |
+ * |    17/10/2026      1.11.0          agent                           added 'HAL_WRAPPER_StartControlTimer' and                       |
+ * |                                                                    'HAL_WRAPPER_WaitControlTick'.                                  |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
  
@@ -57,6 +77,16 @@
 */
 #include "MCAL_wrapper.h"
 
+/**
+ * @reason: contains the DMA driven receiver of the comm port
+ */
+#include "MCAL_UART.h"
+
+/**
+ * @reason: contains the periodic tick of the control loop
+ */
+#include "MCAL_TIM3.h"
+
 /**
  * @reason: contains common definitions
  */
@@ -92,6 +122,11 @@
  */
 #include "HC_SR04.h"
 
+/**
+ * @reason: contains the time stamp of the RTOS
+ */
+#include "Service_RTOS_wrapper.h"
+
 /******************************************************************************
  * Module Preprocessor Constants
  *******************************************************************************/
@@ -120,8 +155,38 @@
 HAL_ADXL345_Acc_t global_ADXL345ACC_t = {0};
 mpu6050_acc_t global_MPU6050ACC_t = {0};
 mpu6050_gyro_t global_MPU6050GYRO_t = {0};
+mpu6050_imu_t global_MPU6050IMU_t = {0};
 hmc5883l_packet global_HMC5883MAGNET_t = {0};
 
+/**
+ * @brief: statistics of the sample period, the sums are kept apart to compute the averages on request
+ */
+HAL_WRAPPER_SampleJitter_t global_ImuSampleJitter_t = {0};
+uint64_t global_u64ImuPeriodSumUS = 0;
+uint64_t global_u64ImuJitterSumUS = 0;
+
+/**
+ * @brief: time of the last wake up on a data ready pulse, 0 when the next period can't be measured
+ */
+uint32_t global_u32ImuLastWakeUS = 0;
+
+/**
+ * @brief: samples of the last FIFO burst as read from the MPU6050
+ */
+mpu6050_fifo_frame_t global_MPU6050FIFO_t[HAL_WRAPPER_IMU_BATCH_MAX] = {0};
+
+/**
+ * @brief: sample period of the MPU6050 measured against the clock of the MCU in 1/256 micro seconds, the internal
+ *         oscillator of the sensor is off by a few percent
+ */
+uint32_t global_u32ImuPeriodQ8 = (uint32_t)HAL_WRAPPER_IMU_SAMPLE_PERIOD_US << 8;
+
+/**
+ * @brief: time of the last read that emptied the FIFO, only valid if 'global_u8ImuLastReadValid' is set
+ */
+uint32_t global_u32ImuLastReadUS = 0;
+uint8_t global_u8ImuLastReadValid = 0;
+
 /******************************************************************************
  * Function Prototypes
  *******************************************************************************/
@@ -218,6 +283,135 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadMagnet(HAL_WRAPPER_Magnet_t *arg_pMagnet)
 
 }
 
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadAccRaw(HAL_WRAPPER_AccRaw_t *arg_pAcc)
+{
+    if(NULL == arg_pAcc)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+
+    // read acceleration from MPU6050
+    mpu6050_accel_read_raw(&arg_pAcc->x, &arg_pAcc->y, &arg_pAcc->z);
+
+    // account for the placement of the IC on the PCB
+    arg_pAcc->x = -arg_pAcc->x;
+    arg_pAcc->y = -arg_pAcc->y;
+
+    return HAL_WRAPPER_STAT_OK;
+}
+
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadGyroRaw(HAL_WRAPPER_GyroRaw_t *arg_pGyro)
+{
+    if(NULL == arg_pGyro)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+
+    // read gyroscope from mpu6050
+    mpu6050_gyro_read_raw(&arg_pGyro->roll, &arg_pGyro->pitch, &arg_pGyro->yaw);
+
+    // account for the placement of the IC on the PCB
+    arg_pGyro->roll = -arg_pGyro->roll;
+    arg_pGyro->pitch = -arg_pGyro->pitch;
+
+    return HAL_WRAPPER_STAT_OK;
+}
+
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadMagnetRaw(HAL_WRAPPER_MagnetRaw_t *arg_pMagnet)
+{
+    int16_t temp = 0;
+
+    if(NULL == arg_pMagnet)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+
+    // read magnetometer from hmc5883l
+    hmc5883l_read(&global_HMC5883MAGNET_t);
+
+    // account for the placement of the IC on the PCB
+    temp = -global_HMC5883MAGNET_t.magnetometer_raw_x;
+    global_HMC5883MAGNET_t.magnetometer_raw_x = -global_HMC5883MAGNET_t.magnetometer_raw_y;
+    global_HMC5883MAGNET_t.magnetometer_raw_y = temp;
+
+    // remove the hard iron offsets, the scale is common to all axes so it doesn't affect the heading
+    arg_pMagnet->x = global_HMC5883MAGNET_t.magnetometer_raw_x - (int16_t)X_OFFSET;
+    arg_pMagnet->y = global_HMC5883MAGNET_t.magnetometer_raw_y - (int16_t)Y_OFFSET;
+    arg_pMagnet->z = global_HMC5883MAGNET_t.magnetometer_raw_z - (int16_t)Z_OFFSET;
+
+    return HAL_WRAPPER_STAT_OK;
+}
+
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadImu(HAL_WRAPPER_Imu_t *arg_pImu)
+{
+    uint32_t local_u32Timestamp = 0;
+
+    if(NULL == arg_pImu)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+
+    // the sensor latches its registers at the start of the burst
+    SERVICE_RTOS_CurrentUSTime(&local_u32Timestamp);
+
+    // read acceleration, temperature and gyroscope from mpu6050
+    if(MCAL_I2C_STAT_OK != mpu6050_imu_read(&global_MPU6050IMU_t))
+        return HAL_WRAPPER_STAT_SENSOR_ERR;
+
+    arg_pImu->timestamp = local_u32Timestamp;
+
+    // account for the placement of the IC on the PCB
+    arg_pImu->acc.x = -global_MPU6050IMU_t.acc.x;
+    arg_pImu->acc.y = -global_MPU6050IMU_t.acc.y;
+    arg_pImu->acc.z = global_MPU6050IMU_t.acc.z;
+
+    arg_pImu->gyro.roll = -global_MPU6050IMU_t.gyro.roll;
+    arg_pImu->gyro.pitch = -global_MPU6050IMU_t.gyro.pitch;
+    arg_pImu->gyro.yaw = global_MPU6050IMU_t.gyro.yaw;
+
+    arg_pImu->temperature = global_MPU6050IMU_t.temperature;
+
+    return HAL_WRAPPER_STAT_OK;
+}
+
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadImuRaw(HAL_WRAPPER_ImuRaw_t *arg_pImu)
+{
+    mpu6050_imu_raw_t local_raw_t;
+    uint32_t local_u32Timestamp = 0;
+
+    if(NULL == arg_pImu)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+
+    // the sensor latches its registers at the start of the burst
+    SERVICE_RTOS_CurrentUSTime(&local_u32Timestamp);
+
+    // read acceleration, temperature and gyroscope from mpu6050
+    if(MCAL_I2C_STAT_OK != mpu6050_imu_read_raw(&local_raw_t))
+        return HAL_WRAPPER_STAT_SENSOR_ERR;
+
+    arg_pImu->timestamp = local_u32Timestamp;
+
+    // account for the placement of the IC on the PCB
+    arg_pImu->acc.x = -local_raw_t.x_acc;
+    arg_pImu->acc.y = -local_raw_t.y_acc;
+    arg_pImu->acc.z = local_raw_t.z_acc;
+
+    arg_pImu->gyro.roll = -local_raw_t.roll_rate;
+    arg_pImu->gyro.pitch = -local_raw_t.pitch_rate;
+    arg_pImu->gyro.yaw = local_raw_t.yaw_rate;
+
+    arg_pImu->temperature = local_raw_t.temperature;
+
+    return HAL_WRAPPER_STAT_OK;
+}
+
 /**
  * 
  */
@@ -234,16 +428,31 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetESCSpeeds(HAL_WRAPPER_MotorSpeeds_t *arg_pM
     HAL_ESC_setSpeed(HAL_ESC_MOTOR_BOTTOM_LEFT, arg_pMotorsSpeed->bottomLeftSpeed);
     HAL_ESC_setSpeed(HAL_ESC_MOTOR_BOTTOM_RIGHT, arg_pMotorsSpeed->bottomRightSpeed);
 
+    // send the four speeds at once (DShot frames)
+    HAL_ESC_update();
+
     return HAL_WRAPPER_STAT_OK;
 }
 
 /**
  * 
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_DisableEnableAppCommRecCallBack(LIB_CONSTANTS_DriverStates_t arg_Enable_Disable_t)
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetMotorRPM(HAL_WRAPPER_MotorRPM_t *arg_pRPM)
 {
-    // configure interrupt
-    MCAL_WRAPPER_UART4RecITConfig(arg_Enable_Disable_t);
+    HAL_ESC_Telemetry_t local_telemetry_t;
+    uint8_t i = 0;
+
+    if(NULL == arg_pRPM)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+
+    if(HAL_ESC_OK != HAL_ESC_getTelemetry(&local_telemetry_t))
+        return HAL_WRAPPER_STAT_SENSOR_ERR;
+
+    for(i = 0; i < HAL_WRAPPER_MOTORS; i++)
+    {
+        arg_pRPM->rpm[i] = local_telemetry_t.eRPM[i] / (HAL_ESC_MOTOR_POLES / 2);
+    }
+    arg_pRPM->valid = local_telemetry_t.valid;
 
     return HAL_WRAPPER_STAT_OK;
 }
@@ -251,65 +460,38 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_DisableEnableAppCommRecCallBack(LIB_CONSTANTS_
 /**
  * 
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecCallBack(functionCallBack_t arg_pUARTCallBack)
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecTask(RTOS_TaskHandle_t arg_Task_t)
 {
-    MCAL_WRAPPER_SetUART4RecCallBack(arg_pUARTCallBack);
+    MCAL_UART_SetRxTask(arg_Task_t);
     return HAL_WRAPPER_STAT_OK;
 }
 
 /**
  * 
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReceiveSendAppCommMessage(HAL_WRAPPER_AppCommMsg_t* arg_AppCommMsg_t)
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommFrame(uint8_t* arg_pu8Frame, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len)
 {
+    MCAL_UART_ErrStat_t local_errState_t = MCAL_UART_Read(arg_pu8Frame, arg_u16MaxLen, arg_pu16Len);
 
-    // temp variables to allow synchronous send and receive at the same time
-    uint16_t local_u16LenOfDataToSend = 0;
-    uint16_t local_u16LenOfDataToReceive = 0;
+    if(MCAL_UART_STAT_INVALID_PARAMS == local_errState_t)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+    else if(MCAL_UART_STAT_OK != local_errState_t)
+        return HAL_WRAPPER_STAT_APP_DIDNT_SND;
 
-    // to detect if there is anything in the receiver buffer (as by writing to UART data register clears the RXNE flag)
-    MCAL_WRAPPER_ErrStat_t local_writeSuccess_t = MCAL_WRAPPER_STAT_OK;
+    return HAL_WRAPPER_STAT_OK;
+}
 
-    // loop until we send or received all messages
-    while (arg_AppCommMsg_t->dataIsToSend || arg_AppCommMsg_t->dataIsToReceive)
-    {
-        // check if to send
-        if(arg_AppCommMsg_t->dataIsToSend)
-        {
-            // send 1 byte
-            local_writeSuccess_t = MCAL_WRAPPER_SendDataThroughUART4(arg_AppCommMsg_t->dataToSend + local_u16LenOfDataToSend, 1);
-            
-            if(MCAL_WRAPPER_STAT_OK == local_writeSuccess_t)
-            {
-                local_u16LenOfDataToSend++;
-                
-                // check if sending is done
-                if(local_u16LenOfDataToSend == arg_AppCommMsg_t->dataToSendLen)
-                {
-                    
-                    arg_AppCommMsg_t->dataIsToSend = 0;
-                }  
-            }
-        }
-
-        // check if to receive
-        if(arg_AppCommMsg_t->dataIsToReceive)
-        {
-            // receive 1 byte
-            MCAL_WRAPPER_ReceiveDataThroughUART4(arg_AppCommMsg_t->dataToReceive + local_u16LenOfDataToReceive, 1);
-            local_u16LenOfDataToReceive++;
-
-            // check if receiving is done
-            if(local_u16LenOfDataToReceive == arg_AppCommMsg_t->dataToReceiveLen)
-            {
-                arg_AppCommMsg_t->dataIsToReceive = 0;
-
-               // enable receuve interrupt
-                HAL_WRAPPER_DisableEnableAppCommRecCallBack(LIB_CONSTANTS_ENABLED);
-            }
-        }
-    }
-    
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommFrame(HAL_WRAPPER_CommFrame_t* arg_pFrame)
+{
+    MCAL_UART_ErrStat_t local_errState_t = MCAL_UART_Send(arg_pFrame);
+
+    if(MCAL_UART_STAT_INVALID_PARAMS == local_errState_t)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+    else if(MCAL_UART_STAT_OK != local_errState_t)
+        return HAL_WRAPPER_STAT_APP_BOARD_BSY;
 
     return HAL_WRAPPER_STAT_OK;
 }
@@ -317,39 +499,185 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReceiveSendAppCommMessage(HAL_WRAPPER_AppCommM
 /**
  * 
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommMessage(uint8_t* arg_pu8Msg)
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommTxStats(HAL_WRAPPER_CommTxStats_t* arg_pStats)
 {
-    // receive 1 byte
-    MCAL_WRAPPER_ErrStat_t local_errState_t = MCAL_WRAPPER_ReceiveDataThroughUART4(arg_pu8Msg, 1);
-    
-    if(MCAL_WRAPPER_STAT_OK != local_errState_t)
+    if(MCAL_UART_STAT_OK != MCAL_UART_GetTxStats(arg_pStats))
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+
+    return HAL_WRAPPER_STAT_OK;
+}
+
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_WaitImuDataReady(uint32_t arg_u32TimeoutMS)
+{
+    uint32_t local_u32EdgeTime = 0;
+    uint32_t local_u32Missed = 0;
+    uint32_t local_u32WakeTime = 0;
+    uint32_t local_u32Period = 0;
+    uint32_t local_u32Jitter = 0;
+    uint32_t local_u32Latency = 0;
+
+    if(MCAL_WRAPPER_STAT_OK != MCAL_WRAPPER_WaitIMUDataReady(arg_u32TimeoutMS, &local_u32EdgeTime, &local_u32Missed))
+    {
+        SERVICE_RTOS_EnterCritical();
+        global_ImuSampleJitter_t.timeouts++;
+        global_u32ImuLastWakeUS = 0;
+        SERVICE_RTOS_ExitCritical();
+        return HAL_WRAPPER_STAT_TIMEOUT;
+    }
+    SERVICE_RTOS_CurrentUSTime(&local_u32WakeTime);
+
+    // the edge is stamped before the wake up, a negative difference can't be a latency (the stamps are taken modulo 2^32)
+    local_u32Latency = local_u32WakeTime - local_u32EdgeTime;
+    if((int32_t)local_u32Latency < 0)
+        local_u32Latency = 0;
+
+    SERVICE_RTOS_EnterCritical();
+    if(local_u32Latency > global_ImuSampleJitter_t.latencyMaxUS)
+        global_ImuSampleJitter_t.latencyMaxUS = local_u32Latency;
+
+    global_ImuSampleJitter_t.missed += local_u32Missed;
+
+    // a period that spans a missed pulse is not a sample period
+    if(0 != global_u32ImuLastWakeUS && 0 == local_u32Missed)
     {
-        local_errState_t = HAL_WRAPPER_STAT_APP_DIDNT_SND;
+        local_u32Period = local_u32WakeTime - global_u32ImuLastWakeUS;
+        local_u32Jitter = (local_u32Period > MPU6050_SAMPLE_PERIOD_US) ? (local_u32Period - MPU6050_SAMPLE_PERIOD_US) : (MPU6050_SAMPLE_PERIOD_US - local_u32Period);
+
+        if(0 == global_ImuSampleJitter_t.samples || local_u32Period < global_ImuSampleJitter_t.periodMinUS)
+            global_ImuSampleJitter_t.periodMinUS = local_u32Period;
+        if(local_u32Period > global_ImuSampleJitter_t.periodMaxUS)
+            global_ImuSampleJitter_t.periodMaxUS = local_u32Period;
+        if(local_u32Jitter > global_ImuSampleJitter_t.jitterMaxUS)
+            global_ImuSampleJitter_t.jitterMaxUS = local_u32Jitter;
+
+        global_u64ImuPeriodSumUS += local_u32Period;
+        global_u64ImuJitterSumUS += local_u32Jitter;
+        global_ImuSampleJitter_t.samples++;
     }
-    else
+
+    // 0 is used as "no previous wake up"
+    global_u32ImuLastWakeUS = (0 == local_u32WakeTime) ? 1 : local_u32WakeTime;
+    SERVICE_RTOS_ExitCritical();
+
+    return HAL_WRAPPER_STAT_OK;
+}
+
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetImuSampleJitter(HAL_WRAPPER_SampleJitter_t *arg_pJitter)
+{
+    if(NULL == arg_pJitter)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+
+    SERVICE_RTOS_EnterCritical();
+    *arg_pJitter = global_ImuSampleJitter_t;
+    if(0 != global_ImuSampleJitter_t.samples)
     {
-        local_errState_t = HAL_WRAPPER_STAT_OK;
+        arg_pJitter->periodMeanUS = (uint32_t)(global_u64ImuPeriodSumUS / global_ImuSampleJitter_t.samples);
+        arg_pJitter->jitterMeanUS = (uint32_t)(global_u64ImuJitterSumUS / global_ImuSampleJitter_t.samples);
     }
+    SERVICE_RTOS_ExitCritical();
 
-    return local_errState_t;
+    return HAL_WRAPPER_STAT_OK;
 }
 
 /**
  * 
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommMessage(uint8_t arg_pu8Msg)
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_StartControlTimer(uint32_t arg_u32PeriodUS)
 {
-    MCAL_WRAPPER_ErrStat_t local_errState_t = MCAL_WRAPPER_SendDataThroughUART4(&arg_pu8Msg, 1);
-    if(MCAL_WRAPPER_STAT_OK != local_errState_t)
+    if(MCAL_TIM3_STAT_OK != MCAL_TIM3_StartPeriodic(arg_u32PeriodUS))
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+
+    return HAL_WRAPPER_STAT_OK;
+}
+
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_WaitControlTick(uint32_t arg_u32TimeoutMS, uint32_t* arg_pu32TickTimeUS, uint32_t* arg_pu32MissedTicks)
+{
+    if(MCAL_TIM3_STAT_OK != MCAL_TIM3_WaitTick(arg_u32TimeoutMS, arg_pu32TickTimeUS, arg_pu32MissedTicks))
+        return HAL_WRAPPER_STAT_TIMEOUT;
+
+    return HAL_WRAPPER_STAT_OK;
+}
+
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadImuBatch(HAL_WRAPPER_ImuBatch_t *arg_pBatch)
+{
+    uint32_t local_u32ReadTime = 0;
+    uint32_t local_u32PeriodQ8 = 0;
+    uint8_t local_u8Count = 0;
+    uint8_t local_u8Overflow = 0;
+    uint8_t i = 0;
+
+    if(NULL == arg_pBatch)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+
+    // the newest sample in the FIFO was taken at most one period before its level is read
+    SERVICE_RTOS_CurrentUSTime(&local_u32ReadTime);
+
+    if(MCAL_I2C_STAT_OK != mpu6050_fifo_read_raw(global_MPU6050FIFO_t, HAL_WRAPPER_IMU_BATCH_MAX, &local_u8Count, &local_u8Overflow))
+        return HAL_WRAPPER_STAT_SENSOR_ERR;
+
+    // measure the period between two reads that emptied the FIFO, a full batch left samples behind
+    if(0 != global_u8ImuLastReadValid && 0 != local_u8Count && HAL_WRAPPER_IMU_BATCH_MAX != local_u8Count)
     {
-        local_errState_t = HAL_WRAPPER_STAT_APP_BOARD_BSY;
+        local_u32PeriodQ8 = ((local_u32ReadTime - global_u32ImuLastReadUS) << 8) / local_u8Count;
+
+        // the read times are only known within one period, the sensor oscillator is within a few percent
+        if(local_u32PeriodQ8 > (global_u32ImuPeriodQ8 >> 1) && local_u32PeriodQ8 < global_u32ImuPeriodQ8 + (global_u32ImuPeriodQ8 >> 1))
+            global_u32ImuPeriodQ8 = global_u32ImuPeriodQ8 + (int32_t)(local_u32PeriodQ8 - global_u32ImuPeriodQ8) / 32;
     }
-    else
+    global_u32ImuLastReadUS = local_u32ReadTime;
+    global_u8ImuLastReadValid = (0 == local_u8Overflow && HAL_WRAPPER_IMU_BATCH_MAX != local_u8Count);
+
+    arg_pBatch->count = local_u8Count;
+    arg_pBatch->overflow = local_u8Overflow;
+    arg_pBatch->periodUS = (global_u32ImuPeriodQ8 + 128) >> 8;
+    arg_pBatch->timestamp = local_u32ReadTime - (arg_pBatch->periodUS >> 1);
+
+    // account for the placement of the IC on the PCB
+    for(i = 0; i < local_u8Count; i++)
     {
-        local_errState_t = HAL_WRAPPER_STAT_OK;
+        arg_pBatch->frames[i].acc.x = -global_MPU6050FIFO_t[i].x_acc;
+        arg_pBatch->frames[i].acc.y = -global_MPU6050FIFO_t[i].y_acc;
+        arg_pBatch->frames[i].acc.z = global_MPU6050FIFO_t[i].z_acc;
+
+        arg_pBatch->frames[i].gyro.roll = -global_MPU6050FIFO_t[i].roll_rate;
+        arg_pBatch->frames[i].gyro.pitch = -global_MPU6050FIFO_t[i].pitch_rate;
+        arg_pBatch->frames[i].gyro.yaw = global_MPU6050FIFO_t[i].yaw_rate;
     }
 
-    return local_errState_t;
+    return HAL_WRAPPER_STAT_OK;
+}
+
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetImuFifoStats(HAL_WRAPPER_ImuFifoStats_t *arg_pStats)
+{
+    mpu6050_fifo_stats_t local_stats_t;
+
+    if(NULL == arg_pStats)
+        return HAL_WRAPPER_STAT_INVALID_PARAMS;
+
+    mpu6050_fifo_get_stats(&local_stats_t);
+
+    arg_pStats->batches = local_stats_t.reads;
+    arg_pStats->samples = local_stats_t.frames;
+    arg_pStats->overflows = local_stats_t.overflows;
+    arg_pStats->dropped = local_stats_t.dropped;
+    arg_pStats->maxLevel = local_stats_t.max_level;
+
+    return HAL_WRAPPER_STAT_OK;
 }
 
 /**
@@ -374,6 +702,17 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadTemperature(HAL_WRAPPER_Temperature_t *arg
     return HAL_WRAPPER_STAT_OK;
 }
 
+/**
+ * 
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadBarometer(HAL_WRAPPER_Pressure_t *arg_pPressure_t, HAL_WRAPPER_Temperature_t *arg_pTemperature_t)
+{
+    // read pressure and temperature from BMP280 in one burst
+    BMP280_get_sample(&arg_pTemperature_t->temperature, &arg_pPressure_t->pressure);
+
+    return HAL_WRAPPER_STAT_OK;
+}
+
 /**
  * 
  */
@@ -46,6 +46,25 @@
  * |    22/06/2023      1.0.0           Abdelrahman Mohamed Salem       added 'HAL_WRAPPER_ReadPressure'.                               |
  * |    22/06/2023      1.0.0           Abdelrahman Mohamed Salem       added 'HAL_WRAPPER_ReadTemperature'.                            |
  * |    22/06/2023      1.0.0           Abdelrahman Mohamed Salem       added 'HAL_WRAPPER_GetBatteryCharge'.                            |
+ * |    17/10/2026      1.1.0           agent                           added raw reads for acc, gyro and magnetometer.                 |
+ * |    17/10/2026      1.2.0           agent                           added 'HAL_WRAPPER_ReadImu' and 'HAL_WRAPPER_ReadImuRaw'.       |
+ * |    17/10/2026      1.3.0           agent                           IMU reads return 'HAL_WRAPPER_STAT_SENSOR_ERR' if the I2C       |
+ * |                                                                    transaction fails.                                              |
+ * |    17/10/2026      1.4.0           agent                           added 'HAL_WRAPPER_WaitImuDataReady' and                        |
+ * |                                                                    'HAL_WRAPPER_GetImuSampleJitter'.                               |
+ * |    17/10/2026      1.5.0           agent                           added 'HAL_WRAPPER_ReadImuBatch' and                            |
+ * |                                                                    'HAL_WRAPPER_GetImuFifoStats'.                                  |
+ * |    17/10/2026      1.6.0           agent                           added 'HAL_WRAPPER_ReadBarometer'.                              |
+ * |    17/10/2026      1.7.0           agent                           replaced the UART4 receive callback functions and               |
+ * |                                                                    'HAL_WRAPPER_GetCommMessage' by 'HAL_WRAPPER_SetAppCommRecTask' |
+ * |                                                                    and 'HAL_WRAPPER_GetCommFrame'.                                 |
+ * |    17/10/2026      1.8.0           agent                           replaced 'HAL_WRAPPER_SendCommMessage' by the DMA frame         |
+ * |                                                                    transmitter 'HAL_WRAPPER_SendCommFrame' and added               |
+ * |                                                                    'HAL_WRAPPER_GetCommTxStats'.                                   |
+ * |    17/10/2026      1.9.0           agent                           'HAL_WRAPPER_SetESCSpeeds' sends the four speeds at once.       |
+ * |    17/10/2026      1.10.0          agent                           added 'HAL_WRAPPER_GetMotorRPM'.                                |
+ * |    17/10/2026      1.11.0          agent                           added 'HAL_WRAPPER_StartControlTimer' and                       |
+ * |                                                                    'HAL_WRAPPER_WaitControlTick'.                                  |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -71,15 +90,73 @@
  */
 #include "common.h"
 
+/**
+ * @reason: contains definition of the task handle notified by the comm port
+ */
+#include "Service_RTOS_wrapper.h"
+
+/**
+ * @reason: contains the frames and counters of the DMA transmitter of the comm port
+ */
+#include "MCAL_UART.h"
+
+/**
+ * @reason: contains the sample rate and the FIFO configuration of the MPU6050
+ */
+#include "MPU6050.h"
+
+/**
+ * @reason: contains the protocol of the ESCs and their telemetry configuration
+ */
+#include "ESC.h"
+
 
 /******************************************************************************
  * Preprocessor Constants
  *******************************************************************************/
 
+/**
+ * @brief: scale of the readings returned by the raw read functions, must match the MPU6050 full scale configuration
+ */
+#define HAL_WRAPPER_ACC_RAW_LSB_PER_G       (4096)
+#define HAL_WRAPPER_GYRO_RAW_LSB_PER_DPS    (65.5)
+
+/**
+ * @brief: scale and offset of the raw die temperature returned by 'HAL_WRAPPER_ReadImuRaw', temperature = raw / LSB_PER_DEG + OFFSET
+ */
+#define HAL_WRAPPER_TEMP_RAW_LSB_PER_DEG    (340)
+#define HAL_WRAPPER_TEMP_RAW_OFFSET         (36.53)
+
+/**
+ * @brief: 1 when the IMU samples at 1 KHz into the FIFO of the MPU6050 and is read in batches by 'HAL_WRAPPER_ReadImuBatch'
+ */
+#define HAL_WRAPPER_IMU_FIFO_BATCH          MPU6050_FIFO_BATCH
+
+/**
+ * @brief: 1 when the ESCs send the speed of their motor back (bidirectional DShot) to be read by 'HAL_WRAPPER_GetMotorRPM'
+ */
+#define HAL_WRAPPER_ESC_TELEMETRY           HAL_ESC_DSHOT_BIDIR
+
+/**
+ * @brief: number of motors in 'HAL_WRAPPER_MotorRPM_t'
+ */
+#define HAL_WRAPPER_MOTORS                  (4)
+
+/**
+ * @brief: time between two IMU samples in micro seconds
+ */
+#define HAL_WRAPPER_IMU_SAMPLE_PERIOD_US    MPU6050_SAMPLE_PERIOD_US
+
 /******************************************************************************
  * Configuration Constants
  *******************************************************************************/
 
+/**
+ * @brief: maximum number of samples returned by one call of 'HAL_WRAPPER_ReadImuBatch', more than the samples of one
+ *         collection period so a late collection catches up on the next ones
+ */
+#define HAL_WRAPPER_IMU_BATCH_MAX           (16)
+
 /******************************************************************************
  * Macros
  *******************************************************************************/
@@ -96,8 +173,20 @@ typedef enum {
   HAL_WRAPPER_STAT_INVALID_PARAMS,
   HAL_WRAPPER_STAT_APP_BOARD_BSY,
   HAL_WRAPPER_STAT_APP_DIDNT_SND,
+  HAL_WRAPPER_STAT_SENSOR_ERR,
+  HAL_WRAPPER_STAT_TIMEOUT,
 } HAL_WRAPPER_ErrStat_t;
 
+/**
+ * @brief: a frame sent to the other board, refer to @MCAL_UART_TxFrame_t in "MCAL_UART.h"
+ */
+typedef MCAL_UART_TxFrame_t HAL_WRAPPER_CommFrame_t;
+
+/**
+ * @brief: counters of the frames sent to the other board, refer to @MCAL_UART_TxStats_t in "MCAL_UART.h"
+ */
+typedef MCAL_UART_TxStats_t HAL_WRAPPER_CommTxStats_t;
+
 /**
  * @brief: contains definitions to be used with reading accelerometer data
  */
@@ -129,6 +218,107 @@ typedef struct
   float z;  /**< Magnetometer in z-direction */  
 } HAL_WRAPPER_Magnet_t;
 
+/**
+ * @brief: contains raw accelerometer data in LSB (HAL_WRAPPER_ACC_RAW_LSB_PER_G LSB = 1 g) to be used with the fixed point fusion
+ */
+typedef struct
+{
+  int16_t x; /**< acceleration in x-direction */
+  int16_t y; /**< acceleration in y-direction */
+  int16_t z; /**< acceleration in z-direction */
+} HAL_WRAPPER_AccRaw_t;
+
+/**
+ * @brief: contains raw gyroscope data in LSB (HAL_WRAPPER_GYRO_RAW_LSB_PER_DPS LSB = 1 deg/s) to be used with the fixed point fusion
+ */
+typedef struct
+{
+  int16_t roll;  /**< gyroscope in x-direction */
+  int16_t pitch; /**< gyroscope in y-direction */
+  int16_t yaw;   /**< gyroscope in z-direction */
+} HAL_WRAPPER_GyroRaw_t;
+
+/**
+ * @brief: contains raw magnetometer data in LSB with the hard iron offsets removed to be used with the fixed point fusion
+ */
+typedef struct
+{
+  int16_t x;  /**< Magnetometer in x-direction */
+  int16_t y;  /**< Magnetometer in y-direction */
+  int16_t z;  /**< Magnetometer in z-direction */
+} HAL_WRAPPER_MagnetRaw_t;
+
+/**
+ * @brief: contains one sample of the IMU (accelerometer, gyroscope and die temperature read together)
+ */
+typedef struct
+{
+  HAL_WRAPPER_Acc_t acc;    /**< acceleration in g */
+  HAL_WRAPPER_Gyro_t gyro;  /**< rate of rotation in deg/s */
+  float temperature;        /**< die temperature in Degree Celsius */
+  uint32_t timestamp;       /**< time in microseconds at which the sample was read */
+} HAL_WRAPPER_Imu_t;
+
+/**
+ * @brief: same as 'HAL_WRAPPER_Imu_t' but in LSB to be used with the fixed point fusion
+ */
+typedef struct
+{
+  HAL_WRAPPER_AccRaw_t acc;   /**< acceleration in LSB */
+  HAL_WRAPPER_GyroRaw_t gyro; /**< rate of rotation in LSB */
+  int16_t temperature;        /**< die temperature in LSB (refer to HAL_WRAPPER_TEMP_RAW_LSB_PER_DEG) */
+  uint32_t timestamp;         /**< time in microseconds at which the sample was read */
+} HAL_WRAPPER_ImuRaw_t;
+
+/**
+ * @brief: statistics of the period between two IMU samples as seen by the task waiting for the data ready pulse
+ */
+typedef struct
+{
+  uint32_t samples;           /**< number of measured periods */
+  uint32_t missed;            /**< data ready pulses that came while the task was still busy with the previous sample */
+  uint32_t timeouts;          /**< waits that ended without a data ready pulse */
+  uint32_t periodMinUS;       /**< shortest period in micro seconds */
+  uint32_t periodMaxUS;       /**< longest period in micro seconds */
+  uint32_t periodMeanUS;      /**< average period in micro seconds */
+  uint32_t jitterMeanUS;      /**< average absolute difference between the period and the sensor period in micro seconds */
+  uint32_t jitterMaxUS;       /**< largest absolute difference between the period and the sensor period in micro seconds */
+  uint32_t latencyMaxUS;      /**< longest time between the data ready pulse and the wake up of the task in micro seconds */
+} HAL_WRAPPER_SampleJitter_t;
+
+/**
+ * @brief: one sample of the IMU FIFO in LSB (accelerometer and gyroscope only)
+ */
+typedef struct
+{
+  HAL_WRAPPER_AccRaw_t acc;   /**< acceleration in LSB */
+  HAL_WRAPPER_GyroRaw_t gyro; /**< rate of rotation in LSB */
+} HAL_WRAPPER_ImuFrameRaw_t;
+
+/**
+ * @brief: the IMU samples taken since the previous batch, sample i was taken at timestamp - (count - 1 - i) * periodUS
+ */
+typedef struct
+{
+  uint8_t count;              /**< number of valid samples in 'frames', oldest first */
+  uint8_t overflow;           /**< 1 if samples were lost before 'frames[0]' (the FIFO overflowed) */
+  uint32_t periodUS;          /**< time between two samples in micro seconds */
+  uint32_t timestamp;         /**< time in micro seconds of the newest sample 'frames[count - 1]' */
+  HAL_WRAPPER_ImuFrameRaw_t frames[HAL_WRAPPER_IMU_BATCH_MAX];
+} HAL_WRAPPER_ImuBatch_t;
+
+/**
+ * @brief: counters of the IMU FIFO reads since boot
+ */
+typedef struct
+{
+  uint32_t batches;           /**< number of FIFO bursts */
+  uint32_t samples;           /**< number of samples read */
+  uint32_t overflows;         /**< number of times the FIFO overflowed and was reset */
+  uint32_t dropped;           /**< number of samples thrown away by the resets */
+  uint16_t maxLevel;          /**< highest number of samples found waiting in the FIFO */
+} HAL_WRAPPER_ImuFifoStats_t;
+
 /**
  * @brief: contains definitions to be used with reading pressure data
  */
@@ -173,6 +363,15 @@ typedef struct
   float bottomRightSpeed; /**< speed of bottom right motor in range 0 to 100 */
 } HAL_WRAPPER_MotorSpeeds_t;
 
+/**
+ * @brief: contains the speeds of the motors in revolutions per minute reported by the ESCs
+ */
+typedef struct
+{
+  uint32_t rpm[HAL_WRAPPER_MOTORS]; /**< top left, top right, bottom left and bottom right motor */
+  uint8_t valid;                    /**< bit n is set if rpm[n] comes from the last reply of the motor */
+} HAL_WRAPPER_MotorRPM_t;
+
 /**
  * @brief: contains definitions to be used with communication with app board
  */
@@ -319,6 +518,418 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadGyro(HAL_WRAPPER_Gyro_t *arg_pGyro);
  */
 HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadMagnet(HAL_WRAPPER_Magnet_t *arg_pMagnet);
 
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadAccRaw(HAL_WRAPPER_AccRaw_t *arg_pAcc);
+ *  \b Description                              :       same as HAL_WRAPPER_ReadAcc but returns the raw sensor counts with the same axes orientation.
+ *  @param  arg_pAcc [OUT]                      :       base address to store the received data from the I2C upon transfer.
+ *  @note                                       :       the calling task sleeps until the I2C data is transferred, no floating point operation is involved,
+ *                                                      'arg_pImu' is left untouched and HAL_WRAPPER_STAT_SENSOR_ERR is returned if the transaction fails.
+ *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadAcc(HAL_WRAPPER_Acc_t *arg_pAcc)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * 
+ * int main() {
+ * 
+ * MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllHW();
+ * if(HAL_Config_STAT_OK == local_errState)
+ * {
+ *  HAL_WRAPPER_AccRaw_t temp = {0};
+ *  local_errState = HAL_WRAPPER_ReadAccRaw(&temp);
+ *  if(HAL_WRAPPER_STAT_OK == local_errState)
+ *  {
+ *    
+ *  }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadAccRaw(HAL_WRAPPER_AccRaw_t *arg_pAcc);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadGyroRaw(HAL_WRAPPER_GyroRaw_t *arg_pGyro);
+ *  \b Description                              :       same as HAL_WRAPPER_ReadGyro but returns the raw sensor counts (calibration offset removed) with the same axes orientation.
+ *  @param  arg_pGyro [OUT]                     :       base address to store the received data from the I2C upon transfer.
+ *  @note                                       :       this is a polling function halting the process execution until the I2C data is transferred, no floating point operation is involved.
+ *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadGyro(HAL_WRAPPER_Gyro_t *arg_pGyro)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * 
+ * int main() {
+ * 
+ * MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllHW();
+ * if(HAL_Config_STAT_OK == local_errState)
+ * {
+ *  HAL_WRAPPER_GyroRaw_t temp = {0};
+ *  local_errState = HAL_WRAPPER_ReadGyroRaw(&temp);
+ *  if(HAL_WRAPPER_STAT_OK == local_errState)
+ *  {
+ *    
+ *  }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadGyroRaw(HAL_WRAPPER_GyroRaw_t *arg_pGyro);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadMagnetRaw(HAL_WRAPPER_MagnetRaw_t *arg_pMagnet);
+ *  \b Description                              :       same as HAL_WRAPPER_ReadMagnet but returns the raw sensor counts (hard iron offsets removed, not scaled) with the same axes orientation.
+ *  @param  arg_pMagnet [OUT]                   :       base address to store the received data from the I2C upon transfer.
+ *  @note                                       :       this is a polling function halting the process execution until the I2C data is transferred, no floating point operation is involved.
+ *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadMagnet(HAL_WRAPPER_Magnet_t *arg_pMagnet)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * 
+ * int main() {
+ * 
+ * MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllHW();
+ * if(HAL_Config_STAT_OK == local_errState)
+ * {
+ *  HAL_WRAPPER_MagnetRaw_t temp = {0};
+ *  local_errState = HAL_WRAPPER_ReadMagnetRaw(&temp);
+ *  if(HAL_WRAPPER_STAT_OK == local_errState)
+ *  {
+ *    
+ *  }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadMagnetRaw(HAL_WRAPPER_MagnetRaw_t *arg_pMagnet);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadImu(HAL_WRAPPER_Imu_t *arg_pImu);
+ *  \b Description                              :       reads the accelerometer, the gyroscope and the die temperature of the MPU6050 in one I2C transaction and stamps the sample
+ *                                                      with the time it was taken, the axes orientation is the same as HAL_WRAPPER_ReadAcc and HAL_WRAPPER_ReadGyro.
+ *  @param  arg_pImu [OUT]                      :       base address to store the received sample in.
+ *  @note                                       :       the calling task sleeps until the I2C data is transferred, it replaces calling HAL_WRAPPER_ReadAcc
+ *                                                      followed by HAL_WRAPPER_ReadGyro (4 I2C transactions), 'arg_pImu' is left untouched and
+ *                                                      HAL_WRAPPER_STAT_SENSOR_ERR is returned if the transaction fails.
+ *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadImuRaw(HAL_WRAPPER_ImuRaw_t *arg_pImu)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * 
+ * int main() {
+ * 
+ * MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllHW();
+ * if(HAL_Config_STAT_OK == local_errState)
+ * {
+ *  HAL_WRAPPER_Imu_t temp = {0};
+ *  local_errState = HAL_WRAPPER_ReadImu(&temp);
+ *  if(HAL_WRAPPER_STAT_OK == local_errState)
+ *  {
+ *    
+ *  }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadImu(HAL_WRAPPER_Imu_t *arg_pImu);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadImuRaw(HAL_WRAPPER_ImuRaw_t *arg_pImu);
+ *  \b Description                              :       same as HAL_WRAPPER_ReadImu but returns the raw sensor counts (gyroscope calibration offset removed) with the same axes orientation.
+ *  @param  arg_pImu [OUT]                      :       base address to store the received sample in.
+ *  @note                                       :       this is a polling function halting the process execution until the I2C data is transferred, no floating point operation is involved.
+ *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadImu(HAL_WRAPPER_Imu_t *arg_pImu)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * 
+ * int main() {
+ * 
+ * MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllHW();
+ * if(HAL_Config_STAT_OK == local_errState)
+ * {
+ *  HAL_WRAPPER_ImuRaw_t temp = {0};
+ *  local_errState = HAL_WRAPPER_ReadImuRaw(&temp);
+ *  if(HAL_WRAPPER_STAT_OK == local_errState)
+ *  {
+ *    
+ *  }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadImuRaw(HAL_WRAPPER_ImuRaw_t *arg_pImu);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_WaitImuDataReady(uint32_t arg_u32TimeoutMS);
+ *  \b Description                              :       blocks the calling task until the MPU6050 has a new sample (data ready pulse) and updates the sample period statistics.
+ *  @param  arg_u32TimeoutMS [IN]               :       maximum time in milliseconds to wait for the pulse.
+ *  @note                                       :       the period is measured between two wake ups of the task, so it includes the latency of the scheduler.
+ *                                                      a wake up that follows a missed pulse or a timeout isn't counted as a period.
+ *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       HAL_WRAPPER_STAT_TIMEOUT if no pulse came in time, otherwise HAL_WRAPPER_STAT_OK
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetImuSampleJitter(HAL_WRAPPER_SampleJitter_t *arg_pJitter)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * void task(void *pvParameters)
+ * {
+ *   HAL_WRAPPER_Imu_t imu = {0};
+ *   while(1)
+ *   {
+ *     HAL_WRAPPER_WaitImuDataReady(10);
+ *     HAL_WRAPPER_ReadImu(&imu);
+ *   }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_WaitImuDataReady(uint32_t arg_u32TimeoutMS);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetImuSampleJitter(HAL_WRAPPER_SampleJitter_t *arg_pJitter);
+ *  \b Description                              :       returns the statistics of the sample period measured by HAL_WRAPPER_WaitImuDataReady since boot.
+ *  @param  arg_pJitter [OUT]                   :       base address to store the statistics in.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_WaitImuDataReady(uint32_t arg_u32TimeoutMS)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * HAL_WRAPPER_SampleJitter_t jitter = {0};
+ * if(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_GetImuSampleJitter(&jitter))
+ * {
+ *   printf("period %lu us, jitter %lu us (max %lu us)\r\n", jitter.periodMeanUS, jitter.jitterMeanUS, jitter.jitterMaxUS);
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetImuSampleJitter(HAL_WRAPPER_SampleJitter_t *arg_pJitter);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_StartControlTimer(uint32_t arg_u32PeriodUS);
+ *  \b Description                              :       starts the hardware timer that paces the control loop, refer to 'HAL_WRAPPER_WaitControlTick'.
+ *  @param  arg_u32PeriodUS [IN]                :       period of the control loop in micro seconds (at most MCAL_TIM3_MAX_PERIOD_US).
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_WaitControlTick(uint32_t arg_u32TimeoutMS, uint32_t* arg_pu32TickTimeUS, uint32_t* arg_pu32MissedTicks)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * HAL_WRAPPER_StartControlTimer(2000);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_StartControlTimer(uint32_t arg_u32PeriodUS);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_WaitControlTick(uint32_t arg_u32TimeoutMS, uint32_t* arg_pu32TickTimeUS, uint32_t* arg_pu32MissedTicks);
+ *  \b Description                              :       blocks the calling task until the next period of the control loop.
+ *  @param  arg_u32TimeoutMS [IN]               :       maximum time in milliseconds to wait for the tick.
+ *  @param  arg_pu32TickTimeUS [OUT]            :       time in micro seconds (SERVICE_RTOS_CurrentUSTime) at which the period started, can be NULL.
+ *  @param  arg_pu32MissedTicks [OUT]           :       number of periods skipped since the last call because the loop took too long, can be NULL.
+ *  @note                                       :       the first task that waits owns the ticks.
+ *  \b PRE-CONDITION                            :       HAL_WRAPPER_StartControlTimer is called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       HAL_WRAPPER_STAT_TIMEOUT if no tick came in time, otherwise HAL_WRAPPER_STAT_OK
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_StartControlTimer(uint32_t arg_u32PeriodUS)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "HAL_wrapper.h"
+ * 
+ * void task(void *pvParameters)
+ * {
+ *   HAL_WRAPPER_StartControlTimer(2000);
+ *   while(1)
+ *   {
+ *     if(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_WaitControlTick(10, NULL, NULL))
+ *     {
+ *       // sample, fuse, control and write the motors
+ *     }
+ *   }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_WaitControlTick(uint32_t arg_u32TimeoutMS, uint32_t* arg_pu32TickTimeUS, uint32_t* arg_pu32MissedTicks);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadImuBatch(HAL_WRAPPER_ImuBatch_t *arg_pBatch);
+ *  \b Description                              :       reads the IMU samples waiting in the FIFO of the MPU6050 in one I2C burst with the same axes orientation
+ *                                                      as HAL_WRAPPER_ReadImuRaw, the timestamps are rebuilt from the sample period and slowly pulled
+ *                                                      towards the time of the reads so they follow the clock of the MCU.
+ *  @param  arg_pBatch [OUT]                    :       base address to store the samples in.
+ *  @note                                       :       at most HAL_WRAPPER_IMU_BATCH_MAX samples are returned, the rest is left in the FIFO for the next call.
+ *                                                      an overflow resets the FIFO and returns an empty batch with 'overflow' set.
+ *                                                      'arg_pBatch' is left untouched and HAL_WRAPPER_STAT_SENSOR_ERR is returned if the transaction fails.
+ *  \b PRE-CONDITION                            :       HAL_WRAPPER_IMU_FIFO_BATCH is enabled and the hardware is configured.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetImuFifoStats(HAL_WRAPPER_ImuFifoStats_t *arg_pStats)
+ *
+ *  \b Example:
+ * @code
+ *
+ * #include "HAL_wrapper.h"
+ *
+ * HAL_WRAPPER_ImuBatch_t batch;
+ * if(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_ReadImuBatch(&batch))
+ * {
+ *   for(uint8_t i = 0; i < batch.count; i++)
+ *   {
+ *     // batch.frames[i] was taken at batch.timestamp - (batch.count - 1 - i) * batch.periodUS
+ *   }
+ * }
+ *
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadImuBatch(HAL_WRAPPER_ImuBatch_t *arg_pBatch);
+
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetImuFifoStats(HAL_WRAPPER_ImuFifoStats_t *arg_pStats);
+ *  \b Description                              :       returns the counters of the IMU FIFO reads since boot (samples, overflows, fill level).
+ *  @param  arg_pStats [OUT]                    :       base address to store the counters in.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadImuBatch(HAL_WRAPPER_ImuBatch_t *arg_pBatch)
+ *
+ *  \b Example:
+ * @code
+ *
+ * #include "HAL_wrapper.h"
+ *
+ * HAL_WRAPPER_ImuFifoStats_t stats = {0};
+ * if(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_GetImuFifoStats(&stats))
+ * {
+ *   printf("overflows %lu, dropped %lu, max level %u\r\n", stats.overflows, stats.dropped, stats.maxLevel);
+ * }
+ *
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetImuFifoStats(HAL_WRAPPER_ImuFifoStats_t *arg_pStats);
+
 /**
  *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadPressure(HAL_WRAPPER_Pressure_t *arg_pMagnet);
  *  \b Description                              :       this functions is used as a wrapper function to the function of reading pressure from different sensors on the board.
@@ -399,6 +1010,41 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadPressure(HAL_WRAPPER_Pressure_t *arg_pPres
  */
 HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadTemperature(HAL_WRAPPER_Temperature_t *arg_pTemperature_t);
 
+/**
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadBarometer(HAL_WRAPPER_Pressure_t *arg_pPressure_t, HAL_WRAPPER_Temperature_t *arg_pTemperature_t);
+ *  \b Description                              :       reads the pressure and the temperature of the same barometer measurement in one transaction.
+ *  @param  arg_pPressure_t [OUT]               :       base address to store the pressure.
+ *  @param  arg_pTemperature_t [OUT]            :       base address to store the temperature.
+ *  @note                                       :       this is a polling function halting the process execution until the data is transferred.
+ *                                                      it replaces a call to HAL_WRAPPER_ReadPressure followed by HAL_WRAPPER_ReadTemperature.
+ *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadPressure(HAL_WRAPPER_Pressure_t *arg_pPressure_t)
+ *
+ *  \b Example:
+ * @code
+ *
+ * #include "HAL_wrapper.h"
+ *
+ * HAL_WRAPPER_Pressure_t pressure = {0};
+ * HAL_WRAPPER_Temperature_t temperature = {0};
+ * if(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_ReadBarometer(&pressure, &temperature))
+ * {
+ *   // pressure and temperature are read
+ * }
+ *
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadBarometer(HAL_WRAPPER_Pressure_t *arg_pPressure_t, HAL_WRAPPER_Temperature_t *arg_pTemperature_t);
+
 
 /**
  *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadAltitude(HAL_WRAPPER_Altitude_t *arg_pAltitude_t, HAL_WRAPPER_Pressure_t *arg_pPressure_t);
@@ -431,7 +1077,8 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadAltitude(HAL_WRAPPER_Altitude_t *arg_pAlti
  *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetESCSeeds(HAL_WRAPPER_MotorSpeeds_t *arg_pMotorsSpeed);
  *  \b Description                              :       this functions is used as a wrapper function to set the speeds of ESCs motors.
  *  @param  arg_pMotorsSpeed [INT]              :       base address of new motors speeds to set, refer to @HAL_WRAPPER_MotorSpeeds_t in "HAL_wrapper.h".
- *  @note                                       :       None.
+ *  @note                                       :       with DShot (HAL_ESC_PROTOCOL in "ESC.h") the four motors get their new speed within ~30 us of
+ *                                                      the call, so every control loop reaches the motors.
  *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
  *  \b POST-CONDITION                           :       Motors Speeds are changed.
  *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
@@ -467,58 +1114,52 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReadAltitude(HAL_WRAPPER_Altitude_t *arg_pAlti
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
  * <tr><td> 15/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.9.0            </td><td> agent    </td><td> the four speeds are sent at once </td></tr>
  * </table><br><br>
  * <hr>
  */
 HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetESCSpeeds(HAL_WRAPPER_MotorSpeeds_t *arg_pMotorsSpeed);
 
 /**
- *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetBatteryCharge(HAL_WRAPPER_Battery_t *arg_pBatteryCharge);
- *  \b Description                              :       this functions is used as a wrapper function to set get the charge of the battery.
- *  @param  arg_pBatteryCharge [OUT]            :       base address of battery charge to insert. refer to @HAL_WRAPPER_Battery_t in "HAL_wrapper.h".
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       Motors Speeds are changed.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetMotorRPM(HAL_WRAPPER_MotorRPM_t *arg_pRPM);
+ *  \b Description                              :       this functions is used as a wrapper function to get the speed of every motor measured by its ESC.
+ *  @param  arg_pRPM [OUT]                      :       base address to store the speeds in, refer to @HAL_WRAPPER_MotorRPM_t in "HAL_wrapper.h".
+ *  @note                                       :       the eRPM sent back by the ESCs is divided by the pole pairs of the motors (HAL_ESC_MOTOR_POLES),
+ *                                                      every motor is heard once every 4 calls of 'HAL_WRAPPER_SetESCSpeeds'.
+ *  \b PRE-CONDITION                            :       HAL_WRAPPER_ESC_TELEMETRY is enabled and the hardware is configured.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       HAL_WRAPPER_STAT_SENSOR_ERR without HAL_WRAPPER_ESC_TELEMETRY, else one of error states (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetESCSpeeds(HAL_WRAPPER_MotorSpeeds_t *arg_pMotorsSpeed)
  *
  *  \b Example:
  * @code
- * 
+ *
  * #include "HAL_wrapper.h"
- * 
- * 
- * int main() {
- * HAL_WRAPPER_Battery_t batteryCharge = {0};
- * MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllHW();
- * if(HAL_Config_STAT_OK == local_errState)
+ *
+ * HAL_WRAPPER_MotorRPM_t rpm;
+ * if(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_GetMotorRPM(&rpm) && (rpm.valid & 1))
  * {
- *  local_errState = HAL_WRAPPER_GetBatteryCharge(&batteryCharge);
- *  if(HAL_WRAPPER_STAT_OK == local_errState)
- *  {
- *    // motor speeds are set
- *  }
+ *   // rpm.rpm[0] is the speed of the top left motor
  * }
- * 
+ *
  * @endcode
  *
  * <br><b> - HISTORY OF CHANGES - </b>
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 27/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
  * </table><br><br>
  * <hr>
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetBatteryCharge(HAL_WRAPPER_Battery_t *arg_pBatteryCharge);
-
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetMotorRPM(HAL_WRAPPER_MotorRPM_t *arg_pRPM);
 
 /**
- *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecCallBack(functionCallBack_t *arg_pUARTCallBack);
- *  \b Description                              :       this functions is used as a wrapper function to set callback function to execute when board receives anything on its uart interface with App board.
- *  @param  arg_pUARTCallBack [INT]             :       base address of function to be executed when board receives anything.
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetBatteryCharge(HAL_WRAPPER_Battery_t *arg_pBatteryCharge);
+ *  \b Description                              :       this functions is used as a wrapper function to set get the charge of the battery.
+ *  @param  arg_pBatteryCharge [OUT]            :       base address of battery charge to insert. refer to @HAL_WRAPPER_Battery_t in "HAL_wrapper.h".
  *  @note                                       :       None.
  *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       Callback function is assigned to be executed whenever board receives anything.
+ *  \b POST-CONDITION                           :       Motors Speeds are changed.
  *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
  *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
  *
@@ -527,63 +1168,56 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetBatteryCharge(HAL_WRAPPER_Battery_t *arg_pB
  * 
  * #include "HAL_wrapper.h"
  * 
- * void func(void)
- * {
- *  // callback code
- * }
  * 
  * int main() {
- *  MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllHW();
- *  if(HAL_Config_STAT_OK == local_errState)
+ * HAL_WRAPPER_Battery_t batteryCharge = {0};
+ * MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllHW();
+ * if(HAL_Config_STAT_OK == local_errState)
+ * {
+ *  local_errState = HAL_WRAPPER_GetBatteryCharge(&batteryCharge);
+ *  if(HAL_WRAPPER_STAT_OK == local_errState)
  *  {
- *    local_errState = HAL_WRAPPER_SetAppCommRecCallBack(func);
- *    if(HAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *    
- *    }
+ *    // motor speeds are set
  *  }
  * }
+ * 
  * @endcode
  *
  * <br><b> - HISTORY OF CHANGES - </b>
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 17/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 27/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
  * </table><br><br>
  * <hr>
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecCallBack(functionCallBack_t arg_pUARTCallBack);
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetBatteryCharge(HAL_WRAPPER_Battery_t *arg_pBatteryCharge);
+
 
 
 /**
- *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_DisableEnableAppCommRecCallBack(LIB_CONSTANTS_DriverStates_t arg_Enable_Disable_t);
- *  \b Description                              :       this functions is used as a wrapper function to set callback function to enable/disable app board byte received interrupt.
- *  @param arg_Enable_Disable_t [IN]            :       to enable or disable the interrupt, refer to @LIB_CONSTANTS_DriverStates_t in "constants.h".
- *  @note                                       :       None.
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecTask(RTOS_TaskHandle_t arg_Task_t);
+ *  \b Description                              :       this functions is used as a wrapper function to set the task notified when the other board sends something.
+ *  @param  arg_Task_t [IN]                     :       handle of the task to notify, it's notified once a burst of bytes ends (idle line on the comm port).
+ *  @note                                       :       the bytes are received by DMA, the task can sleep until it's notified.
  *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       app board receive interrupt is enabled/disabled.
+ *  \b POST-CONDITION                           :       None.
  *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommFrame(uint8_t* arg_pu8Frame, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len)
  *
  *  \b Example:
  * @code
  * 
  * #include "HAL_wrapper.h"
  * 
- * void func(void)
+ * void task(void)
  * {
- *  // callback code
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllHW();
- *  if(HAL_Config_STAT_OK == local_errState)
+ *  RTOS_TaskHandle_t local_task_t = NULL;
+ *  SERVICE_RTOS_GetCurrentTaskHandle(&local_task_t);
+ *  HAL_WRAPPER_SetAppCommRecTask(local_task_t);
+ *  while(1)
  *  {
- *    local_errState = HAL_WRAPPER_DisableEnableAppCommRecCallBack(LIB_CONSTANTS_ENABLED);
- *    if(HAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *    
- *    }
+ *    SERVICE_RTOS_WaitForNotification(1000);
+ *    // read the received bytes with HAL_WRAPPER_GetCommFrame
  *  }
  * }
  * @endcode
@@ -591,159 +1225,115 @@ HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecCallBack(functionCallBack_t arg_p
  * <br><b> - HISTORY OF CHANGES - </b>
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 20/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
  * </table><br><br>
  * <hr>
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_DisableEnableAppCommRecCallBack(LIB_CONSTANTS_DriverStates_t arg_Enable_Disable_t);
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecTask(RTOS_TaskHandle_t arg_Task_t);
 
 /**
- *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReceiveSendAppCommMessage(HAL_WRAPPER_AppCommMsg_t* arg_AppCommMsg_t);
- *  \b Description                              :       this functions is used as a wrapper function to set receive and send messages with App board.
- *  @param  arg_AppCommMsg_t [IN][OUT]          :       base address of function to be executed when board receives anything, refer to @HAL_WRAPPER_AppCommMsg_t in "HAL_wrapper.h".
- *  @note                                       :       None.
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommFrame(uint8_t* arg_pu8Frame, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len);
+ *  \b Description                              :       this functions is used as a wrapper function to get the bytes received from the other board up to the
+ *                                                      end of the last burst.
+ *  @param  arg_pu8Frame [OUT]                  :       base address to copy the received bytes to.
+ *  @param  arg_u16MaxLen [IN]                  :       size of 'arg_pu8Frame', the rest is returned by the next call.
+ *  @param  arg_pu16Len [OUT]                   :       number of copied bytes.
+ *  @note                                       :       a message may be split over two calls if it's sent with a pause in the middle.
  *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       a message is exchanged between the 2 boards.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       HAL_WRAPPER_STAT_APP_DIDNT_SND if nothing was received, else HAL_WRAPPER_STAT_OK (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SetAppCommRecTask(RTOS_TaskHandle_t arg_Task_t)
  *
  *  \b Example:
  * @code
  * 
  * #include "HAL_wrapper.h"
  * 
- * void func(void)
+ * uint8_t local_u8Frame[32];
+ * uint16_t local_u16Len = 0;
+ * while(HAL_WRAPPER_STAT_OK == HAL_WRAPPER_GetCommFrame(local_u8Frame, sizeof(local_u8Frame), &local_u16Len))
  * {
- *  // callback code
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllHW();
- *  if(HAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = HAL_WRAPPER_SetAppCommRecCallBack(func);
- *    if(HAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *      uint8_t dataSend[] = [3, 4];
- *      uint8_t dataRec[] = [1, 2];
- *      HAL_WRAPPER_AppCommMsg_t temp = {
- *        .dataToSend=dataSend,
- *        .dataToReceive=dataRec, 
- *        .dataToSendLen=2,
- *        .dataToReceiveLen=2,
- *        .dataIsToReceive=1
- *        .dataIsToSend=1
- *      };
- *      local_errState = HAL_WRAPPER_ReceiveSendAppCommMessage(&temp);
- *    }
- *  }
+ *   // parse local_u16Len bytes
  * }
  * @endcode
  *
  * <br><b> - HISTORY OF CHANGES - </b>
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 17/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
  * </table><br><br>
  * <hr>
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_ReceiveSendAppCommMessage(HAL_WRAPPER_AppCommMsg_t* arg_AppCommMsg_t);
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommFrame(uint8_t* arg_pu8Frame, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len);
 
 /**
- *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommMessage(uint8_t* arg_pu8Msg);
- *  \b Description                              :       this functions is used as a wrapper function to get 1 byte of received message.
- *  @param  arg_pu8Msg [OUT]                    :       base address of variable to put inside it the  of message received.
- *  @note                                       :       it reads a byte from UART to know if it's a valid message header or not.
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommFrame(HAL_WRAPPER_CommFrame_t* arg_pFrame);
+ *  \b Description                              :       this functions is used as a wrapper function to queue a frame to the other board, the frame is sent by DMA
+ *                                                      from its own memory and its callback is called once it's sent.
+ *  @param  arg_pFrame [IN/OUT]                 :       the frame to send (refer to @MCAL_UART_TxFrame_t in "MCAL_UART.h").
+ *  @note                                       :       the frame and its data must stay untouched until its callback is called, the callback runs in an interrupt.
  *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
  *  \b POST-CONDITION                           :       None.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
+ *  @return                                     :       HAL_WRAPPER_STAT_APP_BOARD_BSY if the transmit queue is full, else one of error states (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommTxStats(HAL_WRAPPER_CommTxStats_t* arg_pStats)
  *
  *  \b Example:
  * @code
  * 
  * #include "HAL_wrapper.h"
  * 
- * void func(void)
+ * void sent(HAL_WRAPPER_CommFrame_t* frame)
  * {
- *  // callback code
- *  uint8_t message;
- *  HAL_WRAPPER_GetCommMessage(&message);
- *  if(DATA_TYPE_INFO == message)
- *  {
- *    // a info message header is received
- *  }
+ *   // the buffer of the frame can be filled again
  * }
  * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllHW();
- *  if(HAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = HAL_WRAPPER_SetAppCommRecCallBack(func);
- *    if(HAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *    
- *    }
- *  }
+ * uint8_t message[8];
+ * HAL_WRAPPER_CommFrame_t frame = {.data = message, .dataLen = sizeof(message), .callBack = sent};
+ * HAL_WRAPPER_ErrStat_t local_errState = HAL_WRAPPER_SendCommFrame(&frame);
+ * if(HAL_WRAPPER_STAT_OK == local_errState)
+ * {
+ *   // message is being sent
  * }
  * @endcode
  *
  * <br><b> - HISTORY OF CHANGES - </b>
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 20/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
  * </table><br><br>
  * <hr>
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommMessage(uint8_t* arg_pu8Msg);
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommFrame(HAL_WRAPPER_CommFrame_t* arg_pFrame);
 
 /**
- *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommMessage(uint8_t arg_pu8Msg);
- *  \b Description                              :       this functions is used as a wrapper function to send 1 byte of message.
- *  @param  arg_pu8Msg [IN]                     :       value of data to send to the comm gateway with the other board.
+ *  \b function                                 :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommTxStats(HAL_WRAPPER_CommTxStats_t* arg_pStats);
+ *  \b Description                              :       this functions is used as a wrapper function to get the counters of the frames sent to the other board
+ *                                                      (count, bytes, time the link was busy and latency).
+ *  @param  arg_pStats [OUT]                    :       base address to store the counters in.
  *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
+ *  \b PRE-CONDITION                            :       None.
  *  \b POST-CONDITION                           :       None.
  *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
+ *  @see                                        :       HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommFrame(HAL_WRAPPER_CommFrame_t* arg_pFrame)
  *
  *  \b Example:
  * @code
  * 
  * #include "HAL_wrapper.h"
  * 
- * void func(void)
- * {
- *  // callback code
- *  uint8_t message = 22;
- *  HAL_WRAPPER_ErrStat_t local_errState = HAL_WRAPPER_SendCommMessage(message);
- *  if(HAL_WRAPPER_STAT_OK == local_errState)
- *  {
- *    // message is send
- *  }
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = HAL_Config_ConfigAllHW();
- *  if(HAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = HAL_WRAPPER_SetAppCommRecCallBack(func);
- *    if(HAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *    
- *    }
- *  }
- * }
+ * HAL_WRAPPER_CommTxStats_t stats = {0};
+ * HAL_WRAPPER_GetCommTxStats(&stats);
+ * printf("sent %lu bytes, max latency %lu us\r\n", stats.bytes, stats.maxLatencyUS);
  * @endcode
  *
  * <br><b> - HISTORY OF CHANGES - </b>
  * <table align="left" style="width:800px">
  * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 20/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
  * </table><br><br>
  * <hr>
  */
-HAL_WRAPPER_ErrStat_t HAL_WRAPPER_SendCommMessage(uint8_t arg_pu8Msg);
+HAL_WRAPPER_ErrStat_t HAL_WRAPPER_GetCommTxStats(HAL_WRAPPER_CommTxStats_t* arg_pStats);
 
 /*** End of File **************************************************************/
 #endif /*HAL_WRAPPER_HEADER_H_*/
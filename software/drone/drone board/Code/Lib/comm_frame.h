@@ -0,0 +1,379 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   framing of the inter-board link                                                                             |
+ * |    @file           :   comm_frame.h                                                                                                |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   COBS framing with version, sequence number and CRC-16 of the messages between the boards                    |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef LIB_COMM_FRAME_H_
+#define LIB_COMM_FRAME_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains standard integer types
+ */
+#include "stdint.h"
+
+/**
+ * @reason: contains defintion for inline and NULL
+ */
+#include "common.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: version of the frame layout, a frame of another version is dropped by the receiver
+ */
+#define LIB_COMM_FRAME_VERSION              (1)
+
+/**
+ * @brief: byte starting and ending every frame, COBS guarantees it doesn't appear anywhere else in the frame
+ */
+#define LIB_COMM_FRAME_DELIMITER            (0x00)
+
+/**
+ * @brief: bytes added to the payload before encoding (version, sequence number and CRC-16)
+ */
+#define LIB_COMM_FRAME_HEADER_LEN           (2)
+#define LIB_COMM_FRAME_CRC_LEN              (2)
+#define LIB_COMM_FRAME_OVERHEAD_LEN         (LIB_COMM_FRAME_HEADER_LEN + LIB_COMM_FRAME_CRC_LEN)
+
+/**
+ * @brief: initial value of the CRC-16/CCITT-FALSE (polynomial 0x1021, not reflected, no final xor)
+ */
+#define LIB_COMM_FRAME_CRC_INIT             (0xFFFF)
+
+/******************************************************************************
+ * Configuration Constants
+ *******************************************************************************/
+
+/**
+ * @brief: largest payload a frame can carry, sets the size of the decoder buffer
+ */
+#define LIB_COMM_FRAME_MAX_PAYLOAD_LEN      (64)
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/**
+ * @brief: worst case size of the encoded frame of a payload of 'PAYLOAD_LEN' bytes including its 2 delimiters, COBS adds one
+ *         byte every 254 bytes and one at the start
+ */
+#define LIB_COMM_FRAME_ENCODED_LEN(PAYLOAD_LEN)     ((PAYLOAD_LEN) + LIB_COMM_FRAME_OVERHEAD_LEN + \
+                                                     ((PAYLOAD_LEN) + LIB_COMM_FRAME_OVERHEAD_LEN) / 254 + 3)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: counters of a decoder, every frame that isn't delivered is counted once in one of the error counters
+ */
+typedef struct {
+  uint32_t frames;                  /**< valid frames delivered */
+  uint32_t crcErrors;               /**< frames dropped as their CRC doesn't match (corrupted or cut bytes) */
+  uint32_t formatErrors;            /**< frames dropped as they are too short, of another version or their COBS blocks are cut */
+  uint32_t overflows;               /**< frames dropped as they don't fit in the decoder (a lost delimiter joining two frames) */
+  uint32_t lostFrames;              /**< frames missing in the sequence numbers of the delivered frames */
+} LIB_COMM_FRAME_Stats_t;
+
+/**
+ * @brief: state of a decoder fed byte by byte, the decoded frame is held in 'buffer' until the next byte is fed
+ */
+typedef struct {
+  uint8_t buffer[LIB_COMM_FRAME_MAX_PAYLOAD_LEN + LIB_COMM_FRAME_OVERHEAD_LEN];  /**< decoded bytes of the current frame */
+  uint16_t len;                     /**< number of decoded bytes in 'buffer' */
+  uint8_t blockCode;                /**< code of the current COBS block, 0 before the first block of a frame */
+  uint8_t blockLeft;                /**< bytes left in the current COBS block */
+  uint8_t discard;                  /**< the current frame overflowed, its bytes are dropped until the delimiter */
+  uint8_t synced;                   /**< a frame was delivered, 'lastSeq' is valid */
+  uint8_t lastSeq;                  /**< sequence number of the last delivered frame */
+  LIB_COMM_FRAME_Stats_t stats;     /**< counters of the decoder */
+} LIB_COMM_FRAME_Decoder_t;
+
+/******************************************************************************
+ * Variables
+ *******************************************************************************/
+
+/**
+ * @brief: CRC-16/CCITT-FALSE of each nibble, the CRC is updated 4 bits at a time to keep the table small
+ */
+static const uint16_t LIB_COMM_FRAME_Crc16Nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                     :       static __in uint16_t LIB_COMM_FRAME_u16Crc16(const uint8_t* args_pu8Data, uint16_t args_u16Len, uint16_t args_u16Crc)
+ *  \b Description                  :       updates a CRC-16/CCITT-FALSE with the given bytes.
+ *  @param    args_pu8Data          :       bytes to add to the CRC.
+ *  @param    args_u16Len           :       number of bytes.
+ *  @param    args_u16Crc           :       CRC of the previous bytes, LIB_COMM_FRAME_CRC_INIT for the first ones.
+ *  @return                         :       the updated CRC.
+ */
+static __in uint16_t LIB_COMM_FRAME_u16Crc16(const uint8_t* args_pu8Data, uint16_t args_u16Len, uint16_t args_u16Crc)
+{
+    while(args_u16Len--)
+    {
+        args_u16Crc = (uint16_t)(args_u16Crc << 4) ^ LIB_COMM_FRAME_Crc16Nibble[(args_u16Crc >> 12) ^ (*args_pu8Data >> 4)];
+        args_u16Crc = (uint16_t)(args_u16Crc << 4) ^ LIB_COMM_FRAME_Crc16Nibble[(args_u16Crc >> 12) ^ (*args_pu8Data & 0x0F)];
+        args_pu8Data++;
+    }
+    return args_u16Crc;
+}
+
+/**
+ *  \b function                     :       static __in void LIB_COMM_FRAME_vidCobsPut(uint8_t* args_pu8Frame, uint16_t* args_pu16Index, uint16_t* args_pu16CodeIndex, uint8_t args_u8Byte)
+ *  \b Description                  :       adds one byte to a COBS encoded frame, a zero byte closes the current block and a block of
+ *                                          254 non zero bytes is closed on its own.
+ *  @param    args_pu8Frame         :       the encoded frame.
+ *  @param    args_pu16Index        :       next free position in the frame.
+ *  @param    args_pu16CodeIndex    :       position of the code of the current block.
+ *  @param    args_u8Byte           :       the byte to add.
+ */
+static __in void LIB_COMM_FRAME_vidCobsPut(uint8_t* args_pu8Frame, uint16_t* args_pu16Index, uint16_t* args_pu16CodeIndex, uint8_t args_u8Byte)
+{
+    if(LIB_COMM_FRAME_DELIMITER != args_u8Byte)
+    {
+        args_pu8Frame[(*args_pu16Index)++] = args_u8Byte;
+        args_pu8Frame[*args_pu16CodeIndex]++;
+    }
+
+    if(LIB_COMM_FRAME_DELIMITER == args_u8Byte || 0xFF == args_pu8Frame[*args_pu16CodeIndex])
+    {
+        *args_pu16CodeIndex = (*args_pu16Index)++;
+        args_pu8Frame[*args_pu16CodeIndex] = 1;
+    }
+}
+
+/**
+ *  \b function                     :       static __in uint16_t LIB_COMM_FRAME_u16Encode(uint8_t args_u8Seq, const uint8_t* args_pu8Payload, uint16_t args_u16PayloadLen, uint8_t* args_pu8Frame)
+ *  \b Description                  :       builds the frame [version, sequence number, payload, CRC-16 (little endian)], encodes it with COBS
+ *                                          and puts it between 2 delimiters.
+ *  @param    args_u8Seq            :       sequence number of the frame, incremented by the sender for every frame.
+ *  @param    args_pu8Payload       :       bytes to send.
+ *  @param    args_u16PayloadLen    :       number of bytes to send, at most LIB_COMM_FRAME_MAX_PAYLOAD_LEN.
+ *  @param    args_pu8Frame         :       buffer of at least LIB_COMM_FRAME_ENCODED_LEN(args_u16PayloadLen) bytes for the encoded frame.
+ *  @note                           :       the receiver can start decoding anywhere in a stream of frames, it's in sync from the first
+ *                                          delimiter on. the leading delimiter keeps the frame whole when the end of the frame before it
+ *                                          is lost, it costs one byte per frame.
+ *  @return                         :       length of the encoded frame including the delimiters, 0 if the payload is too long.
+ */
+static __in uint16_t LIB_COMM_FRAME_u16Encode(uint8_t args_u8Seq, const uint8_t* args_pu8Payload, uint16_t args_u16PayloadLen, uint8_t* args_pu8Frame)
+{
+    uint8_t local_u8Header[LIB_COMM_FRAME_HEADER_LEN] = {LIB_COMM_FRAME_VERSION, args_u8Seq};
+    uint16_t local_u16Crc = LIB_COMM_FRAME_CRC_INIT;
+    uint16_t local_u16Index = 2;
+    uint16_t local_u16CodeIndex = 1;
+    uint16_t i = 0;
+
+    if(LIB_COMM_FRAME_MAX_PAYLOAD_LEN < args_u16PayloadLen || NULL == args_pu8Frame || (NULL == args_pu8Payload && 0 != args_u16PayloadLen))
+    {
+        return 0;
+    }
+
+    local_u16Crc = LIB_COMM_FRAME_u16Crc16(local_u8Header, LIB_COMM_FRAME_HEADER_LEN, local_u16Crc);
+    local_u16Crc = LIB_COMM_FRAME_u16Crc16(args_pu8Payload, args_u16PayloadLen, local_u16Crc);
+
+    args_pu8Frame[0] = LIB_COMM_FRAME_DELIMITER;
+    args_pu8Frame[1] = 1;
+    for(i = 0; i < LIB_COMM_FRAME_HEADER_LEN; i++)
+    {
+        LIB_COMM_FRAME_vidCobsPut(args_pu8Frame, &local_u16Index, &local_u16CodeIndex, local_u8Header[i]);
+    }
+    for(i = 0; i < args_u16PayloadLen; i++)
+    {
+        LIB_COMM_FRAME_vidCobsPut(args_pu8Frame, &local_u16Index, &local_u16CodeIndex, args_pu8Payload[i]);
+    }
+    LIB_COMM_FRAME_vidCobsPut(args_pu8Frame, &local_u16Index, &local_u16CodeIndex, (uint8_t)(local_u16Crc & 0xFF));
+    LIB_COMM_FRAME_vidCobsPut(args_pu8Frame, &local_u16Index, &local_u16CodeIndex, (uint8_t)(local_u16Crc >> 8));
+
+    args_pu8Frame[local_u16Index++] = LIB_COMM_FRAME_DELIMITER;
+
+    return local_u16Index;
+}
+
+/**
+ *  \b function                     :       static __in void LIB_COMM_FRAME_vidDecoderInit(LIB_COMM_FRAME_Decoder_t* args_pDecoder)
+ *  \b Description                  :       clears the decoder and its counters.
+ *  @param    args_pDecoder         :       the decoder.
+ */
+static __in void LIB_COMM_FRAME_vidDecoderInit(LIB_COMM_FRAME_Decoder_t* args_pDecoder)
+{
+    LIB_COMM_FRAME_Stats_t local_Stats_t = {0};
+
+    args_pDecoder->len = 0;
+    args_pDecoder->blockCode = 0;
+    args_pDecoder->blockLeft = 0;
+    args_pDecoder->discard = 0;
+    args_pDecoder->synced = 0;
+    args_pDecoder->lastSeq = 0;
+    args_pDecoder->stats = local_Stats_t;
+}
+
+/**
+ *  \b function                     :       static __in uint8_t LIB_COMM_FRAME_u8Decode(LIB_COMM_FRAME_Decoder_t* args_pDecoder, uint8_t args_u8Byte)
+ *  \b Description                  :       feeds one received byte to the decoder, at the delimiter the frame is checked (COBS blocks, length,
+ *                                          CRC and version) and delivered if it's valid.
+ *  @param    args_pDecoder         :       the decoder.
+ *  @param    args_u8Byte           :       the received byte.
+ *  @note                           :       a corrupted frame is dropped at its delimiter so the next frame is decoded normally, a lost delimiter
+ *                                          is made up by the leading delimiter of the next frame. the payload of a delivered frame is read with
+ *                                          LIB_COMM_FRAME_pu8Payload before the next byte is fed.
+ *  @return                         :       1 if a valid frame was completed by this byte, else 0.
+ */
+static __in uint8_t LIB_COMM_FRAME_u8Decode(LIB_COMM_FRAME_Decoder_t* args_pDecoder, uint8_t args_u8Byte)
+{
+    uint8_t local_u8Delivered = 0;
+    uint8_t local_u8Seq = 0;
+    uint8_t local_u8ImplicitZero = 0;
+    uint16_t local_u16Crc = 0;
+
+    if(LIB_COMM_FRAME_DELIMITER == args_u8Byte)
+    {
+        // an empty frame (2 delimiters in a row) is only a resynchronization point
+        if(0 == args_pDecoder->discard && 0 != args_pDecoder->blockCode)
+        {
+            if(0 != args_pDecoder->blockLeft || LIB_COMM_FRAME_OVERHEAD_LEN > args_pDecoder->len)
+            {
+                args_pDecoder->stats.formatErrors++;
+            }
+            else
+            {
+                local_u16Crc = LIB_COMM_FRAME_u16Crc16(args_pDecoder->buffer, args_pDecoder->len - LIB_COMM_FRAME_CRC_LEN, LIB_COMM_FRAME_CRC_INIT);
+                if((uint8_t)(local_u16Crc & 0xFF) != args_pDecoder->buffer[args_pDecoder->len - 2]
+                   || (uint8_t)(local_u16Crc >> 8) != args_pDecoder->buffer[args_pDecoder->len - 1])
+                {
+                    args_pDecoder->stats.crcErrors++;
+                }
+                else if(LIB_COMM_FRAME_VERSION != args_pDecoder->buffer[0])
+                {
+                    args_pDecoder->stats.formatErrors++;
+                }
+                else
+                {
+                    local_u8Seq = args_pDecoder->buffer[1];
+                    if(args_pDecoder->synced)
+                    {
+                        args_pDecoder->stats.lostFrames += (uint8_t)(local_u8Seq - args_pDecoder->lastSeq - 1);
+                    }
+                    args_pDecoder->lastSeq = local_u8Seq;
+                    args_pDecoder->synced = 1;
+                    args_pDecoder->stats.frames++;
+                    local_u8Delivered = 1;
+                }
+            }
+        }
+
+        // keep the decoded bytes of a delivered frame for LIB_COMM_FRAME_pu8Payload until the next byte
+        if(0 == local_u8Delivered)
+        {
+            args_pDecoder->len = 0;
+        }
+        args_pDecoder->blockCode = 0;
+        args_pDecoder->blockLeft = 0;
+        args_pDecoder->discard = 0;
+        return local_u8Delivered;
+    }
+
+    // first byte of a new frame after a delivered one
+    if(0 == args_pDecoder->blockCode)
+    {
+        args_pDecoder->len = 0;
+    }
+
+    if(args_pDecoder->discard)
+    {
+        return 0;
+    }
+
+    if(0 == args_pDecoder->blockLeft)
+    {
+        // every block but the first and the full ones stands for a zero byte that was removed by the encoder
+        local_u8ImplicitZero = (0 != args_pDecoder->blockCode && 0xFF != args_pDecoder->blockCode);
+        args_pDecoder->blockCode = args_u8Byte;
+        args_pDecoder->blockLeft = args_u8Byte - 1;
+        if(0 == local_u8ImplicitZero)
+        {
+            return 0;
+        }
+        args_u8Byte = LIB_COMM_FRAME_DELIMITER;
+    }
+    else
+    {
+        args_pDecoder->blockLeft--;
+    }
+
+    if(sizeof(args_pDecoder->buffer) <= args_pDecoder->len)
+    {
+        args_pDecoder->discard = 1;
+        args_pDecoder->stats.overflows++;
+        return 0;
+    }
+    args_pDecoder->buffer[args_pDecoder->len++] = args_u8Byte;
+
+    return 0;
+}
+
+/**
+ *  \b function                     :       static __in const uint8_t* LIB_COMM_FRAME_pu8Payload(const LIB_COMM_FRAME_Decoder_t* args_pDecoder, uint16_t* args_pu16Len)
+ *  \b Description                  :       gives the payload of the frame just delivered by LIB_COMM_FRAME_u8Decode.
+ *  @param    args_pDecoder         :       the decoder.
+ *  @param    args_pu16Len          :       number of bytes of the payload.
+ *  @return                         :       address of the payload inside the decoder, valid until the next byte is fed.
+ */
+static __in const uint8_t* LIB_COMM_FRAME_pu8Payload(const LIB_COMM_FRAME_Decoder_t* args_pDecoder, uint16_t* args_pu16Len)
+{
+    *args_pu16Len = args_pDecoder->len - LIB_COMM_FRAME_OVERHEAD_LEN;
+    return &args_pDecoder->buffer[LIB_COMM_FRAME_HEADER_LEN];
+}
+
+/*** End of File **************************************************************/
+#endif /*LIB_COMM_FRAME_H_*/
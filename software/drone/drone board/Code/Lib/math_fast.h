@@ -0,0 +1,260 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   fast math                                                                                                   |
+ * |    @file           :   math_fast.h                                                                                                 |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   single precision approximations with bounded error for atan2, asin, sin/cos and inverse square root         |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef LIB_MATH_FAST_H_
+#define LIB_MATH_FAST_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains standard integer types
+ */
+#include "stdint.h"
+
+/**
+ * @reason: contains defintion for inline
+ */
+#include "common.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: pi related constants in single precision
+ */
+#define LIB_MATH_FAST_PI                (3.14159265f)
+#define LIB_MATH_FAST_HALF_PI           (1.57079633f)
+#define LIB_MATH_FAST_RAD_TO_DEG        (57.2957795f)
+#define LIB_MATH_FAST_DEG_TO_RAD        (0.0174532925f)
+
+/**
+ * @brief: coefficients of the odd minimax polynomial of atan(z) for |z| <= 1, max error 1e-5 rad
+ */
+#define LIB_MATH_FAST_ATAN_C1           (0.99997726f)
+#define LIB_MATH_FAST_ATAN_C3           (-0.33262347f)
+#define LIB_MATH_FAST_ATAN_C5           (0.19354346f)
+#define LIB_MATH_FAST_ATAN_C7           (-0.11643287f)
+#define LIB_MATH_FAST_ATAN_C9           (0.05265332f)
+#define LIB_MATH_FAST_ATAN_C11          (-0.01172120f)
+
+/******************************************************************************
+ * Configuration Constants
+ *******************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/******************************************************************************
+ * Variables
+ *******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                     :       static __in float LIB_MATH_FAST_f32InvSqrt(float args_f32Value)
+ *  \b Description                  :       computes 1/sqrt(x) from an exponent halving initial guess refined with 2 newton iterations.
+ *  @param    args_f32Value         :       the value, must be positive.
+ *  @note                           :       relative error is below 5e-6, only multiplications are used (no division).
+ *  @return                         :       1/sqrt(x).
+ */
+static __in float LIB_MATH_FAST_f32InvSqrt(float args_f32Value)
+{
+    union {
+        float f32;
+        uint32_t u32;
+    } local_bits;
+    float local_f32Half = 0.5f * args_f32Value;
+
+    local_bits.f32 = args_f32Value;
+    local_bits.u32 = 0x5F375A86UL - (local_bits.u32 >> 1);
+    local_bits.f32 = local_bits.f32 * (1.5f - local_f32Half * local_bits.f32 * local_bits.f32);
+    local_bits.f32 = local_bits.f32 * (1.5f - local_f32Half * local_bits.f32 * local_bits.f32);
+
+    return local_bits.f32;
+}
+
+/**
+ *  \b function                     :       static __in float LIB_MATH_FAST_f32Sqrt(float args_f32Value)
+ *  \b Description                  :       computes sqrt(x) as x * (1/sqrt(x)).
+ *  @param    args_f32Value         :       the value, negative values and zero return zero.
+ *  @note                           :       relative error is below 5e-6.
+ *  @return                         :       sqrt(x).
+ */
+static __in float LIB_MATH_FAST_f32Sqrt(float args_f32Value)
+{
+    if(args_f32Value <= 0.0f)
+    {
+        return 0.0f;
+    }
+    return args_f32Value * LIB_MATH_FAST_f32InvSqrt(args_f32Value);
+}
+
+/**
+ *  \b function                     :       static __in float LIB_MATH_FAST_f32Atan2(float args_f32Y, float args_f32X)
+ *  \b Description                  :       computes atan2(y, x), the ratio is taken so that it is always in [-1, 1] and the
+ *                                          polynomial is applied then the result is moved to the right octant.
+ *  @param    args_f32Y             :       y component.
+ *  @param    args_f32X             :       x component.
+ *  @note                           :       max error is 1e-5 rad, atan2(0, 0) returns 0.
+ *  @return                         :       the angle in radians in the range [-pi, pi].
+ */
+static __in float LIB_MATH_FAST_f32Atan2(float args_f32Y, float args_f32X)
+{
+    float local_f32AbsX = (args_f32X < 0.0f) ? -args_f32X : args_f32X;
+    float local_f32AbsY = (args_f32Y < 0.0f) ? -args_f32Y : args_f32Y;
+    float local_f32Ratio, local_f32Square, local_f32Angle;
+
+    if(0.0f == local_f32AbsX && 0.0f == local_f32AbsY)
+    {
+        return 0.0f;
+    }
+
+    // atan of the smaller over the larger component
+    if(local_f32AbsY > local_f32AbsX)
+    {
+        local_f32Ratio = local_f32AbsX / local_f32AbsY;
+    }
+    else
+    {
+        local_f32Ratio = local_f32AbsY / local_f32AbsX;
+    }
+
+    local_f32Square = local_f32Ratio * local_f32Ratio;
+    local_f32Angle = local_f32Ratio * (LIB_MATH_FAST_ATAN_C1 + local_f32Square * (LIB_MATH_FAST_ATAN_C3 + local_f32Square * (LIB_MATH_FAST_ATAN_C5 +
+                     local_f32Square * (LIB_MATH_FAST_ATAN_C7 + local_f32Square * (LIB_MATH_FAST_ATAN_C9 + local_f32Square * LIB_MATH_FAST_ATAN_C11)))));
+
+    // move the result to the right octant then the right quadrant
+    if(local_f32AbsY > local_f32AbsX)
+    {
+        local_f32Angle = LIB_MATH_FAST_HALF_PI - local_f32Angle;
+    }
+    if(args_f32X < 0.0f)
+    {
+        local_f32Angle = LIB_MATH_FAST_PI - local_f32Angle;
+    }
+    if(args_f32Y < 0.0f)
+    {
+        local_f32Angle = -local_f32Angle;
+    }
+
+    return local_f32Angle;
+}
+
+/**
+ *  \b function                     :       static __in float LIB_MATH_FAST_f32Asin(float args_f32Value)
+ *  \b Description                  :       computes asin(x) as atan2(x, sqrt(1 - x^2)).
+ *  @param    args_f32Value         :       the value, clamped to [-1, 1].
+ *  @note                           :       max error is 2e-5 rad.
+ *  @return                         :       the angle in radians in the range [-pi/2, pi/2].
+ */
+static __in float LIB_MATH_FAST_f32Asin(float args_f32Value)
+{
+    if(args_f32Value >= 1.0f)
+    {
+        return LIB_MATH_FAST_HALF_PI;
+    }
+    else if(args_f32Value <= -1.0f)
+    {
+        return -LIB_MATH_FAST_HALF_PI;
+    }
+    return LIB_MATH_FAST_f32Atan2(args_f32Value, LIB_MATH_FAST_f32Sqrt((1.0f - args_f32Value) * (1.0f + args_f32Value)));
+}
+
+/**
+ *  \b function                     :       static __in void LIB_MATH_FAST_f32SinCos(float args_f32Angle, float* args_pf32Sin, float* args_pf32Cos)
+ *  \b Description                  :       computes sin and cos together, the angle is reduced to [-pi/4, pi/4] where 2 short
+ *                                          taylor polynomials are accurate then the quadrant is restored by swapping and negating.
+ *  @param    args_f32Angle         :       the angle in radians, accurate for |angle| < 1000.
+ *  @param    args_pf32Sin          :       [OUT] sin of the angle.
+ *  @param    args_pf32Cos          :       [OUT] cos of the angle.
+ *  @note                           :       max error is 1e-6.
+ *  @return                         :       None.
+ */
+static __in void LIB_MATH_FAST_f32SinCos(float args_f32Angle, float* args_pf32Sin, float* args_pf32Cos)
+{
+    int32_t local_s32Quadrant;
+    float local_f32Square, local_f32Sin, local_f32Cos;
+
+    // quadrant = round(angle / (pi/2)), the reduction is done in 2 steps to keep the precision of pi/2
+    local_f32Square = args_f32Angle * (2.0f / LIB_MATH_FAST_PI);
+    local_s32Quadrant = (int32_t)(local_f32Square + ((local_f32Square >= 0.0f) ? 0.5f : -0.5f));
+    args_f32Angle = (args_f32Angle - (float)local_s32Quadrant * 1.5703125f) - (float)local_s32Quadrant * 4.83826794e-4f;
+
+    local_f32Square = args_f32Angle * args_f32Angle;
+    local_f32Sin = args_f32Angle * (1.0f + local_f32Square * (-1.0f / 6.0f + local_f32Square * (1.0f / 120.0f + local_f32Square * (-1.0f / 5040.0f))));
+    local_f32Cos = 1.0f + local_f32Square * (-0.5f + local_f32Square * (1.0f / 24.0f + local_f32Square * (-1.0f / 720.0f + local_f32Square * (1.0f / 40320.0f))));
+
+    switch(local_s32Quadrant & 3)
+    {
+        case 0:
+            *args_pf32Sin = local_f32Sin;
+            *args_pf32Cos = local_f32Cos;
+            break;
+        case 1:
+            *args_pf32Sin = local_f32Cos;
+            *args_pf32Cos = -local_f32Sin;
+            break;
+        case 2:
+            *args_pf32Sin = -local_f32Sin;
+            *args_pf32Cos = -local_f32Cos;
+            break;
+        default:
+            *args_pf32Sin = -local_f32Cos;
+            *args_pf32Cos = local_f32Sin;
+            break;
+    }
+}
+
+/*** End of File **************************************************************/
+#endif /*LIB_MATH_FAST_H_*/
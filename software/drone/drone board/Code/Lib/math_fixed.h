@@ -0,0 +1,478 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   fixed point math                                                                                            |
+ * |    @file           :   math_fixed.h                                                                                                |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   fixed point (Q15/Q16.16/Q31) arithmetic and CORDIC trigonometry for targets without FPU                     |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           added asin and inverse square root.                             |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef LIB_MATH_FIXED_H_
+#define LIB_MATH_FIXED_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains standard integer types
+ */
+#include "stdint.h"
+
+/**
+ * @reason: contains defintion for inline
+ */
+#include "common.h"
+
+/**
+ * @reason: contains LIB_MATH_BTT_u8GetMSBSetPos used to normalize CORDIC inputs
+ */
+#include "math_btt.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: 1.0 in the different fixed point formats
+ */
+#define LIB_MATH_FIXED_Q15_ONE              (32768L)
+#define LIB_MATH_FIXED_Q16_ONE              (65536L)
+#define LIB_MATH_FIXED_Q31_ONE              (2147483648.0)
+
+/**
+ * @brief: number of CORDIC iterations, each iteration adds around one bit of precision to the angle
+ */
+#define LIB_MATH_FIXED_CORDIC_ITERATIONS    (16)
+
+/**
+ * @brief: CORDIC gain compensation (product of cos(atan(2^-i))) in Q30
+ */
+#define LIB_MATH_FIXED_CORDIC_K_Q30         (652032874L)
+
+/******************************************************************************
+ * Configuration Constants
+ *******************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/**
+ * @brief: conversions between floating point and fixed point values
+ * @note: meant for constant expressions (gains, noise values, scales) so the compiler does the floating point math
+ */
+#define LIB_MATH_FIXED_FLOAT_TO_Q15(X)      ((LIB_MATH_FIXED_q15_t)((X) * 32768.0 + (((X) >= 0) ? 0.5 : -0.5)))
+#define LIB_MATH_FIXED_FLOAT_TO_Q16(X)      ((LIB_MATH_FIXED_q16_t)((X) * 65536.0 + (((X) >= 0) ? 0.5 : -0.5)))
+#define LIB_MATH_FIXED_FLOAT_TO_Q31(X)      ((LIB_MATH_FIXED_q31_t)((X) * 2147483648.0 + (((X) >= 0) ? 0.5 : -0.5)))
+#define LIB_MATH_FIXED_FLOAT_TO_Q30(X)      ((int32_t)((X) * 1073741824.0 + (((X) >= 0) ? 0.5 : -0.5)))
+#define LIB_MATH_FIXED_Q16_TO_FLOAT(X)      ((float)(X) * (1.0f / 65536.0f))
+
+/**
+ * @brief: conversions between integers and Q16.16
+ */
+#define LIB_MATH_FIXED_INT_TO_Q16(X)        ((LIB_MATH_FIXED_q16_t)(X) * LIB_MATH_FIXED_Q16_ONE)
+#define LIB_MATH_FIXED_Q16_TO_INT(X)        ((int32_t)(X) >> 16)
+
+/**
+ * @brief: conversions between Q15 and Q16.16
+ */
+#define LIB_MATH_FIXED_Q15_TO_Q16(X)        ((LIB_MATH_FIXED_q16_t)(X) * 2)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: signed fraction in [-1, 1) with 15 fractional bits
+ */
+typedef int16_t LIB_MATH_FIXED_q15_t;
+
+/**
+ * @brief: signed fraction in [-1, 1) with 31 fractional bits
+ */
+typedef int32_t LIB_MATH_FIXED_q31_t;
+
+/**
+ * @brief: signed number in [-32768, 32768) with 16 fractional bits, used for engineering values as degrees and degrees/s
+ */
+typedef int32_t LIB_MATH_FIXED_q16_t;
+
+/******************************************************************************
+ * Variables
+ *******************************************************************************/
+
+/**
+ * @brief: atan(2^-i) in degrees as Q16.16, used by the CORDIC functions
+ */
+static const LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_CordicAtanDeg[LIB_MATH_FIXED_CORDIC_ITERATIONS] = {
+    LIB_MATH_FIXED_FLOAT_TO_Q16(45.0),          LIB_MATH_FIXED_FLOAT_TO_Q16(26.565051177),
+    LIB_MATH_FIXED_FLOAT_TO_Q16(14.036243468),  LIB_MATH_FIXED_FLOAT_TO_Q16(7.125016349),
+    LIB_MATH_FIXED_FLOAT_TO_Q16(3.576334375),   LIB_MATH_FIXED_FLOAT_TO_Q16(1.789910608),
+    LIB_MATH_FIXED_FLOAT_TO_Q16(0.895173710),   LIB_MATH_FIXED_FLOAT_TO_Q16(0.447614171),
+    LIB_MATH_FIXED_FLOAT_TO_Q16(0.223810500),   LIB_MATH_FIXED_FLOAT_TO_Q16(0.111905677),
+    LIB_MATH_FIXED_FLOAT_TO_Q16(0.055952892),   LIB_MATH_FIXED_FLOAT_TO_Q16(0.027976453),
+    LIB_MATH_FIXED_FLOAT_TO_Q16(0.013988227),   LIB_MATH_FIXED_FLOAT_TO_Q16(0.006994114),
+    LIB_MATH_FIXED_FLOAT_TO_Q16(0.003497057),   LIB_MATH_FIXED_FLOAT_TO_Q16(0.001748528),
+};
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                     :       static __in int32_t LIB_MATH_FIXED_s32Saturate(int64_t args_s64Value)
+ *  \b Description                  :       clamps a 64-bit intermediate result into the int32_t range.
+ *  @param    args_s64Value         :       the value to clamp.
+ *  @return                         :       the clamped value.
+ */
+static __in int32_t LIB_MATH_FIXED_s32Saturate(int64_t args_s64Value)
+{
+    if(args_s64Value > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    else if(args_s64Value < -INT32_MAX - 1)
+    {
+        return -INT32_MAX - 1;
+    }
+    return (int32_t)args_s64Value;
+}
+
+/**
+ *  \b function                     :       static __in LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_q16FromFloat(float args_f32Value)
+ *  \b Description                  :       converts a run time float value to Q16.16 with rounding and saturation, single precision only.
+ *  @param    args_f32Value         :       the value to convert.
+ *  @return                         :       the value in Q16.16.
+ */
+static __in LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_q16FromFloat(float args_f32Value)
+{
+    args_f32Value *= 65536.0f;
+    if(args_f32Value >= 2147483520.0f)
+    {
+        return INT32_MAX;
+    }
+    else if(args_f32Value <= -2147483648.0f)
+    {
+        return -INT32_MAX - 1;
+    }
+    return (LIB_MATH_FIXED_q16_t)(args_f32Value + ((args_f32Value >= 0) ? 0.5f : -0.5f));
+}
+
+/**
+ *  \b function                     :       static __in int32_t LIB_MATH_FIXED_s32MulShift(int32_t args_s32A, int32_t args_s32B, uint8_t args_u8Shift)
+ *  \b Description                  :       computes (A * B) >> shift with rounding and saturation, the product of a Qm and a Qn number
+ *                                          shifted by n gives back a Qm number.
+ *  @param    args_s32A             :       first operand.
+ *  @param    args_s32B             :       second operand.
+ *  @param    args_u8Shift          :       number of fractional bits to drop from the product (1 to 62).
+ *  @note                           :       on RV32IM the 64-bit product is a MUL + MULH pair, no library call is involved.
+ *  @return                         :       the rounded and saturated product.
+ */
+static __in int32_t LIB_MATH_FIXED_s32MulShift(int32_t args_s32A, int32_t args_s32B, uint8_t args_u8Shift)
+{
+    int64_t local_s64Product = (int64_t)args_s32A * args_s32B;
+    local_s64Product += (int64_t)1 << (args_u8Shift - 1);
+    return LIB_MATH_FIXED_s32Saturate(local_s64Product >> args_u8Shift);
+}
+
+/**
+ *  \b function                     :       static __in LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_q16Mul(LIB_MATH_FIXED_q16_t args_q16A, LIB_MATH_FIXED_q16_t args_q16B)
+ *  \b Description                  :       multiplies 2 Q16.16 numbers.
+ *  @return                         :       A * B in Q16.16 (saturated).
+ */
+static __in LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_q16Mul(LIB_MATH_FIXED_q16_t args_q16A, LIB_MATH_FIXED_q16_t args_q16B)
+{
+    return LIB_MATH_FIXED_s32MulShift(args_q16A, args_q16B, 16);
+}
+
+/**
+ *  \b function                     :       static __in LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_q16Div(LIB_MATH_FIXED_q16_t args_q16A, LIB_MATH_FIXED_q16_t args_q16B)
+ *  \b Description                  :       divides 2 Q16.16 numbers.
+ *  @note                           :       division by zero returns the largest value with the sign of the numerator.
+ *  @return                         :       A / B in Q16.16 (saturated).
+ */
+static __in LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_q16Div(LIB_MATH_FIXED_q16_t args_q16A, LIB_MATH_FIXED_q16_t args_q16B)
+{
+    if(0 == args_q16B)
+    {
+        return (args_q16A >= 0) ? INT32_MAX : -INT32_MAX - 1;
+    }
+    return LIB_MATH_FIXED_s32Saturate(((int64_t)args_q16A * LIB_MATH_FIXED_Q16_ONE) / args_q16B);
+}
+
+/**
+ *  \b function                     :       static __in uint32_t LIB_MATH_FIXED_u32Sqrt(uint32_t args_u32Value)
+ *  \b Description                  :       integer square root (floor) using the bit by bit method, only shifts and additions.
+ *  @note                           :       sqrt of a Q16.16 number is LIB_MATH_FIXED_u32Sqrt(x) << 8.
+ *  @return                         :       floor(sqrt(value)).
+ */
+static __in uint32_t LIB_MATH_FIXED_u32Sqrt(uint32_t args_u32Value)
+{
+    uint32_t local_u32Result = 0;
+    uint32_t local_u32Bit = (uint32_t)1 << 30;
+
+    while(local_u32Bit > args_u32Value)
+    {
+        local_u32Bit >>= 2;
+    }
+
+    while(local_u32Bit != 0)
+    {
+        if(args_u32Value >= local_u32Result + local_u32Bit)
+        {
+            args_u32Value -= local_u32Result + local_u32Bit;
+            local_u32Result = (local_u32Result >> 1) + local_u32Bit;
+        }
+        else
+        {
+            local_u32Result >>= 1;
+        }
+        local_u32Bit >>= 2;
+    }
+
+    return local_u32Result;
+}
+
+/**
+ *  \b function                     :       static __in LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_q16Atan2Deg(int32_t args_s32Y, int32_t args_s32X)
+ *  \b Description                  :       computes atan2(y, x) in degrees with CORDIC in vectoring mode.
+ *  @param    args_s32Y             :       y component, any scale as long as it is the same as x.
+ *  @param    args_s32X             :       x component, any scale as long as it is the same as y.
+ *  @note                           :       inputs are normalized first so the precision doesn't depend on their magnitude,
+ *                                          the error is below 0.01 degree.
+ *  @return                         :       the angle in degrees in the range [-180, 180] as Q16.16.
+ */
+static __in LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_q16Atan2Deg(int32_t args_s32Y, int32_t args_s32X)
+{
+    int32_t local_s32X = args_s32X;
+    int32_t local_s32Y = args_s32Y;
+    int32_t local_s32Temp = 0;
+    int8_t local_s8Shift = 0;
+    uint32_t local_u32Magnitude = 0;
+    LIB_MATH_FIXED_q16_t local_q16Angle = 0;
+
+    if(0 == local_s32X && 0 == local_s32Y)
+    {
+        return 0;
+    }
+
+    // bring the vector to the right half plane
+    if(local_s32X < 0)
+    {
+        local_q16Angle = (local_s32Y >= 0) ? LIB_MATH_FIXED_INT_TO_Q16(180) : -LIB_MATH_FIXED_INT_TO_Q16(180);
+        local_s32X = (local_s32X == -INT32_MAX - 1) ? INT32_MAX : -local_s32X;
+        local_s32Y = (local_s32Y == -INT32_MAX - 1) ? INT32_MAX : -local_s32Y;
+    }
+
+    // normalize so the largest component has its MSB at bit 28 (leaves room for the CORDIC gain of 1.65)
+    local_u32Magnitude = (uint32_t)local_s32X | (uint32_t)(local_s32Y < 0 ? -local_s32Y : local_s32Y);
+    local_s8Shift = 28 - (int8_t)LIB_MATH_BTT_u8GetMSBSetPos(local_u32Magnitude);
+    if(local_s8Shift > 0)
+    {
+        local_s32X = (int32_t)((uint32_t)local_s32X << local_s8Shift);
+        local_s32Y = (int32_t)((uint32_t)local_s32Y << local_s8Shift);
+    }
+    else if(local_s8Shift < 0)
+    {
+        local_s32X >>= -local_s8Shift;
+        local_s32Y >>= -local_s8Shift;
+    }
+
+    // rotate the vector towards the x axis accumulating the rotation angle
+    for(uint8_t i = 0; i < LIB_MATH_FIXED_CORDIC_ITERATIONS; i++)
+    {
+        local_s32Temp = local_s32X;
+        if(local_s32Y > 0)
+        {
+            local_s32X += local_s32Y >> i;
+            local_s32Y -= local_s32Temp >> i;
+            local_q16Angle += LIB_MATH_FIXED_CordicAtanDeg[i];
+        }
+        else
+        {
+            local_s32X -= local_s32Y >> i;
+            local_s32Y += local_s32Temp >> i;
+            local_q16Angle -= LIB_MATH_FIXED_CordicAtanDeg[i];
+        }
+    }
+
+    // the pre rotation by 180 degrees may have pushed the angle out of range
+    if(local_q16Angle > LIB_MATH_FIXED_INT_TO_Q16(180))
+    {
+        local_q16Angle -= LIB_MATH_FIXED_INT_TO_Q16(360);
+    }
+    else if(local_q16Angle < -LIB_MATH_FIXED_INT_TO_Q16(180))
+    {
+        local_q16Angle += LIB_MATH_FIXED_INT_TO_Q16(360);
+    }
+
+    return local_q16Angle;
+}
+
+/**
+ *  \b function                     :       static __in void LIB_MATH_FIXED_q16SinCosDeg(LIB_MATH_FIXED_q16_t args_q16Angle, LIB_MATH_FIXED_q16_t* args_pq16Sin, LIB_MATH_FIXED_q16_t* args_pq16Cos)
+ *  \b Description                  :       computes sin and cos of an angle in degrees together with CORDIC in rotation mode.
+ *  @param    args_q16Angle         :       the angle in degrees as Q16.16, any value in [-32768, 32768).
+ *  @param    args_pq16Sin          :       [OUT] sin of the angle as Q16.16.
+ *  @param    args_pq16Cos          :       [OUT] cos of the angle as Q16.16.
+ *  @return                         :       None.
+ */
+static __in void LIB_MATH_FIXED_q16SinCosDeg(LIB_MATH_FIXED_q16_t args_q16Angle, LIB_MATH_FIXED_q16_t* args_pq16Sin, LIB_MATH_FIXED_q16_t* args_pq16Cos)
+{
+    int32_t local_s32X = LIB_MATH_FIXED_CORDIC_K_Q30;
+    int32_t local_s32Y = 0;
+    int32_t local_s32Temp = 0;
+    int8_t local_s8Sign = 1;
+
+    // wrap the angle to [-180, 180] then fold it to [-90, 90] where CORDIC converges
+    while(args_q16Angle > LIB_MATH_FIXED_INT_TO_Q16(180))
+    {
+        args_q16Angle -= LIB_MATH_FIXED_INT_TO_Q16(360);
+    }
+    while(args_q16Angle < -LIB_MATH_FIXED_INT_TO_Q16(180))
+    {
+        args_q16Angle += LIB_MATH_FIXED_INT_TO_Q16(360);
+    }
+    if(args_q16Angle > LIB_MATH_FIXED_INT_TO_Q16(90))
+    {
+        args_q16Angle -= LIB_MATH_FIXED_INT_TO_Q16(180);
+        local_s8Sign = -1;
+    }
+    else if(args_q16Angle < -LIB_MATH_FIXED_INT_TO_Q16(90))
+    {
+        args_q16Angle += LIB_MATH_FIXED_INT_TO_Q16(180);
+        local_s8Sign = -1;
+    }
+
+    // rotate the unit vector (pre-scaled by the CORDIC gain) by the angle
+    for(uint8_t i = 0; i < LIB_MATH_FIXED_CORDIC_ITERATIONS; i++)
+    {
+        local_s32Temp = local_s32X;
+        if(args_q16Angle >= 0)
+        {
+            local_s32X -= local_s32Y >> i;
+            local_s32Y += local_s32Temp >> i;
+            args_q16Angle -= LIB_MATH_FIXED_CordicAtanDeg[i];
+        }
+        else
+        {
+            local_s32X += local_s32Y >> i;
+            local_s32Y -= local_s32Temp >> i;
+            args_q16Angle += LIB_MATH_FIXED_CordicAtanDeg[i];
+        }
+    }
+
+    // Q30 to Q16.16 with rounding
+    *args_pq16Cos = local_s8Sign * ((local_s32X + (1 << 13)) >> 14);
+    *args_pq16Sin = local_s8Sign * ((local_s32Y + (1 << 13)) >> 14);
+}
+
+/**
+ *  \b function                     :       static __in LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_q16AsinDeg(LIB_MATH_FIXED_q16_t args_q16Value)
+ *  \b Description                  :       computes asin(x) in degrees as atan2(x, sqrt(1 - x^2)).
+ *  @param    args_q16Value         :       the value as Q16.16, clamped to [-1, 1].
+ *  @note                           :       the error is below 0.01 degree.
+ *  @return                         :       the angle in degrees in the range [-90, 90] as Q16.16.
+ */
+static __in LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_q16AsinDeg(LIB_MATH_FIXED_q16_t args_q16Value)
+{
+    uint64_t local_u64Cos2;
+
+    if(args_q16Value >= LIB_MATH_FIXED_Q16_ONE)
+    {
+        return LIB_MATH_FIXED_INT_TO_Q16(90);
+    }
+    else if(args_q16Value <= -LIB_MATH_FIXED_Q16_ONE)
+    {
+        return -LIB_MATH_FIXED_INT_TO_Q16(90);
+    }
+
+    // 1 - x^2 in Q32, its square root is in Q16
+    local_u64Cos2 = ((uint64_t)1 << 32) - (uint64_t)((int64_t)args_q16Value * args_q16Value);
+    if(local_u64Cos2 > UINT32_MAX)
+    {
+        local_u64Cos2 = UINT32_MAX;
+    }
+
+    return LIB_MATH_FIXED_q16Atan2Deg(args_q16Value, (int32_t)LIB_MATH_FIXED_u32Sqrt((uint32_t)local_u64Cos2));
+}
+
+/**
+ *  \b function                     :       static __in LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_q16InvSqrt(LIB_MATH_FIXED_q16_t args_q16Value)
+ *  \b Description                  :       computes 1/sqrt(x), x is written as m * 4^k with m in [1, 4) then 1/sqrt(m) is found with
+ *                                          newton iterations y = y * (3 - m * y^2) / 2 in Q2.30 and scaled back by 2^-k.
+ *  @param    args_q16Value         :       the value as Q16.16, must be positive.
+ *  @note                           :       the result is exact to the last bit of Q16.16 (the relative error grows for large
+ *                                          values only because the result gets small), zero or negative values return the largest value.
+ *  @return                         :       1/sqrt(x) as Q16.16 (saturated).
+ */
+static __in LIB_MATH_FIXED_q16_t LIB_MATH_FIXED_q16InvSqrt(LIB_MATH_FIXED_q16_t args_q16Value)
+{
+    int64_t local_s64Mantissa;
+    int64_t local_s64Result;
+    int64_t local_s64Temp;
+    int8_t local_s8Exponent;
+
+    if(args_q16Value <= 0)
+    {
+        return INT32_MAX;
+    }
+
+    // k = floor((msb - 16) / 2) so that m = x / 4^k is in [1, 4), m is kept in Q2.30
+    local_s8Exponent = (int8_t)((LIB_MATH_BTT_u8GetMSBSetPos((uint32_t)args_q16Value) + 16) / 2) - 16;
+    local_s64Mantissa = (int64_t)args_q16Value << (14 - 2 * local_s8Exponent);
+
+    // initial guess within 20% of 1/sqrt(m) then newton iterations
+    local_s64Result = (local_s64Mantissa < ((int64_t)2 << 30)) ? LIB_MATH_FIXED_FLOAT_TO_Q30(0.8) : LIB_MATH_FIXED_FLOAT_TO_Q30(0.56);
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        local_s64Temp = (local_s64Result * local_s64Result) >> 30;
+        local_s64Temp = (local_s64Temp * local_s64Mantissa) >> 30;
+        local_s64Result = (local_s64Result * (((int64_t)3 << 30) - local_s64Temp)) >> 31;
+    }
+
+    // 1/sqrt(x) = 2^-k / sqrt(m), from Q2.30 to Q16.16 with rounding
+    local_s64Result = (local_s64Result + ((int64_t)1 << (13 + local_s8Exponent))) >> (14 + local_s8Exponent);
+
+    return LIB_MATH_FIXED_s32Saturate(local_s64Result);
+}
+
+/*** End of File **************************************************************/
+#endif /*LIB_MATH_FIXED_H_*/
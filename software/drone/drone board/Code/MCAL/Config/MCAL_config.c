@@ -41,6 +41,10 @@
  * |    18/05/2023      1.0.0           Abdelrahman Mohamed Salem       Interface Created.                                              |
  * |    24/05/2023      1.0.0           Abdelrahman Mohamed Salem       Added configurations for SPI of ADXL345.                        |
  * |    12/06/2023      1.0.0           Mohab Zaghloul                  Added configurations for I2C of MPU6050.                        |
+ * |    17/10/2026      1.1.0           agent                           I2C2 is initialized through 'MCAL_I2C_Init'.                    |
+ * |    17/10/2026      1.2.0           agent                           PB13 is the data ready interrupt of MPU6050 (EXTI13).           |
+ * |    17/10/2026      1.3.0           agent                           DMA1 is clocked, SPI1 transfers go through 'MCAL_SPI_Init'.     |
+ * |    17/10/2026      1.4.0           agent                           UART4 receives by DMA through 'MCAL_UART_Init'.                 |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
  
@@ -81,6 +85,26 @@
  */
 #include "ch32v20x_usart.h"
 
+/**
+ * @reason: contains the DMA driven receiver of UART4
+ */
+#include "MCAL_UART.h"
+
+/**
+ * @reason: contains the interrupt driven I2C2 driver
+ */
+#include "MCAL_I2C.h"
+
+/**
+ * @reason: contains the DMA driven SPI1 driver
+ */
+#include "MCAL_SPI.h"
+
+/**
+ * @reason: contains definitions for external interrupts
+ */
+#include "ch32v20x_exti.h"
+
 /******************************************************************************
  * Module Preprocessor Constants
  *******************************************************************************/
@@ -118,13 +142,13 @@ MCAL_CONFIG_SPI_t MCAL_CFG_BMPSPI;
 MCAL_Config_ErrStat_t MCAL_Config_ConfigAllPins(void)
 {   
     // enable clock for all needed peripherals
-    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, DISABLE);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
     RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA2, DISABLE);
     RCC_AHBPeriphClockCmd(RCC_AHBPeriph_SRAM, DISABLE);
     RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, DISABLE);
     RCC_AHBPeriphClockCmd(RCC_AHBPeriph_OTG_FS, DISABLE);
 
-    RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, DISABLE);
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, ENABLE);
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE);
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOC, ENABLE);
@@ -278,7 +302,8 @@ MCAL_Config_ErrStat_t MCAL_Config_ConfigAllPins(void)
     local_dummy_t.GPIO_Pin = GPIO_Pin_12;
     GPIO_Init(GPIOB, &local_dummy_t);
 
-    local_dummy_t.GPIO_Mode = GPIO_Mode_IN_FLOATING;
+    // INT (data ready) pin of MPU6050, push pull active high
+    local_dummy_t.GPIO_Mode = GPIO_Mode_IPD;
     local_dummy_t.GPIO_Pin = GPIO_Pin_13;
     GPIO_Init(GPIOB, &local_dummy_t);
 
@@ -335,6 +360,7 @@ MCAL_Config_ErrStat_t MCAL_Config_ConfigAllPins(void)
     GPIO_SetBits(MCAL_CFG_adxlSPI.GPIO, MCAL_CFG_adxlSPI.SlavePin);
     GPIO_SetBits(MCAL_CFG_BMPSPI.GPIO, MCAL_CFG_BMPSPI.SlavePin);
     SPI_Cmd(SPI1, ENABLE);
+    MCAL_SPI_Init();
 
     
      
@@ -347,8 +373,24 @@ MCAL_Config_ErrStat_t MCAL_Config_ConfigAllPins(void)
     I2CConfig.I2C_OwnAddress1 = 0x2F;
     I2CConfig.I2C_Ack = I2C_Ack_Enable;
     I2CConfig.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
-    I2C_Init(I2C2, &I2CConfig);
-    I2C_Cmd(I2C2, ENABLE);
+    MCAL_I2C_Init(&I2CConfig);
+
+    /******************************************/
+    // rising edge on PB13 when MPU6050 has a new sample
+    GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource13);
+    EXTI_InitTypeDef local_imuDataReadyEXTI_t = {0};
+    local_imuDataReadyEXTI_t.EXTI_Line = EXTI_Line13;
+    local_imuDataReadyEXTI_t.EXTI_Mode = EXTI_Mode_Interrupt;
+    local_imuDataReadyEXTI_t.EXTI_Trigger = EXTI_Trigger_Rising;
+    local_imuDataReadyEXTI_t.EXTI_LineCmd = ENABLE;
+    EXTI_Init(&local_imuDataReadyEXTI_t);
+
+    NVIC_InitTypeDef local_imuDataReadyNVIC_t = {0};
+    local_imuDataReadyNVIC_t.NVIC_IRQChannel = EXTI15_10_IRQn;
+    local_imuDataReadyNVIC_t.NVIC_IRQChannelPreemptionPriority = 1;
+    local_imuDataReadyNVIC_t.NVIC_IRQChannelSubPriority = 0;
+    local_imuDataReadyNVIC_t.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&local_imuDataReadyNVIC_t);
 
     /******************************************/
     TIM_TimeBaseInitTypeDef local_tim4Init_t = {0};
@@ -440,17 +482,10 @@ MCAL_Config_ErrStat_t MCAL_Config_ConfigAllPins(void)
     local_usart4_t.USART_Mode = USART_Mode_Tx | USART_Mode_Rx;
     USART_Init(UART4, &local_usart4_t);
 
-    // USART_ITConfig(UART4, USART_IT_RXNE, ENABLE);
-    // interrupt is causing Systick timer interrupt to stop which is in return responsible for stopping freeRTOS kernal from work
-    // // configure NVIC for uart4 interrupt channel
-    // NVIC_InitTypeDef  uart_nvic_t = {0};
-    // uart_nvic_t.NVIC_IRQChannel = UART4_IRQn;
-    // uart_nvic_t.NVIC_IRQChannelPreemptionPriority = 1;
-    // uart_nvic_t.NVIC_IRQChannelSubPriority = 1;
-    // uart_nvic_t.NVIC_IRQChannelCmd = ENABLE;
-    // NVIC_Init(&uart_nvic_t);
-
+    // the received bytes are moved by DMA into a circular buffer, the idle line interrupt tells when the other board
+    // stopped sending (refer to "MCAL_UART.h")
     USART_Cmd(UART4, ENABLE);
+    MCAL_UART_Init();
 
     /******************************************/
     RCC_ADCCLKConfig(RCC_PCLK2_Div8);
@@ -0,0 +1,631 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   asynchronous I2C master driver                                                                              |
+ * |    @file           :   MCAL_I2C.c                                                                                                  |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file contains the interrupt driven I2C2 transaction engine used by the I2C sensors                     |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains the interface of this module
+ */
+#include "MCAL_I2C.h"
+
+/**
+ * @reason: contains GPIO functionality used to free the bus
+ */
+#include "ch32v20x_gpio.h"
+
+/**
+ * @reason: contains NVIC configuration
+ */
+#include "ch32v20x_misc.h"
+
+/**
+ * @reason: contains the micro second delay used to clock the bus by hand
+ */
+#include "MCAL_wrapper.h"
+
+/**
+ * @reason: contains enabled/disabled constants
+ */
+#include "constants.h"
+
+/******************************************************************************
+ * Module Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: phases of the transaction on the bus
+ */
+#define MCAL_I2C_PHASE_START            (0)     /**< waiting for the first START */
+#define MCAL_I2C_PHASE_ADDR_TX          (1)     /**< slave address sent for writing the register address */
+#define MCAL_I2C_PHASE_WRITE_DATA       (2)     /**< writing the data bytes */
+#define MCAL_I2C_PHASE_REG_SENT         (3)     /**< register address is being sent before the repeated START */
+#define MCAL_I2C_PHASE_RESTART          (4)     /**< waiting for the repeated START */
+#define MCAL_I2C_PHASE_ADDR_RX          (5)     /**< slave address sent for reading */
+#define MCAL_I2C_PHASE_READ_DATA        (6)     /**< receiving the data bytes */
+
+/**
+ * @brief: number of SCL pulses needed to let any slave finish the byte it's sending
+ */
+#define MCAL_I2C_RECOVERY_CLOCKS        (9)
+
+/**
+ * @brief: half period of SCL while freeing the bus (100 KHz)
+ */
+#define MCAL_I2C_RECOVERY_HALF_PERIOD_US (5)
+
+/******************************************************************************
+ * Module Preprocessor Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Typedefs
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Variable Definitions
+ *******************************************************************************/
+
+/**
+ * @brief: configuration of I2C2, kept to re-initialize it after a bus recovery
+ */
+I2C_InitTypeDef global_I2CConfig_t = {0};
+
+/**
+ * @brief: transactions waiting for the bus, the one at the head is the one on the bus
+ */
+MCAL_I2C_Transaction_t* global_I2CQueue[MCAL_I2C_QUEUE_LEN] = {NULL};
+
+/**
+ * @brief: index of the head of the queue and number of queued transactions
+ */
+volatile uint8_t global_u8I2CQueueHead = 0;
+volatile uint8_t global_u8I2CQueueCount = 0;
+
+/**
+ * @brief: the transaction on the bus, NULL when the bus is idle
+ */
+MCAL_I2C_Transaction_t* volatile global_I2CCurrent_t = NULL;
+
+/**
+ * @brief: phase of the current transaction
+ */
+volatile uint8_t global_u8I2CPhase = MCAL_I2C_PHASE_START;
+
+/**
+ * @brief: index of the next byte to send/receive and number of bytes left
+ */
+volatile uint8_t global_u8I2CIndex = 0;
+volatile uint8_t global_u8I2CRemaining = 0;
+
+/**
+ * @brief: set when the bus is in an unknown state, no transaction is started until the bus is recovered
+ */
+volatile uint8_t global_u8I2CNeedsRecovery = LIB_CONSTANTS_DISABLED;
+
+/**
+ * @brief: counters of the bus activity
+ */
+volatile MCAL_I2C_Stats_t global_I2CStats_t = {0};
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ * @brief: I2C2 IRQ handlers
+ */
+void I2C2_EV_IRQHandler(void) __attribute__((interrupt()));
+void I2C2_ER_IRQHandler(void) __attribute__((interrupt()));
+
+/**
+ * @brief: puts the transaction at the head of the queue on the bus, must be called with the interrupts disabled or from the ISR
+ */
+void MCAL_I2C_StartNext(void);
+
+/**
+ * @brief: ends the current transaction with the given state, notifies its task and starts the next one
+ */
+void MCAL_I2C_Complete(MCAL_I2C_ErrStat_t arg_Status);
+
+/******************************************************************************
+ * Function Definitions
+ *******************************************************************************/
+
+/**
+ * 
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_Init(I2C_InitTypeDef* arg_pI2CConfig)
+{
+    if(NULL == arg_pI2CConfig)
+        return MCAL_I2C_STAT_INVALID_PARAMS;
+
+    global_I2CConfig_t = *arg_pI2CConfig;
+    global_u8I2CQueueHead = 0;
+    global_u8I2CQueueCount = 0;
+    global_I2CCurrent_t = NULL;
+    global_u8I2CNeedsRecovery = LIB_CONSTANTS_DISABLED;
+
+    I2C_Init(I2C2, &global_I2CConfig_t);
+    I2C_Cmd(I2C2, ENABLE);
+
+    NVIC_InitTypeDef local_i2cNVICInit_t = {0};
+    local_i2cNVICInit_t.NVIC_IRQChannel = I2C2_EV_IRQn;
+    local_i2cNVICInit_t.NVIC_IRQChannelPreemptionPriority = MCAL_I2C_IRQ_PREEMPTION_PRIO;
+    local_i2cNVICInit_t.NVIC_IRQChannelSubPriority = MCAL_I2C_IRQ_SUB_PRIO;
+    local_i2cNVICInit_t.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&local_i2cNVICInit_t);
+    local_i2cNVICInit_t.NVIC_IRQChannel = I2C2_ER_IRQn;
+    NVIC_Init(&local_i2cNVICInit_t);
+
+    return MCAL_I2C_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_Submit(MCAL_I2C_Transaction_t* arg_pTransaction)
+{
+    MCAL_I2C_ErrStat_t local_errState = MCAL_I2C_STAT_OK;
+
+    if(NULL == arg_pTransaction || NULL == arg_pTransaction->data || 0 == arg_pTransaction->dataLen)
+        return MCAL_I2C_STAT_INVALID_PARAMS;
+
+    SERVICE_RTOS_EnterCritical();
+    if(MCAL_I2C_QUEUE_LEN <= global_u8I2CQueueCount)
+    {
+        local_errState = MCAL_I2C_STAT_QUEUE_FULL;
+    }
+    else
+    {
+        arg_pTransaction->status = MCAL_I2C_STAT_PENDING;
+        global_I2CQueue[(global_u8I2CQueueHead + global_u8I2CQueueCount) % MCAL_I2C_QUEUE_LEN] = arg_pTransaction;
+        global_u8I2CQueueCount++;
+
+        if(NULL == global_I2CCurrent_t && LIB_CONSTANTS_DISABLED == global_u8I2CNeedsRecovery)
+            MCAL_I2C_StartNext();
+    }
+    SERVICE_RTOS_ExitCritical();
+
+    return local_errState;
+}
+
+/**
+ * 
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_Wait(MCAL_I2C_Transaction_t* arg_pTransaction, uint32_t arg_u32TimeoutMS)
+{
+    uint32_t local_u32StartTime = 0;
+    uint32_t local_u32CurrentTime = 0;
+    uint8_t local_u8Index = 0;
+
+    if(NULL == arg_pTransaction)
+        return MCAL_I2C_STAT_INVALID_PARAMS;
+
+    SERVICE_RTOS_CurrentMSTime(&local_u32StartTime);
+    while(MCAL_I2C_STAT_PENDING == arg_pTransaction->status)
+    {
+        SERVICE_RTOS_CurrentMSTime(&local_u32CurrentTime);
+        if(local_u32CurrentTime - local_u32StartTime >= arg_u32TimeoutMS)
+        {
+            // the transaction is stuck, take it out of the bus/queue so the caller can reuse its memory
+            SERVICE_RTOS_EnterCritical();
+            if(MCAL_I2C_STAT_PENDING == arg_pTransaction->status)
+            {
+                if(arg_pTransaction == global_I2CCurrent_t)
+                {
+                    I2C_ITConfig(I2C2, I2C_IT_EVT | I2C_IT_BUF | I2C_IT_ERR, DISABLE);
+                    I2C_GenerateSTOP(I2C2, ENABLE);
+                    global_I2CCurrent_t = NULL;
+                    global_u8I2CNeedsRecovery = LIB_CONSTANTS_ENABLED;
+                }
+
+                // remove it from the queue keeping the order of the others
+                for(local_u8Index = 0; local_u8Index < global_u8I2CQueueCount; local_u8Index++)
+                {
+                    if(arg_pTransaction == global_I2CQueue[(global_u8I2CQueueHead + local_u8Index) % MCAL_I2C_QUEUE_LEN])
+                        break;
+                }
+                for(; local_u8Index + 1 < global_u8I2CQueueCount; local_u8Index++)
+                {
+                    global_I2CQueue[(global_u8I2CQueueHead + local_u8Index) % MCAL_I2C_QUEUE_LEN] =
+                        global_I2CQueue[(global_u8I2CQueueHead + local_u8Index + 1) % MCAL_I2C_QUEUE_LEN];
+                }
+                if(local_u8Index < global_u8I2CQueueCount)
+                    global_u8I2CQueueCount--;
+
+                global_I2CStats_t.timeouts++;
+                arg_pTransaction->status = MCAL_I2C_STAT_TIMEOUT;
+            }
+            SERVICE_RTOS_ExitCritical();
+            break;
+        }
+
+        SERVICE_RTOS_WaitForNotification(arg_u32TimeoutMS - (local_u32CurrentTime - local_u32StartTime));
+    }
+
+    if(LIB_CONSTANTS_ENABLED == global_u8I2CNeedsRecovery)
+        MCAL_I2C_RecoverBus();
+
+    return arg_pTransaction->status;
+}
+
+/**
+ * 
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_ReadRegs(uint8_t arg_u8SlaveAddress, uint8_t arg_u8StartReg, uint8_t* arg_pu8Data, uint8_t arg_u8DataLen, uint32_t arg_u32TimeoutMS)
+{
+    MCAL_I2C_ErrStat_t local_errState = MCAL_I2C_STAT_OK;
+    MCAL_I2C_Transaction_t local_transaction_t = {0};
+
+    local_transaction_t.slaveAddress = arg_u8SlaveAddress;
+    local_transaction_t.regAddress = arg_u8StartReg;
+    local_transaction_t.data = arg_pu8Data;
+    local_transaction_t.dataLen = arg_u8DataLen;
+    local_transaction_t.direction = MCAL_I2C_DIR_READ;
+    SERVICE_RTOS_GetCurrentTaskHandle(&local_transaction_t.notifyTask);
+
+    local_errState = MCAL_I2C_Submit(&local_transaction_t);
+    if(MCAL_I2C_STAT_OK != local_errState)
+        return local_errState;
+
+    return MCAL_I2C_Wait(&local_transaction_t, arg_u32TimeoutMS);
+}
+
+/**
+ * 
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_WriteReg(uint8_t arg_u8SlaveAddress, uint8_t arg_u8Reg, uint8_t arg_u8Value, uint32_t arg_u32TimeoutMS)
+{
+    MCAL_I2C_ErrStat_t local_errState = MCAL_I2C_STAT_OK;
+    MCAL_I2C_Transaction_t local_transaction_t = {0};
+
+    local_transaction_t.slaveAddress = arg_u8SlaveAddress;
+    local_transaction_t.regAddress = arg_u8Reg;
+    local_transaction_t.data = &arg_u8Value;
+    local_transaction_t.dataLen = 1;
+    local_transaction_t.direction = MCAL_I2C_DIR_WRITE;
+    SERVICE_RTOS_GetCurrentTaskHandle(&local_transaction_t.notifyTask);
+
+    local_errState = MCAL_I2C_Submit(&local_transaction_t);
+    if(MCAL_I2C_STAT_OK != local_errState)
+        return local_errState;
+
+    return MCAL_I2C_Wait(&local_transaction_t, arg_u32TimeoutMS);
+}
+
+/**
+ * 
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_RecoverBus(void)
+{
+    GPIO_InitTypeDef local_GPIOInit_t = {0};
+    uint8_t local_u8Clock = 0;
+
+    SERVICE_RTOS_EnterCritical();
+    I2C_ITConfig(I2C2, I2C_IT_EVT | I2C_IT_BUF | I2C_IT_ERR, DISABLE);
+    I2C_Cmd(I2C2, DISABLE);
+    SERVICE_RTOS_ExitCritical();
+
+    // drive the pins by hand, both released (high)
+    GPIO_SetBits(MCAL_I2C_GPIO, MCAL_I2C_SCL_PIN | MCAL_I2C_SDA_PIN);
+    local_GPIOInit_t.GPIO_Pin = MCAL_I2C_SCL_PIN | MCAL_I2C_SDA_PIN;
+    local_GPIOInit_t.GPIO_Mode = GPIO_Mode_Out_OD;
+    local_GPIOInit_t.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_Init(MCAL_I2C_GPIO, &local_GPIOInit_t);
+    MCAL_WRAPPER_DelayUS(MCAL_I2C_RECOVERY_HALF_PERIOD_US);
+
+    // a slave that was sending a byte releases SDA after at most 9 clocks
+    for(local_u8Clock = 0; local_u8Clock < MCAL_I2C_RECOVERY_CLOCKS; local_u8Clock++)
+    {
+        if(Bit_SET == GPIO_ReadInputDataBit(MCAL_I2C_GPIO, MCAL_I2C_SDA_PIN))
+            break;
+
+        GPIO_ResetBits(MCAL_I2C_GPIO, MCAL_I2C_SCL_PIN);
+        MCAL_WRAPPER_DelayUS(MCAL_I2C_RECOVERY_HALF_PERIOD_US);
+        GPIO_SetBits(MCAL_I2C_GPIO, MCAL_I2C_SCL_PIN);
+        MCAL_WRAPPER_DelayUS(MCAL_I2C_RECOVERY_HALF_PERIOD_US);
+    }
+
+    // STOP condition: SDA rises while SCL is high
+    GPIO_ResetBits(MCAL_I2C_GPIO, MCAL_I2C_SCL_PIN);
+    MCAL_WRAPPER_DelayUS(MCAL_I2C_RECOVERY_HALF_PERIOD_US);
+    GPIO_ResetBits(MCAL_I2C_GPIO, MCAL_I2C_SDA_PIN);
+    MCAL_WRAPPER_DelayUS(MCAL_I2C_RECOVERY_HALF_PERIOD_US);
+    GPIO_SetBits(MCAL_I2C_GPIO, MCAL_I2C_SCL_PIN);
+    MCAL_WRAPPER_DelayUS(MCAL_I2C_RECOVERY_HALF_PERIOD_US);
+    GPIO_SetBits(MCAL_I2C_GPIO, MCAL_I2C_SDA_PIN);
+    MCAL_WRAPPER_DelayUS(MCAL_I2C_RECOVERY_HALF_PERIOD_US);
+
+    // give the pins back to the peripheral and clear its state (BUSY flag may be stuck)
+    local_GPIOInit_t.GPIO_Mode = GPIO_Mode_AF_OD;
+    GPIO_Init(MCAL_I2C_GPIO, &local_GPIOInit_t);
+    I2C_SoftwareResetCmd(I2C2, ENABLE);
+    I2C_SoftwareResetCmd(I2C2, DISABLE);
+    I2C_Init(I2C2, &global_I2CConfig_t);
+    I2C_Cmd(I2C2, ENABLE);
+
+    SERVICE_RTOS_EnterCritical();
+    global_I2CStats_t.recoveries++;
+    global_u8I2CNeedsRecovery = LIB_CONSTANTS_DISABLED;
+    if(NULL == global_I2CCurrent_t)
+        MCAL_I2C_StartNext();
+    SERVICE_RTOS_ExitCritical();
+
+    return MCAL_I2C_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_GetStats(MCAL_I2C_Stats_t* arg_pStats)
+{
+    if(NULL == arg_pStats)
+        return MCAL_I2C_STAT_INVALID_PARAMS;
+
+    SERVICE_RTOS_EnterCritical();
+    *arg_pStats = global_I2CStats_t;
+    SERVICE_RTOS_ExitCritical();
+
+    return MCAL_I2C_STAT_OK;
+}
+
+/**
+ * 
+ */
+void MCAL_I2C_StartNext(void)
+{
+    if(0 == global_u8I2CQueueCount)
+    {
+        global_I2CCurrent_t = NULL;
+        return;
+    }
+
+    global_I2CCurrent_t = global_I2CQueue[global_u8I2CQueueHead];
+    global_u8I2CPhase = MCAL_I2C_PHASE_START;
+    global_u8I2CIndex = 0;
+    global_u8I2CRemaining = global_I2CCurrent_t->dataLen;
+
+    I2C_NACKPositionConfig(I2C2, I2C_NACKPosition_Current);
+    I2C_AcknowledgeConfig(I2C2, ENABLE);
+    I2C_ITConfig(I2C2, I2C_IT_EVT | I2C_IT_ERR, ENABLE);
+    I2C_GenerateSTART(I2C2, ENABLE);
+}
+
+/**
+ * 
+ */
+void MCAL_I2C_Complete(MCAL_I2C_ErrStat_t arg_Status)
+{
+    MCAL_I2C_Transaction_t* local_pTransaction = global_I2CCurrent_t;
+    RTOS_TaskHandle_t local_notifyTask = local_pTransaction->notifyTask;
+
+    I2C_ITConfig(I2C2, I2C_IT_EVT | I2C_IT_BUF | I2C_IT_ERR, DISABLE);
+    I2C_NACKPositionConfig(I2C2, I2C_NACKPosition_Current);
+    I2C_AcknowledgeConfig(I2C2, ENABLE);
+
+    global_u8I2CQueueHead = (global_u8I2CQueueHead + 1) % MCAL_I2C_QUEUE_LEN;
+    global_u8I2CQueueCount--;
+    global_I2CCurrent_t = NULL;
+
+    if(MCAL_I2C_STAT_OK == arg_Status)
+        global_I2CStats_t.completed++;
+    else if(MCAL_I2C_STAT_NACK == arg_Status)
+        global_I2CStats_t.nacks++;
+    else
+        global_I2CStats_t.busErrors++;
+
+    // the owner may reuse the transaction as soon as it's not pending, don't touch it after this line
+    local_pTransaction->status = arg_Status;
+
+    if(NULL != local_notifyTask)
+        SERVICE_RTOS_Notify(local_notifyTask, LIB_CONSTANTS_ENABLED);
+
+    if(LIB_CONSTANTS_DISABLED == global_u8I2CNeedsRecovery)
+        MCAL_I2C_StartNext();
+}
+
+/**
+ * 
+ */
+void I2C2_EV_IRQHandler(void)
+{
+    uint16_t local_u16Status = I2C_ReadRegister(I2C2, I2C_Register_STAR1);
+    MCAL_I2C_Transaction_t* local_pTransaction = global_I2CCurrent_t;
+
+    if(NULL == local_pTransaction)
+    {
+        I2C_ITConfig(I2C2, I2C_IT_EVT | I2C_IT_BUF, DISABLE);
+        return;
+    }
+
+    if(local_u16Status & I2C_STAR1_SB)
+    {
+        if(MCAL_I2C_PHASE_START == global_u8I2CPhase)
+        {
+            I2C_Send7bitAddress(I2C2, local_pTransaction->slaveAddress << 1, I2C_Direction_Transmitter);
+            global_u8I2CPhase = MCAL_I2C_PHASE_ADDR_TX;
+        }
+        else if(MCAL_I2C_PHASE_RESTART == global_u8I2CPhase)
+        {
+            I2C_Send7bitAddress(I2C2, local_pTransaction->slaveAddress << 1, I2C_Direction_Receiver);
+            global_u8I2CPhase = MCAL_I2C_PHASE_ADDR_RX;
+        }
+    }
+    else if(local_u16Status & I2C_STAR1_ADDR)
+    {
+        if(MCAL_I2C_PHASE_ADDR_TX == global_u8I2CPhase)
+        {
+            // reading STAR2 after STAR1 clears ADDR
+            I2C_ReadRegister(I2C2, I2C_Register_STAR2);
+            I2C_SendData(I2C2, local_pTransaction->regAddress);
+            global_u8I2CPhase = (MCAL_I2C_DIR_WRITE == local_pTransaction->direction) ? MCAL_I2C_PHASE_WRITE_DATA : MCAL_I2C_PHASE_REG_SENT;
+        }
+        else
+        {
+            // the ACK/POS/STOP bits must be set before ADDR is cleared, the first byte is clocked in right after it
+            if(1 == global_u8I2CRemaining)
+            {
+                I2C_AcknowledgeConfig(I2C2, DISABLE);
+                I2C_ReadRegister(I2C2, I2C_Register_STAR2);
+                I2C_GenerateSTOP(I2C2, ENABLE);
+                I2C_ITConfig(I2C2, I2C_IT_BUF, ENABLE);
+            }
+            else if(2 == global_u8I2CRemaining)
+            {
+                I2C_AcknowledgeConfig(I2C2, DISABLE);
+                I2C_NACKPositionConfig(I2C2, I2C_NACKPosition_Next);
+                I2C_ReadRegister(I2C2, I2C_Register_STAR2);
+            }
+            else
+            {
+                I2C_AcknowledgeConfig(I2C2, ENABLE);
+                I2C_ReadRegister(I2C2, I2C_Register_STAR2);
+                // the last 3 bytes are handled on BTF to place the NACK and STOP correctly
+                if(3 < global_u8I2CRemaining)
+                    I2C_ITConfig(I2C2, I2C_IT_BUF, ENABLE);
+            }
+            global_u8I2CPhase = MCAL_I2C_PHASE_READ_DATA;
+        }
+    }
+    else if(MCAL_I2C_PHASE_WRITE_DATA == global_u8I2CPhase)
+    {
+        if(local_u16Status & I2C_STAR1_BTF)
+        {
+            if(global_u8I2CIndex < local_pTransaction->dataLen)
+            {
+                I2C_SendData(I2C2, local_pTransaction->data[global_u8I2CIndex++]);
+            }
+            else
+            {
+                I2C_GenerateSTOP(I2C2, ENABLE);
+                MCAL_I2C_Complete(MCAL_I2C_STAT_OK);
+            }
+        }
+    }
+    else if(MCAL_I2C_PHASE_REG_SENT == global_u8I2CPhase)
+    {
+        if(local_u16Status & I2C_STAR1_BTF)
+        {
+            I2C_GenerateSTART(I2C2, ENABLE);
+            global_u8I2CPhase = MCAL_I2C_PHASE_RESTART;
+        }
+    }
+    else if(MCAL_I2C_PHASE_READ_DATA == global_u8I2CPhase)
+    {
+        if(3 < global_u8I2CRemaining)
+        {
+            if(local_u16Status & I2C_STAR1_RXNE)
+            {
+                local_pTransaction->data[global_u8I2CIndex++] = I2C_ReceiveData(I2C2);
+                global_u8I2CRemaining--;
+                if(3 == global_u8I2CRemaining)
+                    I2C_ITConfig(I2C2, I2C_IT_BUF, DISABLE);
+            }
+        }
+        else if(3 == global_u8I2CRemaining)
+        {
+            if(local_u16Status & I2C_STAR1_BTF)
+            {
+                // byte N-2 in the data register, N-1 in the shift register: NACK the last byte
+                I2C_AcknowledgeConfig(I2C2, DISABLE);
+                local_pTransaction->data[global_u8I2CIndex++] = I2C_ReceiveData(I2C2);
+                global_u8I2CRemaining--;
+            }
+        }
+        else if(2 == global_u8I2CRemaining)
+        {
+            if(local_u16Status & I2C_STAR1_BTF)
+            {
+                // byte N-1 in the data register, N in the shift register and the NACK already sent
+                I2C_GenerateSTOP(I2C2, ENABLE);
+                local_pTransaction->data[global_u8I2CIndex++] = I2C_ReceiveData(I2C2);
+                local_pTransaction->data[global_u8I2CIndex++] = I2C_ReceiveData(I2C2);
+                global_u8I2CRemaining = 0;
+                MCAL_I2C_Complete(MCAL_I2C_STAT_OK);
+            }
+        }
+        else
+        {
+            if(local_u16Status & I2C_STAR1_RXNE)
+            {
+                local_pTransaction->data[global_u8I2CIndex++] = I2C_ReceiveData(I2C2);
+                global_u8I2CRemaining = 0;
+                MCAL_I2C_Complete(MCAL_I2C_STAT_OK);
+            }
+        }
+    }
+}
+
+/**
+ * 
+ */
+void I2C2_ER_IRQHandler(void)
+{
+    uint16_t local_u16Status = I2C_ReadRegister(I2C2, I2C_Register_STAR1);
+
+    if(local_u16Status & (I2C_STAR1_BERR | I2C_STAR1_ARLO | I2C_STAR1_OVR | I2C_STAR1_TIMEOUT))
+    {
+        I2C_ClearFlag(I2C2, I2C_FLAG_BERR | I2C_FLAG_ARLO | I2C_FLAG_OVR | I2C_FLAG_TIMEOUT | I2C_FLAG_AF);
+        global_u8I2CNeedsRecovery = LIB_CONSTANTS_ENABLED;
+
+        if(NULL != global_I2CCurrent_t)
+            MCAL_I2C_Complete((local_u16Status & I2C_STAR1_ARLO) ? MCAL_I2C_STAT_ARB_LOST : MCAL_I2C_STAT_BUS_ERR);
+        else
+            I2C_ITConfig(I2C2, I2C_IT_EVT | I2C_IT_BUF | I2C_IT_ERR, DISABLE);
+    }
+    else if(local_u16Status & I2C_STAR1_AF)
+    {
+        I2C_ClearFlag(I2C2, I2C_FLAG_AF);
+
+        if(NULL != global_I2CCurrent_t)
+        {
+            I2C_GenerateSTOP(I2C2, ENABLE);
+            MCAL_I2C_Complete(MCAL_I2C_STAT_NACK);
+        }
+    }
+}
+
+/*************** END OF FUNCTIONS ***************************************************************************/
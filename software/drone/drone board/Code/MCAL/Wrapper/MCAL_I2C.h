@@ -0,0 +1,394 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   asynchronous I2C master driver                                                                              |
+ * |    @file           :   MCAL_I2C.h                                                                                                  |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file contains the interrupt driven I2C2 transaction engine used by the I2C sensors                     |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+
+#ifndef MCAL_I2C_HEADER_H_
+#define MCAL_I2C_HEADER_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains standard definitions for int
+ */
+#include "stdint.h"
+
+/**
+ * @reason: contains common definitions
+ */
+#include "common.h"
+
+/**
+ * @reason: contains I2C configuration struct
+ */
+#include "ch32v20x_i2c.h"
+
+/**
+ * @reason: contains definition of the task handle to notify
+ */
+#include "Service_RTOS_wrapper.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: maximum number of transactions that can wait for the bus at the same time
+ */
+#define MCAL_I2C_QUEUE_LEN                  (8)
+
+/**
+ * @brief: timeout used by the sensors drivers for a single transaction, a 14 bytes read takes ~0.4 ms at 400 KHz
+ */
+#define MCAL_I2C_DEFAULT_TIMEOUT_MS         (10)
+
+/******************************************************************************
+ * Configuration Constants
+ *******************************************************************************/
+
+/**
+ * @brief: pins of I2C2 used to free the bus when a slave holds SDA low
+ */
+#define MCAL_I2C_GPIO                       GPIOB
+#define MCAL_I2C_SCL_PIN                    GPIO_Pin_10
+#define MCAL_I2C_SDA_PIN                    GPIO_Pin_11
+
+/**
+ * @brief: priority of the I2C2 event and error interrupts
+ */
+#define MCAL_I2C_IRQ_PREEMPTION_PRIO        (1)
+#define MCAL_I2C_IRQ_SUB_PRIO               (1)
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: contains error states for this module, also used as the state of a transaction
+*/
+typedef enum {
+  MCAL_I2C_STAT_OK,                 /**< transaction finished successfully */
+  MCAL_I2C_STAT_INVALID_PARAMS,     /**< invalid arguments */
+  MCAL_I2C_STAT_PENDING,            /**< transaction is queued or on the bus */
+  MCAL_I2C_STAT_QUEUE_FULL,         /**< no room in the queue, try again later */
+  MCAL_I2C_STAT_NACK,               /**< the slave didn't acknowledge its address or a written byte */
+  MCAL_I2C_STAT_BUS_ERR,            /**< misplaced start/stop or overrun detected on the bus */
+  MCAL_I2C_STAT_ARB_LOST,           /**< another master took the bus */
+  MCAL_I2C_STAT_TIMEOUT,            /**< transaction didn't finish in time and was aborted */
+} MCAL_I2C_ErrStat_t;
+
+/**
+ * @brief: direction of the data phase of a transaction
+ */
+typedef enum {
+  MCAL_I2C_DIR_READ,                /**< write the register address then read 'dataLen' bytes after a repeated start */
+  MCAL_I2C_DIR_WRITE,               /**< write the register address followed by 'dataLen' bytes */
+} MCAL_I2C_Dir_t;
+
+/**
+ * @brief: one register read/write transaction, owned by the caller until its state is no longer MCAL_I2C_STAT_PENDING
+ */
+typedef struct {
+  uint8_t slaveAddress;                     /**< 7-bit address of the slave */
+  uint8_t regAddress;                       /**< first register to access, the slave auto increments it */
+  uint8_t* data;                            /**< bytes to write or buffer to read into */
+  uint8_t dataLen;                          /**< number of bytes in 'data' */
+  MCAL_I2C_Dir_t direction;                 /**< read or write */
+  RTOS_TaskHandle_t notifyTask;             /**< task notified when the transaction ends, NULL to poll 'status' instead */
+  volatile MCAL_I2C_ErrStat_t status;       /**< state of the transaction */
+} MCAL_I2C_Transaction_t;
+
+/**
+ * @brief: counters of the bus activity, read with MCAL_I2C_GetStats
+ */
+typedef struct {
+  uint32_t completed;               /**< transactions finished successfully */
+  uint32_t nacks;                   /**< transactions ended by a NACK */
+  uint32_t busErrors;               /**< transactions ended by a bus error or arbitration lost */
+  uint32_t timeouts;                /**< transactions aborted because they took too long */
+  uint32_t recoveries;              /**< times the bus was freed and the peripheral reset */
+} MCAL_I2C_Stats_t;
+
+/******************************************************************************
+ * Variables
+ *******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       MCAL_I2C_ErrStat_t MCAL_I2C_Init(I2C_InitTypeDef* arg_pI2CConfig);
+ *  \b Description                              :       configures I2C2 and its event/error interrupts, the configuration is kept to re-initialize the peripheral after a bus recovery.
+ *  @param  arg_pI2CConfig [IN]                 :       configuration of the I2C peripheral (speed, duty cycle, ...).
+ *  @note                                       :       the pins must be configured as alternate function open drain before calling this function.
+ *  \b PRE-CONDITION                            :       clock of I2C2 is enabled.
+ *  \b POST-CONDITION                           :       transactions can be submitted.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_I2C_ErrStat_t in "MCAL_I2C.h")
+ *  @see                                        :       MCAL_Config_ErrStat_t MCAL_Config_ConfigAllPins(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_I2C.h"
+ * 
+ * int main() {
+ *  I2C_InitTypeDef I2CConfig = {0};
+ *  I2CConfig.I2C_ClockSpeed = 400000;
+ *  I2CConfig.I2C_Mode = I2C_Mode_I2C;
+ *  I2CConfig.I2C_DutyCycle = I2C_DutyCycle_2;
+ *  I2CConfig.I2C_Ack = I2C_Ack_Enable;
+ *  I2CConfig.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
+ *  MCAL_I2C_Init(&I2CConfig);
+ * }
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_Init(I2C_InitTypeDef* arg_pI2CConfig);
+
+/**
+ *  \b function                                 :       MCAL_I2C_ErrStat_t MCAL_I2C_Submit(MCAL_I2C_Transaction_t* arg_pTransaction);
+ *  \b Description                              :       queues a transaction and returns immediately, the transaction is executed by the I2C2 interrupts
+ *                                                      once the transactions before it are done.
+ *  @param  arg_pTransaction [IN/OUT]           :       the transaction to execute, its 'status' becomes MCAL_I2C_STAT_PENDING until it ends.
+ *  @note                                       :       the transaction and its data buffer must stay valid until the transaction ends,
+ *                                                      'notifyTask' is notified from the ISR when it ends.
+ *  \b PRE-CONDITION                            :       MCAL_I2C_Init is called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_I2C_ErrStat_t in "MCAL_I2C.h")
+ *  @see                                        :       MCAL_I2C_ErrStat_t MCAL_I2C_Wait(MCAL_I2C_Transaction_t* arg_pTransaction, uint32_t arg_u32TimeoutMS)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_I2C.h"
+ * 
+ * void task(void *pvParameters)
+ * {
+ *   uint8_t data[6] = {0};
+ *   MCAL_I2C_Transaction_t transaction = {0x1E, 0x03, data, 6, MCAL_I2C_DIR_READ, NULL};
+ *   SERVICE_RTOS_GetCurrentTaskHandle(&transaction.notifyTask);
+ *   MCAL_I2C_Submit(&transaction);
+ *   // do something else while the bus is busy
+ *   if(MCAL_I2C_STAT_OK == MCAL_I2C_Wait(&transaction, MCAL_I2C_DEFAULT_TIMEOUT_MS))
+ *   {
+ *     // data is received
+ *   }
+ * }
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_Submit(MCAL_I2C_Transaction_t* arg_pTransaction);
+
+/**
+ *  \b function                                 :       MCAL_I2C_ErrStat_t MCAL_I2C_Wait(MCAL_I2C_Transaction_t* arg_pTransaction, uint32_t arg_u32TimeoutMS);
+ *  \b Description                              :       blocks the calling task until a submitted transaction ends, if it doesn't end in time it's aborted and the bus is recovered.
+ *  @param  arg_pTransaction [IN/OUT]           :       a transaction submitted by MCAL_I2C_Submit with 'notifyTask' set to the calling task.
+ *  @param  arg_u32TimeoutMS [IN]               :       maximum time in milliseconds to wait for the transaction.
+ *  @note                                       :       the calling task sleeps on its notification while the transfer is on the bus.
+ *  \b PRE-CONDITION                            :       the schedular is running.
+ *  \b POST-CONDITION                           :       the transaction is no longer pending.
+ *  @return                                     :       the final state of the transaction (refer to @MCAL_I2C_ErrStat_t in "MCAL_I2C.h")
+ *  @see                                        :       MCAL_I2C_ErrStat_t MCAL_I2C_Submit(MCAL_I2C_Transaction_t* arg_pTransaction)
+ *
+ *  \b Example:
+ * @code
+ * 
+ *          refer to MCAL_I2C_Submit
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_Wait(MCAL_I2C_Transaction_t* arg_pTransaction, uint32_t arg_u32TimeoutMS);
+
+/**
+ *  \b function                                 :       MCAL_I2C_ErrStat_t MCAL_I2C_ReadRegs(uint8_t arg_u8SlaveAddress, uint8_t arg_u8StartReg, uint8_t* arg_pu8Data, uint8_t arg_u8DataLen, uint32_t arg_u32TimeoutMS);
+ *  \b Description                              :       reads consecutive registers of a slave in one transaction (START, register address, repeated START, read, STOP)
+ *                                                      and blocks the calling task until the data is received.
+ *  @param  arg_u8SlaveAddress [IN]             :       7-bit address of the slave.
+ *  @param  arg_u8StartReg [IN]                 :       address of the first register to read.
+ *  @param  arg_pu8Data [OUT]                   :       base address of the buffer to store the received bytes in.
+ *  @param  arg_u8DataLen [IN]                  :       number of bytes to read.
+ *  @param  arg_u32TimeoutMS [IN]               :       maximum time in milliseconds to wait for the transaction.
+ *  @note                                       :       the task sleeps while the transfer is on the bus instead of polling the I2C flags.
+ *  \b PRE-CONDITION                            :       MCAL_I2C_Init is called and the schedular is running.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_I2C_ErrStat_t in "MCAL_I2C.h")
+ *  @see                                        :       MCAL_I2C_ErrStat_t MCAL_I2C_Submit(MCAL_I2C_Transaction_t* arg_pTransaction)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_I2C.h"
+ * 
+ * void task(void *pvParameters)
+ * {
+ *   uint8_t data[14] = {0};
+ *   if(MCAL_I2C_STAT_OK == MCAL_I2C_ReadRegs(0x68, 0x3B, data, 14, MCAL_I2C_DEFAULT_TIMEOUT_MS))
+ *   {
+ *     // data now holds registers 0x3B to 0x48
+ *   }
+ * }
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_ReadRegs(uint8_t arg_u8SlaveAddress, uint8_t arg_u8StartReg, uint8_t* arg_pu8Data, uint8_t arg_u8DataLen, uint32_t arg_u32TimeoutMS);
+
+/**
+ *  \b function                                 :       MCAL_I2C_ErrStat_t MCAL_I2C_WriteReg(uint8_t arg_u8SlaveAddress, uint8_t arg_u8Reg, uint8_t arg_u8Value, uint32_t arg_u32TimeoutMS);
+ *  \b Description                              :       writes one register of a slave and blocks the calling task until the write is done.
+ *  @param  arg_u8SlaveAddress [IN]             :       7-bit address of the slave.
+ *  @param  arg_u8Reg [IN]                      :       address of the register to write.
+ *  @param  arg_u8Value [IN]                    :       value to write.
+ *  @param  arg_u32TimeoutMS [IN]               :       maximum time in milliseconds to wait for the transaction.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       MCAL_I2C_Init is called and the schedular is running.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_I2C_ErrStat_t in "MCAL_I2C.h")
+ *  @see                                        :       MCAL_I2C_ErrStat_t MCAL_I2C_ReadRegs(uint8_t arg_u8SlaveAddress, uint8_t arg_u8StartReg, uint8_t* arg_pu8Data, uint8_t arg_u8DataLen, uint32_t arg_u32TimeoutMS)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_I2C.h"
+ * 
+ * void task(void *pvParameters)
+ * {
+ *   MCAL_I2C_WriteReg(0x68, 0x6B, 0x00, MCAL_I2C_DEFAULT_TIMEOUT_MS);
+ * }
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_WriteReg(uint8_t arg_u8SlaveAddress, uint8_t arg_u8Reg, uint8_t arg_u8Value, uint32_t arg_u32TimeoutMS);
+
+/**
+ *  \b function                                 :       MCAL_I2C_ErrStat_t MCAL_I2C_RecoverBus(void);
+ *  \b Description                              :       frees the bus from a slave stuck in the middle of a byte by clocking SCL up to 9 times and
+ *                                                      generating a STOP by hand, then resets and re-initializes I2C2 and restarts the queued transactions.
+ *  @note                                       :       called by MCAL_I2C_Wait after a timeout or a bus error, busy waits for ~0.1 ms.
+ *  \b PRE-CONDITION                            :       MCAL_I2C_Init is called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_I2C_ErrStat_t in "MCAL_I2C.h")
+ *  @see                                        :       MCAL_I2C_ErrStat_t MCAL_I2C_Wait(MCAL_I2C_Transaction_t* arg_pTransaction, uint32_t arg_u32TimeoutMS)
+ *
+ *  \b Example:
+ * @code
+ * 
+ *          MCAL_I2C_RecoverBus();
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_RecoverBus(void);
+
+/**
+ *  \b function                                 :       MCAL_I2C_ErrStat_t MCAL_I2C_GetStats(MCAL_I2C_Stats_t* arg_pStats);
+ *  \b Description                              :       returns a copy of the bus activity counters.
+ *  @param  arg_pStats [OUT]                    :       base address to store the counters in.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_I2C_ErrStat_t in "MCAL_I2C.h")
+ *  @see                                        :       None
+ *
+ *  \b Example:
+ * @code
+ * 
+ *          MCAL_I2C_Stats_t stats = {0};
+ *          MCAL_I2C_GetStats(&stats);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_I2C_ErrStat_t MCAL_I2C_GetStats(MCAL_I2C_Stats_t* arg_pStats);
+
+/*** End of File **************************************************************/
+#endif /*MCAL_I2C_HEADER_H_*/
@@ -0,0 +1,428 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   asynchronous SPI master driver                                                                              |
+ * |    @file           :   MCAL_SPI.c                                                                                                  |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file contains the DMA driven SPI1 transaction engine used by the SPI sensors                           |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains the interface of this module
+ */
+#include "MCAL_SPI.h"
+
+/**
+ * @reason: contains GPIO functionality used for the chip selects
+ */
+#include "ch32v20x_gpio.h"
+
+/**
+ * @reason: contains NVIC configuration
+ */
+#include "ch32v20x_misc.h"
+
+/**
+ * @reason: contains SPI DMA requests configuration
+ */
+#include "ch32v20x_spi.h"
+
+/**
+ * @reason: contains enabled/disabled constants
+ */
+#include "constants.h"
+
+/******************************************************************************
+ * Module Preprocessor Constants
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Preprocessor Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Typedefs
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Variable Definitions
+ *******************************************************************************/
+
+/**
+ * @brief: transactions waiting for the bus, the one at the head is the one on the bus
+ */
+MCAL_SPI_Transaction_t* global_SPIQueue[MCAL_SPI_QUEUE_LEN] = {NULL};
+
+/**
+ * @brief: index of the head of the queue and number of queued transactions
+ */
+volatile uint8_t global_u8SPIQueueHead = 0;
+volatile uint8_t global_u8SPIQueueCount = 0;
+
+/**
+ * @brief: the transaction on the bus, NULL when the bus is idle
+ */
+MCAL_SPI_Transaction_t* volatile global_SPICurrent_t = NULL;
+
+/**
+ * @brief: byte sent for the transactions without TX data and byte the dropped RX data is written to
+ */
+const uint8_t global_u8SPIZeroTx = 0;
+volatile uint8_t global_u8SPIDummyRx = 0;
+
+/**
+ * @brief: counters of the bus activity
+ */
+volatile MCAL_SPI_Stats_t global_SPIStats_t = {0};
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ * @brief: DMA1 channel 2 (SPI1 RX) IRQ handler
+ */
+void DMA1_Channel2_IRQHandler(void) __attribute__((interrupt()));
+
+/**
+ * @brief: puts the transaction at the head of the queue on the bus, must be called with the interrupts disabled or from the ISR
+ */
+void MCAL_SPI_StartNext(void);
+
+/**
+ * @brief: stops both DMA channels and releases the chip select of the transaction on the bus
+ */
+void MCAL_SPI_StopTransfer(void);
+
+/**
+ * @brief: ends the current transaction with the given state, notifies its task and starts the next one
+ */
+void MCAL_SPI_Complete(MCAL_SPI_ErrStat_t arg_Status);
+
+/******************************************************************************
+ * Function Definitions
+ *******************************************************************************/
+
+/**
+ * 
+ */
+MCAL_SPI_ErrStat_t MCAL_SPI_Init(void)
+{
+    DMA_InitTypeDef local_DMAInit_t = {0};
+    NVIC_InitTypeDef local_NVICInit_t = {0};
+
+    global_u8SPIQueueHead = 0;
+    global_u8SPIQueueCount = 0;
+    global_SPICurrent_t = NULL;
+
+    // the addresses and lengths are set for every transaction, only the fixed part is configured here
+    local_DMAInit_t.DMA_PeripheralBaseAddr = (uint32_t)&MCAL_SPI_PERIPHERAL->DATAR;
+    local_DMAInit_t.DMA_MemoryBaseAddr = (uint32_t)&global_u8SPIDummyRx;
+    local_DMAInit_t.DMA_DIR = DMA_DIR_PeripheralSRC;
+    local_DMAInit_t.DMA_BufferSize = 1;
+    local_DMAInit_t.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    local_DMAInit_t.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    local_DMAInit_t.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    local_DMAInit_t.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    local_DMAInit_t.DMA_Mode = DMA_Mode_Normal;
+    // the RX channel is served first so no received byte is overwritten before it's stored
+    local_DMAInit_t.DMA_Priority = DMA_Priority_VeryHigh;
+    local_DMAInit_t.DMA_M2M = DMA_M2M_Disable;
+    DMA_DeInit(MCAL_SPI_DMA_RX_CHANNEL);
+    DMA_Init(MCAL_SPI_DMA_RX_CHANNEL, &local_DMAInit_t);
+
+    local_DMAInit_t.DMA_MemoryBaseAddr = (uint32_t)&global_u8SPIZeroTx;
+    local_DMAInit_t.DMA_DIR = DMA_DIR_PeripheralDST;
+    local_DMAInit_t.DMA_Priority = DMA_Priority_High;
+    DMA_DeInit(MCAL_SPI_DMA_TX_CHANNEL);
+    DMA_Init(MCAL_SPI_DMA_TX_CHANNEL, &local_DMAInit_t);
+
+    // the last received byte ends the transaction, the TX channel is always done by then
+    DMA_ITConfig(MCAL_SPI_DMA_RX_CHANNEL, DMA_IT_TC | DMA_IT_TE, ENABLE);
+    SPI_I2S_DMACmd(MCAL_SPI_PERIPHERAL, SPI_I2S_DMAReq_Tx | SPI_I2S_DMAReq_Rx, ENABLE);
+
+    local_NVICInit_t.NVIC_IRQChannel = MCAL_SPI_DMA_RX_IRQ;
+    local_NVICInit_t.NVIC_IRQChannelPreemptionPriority = MCAL_SPI_IRQ_PREEMPTION_PRIO;
+    local_NVICInit_t.NVIC_IRQChannelSubPriority = MCAL_SPI_IRQ_SUB_PRIO;
+    local_NVICInit_t.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&local_NVICInit_t);
+
+    return MCAL_SPI_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_SPI_ErrStat_t MCAL_SPI_Submit(MCAL_SPI_Transaction_t* arg_pTransaction)
+{
+    MCAL_SPI_ErrStat_t local_errState = MCAL_SPI_STAT_OK;
+
+    if(NULL == arg_pTransaction || NULL == arg_pTransaction->device || 0 == arg_pTransaction->dataLen
+       || MCAL_SPI_PERIPHERAL != arg_pTransaction->device->SPI)
+        return MCAL_SPI_STAT_INVALID_PARAMS;
+
+    SERVICE_RTOS_EnterCritical();
+    if(MCAL_SPI_QUEUE_LEN <= global_u8SPIQueueCount)
+    {
+        local_errState = MCAL_SPI_STAT_QUEUE_FULL;
+    }
+    else
+    {
+        arg_pTransaction->status = MCAL_SPI_STAT_PENDING;
+        global_SPIQueue[(global_u8SPIQueueHead + global_u8SPIQueueCount) % MCAL_SPI_QUEUE_LEN] = arg_pTransaction;
+        global_u8SPIQueueCount++;
+
+        if(NULL == global_SPICurrent_t)
+            MCAL_SPI_StartNext();
+    }
+    SERVICE_RTOS_ExitCritical();
+
+    return local_errState;
+}
+
+/**
+ * 
+ */
+MCAL_SPI_ErrStat_t MCAL_SPI_Wait(MCAL_SPI_Transaction_t* arg_pTransaction, uint32_t arg_u32TimeoutMS)
+{
+    uint32_t local_u32StartTime = 0;
+    uint32_t local_u32CurrentTime = 0;
+    uint8_t local_u8Index = 0;
+
+    if(NULL == arg_pTransaction)
+        return MCAL_SPI_STAT_INVALID_PARAMS;
+
+    SERVICE_RTOS_CurrentMSTime(&local_u32StartTime);
+    while(MCAL_SPI_STAT_PENDING == arg_pTransaction->status)
+    {
+        SERVICE_RTOS_CurrentMSTime(&local_u32CurrentTime);
+        if(local_u32CurrentTime - local_u32StartTime >= arg_u32TimeoutMS)
+        {
+            // the transaction is stuck, take it out of the bus/queue so the caller can reuse its memory
+            SERVICE_RTOS_EnterCritical();
+            if(MCAL_SPI_STAT_PENDING == arg_pTransaction->status)
+            {
+                // remove it from the queue keeping the order of the others
+                for(local_u8Index = 0; local_u8Index < global_u8SPIQueueCount; local_u8Index++)
+                {
+                    if(arg_pTransaction == global_SPIQueue[(global_u8SPIQueueHead + local_u8Index) % MCAL_SPI_QUEUE_LEN])
+                        break;
+                }
+                for(; local_u8Index + 1 < global_u8SPIQueueCount; local_u8Index++)
+                {
+                    global_SPIQueue[(global_u8SPIQueueHead + local_u8Index) % MCAL_SPI_QUEUE_LEN] =
+                        global_SPIQueue[(global_u8SPIQueueHead + local_u8Index + 1) % MCAL_SPI_QUEUE_LEN];
+                }
+                if(local_u8Index < global_u8SPIQueueCount)
+                    global_u8SPIQueueCount--;
+
+                global_SPIStats_t.timeouts++;
+                arg_pTransaction->status = MCAL_SPI_STAT_TIMEOUT;
+
+                // the one on the bus is at the head, the next one takes its place
+                if(arg_pTransaction == global_SPICurrent_t)
+                {
+                    MCAL_SPI_StopTransfer();
+                    MCAL_SPI_StartNext();
+                }
+            }
+            SERVICE_RTOS_ExitCritical();
+            break;
+        }
+
+        SERVICE_RTOS_WaitForNotification(arg_u32TimeoutMS - (local_u32CurrentTime - local_u32StartTime));
+    }
+
+    return arg_pTransaction->status;
+}
+
+/**
+ * 
+ */
+MCAL_SPI_ErrStat_t MCAL_SPI_Transfer(MCAL_CONFIG_SPI_t* arg_pDevice, const uint8_t* arg_pu8TxData, uint8_t* arg_pu8RxData, uint16_t arg_u16Len, uint32_t arg_u32TimeoutMS)
+{
+    MCAL_SPI_ErrStat_t local_errState = MCAL_SPI_STAT_OK;
+    MCAL_SPI_Transaction_t local_transaction_t = {0};
+
+    local_transaction_t.device = arg_pDevice;
+    local_transaction_t.txData = arg_pu8TxData;
+    local_transaction_t.rxData = arg_pu8RxData;
+    local_transaction_t.dataLen = arg_u16Len;
+    SERVICE_RTOS_GetCurrentTaskHandle(&local_transaction_t.notifyTask);
+
+    local_errState = MCAL_SPI_Submit(&local_transaction_t);
+    if(MCAL_SPI_STAT_OK != local_errState)
+        return local_errState;
+
+    return MCAL_SPI_Wait(&local_transaction_t, arg_u32TimeoutMS);
+}
+
+/**
+ * 
+ */
+MCAL_SPI_ErrStat_t MCAL_SPI_GetStats(MCAL_SPI_Stats_t* arg_pStats)
+{
+    if(NULL == arg_pStats)
+        return MCAL_SPI_STAT_INVALID_PARAMS;
+
+    SERVICE_RTOS_EnterCritical();
+    *arg_pStats = global_SPIStats_t;
+    SERVICE_RTOS_ExitCritical();
+
+    return MCAL_SPI_STAT_OK;
+}
+
+/**
+ * NOTE: the memory increment is turned off to send the same zero byte or to drop the received bytes into one dummy byte
+ */
+void MCAL_SPI_StartNext(void)
+{
+    MCAL_SPI_Transaction_t* local_pTransaction = NULL;
+
+    if(0 == global_u8SPIQueueCount)
+    {
+        global_SPICurrent_t = NULL;
+        return;
+    }
+
+    local_pTransaction = global_SPIQueue[global_u8SPIQueueHead];
+    global_SPICurrent_t = local_pTransaction;
+
+    // a byte left by a polled transfer would be taken as the first received byte
+    (void)SPI_I2S_ReceiveData(MCAL_SPI_PERIPHERAL);
+
+    if(NULL != local_pTransaction->rxData)
+    {
+        MCAL_SPI_DMA_RX_CHANNEL->MADDR = (uint32_t)local_pTransaction->rxData;
+        MCAL_SPI_DMA_RX_CHANNEL->CFGR |= DMA_MemoryInc_Enable;
+    }
+    else
+    {
+        MCAL_SPI_DMA_RX_CHANNEL->MADDR = (uint32_t)&global_u8SPIDummyRx;
+        MCAL_SPI_DMA_RX_CHANNEL->CFGR &= ~DMA_MemoryInc_Enable;
+    }
+    MCAL_SPI_DMA_RX_CHANNEL->CNTR = local_pTransaction->dataLen;
+
+    if(NULL != local_pTransaction->txData)
+    {
+        MCAL_SPI_DMA_TX_CHANNEL->MADDR = (uint32_t)local_pTransaction->txData;
+        MCAL_SPI_DMA_TX_CHANNEL->CFGR |= DMA_MemoryInc_Enable;
+    }
+    else
+    {
+        MCAL_SPI_DMA_TX_CHANNEL->MADDR = (uint32_t)&global_u8SPIZeroTx;
+        MCAL_SPI_DMA_TX_CHANNEL->CFGR &= ~DMA_MemoryInc_Enable;
+    }
+    MCAL_SPI_DMA_TX_CHANNEL->CNTR = local_pTransaction->dataLen;
+
+    DMA_ClearITPendingBit(MCAL_SPI_DMA_RX_IT_GL | MCAL_SPI_DMA_TX_IT_GL);
+
+    // select the slave then let the TX request start the clock
+    GPIO_ResetBits(local_pTransaction->device->GPIO, local_pTransaction->device->SlavePin);
+    DMA_Cmd(MCAL_SPI_DMA_RX_CHANNEL, ENABLE);
+    DMA_Cmd(MCAL_SPI_DMA_TX_CHANNEL, ENABLE);
+}
+
+/**
+ * 
+ */
+void MCAL_SPI_StopTransfer(void)
+{
+    DMA_Cmd(MCAL_SPI_DMA_TX_CHANNEL, DISABLE);
+    DMA_Cmd(MCAL_SPI_DMA_RX_CHANNEL, DISABLE);
+    DMA_ClearITPendingBit(MCAL_SPI_DMA_RX_IT_GL | MCAL_SPI_DMA_TX_IT_GL);
+
+    GPIO_SetBits(global_SPICurrent_t->device->GPIO, global_SPICurrent_t->device->SlavePin);
+    global_SPICurrent_t = NULL;
+}
+
+/**
+ * 
+ */
+void MCAL_SPI_Complete(MCAL_SPI_ErrStat_t arg_Status)
+{
+    MCAL_SPI_Transaction_t* local_pTransaction = global_SPICurrent_t;
+    RTOS_TaskHandle_t local_notifyTask = local_pTransaction->notifyTask;
+
+    MCAL_SPI_StopTransfer();
+
+    global_u8SPIQueueHead = (global_u8SPIQueueHead + 1) % MCAL_SPI_QUEUE_LEN;
+    global_u8SPIQueueCount--;
+
+    if(MCAL_SPI_STAT_OK == arg_Status)
+    {
+        global_SPIStats_t.completed++;
+        global_SPIStats_t.bytes += local_pTransaction->dataLen;
+    }
+    else
+    {
+        global_SPIStats_t.dmaErrors++;
+    }
+
+    // the owner may reuse the transaction as soon as it's not pending, don't touch it after this line
+    local_pTransaction->status = arg_Status;
+
+    if(NULL != local_notifyTask)
+        SERVICE_RTOS_Notify(local_notifyTask, LIB_CONSTANTS_ENABLED);
+
+    MCAL_SPI_StartNext();
+}
+
+/**
+ * NOTE: the RX channel completes once the last byte is shifted in, the clock is stopped by then so the chip select can
+ *       be released right away
+ */
+void DMA1_Channel2_IRQHandler(void)
+{
+    if(NULL == global_SPICurrent_t)
+    {
+        DMA_ClearITPendingBit(MCAL_SPI_DMA_RX_IT_GL | MCAL_SPI_DMA_TX_IT_GL);
+        return;
+    }
+
+    if(DMA_GetITStatus(MCAL_SPI_DMA_RX_IT_TE))
+        MCAL_SPI_Complete(MCAL_SPI_STAT_DMA_ERR);
+    else if(DMA_GetITStatus(MCAL_SPI_DMA_RX_IT_TC))
+        MCAL_SPI_Complete(MCAL_SPI_STAT_OK);
+}
+
+/*************** END OF FUNCTIONS ***************************************************************************/
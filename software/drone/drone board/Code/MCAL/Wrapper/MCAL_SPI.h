@@ -0,0 +1,327 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   asynchronous SPI master driver                                                                              |
+ * |    @file           :   MCAL_SPI.h                                                                                                  |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file contains the DMA driven SPI1 transaction engine used by the SPI sensors                           |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+
+#ifndef MCAL_SPI_HEADER_H_
+#define MCAL_SPI_HEADER_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains standard definitions for int
+ */
+#include "stdint.h"
+
+/**
+ * @reason: contains common definitions
+ */
+#include "common.h"
+
+/**
+ * @reason: contains the SPI device struct (SPI and chip select pin of the slave)
+ */
+#include "MCAL_config.h"
+
+/**
+ * @reason: contains DMA channels definitions
+ */
+#include "ch32v20x_dma.h"
+
+/**
+ * @reason: contains definition of the task handle to notify
+ */
+#include "Service_RTOS_wrapper.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: maximum number of transactions that can wait for the bus at the same time
+ */
+#define MCAL_SPI_QUEUE_LEN                  (4)
+
+/**
+ * @brief: timeout used by the sensors drivers for a single transaction, a 25 bytes burst takes ~0.4 ms at 562.5 KHz
+ */
+#define MCAL_SPI_DEFAULT_TIMEOUT_MS         (10)
+
+/******************************************************************************
+ * Configuration Constants
+ *******************************************************************************/
+
+/**
+ * @brief: the SPI served by the engine and its DMA1 channels (fixed by the hardware for SPI1)
+ */
+#define MCAL_SPI_PERIPHERAL                 SPI1
+#define MCAL_SPI_DMA_RX_CHANNEL             DMA1_Channel2
+#define MCAL_SPI_DMA_TX_CHANNEL             DMA1_Channel3
+#define MCAL_SPI_DMA_RX_IRQ                 DMA1_Channel2_IRQn
+#define MCAL_SPI_DMA_RX_IT_TC               DMA1_IT_TC2
+#define MCAL_SPI_DMA_RX_IT_TE               DMA1_IT_TE2
+#define MCAL_SPI_DMA_RX_IT_GL               DMA1_IT_GL2
+#define MCAL_SPI_DMA_TX_IT_GL               DMA1_IT_GL3
+
+/**
+ * @brief: priority of the DMA interrupt ending the transactions
+ */
+#define MCAL_SPI_IRQ_PREEMPTION_PRIO        (1)
+#define MCAL_SPI_IRQ_SUB_PRIO               (2)
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: contains error states for this module, also used as the state of a transaction
+*/
+typedef enum {
+  MCAL_SPI_STAT_OK,                 /**< transaction finished successfully */
+  MCAL_SPI_STAT_INVALID_PARAMS,     /**< invalid arguments */
+  MCAL_SPI_STAT_PENDING,            /**< transaction is queued or on the bus */
+  MCAL_SPI_STAT_QUEUE_FULL,         /**< no room in the queue, try again later */
+  MCAL_SPI_STAT_DMA_ERR,            /**< the DMA reported a transfer error */
+  MCAL_SPI_STAT_TIMEOUT,            /**< transaction didn't finish in time and was aborted */
+} MCAL_SPI_ErrStat_t;
+
+/**
+ * @brief: one full duplex transfer with a slave, owned by the caller until its state is no longer MCAL_SPI_STAT_PENDING
+ */
+typedef struct {
+  MCAL_CONFIG_SPI_t* device;                /**< the slave, its chip select is held low during the whole transfer */
+  const uint8_t* txData;                    /**< bytes to send, NULL to send zeros */
+  uint8_t* rxData;                          /**< buffer to receive into, NULL to drop the received bytes, may be 'txData' */
+  uint16_t dataLen;                         /**< number of bytes to send and receive */
+  RTOS_TaskHandle_t notifyTask;             /**< task notified when the transaction ends, NULL to poll 'status' instead */
+  volatile MCAL_SPI_ErrStat_t status;       /**< state of the transaction */
+} MCAL_SPI_Transaction_t;
+
+/**
+ * @brief: counters of the bus activity, read with MCAL_SPI_GetStats
+ */
+typedef struct {
+  uint32_t completed;               /**< transactions finished successfully */
+  uint32_t bytes;                   /**< bytes exchanged by the completed transactions */
+  uint32_t dmaErrors;               /**< transactions ended by a DMA transfer error */
+  uint32_t timeouts;                /**< transactions aborted because they took too long */
+} MCAL_SPI_Stats_t;
+
+/******************************************************************************
+ * Variables
+ *******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       MCAL_SPI_ErrStat_t MCAL_SPI_Init(void);
+ *  \b Description                              :       configures the DMA1 channels of SPI1 (RX and TX) and the interrupt of the RX channel that ends the transactions.
+ *  @note                                       :       the SPI itself is configured by the caller, the engine only owns its DMA requests.
+ *  \b PRE-CONDITION                            :       clock of DMA1 is enabled, SPI1 is configured and enabled.
+ *  \b POST-CONDITION                           :       transactions can be submitted.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_SPI_ErrStat_t in "MCAL_SPI.h")
+ *  @see                                        :       MCAL_Config_ErrStat_t MCAL_Config_ConfigAllPins(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_SPI.h"
+ * 
+ * int main() {
+ *  SPI_Init(SPI1, &MCAL_CFG_BMPSPI.spiConfig);
+ *  SPI_Cmd(SPI1, ENABLE);
+ *  MCAL_SPI_Init();
+ * }
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_SPI_ErrStat_t MCAL_SPI_Init(void);
+
+/**
+ *  \b function                                 :       MCAL_SPI_ErrStat_t MCAL_SPI_Submit(MCAL_SPI_Transaction_t* arg_pTransaction);
+ *  \b Description                              :       queues a transaction and returns immediately, the bytes are moved by DMA once the transactions before it are done
+ *                                                      and the transaction ends from the interrupt of the RX channel.
+ *  @param  arg_pTransaction [IN/OUT]           :       the transaction to execute, its 'status' becomes MCAL_SPI_STAT_PENDING until it ends.
+ *  @note                                       :       the transaction and its buffers must stay valid until the transaction ends,
+ *                                                      'notifyTask' is notified from the ISR when it ends.
+ *  \b PRE-CONDITION                            :       MCAL_SPI_Init is called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_SPI_ErrStat_t in "MCAL_SPI.h")
+ *  @see                                        :       MCAL_SPI_ErrStat_t MCAL_SPI_Wait(MCAL_SPI_Transaction_t* arg_pTransaction, uint32_t arg_u32TimeoutMS)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_SPI.h"
+ * 
+ * void task(void *pvParameters)
+ * {
+ *   uint8_t data[7] = {0xF7 | 0x80};
+ *   MCAL_SPI_Transaction_t transaction = {&MCAL_CFG_BMPSPI, data, data, 7, NULL};
+ *   SERVICE_RTOS_GetCurrentTaskHandle(&transaction.notifyTask);
+ *   MCAL_SPI_Submit(&transaction);
+ *   // do something else while the bus is busy
+ *   if(MCAL_SPI_STAT_OK == MCAL_SPI_Wait(&transaction, MCAL_SPI_DEFAULT_TIMEOUT_MS))
+ *   {
+ *     // data[1] to data[6] hold registers 0xF7 to 0xFC
+ *   }
+ * }
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_SPI_ErrStat_t MCAL_SPI_Submit(MCAL_SPI_Transaction_t* arg_pTransaction);
+
+/**
+ *  \b function                                 :       MCAL_SPI_ErrStat_t MCAL_SPI_Wait(MCAL_SPI_Transaction_t* arg_pTransaction, uint32_t arg_u32TimeoutMS);
+ *  \b Description                              :       blocks the calling task until a submitted transaction ends, if it doesn't end in time it's aborted.
+ *  @param  arg_pTransaction [IN/OUT]           :       a transaction submitted by MCAL_SPI_Submit with 'notifyTask' set to the calling task.
+ *  @param  arg_u32TimeoutMS [IN]               :       maximum time in milliseconds to wait for the transaction.
+ *  @note                                       :       the calling task sleeps on its notification while the transfer is on the bus.
+ *  \b PRE-CONDITION                            :       the schedular is running.
+ *  \b POST-CONDITION                           :       the transaction is no longer pending.
+ *  @return                                     :       the final state of the transaction (refer to @MCAL_SPI_ErrStat_t in "MCAL_SPI.h")
+ *  @see                                        :       MCAL_SPI_ErrStat_t MCAL_SPI_Submit(MCAL_SPI_Transaction_t* arg_pTransaction)
+ *
+ *  \b Example:
+ * @code
+ * 
+ *          refer to MCAL_SPI_Submit
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_SPI_ErrStat_t MCAL_SPI_Wait(MCAL_SPI_Transaction_t* arg_pTransaction, uint32_t arg_u32TimeoutMS);
+
+/**
+ *  \b function                                 :       MCAL_SPI_ErrStat_t MCAL_SPI_Transfer(MCAL_CONFIG_SPI_t* arg_pDevice, const uint8_t* arg_pu8TxData, uint8_t* arg_pu8RxData, uint16_t arg_u16Len, uint32_t arg_u32TimeoutMS);
+ *  \b Description                              :       exchanges bytes with a slave in one chip select cycle and blocks the calling task until the transfer ends.
+ *  @param  arg_pDevice [IN]                    :       the slave to talk to.
+ *  @param  arg_pu8TxData [IN]                  :       bytes to send, NULL to send zeros.
+ *  @param  arg_pu8RxData [OUT]                 :       buffer to store the received bytes in, NULL to drop them, may be 'arg_pu8TxData'.
+ *  @param  arg_u16Len [IN]                     :       number of bytes to exchange.
+ *  @param  arg_u32TimeoutMS [IN]               :       maximum time in milliseconds to wait for the transfer.
+ *  @note                                       :       the task sleeps while the DMA moves the bytes instead of polling the SPI flags.
+ *  \b PRE-CONDITION                            :       MCAL_SPI_Init is called and the schedular is running.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_SPI_ErrStat_t in "MCAL_SPI.h")
+ *  @see                                        :       MCAL_SPI_ErrStat_t MCAL_SPI_Submit(MCAL_SPI_Transaction_t* arg_pTransaction)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_SPI.h"
+ * 
+ * void task(void *pvParameters)
+ * {
+ *   uint8_t data[2] = {0xD0 | 0x80, 0};
+ *   if(MCAL_SPI_STAT_OK == MCAL_SPI_Transfer(&MCAL_CFG_BMPSPI, data, data, 2, MCAL_SPI_DEFAULT_TIMEOUT_MS))
+ *   {
+ *     // data[1] holds the chip id
+ *   }
+ * }
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_SPI_ErrStat_t MCAL_SPI_Transfer(MCAL_CONFIG_SPI_t* arg_pDevice, const uint8_t* arg_pu8TxData, uint8_t* arg_pu8RxData, uint16_t arg_u16Len, uint32_t arg_u32TimeoutMS);
+
+/**
+ *  \b function                                 :       MCAL_SPI_ErrStat_t MCAL_SPI_GetStats(MCAL_SPI_Stats_t* arg_pStats);
+ *  \b Description                              :       returns a copy of the bus activity counters.
+ *  @param  arg_pStats [OUT]                    :       base address to store the counters in.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_SPI_ErrStat_t in "MCAL_SPI.h")
+ *  @see                                        :       None
+ *
+ *  \b Example:
+ * @code
+ * 
+ *          MCAL_SPI_Stats_t stats = {0};
+ *          MCAL_SPI_GetStats(&stats);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_SPI_ErrStat_t MCAL_SPI_GetStats(MCAL_SPI_Stats_t* arg_pStats);
+
+/*** End of File **************************************************************/
+#endif /*MCAL_SPI_HEADER_H_*/
@@ -0,0 +1,225 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   TIM3 periodic tick of the control loop                                                                      |
+ * |    @file           :   MCAL_TIM3.c                                                                                                 |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   wakes up a task on every period of TIM3 so the control loop runs at a fixed rate                            |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains the interface of this module
+ */
+#include "MCAL_TIM3.h"
+
+/**
+ * @reason: contains timer functionality
+ */
+#include "ch32v20x_tim.h"
+
+/**
+ * @reason: contains the clock gate of TIM3
+ */
+#include "ch32v20x_rcc.h"
+
+/**
+ * @reason: contains NVIC configuration
+ */
+#include "ch32v20x_misc.h"
+
+/**
+ * @reason: contains definition for NULL
+ */
+#include "common.h"
+
+/**
+ * @reason: contains the notifications and the time of the ticks
+ */
+#include "Service_RTOS_wrapper.h"
+
+/**
+ * @reason: contains constants common values
+ */
+#include "constants.h"
+
+/******************************************************************************
+ * Module Preprocessor Constants
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Preprocessor Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Typedefs
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Variable Definitions
+ *******************************************************************************/
+
+/**
+ * @brief: the task waiting for the ticks
+ */
+RTOS_TaskHandle_t global_TIM3Task_t = NULL;
+
+/**
+ * @brief: number of ticks since the start and the time of the last one in micro seconds
+ */
+volatile uint32_t global_u32TIM3Ticks = 0;
+volatile uint32_t global_u32TIM3TickTimeUS = 0;
+
+/**
+ * @brief: number of ticks already handed to the waiting task
+ */
+uint32_t global_u32TIM3Served = 0;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ * @brief: TIM3 IRQ handler (tick)
+ */
+void TIM3_IRQHandler(void) __attribute__((interrupt()));
+
+/******************************************************************************
+ * Function Definitions
+ *******************************************************************************/
+
+/**
+ * 
+ */
+MCAL_TIM3_ErrStat_t MCAL_TIM3_StartPeriodic(uint32_t arg_u32PeriodUS)
+{
+    TIM_TimeBaseInitTypeDef local_TIMInit_t = {0};
+    NVIC_InitTypeDef local_NVICInit_t = {0};
+
+    if(arg_u32PeriodUS < 2 || arg_u32PeriodUS > MCAL_TIM3_MAX_PERIOD_US)
+        return MCAL_TIM3_STAT_INVALID_PARAMS;
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM3, ENABLE);
+    TIM_Cmd(TIM3, DISABLE);
+
+    // one count per micro second
+    local_TIMInit_t.TIM_CounterMode = TIM_CounterMode_Up;
+    local_TIMInit_t.TIM_ClockDivision = TIM_CKD_DIV1;
+    local_TIMInit_t.TIM_Prescaler = (MCAL_TIM3_CLOCK_HZ / 1000000) - 1;
+    local_TIMInit_t.TIM_Period = (uint16_t)(arg_u32PeriodUS - 1);
+    TIM_TimeBaseInit(TIM3, &local_TIMInit_t);
+
+    // the init generates an update event to load the prescaler, it isn't a tick
+    TIM_ClearITPendingBit(TIM3, TIM_IT_Update);
+    TIM_ITConfig(TIM3, TIM_IT_Update, ENABLE);
+
+    local_NVICInit_t.NVIC_IRQChannel = TIM3_IRQn;
+    local_NVICInit_t.NVIC_IRQChannelPreemptionPriority = MCAL_TIM3_IRQ_PREEMPTION_PRIO;
+    local_NVICInit_t.NVIC_IRQChannelSubPriority = MCAL_TIM3_IRQ_SUB_PRIO;
+    local_NVICInit_t.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&local_NVICInit_t);
+
+    TIM_Cmd(TIM3, ENABLE);
+
+    return MCAL_TIM3_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_TIM3_ErrStat_t MCAL_TIM3_WaitTick(uint32_t arg_u32TimeoutMS, uint32_t* arg_pu32TickTimeUS, uint32_t* arg_pu32MissedTicks)
+{
+    uint32_t local_u32StartTime = 0;
+    uint32_t local_u32CurrentTime = 0;
+    uint32_t local_u32Ticks = 0;
+    uint32_t local_u32TickTime = 0;
+
+    // get the current handle, the ticks that came before the first wait aren't missed
+    if(NULL == global_TIM3Task_t)
+    {
+        global_u32TIM3Served = global_u32TIM3Ticks;
+        SERVICE_RTOS_GetCurrentTaskHandle(&global_TIM3Task_t);
+    }
+
+    // a wake up isn't always a tick, the task waits again until the update interrupt moves the tick counter past the served one
+    SERVICE_RTOS_CurrentMSTime(&local_u32StartTime);
+    while(global_u32TIM3Ticks == global_u32TIM3Served)
+    {
+        SERVICE_RTOS_CurrentMSTime(&local_u32CurrentTime);
+        if(local_u32CurrentTime - local_u32StartTime >= arg_u32TimeoutMS)
+            return MCAL_TIM3_STAT_TIMEOUT;
+
+        SERVICE_RTOS_WaitForNotification(arg_u32TimeoutMS - (local_u32CurrentTime - local_u32StartTime));
+    }
+
+    // take the counter and the time of the same tick
+    SERVICE_RTOS_EnterCritical();
+    local_u32Ticks = global_u32TIM3Ticks;
+    local_u32TickTime = global_u32TIM3TickTimeUS;
+    SERVICE_RTOS_ExitCritical();
+
+    if(NULL != arg_pu32TickTimeUS)
+        *arg_pu32TickTimeUS = local_u32TickTime;
+
+    if(NULL != arg_pu32MissedTicks)
+        *arg_pu32MissedTicks = local_u32Ticks - global_u32TIM3Served - 1;
+
+    global_u32TIM3Served = local_u32Ticks;
+
+    return MCAL_TIM3_STAT_OK;
+}
+
+/**
+ * 
+ */
+void TIM3_IRQHandler(void)
+{
+    if(TIM_GetITStatus(TIM3, TIM_IT_Update) != RESET)
+    {
+        // the micro seconds time counts a tick whose interrupt is held back by this one
+        SERVICE_RTOS_CurrentUSTime((uint32_t*)&global_u32TIM3TickTimeUS);
+        global_u32TIM3Ticks++;
+        TIM_ClearITPendingBit(TIM3, TIM_IT_Update);
+
+        if(NULL != global_TIM3Task_t)
+            SERVICE_RTOS_Notify(global_TIM3Task_t, LIB_CONSTANTS_ENABLED);
+    }
+}
@@ -0,0 +1,180 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   TIM3 periodic tick of the control loop                                                                      |
+ * |    @file           :   MCAL_TIM3.h                                                                                                 |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   wakes up a task on every period of TIM3 so the control loop runs at a fixed rate                            |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+
+#ifndef MCAL_TIM3_HEADER_H_
+#define MCAL_TIM3_HEADER_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains standard definitions for int
+ */
+#include "stdint.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: clock of TIM3 in Hz (APB1 is not divided, refer to "system_ch32v20x.c")
+ */
+#define MCAL_TIM3_CLOCK_HZ                  (144000000UL)
+
+/**
+ * @brief: TIM3 counts micro seconds, so the longest period is 65536 us
+ */
+#define MCAL_TIM3_MAX_PERIOD_US             (65536UL)
+
+/******************************************************************************
+ * Configuration Constants
+ *******************************************************************************/
+
+/**
+ * @brief: priority of the update interrupt, the same as the data ready pin of the MPU6050 as both pace a task
+ */
+#define MCAL_TIM3_IRQ_PREEMPTION_PRIO       (1)
+#define MCAL_TIM3_IRQ_SUB_PRIO              (0)
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: contains error states for this module
+*/
+typedef enum {
+  MCAL_TIM3_STAT_OK,                /**< everything went as intended */
+  MCAL_TIM3_STAT_INVALID_PARAMS,    /**< invalid arguments */
+  MCAL_TIM3_STAT_TIMEOUT,           /**< no tick came in time */
+} MCAL_TIM3_ErrStat_t;
+
+/******************************************************************************
+ * Variables
+ *******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       MCAL_TIM3_ErrStat_t MCAL_TIM3_StartPeriodic(uint32_t arg_u32PeriodUS);
+ *  \b Description                              :       starts TIM3 counting micro seconds with an update interrupt every period, each one is a tick
+ *                                                      waited for by 'MCAL_TIM3_WaitTick'.
+ *  @param  arg_u32PeriodUS [IN]                :       period of the ticks in micro seconds, from 2 to MCAL_TIM3_MAX_PERIOD_US.
+ *  @note                                       :       the ticks follow the crystal of the MCU, not the RTOS tick, so they neither drift nor jitter
+ *                                                      with the RTOS tick rate.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       the ticks run until reset.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_TIM3_ErrStat_t in "MCAL_TIM3.h")
+ *  @see                                        :       MCAL_TIM3_ErrStat_t MCAL_TIM3_WaitTick(uint32_t arg_u32TimeoutMS, uint32_t* arg_pu32TickTimeUS, uint32_t* arg_pu32MissedTicks)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_TIM3.h"
+ * 
+ * // 500 Hz
+ * MCAL_TIM3_StartPeriodic(2000);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_TIM3_ErrStat_t MCAL_TIM3_StartPeriodic(uint32_t arg_u32PeriodUS);
+
+/**
+ *  \b function                                 :       MCAL_TIM3_ErrStat_t MCAL_TIM3_WaitTick(uint32_t arg_u32TimeoutMS, uint32_t* arg_pu32TickTimeUS, uint32_t* arg_pu32MissedTicks);
+ *  \b Description                              :       blocks the calling task until the next tick of TIM3.
+ *  @param  arg_u32TimeoutMS [IN]               :       maximum time in milliseconds to wait for the tick.
+ *  @param  arg_pu32TickTimeUS [OUT]            :       time in micro seconds (SERVICE_RTOS_CurrentUSTime) of the tick, can be NULL.
+ *  @param  arg_pu32MissedTicks [OUT]           :       number of ticks that came since the last call and were not waited for (overruns of the
+ *                                                      task), can be NULL.
+ *  @note                                       :       the first task that waits owns the ticks, it returns immediately if a tick came since the last call.
+ *  \b PRE-CONDITION                            :       MCAL_TIM3_StartPeriodic is called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       MCAL_TIM3_STAT_TIMEOUT if no tick came in time, otherwise one of error states (refer to @MCAL_TIM3_ErrStat_t in "MCAL_TIM3.h")
+ *  @see                                        :       MCAL_TIM3_ErrStat_t MCAL_TIM3_StartPeriodic(uint32_t arg_u32PeriodUS)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_TIM3.h"
+ * 
+ * void task(void *pvParameters)
+ * {
+ *   uint32_t tickTime = 0;
+ *   MCAL_TIM3_StartPeriodic(2000);
+ *   while(1)
+ *   {
+ *     if(MCAL_TIM3_STAT_OK == MCAL_TIM3_WaitTick(10, &tickTime, NULL))
+ *     {
+ *       // one period of the loop
+ *     }
+ *   }
+ * }
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_TIM3_ErrStat_t MCAL_TIM3_WaitTick(uint32_t arg_u32TimeoutMS, uint32_t* arg_pu32TickTimeUS, uint32_t* arg_pu32MissedTicks);
+
+/*** End of File **************************************************************/
+#endif /*MCAL_TIM3_HEADER_H_*/
@@ -0,0 +1,475 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   TIM4 motor outputs driven by DMA bursts or single pulses                                                    |
+ * |    @file           :   MCAL_TIM4.c                                                                                                 |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file contains the driver of the four motor outputs of TIM4 (DMA bursts and one pulse mode)             |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           added the one pulse mode, the burst period is loaded before the |
+ * |                                                                    update event.                                                   |
+ * |    17/10/2026      1.2.0           agent                           added inverted bursts and the input capture of the line after a |
+ * |                                                                    burst.                                                          |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains the interface of this module
+ */
+#include "MCAL_TIM4.h"
+
+/**
+ * @reason: contains timer functionality
+ */
+#include "ch32v20x_tim.h"
+
+/**
+ * @reason: contains NVIC configuration
+ */
+#include "ch32v20x_misc.h"
+
+/******************************************************************************
+ * Module Preprocessor Constants
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Preprocessor Macros
+ *******************************************************************************/
+
+/**
+ * @brief: true while the DMA still has compare values of a burst to write
+ */
+#define MCAL_TIM4_BURST_IN_FLIGHT() ((MCAL_TIM4_DMA_CHANNEL->CFGR & DMA_CFGR1_EN) && MCAL_TIM4_DMA_CHANNEL->CNTR)
+
+/******************************************************************************
+ * Module Typedefs
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Variable Definitions
+ *******************************************************************************/
+
+/**
+ * @brief: period and polarity of the bursts, restored after a capture
+ */
+uint16_t global_u16TIM4PeriodTicks = 0;
+uint8_t global_u8TIM4Inverted = 0;
+
+/**
+ * @brief: what the channels are doing, changed by the end of burst interrupt
+ */
+volatile MCAL_TIM4_Mode_t global_TIM4Mode_t = MCAL_TIM4_MODE_OUTPUT;
+
+/**
+ * @brief: the captured channel, its capture register and the buffer of its edges
+ */
+uint8_t global_u8TIM4CaptureChannel = 0;
+volatile uint16_t* global_pu16TIM4CaptureReg = NULL;
+uint16_t* global_pu16TIM4Edges = NULL;
+uint8_t global_u8TIM4MaxEdges = 0;
+volatile uint8_t global_u8TIM4EdgeCount = 0;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ * @brief: DMA1 channel 7 (TIM4 update) IRQ handler (end of the burst before a capture)
+ */
+void DMA1_Channel7_IRQHandler(void) __attribute__((interrupt()));
+
+/**
+ * @brief: TIM4 IRQ handler (edge captured)
+ */
+void TIM4_IRQHandler(void) __attribute__((interrupt()));
+
+/**
+ * @brief: configures a channel as a PWM output with the polarity of the bursts and preloaded compare value
+ */
+void MCAL_TIM4_ConfigOutput(uint8_t arg_u8Channel);
+
+/******************************************************************************
+ * Function Definitions
+ *******************************************************************************/
+
+/**
+ * 
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_InitBurst(uint16_t arg_u16PeriodTicks, uint8_t arg_u8Inverted)
+{
+    DMA_InitTypeDef local_DMAInit_t = {0};
+    NVIC_InitTypeDef local_NVICInit_t = {0};
+    uint8_t i = 0;
+
+    if(arg_u16PeriodTicks < 2)
+        return MCAL_TIM4_STAT_INVALID_PARAMS;
+
+    TIM_Cmd(TIM4, DISABLE);
+    global_u16TIM4PeriodTicks = arg_u16PeriodTicks;
+    global_u8TIM4Inverted = arg_u8Inverted;
+    global_TIM4Mode_t = MCAL_TIM4_MODE_OUTPUT;
+
+    // full speed counter, the compare values only change at the update events
+    TIM_SetAutoreload(TIM4, arg_u16PeriodTicks - 1);
+    for(i = 0; i < MCAL_TIM4_CHANNELS; i++)
+    {
+        MCAL_TIM4_ConfigOutput(i);
+    }
+
+    // the update event of the immediate reload applies the prescaler and the period now
+    TIM_PrescalerConfig(TIM4, 0, TIM_PSCReloadMode_Immediate);
+    TIM_SetCounter(TIM4, 0);
+
+    // every update request writes CH1CVR to CH4CVR through the DMA burst register
+    TIM_DMAConfig(TIM4, TIM_DMABase_CCR1, TIM_DMABurstLength_4Transfers);
+
+    // the address and length are set for every burst, only the fixed part is configured here
+    local_DMAInit_t.DMA_PeripheralBaseAddr = (uint32_t)&TIM4->DMAADR;
+    local_DMAInit_t.DMA_MemoryBaseAddr = 0;
+    local_DMAInit_t.DMA_DIR = DMA_DIR_PeripheralDST;
+    local_DMAInit_t.DMA_BufferSize = MCAL_TIM4_CHANNELS;
+    local_DMAInit_t.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    local_DMAInit_t.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    local_DMAInit_t.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    local_DMAInit_t.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    local_DMAInit_t.DMA_Mode = DMA_Mode_Normal;
+    // a late burst stretches a bit of the protocol, so it goes before the other DMA users
+    local_DMAInit_t.DMA_Priority = DMA_Priority_VeryHigh;
+    local_DMAInit_t.DMA_M2M = DMA_M2M_Disable;
+    DMA_DeInit(MCAL_TIM4_DMA_CHANNEL);
+    DMA_Init(MCAL_TIM4_DMA_CHANNEL, &local_DMAInit_t);
+
+    // switches the pins to inputs at the end of a burst and captures the edges of the reply
+    local_NVICInit_t.NVIC_IRQChannelPreemptionPriority = MCAL_TIM4_IRQ_PREEMPTION_PRIO;
+    local_NVICInit_t.NVIC_IRQChannelSubPriority = MCAL_TIM4_IRQ_SUB_PRIO;
+    local_NVICInit_t.NVIC_IRQChannelCmd = ENABLE;
+    local_NVICInit_t.NVIC_IRQChannel = MCAL_TIM4_DMA_IRQ;
+    NVIC_Init(&local_NVICInit_t);
+    local_NVICInit_t.NVIC_IRQChannel = MCAL_TIM4_IRQ;
+    NVIC_Init(&local_NVICInit_t);
+
+    TIM_DMACmd(TIM4, TIM_DMA_Update, ENABLE);
+    TIM_Cmd(TIM4, ENABLE);
+
+    return MCAL_TIM4_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_StartBurst(const uint16_t* arg_pu16Compares, uint16_t arg_u16Periods)
+{
+    if(NULL == arg_pu16Compares || 0 == arg_u16Periods)
+        return MCAL_TIM4_STAT_INVALID_PARAMS;
+
+    // the channel is left enabled after a burst, it's done when all the compare values are written
+    if(MCAL_TIM4_BURST_IN_FLIGHT() || MCAL_TIM4_MODE_CAPTURE == global_TIM4Mode_t)
+        return MCAL_TIM4_STAT_BUSY;
+
+    // the first set is written at the next update event and output during the period after it
+    MCAL_TIM4_DMA_CHANNEL->CFGR &= ~DMA_CFGR1_EN;
+    MCAL_TIM4_DMA_CHANNEL->MADDR = (uint32_t)arg_pu16Compares;
+    MCAL_TIM4_DMA_CHANNEL->CNTR = (uint32_t)arg_u16Periods * MCAL_TIM4_CHANNELS;
+    MCAL_TIM4_DMA_CHANNEL->CFGR |= DMA_CFGR1_EN;
+
+    return MCAL_TIM4_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_InitOnePulse(uint16_t arg_u16PeriodTicks)
+{
+    if(arg_u16PeriodTicks < 2)
+        return MCAL_TIM4_STAT_INVALID_PARAMS;
+
+    TIM_Cmd(TIM4, DISABLE);
+    TIM_DMACmd(TIM4, TIM_DMA_Update, DISABLE);
+
+    // PWM mode 2 with active high outputs: low until the compare value, high until the end of the period, the stopped
+    // counter is 0 so the outputs are low between the pulses
+    TIM_OC1PolarityConfig(TIM4, TIM_OCPolarity_High);
+    TIM_OC2PolarityConfig(TIM4, TIM_OCPolarity_High);
+    TIM_OC3PolarityConfig(TIM4, TIM_OCPolarity_High);
+    TIM_OC4PolarityConfig(TIM4, TIM_OCPolarity_High);
+
+    // the compare values are written while the counter is stopped so they don't need the preload
+    TIM_OC1PreloadConfig(TIM4, TIM_OCPreload_Disable);
+    TIM_OC2PreloadConfig(TIM4, TIM_OCPreload_Disable);
+    TIM_OC3PreloadConfig(TIM4, TIM_OCPreload_Disable);
+    TIM_OC4PreloadConfig(TIM4, TIM_OCPreload_Disable);
+    TIM_SetCompare1(TIM4, arg_u16PeriodTicks);
+    TIM_SetCompare2(TIM4, arg_u16PeriodTicks);
+    TIM_SetCompare3(TIM4, arg_u16PeriodTicks);
+    TIM_SetCompare4(TIM4, arg_u16PeriodTicks);
+
+    // the counter clears its enable bit at the end of the period
+    TIM_SetAutoreload(TIM4, arg_u16PeriodTicks - 1);
+    TIM_SelectOnePulseMode(TIM4, TIM_OPMode_Single);
+    TIM_PrescalerConfig(TIM4, 0, TIM_PSCReloadMode_Immediate);
+    TIM_SetCounter(TIM4, 0);
+
+    return MCAL_TIM4_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_StartPulses(const uint16_t* arg_pu16Compares)
+{
+    if(NULL == arg_pu16Compares)
+        return MCAL_TIM4_STAT_INVALID_PARAMS;
+
+    if(TIM4->CTLR1 & TIM_CEN)
+        return MCAL_TIM4_STAT_BUSY;
+
+    TIM4->CH1CVR = arg_pu16Compares[0];
+    TIM4->CH2CVR = arg_pu16Compares[1];
+    TIM4->CH3CVR = arg_pu16Compares[2];
+    TIM4->CH4CVR = arg_pu16Compares[3];
+    TIM4->CNT = 0;
+    TIM4->CTLR1 |= TIM_CEN;
+
+    return MCAL_TIM4_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_GetCounter(uint16_t* arg_pu16Counter)
+{
+    if(NULL == arg_pu16Counter)
+        return MCAL_TIM4_STAT_INVALID_PARAMS;
+
+    *arg_pu16Counter = TIM4->CNT;
+
+    return MCAL_TIM4_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_ArmCapture(uint8_t arg_u8Channel, uint16_t* arg_pu16Edges, uint8_t arg_u8MaxEdges)
+{
+    if(arg_u8Channel >= MCAL_TIM4_CHANNELS || NULL == arg_pu16Edges || 0 == arg_u8MaxEdges)
+        return MCAL_TIM4_STAT_INVALID_PARAMS;
+
+    // the end of a burst already in flight would start the capture too early
+    if(MCAL_TIM4_MODE_OUTPUT != global_TIM4Mode_t || MCAL_TIM4_BURST_IN_FLIGHT())
+        return MCAL_TIM4_STAT_BUSY;
+
+    switch(arg_u8Channel)
+    {
+    case 0:
+        global_pu16TIM4CaptureReg = &TIM4->CH1CVR;
+        break;
+    case 1:
+        global_pu16TIM4CaptureReg = &TIM4->CH2CVR;
+        break;
+    case 2:
+        global_pu16TIM4CaptureReg = &TIM4->CH3CVR;
+        break;
+    default:
+        global_pu16TIM4CaptureReg = &TIM4->CH4CVR;
+        break;
+    }
+    global_u8TIM4CaptureChannel = arg_u8Channel;
+    global_pu16TIM4Edges = arg_pu16Edges;
+    global_u8TIM4MaxEdges = arg_u8MaxEdges;
+    global_u8TIM4EdgeCount = 0;
+
+    DMA_ClearITPendingBit(MCAL_TIM4_DMA_IT_GL);
+    global_TIM4Mode_t = MCAL_TIM4_MODE_CAPTURE_ARMED;
+    DMA_ITConfig(MCAL_TIM4_DMA_CHANNEL, DMA_IT_TC, ENABLE);
+
+    return MCAL_TIM4_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_StopCapture(uint8_t* arg_pu8Edges)
+{
+    GPIO_InitTypeDef local_GPIOInit_t = {0};
+
+    if(NULL == arg_pu8Edges)
+        return MCAL_TIM4_STAT_INVALID_PARAMS;
+
+    *arg_pu8Edges = 0;
+
+    if(MCAL_TIM4_MODE_OUTPUT == global_TIM4Mode_t)
+        return MCAL_TIM4_STAT_OK;
+
+    if(MCAL_TIM4_MODE_CAPTURE_ARMED == global_TIM4Mode_t)
+    {
+        if(MCAL_TIM4_BURST_IN_FLIGHT())
+            return MCAL_TIM4_STAT_BUSY;
+
+        // no burst was started after arming
+        DMA_ITConfig(MCAL_TIM4_DMA_CHANNEL, DMA_IT_TC, DISABLE);
+        global_TIM4Mode_t = MCAL_TIM4_MODE_OUTPUT;
+        return MCAL_TIM4_STAT_OK;
+    }
+
+    TIM4->CTLR1 &= ~TIM_CEN;
+    TIM_ITConfig(TIM4, (uint16_t)(TIM_IT_CC1 << global_u8TIM4CaptureChannel), DISABLE);
+    *arg_pu8Edges = global_u8TIM4EdgeCount;
+
+    // the captured channel back to an output before the pins are driven again
+    MCAL_TIM4_ConfigOutput(global_u8TIM4CaptureChannel);
+    local_GPIOInit_t.GPIO_Pin = MCAL_TIM4_PINS;
+    local_GPIOInit_t.GPIO_Mode = GPIO_Mode_AF_PP;
+    local_GPIOInit_t.GPIO_Speed = GPIO_Speed_10MHz;
+    GPIO_Init(MCAL_TIM4_GPIO, &local_GPIOInit_t);
+
+    // the update event loads the period and the idle compare values and requests the first transfer of the next burst
+    TIM4->ATRLR = global_u16TIM4PeriodTicks - 1;
+    TIM_DMACmd(TIM4, TIM_DMA_Update, ENABLE);
+    TIM_GenerateEvent(TIM4, TIM_EventSource_Update);
+    global_TIM4Mode_t = MCAL_TIM4_MODE_OUTPUT;
+    TIM4->CTLR1 |= TIM_CEN;
+
+    return MCAL_TIM4_STAT_OK;
+}
+
+/**
+ * 
+ */
+void MCAL_TIM4_ConfigOutput(uint8_t arg_u8Channel)
+{
+    TIM_OCInitTypeDef local_OCInit_t = {0};
+
+    // PWM mode 2: inactive until the compare value, the polarity makes the inactive level high or low
+    local_OCInit_t.TIM_OCMode = TIM_OCMode_PWM2;
+    local_OCInit_t.TIM_OutputState = TIM_OutputState_Enable;
+    local_OCInit_t.TIM_Pulse = 0;
+    local_OCInit_t.TIM_OCPolarity = global_u8TIM4Inverted ? TIM_OCPolarity_High : TIM_OCPolarity_Low;
+
+    switch(arg_u8Channel)
+    {
+    case 0:
+        TIM_OC1Init(TIM4, &local_OCInit_t);
+        TIM_OC1PreloadConfig(TIM4, TIM_OCPreload_Enable);
+        break;
+    case 1:
+        TIM_OC2Init(TIM4, &local_OCInit_t);
+        TIM_OC2PreloadConfig(TIM4, TIM_OCPreload_Enable);
+        break;
+    case 2:
+        TIM_OC3Init(TIM4, &local_OCInit_t);
+        TIM_OC3PreloadConfig(TIM4, TIM_OCPreload_Enable);
+        break;
+    default:
+        TIM_OC4Init(TIM4, &local_OCInit_t);
+        TIM_OC4PreloadConfig(TIM4, TIM_OCPreload_Enable);
+        break;
+    }
+}
+
+/**
+ * NOTE: the transfer completes when the last compare values (the low periods after the frame) are written, the data bits
+ *       are all out so the pins can be released for the reply that comes ~30 us later
+ */
+void DMA1_Channel7_IRQHandler(void)
+{
+    GPIO_InitTypeDef local_GPIOInit_t = {0};
+    TIM_ICInitTypeDef local_ICInit_t = {0};
+    uint16_t local_u16Flag = 0;
+
+    if(!DMA_GetITStatus(MCAL_TIM4_DMA_IT_TC))
+        return;
+    DMA_ClearITPendingBit(MCAL_TIM4_DMA_IT_GL);
+    DMA_ITConfig(MCAL_TIM4_DMA_CHANNEL, DMA_IT_TC, DISABLE);
+
+    if(MCAL_TIM4_MODE_CAPTURE_ARMED != global_TIM4Mode_t)
+        return;
+
+    TIM4->CTLR1 &= ~TIM_CEN;
+    TIM_DMACmd(TIM4, TIM_DMA_Update, DISABLE);
+
+    // the pull ups hold the idle level of the inverted signal while nobody drives the wires
+    local_GPIOInit_t.GPIO_Pin = MCAL_TIM4_PINS;
+    local_GPIOInit_t.GPIO_Mode = GPIO_Mode_IPU;
+    local_GPIOInit_t.GPIO_Speed = GPIO_Speed_10MHz;
+    GPIO_Init(MCAL_TIM4_GPIO, &local_GPIOInit_t);
+
+    // every edge latches the free running counter
+    local_ICInit_t.TIM_Channel = (uint16_t)(TIM_Channel_1 + (global_u8TIM4CaptureChannel << 2));
+    local_ICInit_t.TIM_ICPolarity = TIM_ICPolarity_BothEdge;
+    local_ICInit_t.TIM_ICSelection = TIM_ICSelection_DirectTI;
+    local_ICInit_t.TIM_ICPrescaler = TIM_ICPSC_DIV1;
+    local_ICInit_t.TIM_ICFilter = 0;
+    TIM_ICInit(TIM4, &local_ICInit_t);
+
+    TIM4->ATRLR = 0xFFFF;
+    TIM_GenerateEvent(TIM4, TIM_EventSource_Update);
+
+    local_u16Flag = (uint16_t)(TIM_IT_CC1 << global_u8TIM4CaptureChannel);
+    TIM_ClearITPendingBit(TIM4, local_u16Flag);
+    TIM_ITConfig(TIM4, local_u16Flag, ENABLE);
+    global_TIM4Mode_t = MCAL_TIM4_MODE_CAPTURE;
+    TIM4->CTLR1 |= TIM_CEN;
+}
+
+/**
+ * 
+ */
+void TIM4_IRQHandler(void)
+{
+    uint16_t local_u16Flag = (uint16_t)(TIM_IT_CC1 << global_u8TIM4CaptureChannel);
+    uint16_t local_u16Edge = 0;
+
+    if(!(TIM4->INTFR & local_u16Flag))
+        return;
+
+    local_u16Edge = *global_pu16TIM4CaptureReg;
+    TIM4->INTFR = (uint16_t)~local_u16Flag;
+
+    if(global_u8TIM4EdgeCount < global_u8TIM4MaxEdges)
+    {
+        global_pu16TIM4Edges[global_u8TIM4EdgeCount++] = local_u16Edge;
+    }
+    else
+    {
+        TIM_ITConfig(TIM4, local_u16Flag, DISABLE);
+    }
+}
+
+/*************** END OF FUNCTIONS ***************************************************************************/
@@ -0,0 +1,385 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   TIM4 motor outputs driven by DMA bursts or single pulses                                                    |
+ * |    @file           :   MCAL_TIM4.h                                                                                                 |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file is the header of the driver of the four motor outputs of TIM4 (DMA bursts and one pulse mode)     |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           added 'MCAL_TIM4_InitOnePulse', 'MCAL_TIM4_StartPulses' and     |
+ * |                                                                    'MCAL_TIM4_GetCounter'.                                         |
+ * |    17/10/2026      1.2.0           agent                           added inverted bursts and the input capture of the line after a |
+ * |                                                                    burst.                                                          |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+
+#ifndef MCAL_TIM4_HEADER_H_
+#define MCAL_TIM4_HEADER_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains standard definitions for int
+ */
+#include "stdint.h"
+
+/**
+ * @reason: contains DMA channels definitions
+ */
+#include "ch32v20x_dma.h"
+
+/**
+ * @reason: contains the pins of the channels
+ */
+#include "ch32v20x_gpio.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: clock of TIM4 in Hz (APB1 is not divided, refer to "system_ch32v20x.c")
+ */
+#define MCAL_TIM4_CLOCK_HZ                  (144000000UL)
+
+/**
+ * @brief: number of output channels of TIM4, one compare value per channel is written every period of a burst
+ */
+#define MCAL_TIM4_CHANNELS                  (4)
+
+/**
+ * @brief: size of the buffer of the edges captured on a channel, a bidirectional DShot reply has at most 22 edges
+ */
+#define MCAL_TIM4_CAPTURE_MAX_EDGES         (32)
+
+/******************************************************************************
+ * Configuration Constants
+ *******************************************************************************/
+
+/**
+ * @brief: the DMA1 channel of the update request of TIM4 (fixed by the hardware)
+ */
+#define MCAL_TIM4_DMA_CHANNEL               DMA1_Channel7
+#define MCAL_TIM4_DMA_IRQ                   DMA1_Channel7_IRQn
+#define MCAL_TIM4_DMA_IT_TC                 DMA1_IT_TC7
+#define MCAL_TIM4_DMA_IT_GL                 DMA1_IT_GL7
+#define MCAL_TIM4_IRQ                       TIM4_IRQn
+
+/**
+ * @brief: the pins of CH1 to CH4 (PB6 to PB9), the channel n is on MCAL_TIM4_PIN_CH1 << n
+ */
+#define MCAL_TIM4_GPIO                      GPIOB
+#define MCAL_TIM4_PIN_CH1                   GPIO_Pin_6
+#define MCAL_TIM4_PINS                      (GPIO_Pin_6 | GPIO_Pin_7 | GPIO_Pin_8 | GPIO_Pin_9)
+
+/**
+ * @brief: priority of the end of burst and capture interrupts, the highest so an edge is captured before the next one
+ *         (1.33 us apart with DShot600)
+ */
+#define MCAL_TIM4_IRQ_PREEMPTION_PRIO       (0)
+#define MCAL_TIM4_IRQ_SUB_PRIO              (0)
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: contains error states for this module
+*/
+typedef enum {
+  MCAL_TIM4_STAT_OK,                /**< everything went as intended */
+  MCAL_TIM4_STAT_INVALID_PARAMS,    /**< invalid arguments */
+  MCAL_TIM4_STAT_BUSY,              /**< the previous burst is still being written to the compare registers or the pulses are still out */
+} MCAL_TIM4_ErrStat_t;
+
+/**
+ * @brief: what the channels are doing
+*/
+typedef enum {
+  MCAL_TIM4_MODE_OUTPUT,            /**< the channels output the bursts or the pulses */
+  MCAL_TIM4_MODE_CAPTURE_ARMED,     /**< the channels switch to inputs at the end of the current burst */
+  MCAL_TIM4_MODE_CAPTURE,           /**< the pins are inputs and the edges of one channel are captured */
+} MCAL_TIM4_Mode_t;
+
+/******************************************************************************
+ * Variables
+ *******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       MCAL_TIM4_ErrStat_t MCAL_TIM4_InitBurst(uint16_t arg_u16PeriodTicks, uint8_t arg_u8Inverted);
+ *  \b Description                              :       reconfigures the four PWM channels of TIM4 to be fed by DMA bursts, every update event of the timer the
+ *                                                      DMA writes the next four compare values (CH1 to CH4) so every period of the timer carries its own
+ *                                                      pulse widths (digital ESC protocols).
+ *  @param  arg_u16PeriodTicks [IN]             :       period of the timer in ticks of MCAL_TIM4_CLOCK_HZ (one bit of the protocol).
+ *  @param  arg_u8Inverted [IN]                 :       0: the outputs are high for the compare value, 1: they are low for it and idle high
+ *                                                      (bidirectional DShot).
+ *  @note                                       :       the outputs stay idle until the first burst, the compare values are preloaded so a burst never
+ *                                                      changes a pulse in the middle of a period.
+ *  \b PRE-CONDITION                            :       TIM4 and its pins are configured by MCAL_Config_ConfigAllPins and DMA1 is clocked.
+ *  \b POST-CONDITION                           :       bursts can be started.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_TIM4_ErrStat_t in "MCAL_TIM4.h")
+ *  @see                                        :       MCAL_TIM4_ErrStat_t MCAL_TIM4_StartBurst(const uint16_t* arg_pu16Compares, uint16_t arg_u16Periods)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_TIM4.h"
+ * 
+ * // 600 KHz periods
+ * MCAL_TIM4_InitBurst(MCAL_TIM4_CLOCK_HZ / 600000, 0);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.2.0            </td><td> agent    </td><td> inverted outputs </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_InitBurst(uint16_t arg_u16PeriodTicks, uint8_t arg_u8Inverted);
+
+/**
+ *  \b function                                 :       MCAL_TIM4_ErrStat_t MCAL_TIM4_StartBurst(const uint16_t* arg_pu16Compares, uint16_t arg_u16Periods);
+ *  \b Description                              :       starts writing a sequence of compare values to the four channels, one set per period of the timer, and returns
+ *                                                      immediately, the DMA does the rest without interrupts.
+ *  @param  arg_pu16Compares [IN]               :       MCAL_TIM4_CHANNELS compare values (CH1 to CH4) for every period, in ticks of the timer.
+ *  @param  arg_u16Periods [IN]                 :       number of periods in the sequence.
+ *  @note                                       :       the buffer must stay untouched until the next burst can be started, the last set of compare
+ *                                                      values stays in the channels after the burst so it should be zeros (outputs low).
+ *  \b PRE-CONDITION                            :       MCAL_TIM4_InitBurst is called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       MCAL_TIM4_STAT_BUSY if the previous burst isn't written yet, else one of error states (refer to @MCAL_TIM4_ErrStat_t in "MCAL_TIM4.h")
+ *  @see                                        :       MCAL_TIM4_ErrStat_t MCAL_TIM4_InitBurst(uint16_t arg_u16PeriodTicks, uint8_t arg_u8Inverted)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_TIM4.h"
+ * 
+ * // a 1 period pulse on CH1 followed by a low period
+ * static uint16_t compares[2 * MCAL_TIM4_CHANNELS] = {100, 0, 0, 0,   0, 0, 0, 0};
+ * if(MCAL_TIM4_STAT_OK == MCAL_TIM4_StartBurst(compares, 2))
+ * {
+ *   // don't touch compares until the next burst can start
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_StartBurst(const uint16_t* arg_pu16Compares, uint16_t arg_u16Periods);
+
+/**
+ *  \b function                                 :       MCAL_TIM4_ErrStat_t MCAL_TIM4_InitOnePulse(uint16_t arg_u16PeriodTicks);
+ *  \b Description                              :       reconfigures the four PWM channels of TIM4 to send one pulse each when started instead of free running, every
+ *                                                      channel is low until its compare value and high from it to the end of the period, then the timer
+ *                                                      stops by itself (analog ESC protocols synchronized with the control loop).
+ *  @param  arg_u16PeriodTicks [IN]             :       period of the timer in ticks of MCAL_TIM4_CLOCK_HZ, all the pulses end with it.
+ *  @note                                       :       the outputs stay low until the first start.
+ *  \b PRE-CONDITION                            :       TIM4 and its pins are configured by MCAL_Config_ConfigAllPins.
+ *  \b POST-CONDITION                           :       pulses can be started.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_TIM4_ErrStat_t in "MCAL_TIM4.h")
+ *  @see                                        :       MCAL_TIM4_ErrStat_t MCAL_TIM4_StartPulses(const uint16_t* arg_pu16Compares)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_TIM4.h"
+ * 
+ * // 251 us period
+ * MCAL_TIM4_InitOnePulse(251 * (MCAL_TIM4_CLOCK_HZ / 1000000));
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_InitOnePulse(uint16_t arg_u16PeriodTicks);
+
+/**
+ *  \b function                                 :       MCAL_TIM4_ErrStat_t MCAL_TIM4_StartPulses(const uint16_t* arg_pu16Compares);
+ *  \b Description                              :       writes the compare values of the four channels and starts one period of the timer, the pulses start
+ *                                                      right away and end together at the end of the period.
+ *  @param  arg_pu16Compares [IN]               :       MCAL_TIM4_CHANNELS compare values (CH1 to CH4), the pulse of a channel is the period minus its
+ *                                                      compare value.
+ *  @note                                       :       the values are copied, the buffer can be reused right away.
+ *  \b PRE-CONDITION                            :       MCAL_TIM4_InitOnePulse is called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       MCAL_TIM4_STAT_BUSY if the previous pulses are still out, else one of error states (refer to @MCAL_TIM4_ErrStat_t in "MCAL_TIM4.h")
+ *  @see                                        :       MCAL_TIM4_ErrStat_t MCAL_TIM4_InitOnePulse(uint16_t arg_u16PeriodTicks)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_TIM4.h"
+ * 
+ * uint16_t compares[MCAL_TIM4_CHANNELS] = {1000, 2000, 3000, 4000};
+ * MCAL_TIM4_StartPulses(compares);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_StartPulses(const uint16_t* arg_pu16Compares);
+
+/**
+ *  \b function                                 :       MCAL_TIM4_ErrStat_t MCAL_TIM4_GetCounter(uint16_t* arg_pu16Counter);
+ *  \b Description                              :       returns the counter of TIM4, used to know how far the outputs are in their period.
+ *  @param  arg_pu16Counter [OUT]               :       where to store the counter.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_TIM4_ErrStat_t in "MCAL_TIM4.h")
+ *  @see                                        :       None
+ *
+ *  \b Example:
+ * @code
+ * 
+ * uint16_t counter = 0;
+ * MCAL_TIM4_GetCounter(&counter);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_GetCounter(uint16_t* arg_pu16Counter);
+
+/**
+ *  \b function                                 :       MCAL_TIM4_ErrStat_t MCAL_TIM4_ArmCapture(uint8_t arg_u8Channel, uint16_t* arg_pu16Edges, uint8_t arg_u8MaxEdges);
+ *  \b Description                              :       makes the next burst end with the four pins released as inputs with pull ups and the edges of one
+ *                                                      channel captured, so a device answering on the same wire is heard (bidirectional DShot). the end
+ *                                                      of burst interrupt switches the pins and the capture interrupt stores the counter at every edge.
+ *  @param  arg_u8Channel [IN]                  :       the channel to capture, 0 (CH1) to MCAL_TIM4_CHANNELS - 1.
+ *  @param  arg_pu16Edges [OUT]                 :       where to store the counter of TIM4 (MCAL_TIM4_CLOCK_HZ ticks) at every edge, rising or falling.
+ *  @param  arg_u8MaxEdges [IN]                 :       size of the buffer, the edges after it are ignored.
+ *  @note                                       :       call it before MCAL_TIM4_StartBurst, the buffer must stay valid until MCAL_TIM4_StopCapture.
+ *                                                      the capture lasts at most one period of the 16 bits counter (455 us).
+ *  \b PRE-CONDITION                            :       MCAL_TIM4_InitBurst is called and the channels are outputs.
+ *  \b POST-CONDITION                           :       the capture starts at the end of the next burst.
+ *  @return                                     :       MCAL_TIM4_STAT_BUSY if a capture is already armed or running, else one of error states (refer to @MCAL_TIM4_ErrStat_t in "MCAL_TIM4.h")
+ *  @see                                        :       MCAL_TIM4_ErrStat_t MCAL_TIM4_StopCapture(uint8_t* arg_pu8Edges)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_TIM4.h"
+ * 
+ * uint16_t edges[MCAL_TIM4_CAPTURE_MAX_EDGES];
+ * uint8_t count = 0;
+ * MCAL_TIM4_ArmCapture(0, edges, MCAL_TIM4_CAPTURE_MAX_EDGES);
+ * MCAL_TIM4_StartBurst(compares, periods);
+ * // ... later
+ * MCAL_TIM4_StopCapture(&count);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_ArmCapture(uint8_t arg_u8Channel, uint16_t* arg_pu16Edges, uint8_t arg_u8MaxEdges);
+
+/**
+ *  \b function                                 :       MCAL_TIM4_ErrStat_t MCAL_TIM4_StopCapture(uint8_t* arg_pu8Edges);
+ *  \b Description                              :       ends the capture armed by MCAL_TIM4_ArmCapture and gives the pins back to the channels as outputs
+ *                                                      configured by MCAL_TIM4_InitBurst, ready for the next burst.
+ *  @param  arg_pu8Edges [OUT]                  :       number of edges stored in the buffer.
+ *  @note                                       :       does nothing and gives 0 edges if no capture is armed.
+ *  \b PRE-CONDITION                            :       MCAL_TIM4_InitBurst is called.
+ *  \b POST-CONDITION                           :       the channels are outputs.
+ *  @return                                     :       MCAL_TIM4_STAT_BUSY if the burst before the capture is still being sent (the capture stays armed),
+ *                                                      else one of error states (refer to @MCAL_TIM4_ErrStat_t in "MCAL_TIM4.h")
+ *  @see                                        :       MCAL_TIM4_ErrStat_t MCAL_TIM4_ArmCapture(uint8_t arg_u8Channel, uint16_t* arg_pu16Edges, uint8_t arg_u8MaxEdges)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_TIM4.h"
+ * 
+ * uint8_t count = 0;
+ * if(MCAL_TIM4_STAT_OK == MCAL_TIM4_StopCapture(&count))
+ * {
+ *  // the first count values of the buffer are the edges
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_StopCapture(uint8_t* arg_pu8Edges);
+
+/*** End of File **************************************************************/
+#endif /*MCAL_TIM4_HEADER_H_*/
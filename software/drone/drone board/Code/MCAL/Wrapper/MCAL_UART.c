@@ -0,0 +1,460 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   DMA driven UART                                                                                             |
+ * |    @file           :   MCAL_UART.c                                                                                                 |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file contains the circular DMA receiver of UART4 with idle line detection and its queued DMA           |
+ * |                        transmitter                                                                                                 |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           Interface Created.                                              |
+ * |    17/10/2026      1.1.0           agent                           added the queued DMA transmitter 'MCAL_UART_Send' and           |
+ * |                                                                    'MCAL_UART_GetTxStats'.                                         |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains the interface of this module
+ */
+#include "MCAL_UART.h"
+
+/**
+ * @reason: contains UART flags, interrupts and DMA requests
+ */
+#include "ch32v20x_usart.h"
+
+/**
+ * @reason: contains NVIC configuration
+ */
+#include "ch32v20x_misc.h"
+
+/**
+ * @reason: contains enabled/disabled constants
+ */
+#include "constants.h"
+
+/******************************************************************************
+ * Module Preprocessor Constants
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Preprocessor Macros
+ *******************************************************************************/
+
+/**
+ * @brief: micro seconds from 'THEN' to 'NOW', both taken modulo 2^32; a stamp taken after the other one gives 0
+ */
+#define MCAL_UART_ELAPSED_US(NOW, THEN)     ((0 > (int32_t)((NOW) - (THEN))) ? 0 : ((NOW) - (THEN)))
+
+/******************************************************************************
+ * Module Typedefs
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Variable Definitions
+ *******************************************************************************/
+
+/**
+ * @brief: circular buffer written by the DMA
+ */
+uint8_t global_u8UARTRxRing[MCAL_UART_RX_RING_LEN] = {0};
+
+/**
+ * @brief: position of the DMA in the buffer at the last interrupt
+ */
+volatile uint16_t global_u16UARTRxLastPos = 0;
+
+/**
+ * @brief: bytes received since boot up to the last interrupt and bytes read by the task, both only grow so the bytes
+ *         waiting in the buffer are the difference even after the DMA wraps around
+ */
+volatile uint32_t global_u32UARTRxReceived = 0;
+uint32_t global_u32UARTRxRead = 0;
+
+/**
+ * @brief: task notified when something is received
+ */
+RTOS_TaskHandle_t volatile global_UARTRxTask = NULL;
+
+/**
+ * @brief: counters of the receiver
+ */
+volatile MCAL_UART_Stats_t global_UARTStats_t = {0};
+
+/**
+ * @brief: frames waiting to be sent, the one at the head is the one being sent
+ */
+MCAL_UART_TxFrame_t* global_UARTTxQueue[MCAL_UART_TX_QUEUE_LEN] = {NULL};
+
+/**
+ * @brief: index of the head of the transmit queue and number of queued frames
+ */
+volatile uint8_t global_u8UARTTxQueueHead = 0;
+volatile uint8_t global_u8UARTTxQueueCount = 0;
+
+/**
+ * @brief: time the DMA started sending the frame at the head of the queue
+ */
+volatile uint32_t global_u32UARTTxStartUS = 0;
+
+/**
+ * @brief: counters of the transmitter
+ */
+volatile MCAL_UART_TxStats_t global_UARTTxStats_t = {0};
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ * @brief: UART4 IRQ handler (idle line)
+ */
+void UART4_IRQHandler(void) __attribute__((interrupt()));
+
+/**
+ * @brief: DMA1 channel 8 (UART4 RX) IRQ handler (half and full buffer)
+ */
+void DMA1_Channel8_IRQHandler(void) __attribute__((interrupt()));
+
+/**
+ * @brief: DMA1 channel 1 (UART4 TX) IRQ handler (frame sent)
+ */
+void DMA1_Channel1_IRQHandler(void) __attribute__((interrupt()));
+
+/**
+ * @brief: takes the bytes written by the DMA since the last interrupt and notifies the task if there are any
+ */
+void MCAL_UART_CollectRx(void);
+
+/**
+ * @brief: gives the frame at the head of the transmit queue to the DMA, must be called with the interrupts disabled or from the ISR
+ */
+void MCAL_UART_StartNextTx(void);
+
+/******************************************************************************
+ * Function Definitions
+ *******************************************************************************/
+
+/**
+ * 
+ */
+MCAL_UART_ErrStat_t MCAL_UART_Init(void)
+{
+    DMA_InitTypeDef local_DMAInit_t = {0};
+    NVIC_InitTypeDef local_NVICInit_t = {0};
+
+    global_u16UARTRxLastPos = 0;
+    global_u32UARTRxReceived = 0;
+    global_u32UARTRxRead = 0;
+    global_u8UARTTxQueueHead = 0;
+    global_u8UARTTxQueueCount = 0;
+
+    local_DMAInit_t.DMA_PeripheralBaseAddr = (uint32_t)&MCAL_UART_PERIPHERAL->DATAR;
+    local_DMAInit_t.DMA_MemoryBaseAddr = (uint32_t)global_u8UARTRxRing;
+    local_DMAInit_t.DMA_DIR = DMA_DIR_PeripheralSRC;
+    local_DMAInit_t.DMA_BufferSize = MCAL_UART_RX_RING_LEN;
+    local_DMAInit_t.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    local_DMAInit_t.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    local_DMAInit_t.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    local_DMAInit_t.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    local_DMAInit_t.DMA_Mode = DMA_Mode_Circular;
+    local_DMAInit_t.DMA_Priority = DMA_Priority_Medium;
+    local_DMAInit_t.DMA_M2M = DMA_M2M_Disable;
+    DMA_DeInit(MCAL_UART_DMA_RX_CHANNEL);
+    DMA_Init(MCAL_UART_DMA_RX_CHANNEL, &local_DMAInit_t);
+
+    // a long burst without an idle line still wakes the task every half buffer so it's read before it's overwritten
+    DMA_ITConfig(MCAL_UART_DMA_RX_CHANNEL, DMA_IT_HT | DMA_IT_TC, ENABLE);
+    DMA_Cmd(MCAL_UART_DMA_RX_CHANNEL, ENABLE);
+
+    // the address and length are set for every frame, only the fixed part is configured here
+    local_DMAInit_t.DMA_MemoryBaseAddr = 0;
+    local_DMAInit_t.DMA_DIR = DMA_DIR_PeripheralDST;
+    local_DMAInit_t.DMA_BufferSize = 0;
+    local_DMAInit_t.DMA_Mode = DMA_Mode_Normal;
+    DMA_DeInit(MCAL_UART_DMA_TX_CHANNEL);
+    DMA_Init(MCAL_UART_DMA_TX_CHANNEL, &local_DMAInit_t);
+    DMA_ITConfig(MCAL_UART_DMA_TX_CHANNEL, DMA_IT_TC, ENABLE);
+
+    USART_DMACmd(MCAL_UART_PERIPHERAL, USART_DMAReq_Rx | USART_DMAReq_Tx, ENABLE);
+    USART_ITConfig(MCAL_UART_PERIPHERAL, USART_IT_IDLE, ENABLE);
+
+    local_NVICInit_t.NVIC_IRQChannelPreemptionPriority = MCAL_UART_IRQ_PREEMPTION_PRIO;
+    local_NVICInit_t.NVIC_IRQChannelSubPriority = MCAL_UART_IRQ_SUB_PRIO;
+    local_NVICInit_t.NVIC_IRQChannelCmd = ENABLE;
+    local_NVICInit_t.NVIC_IRQChannel = MCAL_UART_DMA_RX_IRQ;
+    NVIC_Init(&local_NVICInit_t);
+    local_NVICInit_t.NVIC_IRQChannel = MCAL_UART_IRQ;
+    NVIC_Init(&local_NVICInit_t);
+    local_NVICInit_t.NVIC_IRQChannel = MCAL_UART_DMA_TX_IRQ;
+    NVIC_Init(&local_NVICInit_t);
+
+    return MCAL_UART_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_UART_ErrStat_t MCAL_UART_SetRxTask(RTOS_TaskHandle_t arg_Task_t)
+{
+    global_UARTRxTask = arg_Task_t;
+
+    return MCAL_UART_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_UART_ErrStat_t MCAL_UART_Read(uint8_t* arg_pu8Data, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len)
+{
+    uint32_t local_u32Waiting = 0;
+    uint16_t local_u16Index = 0;
+
+    if(NULL == arg_pu8Data || NULL == arg_pu16Len || 0 == arg_u16MaxLen)
+        return MCAL_UART_STAT_INVALID_PARAMS;
+
+    *arg_pu16Len = 0;
+
+    local_u32Waiting = global_u32UARTRxReceived - global_u32UARTRxRead;
+    if(0 == local_u32Waiting)
+        return MCAL_UART_STAT_EMPTY;
+
+    // the DMA went around the buffer more than once since the last read, the oldest bytes are gone
+    if(MCAL_UART_RX_RING_LEN < local_u32Waiting)
+    {
+        SERVICE_RTOS_EnterCritical();
+        global_UARTStats_t.lost += local_u32Waiting - MCAL_UART_RX_RING_LEN;
+        SERVICE_RTOS_ExitCritical();
+
+        global_u32UARTRxRead += local_u32Waiting - MCAL_UART_RX_RING_LEN;
+        local_u32Waiting = MCAL_UART_RX_RING_LEN;
+    }
+
+    if(local_u32Waiting > arg_u16MaxLen)
+        local_u32Waiting = arg_u16MaxLen;
+
+    for(local_u16Index = 0; local_u16Index < local_u32Waiting; local_u16Index++)
+    {
+        arg_pu8Data[local_u16Index] = global_u8UARTRxRing[(global_u32UARTRxRead + local_u16Index) % MCAL_UART_RX_RING_LEN];
+    }
+
+    global_u32UARTRxRead += local_u32Waiting;
+    *arg_pu16Len = (uint16_t)local_u32Waiting;
+
+    return MCAL_UART_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_UART_ErrStat_t MCAL_UART_GetRxStats(MCAL_UART_Stats_t* arg_pStats)
+{
+    if(NULL == arg_pStats)
+        return MCAL_UART_STAT_INVALID_PARAMS;
+
+    SERVICE_RTOS_EnterCritical();
+    *arg_pStats = global_UARTStats_t;
+    SERVICE_RTOS_ExitCritical();
+
+    return MCAL_UART_STAT_OK;
+}
+
+/**
+ * 
+ */
+MCAL_UART_ErrStat_t MCAL_UART_Send(MCAL_UART_TxFrame_t* arg_pFrame)
+{
+    MCAL_UART_ErrStat_t local_errState = MCAL_UART_STAT_OK;
+
+    if(NULL == arg_pFrame || NULL == arg_pFrame->data || 0 == arg_pFrame->dataLen)
+        return MCAL_UART_STAT_INVALID_PARAMS;
+
+    SERVICE_RTOS_EnterCritical();
+    if(MCAL_UART_TX_QUEUE_LEN <= global_u8UARTTxQueueCount)
+    {
+        global_UARTTxStats_t.queueFull++;
+        local_errState = MCAL_UART_STAT_QUEUE_FULL;
+    }
+    else
+    {
+        arg_pFrame->status = MCAL_UART_STAT_PENDING;
+        SERVICE_RTOS_CurrentUSTime(&arg_pFrame->queuedTimeUS);
+        global_UARTTxQueue[(global_u8UARTTxQueueHead + global_u8UARTTxQueueCount) % MCAL_UART_TX_QUEUE_LEN] = arg_pFrame;
+        global_u8UARTTxQueueCount++;
+
+        // the DMA is idle, start it right away
+        if(1 == global_u8UARTTxQueueCount)
+            MCAL_UART_StartNextTx();
+    }
+    SERVICE_RTOS_ExitCritical();
+
+    return local_errState;
+}
+
+/**
+ * 
+ */
+MCAL_UART_ErrStat_t MCAL_UART_GetTxStats(MCAL_UART_TxStats_t* arg_pStats)
+{
+    if(NULL == arg_pStats)
+        return MCAL_UART_STAT_INVALID_PARAMS;
+
+    SERVICE_RTOS_EnterCritical();
+    *arg_pStats = global_UARTTxStats_t;
+    SERVICE_RTOS_ExitCritical();
+
+    return MCAL_UART_STAT_OK;
+}
+
+/**
+ * NOTE: the interrupts come at least every half buffer so the DMA can't go around the buffer between two of them
+ */
+void MCAL_UART_CollectRx(void)
+{
+    uint16_t local_u16Pos = 0;
+    uint16_t local_u16New = 0;
+
+    local_u16Pos = MCAL_UART_RX_RING_LEN - DMA_GetCurrDataCounter(MCAL_UART_DMA_RX_CHANNEL);
+    if(MCAL_UART_RX_RING_LEN == local_u16Pos)
+        local_u16Pos = 0;
+
+    local_u16New = (local_u16Pos + MCAL_UART_RX_RING_LEN - global_u16UARTRxLastPos) % MCAL_UART_RX_RING_LEN;
+    global_u16UARTRxLastPos = local_u16Pos;
+
+    if(0 == local_u16New)
+        return;
+
+    global_u32UARTRxReceived += local_u16New;
+    global_UARTStats_t.bytes += local_u16New;
+
+    if(NULL != global_UARTRxTask)
+        SERVICE_RTOS_Notify(global_UARTRxTask, LIB_CONSTANTS_ENABLED);
+}
+
+/**
+ * NOTE: the idle and overrun flags are cleared by reading the status register then the data register
+ */
+void UART4_IRQHandler(void)
+{
+    uint16_t local_u16Status = MCAL_UART_PERIPHERAL->STATR;
+
+    if(local_u16Status & (USART_FLAG_IDLE | USART_FLAG_ORE))
+    {
+        (void)MCAL_UART_PERIPHERAL->DATAR;
+
+        if(local_u16Status & USART_FLAG_ORE)
+            global_UARTStats_t.overruns++;
+
+        if(local_u16Status & USART_FLAG_IDLE)
+        {
+            global_UARTStats_t.frames++;
+            MCAL_UART_CollectRx();
+        }
+    }
+}
+
+/**
+ * 
+ */
+void DMA1_Channel8_IRQHandler(void)
+{
+    if(DMA_GetITStatus(MCAL_UART_DMA_RX_IT_HT))
+        DMA_ClearITPendingBit(MCAL_UART_DMA_RX_IT_HT);
+    if(DMA_GetITStatus(MCAL_UART_DMA_RX_IT_TC))
+        DMA_ClearITPendingBit(MCAL_UART_DMA_RX_IT_TC);
+
+    MCAL_UART_CollectRx();
+}
+
+/**
+ * 
+ */
+void MCAL_UART_StartNextTx(void)
+{
+    MCAL_UART_TxFrame_t* local_pFrame = global_UARTTxQueue[global_u8UARTTxQueueHead];
+
+    DMA_Cmd(MCAL_UART_DMA_TX_CHANNEL, DISABLE);
+    MCAL_UART_DMA_TX_CHANNEL->MADDR = (uint32_t)local_pFrame->data;
+    MCAL_UART_DMA_TX_CHANNEL->CNTR = local_pFrame->dataLen;
+    DMA_ClearITPendingBit(MCAL_UART_DMA_TX_IT_GL);
+
+    SERVICE_RTOS_CurrentUSTime((uint32_t*)&global_u32UARTTxStartUS);
+    DMA_Cmd(MCAL_UART_DMA_TX_CHANNEL, ENABLE);
+}
+
+/**
+ * NOTE: the transfer completes when the last byte is written to the UART, the frame memory isn't needed anymore even
+ *       though the last bytes are still on the line. the next frame is started before the callback so the line doesn't wait for it
+ */
+void DMA1_Channel1_IRQHandler(void)
+{
+    MCAL_UART_TxFrame_t* local_pFrame = NULL;
+    uint32_t local_u32NowUS = 0;
+    uint32_t local_u32LatencyUS = 0;
+
+    if(!DMA_GetITStatus(MCAL_UART_DMA_TX_IT_TC))
+        return;
+    DMA_ClearITPendingBit(MCAL_UART_DMA_TX_IT_GL);
+
+    // the stamps are taken here, in 'MCAL_UART_StartNextTx' and in the critical section of 'MCAL_UART_Send', the micro
+    // seconds time counts a tick whose interrupt is held back there
+    local_pFrame = global_UARTTxQueue[global_u8UARTTxQueueHead];
+    SERVICE_RTOS_CurrentUSTime(&local_u32NowUS);
+
+    local_u32LatencyUS = MCAL_UART_ELAPSED_US(local_u32NowUS, local_pFrame->queuedTimeUS);
+    global_UARTTxStats_t.frames++;
+    global_UARTTxStats_t.bytes += local_pFrame->dataLen;
+    global_UARTTxStats_t.busyUS += MCAL_UART_ELAPSED_US(local_u32NowUS, global_u32UARTTxStartUS);
+    global_UARTTxStats_t.lastLatencyUS = local_u32LatencyUS;
+    if(local_u32LatencyUS > global_UARTTxStats_t.maxLatencyUS)
+        global_UARTTxStats_t.maxLatencyUS = local_u32LatencyUS;
+
+    global_u8UARTTxQueueHead = (global_u8UARTTxQueueHead + 1) % MCAL_UART_TX_QUEUE_LEN;
+    global_u8UARTTxQueueCount--;
+    if(0 != global_u8UARTTxQueueCount)
+        MCAL_UART_StartNextTx();
+    else
+        DMA_Cmd(MCAL_UART_DMA_TX_CHANNEL, DISABLE);
+
+    local_pFrame->status = MCAL_UART_STAT_OK;
+    if(NULL != local_pFrame->callBack)
+        local_pFrame->callBack(local_pFrame);
+}
+
+/*************** END OF FUNCTIONS ***************************************************************************/
@@ -44,6 +44,15 @@
  * |                                                                            'I2C_requestFrom', 'I2C_read' functions.                |
  * |    15/06/2023      1.0.0           Abdelrahman Mohamed Salem       created 'MCAL_WRAPEPR_TIM4_PWM_OUT'.                            |
  * |    15/06/2023      1.0.0           Abdelrahman Mohamed Salem       created 'MCAL_WRAPPER_SendDataThroughUART4'.                    |
+ * |    17/10/2026      1.1.0           agent                           added 'MCAL_WRAPPER_I2C2BurstRead'.                             |
+ * |    17/10/2026      1.2.0           agent                           removed the polling I2C functions, replaced by "MCAL_I2C.h".    |
+ * |    17/10/2026      1.3.0           agent                           added 'MCAL_WRAPPER_WaitIMUDataReady'.                          |
+ * |    17/10/2026      1.4.0           agent                           'MCAL_WRAPEPR_SPI_POLL_TRANSFER' always drains the received     |
+ * |                                                                    byte.                                                           |
+ * |    17/10/2026      1.5.0           agent                           removed the polling and RXNE interrupt UART4 receive functions, |
+ * |                                                                    replaced by "MCAL_UART.h".                                      |
+ * |    17/10/2026      1.6.0           agent                           removed the polling 'MCAL_WRAPPER_SendDataThroughUART4',        |
+ * |                                                                    replaced by "MCAL_UART.h".                                      |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
  
@@ -67,21 +76,11 @@
  */
 #include "ch32v20x_spi.h"
 
-/**
- * @reason: contains I2C funcitonality
- */
-#include "ch32v20x_i2c.h"
-
 /**
  * @reason: contains common definitions
  */
 #include "common.h"
 
-/**
- * @reason: contains some configuration constants
- */
-#include "MPU6050.h"
-
 /**
  * @reason: contains UART functionality
  */
@@ -97,6 +96,11 @@
  */
 #include "Service_RTOS_wrapper.h"
 
+/**
+ * @reason: contains external interrupt functionality
+ */
+#include "ch32v20x_exti.h"
+
 /******************************************************************************
  * Module Preprocessor Constants
  *******************************************************************************/
@@ -119,11 +123,6 @@
  * Module Variable Definitions
  *******************************************************************************/
 
-/**
- * @brief: the callback function that will be called when UART receive interrupt happenss
- */
-functionCallBack_t global_UART4RecCallback = NULL;
-
 /**
  * @brief: calculated number of ticks for a timer to compute width of a pulse
  */
@@ -144,16 +143,29 @@ RTOS_TaskHandle_t global_CurrentPWTask_t = NULL;
  */
 volatile uint16_t tempreg = 0;
 
+/**
+ * @brief: the task waiting for the data ready pulse of the MPU6050
+ */
+RTOS_TaskHandle_t global_IMUDataReadyTask_t = NULL;
+
+/**
+ * @brief: number of data ready pulses caught since boot and the time of the last one in micro seconds
+ */
+volatile uint32_t global_u32IMUDataReadyEdges = 0;
+volatile uint32_t global_u32IMUDataReadyTimeUS = 0;
+
+/**
+ * @brief: number of data ready pulses already handed to the waiting task
+ */
+uint32_t global_u32IMUDataReadyServed = 0;
+
 /******************************************************************************
  * Function Prototypes
  *******************************************************************************/
 
-/**
- * @brief: USART4 IRQ handler
- */
- void UART4_IRQHandler(void); // __attribute__((interrupt("WCH-Interrupt-fast")));
 void TIM1_CC_IRQHandler(void) __attribute__((interrupt()));
 void TIM1_UP_IRQHandler(void) __attribute__((interrupt()));
+void EXTI15_10_IRQHandler(void) __attribute__((interrupt()));
 
 /******************************************************************************
  * Function Definitions
@@ -167,17 +179,23 @@ MCAL_WRAPPER_ErrStat_t MCAL_WRAPEPR_SPI_POLL_TRANSFER(MCAL_CONFIG_SPI_t *arg_pSP
     if(NULL == arg_pSPI || NULL == args_pu8InData)
         return MCAL_WRAPPER_STAT_INVALID_PARAMS;
 
+    uint8_t local_u8Received = 0;
+
+    // a byte left in the receive register would be taken as the answer to the first byte
+    (void)SPI_I2S_ReceiveData(arg_pSPI->SPI);
+
     GPIO_ResetBits(arg_pSPI->GPIO, arg_pSPI->SlavePin);
 
     while (arg_u16Len > 0)
     {
         SPI_I2S_SendData(arg_pSPI->SPI, *args_pu8InData);
-        while(SPI_I2S_GetFlagStatus(arg_pSPI->SPI, SPI_I2S_FLAG_TXE) != SET);
-        while(SPI_I2S_GetFlagStatus(arg_pSPI->SPI, SPI_I2S_FLAG_BSY) == SET);        
+        // the received byte is complete once the sent one is fully shifted out, it's always read to not overrun
+        while(SPI_I2S_GetFlagStatus(arg_pSPI->SPI, SPI_I2S_FLAG_RXNE) != SET);
+        local_u8Received = (uint8_t)SPI_I2S_ReceiveData(arg_pSPI->SPI);
         args_pu8InData++;
         if(args_pu8OutData != NULL)
         {
-            *args_pu8OutData = SPI_I2S_ReceiveData(arg_pSPI->SPI);
+            *args_pu8OutData = local_u8Received;
             args_pu8OutData++;
         }
 
@@ -191,75 +209,6 @@ MCAL_WRAPPER_ErrStat_t MCAL_WRAPEPR_SPI_POLL_TRANSFER(MCAL_CONFIG_SPI_t *arg_pSP
 
 
 
-/**
- * 
- */
-void I2C_start_transmission(uint8_t receiver_address, uint8_t master_receive){
-    uint8_t i2c_dir = I2C_Direction_Transmitter;
-    uint32_t i2c_event = I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED;
-
-    if(master_receive){
-        i2c_dir = I2C_Direction_Receiver;
-        i2c_event = I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED;
-    }
-
-    while( I2C_GetFlagStatus( I2C2, I2C_FLAG_BUSY ) != RESET );
-
-    I2C_GenerateSTART(I2C2, ENABLE);
-    while( !I2C_CheckEvent( I2C2, I2C_EVENT_MASTER_MODE_SELECT ) );
-
-    I2C_Send7bitAddress(I2C2, receiver_address << 1, i2c_dir);
-    while( !I2C_CheckEvent( I2C2, i2c_event ) );
-}
-
-/**
- * 
- */
-void I2C_write(uint8_t value){
-    while(I2C_GetFlagStatus(I2C2, I2C_FLAG_TXE)!=SET);
-    I2C_SendData(I2C2, value);
-}
-
-/**
- * 
- */
-void I2C_stop(){
-    while(I2C_GetFlagStatus(I2C2, I2C_FLAG_TXE)!=SET);
-    I2C_GenerateSTOP(I2C2, ENABLE);
-}
-
-/**
- * 
- */
-uint8_t I2C_read(){
-    static uint8_t i = 0;
-    uint8_t result = RxData[i];
-    i = (i+1) % I2C_Rx_BUFFER_SIZE;
-    return result;
-}
-
-/**
- * 
- */
-uint8_t I2C_requestFrom(uint8_t address, uint8_t quantity){
-    uint8_t i = 0;
-
-    I2C_start_transmission(address, MASTER_RECEIVER_MODE);
-
-    while(i < quantity){
-        if( I2C_GetFlagStatus( I2C2, I2C_FLAG_RXNE ) !=  RESET ){
-            RxData[i] = I2C_ReceiveData( I2C2 );
-            i++;
-        }
-        if(i == I2C_Rx_BUFFER_SIZE-1) I2C_NACKPositionConfig(I2C2, I2C_NACKPosition_Next);
-    }
-
-    while(I2C_GetFlagStatus(I2C2, I2C_FLAG_RXNE)!=SET);
-    I2C_GenerateSTOP(I2C2, ENABLE);
-
-    return i;
-}
-
 /**
  * 
  */
@@ -294,17 +243,6 @@ MCAL_WRAPPER_ErrStat_t MCAL_WRAPEPR_TIM4_PWM_OUT(MCAL_WRAPPER_TIM_CH_t arg_chann
     return MCAL_WRAPPER_STAT_OK;
 }
 
-/**
- *
- */
-void UART4_IRQHandler(void)
-{
-   if(USART_GetITStatus(UART4, USART_IT_RXNE) != RESET && NULL != global_UART4RecCallback)
-   {
-		global_UART4RecCallback();
-   }
-}
-
 
 /**
  * 
@@ -399,123 +337,6 @@ MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_TIM1GetWidthOfPulse(uint32_t* arg_u32TimeUS)
 
 }
 
-/**
- * 
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SetUART4RecCallBack(functionCallBack_t arg_pUARTCallBack)
-{
-    if(arg_pUARTCallBack == NULL)
-    {
-        return MCAL_WRAPPER_STAT_INVALID_PARAMS;
-    }
-
-    global_UART4RecCallback = arg_pUARTCallBack;
-
-    return MCAL_WRAPPER_STAT_OK;
-}
-
-/**
- * 
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_UART4RecITConfig(LIB_CONSTANTS_DriverStates_t arg_Enable_Disable_t)
-{
-	NVIC_InitTypeDef  uart_nvic_t = {0};
-    uart_nvic_t.NVIC_IRQChannel = UART4_IRQn;
-    uart_nvic_t.NVIC_IRQChannelPreemptionPriority = 1;
-    uart_nvic_t.NVIC_IRQChannelSubPriority = 1;
-
-    switch (arg_Enable_Disable_t)
-    {
-    case LIB_CONSTANTS_DISABLED:
-            // disable receive interrupt
-            USART_ITConfig(UART4, USART_IT_RXNE, DISABLE);
-            // configure NVIC for uart4 interrupt channel
-            uart_nvic_t.NVIC_IRQChannelCmd = DISABLE;
-            NVIC_Init(&uart_nvic_t);
-        break;
-
-    case LIB_CONSTANTS_ENABLED:
-            // enable receive interrupt
-            USART_ITConfig(UART4, USART_IT_RXNE, ENABLE);
-            // configure NVIC for uart4 interrupt channel
-            uart_nvic_t.NVIC_IRQChannelCmd = ENABLE;
-            NVIC_Init(&uart_nvic_t);
-        break;
-
-    default:
-        break;
-    }
-    
-    return MCAL_WRAPPER_STAT_OK;
-}
-
-/**
- * 
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SendDataThroughUART4(uint8_t* arg_pu8Data, uint16_t arg_u16DataLen)
-{
-    MCAL_WRAPPER_ErrStat_t local_errState_t = MCAL_WRAPPER_STAT_OK;
-
-    if(NULL == arg_pu8Data)
-    {
-        return MCAL_WRAPPER_STAT_INVALID_PARAMS;
-    }
-
-    while (arg_u16DataLen > 0)
-    {
-        // check if we can send
-        if(USART_GetFlagStatus(UART4, USART_FLAG_TXE) == SET && USART_GetFlagStatus(UART4, USART_FLAG_RXNE) == RESET)
-        {
-            USART_SendData(UART4, (uint16_t) *arg_pu8Data);
-            arg_pu8Data++;
-            arg_u16DataLen--;
-        }
-        else
-        {
-            local_errState_t = MCAL_WRAPPER_STAT_UART_BUSY;
-            break;
-        }
-
-    }
-    
-    return local_errState_t;
-}
-
-/**
- * 
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_ReceiveDataThroughUART4(uint8_t* arg_pu8Data, uint16_t arg_u16DataLen)
-{
-
-    MCAL_WRAPPER_ErrStat_t local_errState_t = MCAL_WRAPPER_STAT_OK;
-
-    if(NULL == arg_pu8Data)
-    {
-        return MCAL_WRAPPER_STAT_INVALID_PARAMS;
-    }
-
-
-    while (arg_u16DataLen > 0)
-    {
-        if(USART_GetFlagStatus(UART4, USART_FLAG_RXNE) == SET)
-        {
-            *arg_pu8Data = USART_ReceiveData(UART4);
-            arg_pu8Data++;
-            arg_u16DataLen--;
-            // clear the interrupt by writing 0 
-            USART_ClearFlag(UART4, USART_IT_RXNE);
-        }
-        else
-        {
-            local_errState_t = MCAL_WRAPPER_STAT_UART_EMPTY;
-            break;
-        }
-
-    }
-
-    return local_errState_t;
-}
-
 /**
  * 
  */
@@ -597,4 +418,67 @@ MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_GetADCBattery(uint16_t* arg_pu16ADCReadings)
     return MCAL_WRAPPER_STAT_OK; 
 }
 
+/**
+ * 
+ */
+void EXTI15_10_IRQHandler(void)
+{
+    if(EXTI_GetITStatus(MCAL_WRAPPER_IMU_DRDY_EXTI_LINE) != RESET)
+    {
+        // stamp the edge first, the sensor latched its registers on it (the micro seconds time counts a tick whose
+        // interrupt is held back by this one)
+        SERVICE_RTOS_CurrentUSTime((uint32_t*)&global_u32IMUDataReadyTimeUS);
+        global_u32IMUDataReadyEdges++;
+        EXTI_ClearITPendingBit(MCAL_WRAPPER_IMU_DRDY_EXTI_LINE);
+
+        if(NULL != global_IMUDataReadyTask_t)
+            SERVICE_RTOS_Notify(global_IMUDataReadyTask_t, LIB_CONSTANTS_ENABLED);
+    }
+}
+
+/**
+ * 
+ */
+MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_WaitIMUDataReady(uint32_t arg_u32TimeoutMS, uint32_t* arg_pu32EdgeTimeUS, uint32_t* arg_pu32MissedEdges)
+{
+    uint32_t local_u32StartTime = 0;
+    uint32_t local_u32CurrentTime = 0;
+    uint32_t local_u32Edges = 0;
+    uint32_t local_u32EdgeTime = 0;
+
+    // get the current handle, the pulses that came before the first wait aren't missed samples
+    if(NULL == global_IMUDataReadyTask_t)
+    {
+        global_u32IMUDataReadyServed = global_u32IMUDataReadyEdges;
+        SERVICE_RTOS_GetCurrentTaskHandle(&global_IMUDataReadyTask_t);
+    }
+
+    // the notification of the task is shared with other drivers (I2C), so wake ups are checked against the edge counter
+    SERVICE_RTOS_CurrentMSTime(&local_u32StartTime);
+    while(global_u32IMUDataReadyEdges == global_u32IMUDataReadyServed)
+    {
+        SERVICE_RTOS_CurrentMSTime(&local_u32CurrentTime);
+        if(local_u32CurrentTime - local_u32StartTime >= arg_u32TimeoutMS)
+            return MCAL_WRAPPER_STAT_TIMEOUT;
+
+        SERVICE_RTOS_WaitForNotification(arg_u32TimeoutMS - (local_u32CurrentTime - local_u32StartTime));
+    }
+
+    // take the counter and the time of the same edge
+    SERVICE_RTOS_EnterCritical();
+    local_u32Edges = global_u32IMUDataReadyEdges;
+    local_u32EdgeTime = global_u32IMUDataReadyTimeUS;
+    SERVICE_RTOS_ExitCritical();
+
+    if(NULL != arg_pu32EdgeTimeUS)
+        *arg_pu32EdgeTimeUS = local_u32EdgeTime;
+
+    if(NULL != arg_pu32MissedEdges)
+        *arg_pu32MissedEdges = local_u32Edges - global_u32IMUDataReadyServed - 1;
+
+    global_u32IMUDataReadyServed = local_u32Edges;
+
+    return MCAL_WRAPPER_STAT_OK;
+}
+
 /*************** END OF FUNCTIONS ***************************************************************************/
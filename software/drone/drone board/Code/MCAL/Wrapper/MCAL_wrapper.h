@@ -52,6 +52,15 @@
  * |    26/06/2023      1.0.0           Abdelrahman Mohamed Salem       added 'MCAL_WRAPPER_TIM1GetWidthOfPulse'.                       |
  * |    26/06/2023      1.0.0           Abdelrahman Mohamed Salem       added 'MCAL_WRAPPER_HCSR04TrigTrig'.                            |
  * |    27/06/2023      1.0.0           Abdelrahman Mohamed Salem       added 'MCAL_WRAPPER_GetADCBattery'.                             |
+ * |    17/10/2026      1.1.0           agent                           added 'MCAL_WRAPPER_I2C2BurstRead'.                             |
+ * |    17/10/2026      1.2.0           agent                           removed the polling I2C functions, replaced by "MCAL_I2C.h".    |
+ * |    17/10/2026      1.3.0           agent                           added 'MCAL_WRAPPER_WaitIMUDataReady'.                          |
+ * |    17/10/2026      1.4.0           agent                           'MCAL_WRAPEPR_SPI_POLL_TRANSFER' always drains the received     |
+ * |                                                                    byte.                                                           |
+ * |    17/10/2026      1.5.0           agent                           removed the polling and RXNE interrupt UART4 receive functions, |
+ * |                                                                    replaced by "MCAL_UART.h".                                      |
+ * |    17/10/2026      1.6.0           agent                           removed the polling 'MCAL_WRAPPER_SendDataThroughUART4',        |
+ * |                                                                    replaced by "MCAL_UART.h".                                      |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -92,6 +101,11 @@
  * Configuration Constants
  *******************************************************************************/
 
+/**
+ * @brief: EXTI line of the pin connected to the INT (data ready) pin of the MPU6050 (PB13)
+ */
+#define MCAL_WRAPPER_IMU_DRDY_EXTI_LINE         EXTI_Line13
+
 /******************************************************************************
  * Macros
  *******************************************************************************/
@@ -110,6 +124,7 @@ typedef enum {
   MCAL_WRAPPER_STAT_UART_BUSY,
   MCAL_WRAPPER_STAT_UART_EMPTY,
   MCAL_WRAPPER_STAT_ECHO_ERR,
+  MCAL_WRAPPER_STAT_TIMEOUT,
 } MCAL_WRAPPER_ErrStat_t;
 
 /**
@@ -139,6 +154,8 @@ typedef enum {
  *  @param  args_u8OutData [OUT]                :       base address to store the received data from the SPI upon transfer.
  *                                                      make args_u16OutData = NULL incase you don't want to receive anything
  *  @note                                       :       this is a polling function halting the process execution until the SPI data is transferred.
+ *                                                      'args_pu8OutData' may be 'args_pu8InData'. prefer MCAL_SPI_Transfer in "MCAL_SPI.h" once the
+ *                                                      schedular is running, it moves the bytes by DMA while the task sleeps.
  *  \b PRE-CONDITION                            :       make sure to call configure the configuration file in the current directory.
  *  \b POST-CONDITION                           :       None.
  *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_WRAPPER_ErrStat_t in "MCAL_wrapper.h")
@@ -176,148 +193,6 @@ MCAL_WRAPPER_ErrStat_t MCAL_WRAPEPR_SPI_POLL_TRANSFER(MCAL_CONFIG_SPI_t *arg_pSP
 
 
 
-/**
- *  \b function                                 :       None
- *  \b Description                              :       None.
- *  @param  arg_pFuncTaskFunction [IN]          :       None
- *  @param  arg_pu8TaskName [IN]                :       None
- *  @param  arg_pTaskHandle [OUT]               :       None
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       None
- *  \b POST-CONDITION                           :       None.
- *  @return                                     :       None
- *  @see                                        :       None
- *
- *  \b Example:
- * @code
- * 
- *          None
- * 
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 12/06/2024 </td><td> 1.0.0            </td><td> MZ      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-void I2C_start_transmission(uint8_t receiver_address, uint8_t master_receive);
-
-/**
- *  \b function                                 :       None
- *  \b Description                              :       None.
- *  @param  arg_pFuncTaskFunction [IN]          :       None
- *  @param  arg_pu8TaskName [IN]                :       None
- *  @param  arg_pTaskHandle [OUT]               :       None
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       None
- *  \b POST-CONDITION                           :       None.
- *  @return                                     :       None
- *  @see                                        :       None
- *
- *  \b Example:
- * @code
- * 
- *          None
- * 
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 12/06/2024 </td><td> 1.0.0            </td><td> MZ      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-void I2C_write(uint8_t value);
-
-
-/**
- *  \b function                                 :       None
- *  \b Description                              :       None.
- *  @param  arg_pFuncTaskFunction [IN]          :       None
- *  @param  arg_pu8TaskName [IN]                :       None
- *  @param  arg_pTaskHandle [OUT]               :       None
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       None
- *  \b POST-CONDITION                           :       None.
- *  @return                                     :       None
- *  @see                                        :       None
- *
- *  \b Example:
- * @code
- * 
- *          None
- * 
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 12/06/2024 </td><td> 1.0.0            </td><td> MZ      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-void I2C_stop();
-
-/**
- *  \b function                                 :       None
- *  \b Description                              :       None.
- *  @param  arg_pFuncTaskFunction [IN]          :       None
- *  @param  arg_pu8TaskName [IN]                :       None
- *  @param  arg_pTaskHandle [OUT]               :       None
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       None
- *  \b POST-CONDITION                           :       None.
- *  @return                                     :       None
- *  @see                                        :       None
- *
- *  \b Example:
- * @code
- * 
- *          None
- * 
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 12/06/2024 </td><td> 1.0.0            </td><td> MZ      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-uint8_t I2C_requestFrom(uint8_t address, uint8_t quantity);
-
-/**
- *  \b function                                 :       None
- *  \b Description                              :       None.
- *  @param  arg_pFuncTaskFunction [IN]          :       None
- *  @param  arg_pu8TaskName [IN]                :       None
- *  @param  arg_pTaskHandle [OUT]               :       None
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       None
- *  \b POST-CONDITION                           :       None.
- *  @return                                     :       None
- *  @see                                        :       None
- *
- *  \b Example:
- * @code
- * 
- *          None
- * 
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 12/06/2024 </td><td> 1.0.0            </td><td> MZ      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-uint8_t I2C_read();
-
-
 /**
  *  \b function                                 :       MCAL_WRAPPER_ErrStat_t MCAL_WRAPEPR_TIM4_PWM_OUT(MCAL_WRAPPER_TIM_CH_t arg_channel_t,  uint16_t arg_u8DutyPercent);
  *  \b Description                              :       this functions is used as a wrapper function to the function of changing pwm signal of TIM4.
@@ -359,176 +234,8 @@ uint8_t I2C_read();
  */
 MCAL_WRAPPER_ErrStat_t MCAL_WRAPEPR_TIM4_PWM_OUT(MCAL_WRAPPER_TIM_CH_t arg_channel_t,  uint16_t arg_u8DutyPercent);
 
-/**
- *  \b function                                 :       MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_UART4RecITConfig(LIB_CONSTANTS_DriverStates_t arg_Enable_Disable_t);
- *  \b Description                              :       this functions is used as a wrapper function to enable/disable uart4 byte received interrupt.
- *  @param arg_Enable_Disable_t [IN]            :       to enable or disable the interrupt, refer to @LIB_CONSTANTS_DriverStates_t in "constants.h".
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       UART receive interrupt is enabled/disabled.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
- *
- *  \b Example:
- * @code
- * 
- * #include "MCAL_wrapper.h"
- * 
- * void func(void)
- * {
- *  // callback code
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = MCAL_Config_ConfigAllPins();
- *  if(MCAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = MCAL_WRAPPER_UART4RecITConfig(LIB_CONSTANTS_ENABLED);
- *    if(MCAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *      // interrupt is enabled
- *    }
- *  }
- * }
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 20/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_UART4RecITConfig(LIB_CONSTANTS_DriverStates_t arg_Enable_Disable_t);
-
-/**
- *  \b function                                 :       MCAL_WRAPPER_SetUART4RecCallBack MCAL_WRAPPER_SetUART4CallBack(functionCallBack_t *arg_pUARTCallBack);
- *  \b Description                              :       this functions is used as a wrapper function to set callback function to execute when UART4 receives anything.
- *  @param  arg_pUARTCallBack [IN]              :       base address of function to be executed when UART4 receives anything.
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       Callback function is assigned to be executed whenever UART4 receives anything.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_WRAPPER_ErrStat_t in "MCAL_wrapper.h")
- *  @see                                        :       MCAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
- *
- *  \b Example:
- * @code
- * 
- * #include "MCAL_wrapper.h"
- * 
- * void func(void)
- * {
- *  // callback code
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = MCAL_Config_ConfigAllPins();
- *  if(MCAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = MCAL_WRAPPER_SetUART4RecCallBack(func);
- *    if(MCAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *    
- *    }
- *  }
- * }
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 17/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SetUART4RecCallBack(functionCallBack_t arg_pUARTCallBack);
 
 
-/**
- *  \b function                                 :       MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SendDataThroughUART4(uint8_t* arg_pu8Data, uint16_t arg_u16DataLen);
- *  \b Description                              :       this functions is used as a wrapper function to send data through UART4.
- *  @param  arg_pu8Data [IN]                    :       base address of data to be send over UART4.
- *  @param  arg_u16DataLen [IN]                 :       length of data in bytes to be send over UART4.
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       data is sent over UART4.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @MCAL_WRAPPER_ErrStat_t in "MCAL_wrapper.h")
- *  @see                                        :       MCAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
- *
- *  \b Example:
- * @code
- * 
- * #include "MCAL_wrapper.h"
- * 
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = MCAL_Config_ConfigAllPins();
- *  uint8_t data[] = [0, 1, 2, 4];
- *  if(MCAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = MCAL_WRAPPER_SendDataThroughUART4(data, 4);
- *    if(MCAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *      // data is sent successfully
- *    }
- *  }
- * }
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 18/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SendDataThroughUART4(uint8_t* arg_pu8Data, uint16_t arg_u16DataLen);
-
-
-/**
- *  \b function                                 :       MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SendDataThroughUART4(uint8_t* arg_pu8Data, uint16_t arg_u16DataLen);
- *  \b Description                              :       this functions is used as a wrapper function to send receive through UART4.
- *  @param  arg_pu8Data [IN]                    :       base address of data to be received over UART4.
- *  @param  arg_u16DataLen [IN]                 :       length of data in bytes to be received over UART4.
- *  @note                                       :       None.
- *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory.
- *  \b POST-CONDITION                           :       data is received over UART4.
- *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @HAL_WRAPPER_ErrStat_t in "HAL_wrapper.h")
- *  @see                                        :       HAL_ADXL345_PinStateModify(uint16_t arg_u16ADXL345Name, uint16_t arg_u16PinNumber, const uint8_t argConst_u8Operation)
- *
- *  \b Example:
- * @code
- * 
- * #include "MCAL_wrapper.h"
- * 
- * void func(void)
- * {
- *    SERVICE_RTOS_Notify(task_AppComm_Handle_t, LIB_CONSTANTS_ENABLED);
- * }
- * 
- * int main() {
- *  MCAL_Config_ErrStat_t local_errState = MCAL_Config_ConfigAllPins();
- *  uint8_t data[4];
- *  if(MCAL_Config_STAT_OK == local_errState)
- *  {
- *    local_errState = MCAL_WRAPPER_ReceiveDataThroughUART4(data, 4);
- *    if(MCAL_WRAPPER_STAT_OK == local_errState)
- *    {
- *      // data is sent successfully
- *    }
- *  }
- * }
- * @endcode
- *
- * <br><b> - HISTORY OF CHANGES - </b>
- * <table align="left" style="width:800px">
- * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
- * <tr><td> 18/06/2024 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
- * </table><br><br>
- * <hr>
- */
-MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_ReceiveDataThroughUART4(uint8_t* arg_pu8Data, uint16_t arg_u16DataLen);
-
 /**
  *  \b function                                 :       MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_DelayUS(uint32_t arg_u16US);
  *  \b Description                              :       this functions is used as a wrapper function to delay for a given micro seconds.
@@ -685,5 +392,48 @@ MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_HCSR04Trig(uint16_t arg_16PWuS);
  */
 MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_GetADCBattery(uint16_t* arg_pu16ADCReadings);
 
+/**
+ *  \b function                                 :       MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_WaitIMUDataReady(uint32_t arg_u32TimeoutMS, uint32_t* arg_pu32EdgeTimeUS, uint32_t* arg_pu32MissedEdges);
+ *  \b Description                              :       this functions is used to block the calling task until the MPU6050 raises its data ready pin,
+ *                                                      so the sampling is paced by the clock of the sensor instead of the RTOS tick.
+ *  @param  arg_u32TimeoutMS [IN]               :       maximum time in milliseconds to wait for the pulse.
+ *  @param  arg_pu32EdgeTimeUS [OUT]            :       time in micro seconds (SERVICE_RTOS_CurrentUSTime) at which the rising edge was caught, can be NULL.
+ *  @param  arg_pu32MissedEdges [OUT]           :       number of pulses that came since the last call and were not waited for, can be NULL.
+ *  @note                                       :       This is an interrupt function that will cause the task calling to block until the pulse comes,
+ *                                                      it returns immediately if a pulse came since the last call.
+ *  \b PRE-CONDITION                            :       make sure to call configure function the configuration file in the current directory and
+ *                                                      to enable the data ready interrupt of the MPU6050.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       MCAL_WRAPPER_STAT_TIMEOUT if no pulse came in time, otherwise one of error states indicating whether a failure or success happened
+ *                                                      (refer to @MCAL_WRAPPER_ErrStat_t in "MCAL_wrapper.h")
+ *  @see                                        :       None
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "MCAL_wrapper.h"
+ * 
+ * void task(void *pvParameters)
+ * {
+ *   uint32_t edgeTime = 0;
+ *   while(1)
+ *   {
+ *     if(MCAL_WRAPPER_STAT_OK == MCAL_WRAPPER_WaitIMUDataReady(10, &edgeTime, NULL))
+ *     {
+ *       // a new sample is ready to be read
+ *     }
+ *   }
+ * }
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_WaitIMUDataReady(uint32_t arg_u32TimeoutMS, uint32_t* arg_pu32EdgeTimeUS, uint32_t* arg_pu32MissedEdges);
+
 /*** End of File **************************************************************/
 #endif /*MCAL_WRAPPER_HEADER_H_*/
@@ -39,6 +39,7 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    26/06/2023      1.0.0           Mohab Zaghloul                  file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           added fixed point pid block.                                    |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -109,5 +110,37 @@ void pid_ctrl(pid_obj_t *pid_obj)
     pid_obj->lastError = pid_obj->error;
 }
 
+/**
+ * NOTE: the 3 products are accumulated in 64 bits (Q32.32) and rounded once, so the only loss is the final rounding
+ */
+void pid_ctrl_fixed(pid_fixed_obj_t *pid_obj)
+{
+    int64_t local_s64Sum = 0;
+
+    pid_obj->integral = LIB_MATH_FIXED_s32Saturate((int64_t)pid_obj->integral + pid_obj->error);
+
+    // check if we reached min or max possible values for error
+    if(pid_obj->integral > pid_obj->maxIntegralVal)
+    {
+        pid_obj->integral = pid_obj->maxIntegralVal;
+    }
+    else if(pid_obj->integral < pid_obj->minIntegralVal)
+    {
+        pid_obj->integral = pid_obj->minIntegralVal;
+    }
+    else
+    {
+        // do nothing
+    }
+
+    local_s64Sum  = (int64_t)pid_obj->kp * pid_obj->error;
+    local_s64Sum += (int64_t)pid_obj->ki * pid_obj->integral;
+    local_s64Sum += (int64_t)pid_obj->kd * ((int64_t)pid_obj->error - pid_obj->lastError);
+
+    pid_obj->output = LIB_MATH_FIXED_s32Saturate((local_s64Sum + (1 << 15)) >> 16);
+    pid_obj->output = LIB_MATH_FIXED_q16Mul(pid_obj->blockWeight, pid_obj->output);
+    pid_obj->lastError = pid_obj->error;
+}
+
 
 /*************** END OF FUNCTIONS ***************************************************************************/
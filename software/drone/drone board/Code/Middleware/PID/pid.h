@@ -39,6 +39,7 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    26/06/2023      1.0.0           Mohab Zaghloul                  file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           added fixed point pid block.                                    |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -50,6 +51,11 @@
  * Includes
  *******************************************************************************/
 
+/**
+ * @reason: contains fixed point types used by the fixed point pid block
+ */
+#include "math_fixed.h"
+
 /******************************************************************************
  * Preprocessor Constants
  *******************************************************************************/
@@ -144,6 +150,28 @@ typedef struct{
 
 }pid_obj_t;
 
+/************
+ * @brief: fixed point pid object, same as pid_obj_t but all the members are in Q16.16
+ * @note: gains smaller than 1/65536 can't be represented, use LIB_MATH_FIXED_FLOAT_TO_Q16 to convert the float gains above
+ **************/
+typedef struct{
+
+	// main pid parameters
+    LIB_MATH_FIXED_q16_t kp;
+    LIB_MATH_FIXED_q16_t ki;
+    LIB_MATH_FIXED_q16_t kd;
+    LIB_MATH_FIXED_q16_t error;
+    LIB_MATH_FIXED_q16_t lastError;
+    LIB_MATH_FIXED_q16_t integral;
+    LIB_MATH_FIXED_q16_t output;
+
+    // extra block infos
+    LIB_MATH_FIXED_q16_t maxIntegralVal;
+    LIB_MATH_FIXED_q16_t minIntegralVal;
+    LIB_MATH_FIXED_q16_t blockWeight;
+
+}pid_fixed_obj_t;
+
 /******************************************************************************
  * Variables
  *******************************************************************************/
@@ -152,6 +180,7 @@ typedef struct{
  * Function Prototypes
  *******************************************************************************/
 void pid_ctrl(pid_obj_t *pid_obj);
+void pid_ctrl_fixed(pid_fixed_obj_t *pid_obj);
 
 /*** End of File **************************************************************/
 #endif /*PID_H_*/
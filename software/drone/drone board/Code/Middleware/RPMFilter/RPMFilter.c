@@ -0,0 +1,199 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   motor speed notch filter bank                                                                               |
+ * |    @file           :   RPMFilter.c                                                                                                 |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   notch filters that follow the motor speeds to remove their vibration from the gyroscope                     |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains the definitions of the filter bank
+ */
+#include "RPMFilter.h"
+
+/**
+ * @reason: contains sin and cos of the notch frequencies
+ */
+#include "math_fast.h"
+
+/******************************************************************************
+ * Module Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: 1.0 in the fixed point of the coefficients
+ */
+#define RPM_FILTER_COEF_ONE         ((float)(1UL << RPM_FILTER_COEF_SHIFT))
+
+/**
+ * @brief: range of the filtered samples
+ */
+#define RPM_FILTER_SAMPLE_MIN       (-32768L)
+#define RPM_FILTER_SAMPLE_MAX       (32767L)
+
+/******************************************************************************
+ * Module Preprocessor Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Typedefs
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Variable Definitions
+ *******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/******************************************************************************
+ * Function Definitions
+ *******************************************************************************/
+
+/**
+ *
+ */
+void RpmFilter_Init(rpm_filter_t* filter, uint32_t sample_period_us)
+{
+    uint8_t i = 0, n = 0;
+
+    for(n = 0; n < RPM_FILTER_NOTCHES; n++)
+    {
+        filter->notch[n].b0 = 0;
+        filter->notch[n].b1 = 0;
+        filter->notch[n].a2 = 0;
+        filter->notch[n].active = 0;
+        for(i = 0; i < RPM_FILTER_AXES; i++)
+        {
+            filter->state[i][n].x1 = 0;
+            filter->state[i][n].x2 = 0;
+            filter->state[i][n].y1 = 0;
+            filter->state[i][n].y2 = 0;
+        }
+    }
+    filter->sample_hz = 1000000.0f / (float)sample_period_us;
+}
+
+/**
+ *
+ */
+void RpmFilter_SetMotors(rpm_filter_t* filter, const uint32_t* rpm, uint8_t valid)
+{
+    uint8_t m = 0, h = 0;
+    rpm_filter_notch_t* notch;
+    float hz, sin_w, cos_w, alpha, norm;
+
+    for(m = 0; m < RPM_FILTER_MOTORS; m++)
+    {
+        for(h = 0; h < RPM_FILTER_HARMONICS; h++)
+        {
+            notch = &filter->notch[m * RPM_FILTER_HARMONICS + h];
+            hz = (float)rpm[m] * (float)(h + 1) / 60.0f;
+
+            if(!(valid & (1 << m)) || hz < RPM_FILTER_MIN_HZ || hz > RPM_FILTER_MAX_RATIO * filter->sample_hz)
+            {
+                notch->active = 0;
+                continue;
+            }
+
+            // notch of the audio EQ cookbook: H(z) = (1 - 2cos(w)z^-1 + z^-2) / ((1 + alpha) - 2cos(w)z^-1 + (1 - alpha)z^-2)
+            LIB_MATH_FAST_f32SinCos(2.0f * LIB_MATH_FAST_PI * hz / filter->sample_hz, &sin_w, &cos_w);
+            alpha = sin_w / (2.0f * RPM_FILTER_Q);
+            norm = RPM_FILTER_COEF_ONE / (1.0f + alpha);
+            notch->b0 = (int32_t)norm;
+            notch->b1 = (int32_t)(-2.0f * cos_w * norm);
+            notch->a2 = (int32_t)((1.0f - alpha) * norm);
+            notch->active = 1;
+        }
+    }
+}
+
+/**
+ *
+ */
+int16_t RpmFilter_Apply(rpm_filter_t* filter, uint8_t axis, int16_t sample)
+{
+    uint8_t n = 0;
+    int32_t x = sample, y;
+    int64_t acc;
+    rpm_filter_notch_t* notch;
+    rpm_filter_state_t* state;
+
+    if(axis >= RPM_FILTER_AXES)
+        return sample;
+
+    for(n = 0; n < RPM_FILTER_NOTCHES; n++)
+    {
+        notch = &filter->notch[n];
+        state = &filter->state[axis][n];
+
+        if(notch->active)
+        {
+            // direct form 1, y = b0(x + x2) + b1(x1 - y1) - a2 y2
+            acc = (int64_t)notch->b0 * (x + state->x2)
+                + (int64_t)notch->b1 * (state->x1 - state->y1)
+                - (int64_t)notch->a2 * state->y2;
+            y = (int32_t)((acc + (1L << (RPM_FILTER_COEF_SHIFT - 1))) >> RPM_FILTER_COEF_SHIFT);
+            state->x2 = state->x1;
+            state->x1 = x;
+            state->y2 = state->y1;
+            state->y1 = y;
+            x = y;
+        }
+        else
+        {
+            // an idle notch follows its input so it starts from a steady state when it's turned on
+            state->x2 = x;
+            state->x1 = x;
+            state->y2 = x;
+            state->y1 = x;
+        }
+    }
+
+    if(x > RPM_FILTER_SAMPLE_MAX)
+        return (int16_t)RPM_FILTER_SAMPLE_MAX;
+    if(x < RPM_FILTER_SAMPLE_MIN)
+        return (int16_t)RPM_FILTER_SAMPLE_MIN;
+    return (int16_t)x;
+}
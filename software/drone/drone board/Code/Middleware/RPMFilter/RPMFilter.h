@@ -0,0 +1,198 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   motor speed notch filter bank                                                                               |
+ * |    @file           :   RPMFilter.h                                                                                                 |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   notch filters that follow the motor speeds to remove their vibration from the gyroscope                     |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+
+#ifndef RPM_FILTER_H_
+#define RPM_FILTER_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains definitions for standard integer definitions
+ */
+#include "stdint.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: number of motors followed by the filter bank
+ */
+#define RPM_FILTER_MOTORS           (4)
+
+/**
+ * @brief: number of harmonics of each motor removed, the first is the rotation frequency and the second the blade pass of 2 bladed props
+ */
+#define RPM_FILTER_HARMONICS        (2)
+
+/**
+ * @brief: number of notches run on every axis
+ */
+#define RPM_FILTER_NOTCHES          (RPM_FILTER_MOTORS * RPM_FILTER_HARMONICS)
+
+/**
+ * @brief: number of filtered axes (roll, pitch and yaw)
+ */
+#define RPM_FILTER_AXES             (3)
+
+/**
+ * @brief: the coefficients are fixed point numbers with this many fraction bits
+ */
+#define RPM_FILTER_COEF_SHIFT       (28)
+
+/******************************************************************************
+ * Configuration Constants
+ *******************************************************************************/
+
+/**
+ * @brief: quality factor of the notches, a higher one is narrower so it takes less phase from the control band but misses
+ *         more when the speed changes between two replies of the ESC
+ */
+#define RPM_FILTER_Q                (4.0f)
+
+/**
+ * @brief: harmonics below this frequency in Hz are left alone, the notch would eat into the band of the control loop
+ */
+#define RPM_FILTER_MIN_HZ           (80.0f)
+
+/**
+ * @brief: harmonics above this fraction of the sample rate are left alone, they are folded by the sampling anyway
+ */
+#define RPM_FILTER_MAX_RATIO        (0.45f)
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: axis index of RpmFilter_Apply()
+ */
+typedef enum {
+    RPM_FILTER_AXIS_ROLL = 0,
+    RPM_FILTER_AXIS_PITCH,
+    RPM_FILTER_AXIS_YAW
+} rpm_filter_axis_t;
+
+/**
+ * @brief: coefficients of one notch, b2 is b0 and a1 is b1 for a notch so they aren't stored
+ */
+typedef struct {
+    int32_t b0;             /**< gain of the input, fixed point with RPM_FILTER_COEF_SHIFT fraction bits */
+    int32_t b1;             /**< gain of the previous input and output */
+    int32_t a2;             /**< gain of the output before the previous one */
+    uint8_t active;         /**< 0 if the harmonic is unknown or out of range, the notch then passes the signal through */
+} rpm_filter_notch_t;
+
+/**
+ * @brief: past inputs and outputs of one notch on one axis
+ */
+typedef struct {
+    int32_t x1, x2;         /**< the last two inputs */
+    int32_t y1, y2;         /**< the last two outputs */
+} rpm_filter_state_t;
+
+/**
+ * @brief: the filter bank, owned by the caller
+ */
+typedef struct {
+    rpm_filter_notch_t notch[RPM_FILTER_NOTCHES];                   /**< harmonic h of motor m is notch[m * RPM_FILTER_HARMONICS + h] */
+    rpm_filter_state_t state[RPM_FILTER_AXES][RPM_FILTER_NOTCHES];
+    float sample_hz;                                                /**< sample rate of the filtered signal */
+} rpm_filter_t;
+
+/******************************************************************************
+ * Variables
+ *******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ * Starts the filter bank with every notch inactive and the states cleared.
+ *
+ * @param filter [OUT] Pointer to the filter bank.
+ * @param sample_period_us [IN] The period in micro seconds of the samples given to RpmFilter_Apply().
+ *
+ * @return void.
+ */
+void RpmFilter_Init(rpm_filter_t* filter, uint32_t sample_period_us);
+
+/**
+ * Moves the notches of every motor to its current speed. The notches of a motor without a valid speed, or whose
+ * harmonic is out of [RPM_FILTER_MIN_HZ, RPM_FILTER_MAX_RATIO * sample rate], are turned off.
+ *
+ * @param filter [IN/OUT] Pointer to the filter bank.
+ * @param rpm [IN] The speed of the RPM_FILTER_MOTORS motors in revolutions per minute.
+ * @param valid [IN] bit m is set if rpm[m] is known.
+ *
+ * @note the previous samples are kept so the output doesn't jump when a notch moves.
+ *
+ * @return void.
+ */
+void RpmFilter_SetMotors(rpm_filter_t* filter, const uint32_t* rpm, uint8_t valid);
+
+/**
+ * Runs one sample of an axis through the notches of every motor.
+ *
+ * @param filter [IN/OUT] Pointer to the filter bank.
+ * @param axis [IN] The axis of the sample (refer to @rpm_filter_axis_t).
+ * @param sample [IN] The sample, in any unit.
+ *
+ * @note RpmFilter_Init() should be called once before this function, every axis must be given its samples in order
+ *       and at the rate of RpmFilter_Init().
+ *
+ * @return the filtered sample, saturated to the range of int16_t.
+ */
+int16_t RpmFilter_Apply(rpm_filter_t* filter, uint8_t axis, int16_t sample);
+
+/*** End of File **************************************************************/
+#endif /*RPM_FILTER_H_*/
@@ -40,6 +40,14 @@
  * |    Date            Version         Author                          Description                                                     |
  * |    14/06/2023      1.0.0           Mohab Zaghloul                  file Created.                                                   |
  * |    18/06/2023      1.0.0           Mohab Zaghloul                  HMC fused.                                                      |
+ * |    17/10/2026      1.1.0           agent                           2D kalman matrices are statically allocated.                    |
+ * |    17/10/2026      1.2.0           agent                           2D kalman written out as scalar equations.                      |
+ * |    17/10/2026      1.3.0           agent                           added fixed point attitude fusion.                              |
+ * |    17/10/2026      1.4.0           agent                           added fast math option for the floating point fusion.           |
+ * |    17/10/2026      1.5.0           agent                           added quaternion (mahony) estimator.                            |
+ * |    17/10/2026      1.6.0           agent                           the mahony estimator integrates the IMU batch sample by sample. |
+ * |    17/10/2026      1.7.0           agent                           measurement updates only run on fresh magnetometer and          |
+ * |                                                                    barometer readings.                                             |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -69,14 +77,14 @@
 #include <math.h>
 
 /**
- * @reason: for malloc and free call functions
+ * @reason: contains fixed point arithmetic and CORDIC functions
  */
-#include <stdlib.h>
+#include "math_fixed.h"
 
 /**
- * 
+ * @reason: contains single precision approximations of the trigonometric functions
  */
-#include "matrix.h"
+#include "math_fast.h"
 
 /******************************************************************************
  * Module Preprocessor Constants
@@ -90,20 +98,90 @@
 #define PI (3.14159265)
 #define EPSILON (1.4e-14)
 
+/* Mahony filter constants */
+#define MAHONY_KP (2.0f)        // proportional gain towards the accelerometer/magnetometer directions
+#define MAHONY_KI (0.02f)       // integral gain, sets how fast the gyroscope bias is learned
+#define MAHONY_YAW_OFFSET (90)  // the heading of compute_azimuth() is measured from the y axis
+
+#define GYRO_RAW_TO_RAD ((float)(PI / (180 * HAL_WRAPPER_GYRO_RAW_LSB_PER_DPS)))   // raw gyroscope counts to rad/s
+
 #define BAROMETER_MEASUREMENT_UNCERTAINTY (900)  // 30cm
+#define ALTITUDE_PROCESS_UNCERTAINTY (1)         // variance of the vertical acceleration input
+
+#if SENSOR_FUSION_FIXED_POINT
+/* fixed point Kalman Filter constants in Q16.16 (variances, the process one is multiplied by the time step squared when used) */
+#define KALMAN_PROCESS_NOISE_Q16 LIB_MATH_FIXED_FLOAT_TO_Q16(STD_DEV_GYR * STD_DEV_GYR)
+#define KALMAN_MEASURE_ACC_Q16   LIB_MATH_FIXED_FLOAT_TO_Q16(STD_DEV_ACC * STD_DEV_ACC)
+#define KALMAN_MEASURE_MAG_Q16   LIB_MATH_FIXED_FLOAT_TO_Q16(STD_DEV_MAG * STD_DEV_MAG)
+
+#define TS_Q32          ((int32_t)(SENSOR_SAMPLE_PERIOD * 4294967.296 + 0.5))                       // sample period in seconds as Q0.32
+#define US_TO_Q32_Q16   ((int32_t)(281474976710656.0 / 1000000 + 0.5))                              // (us * US_TO_Q32_Q16) >> 16 gives seconds as Q0.32
+#define GYRO_SCALE_Q32  ((int32_t)(4294967296.0 / HAL_WRAPPER_GYRO_RAW_LSB_PER_DPS + 0.5))          // (raw * GYRO_SCALE_Q32) >> 16 gives deg/s in Q16.16
+#define DECLINATION_Q16 LIB_MATH_FIXED_FLOAT_TO_Q16(DECLINATION_DEGREE + (DECLINATION_MINUTE / 60.0))
+#endif
 
 /******************************************************************************
  * Module Preprocessor Macros
  *******************************************************************************/
 
+/* math functions used by the floating point fusion */
+#if SENSOR_FUSION_FAST_MATH
+#define FUSION_SQRT(X)          LIB_MATH_FAST_f32Sqrt(X)
+#define FUSION_ATAN2(Y, X)      LIB_MATH_FAST_f32Atan2(Y, X)
+#define FUSION_SINCOS(X, S, C)  LIB_MATH_FAST_f32SinCos(X, S, C)
+#define FUSION_ASIN(X)          LIB_MATH_FAST_f32Asin(X)
+#else
+#define FUSION_SQRT(X)          sqrt(X)
+#define FUSION_ATAN2(Y, X)      atan2(Y, X)
+#define FUSION_SINCOS(X, S, C)  do { *(S) = sin(X); *(C) = cos(X); } while(0)
+#define FUSION_ASIN(X)          asin(X)
+#endif
+
 /******************************************************************************
  * Module Typedefs
  *******************************************************************************/
 
+/**
+ * @brief: state of the 2D altitude kalman filter
+ * @note: the model is S = [altitude, vertical velocity], F = [1 Ts; 0 1], G = [Ts^2/2; Ts], H = [1 0]
+ *        so only the non-trivial entries of the matrices are kept
+ */
+typedef struct {
+    float altitude;            /**< estimated altitude in cm */
+    float vertical_velocity;   /**< estimated vertical velocity in cm/s */
+    float p00, p01, p10, p11;  /**< covariance matrix P */
+    float q00, q01, q11;       /**< process noise covariance Q = G.G' * process variance (symmetric) */
+    float r;                   /**< measurement noise variance R */
+    float g0, g1;              /**< control matrix G */
+    float dt;                  /**< time step G and Q were computed for */
+    float process_variance;    /**< variance of the acceleration input */
+} altitude_kalman_t;
+
+/**
+ * @brief: state of the quaternion (mahony) attitude estimator
+ * @note: the quaternion rotates the body frame (z up) to the earth frame (x towards the magnetic north, z up)
+ */
+typedef struct {
+    float q0, q1, q2, q3;                       /**< attitude quaternion */
+    float bias_x, bias_y, bias_z;               /**< integral feedback in rad/s, it is the negative of the gyroscope bias */
+} attitude_mahony_t;
+
 /******************************************************************************
  * Module Variable Definitions
  *******************************************************************************/
-matrix_2d_t S = {0}, F = {0}, G = {0}, U = {0}, H = {0}, Q = {0}, P = {0}, K = {0}, L = {0}, R = {0}, M = {0}, I = {0};
+
+/**
+ * @brief: the 2D altitude kalman filter
+ */
+static altitude_kalman_t global_AltitudeKalman_t = {0};
+
+#if !SENSOR_FUSION_FIXED_POINT
+/**
+ * @brief: the quaternion attitude estimator
+ */
+static attitude_mahony_t global_AttitudeMahony_t = {1, 0, 0, 0, 0, 0, 0};
+#endif
+
 float  Ts = SENSOR_SAMPLE_PERIOD/1000.0;
 
 /******************************************************************************
@@ -119,6 +197,35 @@ float  Ts = SENSOR_SAMPLE_PERIOD/1000.0;
  *
  * @return The azimuth angle in radians.
  */
+#if SENSOR_FUSION_FIXED_POINT
+/**
+ * Fixed point version of kalman_filter(), all the values are in Q16.16 but the time step.
+ *
+ * @param KalmanState Pointer to the current state estimate of the Kalman filter. Updated by this function.
+ * @param KalmanUncertainty Pointer to the current estimate uncertainty of the Kalman filter. Updated by this function.
+ * @param KalmanInput The control input to the system (rate of change of the state).
+ * @param KalmanMeasurement The new measurement for the update step.
+ * @param dt The time step since the previous call in seconds as Q0.32.
+ * @param process_variance The variance of the control input, it is multiplied by dt^2.
+ * @param measure_variance The measurement noise variance.
+ *
+ * @return void.
+ */
+void kalman_filter_fixed(LIB_MATH_FIXED_q16_t * KalmanState, LIB_MATH_FIXED_q16_t * KalmanUncertainty, LIB_MATH_FIXED_q16_t KalmanInput, LIB_MATH_FIXED_q16_t KalmanMeasurement, int32_t dt, LIB_MATH_FIXED_q16_t process_variance, LIB_MATH_FIXED_q16_t measure_variance);
+
+/**
+ * Prediction step of kalman_filter_fixed() alone, used when there is no new measurement.
+ *
+ * @param KalmanState Pointer to the current state estimate of the Kalman filter. Updated by this function.
+ * @param KalmanUncertainty Pointer to the current estimate uncertainty of the Kalman filter. Updated by this function.
+ * @param KalmanInput The control input to the system (rate of change of the state).
+ * @param dt The time step since the previous call in seconds as Q0.32.
+ * @param process_variance The variance of the control input, it is multiplied by dt^2.
+ *
+ * @return void.
+ */
+void kalman_predict_fixed(LIB_MATH_FIXED_q16_t * KalmanState, LIB_MATH_FIXED_q16_t * KalmanUncertainty, LIB_MATH_FIXED_q16_t KalmanInput, int32_t dt, LIB_MATH_FIXED_q16_t process_variance);
+#else
 float compute_azimuth(float mag_x, float mag_y);
 
 /**
@@ -137,6 +244,32 @@ float compute_azimuth(float mag_x, float mag_y);
  */
 void kalman_filter(float * KalmanState, float * KalmanUncertainty, float KalmanInput, float KalmanMeasurement, float Ts, float process_noise, float measure_covar);
 
+/**
+ * Prediction step of kalman_filter() alone, used when there is no new measurement.
+ *
+ * @param KalmanState Pointer to the current state estimate of the Kalman filter. Updated by this function.
+ * @param KalmanUncertainty Pointer to the current estimate uncertainty of the Kalman filter. Updated by this function.
+ * @param KalmanInput The control input to the system.
+ * @param Ts The time step since the previous call.
+ * @param process_noise The process noise covariance, representing the uncertainty in the system model.
+ *
+ * @return void.
+ */
+void kalman_predict(float * KalmanState, float * KalmanUncertainty, float KalmanInput, float Ts, float process_noise);
+
+/**
+ * Rotates the attitude quaternion by the given rates over one time step.
+ *
+ * @param ahrs Pointer to the state of the quaternion estimator. Updated by this function.
+ * @param half_gx The rate around the x axis in rad/s multiplied by half of the time step.
+ * @param half_gy The rate around the y axis in rad/s multiplied by half of the time step.
+ * @param half_gz The rate around the z axis in rad/s multiplied by half of the time step.
+ *
+ * @return void.
+ */
+void Attitude_Mahony_integrate(attitude_mahony_t* ahrs, float half_gx, float half_gy, float half_gz);
+#endif
+
 /**
  * Applies a 2D Kalman filter to estimate the true position based on a single measurement and inertial acceleration.
  * This simplified function is designed for systems where a full 2D state estimation is required but only a single
@@ -144,14 +277,47 @@ void kalman_filter(float * KalmanState, float * KalmanUncertainty, float KalmanI
  *
  * @param measurement The measurement value used for the update step of the Kalman filter.
  * @param inertial_acc The acceleration value from an inertial measurement unit, used as part of the system model.
+ * @param dt The time step since the previous call in seconds.
+ * @param measured 0 when 'measurement' is not a new reading, only the prediction step is done then.
+ *
+ * @return void.
+ */
+void kalman_filter_2d(float measurement, float inertial_acc, float dt, uint8_t measured);
+
+/**
+ * Sets the time step of the 2D altitude kalman filter, the control matrix G and the process noise Q follow it.
+ *
+ * @param dt The time step in seconds.
  *
  * @return void.
  */
-void kalman_filter_2d(float measurement, float inertial_acc);
+void Altitude_Kalman_2D_SetStep(float dt);
 /******************************************************************************
  * Function Definitions
  *******************************************************************************/
 
+#if SENSOR_FUSION_FIXED_POINT
+/**
+ * NOTE: the gain is kept in Q2.30 as it is usually around 0.01 where Q16.16 would only give 2 significant digits
+ */
+void kalman_filter_fixed(LIB_MATH_FIXED_q16_t * KalmanState, LIB_MATH_FIXED_q16_t * KalmanUncertainty, LIB_MATH_FIXED_q16_t KalmanInput, LIB_MATH_FIXED_q16_t KalmanMeasurement, int32_t dt, LIB_MATH_FIXED_q16_t process_variance, LIB_MATH_FIXED_q16_t measure_variance)
+{
+    int32_t KalmanGain;
+    kalman_predict_fixed(KalmanState, KalmanUncertainty, KalmanInput, dt, process_variance);
+    KalmanGain = (int32_t)(((int64_t)*KalmanUncertainty << 30) / ((int64_t)*KalmanUncertainty + measure_variance));
+    *KalmanState = *KalmanState + LIB_MATH_FIXED_s32MulShift(KalmanGain, KalmanMeasurement - *KalmanState, 30);
+    *KalmanUncertainty = LIB_MATH_FIXED_s32MulShift(((int32_t)1 << 30) - KalmanGain, *KalmanUncertainty, 30);
+}
+
+/**
+ *
+ */
+void kalman_predict_fixed(LIB_MATH_FIXED_q16_t * KalmanState, LIB_MATH_FIXED_q16_t * KalmanUncertainty, LIB_MATH_FIXED_q16_t KalmanInput, int32_t dt, LIB_MATH_FIXED_q16_t process_variance)
+{
+    *KalmanState = *KalmanState + LIB_MATH_FIXED_s32MulShift(KalmanInput, dt, 32);
+    *KalmanUncertainty = *KalmanUncertainty + LIB_MATH_FIXED_s32MulShift(process_variance, LIB_MATH_FIXED_s32MulShift(dt, dt, 32), 32);
+}
+#else
 /**
  *
  */
@@ -159,12 +325,12 @@ float compute_azimuth(float mag_x, float mag_y)
 {
     float declination_angle, heading;
     // Declination angle
-    declination_angle = (DECLINATION_DEGREE + (DECLINATION_MINUTE / 60.0)) * (PI / 180);
+    declination_angle = (float)((DECLINATION_DEGREE + (DECLINATION_MINUTE / 60.0)) * (PI / 180));
     // Calculate heading
-    heading = atan2(mag_x, mag_y);
+    heading = FUSION_ATAN2(mag_x, mag_y);
     heading += declination_angle;
 
-    return heading * (180/PI);
+    return heading * (float)(180/PI);
 }
 
 
@@ -174,208 +340,441 @@ float compute_azimuth(float mag_x, float mag_y)
 void kalman_filter(float * KalmanState, float * KalmanUncertainty, float KalmanInput, float KalmanMeasurement, float Ts, float process_noise, float measure_covar)
 {
     float KalmanGain;
-    *KalmanState = *KalmanState + Ts*KalmanInput;
-    *KalmanUncertainty = *KalmanUncertainty + Ts*Ts * process_noise*process_noise;
+    kalman_predict(KalmanState, KalmanUncertainty, KalmanInput, Ts, process_noise);
     KalmanGain = *KalmanUncertainty * 1/(*KalmanUncertainty + measure_covar*measure_covar);
     *KalmanState = *KalmanState + KalmanGain*(KalmanMeasurement-*KalmanState);
     *KalmanUncertainty = (1-KalmanGain) * (*KalmanUncertainty);
 }
 
 /**
- * @param S: State matrix
- * @param F: State transition matrix
- * @param G: Control matrix
- * @param U: Input variable matrix
- * @param H: Measurement matrix
- * @param Q: Process noise covariance matrix
- * @param R: Measurement noise covariance matrix
- * @param P: Covariance matrix
- * @param K: Kalman gain matrix
- * @param L: Temporary matrix for storing intermediate values during Kalman gain calculation
- * @param M: Measurement matrix
- * @param I: Identity matrix
- * @param F_T: Transpose of the state transition matrix
- * @param H_T: Transpose of the measurement matrix
- * @param temp_1, temp_2, temp_3, temp_4: Temporary matrices for intermediate calculations
- */
-void kalman_filter_2d(float measurement, float inertial_acc)
+ *
+ */
+void kalman_predict(float * KalmanState, float * KalmanUncertainty, float KalmanInput, float Ts, float process_noise)
 {
-    matrix_2d_t temp_1, temp_2, temp_3, temp_4;
-    matrix_2d_t F_T, H_T;
-
-    U.values[0] = inertial_acc;
-
-    // Predict
-    matrix_multiply(&F, &S, &temp_1);
-    matrix_multiply(&G, &U, &temp_2);
-    matrix_add(&temp_1, &temp_2, &S);
-    matrix_clear(&temp_1);
-    matrix_clear(&temp_2);
-
-    // Update
-    matrix_multiply(&F, &P, &temp_1);
-    matrix_transpose(&F, &F_T);
-    matrix_multiply(&temp_1, &F_T, &temp_2);
-    matrix_add(&temp_2, &Q, &P);
-    matrix_clear(&temp_1);
-    matrix_clear(&temp_2);
+    *KalmanState = *KalmanState + Ts*KalmanInput;
+    *KalmanUncertainty = *KalmanUncertainty + Ts*Ts * process_noise*process_noise;
+}
+#endif
+
+/**
+ * NOTE: this is F.S + G.U, F.P.F' + Q, K = P.H'/(H.P.H' + R) and P = (I - K.H).P expanded by hand
+ *       for the 2 states model, terms multiplied by the zeros and ones of F and H are dropped.
+ */
+void kalman_filter_2d(float measurement, float inertial_acc, float dt, uint8_t measured)
+{
+    altitude_kalman_t* kf = &global_AltitudeKalman_t;
+    float fp00, fp01, gain_0, gain_1, innovation, p00, p01;
+
+    // G and Q are only recomputed when the batch length changes
+    if(dt != kf->dt)
+        Altitude_Kalman_2D_SetStep(dt);
+
+    // Predict state
+    kf->altitude = (kf->altitude + dt * kf->vertical_velocity) + kf->g0 * inertial_acc;
+    kf->vertical_velocity = kf->vertical_velocity + kf->g1 * inertial_acc;
+
+    // Predict uncertainty (first row of F.P, second row equals the second row of P)
+    fp00 = kf->p00 + dt * kf->p10;
+    fp01 = kf->p01 + dt * kf->p11;
+    kf->p00 = (fp00 + dt * fp01) + kf->q00;
+    kf->p01 = fp01 + kf->q01;
+    kf->p10 = (kf->p10 + dt * kf->p11) + kf->q01;
+    kf->p11 = kf->p11 + kf->q11;
+
+    // no new barometer reading, the inertial acceleration carries the estimate
+    if(!measured)
+        return;
 
     // Kalman Gain
-    matrix_transpose(&H, &H_T);
-    matrix_multiply(&H, &P, &temp_1);
-    matrix_multiply(&temp_1, &H_T, &temp_2);
-    matrix_add(&temp_2, &R, &L);
-    matrix_clear(&temp_1);
-    matrix_clear(&temp_2);
-    L.values[0] = 1/(L.values[0]+EPSILON);
-
-    matrix_multiply(&P, &H_T, &temp_1);
-    matrix_multiply(&temp_1, &L, &K);
-    matrix_clear(&temp_1);
+    gain_0 = 1 / ((kf->p00 + kf->r) + EPSILON);
+    gain_1 = kf->p10 * gain_0;
+    gain_0 = kf->p00 * gain_0;
 
     // Update State
-    M.values[0] = measurement;
-    matrix_multiply(&H, &S, &temp_1);
-    matrix_subtract(&M, &temp_1, &temp_2);
-    matrix_multiply(&K, &temp_2, &temp_3);
-    matrix_add(&S, &temp_3, &temp_4);
-    matrix_clear(&S);
-    matrix_copy(&temp_4, &S);
-    matrix_clear(&temp_1);
-    matrix_clear(&temp_2);
-    matrix_clear(&temp_3);
+    innovation = measurement - kf->altitude;
+    kf->altitude = kf->altitude + gain_0 * innovation;
+    kf->vertical_velocity = kf->vertical_velocity + gain_1 * innovation;
 
     // Update Uncertainty
-    matrix_multiply(&K, &H, &temp_1);
-    matrix_subtract(&I, &temp_1, &temp_2);
-    matrix_multiply(&temp_2, &P, &temp_3);
-    matrix_clear(&P);
-    matrix_clear(&temp_1);
-    matrix_clear(&temp_2);
-    matrix_copy(&temp_3, &P);
+    p00 = kf->p00;
+    p01 = kf->p01;
+    kf->p00 = (1 - gain_0) * p00;
+    kf->p01 = (1 - gain_0) * p01;
+    kf->p10 = kf->p10 - gain_1 * p00;
+    kf->p11 = kf->p11 - gain_1 * p01;
 }
 
+#if SENSOR_FUSION_FIXED_POINT
+/**
+ * NOTE: same equations as the floating point version below, angles are in Q16.16 degrees and the sensor readings are raw counts
+ */
+void SensorFuseWithKalman(RawSensorDataItem_t* arg_pSensorsReadings, SensorFusionDataItem_t* arg_pFusedReadings)
+{
+    int32_t acc_x = arg_pSensorsReadings->Acc.x;
+    int32_t acc_y = arg_pSensorsReadings->Acc.y;
+    int32_t acc_z = arg_pSensorsReadings->Acc.z;
+    int32_t mag_x, mag_y;
+    LIB_MATH_FIXED_q16_t roll_rate, pitch_rate, yaw_rate;
+    LIB_MATH_FIXED_q16_t measured_roll, measured_pitch, measured_yaw;
+    LIB_MATH_FIXED_q16_t sin_roll, cos_roll, sin_pitch, cos_pitch;
+    int64_t vertical_acc;
+
+#if SENSOR_IMU_FIFO_BATCH
+    // the gyroscope is the average of the batch, it is applied over the time the batch spans
+    int32_t dt_us = arg_pSensorsReadings->ImuBatch.count * arg_pSensorsReadings->ImuBatch.periodUS;
+    int32_t dt = LIB_MATH_FIXED_s32MulShift(dt_us, US_TO_Q32_Q16, 16);
+#else
+    int32_t dt_us = SENSOR_SAMPLE_PERIOD * 1000;
+    int32_t dt = TS_Q32;
+#endif
+
+    // gyroscope counts to deg/s
+    roll_rate  = LIB_MATH_FIXED_s32MulShift(arg_pSensorsReadings->Gyro.roll, GYRO_SCALE_Q32, 16);
+    pitch_rate = LIB_MATH_FIXED_s32MulShift(arg_pSensorsReadings->Gyro.pitch, GYRO_SCALE_Q32, 16);
+    yaw_rate   = LIB_MATH_FIXED_s32MulShift(arg_pSensorsReadings->Gyro.yaw, GYRO_SCALE_Q32, 16);
+
+    // Roll and Pitch angles, atan(a / sqrt(b^2 + c^2)) is atan2(a, sqrt(b^2 + c^2)) as the root is never negative
+    measured_roll  = LIB_MATH_FIXED_q16Atan2Deg(acc_y, (int32_t)LIB_MATH_FIXED_u32Sqrt((uint32_t)(acc_x * acc_x) + (uint32_t)(acc_z * acc_z)));
+    measured_pitch = -LIB_MATH_FIXED_q16Atan2Deg(acc_x, (int32_t)LIB_MATH_FIXED_u32Sqrt((uint32_t)(acc_y * acc_y) + (uint32_t)(acc_z * acc_z)));
+
+    kalman_filter_fixed(&arg_pFusedReadings->roll, &arg_pFusedReadings->roll_uncertainty, roll_rate, measured_roll, dt, KALMAN_PROCESS_NOISE_Q16, KALMAN_MEASURE_ACC_Q16);
+    kalman_filter_fixed(&arg_pFusedReadings->pitch, &arg_pFusedReadings->pitch_uncertainty, pitch_rate, measured_pitch, dt, KALMAN_PROCESS_NOISE_Q16, KALMAN_MEASURE_ACC_Q16);
+
+    // Yaw angle
+    LIB_MATH_FIXED_q16SinCosDeg(arg_pFusedReadings->roll, &sin_roll, &cos_roll);
+    LIB_MATH_FIXED_q16SinCosDeg(arg_pFusedReadings->pitch, &sin_pitch, &cos_pitch);
+
+    if(arg_pSensorsReadings->Fresh & SENSOR_FRESH(SENSOR_ID_MAGNET))
+    {
+        // the scale of the magnetometer is common to both axes so the heading only needs the counts
+        mag_x = arg_pSensorsReadings->Magnet.x * cos_roll + arg_pSensorsReadings->Magnet.z * sin_roll;
+        mag_y = arg_pSensorsReadings->Magnet.y * cos_pitch + arg_pSensorsReadings->Magnet.z * sin_pitch;
+
+        measured_yaw = LIB_MATH_FIXED_q16Atan2Deg(mag_x, mag_y) + DECLINATION_Q16;
+
+        kalman_filter_fixed(&(arg_pFusedReadings->yaw), &(arg_pFusedReadings->yaw_uncertainty), yaw_rate, measured_yaw, dt, KALMAN_PROCESS_NOISE_Q16, KALMAN_MEASURE_MAG_Q16);
+    }
+    else
+    {
+        // the heading was already used, the gyroscope carries the yaw until the next output of the magnetometer
+        kalman_predict_fixed(&(arg_pFusedReadings->yaw), &(arg_pFusedReadings->yaw_uncertainty), yaw_rate, dt, KALMAN_PROCESS_NOISE_Q16);
+    }
+
+    // Inertial vertical velocity (in counts as Q16.16 then in cm/s^2)
+    vertical_acc =  - (int64_t)acc_x * sin_pitch
+                    + (int64_t)acc_y * LIB_MATH_FIXED_q16Mul(sin_roll, cos_pitch)
+                    + (int64_t)acc_z * LIB_MATH_FIXED_q16Mul(cos_roll, cos_pitch);
+    vertical_acc = ((vertical_acc - ((int64_t)HAL_WRAPPER_ACC_RAW_LSB_PER_G << 16)) * 981) / HAL_WRAPPER_ACC_RAW_LSB_PER_G;
+
+    // 2D kalman filter for altitude estimation
+    kalman_filter_2d(arg_pSensorsReadings->Altitude.altitude*100, LIB_MATH_FIXED_Q16_TO_FLOAT(LIB_MATH_FIXED_s32Saturate(vertical_acc)), dt_us * 1e-6f,
+                     arg_pSensorsReadings->Fresh & SENSOR_FRESH(SENSOR_ID_BARO));
+    arg_pFusedReadings->altitude = global_AltitudeKalman_t.altitude;
+    arg_pFusedReadings->vertical_velocity = global_AltitudeKalman_t.vertical_velocity;
+
+    // compute yaw rate
+    arg_pFusedReadings->yaw_rate = yaw_rate;
+
+}
+#else
 /**
  *
  */
 void SensorFuseWithKalman(RawSensorDataItem_t* arg_pSensorsReadings, SensorFusionDataItem_t* arg_pFusedReadings)
 {
     float roll_rad, pitch_rad;
+    float sin_roll, cos_roll, sin_pitch, cos_pitch;
     float mag_x, mag_y, mag_z;
     float measured_roll, measured_pitch, measured_yaw;
     float vertical_acc;
 
-    // Roll and Pitch angles
-    roll_rad  = atan(arg_pSensorsReadings->Acc.y / sqrt(arg_pSensorsReadings->Acc.x * arg_pSensorsReadings->Acc.x + arg_pSensorsReadings->Acc.z * arg_pSensorsReadings->Acc.z) );
-    pitch_rad = -atan(arg_pSensorsReadings->Acc.x / sqrt(arg_pSensorsReadings->Acc.y * arg_pSensorsReadings->Acc.y + arg_pSensorsReadings->Acc.z * arg_pSensorsReadings->Acc.z) );
-
-    measured_roll  = roll_rad  * (180/PI);
-    measured_pitch = pitch_rad * (180/PI);
+#if SENSOR_IMU_FIFO_BATCH
+    // the gyroscope is the average of the batch, it is applied over the time the batch spans
+    float dt = arg_pSensorsReadings->ImuBatch.count * (arg_pSensorsReadings->ImuBatch.periodUS * 1e-6f);
+#else
+    float dt = Ts;
+#endif
 
-    kalman_filter(&arg_pFusedReadings->roll, &arg_pFusedReadings->roll_uncertainty, arg_pSensorsReadings->Gyro.roll, measured_roll, Ts, STD_DEV_GYR, STD_DEV_ACC);
-    kalman_filter(&arg_pFusedReadings->pitch, &arg_pFusedReadings->pitch_uncertainty, arg_pSensorsReadings->Gyro.pitch, measured_pitch, Ts, STD_DEV_GYR, STD_DEV_ACC);
+    // Roll and Pitch angles, atan(a / sqrt(b^2 + c^2)) is atan2(a, sqrt(b^2 + c^2)) as the root is never negative
+    roll_rad  = FUSION_ATAN2(arg_pSensorsReadings->Acc.y, FUSION_SQRT(arg_pSensorsReadings->Acc.x * arg_pSensorsReadings->Acc.x + arg_pSensorsReadings->Acc.z * arg_pSensorsReadings->Acc.z) );
+    pitch_rad = -FUSION_ATAN2(arg_pSensorsReadings->Acc.x, FUSION_SQRT(arg_pSensorsReadings->Acc.y * arg_pSensorsReadings->Acc.y + arg_pSensorsReadings->Acc.z * arg_pSensorsReadings->Acc.z) );
 
-    // Yaw angle
-    roll_rad = arg_pFusedReadings->roll * (PI/180);
-    pitch_rad = arg_pFusedReadings->pitch * (PI/180);
-
-    mag_x = arg_pSensorsReadings->Magnet.x;
-    mag_y = arg_pSensorsReadings->Magnet.y;
-    mag_z = arg_pSensorsReadings->Magnet.z;
+    measured_roll  = roll_rad  * (float)(180/PI);
+    measured_pitch = pitch_rad * (float)(180/PI);
 
-    mag_x = mag_x*cos(roll_rad) + mag_z*sin(roll_rad);
-    mag_y = mag_y*cos(pitch_rad) + mag_z*sin(pitch_rad);
+    kalman_filter(&arg_pFusedReadings->roll, &arg_pFusedReadings->roll_uncertainty, arg_pSensorsReadings->Gyro.roll, measured_roll, dt, STD_DEV_GYR, STD_DEV_ACC);
+    kalman_filter(&arg_pFusedReadings->pitch, &arg_pFusedReadings->pitch_uncertainty, arg_pSensorsReadings->Gyro.pitch, measured_pitch, dt, STD_DEV_GYR, STD_DEV_ACC);
 
-    measured_yaw = compute_azimuth(mag_x, mag_y);
-
-    kalman_filter(&(arg_pFusedReadings->yaw), &(arg_pFusedReadings->yaw_uncertainty), arg_pSensorsReadings->Gyro.yaw, measured_yaw, Ts, STD_DEV_GYR, STD_DEV_MAG);
+    // Yaw angle
+    roll_rad = arg_pFusedReadings->roll * (float)(PI/180);
+    pitch_rad = arg_pFusedReadings->pitch * (float)(PI/180);
+    FUSION_SINCOS(roll_rad, &sin_roll, &cos_roll);
+    FUSION_SINCOS(pitch_rad, &sin_pitch, &cos_pitch);
+
+    if(arg_pSensorsReadings->Fresh & SENSOR_FRESH(SENSOR_ID_MAGNET))
+    {
+        mag_x = arg_pSensorsReadings->Magnet.x;
+        mag_y = arg_pSensorsReadings->Magnet.y;
+        mag_z = arg_pSensorsReadings->Magnet.z;
+
+        mag_x = mag_x*cos_roll + mag_z*sin_roll;
+        mag_y = mag_y*cos_pitch + mag_z*sin_pitch;
+
+        measured_yaw = compute_azimuth(mag_x, mag_y);
+
+        kalman_filter(&(arg_pFusedReadings->yaw), &(arg_pFusedReadings->yaw_uncertainty), arg_pSensorsReadings->Gyro.yaw, measured_yaw, dt, STD_DEV_GYR, STD_DEV_MAG);
+    }
+    else
+    {
+        // the heading was already used, the gyroscope carries the yaw until the next output of the magnetometer
+        kalman_predict(&(arg_pFusedReadings->yaw), &(arg_pFusedReadings->yaw_uncertainty), arg_pSensorsReadings->Gyro.yaw, dt, STD_DEV_GYR);
+    }
     
 
     // Inertial vertical velocity
-    vertical_acc =  - arg_pSensorsReadings->Acc.x * sin(pitch_rad)
-                    + arg_pSensorsReadings->Acc.y * sin(roll_rad) * cos(pitch_rad) 
-                    + arg_pSensorsReadings->Acc.z * cos(roll_rad) * cos(pitch_rad);
-    vertical_acc = (vertical_acc-1)*9.81*100;
+    vertical_acc =  - arg_pSensorsReadings->Acc.x * sin_pitch
+                    + arg_pSensorsReadings->Acc.y * sin_roll * cos_pitch 
+                    + arg_pSensorsReadings->Acc.z * cos_roll * cos_pitch;
+    vertical_acc = (vertical_acc-1)*(float)(9.81*100);
 
     // 2D kalman filter for altitude estimation
-    kalman_filter_2d(arg_pSensorsReadings->Altitude.altitude*100, vertical_acc);
-    arg_pFusedReadings->altitude = S.values[0];
-    arg_pFusedReadings->vertical_velocity = S.values[1];
+    kalman_filter_2d(arg_pSensorsReadings->Altitude.altitude*100, vertical_acc, dt, arg_pSensorsReadings->Fresh & SENSOR_FRESH(SENSOR_ID_BARO));
+    arg_pFusedReadings->altitude = global_AltitudeKalman_t.altitude;
+    arg_pFusedReadings->vertical_velocity = global_AltitudeKalman_t.vertical_velocity;
 
     // compute yaw rate
     arg_pFusedReadings->yaw_rate = arg_pSensorsReadings->Gyro.yaw;
 
 }
 
+/**
+ * NOTE: q' = q * (0, g) / 2 integrated with one euler step, the caller normalizes the quaternion
+ */
+void Attitude_Mahony_integrate(attitude_mahony_t* ahrs, float half_gx, float half_gy, float half_gz)
+{
+    float qa = ahrs->q0;
+    float qb = ahrs->q1;
+    float qc = ahrs->q2;
+
+    ahrs->q0 += -qb * half_gx - qc * half_gy - ahrs->q3 * half_gz;
+    ahrs->q1 +=  qa * half_gx + qc * half_gz - ahrs->q3 * half_gy;
+    ahrs->q2 +=  qa * half_gy - qb * half_gz + ahrs->q3 * half_gx;
+    ahrs->q3 +=  qa * half_gz + qb * half_gy - qc * half_gx;
+}
 
-void Altitude_Kalman_2D_init()
+/**
+ * NOTE: the correction is the cross product between the measured and the estimated directions of gravity and of the
+ *       magnetic field, the magnetic reference is rebuilt each step from the measurement rotated to the earth frame
+ *       so only its horizontal and vertical magnitudes are used. half angles are used all over to save multiplications.
+ */
+void SensorFuseWithMahony(RawSensorDataItem_t* arg_pSensorsReadings, SensorFusionDataItem_t* arg_pFusedReadings)
 {
-    matrix_2d_t G_T;
+    attitude_mahony_t* ahrs = &global_AttitudeMahony_t;
+    float gx, gy, gz, ax, ay, az, mx, my, mz;
+    float q0q0, q0q1, q0q2, q0q3, q1q1, q1q2, q1q3, q2q2, q2q3, q3q3;
+    float halfvx, halfvy, halfvz, halfwx, halfwy, halfwz;
+    float hx, hy, bx, bz;
+    float halfex = 0, halfey = 0, halfez = 0;
+    float recip_norm, sin_pitch;
+    float vertical_acc, dt;
+#if SENSOR_IMU_FIFO_BATCH
+    float half_dt;
+    uint8_t i;
+#endif
+
+    gx = arg_pSensorsReadings->Gyro.roll * LIB_MATH_FAST_DEG_TO_RAD;
+    gy = arg_pSensorsReadings->Gyro.pitch * LIB_MATH_FAST_DEG_TO_RAD;
+    gz = arg_pSensorsReadings->Gyro.yaw * LIB_MATH_FAST_DEG_TO_RAD;
+    ax = arg_pSensorsReadings->Acc.x;
+    ay = arg_pSensorsReadings->Acc.y;
+    az = arg_pSensorsReadings->Acc.z;
+    mx = arg_pSensorsReadings->Magnet.x;
+    my = arg_pSensorsReadings->Magnet.y;
+    mz = arg_pSensorsReadings->Magnet.z;
+
+    q0q0 = ahrs->q0 * ahrs->q0;   q0q1 = ahrs->q0 * ahrs->q1;   q0q2 = ahrs->q0 * ahrs->q2;   q0q3 = ahrs->q0 * ahrs->q3;
+    q1q1 = ahrs->q1 * ahrs->q1;   q1q2 = ahrs->q1 * ahrs->q2;   q1q3 = ahrs->q1 * ahrs->q3;
+    q2q2 = ahrs->q2 * ahrs->q2;   q2q3 = ahrs->q2 * ahrs->q3;
+    q3q3 = ahrs->q3 * ahrs->q3;
+
+    // half of the estimated direction of gravity in the body frame
+    halfvx = q1q3 - q0q2;
+    halfvy = q0q1 + q2q3;
+    halfvz = q0q0 - 0.5f + q3q3;
+
+    // accelerometer correction, skipped in free fall
+    if(!(ax == 0.0f && ay == 0.0f && az == 0.0f))
+    {
+        // inertial vertical acceleration, projection on the estimated gravity direction
+        vertical_acc = 2.0f * (ax * halfvx + ay * halfvy + az * halfvz);
+
+        recip_norm = LIB_MATH_FAST_f32InvSqrt(ax * ax + ay * ay + az * az);
+        ax *= recip_norm;
+        ay *= recip_norm;
+        az *= recip_norm;
+
+        halfex = ay * halfvz - az * halfvy;
+        halfey = az * halfvx - ax * halfvz;
+        halfez = ax * halfvy - ay * halfvx;
+    }
+    else
+    {
+        vertical_acc = 0.0f;
+    }
+
+    // magnetometer correction, only with a new reading (the item keeps the previous one in between) and never with a zero one
+    if((arg_pSensorsReadings->Fresh & SENSOR_FRESH(SENSOR_ID_MAGNET)) && !(mx == 0.0f && my == 0.0f && mz == 0.0f))
+    {
+        recip_norm = LIB_MATH_FAST_f32InvSqrt(mx * mx + my * my + mz * mz);
+        mx *= recip_norm;
+        my *= recip_norm;
+        mz *= recip_norm;
+
+        // reference direction of the magnetic field in the earth frame
+        hx = 2.0f * (mx * (0.5f - q2q2 - q3q3) + my * (q1q2 - q0q3) + mz * (q1q3 + q0q2));
+        hy = 2.0f * (mx * (q1q2 + q0q3) + my * (0.5f - q1q1 - q3q3) + mz * (q2q3 - q0q1));
+        bx = LIB_MATH_FAST_f32Sqrt(hx * hx + hy * hy);
+        bz = 2.0f * (mx * (q1q3 - q0q2) + my * (q2q3 + q0q1) + mz * (0.5f - q1q1 - q2q2));
+
+        // half of the estimated direction of the magnetic field in the body frame
+        halfwx = bx * (0.5f - q2q2 - q3q3) + bz * (q1q3 - q0q2);
+        halfwy = bx * (q1q2 - q0q3) + bz * (q0q1 + q2q3);
+        halfwz = bx * (q0q2 + q1q3) + bz * (0.5f - q1q1 - q2q2);
+
+        halfex += my * halfwz - mz * halfwy;
+        halfey += mz * halfwx - mx * halfwz;
+        halfez += mx * halfwy - my * halfwx;
+    }
+
+#if SENSOR_IMU_FIFO_BATCH
+    // the correction is computed once per batch from the average accelerometer and applied over the whole batch
+    dt = arg_pSensorsReadings->ImuBatch.count * (arg_pSensorsReadings->ImuBatch.periodUS * 1e-6f);
+#else
+    dt = Ts;
+#endif
+
+    // integral feedback (gyroscope bias) then proportional feedback
+    ahrs->bias_x += 2.0f * MAHONY_KI * halfex * dt;
+    ahrs->bias_y += 2.0f * MAHONY_KI * halfey * dt;
+    ahrs->bias_z += 2.0f * MAHONY_KI * halfez * dt;
+
+#if SENSOR_IMU_FIFO_BATCH
+    // integrate every sample of the batch with its own rates
+    halfex = ahrs->bias_x + 2.0f * MAHONY_KP * halfex;
+    halfey = ahrs->bias_y + 2.0f * MAHONY_KP * halfey;
+    halfez = ahrs->bias_z + 2.0f * MAHONY_KP * halfez;
+    half_dt = 0.5f * (arg_pSensorsReadings->ImuBatch.periodUS * 1e-6f);
+    for(i = 0; i < arg_pSensorsReadings->ImuBatch.count; i++)
+    {
+        gx = (arg_pSensorsReadings->ImuBatch.frames[i].gyro.roll * GYRO_RAW_TO_RAD + halfex) * half_dt;
+        gy = (arg_pSensorsReadings->ImuBatch.frames[i].gyro.pitch * GYRO_RAW_TO_RAD + halfey) * half_dt;
+        gz = (arg_pSensorsReadings->ImuBatch.frames[i].gyro.yaw * GYRO_RAW_TO_RAD + halfez) * half_dt;
+        Attitude_Mahony_integrate(ahrs, gx, gy, gz);
+    }
+#else
+    gx += ahrs->bias_x + 2.0f * MAHONY_KP * halfex;
+    gy += ahrs->bias_y + 2.0f * MAHONY_KP * halfey;
+    gz += ahrs->bias_z + 2.0f * MAHONY_KP * halfez;
+    Attitude_Mahony_integrate(ahrs, gx * (0.5f * dt), gy * (0.5f * dt), gz * (0.5f * dt));
+#endif
+
+    // keep the quaternion of unit length
+    recip_norm = LIB_MATH_FAST_f32InvSqrt(ahrs->q0 * ahrs->q0 + ahrs->q1 * ahrs->q1 + ahrs->q2 * ahrs->q2 + ahrs->q3 * ahrs->q3);
+    ahrs->q0 *= recip_norm;
+    ahrs->q1 *= recip_norm;
+    ahrs->q2 *= recip_norm;
+    ahrs->q3 *= recip_norm;
+
+    // quaternion to euler angles in degrees
+    sin_pitch = -2.0f * (ahrs->q1 * ahrs->q3 - ahrs->q0 * ahrs->q2);
+    if(sin_pitch > 1.0f)        sin_pitch = 1.0f;
+    else if(sin_pitch < -1.0f)  sin_pitch = -1.0f;
+
+    arg_pFusedReadings->roll  = FUSION_ATAN2(ahrs->q0 * ahrs->q1 + ahrs->q2 * ahrs->q3, 0.5f - ahrs->q1 * ahrs->q1 - ahrs->q2 * ahrs->q2) * LIB_MATH_FAST_RAD_TO_DEG;
+    arg_pFusedReadings->pitch = FUSION_ASIN(sin_pitch) * LIB_MATH_FAST_RAD_TO_DEG;
+    arg_pFusedReadings->yaw   = FUSION_ATAN2(ahrs->q1 * ahrs->q2 + ahrs->q0 * ahrs->q3, 0.5f - ahrs->q2 * ahrs->q2 - ahrs->q3 * ahrs->q3) * LIB_MATH_FAST_RAD_TO_DEG
+                              + (float)(MAHONY_YAW_OFFSET + DECLINATION_DEGREE + (DECLINATION_MINUTE / 60.0));
+    if(arg_pFusedReadings->yaw > 180.0f)
+    {
+        arg_pFusedReadings->yaw -= 360.0f;
+    }
+
+    arg_pFusedReadings->roll_uncertainty = 0;
+    arg_pFusedReadings->pitch_uncertainty = 0;
+    arg_pFusedReadings->yaw_uncertainty = 0;
+
+    // 2D kalman filter for altitude estimation
+    vertical_acc = (vertical_acc-1)*(float)(9.81*100);
+    kalman_filter_2d(arg_pSensorsReadings->Altitude.altitude*100, vertical_acc, dt, arg_pSensorsReadings->Fresh & SENSOR_FRESH(SENSOR_ID_BARO));
+    arg_pFusedReadings->altitude = global_AltitudeKalman_t.altitude;
+    arg_pFusedReadings->vertical_velocity = global_AltitudeKalman_t.vertical_velocity;
 
-    // State Matrix S
-    float* S_values = (float*)malloc(2 * 1 * sizeof(float));
-    S_values[0] = 0; S_values[1] = 0;
-    matrix_set(&S, 2, 1, S_values);
+    // yaw rate with the estimated bias removed
+    arg_pFusedReadings->yaw_rate = arg_pSensorsReadings->Gyro.yaw + ahrs->bias_z * LIB_MATH_FAST_RAD_TO_DEG;
+}
 
-    // Covariance Matrix P
-    float* P_values = (float*)malloc(2 * 2 * sizeof(float));
-    P_values[0] = 0; P_values[1] = 0;
-    P_values[2] = 0; P_values[3] = 0;
-    matrix_set(&P, 2, 2, P_values);
+/**
+ *
+ */
+void Attitude_Mahony_init()
+{
+    global_AttitudeMahony_t.q0 = 1;
+    global_AttitudeMahony_t.q1 = 0;
+    global_AttitudeMahony_t.q2 = 0;
+    global_AttitudeMahony_t.q3 = 0;
+    global_AttitudeMahony_t.bias_x = 0;
+    global_AttitudeMahony_t.bias_y = 0;
+    global_AttitudeMahony_t.bias_z = 0;
+}
+#endif
 
-    // State Transition Matrix F
-    float* F_values = (float*)malloc(2 * 2 * sizeof(float));
-    F_values[0] = 1; F_values[1] = Ts;
-    F_values[2] = 0; F_values[3] = 1;
-    matrix_set(&F, 2, 2, F_values);
 
-    // Control Matrix G
-    float* G_values = (float*)malloc(2 * 1 * sizeof(float));
-    G_values[0] = 0.5 * Ts * Ts; G_values[1] = Ts;
-    matrix_set(&G, 2, 1, G_values);
+void Altitude_Kalman_2D_init()
+{
+    // State and covariance
+    global_AltitudeKalman_t.altitude = 0;
+    global_AltitudeKalman_t.vertical_velocity = 0;
+    global_AltitudeKalman_t.p00 = 0; global_AltitudeKalman_t.p01 = 0;
+    global_AltitudeKalman_t.p10 = 0; global_AltitudeKalman_t.p11 = 0;
+
+    // Process and measurement noise, then the control matrix G for the nominal sample period
+    Altitude_Kalman_2D_SetNoise(ALTITUDE_PROCESS_UNCERTAINTY, BAROMETER_MEASUREMENT_UNCERTAINTY);
+    Altitude_Kalman_2D_SetStep(Ts);
+}
+
+/**
+ *
+ */
+void Altitude_Kalman_2D_SetStep(float dt)
+{
+    altitude_kalman_t* kf = &global_AltitudeKalman_t;
 
-    // Input Matrix U
-    float* U_values = (float*)malloc(1 * 1 * sizeof(float));
-    U_values[0] = 0;
-    matrix_set(&U, 1, 1, U_values);
+    // Control Matrix G
+    kf->dt = dt;
+    kf->g0 = 0.5 * dt * dt;
+    kf->g1 = dt;
+
+    // Process Noise Covariance Matrix Q = G.G' * process variance
+    kf->q00 = kf->g0 * kf->g0 * kf->process_variance;
+    kf->q01 = kf->g0 * kf->g1 * kf->process_variance;
+    kf->q11 = kf->g1 * kf->g1 * kf->process_variance;
+}
 
-    // Observation Matrix H
-    float* H_values = (float*)malloc(1 * 2 * sizeof(float));
-    H_values[0] = 1; H_values[1] = 0;
-    matrix_set(&H, 1, 2, H_values);
+/**
+ *
+ */
+void Altitude_Kalman_2D_SetNoise(float process_variance, float measurement_variance)
+{
+    altitude_kalman_t* kf = &global_AltitudeKalman_t;
 
-    // Process Noise Covariance Matrix Q (assume process variance = 1)
-    matrix_transpose(&G, &G_T);
-    matrix_multiply(&G, &G_T, &Q);
+    // Process Noise Covariance Matrix Q = G.G' * process variance
+    kf->process_variance = process_variance;
+    kf->q00 = kf->g0 * kf->g0 * process_variance;
+    kf->q01 = kf->g0 * kf->g1 * process_variance;
+    kf->q11 = kf->g1 * kf->g1 * process_variance;
 
     // Measurement Noise Covariance Matrix R
-    float* R_values = (float*)malloc(1 * 1 * sizeof(float));
-    R_values[0] = BAROMETER_MEASUREMENT_UNCERTAINTY;
-    matrix_set(&R, 1, 1, R_values);
-
-    // Intermediate Matrix L
-    float* L_values = (float*)malloc(1 * 1 * sizeof(float));
-    L_values[0] = 0;
-    matrix_set(&L, 1, 1, L_values);
-
-    // Kalman Gain Matrix K
-    float* K_values = (float*)malloc(2 * 1 * sizeof(float));
-    K_values[0] = 0; K_values[1] = 0;
-    matrix_set(&K, 2, 1, K_values);
-
-    // Measurement matrix M
-    float* M_values = (float*)malloc(1 * 1 * sizeof(float));
-    M_values[0] = 0;
-    matrix_set(&M, 1, 1, M_values);
-
-    // Identity Matrix I
-    float* I_values = (float*)malloc(2 * 2 * sizeof(float));
-    I_values[0] = 1; I_values[1] = 0;
-    I_values[2] = 0; I_values[3] = 1;
-    matrix_set(&I, 2, 2, I_values);
-
+    kf->r = measurement_variance;
 }
 
- 
-
 /*************** END OF FUNCTIONS ***************************************************************************/
@@ -39,6 +39,9 @@
  * |    ====================                                                                                                            |
  * |    Date            Version         Author                          Description                                                     |
  * |    14/06/2023      1.0.0           Mohab Zaghloul                  file Created.                                                   |
+ * |    17/10/2026      1.1.0           agent                           added fast math option.                                         |
+ * |    17/10/2026      1.2.0           agent                           added quaternion (mahony) estimator.                            |
+ * |    17/10/2026      1.3.0           agent                           the mahony estimator integrates the IMU batch sample by sample. |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -67,6 +70,19 @@
 #define DECLINATION_DEGREE 4
 #define DECLINATION_MINUTE 51
 
+/* 1 to use the single precision approximations of "math_fast.h" in the floating point fusion instead of the
+   double precision functions of <math.h>, the error of the approximations is below 1e-5 rad */
+#define SENSOR_FUSION_FAST_MATH 0
+
+/* attitude estimator used by the sensor fusion task */
+#define SENSOR_FUSION_ESTIMATOR_KALMAN 0    /**< 3 scalar kalman filters on the euler angles */
+#define SENSOR_FUSION_ESTIMATOR_MAHONY 1    /**< quaternion complementary filter with gyro bias estimation */
+#define SENSOR_FUSION_ESTIMATOR SENSOR_FUSION_ESTIMATOR_KALMAN
+
+#if SENSOR_FUSION_FIXED_POINT && (SENSOR_FUSION_ESTIMATOR == SENSOR_FUSION_ESTIMATOR_MAHONY)
+#error "the mahony estimator is only available in the floating point build (SENSOR_FUSION_FIXED_POINT = 0)"
+#endif
+
 /******************************************************************************
  * Macros
  *******************************************************************************/
@@ -106,5 +122,39 @@ void SensorFuseWithKalman(RawSensorDataItem_t* arg_pSensorsReadings, SensorFusio
  */
 void Altitude_Kalman_2D_init();
 
+/**
+ * Fuses sensor data using a quaternion complementary (Mahony) filter. The gyroscope is integrated as a quaternion
+ * and corrected towards the gravity and magnetic field directions, the integral of the correction estimates the
+ * gyroscope bias. The output has the same meaning as SensorFuseWithKalman() (the uncertainties are set to zero).
+ * With SENSOR_IMU_FIFO_BATCH every sample of the IMU batch is integrated with its own rates.
+ *
+ * @param arg_pSensorsReadings [IN] Pointer to the structure containing raw sensor data.
+ * @param arg_pFusedReadings [OUT] Pointer to the structure where the fused sensor data will be stored.
+ *
+ * @note Attitude_Mahony_init() and Altitude_Kalman_2D_init() should be called before this function.
+ *
+ * @return void.
+ */
+void SensorFuseWithMahony(RawSensorDataItem_t* arg_pSensorsReadings, SensorFusionDataItem_t* arg_pFusedReadings);
+
+/**
+ * Resets the quaternion estimator to the level attitude and clears the estimated gyroscope bias.
+ *
+ * @return void.
+ */
+void Attitude_Mahony_init();
+
+/**
+ * Changes the noise model of the 2D altitude kalman filter at run time, the current estimate is kept.
+ *
+ * @param process_variance [IN] Variance of the vertical acceleration used as the filter input.
+ * @param measurement_variance [IN] Variance of the barometric altitude measurement in cm^2.
+ *
+ * @note Altitude_Kalman_2D_init() sets the default values, call this function after it.
+ *
+ * @return void.
+ */
+void Altitude_Kalman_2D_SetNoise(float process_variance, float measurement_variance);
+
 /*** End of File **************************************************************/
 #endif /*SENSOR_FUSION_H_*/
\ No newline at end of file
@@ -0,0 +1,141 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   multi rate sensor scheduler                                                                                 |
+ * |    @file           :   SensorScheduler.c                                                                                           |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   decides which sensors are due in each cycle of the sensors collection task                                  |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains the definitions of the scheduler
+ */
+#include "SensorScheduler.h"
+
+/******************************************************************************
+ * Module Preprocessor Constants
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Preprocessor Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Typedefs
+ *******************************************************************************/
+
+/******************************************************************************
+ * Module Variable Definitions
+ *******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/******************************************************************************
+ * Function Definitions
+ *******************************************************************************/
+
+/**
+ *
+ */
+void SensorSched_Init(sensor_sched_entry_t* entries, uint8_t count, uint32_t now_us)
+{
+    uint8_t i;
+
+    for(i = 0; i < count; i++)
+    {
+        entries[i].nextDueUS = now_us;
+        entries[i].reads = 0;
+        entries[i].deferred = 0;
+        entries[i].overruns = 0;
+    }
+}
+
+/**
+ * NOTE: the times are compared through their signed difference so the wrap around of the micro seconds counter
+ *       (every ~71 minutes) doesn't matter
+ */
+uint32_t SensorSched_GetDue(sensor_sched_entry_t* entries, uint8_t count, uint32_t now_us, uint32_t cycle_us)
+{
+    uint32_t due = 0;
+    uint8_t slot_taken = 0;
+    int32_t late;
+    uint8_t i;
+
+    for(i = 0; i < count && i < SENSOR_SCHED_MAX_ENTRIES; i++)
+    {
+        if(0 == entries[i].periodUS)
+        {
+            due |= (uint32_t)1 << i;
+            entries[i].reads++;
+            continue;
+        }
+
+        late = (int32_t)(now_us - entries[i].nextDueUS);
+        if(late < 0)
+            continue;
+
+        // another sensor is read in this cycle, wait for the next one if the deadline allows it
+        if(slot_taken && (uint32_t)late + cycle_us <= entries[i].deadlineUS)
+        {
+            entries[i].deferred++;
+            continue;
+        }
+
+        due |= (uint32_t)1 << i;
+        entries[i].reads++;
+        slot_taken = 1;
+
+        // the next output of the sensor, start again from now if one or more outputs were missed
+        entries[i].nextDueUS += entries[i].periodUS;
+        if((int32_t)(now_us - entries[i].nextDueUS) >= 0)
+        {
+            entries[i].nextDueUS = now_us + entries[i].periodUS;
+            entries[i].overruns++;
+        }
+    }
+
+    return due;
+}
+
+/*************** END OF FUNCTIONS ***************************************************************************/
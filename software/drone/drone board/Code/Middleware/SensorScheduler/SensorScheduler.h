@@ -0,0 +1,128 @@
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   multi rate sensor scheduler                                                                                 |
+ * |    @file           :   SensorScheduler.h                                                                                           |
+ * |    @author         :   agent                                                                                                       |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   RISC-V Cross GCC                                                                                            |
+ * |    @compiler       :   GCC                                                                                                         |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   CH32V203C8T6                                                                                                |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   decides which sensors are due in each cycle of the sensors collection task                                  |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2026 - agent - All Rights Reserved                                                                              |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           agent                           file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+
+#ifndef SENSOR_SCHEDULER_H_
+#define SENSOR_SCHEDULER_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: contains definitions for standard integer definitions
+ */
+#include "stdint.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: maximum number of sensors in one schedule (bits of the mask returned by SensorSched_GetDue)
+ */
+#define SENSOR_SCHED_MAX_ENTRIES    (32)
+
+/******************************************************************************
+ * Configuration Constants
+ *******************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: one sensor of the schedule, the period and the deadline are set by the user, the rest is kept by the scheduler
+ */
+typedef struct {
+    uint32_t periodUS;      /**< native output period of the sensor in micro seconds, 0 to read it in every cycle */
+    uint32_t deadlineUS;    /**< how late the read may be after the sensor became due, used to spread the reads over the cycles */
+    uint32_t nextDueUS;     /**< time at which the next output of the sensor is expected */
+    uint32_t reads;         /**< number of cycles in which the sensor was due */
+    uint32_t deferred;      /**< number of cycles the read was moved to the next cycle to spread the bus load */
+    uint32_t overruns;      /**< number of times the sensor was due for more than one period and its schedule was restarted */
+} sensor_sched_entry_t;
+
+/******************************************************************************
+ * Variables
+ *******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ * Starts the schedule, every sensor becomes due in the first cycle and the counters are cleared.
+ *
+ * @param entries [IN/OUT] Pointer to the sensors of the schedule with the period and the deadline set.
+ * @param count [IN] Number of sensors in entries (at most SENSOR_SCHED_MAX_ENTRIES).
+ * @param now_us [IN] The current time in micro seconds.
+ *
+ * @return void.
+ */
+void SensorSched_Init(sensor_sched_entry_t* entries, uint8_t count, uint32_t now_us);
+
+/**
+ * Returns the sensors to read in the current cycle and moves their due time by one period, so each sensor is read
+ * once per output at its native rate without drifting. Only one sensor with a period is read per cycle as long as
+ * the deadline of the others allows them to wait for the next cycle, which keeps the slow reads from piling up
+ * in the same cycle. The sensors with a zero period are always returned and don't count.
+ *
+ * @param entries [IN/OUT] Pointer to the sensors of the schedule, the earlier ones have the priority.
+ * @param count [IN] Number of sensors in entries (at most SENSOR_SCHED_MAX_ENTRIES).
+ * @param now_us [IN] The current time in micro seconds.
+ * @param cycle_us [IN] The period of the calling loop in micro seconds.
+ *
+ * @note SensorSched_Init() should be called once before this function.
+ *
+ * @return bit i is set if entries[i] has to be read in this cycle.
+ */
+uint32_t SensorSched_GetDue(sensor_sched_entry_t* entries, uint8_t count, uint32_t now_us, uint32_t cycle_us);
+
+/*** End of File **************************************************************/
+#endif /*SENSOR_SCHEDULER_H_*/
@@ -47,6 +47,15 @@
  * |                                                                    function 'SERVICE_RTOS_ReadFromBlockingQueue'.                  |
  * |    24/06/2023      1.0.0           Abdelrahman Mohamed Salem       added 'SERVICE_RTOS_CurrentMSTime'.                             |
  * |    26/06/2023      1.0.0           Abdelrahman Mohamed Salem       added 'SERVICE_RTOS_GetCurrentTaskHandle'.                      |
+ * |    17/10/2026      1.1.0           agent                           added 'SERVICE_RTOS_CurrentUSTime'.                             |
+ * |    17/10/2026      1.2.0           agent                           added 'SERVICE_RTOS_EnterCritical',                             |
+ * |                                                                    'SERVICE_RTOS_ExitCritical'.                                    |
+ * |    17/10/2026      1.2.0           agent                           made 'SERVICE_RTOS_Notify' yield from ISR.                      |
+ * |    17/10/2026      1.3.0           agent                           added 'SERVICE_RTOS_GetIdleTime'.                               |
+ * |    17/10/2026      1.4.0           agent                           added the latest item mailbox 'RTOS_Mailbox_t' (triple buffer)  |
+ * |                                                                    and its functions.                                              |
+ * |    17/10/2026      1.4.1           agent                           'SERVICE_RTOS_CurrentUSTime' counts a tick whose interrupt is   |
+ * |                                                                    still pending.                                                  |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
  
@@ -75,6 +84,12 @@
 #include "math_btt.h"
 
 
+/**
+ * @reason: contains memcpy used to write an item into a mailbox
+ */
+#include "string.h"
+
+
 /**
  * @reason: contains definition for our functions
 */
@@ -100,6 +115,17 @@
  * Module Preprocessor Constants
  *******************************************************************************/
 
+/**
+ * @brief: the bits of 'RTOS_Mailbox_t::state', the buffer of the newest item and a flag set until it's read
+ */
+#define SERVICE_RTOS_MAILBOX_INDEX_MASK     (0x3UL)
+#define SERVICE_RTOS_MAILBOX_FRESH          (0x4UL)
+
+/**
+ * @brief: the count flag of the systick status register, set when the counter restarts and cleared by the tick interrupt
+ */
+#define SERVICE_RTOS_SYSTICK_CNTIF          (0x1UL)
+
 /******************************************************************************
  * Module Preprocessor Macros
  *******************************************************************************/
@@ -276,7 +302,11 @@ SERVICE_RTOS_ErrStat_t SERVICE_RTOS_Notify(RTOS_TaskHandle_t arg_TaskToNotify_t,
         } 
         else if(LIB_CONSTANTS_ENABLED == arg_u8IsFromISR)
         {
-            vTaskNotifyGiveFromISR(arg_TaskToNotify_t, NULL);
+            BaseType_t local_HigherPriorityTaskWoken = pdFALSE;
+            vTaskNotifyGiveFromISR(arg_TaskToNotify_t, &local_HigherPriorityTaskWoken);
+
+            // switch to the notified task as soon as the ISR returns instead of waiting for the next tick
+            portYIELD_FROM_ISR(local_HigherPriorityTaskWoken);
         }
         else
         {
@@ -307,6 +337,64 @@ SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentMSTime(uint32_t* arg_pu32CurrentTime)
     return local_ErrStatus;
 }
 
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentUSTime(uint32_t* arg_pu32CurrentTime)
+{
+    SERVICE_RTOS_ErrStat_t local_ErrStatus = SERVICE_RTOS_STAT_OK;
+    TickType_t local_TickCount = 0;
+    uint32_t local_u32SysTickCount = 0;
+    uint32_t local_u32PendingTicks = 0;
+
+    if(NULL != arg_pu32CurrentTime)
+    {
+        // the systick counter is reset every tick, read it again if a tick happened in between
+        do
+        {
+            local_TickCount = xTaskGetTickCount();
+            local_u32SysTickCount = (uint32_t)SysTick->CNT;
+            local_u32PendingTicks = 0;
+
+            // the counter restarted but the tick interrupt didn't run yet (called from an ISR or a critical section),
+            // the counter is read again as the first read may be from before the restart
+            if(SysTick->SR & SERVICE_RTOS_SYSTICK_CNTIF)
+            {
+                local_u32SysTickCount = (uint32_t)SysTick->CNT;
+                local_u32PendingTicks = 1;
+            }
+        } while (local_TickCount != xTaskGetTickCount());
+
+        *arg_pu32CurrentTime = (local_TickCount + local_u32PendingTicks) * (1000000 / configTICK_RATE_HZ) + local_u32SysTickCount / (configCPU_CLOCK_HZ / 1000000);
+    }
+    else
+    {
+        local_ErrStatus = SERVICE_RTOS_STAT_INVALID_PARAMS;
+    }
+
+    return local_ErrStatus;
+}
+
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_EnterCritical(void)
+{
+    taskENTER_CRITICAL();
+
+    return SERVICE_RTOS_STAT_OK;
+}
+
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ExitCritical(void)
+{
+    taskEXIT_CRITICAL();
+
+    return SERVICE_RTOS_STAT_OK;
+}
+
 /**
  * 
  */
@@ -326,6 +414,215 @@ SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetCurrentTaskHandle(RTOS_TaskHandle_t* arg_
     return local_ErrStatus;
 }
 
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetIdleTime(uint32_t* arg_pu32IdleTimeUS, uint32_t* arg_pu32TotalTimeUS)
+{
+    SERVICE_RTOS_ErrStat_t local_ErrStatus = SERVICE_RTOS_STAT_OK;
+
+    if(NULL != arg_pu32IdleTimeUS && NULL != arg_pu32TotalTimeUS)
+    {
+        *arg_pu32IdleTimeUS = ulTaskGetIdleRunTimeCounter();
+        *arg_pu32TotalTimeUS = SERVICE_RTOS_RunTimeCounter();
+    }
+    else
+    {
+        local_ErrStatus = SERVICE_RTOS_STAT_INVALID_PARAMS;
+    }
+
+    return local_ErrStatus;
+}
+
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CreateMailbox(uint16_t arg_u16ElementSize, void* arg_pStorage, RTOS_Mailbox_t* arg_pMailbox)
+{
+    SERVICE_RTOS_ErrStat_t local_ErrStatus = SERVICE_RTOS_STAT_OK;
+    uint8_t i = 0;
+
+    if(0 == arg_u16ElementSize || NULL == arg_pStorage || NULL == arg_pMailbox)
+    {
+        local_ErrStatus = SERVICE_RTOS_STAT_INVALID_PARAMS;
+    }
+    else
+    {
+        arg_pMailbox->pBuffers = (uint8_t*)arg_pStorage;
+        arg_pMailbox->elementSize = arg_u16ElementSize;
+        arg_pMailbox->writeSequence = 0;
+        arg_pMailbox->consumer = NULL;
+        for(i = 0; i < SERVICE_RTOS_MAILBOX_BUFFERS; i++)
+        {
+            arg_pMailbox->sequence[i] = 0;
+        }
+
+        // each side owns one buffer, the third one is swapped between them
+        arg_pMailbox->writeIndex = 0;
+        arg_pMailbox->state = 1;
+        arg_pMailbox->readIndex = 2;
+    }
+
+    return local_ErrStatus;
+}
+
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetMailboxWriteBuffer(void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox)
+{
+    SERVICE_RTOS_ErrStat_t local_ErrStatus = SERVICE_RTOS_STAT_OK;
+
+    if(NULL == arg_ppItem || NULL == arg_pMailbox)
+    {
+        local_ErrStatus = SERVICE_RTOS_STAT_INVALID_PARAMS;
+    }
+    else
+    {
+        *arg_ppItem = (void*)&arg_pMailbox->pBuffers[arg_pMailbox->writeIndex * arg_pMailbox->elementSize];
+    }
+
+    return local_ErrStatus;
+}
+
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_PublishMailbox(RTOS_Mailbox_t* arg_pMailbox)
+{
+    SERVICE_RTOS_ErrStat_t local_ErrStatus = SERVICE_RTOS_STAT_OK;
+    uint32_t local_u32OldState = 0;
+    RTOS_TaskHandle_t local_Consumer = NULL;
+
+    if(NULL == arg_pMailbox)
+    {
+        local_ErrStatus = SERVICE_RTOS_STAT_INVALID_PARAMS;
+    }
+    else
+    {
+        arg_pMailbox->writeSequence++;
+        arg_pMailbox->sequence[arg_pMailbox->writeIndex] = arg_pMailbox->writeSequence;
+
+        // swap the written buffer with the middle one in one atomic instruction (amoswap), the reader sees either the
+        // previous item or this one whole. the old middle buffer, read or not, is the next one to write
+        local_u32OldState = __atomic_exchange_n(&arg_pMailbox->state, (uint32_t)arg_pMailbox->writeIndex | SERVICE_RTOS_MAILBOX_FRESH, __ATOMIC_ACQ_REL);
+        arg_pMailbox->writeIndex = (uint8_t)(local_u32OldState & SERVICE_RTOS_MAILBOX_INDEX_MASK);
+
+        // wake the reader waiting in SERVICE_RTOS_WaitForMailbox
+        local_Consumer = __atomic_load_n(&arg_pMailbox->consumer, __ATOMIC_ACQUIRE);
+        if(NULL != local_Consumer)
+        {
+            SERVICE_RTOS_Notify(local_Consumer, LIB_CONSTANTS_DISABLED);
+        }
+    }
+
+    return local_ErrStatus;
+}
+
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_WriteToMailbox(const void * arg_pItemToWrite, RTOS_Mailbox_t* arg_pMailbox)
+{
+    SERVICE_RTOS_ErrStat_t local_ErrStatus = SERVICE_RTOS_STAT_OK;
+    void* local_pBuffer = NULL;
+
+    if(NULL == arg_pItemToWrite || NULL == arg_pMailbox)
+    {
+        local_ErrStatus = SERVICE_RTOS_STAT_INVALID_PARAMS;
+    }
+    else
+    {
+        SERVICE_RTOS_GetMailboxWriteBuffer(&local_pBuffer, arg_pMailbox);
+        memcpy(local_pBuffer, arg_pItemToWrite, arg_pMailbox->elementSize);
+        local_ErrStatus = SERVICE_RTOS_PublishMailbox(arg_pMailbox);
+    }
+
+    return local_ErrStatus;
+}
+
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ReadFromMailbox(void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox, uint32_t* arg_pu32Sequence)
+{
+    SERVICE_RTOS_ErrStat_t local_ErrStatus = SERVICE_RTOS_STAT_OK;
+    uint32_t local_u32OldState = 0;
+
+    if(NULL == arg_ppItem || NULL == arg_pMailbox)
+    {
+        local_ErrStatus = SERVICE_RTOS_STAT_INVALID_PARAMS;
+    }
+    else
+    {
+        // only the reader clears the flag, so it can't be lost between the check and the swap
+        if(__atomic_load_n(&arg_pMailbox->state, __ATOMIC_ACQUIRE) & SERVICE_RTOS_MAILBOX_FRESH)
+        {
+            // give back the buffer read last time and take the newest item
+            local_u32OldState = __atomic_exchange_n(&arg_pMailbox->state, (uint32_t)arg_pMailbox->readIndex, __ATOMIC_ACQ_REL);
+            arg_pMailbox->readIndex = (uint8_t)(local_u32OldState & SERVICE_RTOS_MAILBOX_INDEX_MASK);
+        }
+        else
+        {
+            local_ErrStatus = SERVICE_RTOS_STAT_MAILBOX_EMPTY;
+        }
+
+        *arg_ppItem = (void*)&arg_pMailbox->pBuffers[arg_pMailbox->readIndex * arg_pMailbox->elementSize];
+        if(NULL != arg_pu32Sequence)
+        {
+            *arg_pu32Sequence = arg_pMailbox->sequence[arg_pMailbox->readIndex];
+        }
+    }
+
+    return local_ErrStatus;
+}
+
+/**
+ * 
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_WaitForMailbox(uint32_t arg_u32TimeoutMS, void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox, uint32_t* arg_pu32Sequence)
+{
+    SERVICE_RTOS_ErrStat_t local_ErrStatus = SERVICE_RTOS_STAT_OK;
+    uint32_t local_u32StartMS = 0;
+    uint32_t local_u32NowMS = 0;
+
+    if(NULL == arg_ppItem || NULL == arg_pMailbox)
+    {
+        local_ErrStatus = SERVICE_RTOS_STAT_INVALID_PARAMS;
+    }
+    else
+    {
+        // register before checking, an item published after the check then leaves a notification behind
+        __atomic_store_n(&arg_pMailbox->consumer, xTaskGetCurrentTaskHandle(), __ATOMIC_RELEASE);
+        SERVICE_RTOS_CurrentMSTime(&local_u32StartMS);
+
+        // the notification may also come from something else than the mailbox, check again until the timeout
+        while(SERVICE_RTOS_STAT_MAILBOX_EMPTY == (local_ErrStatus = SERVICE_RTOS_ReadFromMailbox(arg_ppItem, arg_pMailbox, arg_pu32Sequence)))
+        {
+            SERVICE_RTOS_CurrentMSTime(&local_u32NowMS);
+            if(arg_u32TimeoutMS <= local_u32NowMS - local_u32StartMS)
+            {
+                break;
+            }
+            SERVICE_RTOS_WaitForNotification(arg_u32TimeoutMS - (local_u32NowMS - local_u32StartMS));
+        }
+    }
+
+    return local_ErrStatus;
+}
+
+/**
+ * 
+ */
+uint32_t SERVICE_RTOS_RunTimeCounter(void)
+{
+    uint32_t local_u32Time = 0;
+
+    SERVICE_RTOS_CurrentUSTime(&local_u32Time);
+
+    return local_u32Time;
+}
+
 /*************** END OF FUNCTIONS ***************************************************************************/
  
 // to be the IdleTask (called when no other tasks are running)
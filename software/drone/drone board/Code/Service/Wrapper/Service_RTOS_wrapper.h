@@ -50,6 +50,13 @@
  * |                                                                    function 'SERVICE_RTOS_ReadFromBlockingQueue'.                  |
  * |    24/06/2023      1.0.0           Abdelrahman Mohamed Salem       added 'SERVICE_RTOS_CurrentMSTime'.                             |
  * |    26/06/2023      1.0.0           Abdelrahman Mohamed Salem       added 'SERVICE_RTOS_GetCurrentTaskHandle'.                      |
+ * |    17/10/2026      1.1.0           agent                           added 'SERVICE_RTOS_CurrentUSTime'.                             |
+ * |    17/10/2026      1.2.0           agent                           added 'SERVICE_RTOS_EnterCritical',                             |
+ * |                                                                    'SERVICE_RTOS_ExitCritical'.                                    |
+ * |    17/10/2026      1.2.0           agent                           made 'SERVICE_RTOS_Notify' yield from ISR.                      |
+ * |    17/10/2026      1.3.0           agent                           added 'SERVICE_RTOS_GetIdleTime'.                               |
+ * |    17/10/2026      1.4.0           agent                           added the latest item mailbox 'RTOS_Mailbox_t' (triple buffer)  |
+ * |                                                                    and its functions.                                              |
  * --------------------------------------------------------------------------------------------------------------------------------------
  */
 
@@ -75,6 +82,11 @@
  * Preprocessor Constants
  *******************************************************************************/
 
+/**
+ * @brief: number of items a mailbox holds, the one being written, the newest published and the one being read
+ */
+#define SERVICE_RTOS_MAILBOX_BUFFERS    (3)
+
 /******************************************************************************
  * Configuration Constants
  *******************************************************************************/
@@ -111,8 +123,25 @@ typedef enum {
   SERVICE_RTOS_STAT_QUEUE_FULL,
   SERVICE_RTOS_STAT_QUEUE_EMPTY,
   SERVICE_RTOS_STAT_QUEUE_NOT_EMPTY,
+  SERVICE_RTOS_STAT_MAILBOX_EMPTY,
 } SERVICE_RTOS_ErrStat_t;
 
+/**
+ * @brief: single producer, single consumer mailbox that only keeps the newest item (triple buffer), the producer never
+ *         waits for the consumer and a new item overwrites the one that wasn't read yet
+ * @note: the fields are private to "Service_RTOS_wrapper.c", the storage of the items is given by the user
+*/
+typedef struct {
+  uint8_t* pBuffers;                                /**< storage of the SERVICE_RTOS_MAILBOX_BUFFERS items */
+  uint16_t elementSize;                             /**< size of an item in bytes */
+  volatile uint32_t state;                          /**< buffer of the newest item, with a flag when it wasn't read yet */
+  volatile uint32_t sequence[SERVICE_RTOS_MAILBOX_BUFFERS];  /**< sequence number of the item in each buffer */
+  uint32_t writeSequence;                           /**< sequence number of the last published item (producer only) */
+  uint8_t writeIndex;                               /**< buffer being written (producer only) */
+  uint8_t readIndex;                                /**< buffer being read (consumer only) */
+  RTOS_TaskHandle_t consumer;                       /**< task notified on publish, set by SERVICE_RTOS_WaitForMailbox */
+} RTOS_Mailbox_t;
+
 /******************************************************************************
  * Variables
  *******************************************************************************/
@@ -475,7 +504,7 @@ SERVICE_RTOS_ErrStat_t SERVICE_RTOS_WaitForNotification(uint32_t arg_u32TimeoutM
  *  \b Description                              :       this functions is used as a wrapper function to notify a task to wake up from block state.
  *  @param  arg_TaskToNotify_t [IN]             :       which task to notify to wakeup.
  *  @param  arg_u8IsFromISR [IN]                :       is this function being called from ISR or not, refer to @LIB_CONSTANTS_DriverStates_t in "constants.h".
- *  @note                                       :       None.
+ *  @note                                       :       when called from ISR and the notified task has higher priority than the interrupted one, a context switch is requested on ISR exit.
  *  \b PRE-CONDITION                            :       None.
  *  \b POST-CONDITION                           :       None.
  *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
@@ -590,6 +619,105 @@ SERVICE_RTOS_ErrStat_t SERVICE_RTOS_Notify(RTOS_TaskHandle_t arg_TaskToNotify_t,
 SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentMSTime(uint32_t* arg_pu32CurrentTime);
 
 
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentUSTime(uint32_t* arg_pu32CurrentTime);
+ *  \b Description                              :       this functions is used as a wrapper function to get how many Microseconds passed since the schedular start running.
+ *  @param  arg_pu32CurrentTime [OUT]           :       The amount of time in Microsecond the schedular has been running for.
+ *  @note                                       :       the sub tick part is taken from the systick counter that drives the RTOS tick, the value wraps around every ~71 minutes.
+ *                                                      safe to call from an ISR or a critical section as long as the tick interrupt isn't held back for more than a tick.
+ *  \b PRE-CONDITION                            :       schedular is running.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentMSTime(uint32_t* arg_pu32CurrentTime)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "Service_RTOS_wrapper.h"
+ * 
+ * void task2_task(void *pvParameters)
+ * {
+ *   while (1)
+ *   {
+ *       uint32_t currentTime = 0;
+ *       SERVICE_RTOS_CurrentUSTime(&currentTime);
+ *      
+ *   }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentUSTime(uint32_t* arg_pu32CurrentTime);
+
+
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_EnterCritical(void);
+ *  \b Description                              :       this functions is used as a wrapper function to enter a critical section where neither interrupts nor context switches can happen.
+ *  @note                                       :       must be paired with SERVICE_RTOS_ExitCritical, keep the section as short as possible, calls can be nested.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       interrupts are disabled.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ExitCritical(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "Service_RTOS_wrapper.h"
+ * 
+ * void task2_task(void *pvParameters)
+ * {
+ *   while (1)
+ *   {
+ *       SERVICE_RTOS_EnterCritical();
+ *       // access data shared with an ISR
+ *       SERVICE_RTOS_ExitCritical();
+ *   }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_EnterCritical(void);
+
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ExitCritical(void);
+ *  \b Description                              :       this functions is used as a wrapper function to leave a critical section entered by SERVICE_RTOS_EnterCritical.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       SERVICE_RTOS_EnterCritical is called before.
+ *  \b POST-CONDITION                           :       interrupts are enabled again when leaving the outermost section.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_EnterCritical(void)
+ *
+ *  \b Example:
+ * @code
+ * 
+ *          refer to SERVICE_RTOS_EnterCritical
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ExitCritical(void);
+
+
 /**
  *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetCurrentTaskHandle(RTOS_TaskHandle_t* arg_pTaskHandle);
  *  \b Description                              :       this functions is used as a wrapper function to get the handle of the current executing task.
@@ -642,5 +770,256 @@ SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentMSTime(uint32_t* arg_pu32CurrentTime)
  */
 SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetCurrentTaskHandle(RTOS_TaskHandle_t* arg_pTaskHandle);
 
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetIdleTime(uint32_t* arg_pu32IdleTimeUS, uint32_t* arg_pu32TotalTimeUS);
+ *  \b Description                              :       this functions is used as a wrapper function to get the time spent in the idle task and the total run time
+ *                                                      from the RTOS run time stats, both in Microsecond.
+ *  @param  arg_pu32IdleTimeUS [OUT]            :       the time the idle task has been running for.
+ *  @param  arg_pu32TotalTimeUS [OUT]           :       the time the schedular has been running for.
+ *  @note                                       :       the load over a window is the difference of two calls, both values wrap around every ~71 minutes.
+ *  \b PRE-CONDITION                            :       schedular is running.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentUSTime(uint32_t* arg_pu32CurrentTime)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "Service_RTOS_wrapper.h"
+ * 
+ * uint32_t idleBefore = 0, totalBefore = 0, idle = 0, total = 0;
+ * SERVICE_RTOS_GetIdleTime(&idleBefore, &totalBefore);
+ * SERVICE_RTOS_BlockFor(1000);
+ * SERVICE_RTOS_GetIdleTime(&idle, &total);
+ * printf("idle %lu%%\r\n", 100 * (idle - idleBefore) / (total - totalBefore));
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetIdleTime(uint32_t* arg_pu32IdleTimeUS, uint32_t* arg_pu32TotalTimeUS);
+
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CreateMailbox(uint16_t arg_u16ElementSize, void* arg_pStorage, RTOS_Mailbox_t* arg_pMailbox);
+ *  \b Description                              :       this functions is used to create a mailbox that hands the newest item from one task to another without
+ *                                                      a queue, the reader always gets the latest item and the items it didn't read are overwritten.
+ *  @param  arg_u16ElementSize [IN]             :       the size of an item in bytes.
+ *  @param  arg_pStorage [IN]                   :       storage of SERVICE_RTOS_MAILBOX_BUFFERS items (an array of 3 items), owned by the mailbox from now on.
+ *  @param  arg_pMailbox [OUT]                  :       the mailbox to create.
+ *  @note                                       :       the mailbox takes no lock, it is only safe with one task writing and one task reading it.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       the mailbox is empty until the first item is published.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ReadFromMailbox(void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox, uint32_t* arg_pu32Sequence)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "Service_RTOS_wrapper.h"
+ * 
+ * SensorFusionDataItem_t global_StateStorage[SERVICE_RTOS_MAILBOX_BUFFERS];
+ * RTOS_Mailbox_t global_StateMailbox_t;
+ * 
+ * int main() {
+ *   SERVICE_RTOS_CreateMailbox(sizeof(SensorFusionDataItem_t), global_StateStorage, &global_StateMailbox_t);
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CreateMailbox(uint16_t arg_u16ElementSize, void* arg_pStorage, RTOS_Mailbox_t* arg_pMailbox);
+
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetMailboxWriteBuffer(void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox);
+ *  \b Description                              :       this functions is used by the writer of the mailbox to get the buffer in which it builds the next item,
+ *                                                      the item is handed to the reader by SERVICE_RTOS_PublishMailbox without being copied.
+ *  @param  arg_ppItem [OUT]                    :       the buffer of the next item, it holds an older item that may not be fully overwritten.
+ *  @param  arg_pMailbox [IN]                   :       the mailbox to write.
+ *  @note                                       :       the buffer changes after every publish, get it again before writing the next item.
+ *  \b PRE-CONDITION                            :       the mailbox is created.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_PublishMailbox(RTOS_Mailbox_t* arg_pMailbox)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "Service_RTOS_wrapper.h"
+ * 
+ * void task2_task(void *pvParameters)
+ * {
+ *   SensorFusionDataItem_t* state = NULL;
+ *   while (1)
+ *   {
+ *       SERVICE_RTOS_GetMailboxWriteBuffer((void**)&state, &global_StateMailbox_t);
+ *       state->roll = 0;
+ *       SERVICE_RTOS_PublishMailbox(&global_StateMailbox_t);
+ *   }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetMailboxWriteBuffer(void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox);
+
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_PublishMailbox(RTOS_Mailbox_t* arg_pMailbox);
+ *  \b Description                              :       this functions is used by the writer of the mailbox to hand the item built in the write buffer to the
+ *                                                      reader, it overwrites the previous item if it wasn't read yet.
+ *  @param  arg_pMailbox [IN]                   :       the mailbox to publish into.
+ *  @note                                       :       it never blocks, the task waiting in SERVICE_RTOS_WaitForMailbox is notified, not to be called from an ISR.
+ *  \b PRE-CONDITION                            :       the item is written in the buffer given by SERVICE_RTOS_GetMailboxWriteBuffer.
+ *  \b POST-CONDITION                           :       the item gets the next sequence number, the write buffer is changed.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetMailboxWriteBuffer(void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox)
+ *
+ *  \b Example:
+ * @code
+ * 
+ *          refer to SERVICE_RTOS_GetMailboxWriteBuffer
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_PublishMailbox(RTOS_Mailbox_t* arg_pMailbox);
+
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_WriteToMailbox(const void * arg_pItemToWrite, RTOS_Mailbox_t* arg_pMailbox);
+ *  \b Description                              :       this functions is used by the writer of the mailbox to copy an item into the write buffer and publish it.
+ *  @param  arg_pItemToWrite [IN]               :       the item to copy, of the size given to SERVICE_RTOS_CreateMailbox.
+ *  @param  arg_pMailbox [IN]                   :       the mailbox to write.
+ *  @note                                       :       for a writer that keeps its own copy of the item between two writes, refer to SERVICE_RTOS_PublishMailbox.
+ *  \b PRE-CONDITION                            :       the mailbox is created.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_PublishMailbox(RTOS_Mailbox_t* arg_pMailbox)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "Service_RTOS_wrapper.h"
+ * 
+ * SensorFusionDataItem_t state = {0};
+ * SERVICE_RTOS_WriteToMailbox(&state, &global_StateMailbox_t);
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_WriteToMailbox(const void * arg_pItemToWrite, RTOS_Mailbox_t* arg_pMailbox);
+
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ReadFromMailbox(void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox, uint32_t* arg_pu32Sequence);
+ *  \b Description                              :       this functions is used by the reader of the mailbox to take the newest item without copying it.
+ *  @param  arg_ppItem [OUT]                    :       the newest item, it stays valid and isn't changed by the writer until the next read.
+ *  @param  arg_pMailbox [IN]                   :       the mailbox to read.
+ *  @param  arg_pu32Sequence [OUT]              :       sequence number of the item (1 for the first item published), a jump of more than one tells
+ *                                                      how many items were overwritten before being read. can be NULL.
+ *  @note                                       :       it never blocks, when no item was published since the last read the previous item is given again
+ *                                                      with SERVICE_RTOS_STAT_MAILBOX_EMPTY (sequence number 0 before the first item).
+ *  \b PRE-CONDITION                            :       the mailbox is created.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_WaitForMailbox(uint32_t arg_u32TimeoutMS, void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox, uint32_t* arg_pu32Sequence)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "Service_RTOS_wrapper.h"
+ * 
+ * SensorFusionDataItem_t* state = NULL;
+ * if(SERVICE_RTOS_STAT_OK == SERVICE_RTOS_ReadFromMailbox((void**)&state, &global_StateMailbox_t, NULL))
+ * {
+ *   // use state->roll, ...
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ReadFromMailbox(void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox, uint32_t* arg_pu32Sequence);
+
+/**
+ *  \b function                                 :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_WaitForMailbox(uint32_t arg_u32TimeoutMS, void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox, uint32_t* arg_pu32Sequence);
+ *  \b Description                              :       this functions is used by the reader of the mailbox to sleep until a new item is published and take it
+ *                                                      without copying it.
+ *  @param  arg_u32TimeoutMS [IN]               :       the longest time to wait for a new item in Millisecond.
+ *  @param  arg_ppItem [OUT]                    :       refer to SERVICE_RTOS_ReadFromMailbox.
+ *  @param  arg_pMailbox [IN]                   :       the mailbox to read.
+ *  @param  arg_pu32Sequence [OUT]              :       refer to SERVICE_RTOS_ReadFromMailbox. can be NULL.
+ *  @note                                       :       the calling task becomes the one notified by SERVICE_RTOS_PublishMailbox, it uses the notification of
+ *                                                      the task like SERVICE_RTOS_WaitForNotification.
+ *  \b PRE-CONDITION                            :       the mailbox is created, schedular is running.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       it return one of error states indicating whether a failure or success happened (refer to @SERVICE_RTOS_ErrStat_t in "Service_RTOS_wrapper.h")
+ *  @see                                        :       SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ReadFromMailbox(void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox, uint32_t* arg_pu32Sequence)
+ *
+ *  \b Example:
+ * @code
+ * 
+ * #include "Service_RTOS_wrapper.h"
+ * 
+ * void task2_task(void *pvParameters)
+ * {
+ *   RawSensorDataItem_t* raw = NULL;
+ *   while (1)
+ *   {
+ *       if(SERVICE_RTOS_STAT_OK == SERVICE_RTOS_WaitForMailbox(1000, (void**)&raw, &global_RawMailbox_t, NULL))
+ *       {
+ *           // use raw->Acc, ...
+ *       }
+ *   }
+ * }
+ * 
+ * @endcode
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> agent    </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_WaitForMailbox(uint32_t arg_u32TimeoutMS, void** arg_ppItem, RTOS_Mailbox_t* arg_pMailbox, uint32_t* arg_pu32Sequence);
+
+/**
+ * @brief: clock of the RTOS run time stats in Microsecond (portGET_RUN_TIME_COUNTER_VALUE in "FreeRTOSConfig.h"), not to
+ *         be called by the application
+ */
+uint32_t SERVICE_RTOS_RunTimeCounter(void);
+
 /*** End of File **************************************************************/
 #endif /*SERVICE_RTOS_WRAPPER_H_*/
@@ -8,6 +8,7 @@
 #include "nano_gfx.h"
 #include <stdio.h>
 #include "math.h"
+#include "comm_pack.h"
 
 
 /**
@@ -32,6 +33,19 @@
 #define FLYING_MODE_LANDING 3
 #define FLYING_MODE_STATUS 4
 
+// period of the commands sent in stable mode in ms, the telemetry of the drone comes back in their acknowledges
+#define COMMAND_PERIOD_MS 20
+
+// retransmits of the commands, the delay is an index of setRetries() ((index + 1) * 250 us), 500 us is the shortest one an
+// acknowledge with a payload fits in at 1 Mbps, the retransmits of a command must end within half of its period
+#define RETRY_DELAY_MIN 1
+#define RETRY_DELAY_MAX 5
+#define RETRY_COUNT_MIN 3
+#define RETRY_COUNT_MAX 15
+#define RETRY_BUDGET_US (COMMAND_PERIOD_MS * 1000UL / 2)
+#define RETRY_AIRTIME_US 300     // sending a command and waiting for its acknowledge without the delay
+#define RETRY_CLEAN_SENDS 50     // commands acked in a row before the delay steps down
+
 
 
 #define CONACTENATE(first, second) first second
@@ -162,6 +176,23 @@ typedef struct __attribute__((packed)){
 
 data_t data; // the variable through which we will send and recieve data
 
+/**
+* @brief: packets sent and received over the air, the messages are packed with "comm_pack.h" (same copy as the drone boards)
+*/
+uint8_t radioPayload[LIB_COMM_PACK_RADIO_LEN];
+LIB_COMM_PACK_InfoState_t infoState; // last keyframe of the telemetry received from the drone
+
+/**
+* @brief: state of the radio link, the drone only sees the commands that arrive so the retransmits are counted here and sent
+*         with the number of the command in the link byte of every command, the drone answers with the quality it measured
+*/
+uint8_t linkByte = 0;                 // retransmits of the last command and number of the next one
+uint8_t linkQuality = 0;              // percentage of acked commands the drone reported in its last link message
+uint16_t retryAverage = 0;            // moving average of the retransmits times 8
+uint8_t retryDelay = RETRY_DELAY_MIN;
+uint8_t retryCount = RETRY_COUNT_MIN;
+uint8_t retryCleanSends = 0;
+
 /**
 * @brief: global counter to count how many sample reading we get from the buttons
 */
@@ -207,6 +238,7 @@ static void drawStatus(float distanceToOrigin, float altitude, float temperature
   sprite.draw();
   ssd1306_printFixed(0,  32, "Battery:       %", STYLE_NORMAL);
   ssd1306_printFixed(0,  40, "Flying Time:", STYLE_NORMAL);
+  ssd1306_printFixed(0,  48, "Link:          %", STYLE_NORMAL);
   updateStatus(distanceToOrigin, altitude, temperature, batteryCharge, 0);
 
 }
@@ -246,6 +278,11 @@ static void updateStatus(float distanceToOrigin, float altitude, float temperatu
   sprintf(buff, "%02d:%02d", flyingTimeInSeconds / 60, flyingTimeInSeconds % 60);
   ssd1306_setCursor(78, 40);
   ssd1306_print(buff);
+
+  // write link quality
+  sprintf(buff, "%3d", linkQuality);
+  ssd1306_setCursor(78, 48);
+  ssd1306_print(buff);
 }
 
 
@@ -264,6 +301,83 @@ static void textDemo()
 
 
 
+/**
+* @brief: adapts the retransmits to the link after every command, the count follows the average retransmits and the delay backs off
+*         after a lost command (busy channel), both only step back after a run of acked commands and are bounded so the retransmits
+*         of a command never take more than RETRY_BUDGET_US
+*/
+static void adaptRetries(bool acked, uint8_t retransmits)
+{
+  uint8_t delayIndex = retryDelay;
+  uint8_t count = retryCount;
+  uint8_t target;
+
+  retryAverage = retryAverage - (retryAverage >> 3) + retransmits;
+
+  if(!acked)
+  {
+    retryCleanSends = 0;
+    if(delayIndex < RETRY_DELAY_MAX)
+      delayIndex++;
+  }
+
+  // twice the average retransmits (retryAverage / 8) and some margin
+  target = (retryAverage >> 2) + RETRY_COUNT_MIN;
+  if(target > RETRY_COUNT_MAX)
+    target = RETRY_COUNT_MAX;
+  if(target > count)
+    count = target;
+
+  if(acked && ++retryCleanSends >= RETRY_CLEAN_SENDS)
+  {
+    retryCleanSends = 0;
+    count = target;
+    if(delayIndex > RETRY_DELAY_MIN)
+      delayIndex--;
+  }
+
+  // the first send and the retransmits must fit in the budget
+  uint8_t budget = RETRY_BUDGET_US / ((delayIndex + 1) * 250UL + RETRY_AIRTIME_US) - 1;
+  if(count > budget)
+    count = budget;
+
+  if(delayIndex != retryDelay || count != retryCount)
+  {
+    retryDelay = delayIndex;
+    retryCount = count;
+    myRadio.setRetries(retryDelay, retryCount);
+  }
+}
+
+/**
+* @brief: packs the move command in 'data' and sends it, only the LIB_COMM_PACK_STICKS_LEN packed bytes go over the air (dynamic payload length)
+* @note: the drone answers in the payload of the acknowledge, it's read from the RX FIFO at the end of loop()
+*/
+static void sendMove()
+{
+  LIB_COMM_PACK_Sticks_t sticks;
+
+  sticks.roll = data.data.move.roll;
+  sticks.pitch = data.data.move.pitch;
+  sticks.thrust = data.data.move.thurst;
+  sticks.yaw = data.data.move.yaw;
+  sticks.flags = (data.data.move.startDrone ? LIB_COMM_PACK_FLAG_START : 0)
+               | (data.data.move.turnOnLeds ? LIB_COMM_PACK_FLAG_LEDS : 0)
+               | (data.data.move.playMusic ? LIB_COMM_PACK_FLAG_MUSIC : 0);
+  sticks.link = linkByte;
+
+  uint8_t len = LIB_COMM_PACK_u8PackSticks(&sticks, radioPayload);
+  bool acked = myRadio.write(radioPayload, len);
+  uint8_t retransmits = myRadio.getARC();
+
+  // the next command carries the retransmits of this one, acked or not, and the next number, the drone counts the commands
+  // that didn't arrive from the gaps in the numbers so a command it got without the acknowledge coming back isn't lost
+  linkByte = (uint8_t)((((linkByte >> LIB_COMM_PACK_LINK_NUMBER_SHIFT) + 1) << LIB_COMM_PACK_LINK_NUMBER_SHIFT)
+                       | (retransmits & LIB_COMM_PACK_LINK_RETRANSMITS_MASK));
+
+  adaptRetries(acked, retransmits);
+}
+
 /**
 * @brief: used to get a god state of button
 */
@@ -304,11 +418,18 @@ void setup()
 
   // intialize nrf24l01
   myRadio.begin();  
-  myRadio.setChannel(115); 
+  myRadio.setChannel(115);      // NRF_RF_CHANNEL of the app board 
   myRadio.setPALevel(RF24_PA_MAX);
   myRadio.setDataRate( RF24_1MBPS ); 
+  myRadio.setPayloadSize(LIB_COMM_PACK_RADIO_LEN);
+  myRadio.enableDynamicPayloads();
+  myRadio.enableAckPayload();
   myRadio.openWritingPipe(addresses[0]);
   myRadio.openReadingPipe(1, addresses[1]);
+  myRadio.setRetries(retryDelay, retryCount);
+
+  // the telemetry comes in the acknowledges of the commands so the radio never switches to listening
+  myRadio.stopListening();
 
   delay(1000);
 
@@ -432,9 +553,7 @@ void loop()
     data.data.move.turnOnLeds = rightJoyStickPressed;
     data.data.move.playMusic = leftJoyStickPressed;
     
-    myRadio.stopListening();
-    myRadio.write(&data, sizeof(data));
-    myRadio.startListening(); 
+    sendMove();
   }
 
   // update of the shown status every 1 second
@@ -446,11 +565,11 @@ void loop()
     updateStatus(distanceToOrigin, altitude, temperature, batteryCharge, ++currentFlyingSessionInSeconds);
   }
 
-  // send commands to the in case of stable mode fly every 50 ms
+  // send commands to the in case of stable mode fly every COMMAND_PERIOD_MS
   if(flyingMode == FLYING_MODE_STABLE)
   {
 
-    if(millis() - commandTime >= 50)
+    if(millis() - commandTime >= COMMAND_PERIOD_MS)
     {
 
       // get the current state of buttons being pressed
@@ -503,17 +622,11 @@ void loop()
       // Serial.println(buff);
       
       Serial.println("SECTION1 --- 2");
-      myRadio.stopListening();
-      
-      Serial.println("SECTION1 --- 3");
-      myRadio.write(&data, sizeof(data));
-      
-      Serial.println("SECTION1 --- 4");
-      myRadio.startListening();
+      sendMove();
 
-      Serial.println("SECTION1 --- 5");
+      Serial.println("SECTION1 --- 3");
     }
-    else if(millis() - commandTime >= 25 && !readingsTaken)
+    else if(millis() - commandTime >= COMMAND_PERIOD_MS / 2 && !readingsTaken)
     {
       // always get the readings
       rightJoyStickSWStateRC = getAverageReadings(50, RIGHT_JOYSTICK_SW_PIN);
@@ -524,21 +637,40 @@ void loop()
    
   }
 
-  // read incoming traffic if any
+  // read the telemetry that came in the acknowledge of the last command if any
   if(myRadio.available())
   {
     Serial.println("SECTION2 --- 1");
-    myRadio.read(&data, sizeof(data));
+    // the width of the payload comes with the packet, 0 means it was corrupted and already flushed
+    uint8_t payloadLen = myRadio.getDynamicPayloadSize();
+    if(payloadLen > sizeof(radioPayload))
+    {
+      myRadio.flush_rx();
+      payloadLen = 0;
+    }
+    else if(payloadLen)
+    {
+      myRadio.read(radioPayload, payloadLen);
+    }
     Serial.println("SECTION2 --- 1");
     // char buff[100];
-    // sprintf(buff, "type = %d", data.type);
+    // sprintf(buff, "type = %d", radioPayload[0]);
     // Serial.println(buff);
 
-    // update current state
-    temperature = data.data.info.temperature;
-    batteryCharge = data.data.info.batteryCharge;
-    altitude = data.data.info.altitude;
-    distanceToOrigin = data.data.info.distanceToOrigin;
+    // update current state, a message of a lost keyframe is skipped
+    LIB_COMM_PACK_Info_t info;
+    LIB_COMM_PACK_Link_t link;
+    if(payloadLen && LIB_COMM_PACK_u8UnpackInfo(&infoState, radioPayload, payloadLen, &info))
+    {
+      temperature = info.temperature;
+      batteryCharge = info.batteryCharge;
+      altitude = info.altitude;
+      distanceToOrigin = info.distanceToOrigin;
+    }
+    else if(payloadLen && LIB_COMM_PACK_u8UnpackLink(radioPayload, payloadLen, &link))
+    {
+      linkQuality = link.quality;
+    }
   }
 
 
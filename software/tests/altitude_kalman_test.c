@@ -0,0 +1,62 @@
+/*
+ * altitude_kalman_test: replays random barometer and acceleration samples, with the time step of a random FIFO batch
+ * length, through the scalar 2D altitude kalman filter and through the matrix based filter of the baseline on the
+ * baseline matrix library, and checks they give the same state and covariance within a tolerance
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/* the module is included to reach its static filter state */
+#include "SensorFusion.c"
+
+/* the baseline filter on the baseline matrix library (refer to host/altitude_kalman_baseline.c) */
+void altitude_kalman_baseline_init(void);
+void altitude_kalman_baseline_step(float measurement, float inertial_acc, float dt, int measured);
+void altitude_kalman_baseline_state(float* arg_pState);
+
+/* relative to the largest of the two values and at least 1 */
+#define TOLERANCE (1e-5)
+
+int main(void)
+{
+    enum { SAMPLES = 200000 };
+    altitude_kalman_t* kf = &global_AltitudeKalman_t;
+    unsigned long local_mismatches = 0, local_differing = 0;
+    double local_max = 0;
+
+    srand(1);
+    Altitude_Kalman_2D_init();
+    altitude_kalman_baseline_init();
+
+    for (int n = 0; n < SAMPLES; n++) {
+        float measurement = (rand() % 20000) / 10.0f;
+        float acceleration = (rand() % 2000 - 1000) / 10.0f;
+        int measured = (rand() % 4) == 0;
+        /* mostly the nominal batch, sometimes a shorter or longer one as the sensor task delivers them */
+        float dt = (rand() % 8) ? Ts : (1 + rand() % HAL_WRAPPER_IMU_BATCH_MAX) * (1000 * 1e-6f);
+
+        kalman_filter_2d(measurement, acceleration, dt, measured);
+        altitude_kalman_baseline_step(measurement, acceleration, dt, measured);
+
+        float scalar[6] = {kf->altitude, kf->vertical_velocity, kf->p00, kf->p01, kf->p10, kf->p11};
+        float matrix[6];
+        altitude_kalman_baseline_state(matrix);
+        for (int i = 0; i < 6; i++) {
+            double difference = fabs((double)scalar[i] - matrix[i]) / fmax(1, fmax(fabs(scalar[i]), fabs(matrix[i])));
+
+            local_differing += scalar[i] != matrix[i];
+            local_mismatches += !(difference <= TOLERANCE);
+            local_max = fmax(local_max, difference);
+        }
+    }
+
+    printf("altitude_kalman_test: %d samples, %lu values differing from the baseline filter, %lu out of tolerance "
+           "(max relative difference %g)\n", SAMPLES, local_differing, local_mismatches, local_max);
+    if (local_mismatches) {
+        printf("altitude_kalman_test: FAIL\n");
+        return 1;
+    }
+    printf("altitude_kalman_test: OK\n");
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * bmp_burst_test: runs the BMP280 driver against a model of the sensor registers behind MCAL_SPI_Transfer() and checks
+ * the SPI transfers it makes (one burst for the trimming, one for a temperature and pressure sample), the datasheet
+ * compensation example and random samples against the floating point compensation of the datasheet
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "BMP.h"
+#include "MCAL_SPI.h"
+#include "MCAL_wrapper.h"
+
+MCAL_CONFIG_SPI_t MCAL_CFG_BMPSPI;
+
+static uint8_t global_registers[256];
+static unsigned global_transfers, global_bytes;
+static int global_failures;
+
+#define CHECK(COND, ...) do { if (!(COND)) { global_failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+/* the first byte is the register with bit 7 set for a read, the sensor increments the register on each byte of a read */
+MCAL_SPI_ErrStat_t MCAL_SPI_Transfer(MCAL_CONFIG_SPI_t* arg_pDevice, const uint8_t* arg_pu8TxData, uint8_t* arg_pu8RxData, uint16_t arg_u16Len, uint32_t arg_u32TimeoutMS)
+{
+    uint8_t reg = arg_pu8TxData[0] | 0x80;
+
+    global_transfers++;
+    global_bytes += arg_u16Len;
+    if (!(arg_pu8TxData[0] & 0x80)) {
+        global_registers[reg] = arg_pu8TxData[1];
+        return MCAL_SPI_STAT_OK;
+    }
+    if (arg_pu8RxData) {
+        arg_pu8RxData[0] = 0;
+        for (int i = 1; i < arg_u16Len; i++) {
+            arg_pu8RxData[i] = global_registers[(uint8_t)(reg + i - 1)];
+        }
+    }
+    return MCAL_SPI_STAT_OK;
+}
+
+MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_DelayUS(uint32_t arg_u16US) { return 0; }
+
+/* trimming of the datasheet example (BMP280 datasheet, 8.2) */
+static const int global_trim[12] = {27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000};
+
+static void set_result(uint8_t reg, int32_t adc)
+{
+    global_registers[reg] = (uint8_t)(adc >> 12);
+    global_registers[reg + 1] = (uint8_t)(adc >> 4);
+    global_registers[reg + 2] = (uint8_t)(adc << 4);
+}
+
+/* floating point compensation of the datasheet (8.1), temperature in degrees and pressure in Pa */
+static double reference_temperature(int32_t adc_T, double* fine)
+{
+    double var1 = (adc_T / 16384.0 - global_trim[0] / 1024.0) * global_trim[1];
+    double var2 = (adc_T / 131072.0 - global_trim[0] / 8192.0) * (adc_T / 131072.0 - global_trim[0] / 8192.0) * global_trim[2];
+    *fine = var1 + var2;
+    return (var1 + var2) / 5120.0;
+}
+
+static double reference_pressure(int32_t adc_P, double fine)
+{
+    double var1 = fine / 2.0 - 64000.0, var2, p;
+    var2 = var1 * var1 * global_trim[8] / 32768.0;
+    var2 = var2 + var1 * global_trim[7] * 2.0;
+    var2 = var2 / 4.0 + global_trim[6] * 65536.0;
+    var1 = (global_trim[5] * var1 * var1 / 524288.0 + global_trim[4] * var1) / 524288.0;
+    var1 = (1.0 + var1 / 32768.0) * global_trim[3];
+    p = 1048576.0 - adc_P;
+    p = (p - var2 / 4096.0) * 6250.0 / var1;
+    var1 = global_trim[11] * p * p / 2147483648.0;
+    var2 = p * global_trim[10] / 32768.0;
+    return p + (var1 + var2 + global_trim[9]) / 16.0;
+}
+
+int main(void)
+{
+    enum { SAMPLES = 100000 };
+    double max_temperature = 0, max_pressure = 0;
+    float temperature, pressure;
+    unsigned init_transfers, sample_transfers, sample_bytes;
+
+    for (int i = 0; i < 12; i++) {
+        global_registers[DIG_T1 + 2 * i] = (uint8_t)global_trim[i];
+        global_registers[DIG_T1 + 2 * i + 1] = (uint8_t)(global_trim[i] >> 8);
+    }
+
+    global_transfers = 0;
+    BMP280_Init();
+    init_transfers = global_transfers;
+    CHECK(global_transfers == 3, "init made %u transfers instead of 3 (trimming burst and 2 writes)", global_transfers);
+    CHECK(trimmingParameter.dig_T1 == 27504 && trimmingParameter.dig_T3 == -1000 && trimmingParameter.dig_P1 == 36477 &&
+          trimmingParameter.dig_P9 == 6000, "trimming parsed wrong");
+    CHECK(global_registers[CTRL_MEAS] == 0xB7 && global_registers[CONFIG] == 0x00, "configuration not written");
+
+    /* the datasheet example: adc_T 519888 and adc_P 415148 give 25.08 degrees, t_fine 128422 and 100653.27 Pa */
+    set_result(TEMP_MSB, 519888);
+    set_result(PRESS_MSB, 415148);
+    global_transfers = 0;
+    global_bytes = 0;
+    BMP280_get_sample(&temperature, &pressure);
+    sample_transfers = global_transfers;
+    sample_bytes = global_bytes;
+    CHECK(global_transfers == 1 && global_bytes == 7, "a sample took %u transfers of %u bytes instead of 1 of 7", global_transfers, global_bytes);
+    CHECK(t_fine == 128422 && fabsf(temperature - 25.08f) < 1e-4f, "datasheet temperature %f (t_fine %d)", temperature, (int)t_fine);
+    CHECK(fabs(pressure - 1006.5327) < 1e-3, "datasheet pressure %f hPa", pressure);
+
+    /* random results over the operating range (-40 to 85 degrees, 300 to 1100 hPa) */
+    srand(11);
+    for (int n = 0; n < SAMPLES; n++) {
+        int32_t adc_T = 380000 + rand() % 260000, adc_P = 180000 + rand() % 440000;
+        double fine, t, p;
+
+        set_result(TEMP_MSB, adc_T);
+        set_result(PRESS_MSB, adc_P);
+        BMP280_get_sample(&temperature, &pressure);
+        t = reference_temperature(adc_T, &fine);
+        if (t < -40 || t > 85) {
+            continue;
+        }
+        p = reference_pressure(adc_P, fine) / 100;
+        if (p < 300 || p > 1100) {
+            continue;
+        }
+        max_temperature = fmax(max_temperature, fabs(temperature - t));
+        max_pressure = fmax(max_pressure, fabs(pressure - p));
+
+        /* the single readers see the same measurement */
+        CHECK(BMP280_get_temperature() == temperature && BMP280_get_pressure() == pressure, "single readers differ at %d", n);
+    }
+
+    CHECK(max_temperature <= 0.01, "temperature off by %g degrees", max_temperature);
+    CHECK(max_pressure <= 0.01, "pressure off by %g hPa", max_pressure);
+
+    printf("bmp_burst_test: SPI transfers: init %u, sample %u (%u bytes)\n", init_transfers, sample_transfers, sample_bytes);
+    printf("bmp_burst_test: max difference to the floating point compensation: temperature %.4f degrees, pressure %.4f hPa\n",
+           max_temperature, max_pressure);
+    if (global_failures) {
+        printf("bmp_burst_test: %d failures\n", global_failures);
+        return 1;
+    }
+    printf("bmp_burst_test: OK\n");
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ * comm_frame_fuzz: encodes a stream of random frames with the COBS, sequence number and CRC-16 framing of the board
+ * link, decodes it clean and then with one corruption in about one frame of ten (a flipped bit, a dropped byte, an
+ * inserted byte or a burst of 5 random bytes). the decoder must deliver every clean frame, no frame that wasn't sent
+ * and count every corrupted one once
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "comm_frame.h"
+
+#define FRAMES          (200000)
+#define SEARCH          (300)       /* the delivered frames are looked for this far after the last delivered one */
+
+typedef struct {
+    uint8_t seq;
+    uint16_t len;
+    uint8_t payload[LIB_COMM_FRAME_MAX_PAYLOAD_LEN];
+    uint32_t start, end;            /* bytes of the frame in the encoded stream */
+} sent_t;
+
+static sent_t global_sent[FRAMES];
+static uint8_t global_stream[FRAMES * LIB_COMM_FRAME_ENCODED_LEN(LIB_COMM_FRAME_MAX_PAYLOAD_LEN)];
+static uint8_t global_received[FRAMES * LIB_COMM_FRAME_ENCODED_LEN(LIB_COMM_FRAME_MAX_PAYLOAD_LEN) + FRAMES];
+static uint8_t global_corrupted[FRAMES], global_delivered[FRAMES];
+static LIB_COMM_FRAME_Decoder_t global_decoder;
+static int global_failures;
+
+#define CHECK(COND, ...) do { if (!(COND)) { global_failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+int main(void)
+{
+    uint32_t stream_len = 0, received_len = 0, encoded = 0;
+    unsigned delivered = 0, mismatched = 0, false_frames = 0, corrupted = 0, clean_lost = 0, next = 0;
+    uint16_t len = 0;
+    const uint8_t* payload;
+    uint8_t frame[LIB_COMM_FRAME_ENCODED_LEN(LIB_COMM_FRAME_MAX_PAYLOAD_LEN)];
+    LIB_COMM_FRAME_Stats_t stats;
+    clock_t start;
+    double encode_seconds, decode_seconds;
+
+    /* check value of CRC-16/CCITT-FALSE */
+    CHECK(LIB_COMM_FRAME_u16Crc16((const uint8_t*)"123456789", 9, LIB_COMM_FRAME_CRC_INIT) == 0x29B1, "CRC check value");
+
+    /* payloads rich in zeros and in the COBS block codes */
+    srand(1234);
+    for (int i = 0; i < FRAMES; i++) {
+        sent_t* s = &global_sent[i];
+
+        s->seq = (uint8_t)i;
+        s->len = rand() % (LIB_COMM_FRAME_MAX_PAYLOAD_LEN + 1);
+        for (int k = 0; k < s->len; k++) {
+            int r = rand() % 4;
+            s->payload[k] = r == 0 ? 0x00 : r == 1 ? 0x55 : r == 2 ? 0xAA : (uint8_t)rand();
+        }
+        s->start = stream_len;
+        len = LIB_COMM_FRAME_u16Encode(s->seq, s->payload, s->len, &global_stream[stream_len]);
+        CHECK(len <= LIB_COMM_FRAME_ENCODED_LEN(s->len), "frame %d encoded in %u bytes", i, len);
+        for (int k = 1; k < len - 1; k++) {
+            CHECK(global_stream[stream_len + k] != LIB_COMM_FRAME_DELIMITER, "delimiter inside frame %d", i);
+        }
+        CHECK(global_stream[stream_len] == LIB_COMM_FRAME_DELIMITER && global_stream[stream_len + len - 1] == LIB_COMM_FRAME_DELIMITER,
+              "frame %d not between delimiters", i);
+        stream_len += len;
+        s->end = stream_len;
+    }
+
+    LIB_COMM_FRAME_vidDecoderInit(&global_decoder);
+    for (uint32_t k = 0; k < stream_len; k++) {
+        if (!LIB_COMM_FRAME_u8Decode(&global_decoder, global_stream[k])) {
+            continue;
+        }
+        payload = LIB_COMM_FRAME_pu8Payload(&global_decoder, &len);
+        if (delivered >= FRAMES || len != global_sent[delivered].len || memcmp(payload, global_sent[delivered].payload, len) ||
+            global_decoder.lastSeq != global_sent[delivered].seq) {
+            mismatched++;
+        }
+        delivered++;
+    }
+    CHECK(delivered == FRAMES && mismatched == 0, "clean stream: %u of %d frames delivered, %u mismatched", delivered, FRAMES, mismatched);
+    CHECK(global_decoder.stats.frames == FRAMES && global_decoder.stats.lostFrames == 0, "clean stream counted errors");
+
+    /* one corruption at a random byte of about one frame of ten */
+    srand(99);
+    for (int i = 0; i < FRAMES; i++) {
+        int kind = (rand() % 10 == 0) ? 1 + rand() % 4 : 0;
+        uint32_t at = global_sent[i].start + rand() % (global_sent[i].end - global_sent[i].start);
+
+        for (uint32_t k = global_sent[i].start; k < global_sent[i].end; k++) {
+            if (!kind || k != at) {
+                global_received[received_len++] = global_stream[k];
+                continue;
+            }
+            global_corrupted[i] = 1;
+            corrupted++;
+            if (kind == 1) {
+                global_received[received_len++] = global_stream[k] ^ (uint8_t)(1 << (rand() % 8));
+            } else if (kind == 3) {
+                global_received[received_len++] = (uint8_t)rand();
+                global_received[received_len++] = global_stream[k];
+            } else if (kind == 4) {
+                for (int j = 0; j < 5; j++) global_received[received_len++] = (uint8_t)rand();
+            }
+        }
+    }
+
+    /* a delivered frame must be one that was sent, after the last delivered one */
+    delivered = 0;
+    LIB_COMM_FRAME_vidDecoderInit(&global_decoder);
+    for (uint32_t k = 0; k < received_len; k++) {
+        int found = -1;
+
+        if (!LIB_COMM_FRAME_u8Decode(&global_decoder, global_received[k])) {
+            continue;
+        }
+        payload = LIB_COMM_FRAME_pu8Payload(&global_decoder, &len);
+        for (unsigned j = next; j < next + SEARCH && j < FRAMES; j++) {
+            if (global_sent[j].seq == global_decoder.lastSeq && global_sent[j].len == len && !memcmp(global_sent[j].payload, payload, len)) {
+                found = (int)j;
+                break;
+            }
+        }
+        if (found < 0) {
+            false_frames++;
+            continue;
+        }
+        global_delivered[found] = 1;
+        next = (unsigned)found + 1;
+        delivered++;
+    }
+    stats = global_decoder.stats;
+    for (int i = 0; i < FRAMES; i++) {
+        clean_lost += !global_delivered[i] && !global_corrupted[i];
+    }
+    CHECK(false_frames == 0, "%u frames delivered that weren't sent", false_frames);
+    CHECK(clean_lost == 0, "%u clean frames lost", clean_lost);
+    CHECK(stats.frames == delivered, "decoder counted %u frames for %u delivered", (unsigned)stats.frames, delivered);
+    CHECK(stats.lostFrames == FRAMES - delivered, "decoder counted %u lost frames for %u", (unsigned)stats.lostFrames, FRAMES - delivered);
+
+    /* host throughput */
+    start = clock();
+    for (int r = 0; r < 20; r++) {
+        for (int i = 0; i < FRAMES; i++) {
+            encoded += LIB_COMM_FRAME_u16Encode(global_sent[i].seq, global_sent[i].payload, global_sent[i].len, frame);
+        }
+    }
+    encode_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int r = 0; r < 20; r++) {
+        LIB_COMM_FRAME_vidDecoderInit(&global_decoder);
+        for (uint32_t k = 0; k < stream_len; k++) {
+            LIB_COMM_FRAME_u8Decode(&global_decoder, global_stream[k]);
+        }
+    }
+    decode_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("comm_frame_fuzz: %u corrupted of %d frames: %u delivered, %u false, %u clean frames lost\n", corrupted, FRAMES, delivered,
+           false_frames, clean_lost);
+    printf("comm_frame_fuzz: decoder counters: crc %u, format %u, overflow %u, lost %u\n", (unsigned)stats.crcErrors,
+           (unsigned)stats.formatErrors, (unsigned)stats.overflows, (unsigned)stats.lostFrames);
+    printf("comm_frame_fuzz: host encode %.1f MB/s, decode %.1f MB/s\n", encoded / encode_seconds / 1e6, 20.0 * stream_len / decode_seconds / 1e6);
+    if (global_failures) {
+        printf("comm_frame_fuzz: %d failures\n", global_failures);
+        return 1;
+    }
+    printf("comm_frame_fuzz: OK\n");
+    return 0;
+}
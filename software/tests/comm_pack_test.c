@@ -0,0 +1,165 @@
+/*
+ * comm_pack_test: packs and unpacks the messages of the board and radio links. the sticks go through unchanged, the
+ * moves and the telemetry within half a step of their scale, and a telemetry stream of keyframes and deltas sent over a
+ * lossy link must give the telemetry that was sent or nothing, never deltas applied to another keyframe
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "comm_pack.h"
+
+#define SAMPLES         (200000)
+#define BOUND           (0.5 / 100 + 1e-4)      /* half a step of the 1/100 scales and the float rounding */
+
+static int global_failures;
+
+#define CHECK(COND, ...) do { if (!(COND)) { global_failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+static float uniform(float min, float max)
+{
+    return min + (max - min) * (rand() / (float)RAND_MAX);
+}
+
+/* random walk of the telemetry with jumps that don't fit the int8 deltas, so the keyframes come early */
+static void walk(LIB_COMM_PACK_Info_t* info)
+{
+    int k = rand() % 10;
+
+    if (k < 3) info->altitude += uniform(-0.3f, 0.3f);
+    if (k == 3) info->altitude += uniform(-50, 50);
+    if (k < 5) info->temperature += uniform(-0.05f, 0.05f);
+    if (k == 6) info->distanceToOrigin = uniform(0, 600);
+    if (k == 7) info->batteryCharge = (uint8_t)(rand() % 101);
+    if (info->altitude > 300 || info->altitude < -300) info->altitude = 0;
+}
+
+static double info_error(const LIB_COMM_PACK_Info_t* a, const LIB_COMM_PACK_Info_t* b)
+{
+    return fmax(fmax(fabs(a->altitude - b->altitude), fabs(a->temperature - b->temperature)), fabs(a->distanceToOrigin - b->distanceToOrigin));
+}
+
+/*
+ * sends the telemetry stream over a link losing 'loss_permille' of the messages one by one and, when 'burst' is set,
+ * as many again in bursts of up to 40 messages. returns the number of messages unpacked with a wrong telemetry
+ */
+static unsigned lossy_stream(uint8_t period, unsigned loss_permille, int burst, unsigned* delivered, unsigned* dropped)
+{
+    LIB_COMM_PACK_InfoState_t tx, rx;
+    LIB_COMM_PACK_Info_t in = {10, 5, 25, 90}, out;
+    uint8_t buf[LIB_COMM_PACK_RADIO_LEN];
+    unsigned wrong = 0, burst_left = 0;
+
+    LIB_COMM_PACK_vidInfoInit(&tx, period);
+    LIB_COMM_PACK_vidInfoInit(&rx, 0);
+    *delivered = 0;
+    for (int n = 0; n < SAMPLES; n++) {
+        uint8_t len;
+
+        walk(&in);
+        len = LIB_COMM_PACK_u8PackInfo(&tx, &in, buf);
+        if (burst && 0 == burst_left && (unsigned)(rand() % 1000) < loss_permille / 20) burst_left = 1 + rand() % 40;
+        if (burst_left) {
+            burst_left--;
+            continue;
+        }
+        if ((unsigned)(rand() % 1000) < loss_permille) continue;
+
+        if (LIB_COMM_PACK_u8UnpackInfo(&rx, buf, len, &out)) {
+            (*delivered)++;
+            wrong += info_error(&out, &in) > BOUND || out.batteryCharge != in.batteryCharge;
+        }
+    }
+    *dropped = rx.dropped;
+    return wrong;
+}
+
+int main(void)
+{
+    uint8_t buf[16];
+    double max_error = 0;
+    unsigned long bytes = 0, keyframes = 0;
+    unsigned delivered, dropped, wrong;
+    LIB_COMM_PACK_InfoState_t tx, rx;
+    LIB_COMM_PACK_Info_t in = {10, 5, 25, 90}, out;
+    LIB_COMM_PACK_Move_t move, moved;
+    LIB_COMM_PACK_Sticks_t sticks, unpacked;
+
+    srand(16);
+
+    /* sticks: every value, read from a radio payload padded with zeros */
+    for (int r = -128; r < 128; r++) {
+        sticks = (LIB_COMM_PACK_Sticks_t){(int8_t)r, (int8_t)-r, (int8_t)(r / 2), (int8_t)(r / 3), (uint8_t)(r & 7), (uint8_t)(r * 3)};
+        memset(buf, 0, sizeof buf);
+        CHECK(LIB_COMM_PACK_u8PackSticks(&sticks, buf) == LIB_COMM_PACK_STICKS_LEN, "sticks length");
+        CHECK(LIB_COMM_PACK_u8UnpackSticks(buf, LIB_COMM_PACK_RADIO_LEN, &unpacked) && !memcmp(&sticks, &unpacked, sizeof sticks), "sticks %d", r);
+    }
+
+    /* moves over the range, then saturated */
+    for (int n = 0; n < SAMPLES; n++) {
+        move = (LIB_COMM_PACK_Move_t){uniform(-180, 180), uniform(-180, 180), uniform(-10, 100), uniform(-180, 180), (uint8_t)(n & 7)};
+        CHECK(LIB_COMM_PACK_u8PackMove(&move, buf) == LIB_COMM_PACK_MOVE_LEN, "move length");
+        if (!LIB_COMM_PACK_u8UnpackMove(buf, LIB_COMM_PACK_MOVE_LEN, &moved) || moved.flags != move.flags) {
+            CHECK(0, "move %d not unpacked", n);
+            continue;
+        }
+        max_error = fmax(max_error, fmax(fmax(fabs(moved.roll - move.roll), fabs(moved.pitch - move.pitch)),
+                                         fmax(fabs(moved.thrust - move.thrust), fabs(moved.yaw - move.yaw))));
+    }
+    CHECK(max_error <= BOUND, "move error %g", max_error);
+    move = (LIB_COMM_PACK_Move_t){1e6f, -1e6f, 0, 0, 0};
+    LIB_COMM_PACK_u8PackMove(&move, buf);
+    LIB_COMM_PACK_u8UnpackMove(buf, LIB_COMM_PACK_MOVE_LEN, &moved);
+    CHECK(moved.roll > 327 && moved.pitch < -327, "move not saturated: %f %f", moved.roll, moved.pitch);
+    printf("comm_pack_test: move max error %.6f\n", max_error);
+
+    /* telemetry without loss, read as its real length and as a padded radio payload */
+    max_error = 0;
+    LIB_COMM_PACK_vidInfoInit(&tx, 8);
+    LIB_COMM_PACK_vidInfoInit(&rx, 0);
+    for (int n = 0; n < SAMPLES; n++) {
+        uint8_t len;
+
+        walk(&in);
+        len = LIB_COMM_PACK_u8PackInfo(&tx, &in, buf);
+        bytes += len;
+        keyframes += (buf[0] == LIB_COMM_PACK_TYPE_INFO);
+        if (len < LIB_COMM_PACK_INFO_DELTA_MIN_LEN || len > LIB_COMM_PACK_INFO_LEN) {
+            CHECK(0, "info length %u", len);
+            continue;
+        }
+        memset(buf + len, 0, sizeof buf - len);
+        if (!LIB_COMM_PACK_u8UnpackInfo(&rx, buf, (n & 1) ? len : LIB_COMM_PACK_RADIO_LEN, &out)) {
+            CHECK(0, "info %d not unpacked", n);
+            continue;
+        }
+        max_error = fmax(max_error, info_error(&out, &in));
+        CHECK(out.batteryCharge == in.batteryCharge, "battery of info %d", n);
+    }
+    CHECK(max_error <= BOUND, "info error %g", max_error);
+    printf("comm_pack_test: info max error %.6f, %.2f bytes per message, %lu keyframes of %d messages\n", max_error,
+           bytes / (double)SAMPLES, keyframes, SAMPLES);
+
+    /* the lossy links of the drone to app board stream and of the radio stream */
+    wrong = lossy_stream(8, 50, 0, &delivered, &dropped);
+    printf("comm_pack_test: 5%% loss, keyframe every 8: %u delivered, %u deltas dropped, %u wrong\n", delivered, dropped, wrong);
+    CHECK(wrong == 0, "%u messages unpacked against another keyframe", wrong);
+    wrong = lossy_stream(4, 100, 1, &delivered, &dropped);
+    printf("comm_pack_test: 10%% loss in bursts, keyframe every 4: %u delivered, %u deltas dropped, %u wrong\n", delivered, dropped, wrong);
+    CHECK(wrong == 0, "%u messages unpacked against another keyframe", wrong);
+
+    /* random bytes never unpack past the message */
+    for (int n = 0; n < SAMPLES; n++) {
+        for (unsigned i = 0; i < sizeof buf; i++) buf[i] = (uint8_t)rand();
+        buf[0] = (n & 1) ? LIB_COMM_PACK_TYPE_INFO_DELTA : LIB_COMM_PACK_TYPE_INFO;
+        LIB_COMM_PACK_u8UnpackInfo(&rx, buf, (uint16_t)(rand() % (LIB_COMM_PACK_INFO_LEN + 1)), &out);
+    }
+
+    if (global_failures) {
+        printf("comm_pack_test: %d failures\n", global_failures);
+        return 1;
+    }
+    printf("comm_pack_test: OK\n");
+    return 0;
+}
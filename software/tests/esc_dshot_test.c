@@ -0,0 +1,190 @@
+/*
+ * esc_dshot_test: the ESC driver built with DShot600 against a model of the DMA bursts of TIM4. the compare values of
+ * every burst are decoded back into frames with the timing of the DShot specification (high for 75% of the bit for a 1
+ * and 37.5% for a 0, within 5% of the bit) and checked against the throttle, the CRC and the commands
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ESC.h"
+#include "MCAL_TIM4.h"
+#include "MCAL_wrapper.h"
+#include "Service_RTOS_wrapper.h"
+
+#define BURSTS          (16)
+#define BIT_NS          (1e9 / 600000)      /* DShot600 */
+#define PERIODS         (HAL_ESC_DSHOT_FRAME_BITS + HAL_ESC_DSHOT_FRAME_GAP)
+
+static int global_failures;
+
+#define CHECK(COND, ...) do { if (!(COND)) { global_failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+/* ---------------------------------------------------------------- TIM4 */
+
+static uint16_t period_ticks, burst_periods;
+static uint8_t inverted;
+static const uint16_t* in_flight;
+static int busy, bursts;
+static uint16_t sent[BURSTS][PERIODS * MCAL_TIM4_CHANNELS];
+static int sent_count;
+
+MCAL_TIM4_ErrStat_t MCAL_TIM4_InitBurst(uint16_t arg_u16PeriodTicks, uint8_t arg_u8Inverted)
+{
+    period_ticks = arg_u16PeriodTicks;
+    inverted = arg_u8Inverted;
+    return MCAL_TIM4_STAT_OK;
+}
+
+/* the bursts kept are the ones since sent_count was cleared */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_StartBurst(const uint16_t* arg_pu16Compares, uint16_t arg_u16Periods)
+{
+    if (busy) return MCAL_TIM4_STAT_BUSY;
+    CHECK(arg_pu16Compares != in_flight, "burst started from the buffer of the previous one");
+    in_flight = arg_pu16Compares;
+    burst_periods = arg_u16Periods;
+    bursts++;
+    if (sent_count < BURSTS) memcpy(sent[sent_count++], arg_pu16Compares, sizeof sent[0]);
+    return MCAL_TIM4_STAT_OK;
+}
+
+MCAL_TIM4_ErrStat_t MCAL_TIM4_GetCounter(uint16_t* arg_pu16Counter)
+{
+    *arg_pu16Counter = 0;
+    return MCAL_TIM4_STAT_OK;
+}
+
+MCAL_WRAPPER_ErrStat_t MCAL_WRAPEPR_TIM4_PWM_OUT(MCAL_WRAPPER_TIM_CH_t arg_Channel_t, uint16_t arg_u16DutyCycle) { return MCAL_WRAPPER_STAT_OK; }
+MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_DelayUS(uint32_t arg_u16US) { return MCAL_WRAPPER_STAT_OK; }
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentUSTime(uint32_t* arg_pu32CurrentTime)
+{
+    *arg_pu32CurrentTime = 0;
+    return SERVICE_RTOS_STAT_OK;
+}
+
+/* ---------------------------------------------------------------- */
+
+/* the frame of one motor in a burst, 0 if a bit is out of the tolerance or the gap isn't low */
+static int decode(const uint16_t* arg_pBurst, int arg_motor, uint16_t* arg_pFrame)
+{
+    double bit_ns = 1e9 * period_ticks / MCAL_TIM4_CLOCK_HZ;
+    uint16_t frame = 0;
+
+    for (int b = 0; b < HAL_ESC_DSHOT_FRAME_BITS; b++) {
+        double high_ns = 1e9 * arg_pBurst[b * MCAL_TIM4_CHANNELS + arg_motor] / MCAL_TIM4_CLOCK_HZ;
+        if (high_ns > bit_ns * 0.70 && high_ns < bit_ns * 0.80) frame = (uint16_t)((frame << 1) | 1);
+        else if (high_ns > bit_ns * 0.325 && high_ns < bit_ns * 0.425) frame = (uint16_t)(frame << 1);
+        else return 0;
+    }
+    for (int b = HAL_ESC_DSHOT_FRAME_BITS; b < PERIODS; b++) {
+        if (arg_pBurst[b * MCAL_TIM4_CHANNELS + arg_motor]) return 0;
+    }
+    *arg_pFrame = frame;
+    return 1;
+}
+
+static int crc_ok(uint16_t arg_frame)
+{
+    uint16_t data = arg_frame >> 4;
+
+    return ((data ^ (data >> 4) ^ (data >> 8)) & 0x0F) == (arg_frame & 0x0F);
+}
+
+int main(void)
+{
+    uint16_t frame = 0, previous = 0, copy[PERIODS * MCAL_TIM4_CHANNELS];
+    const uint16_t* busy_buffer;
+    int distinct = 0;
+    HAL_ESC_Latency_t latency;
+
+    /* the ESCs arm on 1.5 s of stop frames, one every ms */
+    HAL_ESC_init();
+    CHECK(!inverted, "signal inverted without bidirectional DShot");
+    CHECK(bursts == 1500, "%d arming frames", bursts);
+    CHECK(burst_periods == PERIODS, "burst of %u periods", burst_periods);
+    CHECK(decode(sent[0], 0, &frame) && frame == 0, "arming frame 0x%04X", frame);
+    CHECK(1e9 * period_ticks / MCAL_TIM4_CLOCK_HZ > BIT_NS * 0.99 && 1e9 * period_ticks / MCAL_TIM4_CLOCK_HZ < BIT_NS * 1.01,
+          "bit of %u ticks", period_ticks);
+
+    /* known frames, then every value with and without the telemetry bit */
+    CHECK(HAL_ESC_DShotPacket(1046, 0) == 0x82C6, "1046 packed as 0x%04X", HAL_ESC_DShotPacket(1046, 0));
+    CHECK(HAL_ESC_DShotPacket(48, 0) == 0x0606, "48 packed as 0x%04X", HAL_ESC_DShotPacket(48, 0));
+    CHECK(HAL_ESC_DShotPacket(0, 0) == 0x0000, "stop packed as 0x%04X", HAL_ESC_DShotPacket(0, 0));
+    for (uint16_t v = 0; v < 2048; v++) {
+        for (uint8_t t = 0; t < 2; t++) {
+            frame = HAL_ESC_DShotPacket(v, t);
+            CHECK(crc_ok(frame) && (frame >> 5) == v && ((frame >> 4) & 1) == t, "value %u telemetry %u packed as 0x%04X", v, t, frame);
+        }
+    }
+
+    /* the speed from 0 to 100% in steps of 0.001%: stop, then the 2000 throttle steps in order */
+    for (int i = 0; i <= 100000; i++) {
+        HAL_ESC_setSpeed(HAL_ESC_MOTOR_TOP_LEFT, i / 1000.0f);
+        sent_count = 0;
+        HAL_ESC_update();
+        if (!decode(sent[0], 0, &frame) || !crc_ok(frame) || (frame & 0x10)) {
+            CHECK(0, "speed %.3f%% sent as 0x%04X", i / 1000.0, frame);
+            continue;
+        }
+        frame >>= 5;
+        if (i == 0) CHECK(frame == 0, "0%% sent as %u", frame);
+        if (i == 1) CHECK(frame == HAL_ESC_DSHOT_THROTTLE_MIN, "0.001%% sent as %u", frame);
+        if (i > 1) CHECK(frame >= previous, "speed %.3f%% sent as %u after %u", i / 1000.0, frame, previous);
+        distinct += (frame != previous);
+        previous = frame;
+    }
+    CHECK(frame == HAL_ESC_DSHOT_THROTTLE_MAX, "100%% sent as %u", frame);
+    CHECK(distinct == HAL_ESC_DSHOT_THROTTLE_MAX - HAL_ESC_DSHOT_THROTTLE_MIN + 1, "%d throttle steps", distinct);
+    CHECK(HAL_ESC_setSpeed(HAL_ESC_MOTOR_TOP_LEFT, 100.5f) == HAL_ESC_ERR_INVALID_PARAMS, "speed over 100%%");
+
+    /* every channel carries its own motor */
+    HAL_ESC_setSpeed(HAL_ESC_MOTOR_TOP_LEFT, 0);
+    HAL_ESC_setSpeed(HAL_ESC_MOTOR_TOP_RIGHT, 25);
+    HAL_ESC_setSpeed(HAL_ESC_MOTOR_BOTTOM_LEFT, 50);
+    HAL_ESC_setSpeed(HAL_ESC_MOTOR_BOTTOM_RIGHT, 100);
+    sent_count = 0;
+    HAL_ESC_update();
+    for (int m = 0; m < MCAL_TIM4_CHANNELS; m++) {
+        static const uint16_t expected[] = {0, 48 + 500, 48 + 1000, 2047};
+        CHECK(decode(sent[0], m, &frame) && (frame >> 5) == expected[m], "motor %d sent %u", m, frame >> 5);
+    }
+    HAL_ESC_getLatency(&latency);
+    CHECK(latency.lastUS >= 27 && latency.lastUS <= 30, "latency of %u us", (unsigned)latency.lastUS);
+
+    /* an update while the previous burst is out leaves its buffer alone */
+    busy_buffer = in_flight;
+    memcpy(copy, busy_buffer, sizeof copy);
+    busy = 1;
+    HAL_ESC_setSpeed(HAL_ESC_MOTOR_TOP_LEFT, 77);
+    CHECK(HAL_ESC_update() == HAL_ESC_ERR_BUSY, "update while busy");
+    CHECK(!memcmp(copy, busy_buffer, sizeof copy), "buffer of the burst in flight changed");
+    HAL_ESC_getLatency(&latency);
+    CHECK(latency.busy == 1, "%u busy updates", (unsigned)latency.busy);
+    busy = 0;
+
+    /* a command is repeated with the telemetry bit while the other motors stop, then the motor stops */
+    sent_count = 0;
+    CHECK(HAL_ESC_sendCommand(HAL_ESC_MOTOR_BOTTOM_LEFT, HAL_ESC_DSHOT_CMD_SPIN_DIRECTION_2) == HAL_ESC_OK, "command");
+    CHECK(sent_count == HAL_ESC_DSHOT_CMD_REPEAT, "command sent %d times", sent_count);
+    for (int k = 0; k < sent_count; k++) {
+        for (int m = 0; m < MCAL_TIM4_CHANNELS; m++) {
+            uint16_t expected = (m == HAL_ESC_MOTOR_BOTTOM_LEFT) ? HAL_ESC_DShotPacket(HAL_ESC_DSHOT_CMD_SPIN_DIRECTION_2, 1) : 0;
+            CHECK(decode(sent[k], m, &frame) && frame == expected, "frame %d of motor %d: 0x%04X", k, m, frame);
+        }
+    }
+    CHECK(HAL_ESC_sendCommand(HAL_ESC_MOTOR_BOTTOM_LEFT, (HAL_ESC_DShotCmd_t)HAL_ESC_DSHOT_THROTTLE_MIN) == HAL_ESC_ERR_INVALID_PARAMS,
+          "throttle value sent as a command");
+    sent_count = 0;
+    HAL_ESC_update();
+    CHECK(decode(sent[0], HAL_ESC_MOTOR_BOTTOM_LEFT, &frame) && frame == 0, "motor not stopped after the command");
+
+    printf("esc_dshot_test: bit of %u ticks (%.1f ns), %d throttle steps, latency %u us\n", period_ticks,
+           1e9 * period_ticks / MCAL_TIM4_CLOCK_HZ, distinct, (unsigned)latency.lastUS);
+    if (global_failures) {
+        printf("esc_dshot_test: %d failures\n", global_failures);
+        return 1;
+    }
+    printf("esc_dshot_test: OK\n");
+    return 0;
+}
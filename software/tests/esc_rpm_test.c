@@ -0,0 +1,293 @@
+/*
+ * esc_rpm_test: the eRPM replies of bidirectional DShot and the notch filters on the motor harmonics. the ESC driver is
+ * built with bidirectional DShot600 against a model of TIM4 where the motor listened to after a burst answers with the
+ * GCR edges of its electrical period. the decoder gets replies with jittered and dropped edges, then the notch bank of
+ * RPMFilter.c runs on a synthetic gyro made of slow motion, the first two harmonics of four motors and noise
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "ESC.h"
+#include "RPMFilter.h"
+#include "MCAL_TIM4.h"
+#include "MCAL_wrapper.h"
+#include "Service_RTOS_wrapper.h"
+
+#define REPLY_BIT_TICKS     ((MCAL_TIM4_CLOCK_HZ / 600000) * 4 / 5)     /* replies are sent at 5/4 of the DShot600 bit rate */
+#define DECODES             (20000)
+#define SAMPLE_HZ           (1000.0)
+#define SAMPLES             (20000)
+#define SETTLE              (2000)
+
+static int global_failures;
+
+#define CHECK(COND, ...) do { if (!(COND)) { global_failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+static double uniform(double min, double max)
+{
+    return min + (max - min) * (rand() / (double)RAND_MAX);
+}
+
+/*
+ * edges of a reply carrying the 12 bits 'arg_value' (3 bits of shift, 9 bits of period): the value and its inverted CRC in
+ * four GCR codes after a start bit, a transition for every 1. 'arg_jitter' moves every edge by up to that many ticks and
+ * 'arg_idle' adds the edge of the line going back to idle after the frame
+ */
+static uint8_t reply(uint16_t arg_value, double arg_jitter, int arg_idle, uint16_t* arg_pEdges)
+{
+    static const uint8_t gcr[16] = {0x19, 0x1B, 0x12, 0x13, 0x1D, 0x15, 0x16, 0x17, 0x1A, 0x09, 0x0A, 0x0B, 0x1E, 0x0D, 0x0E, 0x0F};
+    uint16_t frame = (uint16_t)((arg_value << 4) | (~(arg_value ^ (arg_value >> 4) ^ (arg_value >> 8)) & 0x0F));
+    uint32_t bits = 1;
+    uint16_t start = (uint16_t)rand();
+    uint8_t count = 0;
+
+    for (int i = 3; i >= 0; i--) bits = (bits << 5) | gcr[(frame >> (4 * i)) & 0x0F];
+    for (int b = 0; b < HAL_ESC_DSHOT_REPLY_BITS; b++) {
+        if ((bits >> (HAL_ESC_DSHOT_REPLY_BITS - 1 - b)) & 1) {
+            arg_pEdges[count++] = (uint16_t)lrint(start + b * REPLY_BIT_TICKS + uniform(-arg_jitter, arg_jitter));
+        }
+    }
+    if (arg_idle) arg_pEdges[count++] = (uint16_t)lrint(start + (HAL_ESC_DSHOT_REPLY_BITS + rand() % 4) * REPLY_BIT_TICKS);
+    return count;
+}
+
+/* the 12 bits of an electrical period in micro seconds and the eRPM the ESC means with them */
+static uint16_t period_value(uint32_t arg_periodUS, uint32_t* arg_pERPM)
+{
+    uint16_t shift = 0;
+
+    while (arg_periodUS > 0x1FF) {
+        arg_periodUS >>= 1;
+        shift++;
+    }
+    *arg_pERPM = (60000000UL + (arg_periodUS << shift) / 2) / (arg_periodUS << shift);
+    return (uint16_t)((shift << 9) | arg_periodUS);
+}
+
+/* ---------------------------------------------------------------- TIM4 and the ESCs */
+
+static uint8_t inverted, armed, armed_channel, stop_busy, corrupt_motor = 0xFF;
+static uint16_t* capture;
+static uint16_t motor_value[MCAL_TIM4_CHANNELS];
+static uint8_t replied_edges;
+
+MCAL_TIM4_ErrStat_t MCAL_TIM4_InitBurst(uint16_t arg_u16PeriodTicks, uint8_t arg_u8Inverted)
+{
+    inverted = arg_u8Inverted;
+    return MCAL_TIM4_STAT_OK;
+}
+
+MCAL_TIM4_ErrStat_t MCAL_TIM4_ArmCapture(uint8_t arg_u8Channel, uint16_t* arg_pu16Edges, uint8_t arg_u8MaxEdges)
+{
+    if (armed) return MCAL_TIM4_STAT_BUSY;
+    if (arg_u8MaxEdges < HAL_ESC_DSHOT_REPLY_BITS + 1) CHECK(0, "capture of %u edges", arg_u8MaxEdges);
+    armed = 1;
+    armed_channel = arg_u8Channel;
+    capture = arg_pu16Edges;
+    return MCAL_TIM4_STAT_OK;
+}
+
+/* the motor listened to answers right after the burst, one of them drops an edge */
+MCAL_TIM4_ErrStat_t MCAL_TIM4_StartBurst(const uint16_t* arg_pu16Compares, uint16_t arg_u16Periods)
+{
+    if (armed) {
+        replied_edges = reply(motor_value[armed_channel], REPLY_BIT_TICKS * 0.1, rand() & 1, capture);
+        if (armed_channel == corrupt_motor) {
+            memmove(capture + 3, capture + 4, sizeof(uint16_t) * (replied_edges - 4));
+            replied_edges--;
+        }
+    }
+    return MCAL_TIM4_STAT_OK;
+}
+
+MCAL_TIM4_ErrStat_t MCAL_TIM4_StopCapture(uint8_t* arg_pu8Edges)
+{
+    if (stop_busy) return MCAL_TIM4_STAT_BUSY;
+    *arg_pu8Edges = armed ? replied_edges : 0;
+    armed = 0;
+    return MCAL_TIM4_STAT_OK;
+}
+
+MCAL_TIM4_ErrStat_t MCAL_TIM4_GetCounter(uint16_t* arg_pu16Counter)
+{
+    *arg_pu16Counter = 0;
+    return MCAL_TIM4_STAT_OK;
+}
+
+MCAL_WRAPPER_ErrStat_t MCAL_WRAPEPR_TIM4_PWM_OUT(MCAL_WRAPPER_TIM_CH_t arg_Channel_t, uint16_t arg_u16DutyCycle) { return MCAL_WRAPPER_STAT_OK; }
+MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_DelayUS(uint32_t arg_u16US) { return MCAL_WRAPPER_STAT_OK; }
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentUSTime(uint32_t* arg_pu32CurrentTime)
+{
+    *arg_pu32CurrentTime = 0;
+    return SERVICE_RTOS_STAT_OK;
+}
+
+/* the telemetry is read by another task than the one updating it */
+static int critical_depth, critical_sections;
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_EnterCritical(void)
+{
+    critical_depth++;
+    critical_sections++;
+    return SERVICE_RTOS_STAT_OK;
+}
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ExitCritical(void)
+{
+    critical_depth--;
+    return SERVICE_RTOS_STAT_OK;
+}
+
+/* ---------------------------------------------------------------- */
+
+/* four motors between 140 and 220 Hz, slowly changing speed, with their first two harmonics */
+static double vibration(double arg_t, double arg_phase[][RPM_FILTER_HARMONICS], uint32_t* arg_pRPM)
+{
+    double out = 0;
+
+    for (int m = 0; m < RPM_FILTER_MOTORS; m++) {
+        double hz = 140 + 20 * m + 20 * sin(2 * M_PI * 0.3 * arg_t + m);
+        for (int h = 0; h < RPM_FILTER_HARMONICS; h++) {
+            arg_phase[m][h] += 2 * M_PI * hz * (h + 1) / SAMPLE_HZ;
+            out += (h ? 150 : 400) * sin(arg_phase[m][h]);
+        }
+        arg_pRPM[m] = (uint32_t)(hz * 60);
+    }
+    return out;
+}
+
+/* attenuation in dB of the harmonics with the speeds of motor (n / 'arg_every') % 4 given every 'arg_every' samples */
+static double attenuation(int arg_every)
+{
+    static rpm_filter_t filter;
+    double phase[RPM_FILTER_MOTORS][RPM_FILTER_HARMONICS] = {{0}}, power_in = 0, power_out = 0;
+    uint32_t rpm[RPM_FILTER_MOTORS], held[RPM_FILTER_MOTORS] = {0};
+
+    RpmFilter_Init(&filter, 1000);
+    for (int n = 0; n < SAMPLES; n++) {
+        double t = n / SAMPLE_HZ, slow = 800 * sin(2 * M_PI * 2 * t) + 300 * sin(2 * M_PI * 15 * t);
+        double vib = vibration(t, phase, rpm), noise = uniform(-10, 10);
+        int16_t y;
+
+        if (n % arg_every == 0) {
+            int m = (n / arg_every) % RPM_FILTER_MOTORS;
+            held[m] = rpm[m];
+            RpmFilter_SetMotors(&filter, held, 0x0F);
+        }
+        y = RpmFilter_Apply(&filter, RPM_FILTER_AXIS_ROLL, (int16_t)lrint(slow + vib + noise));
+        if (n >= SETTLE) {
+            power_in += vib * vib;
+            power_out += (y - slow) * (y - slow);
+        }
+    }
+    return 10 * log10(power_in / power_out);
+}
+
+int main(void)
+{
+    static rpm_filter_t filter;
+    static const uint32_t passband_rpm[RPM_FILTER_MOTORS] = {9000, 10200, 11400, 12600};
+    static const double passband_hz[] = {5, 10, 20, 40};
+    uint16_t edges[HAL_ESC_DSHOT_REPLY_BITS + 2];
+    uint32_t erpm[MCAL_TIM4_CHANNELS], expected, got;
+    unsigned wrong = 0, accepted = 0;
+    HAL_ESC_Telemetry_t telemetry;
+    double att_every, att_round_robin;
+
+    srand(23);
+
+    /* the replies of the four motors, one per update */
+    HAL_ESC_init();
+    CHECK(inverted, "bidirectional signal not inverted");
+    CHECK((HAL_ESC_DShotPacket(1046, 0) & 0x0F) == (~0x82C6 & 0x0F), "CRC of a bidirectional frame not inverted");
+    for (int m = 0; m < MCAL_TIM4_CHANNELS; m++) motor_value[m] = period_value(300 + 700 * m, &erpm[m]);
+    for (int n = 0; n < 2 * MCAL_TIM4_CHANNELS; n++) CHECK(HAL_ESC_update() == HAL_ESC_OK, "update %d", n);
+    critical_sections = 0;
+    HAL_ESC_getTelemetry(&telemetry);
+    CHECK(critical_sections == 1 && critical_depth == 0, "telemetry not copied in one critical section");
+    CHECK(telemetry.valid == 0x0F, "valid replies 0x%X", telemetry.valid);
+    for (int m = 0; m < MCAL_TIM4_CHANNELS; m++) CHECK(telemetry.eRPM[m] == erpm[m], "motor %d at %u eRPM for %u", m, telemetry.eRPM[m], erpm[m]);
+
+    /* a corrupted reply is an error and its motor isn't valid until it answers again */
+    corrupt_motor = 2;
+    for (int n = 0; n <= MCAL_TIM4_CHANNELS; n++) HAL_ESC_update();
+    HAL_ESC_getTelemetry(&telemetry);
+    CHECK(telemetry.valid == 0x0B && telemetry.errors >= 1, "corrupted reply: valid 0x%X, %u errors", telemetry.valid, telemetry.errors);
+    corrupt_motor = 0xFF;
+    for (int n = 0; n <= MCAL_TIM4_CHANNELS; n++) HAL_ESC_update();
+    HAL_ESC_getTelemetry(&telemetry);
+    CHECK(telemetry.valid == 0x0F, "valid replies 0x%X after the corrupted one", telemetry.valid);
+
+    /* the pins aren't given back while the burst before the capture is out */
+    stop_busy = 1;
+    CHECK(HAL_ESC_update() == HAL_ESC_ERR_BUSY, "update while the capture runs");
+    stop_busy = 0;
+
+    /* random periods, 10% jitter on the edges and the edge of the line going back to idle or not */
+    for (int n = 0; n < DECODES; n++) {
+        uint16_t value = period_value(20 + rand() % 40000, &expected);
+        uint8_t count = reply(value, REPLY_BIT_TICKS * 0.1, rand() & 1, edges);
+        got = HAL_ESC_DecodeERPM(edges, count, REPLY_BIT_TICKS);
+        if (got != expected) {
+            if (wrong++ < 5) printf("esc_rpm_test: value 0x%03X decoded as %u for %u\n", value, got, expected);
+        }
+    }
+    CHECK(wrong == 0, "%u of %d replies decoded wrong", wrong, DECODES);
+    CHECK(HAL_ESC_DecodeERPM(edges, reply(0x0FFF, 0, 0, edges), REPLY_BIT_TICKS) == 0, "stopped motor");
+    CHECK(HAL_ESC_DecodeERPM(edges, 0, REPLY_BIT_TICKS) == HAL_ESC_ERPM_INVALID, "no edge");
+
+    /* a dropped edge shifts the codes after it, the GCR codes and the CRC catch most of them */
+    for (int n = 0; n < DECODES; n++) {
+        uint16_t value = (uint16_t)(((rand() % 8) << 9) | (1 + rand() % 511));
+        uint8_t count = reply(value, REPLY_BIT_TICKS * 0.1, 0, edges), drop = (uint8_t)(rand() % count);
+        memmove(edges + drop, edges + drop + 1, sizeof(uint16_t) * (count - drop - 1));
+        accepted += HAL_ESC_DecodeERPM(edges, count - 1, REPLY_BIT_TICKS) != HAL_ESC_ERPM_INVALID;
+    }
+    CHECK(accepted * 100 < DECODES, "%u of %d replies with a dropped edge accepted", accepted, DECODES);
+
+    /* the harmonics with the speeds of every motor every 7 samples, then one motor per ms as the replies come */
+    att_every = attenuation(7);
+    att_round_robin = attenuation(1);
+    CHECK(att_every > 20 && att_round_robin > 20, "harmonics attenuated by %.1f and %.1f dB", att_every, att_round_robin);
+
+    /* the flight band goes through with the motors between 150 and 210 Hz, the eight notches delay it by about a ms */
+    for (unsigned k = 0; k < sizeof passband_hz / sizeof passband_hz[0]; k++) {
+        double s = 0, c = 0, gain, phase, delay_ms;
+
+        RpmFilter_Init(&filter, 1000);
+        RpmFilter_SetMotors(&filter, passband_rpm, 0x0F);
+        for (int n = 0; n < 8000; n++) {
+            double a = 2 * M_PI * passband_hz[k] * n / SAMPLE_HZ;
+            int16_t y = RpmFilter_Apply(&filter, RPM_FILTER_AXIS_PITCH, (int16_t)lrint(10000 * sin(a)));
+            if (n >= 4000) {
+                s += y * sin(a);
+                c += y * cos(a);
+            }
+        }
+        gain = 2 * sqrt(s * s + c * c) / 4000 / 10000;
+        phase = atan2(c, s) * 180 / M_PI;
+        delay_ms = -phase / 360 / passband_hz[k] * 1000;
+        printf("esc_rpm_test: %2.0f Hz: gain %.3f, phase %.1f deg (%.2f ms)\n", passband_hz[k], gain, phase, delay_ms);
+        CHECK(fabs(gain - 1) < 0.02 && delay_ms > 0 && delay_ms < 1.2, "%.0f Hz: gain %.3f, phase %.1f deg", passband_hz[k], gain, phase);
+    }
+
+    /* without a valid motor the signal goes through untouched */
+    RpmFilter_Init(&filter, 1000);
+    RpmFilter_SetMotors(&filter, passband_rpm, 0);
+    for (int n = 0; n < 100; n++) {
+        int16_t x = (int16_t)(n * 37 % 1000);
+        CHECK(RpmFilter_Apply(&filter, RPM_FILTER_AXIS_YAW, x) == x, "sample %d changed without a valid motor", n);
+    }
+
+    printf("esc_rpm_test: %d replies decoded, %u of %d with a dropped edge accepted\n", DECODES, accepted, DECODES);
+    printf("esc_rpm_test: harmonics attenuated by %.1f dB (speeds every 7 ms), %.1f dB (one motor per ms)\n", att_every, att_round_robin);
+    if (global_failures) {
+        printf("esc_rpm_test: %d failures\n", global_failures);
+        return 1;
+    }
+    printf("esc_rpm_test: OK\n");
+    return 0;
+}
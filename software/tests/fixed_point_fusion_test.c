@@ -0,0 +1,159 @@
+/*
+ * fixed_point_fusion_test: replays a noisy flight through the float and the fixed point (SENSOR_FUSION_FIXED_POINT)
+ * builds of the kalman attitude fusion and through pid_ctrl / pid_ctrl_fixed, and reports how far the fixed point
+ * results are from the float ones and from the true attitude
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <x86intrin.h>
+
+#include "pid.h"
+#include "math_fixed.h"
+
+void fusion_float(const double* arg_pAcc, const double* arg_pGyro, const double* arg_pMagnet, uint8_t arg_u8Fresh, double* arg_pAngles);
+void fusion_fixed(const double* arg_pAcc, const double* arg_pGyro, const double* arg_pMagnet, uint8_t arg_u8Fresh, double* arg_pAngles);
+
+#define SAMPLES         (60000)
+#define SAMPLE_PERIOD   (0.007)
+#define DEG             (M_PI / 180)
+#define ACC_LSB_PER_G   (4096.0)
+#define GYRO_LSB_PER_DPS (65.5)
+#define MAG_LSB_PER_G   (1090.0)
+
+/* bits of RawSensorDataItem_t.Fresh, IMU / magnetometer / barometer */
+#define FRESH_IMU       (1u << 0)
+#define FRESH_MAGNET    (1u << 1)
+#define FRESH_BARO      (1u << 2)
+
+static double noise(void)
+{
+    double u = (rand() + 1.0) / (RAND_MAX + 2.0), v = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+static double quantize(double value, double lsb)
+{
+    return lround(value * lsb) / lsb;
+}
+
+static double wrap(double angle)
+{
+    return fmod(angle + 540.0, 360.0) - 180.0;
+}
+
+int main(void)
+{
+    static double truth[SAMPLES][3], acc[SAMPLES][3], gyro[SAMPLES][3], magnet[SAMPLES][3];
+    static uint8_t fresh[SAMPLES];
+    double local_float[3], local_fixed[3];
+    double local_maxFixedFloat[3] = {0}, local_sumFloat[3] = {0}, local_sumFixed[3] = {0};
+    double local_maxPid = 0, local_maxPidOutput = 0;
+    uint64_t local_start, local_floatCycles, local_fixedCycles;
+    int local_count = 0, local_failed = 0;
+    pid_obj_t local_Pid_t = {0};
+    pid_fixed_obj_t local_PidFixed_t = {0};
+
+    srand(3);
+
+    /* body rates from the euler angle rates, gravity and the earth field rotated into the body frame */
+    for (int i = 0; i < SAMPLES; i++) {
+        double t = i * SAMPLE_PERIOD;
+        double roll = 25 * sin(0.5 * t), pitch = 18 * sin(0.37 * t + 1), yaw = 60 * sin(0.11 * t);
+        double droll = 12.5 * cos(0.5 * t), dpitch = 18 * 0.37 * cos(0.37 * t + 1), dyaw = 60 * 0.11 * cos(0.11 * t);
+        double f = roll * DEG, h = pitch * DEG, heading = (yaw - 90 - (4 + 51 / 60.0)) * DEG;
+        double R[3][3] = {
+            {cos(heading) * cos(h), cos(heading) * sin(h) * sin(f) - sin(heading) * cos(f), cos(heading) * sin(h) * cos(f) + sin(heading) * sin(f)},
+            {sin(heading) * cos(h), sin(heading) * sin(h) * sin(f) + cos(heading) * cos(f), sin(heading) * sin(h) * cos(f) - cos(heading) * sin(f)},
+            {-sin(h), cos(h) * sin(f), cos(h) * cos(f)}};
+        double earth_g[3] = {0, 0, 1}, earth_m[3] = {0.25, 0, -0.4};
+
+        truth[i][0] = roll;
+        truth[i][1] = pitch;
+        truth[i][2] = yaw;
+        gyro[i][0] = quantize(droll - sin(h) * dyaw + 0.3 * noise(), GYRO_LSB_PER_DPS);
+        gyro[i][1] = quantize(cos(f) * dpitch + sin(f) * cos(h) * dyaw + 0.3 * noise(), GYRO_LSB_PER_DPS);
+        gyro[i][2] = quantize(-sin(f) * dpitch + cos(f) * cos(h) * dyaw + 0.3 * noise(), GYRO_LSB_PER_DPS);
+        for (int k = 0; k < 3; k++) {
+            double a = 0, m = 0;
+            for (int j = 0; j < 3; j++) {
+                a += R[j][k] * earth_g[j];
+                m += R[j][k] * earth_m[j];
+            }
+            acc[i][k] = quantize(a + 0.02 * noise(), ACC_LSB_PER_G);
+            magnet[i][k] = quantize(m + 0.005 * noise(), MAG_LSB_PER_G);
+        }
+        fresh[i] = FRESH_IMU | ((i % 2) ? 0 : FRESH_MAGNET) | ((i % 4) ? 0 : FRESH_BARO);
+    }
+
+    local_Pid_t.kp = ROLL_KP;
+    local_Pid_t.ki = ROLL_KI;
+    local_Pid_t.kd = ROLL_KD;
+    local_Pid_t.minIntegralVal = ROLL_INTEGRAL_MIN;
+    local_Pid_t.maxIntegralVal = ROLL_INTEGRAL_MAX;
+    local_Pid_t.blockWeight = ROLL_BLOCK_WEIGHT;
+    local_PidFixed_t.kp = LIB_MATH_FIXED_FLOAT_TO_Q16(ROLL_KP);
+    local_PidFixed_t.ki = LIB_MATH_FIXED_FLOAT_TO_Q16(ROLL_KI);
+    local_PidFixed_t.kd = LIB_MATH_FIXED_FLOAT_TO_Q16(ROLL_KD);
+    local_PidFixed_t.minIntegralVal = LIB_MATH_FIXED_FLOAT_TO_Q16(ROLL_INTEGRAL_MIN);
+    local_PidFixed_t.maxIntegralVal = LIB_MATH_FIXED_FLOAT_TO_Q16(ROLL_INTEGRAL_MAX);
+    local_PidFixed_t.blockWeight = LIB_MATH_FIXED_FLOAT_TO_Q16(ROLL_BLOCK_WEIGHT);
+
+    for (int i = 0; i < SAMPLES; i++) {
+        fusion_float(acc[i], gyro[i], magnet[i], fresh[i], local_float);
+        fusion_fixed(acc[i], gyro[i], magnet[i], fresh[i], local_fixed);
+
+        /* both controllers see the same error so only their arithmetic differs */
+        local_Pid_t.error = (float)(10.0 - local_float[0]);
+        local_PidFixed_t.error = LIB_MATH_FIXED_FLOAT_TO_Q16(local_Pid_t.error);
+        pid_ctrl(&local_Pid_t);
+        pid_ctrl_fixed(&local_PidFixed_t);
+        local_maxPid = fmax(local_maxPid, fabs(local_Pid_t.output - LIB_MATH_FIXED_Q16_TO_FLOAT(local_PidFixed_t.output)));
+        local_maxPidOutput = fmax(local_maxPidOutput, fabs(local_Pid_t.output));
+
+        /* skip the convergence from the zero initial state */
+        if (i < SAMPLES / 10) {
+            continue;
+        }
+        local_count++;
+        for (int k = 0; k < 3; k++) {
+            double e_float = wrap(local_float[k] - truth[i][k]), e_fixed = wrap(local_fixed[k] - truth[i][k]);
+            local_maxFixedFloat[k] = fmax(local_maxFixedFloat[k], fabs(wrap(local_fixed[k] - local_float[k])));
+            local_sumFloat[k] += e_float * e_float;
+            local_sumFixed[k] += e_fixed * e_fixed;
+        }
+    }
+
+    local_start = __rdtsc();
+    for (int i = 0; i < SAMPLES; i++) {
+        fusion_float(acc[i], gyro[i], magnet[i], fresh[i], local_float);
+    }
+    local_floatCycles = __rdtsc() - local_start;
+    local_start = __rdtsc();
+    for (int i = 0; i < SAMPLES; i++) {
+        fusion_fixed(acc[i], gyro[i], magnet[i], fresh[i], local_fixed);
+    }
+    local_fixedCycles = __rdtsc() - local_start;
+
+    printf("fixed_point_fusion_test: max |fixed - float| roll %.3f pitch %.3f yaw %.3f deg\n",
+           local_maxFixedFloat[0], local_maxFixedFloat[1], local_maxFixedFloat[2]);
+    /* the yaw error to the truth is mostly the approximate tilt compensation of the heading, the same in both builds */
+    printf("fixed_point_fusion_test: RMS error to the true attitude, float %.3f %.3f %.3f deg, fixed %.3f %.3f %.3f deg\n",
+           sqrt(local_sumFloat[0] / local_count), sqrt(local_sumFloat[1] / local_count), sqrt(local_sumFloat[2] / local_count),
+           sqrt(local_sumFixed[0] / local_count), sqrt(local_sumFixed[1] / local_count), sqrt(local_sumFixed[2] / local_count));
+    printf("fixed_point_fusion_test: max |fixed - float| roll PID output %.5f (largest output %.3f)\n", local_maxPid, local_maxPidOutput);
+    printf("fixed_point_fusion_test: host cycles per sample (hardware FPU) float %.0f fixed %.0f\n",
+           (double)local_floatCycles / SAMPLES, (double)local_fixedCycles / SAMPLES);
+
+    /* the heading is an atan2 of a few hundred magnetometer counts, its CORDIC resolution is coarser than the tilt's */
+    for (int k = 0; k < 3; k++) {
+        if (local_maxFixedFloat[k] > (k == 2 ? 1.0 : 0.1) || sqrt(local_sumFixed[k] / local_count) > sqrt(local_sumFloat[k] / local_count) + 0.1) {
+            local_failed = 1;
+        }
+    }
+    if (local_maxPid > 1e-3 * (1 + local_maxPidOutput)) {
+        local_failed = 1;
+    }
+    printf("fixed_point_fusion_test: %s\n", local_failed ? "FAIL" : "OK");
+    return local_failed;
+}
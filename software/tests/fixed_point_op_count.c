@@ -0,0 +1,94 @@
+/*
+ * fixed_point_op_count: counts the soft-float library calls one fused sample and one PID step cost without floating
+ * point unit, built once as the firmware is configured and once with SENSOR_FUSION_FIXED_POINT set (host/softfloat.c)
+ */
+#include "softfloat.h"
+
+#include "SensorFusion.c"
+#include "pid.h"
+
+#define SAMPLES     (1000)
+#define PATTERNS    (16)
+
+int softfloat_main(void)
+{
+    static RawSensorDataItem_t local_Raw_t[PATTERNS];
+    SensorFusionDataItem_t local_Fused_t = {0};
+
+    /* a slow swing of the acc and gyro counts, the magnetometer every 2nd sample and the barometer every 4th */
+    for (int i = 0; i < PATTERNS; i++) {
+        int32_t swing = (i < PATTERNS / 2) ? i : PATTERNS - i;
+#if SENSOR_FUSION_FIXED_POINT
+        local_Raw_t[i].Acc.x = (int16_t)(200 * swing);
+        local_Raw_t[i].Acc.y = (int16_t)(-150 * swing);
+        local_Raw_t[i].Acc.z = (int16_t)(4000 - 20 * swing);
+        local_Raw_t[i].Gyro.roll = (int16_t)(300 * swing);
+        local_Raw_t[i].Gyro.pitch = (int16_t)(-200 * swing);
+        local_Raw_t[i].Gyro.yaw = (int16_t)(50 * swing);
+        local_Raw_t[i].Magnet.x = (int16_t)(250 - 10 * swing);
+        local_Raw_t[i].Magnet.y = (int16_t)(10 * swing);
+        local_Raw_t[i].Magnet.z = (int16_t)(-400);
+#else
+        local_Raw_t[i].Acc.x = (200 * swing) / 4096.0f;
+        local_Raw_t[i].Acc.y = (-150 * swing) / 4096.0f;
+        local_Raw_t[i].Acc.z = (4000 - 20 * swing) / 4096.0f;
+        local_Raw_t[i].Gyro.roll = (300 * swing) / 65.5f;
+        local_Raw_t[i].Gyro.pitch = (-200 * swing) / 65.5f;
+        local_Raw_t[i].Gyro.yaw = (50 * swing) / 65.5f;
+        local_Raw_t[i].Magnet.x = (250 - 10 * swing) / 1090.0f;
+        local_Raw_t[i].Magnet.y = (10 * swing) / 1090.0f;
+        local_Raw_t[i].Magnet.z = -400 / 1090.0f;
+#endif
+        local_Raw_t[i].Altitude.altitude = (float)swing;
+#if SENSOR_IMU_FIFO_BATCH
+        local_Raw_t[i].ImuBatch.count = SENSOR_SAMPLE_PERIOD;
+        local_Raw_t[i].ImuBatch.periodUS = 1000;
+#endif
+        local_Raw_t[i].Fresh = SENSOR_FRESH(SENSOR_ID_IMU) | ((i % 2) ? 0 : SENSOR_FRESH(SENSOR_ID_MAGNET)) |
+                               ((i % 4) ? 0 : SENSOR_FRESH(SENSOR_ID_BARO));
+    }
+    Altitude_Kalman_2D_init();
+
+#if SENSOR_FUSION_FIXED_POINT
+    softfloat_print("fixed_point_op_count: SENSOR_FUSION_FIXED_POINT 1\n");
+#else
+    softfloat_print("fixed_point_op_count: SENSOR_FUSION_FIXED_POINT 0\n");
+#endif
+
+    softfloat_reset();
+    for (int i = 0; i < SAMPLES; i++) {
+        SensorFuseWithKalman(&local_Raw_t[i % PATTERNS], &local_Fused_t);
+    }
+    softfloat_report("fixed_point_op_count:   kalman fusion", SAMPLES);
+
+    /* the altitude filter stays in floating point in both builds */
+    softfloat_reset();
+    for (int i = 0; i < SAMPLES; i++) {
+        kalman_filter_2d(local_Raw_t[i % PATTERNS].Altitude.altitude, 1.0f, Ts, local_Raw_t[i % PATTERNS].Fresh & SENSOR_FRESH(SENSOR_ID_BARO));
+    }
+    softfloat_report("fixed_point_op_count:   of which altitude", SAMPLES);
+
+#if SENSOR_FUSION_FIXED_POINT
+    pid_fixed_obj_t local_Pid_t = {0};
+    local_Pid_t.kp = LIB_MATH_FIXED_FLOAT_TO_Q16(ROLL_KP);
+    local_Pid_t.ki = LIB_MATH_FIXED_FLOAT_TO_Q16(ROLL_KI);
+    local_Pid_t.kd = LIB_MATH_FIXED_FLOAT_TO_Q16(ROLL_KD);
+    local_Pid_t.minIntegralVal = LIB_MATH_FIXED_FLOAT_TO_Q16(ROLL_INTEGRAL_MIN);
+    local_Pid_t.maxIntegralVal = LIB_MATH_FIXED_FLOAT_TO_Q16(ROLL_INTEGRAL_MAX);
+    local_Pid_t.blockWeight = LIB_MATH_FIXED_FLOAT_TO_Q16(ROLL_BLOCK_WEIGHT);
+#else
+    pid_obj_t local_Pid_t = {ROLL_KP, ROLL_KI, ROLL_KD, 0, 0, 0, 0, ROLL_INTEGRAL_MAX, ROLL_INTEGRAL_MIN, ROLL_BLOCK_WEIGHT};
+#endif
+    softfloat_reset();
+    for (int i = 0; i < SAMPLES; i++) {
+        local_Pid_t.error = local_Fused_t.roll;
+#if SENSOR_FUSION_FIXED_POINT
+        pid_ctrl_fixed(&local_Pid_t);
+#else
+        pid_ctrl(&local_Pid_t);
+#endif
+    }
+    softfloat_report("fixed_point_op_count:   roll PID", SAMPLES);
+
+    return 0;
+}
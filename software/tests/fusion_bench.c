@@ -0,0 +1,79 @@
+/*
+ * fusion_bench: counts the heap allocations done while fusing samples (there must be none) and measures the host
+ * cycles taken per fused sample of both estimators
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <x86intrin.h>
+
+#include "main.h"
+#include "SensorFusion.h"
+
+static unsigned long global_allocations;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size) { global_allocations++; return __real_malloc(size); }
+void* __wrap_calloc(size_t count, size_t size) { global_allocations++; return __real_calloc(count, size); }
+void* __wrap_realloc(void* ptr, size_t size) { global_allocations++; return __real_realloc(ptr, size); }
+void __wrap_free(void* ptr) { __real_free(ptr); }
+
+static int global_failures;
+
+#define CHECK(COND, ...) do { if (!(COND)) { global_failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+int main(void)
+{
+    enum { SAMPLES = 100000 };
+    RawSensorDataItem_t local_Raw_t = {0};
+    SensorFusionDataItem_t local_Fused_t = {0};
+    uint64_t local_start, local_kalman, local_mahony;
+    unsigned long local_allocations;
+
+#if SENSOR_IMU_FIFO_BATCH
+    /* the fusion integrates over the time the batch spans, 7 samples of the 1 kHz FIFO per collection */
+    local_Raw_t.ImuBatch.count = SENSOR_SAMPLE_PERIOD;
+    local_Raw_t.ImuBatch.periodUS = 1000;
+#endif
+    Altitude_Kalman_2D_init();
+    Attitude_Mahony_init();
+    local_allocations = global_allocations;
+
+    local_start = __rdtsc();
+    for (int i = 0; i < SAMPLES; i++) {
+        local_Raw_t.Acc.x = 0.01f * (i % 7);
+        local_Raw_t.Acc.z = 1.0f;
+        local_Raw_t.Gyro.roll = 0.5f * (i % 5);
+        local_Raw_t.Magnet.x = 0.5f;
+        local_Raw_t.Magnet.z = -0.8f;
+        local_Raw_t.Altitude.altitude = 10.0f * (i % 11);
+        local_Raw_t.Fresh = SENSOR_FRESH(SENSOR_ID_IMU) | ((i % 4) ? 0 : SENSOR_FRESH(SENSOR_ID_MAGNET) | SENSOR_FRESH(SENSOR_ID_BARO));
+        SensorFuseWithKalman(&local_Raw_t, &local_Fused_t);
+    }
+    local_kalman = __rdtsc() - local_start;
+
+    local_start = __rdtsc();
+    for (int i = 0; i < SAMPLES; i++) {
+        local_Raw_t.Gyro.pitch = 0.5f * (i % 3);
+        local_Raw_t.Fresh = SENSOR_FRESH(SENSOR_ID_IMU) | ((i % 4) ? 0 : SENSOR_FRESH(SENSOR_ID_MAGNET) | SENSOR_FRESH(SENSOR_ID_BARO));
+        SensorFuseWithMahony(&local_Raw_t, &local_Fused_t);
+    }
+    local_mahony = __rdtsc() - local_start;
+
+    local_allocations = global_allocations - local_allocations;
+    CHECK(local_allocations == 0, "%lu heap allocations while fusing", local_allocations);
+
+    printf("fusion_bench: heap allocations per fused sample %.3f\n", (double)local_allocations / (2.0 * SAMPLES));
+    printf("fusion_bench: host cycles per kalman sample %.0f, per mahony sample %.0f\n",
+           (double)local_kalman / SAMPLES, (double)local_mahony / SAMPLES);
+
+    if (global_failures) {
+        printf("fusion_bench: %d failures\n", global_failures);
+        return 1;
+    }
+    printf("fusion_bench: OK\n");
+    return 0;
+}
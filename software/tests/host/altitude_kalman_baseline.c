@@ -0,0 +1,183 @@
+/*
+ * the 2D altitude kalman filter of the baseline SensorFusion.c on the baseline matrix library (host/baseline holds a copy
+ * of its matrix.c and matrix.h), kept as the reference of the scalar filter of the tree. the globals, kalman_filter_2d and
+ * Altitude_Kalman_2D_init below are copied as they were; only the entry points at the end stay global (refer to the
+ * Makefile) so the copy can be linked next to the tree's SensorFusion.c. the baseline allocates its temporaries on every
+ * call and leaks some of them, a replay of a few hundred thousand samples is fine with it
+ */
+#include <math.h>
+#include <stdlib.h>
+
+#include "main.h"
+#include "baseline/matrix.c"
+
+#define EPSILON (1.4e-14)
+
+#define BAROMETER_MEASUREMENT_UNCERTAINTY (900)  // 30cm
+
+/* ------------------------------------------------------------ baseline SensorFusion.c */
+
+matrix_2d_t S = {0}, F = {0}, G = {0}, U = {0}, H = {0}, Q = {0}, P = {0}, K = {0}, L = {0}, R = {0}, M = {0}, I = {0};
+float  Ts = SENSOR_SAMPLE_PERIOD/1000.0;
+
+void kalman_filter_2d(float measurement, float inertial_acc)
+{
+    matrix_2d_t temp_1, temp_2, temp_3, temp_4;
+    matrix_2d_t F_T, H_T;
+
+    U.values[0] = inertial_acc;
+
+    // Predict
+    matrix_multiply(&F, &S, &temp_1);
+    matrix_multiply(&G, &U, &temp_2);
+    matrix_add(&temp_1, &temp_2, &S);
+    matrix_clear(&temp_1);
+    matrix_clear(&temp_2);
+
+    // Update
+    matrix_multiply(&F, &P, &temp_1);
+    matrix_transpose(&F, &F_T);
+    matrix_multiply(&temp_1, &F_T, &temp_2);
+    matrix_add(&temp_2, &Q, &P);
+    matrix_clear(&temp_1);
+    matrix_clear(&temp_2);
+
+    // Kalman Gain
+    matrix_transpose(&H, &H_T);
+    matrix_multiply(&H, &P, &temp_1);
+    matrix_multiply(&temp_1, &H_T, &temp_2);
+    matrix_add(&temp_2, &R, &L);
+    matrix_clear(&temp_1);
+    matrix_clear(&temp_2);
+    L.values[0] = 1/(L.values[0]+EPSILON);
+
+    matrix_multiply(&P, &H_T, &temp_1);
+    matrix_multiply(&temp_1, &L, &K);
+    matrix_clear(&temp_1);
+
+    // Update State
+    M.values[0] = measurement;
+    matrix_multiply(&H, &S, &temp_1);
+    matrix_subtract(&M, &temp_1, &temp_2);
+    matrix_multiply(&K, &temp_2, &temp_3);
+    matrix_add(&S, &temp_3, &temp_4);
+    matrix_clear(&S);
+    matrix_copy(&temp_4, &S);
+    matrix_clear(&temp_1);
+    matrix_clear(&temp_2);
+    matrix_clear(&temp_3);
+
+    // Update Uncertainty
+    matrix_multiply(&K, &H, &temp_1);
+    matrix_subtract(&I, &temp_1, &temp_2);
+    matrix_multiply(&temp_2, &P, &temp_3);
+    matrix_clear(&P);
+    matrix_clear(&temp_1);
+    matrix_clear(&temp_2);
+    matrix_copy(&temp_3, &P);
+}
+
+void Altitude_Kalman_2D_init()
+{
+    matrix_2d_t G_T;
+
+    // State Matrix S
+    float* S_values = (float*)malloc(2 * 1 * sizeof(float));
+    S_values[0] = 0; S_values[1] = 0;
+    matrix_set(&S, 2, 1, S_values);
+
+    // Covariance Matrix P
+    float* P_values = (float*)malloc(2 * 2 * sizeof(float));
+    P_values[0] = 0; P_values[1] = 0;
+    P_values[2] = 0; P_values[3] = 0;
+    matrix_set(&P, 2, 2, P_values);
+
+    // State Transition Matrix F
+    float* F_values = (float*)malloc(2 * 2 * sizeof(float));
+    F_values[0] = 1; F_values[1] = Ts;
+    F_values[2] = 0; F_values[3] = 1;
+    matrix_set(&F, 2, 2, F_values);
+
+    // Control Matrix G
+    float* G_values = (float*)malloc(2 * 1 * sizeof(float));
+    G_values[0] = 0.5 * Ts * Ts; G_values[1] = Ts;
+    matrix_set(&G, 2, 1, G_values);
+
+    // Input Matrix U
+    float* U_values = (float*)malloc(1 * 1 * sizeof(float));
+    U_values[0] = 0;
+    matrix_set(&U, 1, 1, U_values);
+
+    // Observation Matrix H
+    float* H_values = (float*)malloc(1 * 2 * sizeof(float));
+    H_values[0] = 1; H_values[1] = 0;
+    matrix_set(&H, 1, 2, H_values);
+
+    // Process Noise Covariance Matrix Q (assume process variance = 1)
+    matrix_transpose(&G, &G_T);
+    matrix_multiply(&G, &G_T, &Q);
+
+    // Measurement Noise Covariance Matrix R
+    float* R_values = (float*)malloc(1 * 1 * sizeof(float));
+    R_values[0] = BAROMETER_MEASUREMENT_UNCERTAINTY;
+    matrix_set(&R, 1, 1, R_values);
+
+    // Intermediate Matrix L
+    float* L_values = (float*)malloc(1 * 1 * sizeof(float));
+    L_values[0] = 0;
+    matrix_set(&L, 1, 1, L_values);
+
+    // Kalman Gain Matrix K
+    float* K_values = (float*)malloc(2 * 1 * sizeof(float));
+    K_values[0] = 0; K_values[1] = 0;
+    matrix_set(&K, 2, 1, K_values);
+
+    // Measurement matrix M
+    float* M_values = (float*)malloc(1 * 1 * sizeof(float));
+    M_values[0] = 0;
+    matrix_set(&M, 1, 1, M_values);
+
+    // Identity Matrix I
+    float* I_values = (float*)malloc(2 * 2 * sizeof(float));
+    I_values[0] = 1; I_values[1] = 0;
+    I_values[2] = 0; I_values[3] = 1;
+    matrix_set(&I, 2, 2, I_values);
+
+}
+
+/* ------------------------------------------------------------ entry points */
+
+void altitude_kalman_baseline_init(void)
+{
+    Altitude_Kalman_2D_init();
+}
+
+/* the baseline ran at the fixed Ts and always had a barometer reading: F, G and Q get the time step of the sample, as
+ * Altitude_Kalman_2D_init computes them, and a sample without a reading gets an infinite measurement variance, its gain is
+ * then exactly 0 and the update leaves the predicted state and covariance as they are */
+void altitude_kalman_baseline_step(float measurement, float inertial_acc, float dt, int measured)
+{
+    matrix_2d_t G_T;
+
+    if (F.values[1] != dt) {
+        F.values[1] = dt;
+        G.values[0] = 0.5 * dt * dt; G.values[1] = dt;
+        matrix_clear(&Q);
+        matrix_transpose(&G, &G_T);
+        matrix_multiply(&G, &G_T, &Q);
+        matrix_clear(&G_T);
+    }
+    R.values[0] = measured ? BAROMETER_MEASUREMENT_UNCERTAINTY : INFINITY;
+
+    kalman_filter_2d(measurement, inertial_acc);
+}
+
+/* altitude, vertical velocity and the covariance by rows */
+void altitude_kalman_baseline_state(float* arg_pState)
+{
+    arg_pState[0] = S.values[0];
+    arg_pState[1] = S.values[1];
+    for (int i = 0; i < 4; i++) {
+        arg_pState[2 + i] = P.values[i];
+    }
+}
@@ -0,0 +1,2 @@
+/* the driver includes "BMP.h", the file is bmp.h (the target is built on a case insensitive file system) */
+#include "bmp.h"
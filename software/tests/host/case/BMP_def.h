@@ -0,0 +1,2 @@
+/* the driver includes "BMP_def.h", the file is bmp_def.h (the target is built on a case insensitive file system) */
+#include "bmp_def.h"
@@ -0,0 +1,184 @@
+/*
+ * the FreeRTOS calls of Service_RTOS_wrapper.c on host threads: a task is a thread that called host_freertos_task, its
+ * notification is a counter under a lock, a queue copies its items under a lock and the ticks are milliseconds of the
+ * monotonic clock. the tasks are preempted by the host scheduler at any point, which is what the tests look for.
+ * xTaskGetTickCount and host_freertos_systick are weak so a test can model the tick interrupt itself
+ */
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+static SysTick_t host_systick;
+
+struct tskTaskControlBlock {
+    pthread_mutex_t lock;
+    pthread_cond_t given;
+    uint32_t count;
+};
+
+struct QueueDefinition {
+    pthread_mutex_t lock;
+    pthread_cond_t sent;
+    uint8_t* items;
+    UBaseType_t length, size, head, count;
+};
+
+static __thread TaskHandle_t current;
+
+static struct timespec deadline(TickType_t ticks)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += ticks / 1000;
+    ts.tv_nsec += (long)(ticks % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+
+static void cond_init(pthread_cond_t* cond)
+{
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+}
+
+TaskHandle_t host_freertos_task(void)
+{
+    current = calloc(1, sizeof *current);
+    pthread_mutex_init(&current->lock, NULL);
+    cond_init(&current->given);
+    return current;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return current;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks)
+{
+    struct timespec until = deadline(ticks);
+    uint32_t value;
+
+    pthread_mutex_lock(&current->lock);
+    while (0 == current->count && ETIMEDOUT != pthread_cond_timedwait(&current->given, &current->lock, &until)) {}
+    value = current->count;
+    if (value) current->count = clear ? 0 : value - 1;
+    pthread_mutex_unlock(&current->lock);
+    return value;
+}
+
+void xTaskNotifyGive(TaskHandle_t handle)
+{
+    pthread_mutex_lock(&handle->lock);
+    handle->count++;
+    pthread_cond_signal(&handle->given);
+    pthread_mutex_unlock(&handle->lock);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t handle, BaseType_t* woken)
+{
+    *woken = pdFALSE;
+    xTaskNotifyGive(handle);
+}
+
+__attribute__((weak)) SysTick_t* host_freertos_systick(void)
+{
+    return &host_systick;
+}
+
+__attribute__((weak)) TickType_t xTaskGetTickCount(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (TickType_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    struct timespec ts = {ticks / 1000, (long)(ticks % 1000) * 1000000L};
+
+    nanosleep(&ts, NULL);
+}
+
+/* the tests start their threads themselves */
+BaseType_t xTaskCreate(TaskFunction_t f, const char* name, uint16_t depth, void* param, UBaseType_t priority, TaskHandle_t* handle)
+{
+    return pdFALSE;
+}
+
+void vTaskStartScheduler(void) {}
+
+uint32_t ulTaskGetIdleRunTimeCounter(void)
+{
+    return 0;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t size)
+{
+    QueueHandle_t queue = calloc(1, sizeof *queue);
+
+    pthread_mutex_init(&queue->lock, NULL);
+    cond_init(&queue->sent);
+    queue->items = malloc(length * size);
+    queue->length = length;
+    queue->size = size;
+    return queue;
+}
+
+/* a full queue refuses the item at once, no writer of the tests waits for room */
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticks)
+{
+    BaseType_t sent = pdFALSE;
+
+    pthread_mutex_lock(&queue->lock);
+    if (queue->count < queue->length) {
+        memcpy(queue->items + ((queue->head + queue->count) % queue->length) * queue->size, item, queue->size);
+        queue->count++;
+        sent = pdTRUE;
+        pthread_cond_signal(&queue->sent);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return sent;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks)
+{
+    struct timespec until = deadline(ticks);
+    BaseType_t received = pdFALSE;
+
+    pthread_mutex_lock(&queue->lock);
+    while (0 == queue->count && ticks && ETIMEDOUT != pthread_cond_timedwait(&queue->sent, &queue->lock, &until)) {}
+    if (queue->count) {
+        memcpy(item, queue->items + queue->head * queue->size, queue->size);
+        queue->head = (queue->head + 1) % queue->length;
+        queue->count--;
+        received = pdTRUE;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return received;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    UBaseType_t count;
+
+    pthread_mutex_lock(&queue->lock);
+    count = queue->count;
+    pthread_mutex_unlock(&queue->lock);
+    return count;
+}
@@ -0,0 +1,39 @@
+/*
+ * the FreeRTOS types and macros Service_RTOS_wrapper.c uses, for a build on host threads (refer to host/freertos.c),
+ * found before the kernel headers of the tree with -iquote
+ */
+#ifndef HOST_FREERTOS_H_
+#define HOST_FREERTOS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void*);
+typedef struct tskTaskControlBlock* TaskHandle_t;
+typedef struct QueueDefinition* QueueHandle_t;
+
+#define pdFALSE                 0
+#define pdTRUE                  1
+#define pdPASS                  1
+#define portTICK_PERIOD_MS      1
+#define portTICK_RATE_MS        1
+#define configTICK_RATE_HZ      1000
+#define configCPU_CLOCK_HZ      144000000
+#define pdMS_TO_TICKS(x)        ((TickType_t)(x))
+#define portYIELD_FROM_ISR(x)   (void)(x)
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+/* the timer of the tick interrupt the micro seconds time reads, every access goes through host_freertos_systick() so a
+ * test can replace it and move the counter on between two accesses; by default the counter and its flag stay 0 */
+typedef struct { uint32_t CTLR; uint32_t SR; uint64_t CNT; uint64_t CMP; } SysTick_t;
+SysTick_t* host_freertos_systick(void);
+#define SysTick (host_freertos_systick())
+
+/* makes the calling thread a task: its notification and xTaskGetCurrentTaskHandle */
+TaskHandle_t host_freertos_task(void);
+
+#endif
@@ -0,0 +1,17 @@
+/* the task calls Service_RTOS_wrapper.c uses, refer to host/freertos.c */
+#ifndef HOST_TASK_H_
+#define HOST_TASK_H_
+
+#include "FreeRTOS.h"
+
+BaseType_t xTaskCreate(TaskFunction_t f, const char* name, uint16_t depth, void* param, UBaseType_t priority, TaskHandle_t* handle);
+void vTaskStartScheduler(void);
+void vTaskDelay(TickType_t ticks);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks);
+void xTaskNotifyGive(TaskHandle_t handle);
+void vTaskNotifyGiveFromISR(TaskHandle_t handle, BaseType_t* woken);
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+uint32_t ulTaskGetIdleRunTimeCounter(void);
+
+#endif
@@ -0,0 +1,12 @@
+/* <math.h> of the freestanding 32 bits soft-float build (host/softfloat.c implements the functions) */
+#ifndef HOST_FREESTANDING_MATH_H_
+#define HOST_FREESTANDING_MATH_H_
+
+double atan2(double y, double x);
+double asin(double x);
+double sqrt(double x);
+double sin(double x);
+double cos(double x);
+void sincos(double x, double* s, double* c);
+
+#endif
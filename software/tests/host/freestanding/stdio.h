@@ -0,0 +1,8 @@
+/* <stdio.h> of the freestanding 32 bits soft-float build, the firmware headers only need the declarations */
+#ifndef HOST_FREESTANDING_STDIO_H_
+#define HOST_FREESTANDING_STDIO_H_
+
+typedef struct FILE FILE;
+int printf(const char* format, ...);
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * one build of the kalman sensor fusion behind a plain interface in physical units, built once with the float fusion and
+ * once with the fixed point fusion (FUSION_VARIANT names the entry point) so a test can link and compare both
+ */
+#include <math.h>
+
+#include "SensorFusion.c"
+
+/* counts per gauss of the HMC5883L at its default gain (HMC5883L_GAIN) */
+#define FUSION_VARIANT_MAGNET_LSB_PER_GAUSS (1090.0)
+
+/* acc in g, gyro in deg/s and magnet in gauss, already quantized to the sensor counts; angles are roll, pitch, yaw in deg */
+void FUSION_VARIANT(const double* arg_pAcc, const double* arg_pGyro, const double* arg_pMagnet, uint8_t arg_u8Fresh, double* arg_pAngles)
+{
+    static RawSensorDataItem_t local_Raw_t;
+    static SensorFusionDataItem_t local_Fused_t;
+    static int local_initialized;
+
+    if (!local_initialized) {
+        Altitude_Kalman_2D_init();
+#if SENSOR_IMU_FIFO_BATCH
+        /* Acc and Gyro stand for the average of a batch of 1 ms FIFO samples spanning the collection period */
+        local_Raw_t.ImuBatch.count = SENSOR_SAMPLE_PERIOD;
+        local_Raw_t.ImuBatch.periodUS = 1000;
+#endif
+        local_initialized = 1;
+    }
+
+#if SENSOR_FUSION_FIXED_POINT
+    local_Raw_t.Acc.x = (int16_t)lround(arg_pAcc[0] * HAL_WRAPPER_ACC_RAW_LSB_PER_G);
+    local_Raw_t.Acc.y = (int16_t)lround(arg_pAcc[1] * HAL_WRAPPER_ACC_RAW_LSB_PER_G);
+    local_Raw_t.Acc.z = (int16_t)lround(arg_pAcc[2] * HAL_WRAPPER_ACC_RAW_LSB_PER_G);
+    local_Raw_t.Gyro.roll = (int16_t)lround(arg_pGyro[0] * HAL_WRAPPER_GYRO_RAW_LSB_PER_DPS);
+    local_Raw_t.Gyro.pitch = (int16_t)lround(arg_pGyro[1] * HAL_WRAPPER_GYRO_RAW_LSB_PER_DPS);
+    local_Raw_t.Gyro.yaw = (int16_t)lround(arg_pGyro[2] * HAL_WRAPPER_GYRO_RAW_LSB_PER_DPS);
+    local_Raw_t.Magnet.x = (int16_t)lround(arg_pMagnet[0] * FUSION_VARIANT_MAGNET_LSB_PER_GAUSS);
+    local_Raw_t.Magnet.y = (int16_t)lround(arg_pMagnet[1] * FUSION_VARIANT_MAGNET_LSB_PER_GAUSS);
+    local_Raw_t.Magnet.z = (int16_t)lround(arg_pMagnet[2] * FUSION_VARIANT_MAGNET_LSB_PER_GAUSS);
+#else
+    local_Raw_t.Acc.x = arg_pAcc[0];
+    local_Raw_t.Acc.y = arg_pAcc[1];
+    local_Raw_t.Acc.z = arg_pAcc[2];
+    local_Raw_t.Gyro.roll = arg_pGyro[0];
+    local_Raw_t.Gyro.pitch = arg_pGyro[1];
+    local_Raw_t.Gyro.yaw = arg_pGyro[2];
+    local_Raw_t.Magnet.x = arg_pMagnet[0];
+    local_Raw_t.Magnet.y = arg_pMagnet[1];
+    local_Raw_t.Magnet.z = arg_pMagnet[2];
+#endif
+    local_Raw_t.Fresh = arg_u8Fresh;
+
+    SensorFuseWithKalman(&local_Raw_t, &local_Fused_t);
+
+#if SENSOR_FUSION_FIXED_POINT
+    arg_pAngles[0] = LIB_MATH_FIXED_Q16_TO_FLOAT(local_Fused_t.roll);
+    arg_pAngles[1] = LIB_MATH_FIXED_Q16_TO_FLOAT(local_Fused_t.pitch);
+    arg_pAngles[2] = LIB_MATH_FIXED_Q16_TO_FLOAT(local_Fused_t.yaw);
+#else
+    arg_pAngles[0] = local_Fused_t.roll;
+    arg_pAngles[1] = local_Fused_t.pitch;
+    arg_pAngles[2] = local_Fused_t.yaw;
+#endif
+}
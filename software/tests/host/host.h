@@ -0,0 +1,3 @@
+/* forced into every host test: the standard integer types of the host instead of the target's "stdint.h" */
+#include <stdint.h>
+#include <stddef.h>
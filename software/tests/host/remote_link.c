@@ -0,0 +1,31 @@
+/*
+ * the link code of the remote control sketch built as C: the Makefile extracts the retransmit constants, the move
+ * command and link state, adaptRetries and sendMove of remote.ino in remote_link.ino.c, with the RF24 methods
+ * renamed to myRadio_ functions the test provides
+ */
+#include <stdbool.h>
+
+#include "comm_pack.h"
+
+bool myRadio_write(const void* buf, uint8_t len);
+uint8_t myRadio_getARC(void);
+void myRadio_setRetries(uint8_t delay, uint8_t count);
+
+#include "remote_link.ino.c"
+
+const unsigned long remote_link_budget_us = RETRY_BUDGET_US;
+const unsigned long remote_link_airtime_us = RETRY_AIRTIME_US;
+
+/* the retransmits setup() gives the radio */
+void remote_link_setup(void)
+{
+    myRadio_setRetries(retryDelay, retryCount);
+}
+
+/* one command of the stable mode, the roll tells the commands apart */
+void remote_link_send(int8_t roll)
+{
+    data.type = DATA_TYPE_MOVE;
+    data.data.move.roll = roll;
+    sendMove();
+}
@@ -0,0 +1,221 @@
+/*
+ * the soft-float routines and the few libc functions of the freestanding 32 bits build, each routine counts its calls
+ * and computes its result with the host SSE unit; the program starts in _start and talks to linux with int 0x80
+ */
+#include "softfloat.h"
+
+enum { SF_ADD, SF_MUL, SF_DIV, SF_CMP, SF_CONV, SF_MATH, SF_COUNT };
+
+static const char* const global_names[SF_COUNT] = {"add/sub", "mul", "div", "compare", "convert", "libm"};
+static unsigned long global_calls[SF_COUNT];
+
+static int sys_call3(int number, int a, int b, int c)
+{
+    int result;
+    __asm__ volatile ("int $0x80" : "=a"(result) : "a"(number), "b"(a), "c"(b), "d"(c) : "memory");
+    return result;
+}
+
+static unsigned length(const char* text)
+{
+    unsigned n = 0;
+    while (text[n]) {
+        n++;
+    }
+    return n;
+}
+
+void softfloat_print(const char* text)
+{
+    sys_call3(4, 1, (int)text, (int)length(text));
+}
+
+/* value / 10^decimals with the given decimals */
+static void print_fixed(unsigned long value, int decimals)
+{
+    char digits[24];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+        if (n == decimals) {
+            digits[n++] = '.';
+            if (!value) {
+                digits[n++] = '0';
+            }
+        }
+    } while (value || n <= decimals);
+    char out[24];
+    for (int i = 0; i < n; i++) {
+        out[i] = digits[n - 1 - i];
+    }
+    out[n] = 0;
+    softfloat_print(out);
+}
+
+void softfloat_reset(void)
+{
+    for (int i = 0; i < SF_COUNT; i++) {
+        global_calls[i] = 0;
+    }
+}
+
+void softfloat_report(const char* name, unsigned samples)
+{
+    unsigned long total = 0;
+    softfloat_print(name);
+    softfloat_print(":");
+    for (int i = 0; i < SF_COUNT; i++) {
+        total += global_calls[i];
+        softfloat_print(" ");
+        softfloat_print(global_names[i]);
+        softfloat_print(" ");
+        print_fixed((global_calls[i] * 10 + samples / 2) / samples, 1);
+    }
+    softfloat_print(", total ");
+    print_fixed((total * 10 + samples / 2) / samples, 1);
+    softfloat_print(" calls per sample\n");
+}
+
+#define BINARY(NAME, TYPE, KIND, OP) TYPE NAME(TYPE a, TYPE b) { global_calls[KIND]++; return a OP b; }
+BINARY(__addsf3, float, SF_ADD, +)
+BINARY(__subsf3, float, SF_ADD, -)
+BINARY(__mulsf3, float, SF_MUL, *)
+BINARY(__divsf3, float, SF_DIV, /)
+BINARY(__adddf3, double, SF_ADD, +)
+BINARY(__subdf3, double, SF_ADD, -)
+BINARY(__muldf3, double, SF_MUL, *)
+BINARY(__divdf3, double, SF_DIV, /)
+
+/* libgcc comparisons: <0, 0 or >0 as a < b, a == b or a > b, unordered gives the value that makes the test false */
+#define COMPARE(NAME, TYPE, UNORDERED) int NAME(TYPE a, TYPE b) \
+    { global_calls[SF_CMP]++; return (a != a || b != b) ? (UNORDERED) : (a < b) ? -1 : (a > b) ? 1 : 0; }
+COMPARE(__eqsf2, float, 1)
+COMPARE(__nesf2, float, 1)
+COMPARE(__ltsf2, float, 1)
+COMPARE(__lesf2, float, 1)
+COMPARE(__gtsf2, float, -1)
+COMPARE(__gesf2, float, -1)
+COMPARE(__eqdf2, double, 1)
+COMPARE(__nedf2, double, 1)
+COMPARE(__ltdf2, double, 1)
+COMPARE(__ledf2, double, 1)
+COMPARE(__gtdf2, double, -1)
+COMPARE(__gedf2, double, -1)
+int __unordsf2(float a, float b) { global_calls[SF_CMP]++; return a != a || b != b; }
+int __unorddf2(double a, double b) { global_calls[SF_CMP]++; return a != a || b != b; }
+
+#define CONVERT(NAME, FROM, TO) TO NAME(FROM a) { global_calls[SF_CONV]++; return (TO)a; }
+CONVERT(__floatsisf, int, float)
+CONVERT(__floatunsisf, unsigned, float)
+CONVERT(__floatdisf, long long, float)
+CONVERT(__floatsidf, int, double)
+CONVERT(__floatunsidf, unsigned, double)
+CONVERT(__fixsfsi, float, int)
+CONVERT(__fixunssfsi, float, unsigned)
+CONVERT(__fixdfsi, double, int)
+CONVERT(__fixunsdfsi, double, unsigned)
+CONVERT(__extendsfdf2, float, double)
+CONVERT(__truncdfsf2, double, float)
+
+double sqrt(double x)
+{
+    global_calls[SF_MATH]++;
+    __asm__ ("sqrtsd %1, %0" : "=x"(x) : "x"(x));
+    return x;
+}
+
+static double x87_atan2(double y, double x)
+{
+    double result;
+    __asm__ ("fpatan" : "=t"(result) : "0"(x), "u"(y) : "st(1)");
+    return result;
+}
+
+double atan2(double y, double x)
+{
+    global_calls[SF_MATH]++;
+    return x87_atan2(y, x);
+}
+
+double asin(double x)
+{
+    double root = 1 - x * x;
+    global_calls[SF_MATH]++;
+    __asm__ ("sqrtsd %1, %0" : "=x"(root) : "x"(root));
+    return x87_atan2(x, root);
+}
+
+void sincos(double x, double* s, double* c)
+{
+    double sine, cosine;
+    global_calls[SF_MATH]++;
+    __asm__ ("fsincos" : "=t"(cosine), "=u"(sine) : "0"(x));
+    *s = sine;
+    *c = cosine;
+}
+
+double sin(double x)
+{
+    global_calls[SF_MATH]++;
+    __asm__ ("fsin" : "+t"(x));
+    return x;
+}
+
+double cos(double x)
+{
+    global_calls[SF_MATH]++;
+    __asm__ ("fcos" : "+t"(x));
+    return x;
+}
+
+void* memcpy(void* dst, const void* src, unsigned n)
+{
+    for (unsigned i = 0; i < n; i++) {
+        ((char*)dst)[i] = ((const char*)src)[i];
+    }
+    return dst;
+}
+
+void* memset(void* dst, int value, unsigned n)
+{
+    for (unsigned i = 0; i < n; i++) {
+        ((char*)dst)[i] = (char)value;
+    }
+    return dst;
+}
+
+/* 64 bits division for the fixed point code, shift and subtract */
+unsigned long long __udivmoddi4(unsigned long long n, unsigned long long d, unsigned long long* remainder)
+{
+    unsigned long long q = 0, r = 0;
+    for (int i = 63; i >= 0; i--) {
+        r = (r << 1) | ((n >> i) & 1);
+        if (r >= d) {
+            r -= d;
+            q |= 1ULL << i;
+        }
+    }
+    if (remainder) {
+        *remainder = r;
+    }
+    return q;
+}
+
+unsigned long long __udivdi3(unsigned long long n, unsigned long long d) { return __udivmoddi4(n, d, 0); }
+
+long long __divdi3(long long n, long long d)
+{
+    int negative = (n < 0) != (d < 0);
+    unsigned long long q = __udivmoddi4(n < 0 ? -(unsigned long long)n : (unsigned long long)n,
+                                        d < 0 ? -(unsigned long long)d : (unsigned long long)d, 0);
+    return negative ? -(long long)q : (long long)q;
+}
+
+void __attribute__((noreturn, force_align_arg_pointer)) _start(void)
+{
+    int status = softfloat_main();
+    for (;;) {
+        sys_call3(1, status, 0, 0);
+    }
+}
@@ -0,0 +1,20 @@
+/*
+ * counters of the soft-float library calls of a freestanding 32 bits build made without floating point unit
+ * (-mno-80387 -mno-sse), the calls the compiler emits are the same libgcc routines the CH32V203 (rv32imac, ilp32) uses
+ */
+#ifndef HOST_SOFTFLOAT_H_
+#define HOST_SOFTFLOAT_H_
+
+/* zeroes the counters */
+void softfloat_reset(void);
+
+/* prints the calls counted since the last reset divided by 'samples' */
+void softfloat_report(const char* name, unsigned samples);
+
+/* prints a line of text */
+void softfloat_print(const char* text);
+
+/* entry point of the test, its return value is the exit status */
+int softfloat_main(void);
+
+#endif
@@ -0,0 +1,486 @@
+/*
+ * i2c_engine_sim: runs the interrupt driven I2C2 engine (MCAL_I2C.c) against a model of the I2C peripheral, its slave
+ * and the bus recovery pins, with a random interrupt latency. the peripheral functions of the SPL and the RTOS wrapper
+ * functions the engine calls are implemented here, one model step is 2.5 us (a byte takes 9 steps at 400 kHz)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "MCAL_I2C.h"
+#include "MCAL_wrapper.h"
+#include "Service_RTOS_wrapper.h"
+#include "ch32v20x_gpio.h"
+#include "ch32v20x_misc.h"
+
+void I2C2_EV_IRQHandler(void);
+void I2C2_ER_IRQHandler(void);
+
+#define FAIL(...) do { printf("i2c_engine_sim: FAIL line %d: ", __LINE__); printf(__VA_ARGS__); printf("\n"); exit(1); } while (0)
+
+#define BYTE_STEPS      (9)
+#define STEPS_PER_MS    (400)
+#define SLAVE_ADDRESS   (0x68)
+
+/* ---------------------------------------------------------------- peripheral model */
+
+enum { BUS_IDLE, BUS_START, BUS_ADDRESS, BUS_ADDRESS_WAIT, BUS_TX, BUS_RX, BUS_HOLD };
+
+static struct {
+    int enabled, ack, pos, startRequest, stopRequest;
+    int itEvent, itBuffer, itError;
+    uint16_t sr1;
+    int sr1Read;            /* STAR1 was read since ADDR was set, reading STAR2 then clears ADDR */
+    int state, busy, receiver;
+    int timer, shifting;
+    uint8_t dr, shift;
+    int drFull;
+    int lastAck;            /* ack given to the last received byte */
+    int latchedAck;         /* ack decided for the byte being received, -1 to use 'ack' when it completes */
+} hw;
+
+/* slave */
+static uint8_t slave_regs[256];
+static int slave_ptr, slave_first_byte, slave_tx_count;
+static int slave_nack_data_at = -1;     /* index of the written data byte the slave NACKs, -1 for none */
+static int stuck;                       /* the peripheral stops moving (clock held) */
+static int sda_low_clocks;              /* SCL pulses before the slave releases SDA */
+
+/* what the bus saw */
+static int rx_count, rx_nacked, bytes_after_nack, bus_stops, stop_after_ack, wrote_bytes;
+
+static void hw_reset(void)
+{
+    memset(&hw, 0, sizeof hw);
+}
+
+void I2C_Init(I2C_TypeDef* I2Cx, I2C_InitTypeDef* I2C_InitStruct) { hw.ack = I2C_InitStruct->I2C_Ack ? 1 : 0; }
+void I2C_Cmd(I2C_TypeDef* I2Cx, FunctionalState NewState) { hw.enabled = NewState; if (!NewState) hw.state = BUS_IDLE; }
+void I2C_GenerateSTART(I2C_TypeDef* I2Cx, FunctionalState NewState) { hw.startRequest = NewState; }
+void I2C_GenerateSTOP(I2C_TypeDef* I2Cx, FunctionalState NewState) { hw.stopRequest = NewState; }
+void I2C_AcknowledgeConfig(I2C_TypeDef* I2Cx, FunctionalState NewState) { hw.ack = NewState; }
+void I2C_NACKPositionConfig(I2C_TypeDef* I2Cx, uint16_t I2C_NACKPosition) { hw.pos = (I2C_NACKPosition == I2C_NACKPosition_Next); }
+void I2C_SoftwareResetCmd(I2C_TypeDef* I2Cx, FunctionalState NewState) { if (NewState) hw_reset(); }
+void I2C_ClearFlag(I2C_TypeDef* I2Cx, uint32_t I2C_FLAG) { hw.sr1 &= ~(uint16_t)(I2C_FLAG & 0xFFFF); }
+void NVIC_Init(NVIC_InitTypeDef* NVIC_InitStruct) { }
+
+void I2C_ITConfig(I2C_TypeDef* I2Cx, uint16_t I2C_IT, FunctionalState NewState)
+{
+    if (I2C_IT & I2C_IT_EVT) hw.itEvent = NewState;
+    if (I2C_IT & I2C_IT_BUF) hw.itBuffer = NewState;
+    if (I2C_IT & I2C_IT_ERR) hw.itError = NewState;
+}
+
+uint16_t I2C_ReadRegister(I2C_TypeDef* I2Cx, uint8_t I2C_Register)
+{
+    if (I2C_Register == I2C_Register_STAR1) {
+        hw.sr1Read = 1;
+        return hw.sr1;
+    }
+    /* STAR2 after STAR1 clears ADDR and starts the data phase */
+    if (hw.sr1Read && (hw.sr1 & I2C_STAR1_ADDR)) {
+        hw.sr1 &= ~I2C_STAR1_ADDR;
+        if (hw.receiver) {
+            hw.state = BUS_RX;
+            hw.shifting = 1;
+            hw.timer = BYTE_STEPS;
+            /* with POS the ack of the first byte was decided during the address phase */
+            hw.latchedAck = hw.pos ? 1 : -1;
+        } else {
+            hw.state = BUS_TX;
+            hw.sr1 |= I2C_STAR1_TXE;
+        }
+    }
+    return 0;
+}
+
+void I2C_Send7bitAddress(I2C_TypeDef* I2Cx, uint8_t Address, uint8_t I2C_Direction)
+{
+    if (!(hw.sr1 & I2C_STAR1_SB)) FAIL("address sent without SB");
+    hw.sr1 &= ~I2C_STAR1_SB;
+    hw.receiver = I2C_Direction;
+    hw.state = BUS_ADDRESS;
+    hw.timer = BYTE_STEPS;
+    hw.dr = Address;
+}
+
+void I2C_SendData(I2C_TypeDef* I2Cx, uint8_t Data)
+{
+    if (hw.state != BUS_TX) FAIL("SendData outside of a write (state %d)", hw.state);
+    hw.sr1 &= ~I2C_STAR1_BTF;
+    if (!hw.shifting) {
+        hw.shift = Data;
+        hw.shifting = 1;
+        hw.timer = BYTE_STEPS;
+        hw.sr1 |= I2C_STAR1_TXE;
+    } else {
+        hw.dr = Data;
+        hw.drFull = 1;
+        hw.sr1 &= ~I2C_STAR1_TXE;
+    }
+}
+
+uint8_t I2C_ReceiveData(I2C_TypeDef* I2Cx)
+{
+    if (!(hw.sr1 & I2C_STAR1_RXNE)) FAIL("DR read while empty");
+    uint8_t value = hw.dr;
+    hw.sr1 &= ~I2C_STAR1_RXNE;
+    if (hw.sr1 & I2C_STAR1_BTF) {
+        /* the byte waiting in the shift register moves to DR and the clock is released */
+        hw.sr1 &= ~I2C_STAR1_BTF;
+        hw.dr = hw.shift;
+        hw.sr1 |= I2C_STAR1_RXNE;
+        if (hw.lastAck && !hw.stopRequest) {
+            hw.shifting = 1;
+            hw.timer = BYTE_STEPS;
+            hw.latchedAck = hw.pos ? hw.ack : -1;
+        }
+    }
+    return value;
+}
+
+/* the recovery drives SCL (PB10) and SDA (PB11) as open drain outputs */
+static int gpio_open_drain, scl_clocks, scl_level = 1, sda_level = 1, manual_stop;
+
+void GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_InitStruct) { gpio_open_drain = (GPIO_InitStruct->GPIO_Mode == GPIO_Mode_Out_OD); }
+
+void GPIO_SetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+    if (!gpio_open_drain) return;
+    if (GPIO_Pin & GPIO_Pin_10) {
+        if (!scl_level) {
+            scl_clocks++;
+            if (sda_low_clocks) sda_low_clocks--;
+        }
+        scl_level = 1;
+    }
+    if (GPIO_Pin & GPIO_Pin_11) {
+        if (!sda_level && scl_level) manual_stop++;
+        sda_level = 1;
+    }
+}
+
+void GPIO_ResetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+    if (!gpio_open_drain) return;
+    if (GPIO_Pin & GPIO_Pin_10) scl_level = 0;
+    if (GPIO_Pin & GPIO_Pin_11) sda_level = 0;
+}
+
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin) { return (sda_low_clocks == 0 && sda_level) ? 1 : 0; }
+
+MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_DelayUS(uint32_t arg_u16US) { return 0; }
+
+static void generate_stop(void)
+{
+    hw.stopRequest = 0;
+    hw.state = BUS_IDLE;
+    hw.busy = 0;
+    hw.shifting = 0;
+    bus_stops++;
+    if (hw.receiver && hw.lastAck) stop_after_ack++;
+}
+
+static void hw_step(void)
+{
+    if (!hw.enabled || stuck) return;
+
+    switch (hw.state) {
+    case BUS_IDLE:
+        if (hw.startRequest) {
+            hw.startRequest = 0;
+            hw.state = BUS_START;
+            hw.timer = 2;
+            hw.busy = 1;
+        } else if (hw.stopRequest) {
+            hw.stopRequest = 0;
+        }
+        break;
+
+    case BUS_START:
+        if (--hw.timer == 0) {
+            hw.sr1 |= I2C_STAR1_SB;
+            hw.state = BUS_HOLD;
+        }
+        break;
+
+    case BUS_ADDRESS:
+        if (--hw.timer == 0) {
+            if ((hw.dr >> 1) == SLAVE_ADDRESS) {
+                hw.sr1 |= I2C_STAR1_ADDR;
+                hw.sr1Read = 0;
+                hw.state = BUS_ADDRESS_WAIT;
+                if (hw.receiver) slave_tx_count = 0;
+                else slave_first_byte = 1;
+            } else {
+                hw.sr1 |= I2C_STAR1_AF;
+                hw.state = BUS_HOLD;
+                hw.receiver = 0;
+            }
+        }
+        break;
+
+    case BUS_TX:
+        if (hw.shifting && --hw.timer == 0) {
+            hw.shifting = 0;
+            if (slave_first_byte) {
+                slave_ptr = hw.shift;
+                slave_first_byte = 0;
+            } else {
+                if (wrote_bytes == slave_nack_data_at) {
+                    hw.sr1 |= I2C_STAR1_AF;
+                    hw.state = BUS_HOLD;
+                    wrote_bytes++;
+                    break;
+                }
+                slave_regs[slave_ptr++] = hw.shift;
+                wrote_bytes++;
+            }
+            if (hw.drFull) {
+                hw.shift = hw.dr;
+                hw.drFull = 0;
+                hw.shifting = 1;
+                hw.timer = BYTE_STEPS;
+                hw.sr1 |= I2C_STAR1_TXE;
+            } else {
+                hw.sr1 |= I2C_STAR1_BTF;
+            }
+        }
+        if (!hw.shifting && (hw.sr1 & I2C_STAR1_BTF)) {
+            if (hw.stopRequest) {
+                hw.sr1 &= ~(I2C_STAR1_BTF | I2C_STAR1_TXE);
+                generate_stop();
+            } else if (hw.startRequest) {
+                hw.startRequest = 0;
+                hw.sr1 &= ~(I2C_STAR1_BTF | I2C_STAR1_TXE);
+                hw.state = BUS_START;
+                hw.timer = 2;
+            }
+        }
+        break;
+
+    case BUS_RX:
+        if (hw.shifting && --hw.timer == 0) {
+            int ack = (hw.latchedAck >= 0) ? hw.latchedAck : hw.ack;
+            uint8_t value = slave_regs[(uint8_t)(slave_ptr + slave_tx_count)];
+
+            hw.shifting = 0;
+            slave_tx_count++;
+            if (rx_nacked) bytes_after_nack++;
+            rx_count++;
+            hw.lastAck = ack;
+            if (!ack) rx_nacked = 1;
+            if (!(hw.sr1 & I2C_STAR1_RXNE)) {
+                hw.dr = value;
+                hw.sr1 |= I2C_STAR1_RXNE;
+                if (ack && !hw.stopRequest) {
+                    hw.shifting = 1;
+                    hw.timer = BYTE_STEPS;
+                    hw.latchedAck = hw.pos ? hw.ack : -1;
+                }
+            } else {
+                /* DR still full, the byte waits in the shift register with the clock stretched */
+                hw.shift = value;
+                hw.sr1 |= I2C_STAR1_BTF;
+            }
+        }
+        if (!hw.shifting && hw.stopRequest && (!(hw.sr1 & I2C_STAR1_BTF) || !hw.lastAck)) {
+            generate_stop();
+        }
+        break;
+
+    case BUS_HOLD:
+    case BUS_ADDRESS_WAIT:
+        if (hw.stopRequest && !(hw.sr1 & (I2C_STAR1_SB | I2C_STAR1_ADDR))) generate_stop();
+        break;
+    }
+}
+
+static int event_pending(void)
+{
+    if (!hw.itEvent) return 0;
+    if (hw.sr1 & (I2C_STAR1_SB | I2C_STAR1_ADDR | I2C_STAR1_BTF)) return 1;
+    return hw.itBuffer && (hw.sr1 & (I2C_STAR1_RXNE | I2C_STAR1_TXE));
+}
+
+static int error_pending(void)
+{
+    return hw.itError && (hw.sr1 & (I2C_STAR1_AF | I2C_STAR1_BERR | I2C_STAR1_ARLO | I2C_STAR1_OVR | I2C_STAR1_TIMEOUT));
+}
+
+/* ---------------------------------------------------------------- RTOS model */
+
+static uint64_t sim_steps;
+static int notified, in_critical, latency = 3;
+
+/* one step of the bus, the pending interrupt is taken after a random latency unless interrupts are masked */
+static void sim_step(void)
+{
+    sim_steps++;
+    hw_step();
+    if (!in_critical && (rand() % latency) == 0) {
+        if (error_pending()) I2C2_ER_IRQHandler();
+        else if (event_pending()) I2C2_EV_IRQHandler();
+    }
+}
+
+static void sim_run(int steps)
+{
+    for (int i = 0; i < steps; i++) sim_step();
+}
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_EnterCritical(void) { in_critical++; return SERVICE_RTOS_STAT_OK; }
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ExitCritical(void) { in_critical--; return SERVICE_RTOS_STAT_OK; }
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_Notify(RTOS_TaskHandle_t arg_TaskToNotify_t, uint8_t arg_u8IsFromISR) { notified++; return SERVICE_RTOS_STAT_OK; }
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentMSTime(uint32_t* arg_pu32CurrentTime)
+{
+    *arg_pu32CurrentTime = (uint32_t)(sim_steps / STEPS_PER_MS);
+    return SERVICE_RTOS_STAT_OK;
+}
+
+/* the waiting task sleeps while the bus runs */
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_WaitForNotification(uint32_t arg_u32TimeoutMS)
+{
+    uint64_t end = sim_steps + (uint64_t)arg_u32TimeoutMS * STEPS_PER_MS + 1;
+    while (!notified && sim_steps < end) sim_step();
+    if (notified) notified--;
+    return SERVICE_RTOS_STAT_OK;
+}
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetCurrentTaskHandle(RTOS_TaskHandle_t* arg_pTaskHandle)
+{
+    *arg_pTaskHandle = (RTOS_TaskHandle_t)0x1234;
+    return SERVICE_RTOS_STAT_OK;
+}
+
+/* ---------------------------------------------------------------- test */
+
+static void reset_counts(void)
+{
+    rx_count = 0;
+    rx_nacked = 0;
+    bytes_after_nack = 0;
+    stop_after_ack = 0;
+    wrote_bytes = 0;
+}
+
+static void check_bus_released(const char* after)
+{
+    sim_run(50);
+    if (hw.busy) FAIL("bus busy after %s", after);
+}
+
+int main(void)
+{
+    I2C_InitTypeDef cfg = {.I2C_ClockSpeed = 400000, .I2C_OwnAddress1 = 0x2F, .I2C_Ack = 1};
+    const int lengths[] = {1, 2, 3, 4, 6, 14};
+    MCAL_I2C_Stats_t stats;
+
+    for (int i = 0; i < 256; i++) slave_regs[i] = (uint8_t)(i * 7 + 3);
+    MCAL_I2C_Init(&cfg);
+
+    for (int seed = 1; seed <= 300; seed++) {
+        srand(seed);
+        latency = 1 + seed % 6;
+
+        /* reads: exact byte count, NACK on the last byte only and a single STOP */
+        for (unsigned k = 0; k < sizeof lengths / sizeof lengths[0]; k++) {
+            int n = lengths[k];
+            uint8_t buffer[20];
+            uint8_t reg = (uint8_t)(rand() % 200);
+            int stops = bus_stops;
+
+            memset(buffer, 0xEE, sizeof buffer);
+            reset_counts();
+            MCAL_I2C_ErrStat_t status = MCAL_I2C_ReadRegs(SLAVE_ADDRESS, reg, buffer, n, 10);
+            if (status != MCAL_I2C_STAT_OK) FAIL("read of %d bytes ended with %d (seed %d)", n, status, seed);
+            for (int i = 0; i < n; i++) {
+                if (buffer[i] != slave_regs[(uint8_t)(reg + i)]) FAIL("byte %d of a %d bytes read (seed %d)", i, n, seed);
+            }
+            if (buffer[n] != 0xEE) FAIL("%d bytes read wrote past the buffer", n);
+            sim_run(50);
+            if (rx_count != n) FAIL("the bus clocked %d bytes for a %d bytes read (seed %d)", rx_count, n, seed);
+            if (!rx_nacked || bytes_after_nack) FAIL("last byte of a %d bytes read not NACKed", n);
+            if (stop_after_ack) FAIL("STOP after an ACK in a %d bytes read", n);
+            if (bus_stops - stops != 1) FAIL("%d STOPs for a %d bytes read (seed %d)", bus_stops - stops, n, seed);
+        }
+
+        /* write */
+        reset_counts();
+        uint8_t value = (uint8_t)rand();
+        if (MCAL_I2C_WriteReg(SLAVE_ADDRESS, 0x6B, value, 10) != MCAL_I2C_STAT_OK || slave_regs[0x6B] != value) FAIL("write (seed %d)", seed);
+        check_bus_released("a write");
+
+        /* NACK of the address then of a data byte */
+        uint8_t buffer[6];
+        if (MCAL_I2C_ReadRegs(0x1E, 3, buffer, 6, 10) != MCAL_I2C_STAT_NACK) FAIL("address NACK (seed %d)", seed);
+        check_bus_released("an address NACK");
+        reset_counts();
+        slave_nack_data_at = 0;
+        if (MCAL_I2C_WriteReg(SLAVE_ADDRESS, 0x10, 1, 10) != MCAL_I2C_STAT_NACK) FAIL("data NACK (seed %d)", seed);
+        slave_nack_data_at = -1;
+        check_bus_released("a data NACK");
+
+        /* transactions queued back to back */
+        MCAL_I2C_Transaction_t queued[5];
+        uint8_t data[5][14];
+        for (int i = 0; i < 5; i++) {
+            MCAL_I2C_Transaction_t t = {SLAVE_ADDRESS, (uint8_t)(i * 20), data[i], (uint8_t)(i * 3 + 1), MCAL_I2C_DIR_READ, (RTOS_TaskHandle_t)1, 0};
+            queued[i] = t;
+            if (MCAL_I2C_Submit(&queued[i]) != MCAL_I2C_STAT_OK) FAIL("submit %d", i);
+        }
+        for (int i = 0; i < 5; i++) {
+            if (MCAL_I2C_Wait(&queued[i], 10) != MCAL_I2C_STAT_OK) FAIL("queued transaction %d (seed %d)", i, seed);
+            for (int j = 0; j < queued[i].dataLen; j++) {
+                if (data[i][j] != slave_regs[i * 20 + j]) FAIL("data of queued transaction %d", i);
+            }
+        }
+        sim_run(50);
+    }
+
+    /* full queue, then a timeout on a slave holding SDA: abort, recover the bus and carry on with the queue */
+    {
+        MCAL_I2C_Transaction_t t[9];
+        uint8_t d[9];
+        int clocks;
+
+        stuck = 1;
+        for (int i = 0; i < 9; i++) {
+            MCAL_I2C_Transaction_t x = {SLAVE_ADDRESS, 0, &d[i], 1, MCAL_I2C_DIR_READ, (RTOS_TaskHandle_t)1, 0};
+            t[i] = x;
+        }
+        for (int i = 0; i < 8; i++) {
+            if (MCAL_I2C_Submit(&t[i]) != MCAL_I2C_STAT_OK) FAIL("filling the queue");
+        }
+        if (MCAL_I2C_Submit(&t[8]) != MCAL_I2C_STAT_QUEUE_FULL) FAIL("queue full not reported");
+
+        sda_low_clocks = 4;
+        clocks = scl_clocks;
+        if (MCAL_I2C_Wait(&t[0], 5) != MCAL_I2C_STAT_TIMEOUT) FAIL("timeout not reported");
+        if (scl_clocks - clocks != 5 || !manual_stop) FAIL("recovery gave %d clocks, manual stop %d", scl_clocks - clocks, manual_stop);
+        stuck = 0;
+        for (int i = 1; i < 8; i++) {
+            if (MCAL_I2C_Wait(&t[i], 10) != MCAL_I2C_STAT_OK || d[i] != slave_regs[0]) FAIL("transaction %d after the recovery (%d)", i, t[i].status);
+        }
+    }
+
+    /* bus error in the middle of a read */
+    {
+        uint8_t d[14];
+        MCAL_I2C_Transaction_t x = {SLAVE_ADDRESS, 0, d, 14, MCAL_I2C_DIR_READ, (RTOS_TaskHandle_t)1, 0};
+
+        MCAL_I2C_Submit(&x);
+        sim_run(40);
+        hw.sr1 |= I2C_STAR1_BERR;
+        if (MCAL_I2C_Wait(&x, 10) != MCAL_I2C_STAT_BUS_ERR) FAIL("bus error reported as %d", x.status);
+        if (MCAL_I2C_ReadRegs(SLAVE_ADDRESS, 5, d, 14, 10) != MCAL_I2C_STAT_OK || d[13] != slave_regs[18]) FAIL("read after the bus error");
+    }
+
+    MCAL_I2C_GetStats(&stats);
+    printf("i2c_engine_sim: completed %u, nacks %u, bus errors %u, timeouts %u, recoveries %u in %.1f simulated seconds\n",
+           (unsigned)stats.completed, (unsigned)stats.nacks, (unsigned)stats.busErrors, (unsigned)stats.timeouts,
+           (unsigned)stats.recoveries, sim_steps / (STEPS_PER_MS * 1000.0));
+    printf("i2c_engine_sim: OK\n");
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * link_loss_sim: sends the commands of the remote control (its link code, refer to host/remote_link.c) to the receive
+ * path of the application board (HAL_wrapper.c) over a radio model losing the packets and the acknowledges at random.
+ * the retransmits of a command must fit in their budget whatever the loss, and the application board must count the
+ * commands that didn't arrive, not the ones that arrived with all their acknowledges lost, and the retransmits of each
+ * command once
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "HAL_wrapper.h"
+#include "MCAL_wrapper.h"
+#include "nrf.h"
+#include "comm_pack.h"
+
+#define FAIL(...) do { printf("link_loss_sim: FAIL line %d: ", __LINE__); printf(__VA_ARGS__); printf("\n"); exit(1); } while (0)
+
+#define COMMANDS        (20000)
+#define OLD_DELAY_US    (1500)      /* SETUP_RETR of the remote control before the adaptation, 1500 us x 15 */
+#define OLD_COUNT       (15)
+
+extern const unsigned long remote_link_budget_us, remote_link_airtime_us;
+void remote_link_setup(void);
+void remote_link_send(int8_t roll);
+
+static double loss;
+static uint8_t retry_delay, retry_count, arc, retry_sets;
+static uint8_t air[NRF_PAYLOAD_LEN], air_len;
+static unsigned long longest_us;
+
+/* what went on, counted on the air */
+static unsigned arrived, acked, gave_up, arrived_unacked;
+
+static int chance(double p)
+{
+    return rand() / (double)RAND_MAX < p;
+}
+
+/* ---------------------------------------------------------------- RF24 of the remote control */
+
+void myRadio_setRetries(uint8_t delay, uint8_t count)
+{
+    retry_delay = delay;
+    retry_count = count;
+    retry_sets++;
+}
+
+uint8_t myRadio_getARC(void)
+{
+    return arc;
+}
+
+/* the first copy that gets through reaches the application board, the radio drops the retransmits of it */
+bool myRadio_write(const void* buf, uint8_t len)
+{
+    unsigned long time_us = 0;
+    int got = 0;
+
+    for (uint8_t tries = 0; tries <= retry_count; tries++) {
+        time_us += remote_link_airtime_us + (tries ? (retry_delay + 1) * 250UL : 0);
+        if (chance(loss)) continue;
+        if (!got) {
+            if (len > sizeof air) FAIL("command of %u bytes", len);
+            memcpy(air, buf, len);
+            air_len = len;
+            arrived++;
+            got = 1;
+        }
+        if (!chance(loss)) {
+            arc = tries;
+            acked++;
+            if (time_us > longest_us) longest_us = time_us;
+            return true;
+        }
+    }
+    if (time_us > longest_us) longest_us = time_us;
+    if (time_us > remote_link_budget_us) FAIL("retransmits of %lu us for %lu", time_us, remote_link_budget_us);
+    arc = retry_count;
+    gave_up++;
+    arrived_unacked += got;
+    return false;
+}
+
+/* ---------------------------------------------------------------- NRF24L01 of the application board */
+
+uint8_t NRF_read(void* buf, uint8_t len)
+{
+    uint8_t width = air_len < len ? air_len : len;
+
+    memcpy(buf, air, width);
+    air_len = 0;
+    return width;
+}
+
+uint8_t NRF_write(const void* buf, uint8_t data_len) { return 1; }
+uint8_t NRF_process(void) { return 0; }
+void NRF_get_stats(NRF_stats_t* stats) { memset(stats, 0, sizeof *stats); }
+
+MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_SetRadioTask(RTOS_TaskHandle_t arg_Task_t) { return MCAL_WRAPPER_STAT_OK; }
+MCAL_UART_ErrStat_t MCAL_UART_Read(uint8_t* arg_pu8Data, uint16_t arg_u16MaxLen, uint16_t* arg_pu16Len) { return MCAL_UART_STAT_OK; }
+MCAL_UART_ErrStat_t MCAL_UART_Send(MCAL_UART_TxFrame_t* arg_pFrame) { return MCAL_UART_STAT_OK; }
+MCAL_UART_ErrStat_t MCAL_UART_SetRxTask(RTOS_TaskHandle_t arg_Task_t) { return MCAL_UART_STAT_OK; }
+MCAL_UART_ErrStat_t MCAL_UART_GetTxStats(MCAL_UART_TxStats_t* arg_pStats) { return MCAL_UART_STAT_OK; }
+
+/* ---------------------------------------------------------------- */
+
+int main(void)
+{
+    static const double losses[] = {0, 0.05, 0.2, 0.5, 0.8};
+    HAL_WRAPPER_RCLinkStats_t stats, last = {0};
+    HAL_WRAPPER_RCMsg_t msg;
+    unsigned long old_us = (OLD_COUNT + 1) * remote_link_airtime_us + OLD_COUNT * (unsigned long)OLD_DELAY_US;
+
+    srand(20);
+    remote_link_setup();
+    for (unsigned l = 0; l < sizeof losses / sizeof losses[0]; l++) {
+        unsigned base_arrived = arrived, base_acked = acked, base_gave_up = gave_up, base_unacked = arrived_unacked;
+        unsigned retransmits = 0;
+        uint8_t last_arc = 0;
+
+        loss = losses[l];
+        longest_us = 0;
+        retry_sets = 0;
+        /* a command carries the retransmits of the one before it, the last one of the loss goes with a clean command */
+        for (int n = 0; n <= COMMANDS; n++) {
+            if (n == COMMANDS) loss = 0;
+            remote_link_send((int8_t)n);
+            if (air_len) {
+                retransmits += last_arc;
+                if (HAL_WRAPPER_STAT_OK != HAL_WRAPPER_RCReceive(&msg)) FAIL("command %d not taken", n);
+                if (msg.MsgToReceive.data.move.roll != (int8_t)n) FAIL("command %d read as %d", n, msg.MsgToReceive.data.move.roll);
+            }
+            last_arc = arc;
+        }
+        HAL_WRAPPER_GetRCLinkStats(&stats);
+
+        unsigned got = arrived - base_arrived, lost = gave_up - base_gave_up;
+        unsigned app_sent = stats.sent - last.sent, app_lost = stats.lost - last.lost;
+        if (stats.acked - last.acked != got) FAIL("%u commands counted for %u received", stats.acked - last.acked, got);
+        if (app_sent != COMMANDS + 1 || app_lost != COMMANDS + 1 - got)
+            FAIL("%.0f%% loss: %u sent and %u lost counted for %u received of %d", losses[l] * 100, app_sent, app_lost, got, COMMANDS + 1);
+        if (stats.retransmits - last.retransmits != retransmits) FAIL("%u retransmits counted for %u", stats.retransmits - last.retransmits, retransmits);
+
+        printf("link_loss_sim: %2.0f%% loss: %5u commands sent, %5u acked, %4u given up (%4u received), app board: %5u sent, %5u lost, "
+               "quality %3u%%, retransmits %2u x %4u us, changed %4u times, longest %4lu us\n",
+               losses[l] * 100, COMMANDS + 1, acked - base_acked, lost, arrived_unacked - base_unacked, app_sent, app_lost,
+               (stats.acked - last.acked) * 100 / app_sent, retry_count, (retry_delay + 1) * 250, retry_sets, longest_us);
+        last = stats;
+    }
+    printf("link_loss_sim: budget %lu us, 1500 us x 15 took up to %lu us\n", remote_link_budget_us, old_us);
+    printf("link_loss_sim: OK\n");
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * mahony_replay_test: flies a known attitude trajectory with a biased and noisy gyroscope through the quaternion (mahony)
+ * estimator, the collection items are built as the sensor task builds them (1 kHz FIFO batches every 7 ms, magnetometer
+ * fresh every second item), and checks the attitude error and the learned gyroscope bias; the kalman fusion gets the same
+ * items for comparison
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <x86intrin.h>
+
+/* the module is included to reach the estimator state (the learned bias) */
+#include "SensorFusion.c"
+
+#define SECONDS     (420)
+#define FRAME_US    (1000)
+#define D2R         (M_PI / 180)
+
+static const double global_bias[3] = {1.5, -2.0, 0.8};     /* deg/s */
+
+static double noise(void)
+{
+    double u = (rand() + 1.0) / (RAND_MAX + 2.0), v = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+static double wrap(double angle)
+{
+    return fmod(angle + 540.0, 360.0) - 180.0;
+}
+
+/* true euler angles (deg), body rates (deg/s), gravity and earth field in the body frame at time t */
+static void trajectory(double t, double* angles, double* rates, double* acc, double* magnet)
+{
+    double roll = 30 * sin(0.5 * t), pitch = 21 * sin(0.37 * t + 1), yaw = 60 * sin(0.11 * t);
+    double droll = 15 * cos(0.5 * t), dpitch = 21 * 0.37 * cos(0.37 * t + 1), dyaw = 60 * 0.11 * cos(0.11 * t);
+    double f = roll * D2R, h = pitch * D2R;
+    double heading = (yaw - MAHONY_YAW_OFFSET - DECLINATION_DEGREE - DECLINATION_MINUTE / 60.0) * D2R;
+    double R[3][3] = {
+        {cos(heading) * cos(h), cos(heading) * sin(h) * sin(f) - sin(heading) * cos(f), cos(heading) * sin(h) * cos(f) + sin(heading) * sin(f)},
+        {sin(heading) * cos(h), sin(heading) * sin(h) * sin(f) + cos(heading) * cos(f), sin(heading) * sin(h) * cos(f) - cos(heading) * sin(f)},
+        {-sin(h), cos(h) * sin(f), cos(h) * cos(f)}};
+    double earth_g[3] = {0, 0, 1}, earth_m[3] = {0.25, 0, -0.4};
+
+    angles[0] = roll;
+    angles[1] = pitch;
+    angles[2] = yaw;
+    rates[0] = droll - sin(h) * dyaw;
+    rates[1] = cos(f) * dpitch + sin(f) * cos(h) * dyaw;
+    rates[2] = -sin(f) * dpitch + cos(f) * cos(h) * dyaw;
+    for (int k = 0; k < 3; k++) {
+        acc[k] = 0;
+        magnet[k] = 0;
+        for (int j = 0; j < 3; j++) {
+            acc[k] += R[j][k] * earth_g[j];
+            magnet[k] += R[j][k] * earth_m[j];
+        }
+    }
+}
+
+int main(void)
+{
+    const int items = SECONDS * 1000 / SENSOR_SAMPLE_PERIOD;
+    static RawSensorDataItem_t local_Raw_t;
+    SensorFusionDataItem_t local_Fused_t = {0}, local_Kalman_t = {0};
+    double angles[3], rates[3], acc[3], magnet[3];
+    double error[3] = {0}, kalman[3] = {0}, learned[3];
+    int count = 0, failed = 0;
+    uint64_t cycles = 0;
+
+    srand(5);
+    Altitude_Kalman_2D_init();
+    Attitude_Mahony_init();
+
+    for (int n = 0; n < items; n++) {
+        double gyro_sum[3] = {0}, acc_sum[3] = {0};
+
+        /* the FIFO samples of this collection period, the item carries their average */
+        for (int i = 0; i < SENSOR_SAMPLE_PERIOD; i++) {
+            trajectory((n * SENSOR_SAMPLE_PERIOD + i + 1) * 1e-3, angles, rates, acc, magnet);
+            for (int k = 0; k < 3; k++) {
+                double g = lround((rates[k] + global_bias[k] + 0.3 * noise()) * HAL_WRAPPER_GYRO_RAW_LSB_PER_DPS);
+                double a = lround((acc[k] + 0.02 * noise()) * HAL_WRAPPER_ACC_RAW_LSB_PER_G);
+                gyro_sum[k] += g;
+                acc_sum[k] += a;
+#if SENSOR_IMU_FIFO_BATCH
+                int16_t* frame_gyro = &local_Raw_t.ImuBatch.frames[i].gyro.roll;
+                int16_t* frame_acc = &local_Raw_t.ImuBatch.frames[i].acc.x;
+                frame_gyro[k] = (int16_t)g;
+                frame_acc[k] = (int16_t)a;
+#endif
+            }
+        }
+#if SENSOR_IMU_FIFO_BATCH
+        local_Raw_t.ImuBatch.count = SENSOR_SAMPLE_PERIOD;
+        local_Raw_t.ImuBatch.periodUS = FRAME_US;
+#endif
+        local_Raw_t.Gyro.roll = gyro_sum[0] / SENSOR_SAMPLE_PERIOD / HAL_WRAPPER_GYRO_RAW_LSB_PER_DPS;
+        local_Raw_t.Gyro.pitch = gyro_sum[1] / SENSOR_SAMPLE_PERIOD / HAL_WRAPPER_GYRO_RAW_LSB_PER_DPS;
+        local_Raw_t.Gyro.yaw = gyro_sum[2] / SENSOR_SAMPLE_PERIOD / HAL_WRAPPER_GYRO_RAW_LSB_PER_DPS;
+        local_Raw_t.Acc.x = acc_sum[0] / SENSOR_SAMPLE_PERIOD / HAL_WRAPPER_ACC_RAW_LSB_PER_G;
+        local_Raw_t.Acc.y = acc_sum[1] / SENSOR_SAMPLE_PERIOD / HAL_WRAPPER_ACC_RAW_LSB_PER_G;
+        local_Raw_t.Acc.z = acc_sum[2] / SENSOR_SAMPLE_PERIOD / HAL_WRAPPER_ACC_RAW_LSB_PER_G;
+
+        /* the magnetometer outputs every other collection, in between the item carries a reading that must not be used
+           (a field turned by 90 degrees here, any use of it shows in the yaw error) */
+        local_Raw_t.Fresh = SENSOR_FRESH(SENSOR_ID_IMU);
+        if ((n % 2) == 0) {
+            local_Raw_t.Magnet.x = magnet[0] + 0.005 * noise();
+            local_Raw_t.Magnet.y = magnet[1] + 0.005 * noise();
+            local_Raw_t.Magnet.z = magnet[2] + 0.005 * noise();
+            local_Raw_t.Fresh |= SENSOR_FRESH(SENSOR_ID_MAGNET);
+        } else {
+            local_Raw_t.Magnet.x = -magnet[1];
+            local_Raw_t.Magnet.y = magnet[0];
+            local_Raw_t.Magnet.z = magnet[2];
+        }
+
+        uint64_t start = __rdtsc();
+        SensorFuseWithMahony(&local_Raw_t, &local_Fused_t);
+        cycles += __rdtsc() - start;
+        SensorFuseWithKalman(&local_Raw_t, &local_Kalman_t);
+
+        /* the first minute lets the bias integrator converge */
+        if (n * SENSOR_SAMPLE_PERIOD > 60000) {
+            double out[3] = {local_Fused_t.roll, local_Fused_t.pitch, local_Fused_t.yaw};
+            double out_kalman[3] = {local_Kalman_t.roll, local_Kalman_t.pitch, local_Kalman_t.yaw};
+            for (int k = 0; k < 3; k++) {
+                double e = wrap(out[k] - angles[k]), e_kalman = wrap(out_kalman[k] - angles[k]);
+                error[k] += e * e;
+                kalman[k] += e_kalman * e_kalman;
+            }
+            count++;
+        }
+    }
+
+    learned[0] = -global_AttitudeMahony_t.bias_x / D2R;
+    learned[1] = -global_AttitudeMahony_t.bias_y / D2R;
+    learned[2] = -global_AttitudeMahony_t.bias_z / D2R;
+    for (int k = 0; k < 3; k++) {
+        error[k] = sqrt(error[k] / count);
+        kalman[k] = sqrt(kalman[k] / count);
+        failed |= error[k] > 1.0 || fabs(learned[k] - global_bias[k]) > 0.2;
+    }
+
+    printf("mahony_replay_test: RMS error roll %.3f pitch %.3f yaw %.3f deg\n", error[0], error[1], error[2]);
+    printf("mahony_replay_test: kalman fusion on the same items roll %.3f pitch %.3f yaw %.3f deg\n", kalman[0], kalman[1], kalman[2]);
+    printf("mahony_replay_test: learned gyro bias %.3f %.3f %.3f deg/s (true %.1f %.1f %.1f)\n",
+           learned[0], learned[1], learned[2], global_bias[0], global_bias[1], global_bias[2]);
+    printf("mahony_replay_test: host cycles per update %.0f\n", (double)cycles / items);
+    printf("mahony_replay_test: %s\n", failed ? "FAIL" : "OK");
+    return failed;
+}
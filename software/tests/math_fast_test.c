@@ -0,0 +1,78 @@
+/*
+ * math_fast_test: sweeps the approximations of Lib/math_fast.h and the CORDIC / Newton functions of Lib/math_fixed.h
+ * against libm in double precision and checks the error bounds their documentation states
+ */
+#include <stdio.h>
+#include <math.h>
+
+#include "math_fast.h"
+#include "math_fixed.h"
+
+static int global_failures;
+
+static void check(const char* name, double error, double bound, const char* unit)
+{
+    int ok = error <= bound;
+    printf("math_fast_test: %-22s max error %-12.4g bound %-8.3g %-4s %s\n", name, error, bound, unit, ok ? "ok" : "FAIL");
+    global_failures += !ok;
+}
+
+int main(void)
+{
+    enum { STEPS = 2000000 };
+    double e_atan2 = 0, e_sincos = 0, e_invsqrt = 0, e_sqrt = 0, e_asin = 0;
+    double f_atan2 = 0, f_sincos = 0, f_invsqrt = 0, f_asin = 0;
+
+    for (int i = 0; i <= STEPS; i++) {
+        double a = -M_PI + 2 * M_PI * i / STEPS;
+        float radius = 0.01f + 50.0f * (i % 97) / 97.0f;
+        float y = sinf((float)a) * radius, x = cosf((float)a) * radius;
+        double d = fabs(LIB_MATH_FAST_f32Atan2(y, x) - atan2(y, x));
+        e_atan2 = fmax(e_atan2, d > M_PI ? 2 * M_PI - d : d);
+
+        /* the angle is rounded to float first so only the approximation is measured */
+        float angle = (float)(a * 300);
+        float s, c;
+        LIB_MATH_FAST_f32SinCos(angle, &s, &c);
+        e_sincos = fmax(e_sincos, fmax(fabs(s - sin(angle)), fabs(c - cos(angle))));
+
+        float v = (float)(1e-4 + i * 1e-3);
+        e_invsqrt = fmax(e_invsqrt, fabs(LIB_MATH_FAST_f32InvSqrt(v) * sqrt(v) - 1));
+        e_sqrt = fmax(e_sqrt, fabs(LIB_MATH_FAST_f32Sqrt(v) / sqrt(v) - 1));
+
+        float u = -1 + 2.0f * i / STEPS;
+        e_asin = fmax(e_asin, fabs(LIB_MATH_FAST_f32Asin(u) - asin(u)));
+    }
+
+    for (int i = -3600; i <= 3600; i++) {
+        double deg = i / 20.0;
+        for (int scale = 16; scale <= (1 << 24); scale <<= 4) {
+            int32_t y = (int32_t)lround(sin(deg * M_PI / 180) * scale), x = (int32_t)lround(cos(deg * M_PI / 180) * scale);
+            double d = fabs(LIB_MATH_FIXED_q16Atan2Deg(y, x) / 65536.0 - atan2(y, x) * 180 / M_PI);
+            f_atan2 = fmax(f_atan2, d > 180 ? 360 - d : d);
+        }
+        LIB_MATH_FIXED_q16_t s, c;
+        LIB_MATH_FIXED_q16SinCosDeg((LIB_MATH_FIXED_q16_t)lround(deg * 65536), &s, &c);
+        f_sincos = fmax(f_sincos, fmax(fabs(s / 65536.0 - sin(deg * M_PI / 180)), fabs(c / 65536.0 - cos(deg * M_PI / 180))));
+    }
+    for (int32_t v = 1; v > 0 && v < 2000000000; v = v + v / 7 + 1) {
+        f_invsqrt = fmax(f_invsqrt, fabs(LIB_MATH_FIXED_q16InvSqrt(v) / 65536.0 - 1 / sqrt(v / 65536.0)) * 65536);
+    }
+    for (int i = -65536; i <= 65536; i++) {
+        f_asin = fmax(f_asin, fabs(LIB_MATH_FIXED_q16AsinDeg(i) / 65536.0 - asin(i / 65536.0) * 180 / M_PI));
+    }
+
+    check("f32Atan2", e_atan2, 1e-5, "rad");
+    check("f32Asin", e_asin, 2e-5, "rad");
+    check("f32SinCos", e_sincos, 1e-6, "");
+    check("f32InvSqrt", e_invsqrt, 5e-6, "rel");
+    check("f32Sqrt", e_sqrt, 5e-6, "rel");
+    check("q16Atan2Deg", f_atan2, 0.01, "deg");
+    check("q16AsinDeg", f_asin, 0.01, "deg");
+    /* no bound is documented for the CORDIC sin/cos, 4 LSB of Q16.16 is asked here */
+    check("q16SinCosDeg", f_sincos, 4 / 65536.0, "");
+    check("q16InvSqrt", f_invsqrt, 0.5, "LSB");
+
+    printf("math_fast_test: %s\n", global_failures ? "FAIL" : "OK");
+    return global_failures != 0;
+}
@@ -0,0 +1,388 @@
+/*
+ * nrf_radio_sim: runs the NRF24L01 driver of the application board (nrf.c) against a register level model of the radio
+ * and of the remote control on the other end of the air. one model step is one micro second.
+ *
+ * the remote sends a sticks packet every 20 ms and retransmits it until it's acknowledged, the packets and the
+ * acknowledges are lost at random. the radio pulls its IRQ pin low on a received packet and the falling edge wakes the
+ * RC task (some edges are missed, the task also wakes on its timeout). the task serves the radio, takes the packets and
+ * queues the telemetry that rides on the acknowledges. the remote must get the telemetry in order, missing only the
+ * payloads whose acknowledges were all lost. some packets come too long for the driver or with a corrupted width, the
+ * driver must clock the exact width of each payload and drop those
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nrf.h"
+#include "nrf24L01.h"
+#include "nrf_config.h"
+#include "MCAL_wrapper.h"
+#include "comm_pack.h"
+
+#define FAIL(...) do { printf("nrf_radio_sim: FAIL line %d: ", __LINE__); printf(__VA_ARGS__); printf("\n"); exit(1); } while (0)
+
+#define COMMAND_PERIOD      (20000)     /* the remote sends the sticks every 20 ms */
+#define RETRY_DELAY         (1500)
+#define RETRY_COUNT         (15)
+#define TASK_SLEEP          (20000)     /* RC_COMM_MAX_SLEEP_MS */
+#define TASK_LATENCY        (300)       /* the higher priority tasks delay the woken task by up to this */
+#define TELEMETRY_PERIOD    (30000)
+#define FIFO_DEPTH          (3)
+#define OVERSIZED_WIDTH     (20)
+#define CORRUPTED_WIDTH     (0xFF)
+#define RUN                 (120000000)
+
+static uint32_t now;
+static double loss, missed_edges, bad_widths;
+
+static int chance(double p)
+{
+    return rand() / (double)RAND_MAX < p;
+}
+
+/* ---------------------------------------------------------------- radio */
+
+typedef struct {
+    uint8_t data[32];
+    uint8_t width;
+} packet_t;
+
+static uint8_t regs[32];
+static packet_t rx_fifo[FIFO_DEPTH], tx_fifo[FIFO_DEPTH];
+static int rx_count, tx_count, ce, irq_high = 1, notified, ack_attached;
+static int spi_index, csn_low;
+static uint8_t command;
+static unsigned edges, lost_edges, oversized, flushes, flushed;
+
+static void fifo_pop(packet_t* fifo, int* count)
+{
+    memmove(fifo, fifo + 1, sizeof(packet_t) * (FIFO_DEPTH - 1));
+    (*count)--;
+}
+
+/* the IRQ pin is low while one of the flags is set, its falling edge notifies the task */
+static void update_irq(void)
+{
+    int high = !(regs[STATUS] & (SHIFT_LEFT(RX_DR) | SHIFT_LEFT(TX_DS) | SHIFT_LEFT(MAX_RT)));
+
+    if (irq_high && !high) {
+        edges++;
+        if (chance(missed_edges)) lost_edges++;
+        else notified = 1;
+    }
+    irq_high = high;
+}
+
+static uint8_t fifo_status(void)
+{
+    return (uint8_t)((rx_count == 0 ? SHIFT_LEFT(RX_EMPTY) : 0) | (tx_count == 0 ? SHIFT_LEFT(TX_EMPTY) : 0) |
+                     (tx_count == FIFO_DEPTH ? SHIFT_LEFT(TX_FULL) : 0));
+}
+
+static int listening(void)
+{
+    return ce && (regs[CONFIG] & SHIFT_LEFT(PRIM_RX)) && (regs[CONFIG] & SHIFT_LEFT(PWR_UP));
+}
+
+void CSN_LOW()
+{
+    if (csn_low) FAIL("chip select already low");
+    csn_low = 1;
+    spi_index = 0;
+}
+
+void CSN_HIGH()
+{
+    csn_low = 0;
+    if (command == R_RX_PAYLOAD) {
+        if (rx_count == 0) FAIL("payload read from an empty RX FIFO");
+        if (spi_index - 1 != rx_fifo[0].width) FAIL("payload of %u bytes read in %d", rx_fifo[0].width, spi_index - 1);
+        oversized += rx_fifo[0].width > NRF_PAYLOAD_LEN;
+        fifo_pop(rx_fifo, &rx_count);
+    } else if (command == (W_ACK_PAYLOAD | NRF_ACK_PIPE)) {
+        if (tx_count == FIFO_DEPTH) FAIL("ACK payload written to a full TX FIFO");
+        tx_fifo[tx_count++].width = (uint8_t)(spi_index - 1);
+    }
+    update_irq();
+}
+
+void CE_LOW() { ce = 0; }
+void CE_HIGH() { ce = 1; }
+
+uint8_t SPI_transfer(uint8_t data)
+{
+    uint8_t out = 0;
+    int i = spi_index++ - 1;
+
+    if (!csn_low) FAIL("clock without the chip select");
+    if (i < 0) {
+        command = data;
+        if (command == FLUSH_RX) {
+            flushes++;
+            flushed += rx_count;
+            rx_count = 0;
+        }
+        if (command == FLUSH_TX) tx_count = 0;
+        if ((command & 0xF8) == W_ACK_PAYLOAD && command != (W_ACK_PAYLOAD | NRF_ACK_PIPE)) FAIL("ACK payload on pipe %d", command & 7);
+        return (uint8_t)(regs[STATUS] | (rx_count ? 0 : 0x0E));
+    }
+
+    if (command == R_RX_PAYLOAD) {
+        if (i >= 32) FAIL("payload read past 32 bytes");
+        out = rx_fifo[0].data[i];
+    } else if (command == R_RX_PL_WID) {
+        out = rx_fifo[0].width;
+    } else if (command == (W_ACK_PAYLOAD | NRF_ACK_PIPE)) {
+        if (i >= 32) FAIL("payload written past 32 bytes");
+        tx_fifo[tx_count].data[i] = data;
+    } else if ((command & 0xE0) == WRITE_REG) {
+        uint8_t reg = command & 0x1F;
+        if (reg == STATUS) regs[STATUS] &= (uint8_t)~(data & 0x70);
+        else if (i == 0) regs[reg] = data;
+    } else if ((command & 0xE0) == READ_REG) {
+        uint8_t reg = command & 0x1F;
+        out = reg == FIFO_STATUS ? fifo_status() : regs[reg];
+    }
+    return out;
+}
+
+/* ---------------------------------------------------------------- remote control */
+
+static uint8_t remote_seq, last_seq = 0xFF, last_id;
+static int remote_tries, got_head;
+static uint32_t remote_next;
+static unsigned sent, given_up, accepted, pops, missed_pops, telemetry;
+static uint32_t arrival[256];       /* time each sticks packet got in the RX FIFO, by sequence number */
+
+static uint8_t telemetry_width(uint8_t id)
+{
+    return (uint8_t)(2 + id % (NRF_PAYLOAD_LEN - 1));
+}
+
+/* the remote takes the ACK payload of an acknowledge it got */
+static void remote_telemetry(const packet_t* p)
+{
+    uint8_t id = p->data[1];
+
+    if (p->width != telemetry_width(id)) FAIL("telemetry %u of %u bytes", id, p->width);
+    for (int i = 2; i < p->width; i++) {
+        if (p->data[i] != (uint8_t)(id ^ i)) FAIL("telemetry %u corrupted", id);
+    }
+    if (telemetry && (uint8_t)(id - last_id - 1) >= 128) FAIL("telemetry %u got after %u", id, last_id);
+    last_id = id;
+    telemetry++;
+}
+
+/*
+ * one attempt of the remote. a packet with a new sequence number tells the radio the acknowledge before it went
+ * through, the radio drops the ACK payload it carried and sets TX_DS. the acknowledge carries the payload at the head
+ * of the TX FIFO
+ */
+static void remote_attempt(void)
+{
+    int acked = 0;
+
+    if (listening() && !chance(loss) && (remote_seq == last_seq || rx_count < FIFO_DEPTH)) {
+        if (remote_seq != last_seq) {
+            if (ack_attached) {
+                fifo_pop(tx_fifo, &tx_count);
+                regs[STATUS] |= SHIFT_LEFT(TX_DS);
+                ack_attached = 0;
+                missed_pops += !got_head;
+                got_head = 0;
+                pops++;
+            }
+            packet_t* p = &rx_fifo[rx_count++];
+            memset(p, 0, sizeof *p);
+            p->data[0] = LIB_COMM_PACK_TYPE_STICKS;
+            p->data[2] = remote_seq;
+            p->width = LIB_COMM_PACK_STICKS_LEN;
+            if (chance(bad_widths)) p->width = (rand() & 1) ? OVERSIZED_WIDTH : CORRUPTED_WIDTH;
+            arrival[remote_seq] = now;
+            regs[STATUS] |= SHIFT_LEFT(RX_DR);
+            last_seq = remote_seq;
+            accepted++;
+        }
+        update_irq();
+        ack_attached = tx_count > 0;
+        acked = !chance(loss);
+        if (acked && ack_attached && !got_head) {
+            remote_telemetry(&tx_fifo[0]);
+            got_head = 1;
+        }
+    }
+
+    if (acked || ++remote_tries > RETRY_COUNT) {
+        given_up += !acked;
+        remote_tries = 0;
+        remote_seq++;
+        sent++;
+        remote_next += COMMAND_PERIOD;
+    } else {
+        remote_next = now + RETRY_DELAY;
+    }
+}
+
+static void advance(uint32_t us)
+{
+    while (us--) {
+        now++;
+        if (now >= remote_next) remote_attempt();
+    }
+}
+
+MCAL_WRAPPER_ErrStat_t MCAL_WRAPPER_DelayUS(uint32_t arg_u16US)
+{
+    advance(arg_u16US);
+    return MCAL_WRAPPER_STAT_OK;
+}
+
+/* ---------------------------------------------------------------- RC task */
+
+extern uint8_t global_NRFTxCount;
+
+typedef struct {
+    unsigned sent, given_up, accepted, read, edges, lost_edges;
+    unsigned written, refused, pops, missed_pops, telemetry, left, got_head;
+    unsigned oversized, flushes, flushed;
+    uint32_t max_latency;
+    NRF_stats_t stats;
+} result_t;
+
+/* the loop of Task_RCComm: sleep until the IRQ pin or the timeout, queue the telemetry, serve the radio, take the packets */
+static result_t run(double arg_loss, double arg_missed_edges, double arg_bad_widths)
+{
+    result_t r = {0};
+    NRF_stats_t before;
+    uint8_t buf[NRF_PAYLOAD_LEN + 4], expected = 0, id = 0;
+    uint8_t len;
+    uint32_t next_telemetry;
+
+    loss = arg_loss;
+    missed_edges = arg_missed_edges;
+    bad_widths = arg_bad_widths;
+    now = 0;
+    memset(regs, 0, sizeof regs);
+    rx_count = tx_count = ack_attached = notified = 0;
+    irq_high = 1;
+    remote_seq = 0;
+    last_seq = 0xFF;
+    remote_tries = 0;
+    remote_next = UINT32_MAX;       /* the remote starts once the radio listens */
+    sent = given_up = accepted = edges = lost_edges = 0;
+    pops = missed_pops = telemetry = 0;
+    got_head = 0;
+    NRF_get_stats(&before);         /* the driver counts from boot */
+
+    NRF_init();
+    if (regs[FEATURE] != (SHIFT_LEFT(EN_DPL) | SHIFT_LEFT(EN_ACK_PAY)) || regs[DYNPD] != (SHIFT_LEFT(DPL_P0) | SHIFT_LEFT(DPL_P1)))
+        FAIL("dynamic payload length and ACK payload not enabled");
+    if (regs[SETUP_RETR] != NRF_SETUP_RETR || regs[RF_CH] != NRF_RF_CHANNEL) FAIL("retransmits or channel not set");
+    NRF_start_listening();
+    oversized = flushes = flushed = 0;  /* not the flush of NRF_init */
+    remote_next = now + 1000;
+    next_telemetry = now;
+    expected = remote_seq;
+
+    while (now < RUN) {
+        uint32_t wake = now + TASK_SLEEP;
+
+        while (!notified && now < wake) advance(1);
+        notified = 0;
+        advance(rand() % TASK_LATENCY);
+
+        while (now >= next_telemetry) {
+            buf[0] = LIB_COMM_PACK_TYPE_INFO;
+            buf[1] = id;
+            for (int i = 2; i < telemetry_width(id); i++) buf[i] = (uint8_t)(id ^ i);
+            if (NRF_write(buf, telemetry_width(id))) r.written++;
+            else r.refused++;
+            id++;
+            next_telemetry += TELEMETRY_PERIOD;
+        }
+        NRF_process();
+        if (!listening()) FAIL("not listening after NRF_process");
+        while ((len = NRF_read(buf, sizeof buf))) {
+            uint8_t seq = buf[2];
+            if (buf[0] != LIB_COMM_PACK_TYPE_STICKS || len != LIB_COMM_PACK_STICKS_LEN) FAIL("packet of type 0x%02X and %u bytes", buf[0], len);
+            if ((uint8_t)(seq - expected) >= 128) FAIL("sticks %u read after %u", seq, expected - 1);
+            expected = seq + 1;
+            if (now - arrival[seq] > r.max_latency) r.max_latency = now - arrival[seq];
+            r.read++;
+        }
+    }
+
+    /* what is left in the radio is taken by the next wake up */
+    NRF_process();
+    while (NRF_read(buf, sizeof buf)) r.read++;
+
+    r.sent = sent;
+    r.given_up = given_up;
+    r.accepted = accepted;
+    r.edges = edges;
+    r.lost_edges = lost_edges;
+    r.pops = pops;
+    r.missed_pops = missed_pops;
+    r.telemetry = telemetry;
+    r.left = global_NRFTxCount + tx_count;
+    r.got_head = got_head;
+    r.oversized = oversized;
+    r.flushes = flushes;
+    r.flushed = flushed;
+    NRF_get_stats(&r.stats);
+    r.stats.irqs -= before.irqs;
+    r.stats.rx_packets -= before.rx_packets;
+    r.stats.rx_overflows -= before.rx_overflows;
+    r.stats.rx_invalid -= before.rx_invalid;
+    r.stats.tx_packets -= before.tx_packets;
+    r.stats.tx_queue_full -= before.tx_queue_full;
+    return r;
+}
+
+int main(void)
+{
+    result_t clean, lossy, bad;
+
+    srand(17);
+    clean = run(0, 0, 0);
+    if (clean.given_up || clean.read != clean.sent) FAIL("clean link: %u of %u sticks read", clean.read, clean.sent);
+    if (clean.stats.rx_packets != clean.read || clean.stats.rx_overflows || clean.stats.rx_invalid) FAIL("clean link counters");
+    if (clean.max_latency > TASK_LATENCY) FAIL("clean link: a packet waited %u us", clean.max_latency);
+    if (clean.refused || clean.missed_pops || clean.telemetry != clean.pops + clean.got_head) FAIL("clean link: %u of %u telemetry got, %u refused, %u popped, %u missed", clean.telemetry, clean.written, clean.refused, clean.pops, clean.missed_pops);
+
+    /* one packet of a hundred too long or with a corrupted width, the flush of the RX FIFO drops the packets behind it */
+    lossy = run(0.1, 0.05, 0.01);
+    if (lossy.read + lossy.stats.rx_overflows + lossy.oversized + lossy.flushed != lossy.accepted)
+        FAIL("lossy link: %u of %u accepted sticks read", lossy.read, lossy.accepted);
+    if (lossy.oversized == 0 || lossy.flushes == 0 || lossy.stats.rx_invalid != lossy.oversized + lossy.flushes)
+        FAIL("lossy link: %u invalid packets counted for %u too long and %u flushes", lossy.stats.rx_invalid, lossy.oversized, lossy.flushes);
+    if (lossy.stats.rx_packets != lossy.read) FAIL("lossy link counters");
+    if (lossy.lost_edges == 0) FAIL("no missed IRQ edge");
+    if (lossy.max_latency > TASK_SLEEP + TASK_LATENCY) FAIL("lossy link: a packet waited %u us", lossy.max_latency);
+
+    /* a link so bad the remote gives up some packets, the ACK payloads of their acknowledges are lost */
+    bad = run(0.7, 0.05, 0);
+    if (bad.read + bad.stats.rx_overflows != bad.accepted) FAIL("bad link: %u of %u accepted sticks read", bad.read, bad.accepted);
+    if (bad.given_up == 0 || bad.missed_pops == 0) FAIL("bad link: no packet given up");
+
+    /* the sent ACK payloads are the ones the remote got and the ones whose acknowledges were lost, the remote may also
+       have the one in the TX FIFO */
+    for (int i = 0; i < 3; i++) {
+        result_t* r = i == 0 ? &clean : i == 1 ? &lossy : &bad;
+        if (r->stats.tx_packets != r->pops || r->telemetry + r->missed_pops != r->pops + r->got_head) FAIL("telemetry counters");
+        if (r->pops + r->left != r->written || r->stats.tx_queue_full != r->refused) FAIL("telemetry queued and not sent");
+    }
+
+    printf("nrf_radio_sim: clean link: %u sticks sent, %u read, %u IRQ edges, %u served, longest wait %u us, %u telemetry got of %u\n",
+           clean.sent, clean.read, clean.edges, clean.stats.irqs, clean.max_latency, clean.telemetry, clean.written);
+    printf("nrf_radio_sim: 10%% loss, 5%% missed edges: %u sticks sent, %u given up, %u read, %u IRQ edges (%u missed), longest wait %u us\n",
+           lossy.sent, lossy.given_up, lossy.read, lossy.edges, lossy.lost_edges, lossy.max_latency);
+    printf("nrf_radio_sim: 10%% loss: %u too long and %u corrupted widths dropped (%u packets flushed)\n", lossy.oversized, lossy.flushes,
+           lossy.flushed);
+    printf("nrf_radio_sim: 10%% loss: %u telemetry written, %u refused, %u got by the remote, %u sent with lost acknowledges\n",
+           lossy.written, lossy.refused, lossy.telemetry, lossy.missed_pops);
+    printf("nrf_radio_sim: 70%% loss: %u sticks sent, %u given up, %u read, %u telemetry written, %u refused, %u got by the remote, %u sent with lost acknowledges\n",
+           bad.sent, bad.given_up, bad.read, bad.written, bad.refused, bad.telemetry, bad.missed_pops);
+    printf("nrf_radio_sim: OK\n");
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * rtos_clock_test: the micro seconds time of Service_RTOS_wrapper.c against a model of the systick timer and of the tick
+ * interrupt: the counter counts the cycles and restarts every tick setting its flag, the interrupt clears the flag and
+ * counts the tick a few register accesses later from a task, or only once the caller is done from an ISR or a critical
+ * section. the calls start on every cycle around a restart and then at random points of a long run, and must give the
+ * time of one of the cycles they ran over and never go backwards
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Service_RTOS_wrapper.h"
+
+#define PERIOD          (configCPU_CLOCK_HZ / configTICK_RATE_HZ)   /* cycles per tick */
+#define CYCLES_PER_US   (configCPU_CLOCK_HZ / 1000000)
+#define AROUND          (400)                                        /* cycles swept on both sides of a restart */
+#define RUN_CALLS       (2000000)
+
+static int global_failures;
+
+#define CHECK(COND, ...) do { if (!(COND)) { global_failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+static SysTick_t registers;
+static uint64_t now;            /* cycles */
+static uint32_t step;           /* cycles between two accesses to the timer or to the tick count */
+static uint32_t latency;        /* cycles from the restart to the tick interrupt when it isn't masked */
+static int masked;              /* the caller is an ISR or is in a critical section */
+static TickType_t ticks;        /* counted by the tick interrupt */
+
+/* the tick interrupt runs as soon as it's pending for long enough and not masked */
+static void advance(uint64_t arg_cycles)
+{
+    now += arg_cycles;
+    if (!masked && ticks < now / PERIOD && now - (uint64_t)(ticks + 1) * PERIOD >= latency) {
+        ticks++;
+    }
+}
+
+SysTick_t* host_freertos_systick(void)
+{
+    advance(step);
+    registers.CMP = PERIOD;
+    registers.CNT = now % PERIOD;
+    registers.SR = ticks < now / PERIOD;
+    return &registers;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    advance(step);
+    return ticks;
+}
+
+/* the time as it was computed before the flag was checked, to show the sweep reaches a restart still pending */
+static uint32_t unflagged_time(void)
+{
+    TickType_t local_TickCount;
+    uint32_t local_u32SysTickCount;
+
+    do {
+        local_TickCount = xTaskGetTickCount();
+        local_u32SysTickCount = (uint32_t)SysTick->CNT;
+    } while (local_TickCount != xTaskGetTickCount());
+    return local_TickCount * (1000000 / configTICK_RATE_HZ) + local_u32SysTickCount / CYCLES_PER_US;
+}
+
+/* a call must return the time of one of the cycles it ran over */
+static int in_call(uint32_t arg_time, uint64_t arg_start, uint64_t arg_end)
+{
+    return arg_time >= arg_start / CYCLES_PER_US && arg_time <= arg_end / CYCLES_PER_US;
+}
+
+/* ---------------------------------------------------------------- around a restart */
+
+static void sweep(void)
+{
+    static const uint32_t steps[] = {1, 3, 7, 13, 40};
+    static const uint32_t latencies[] = {0, 20, 150};
+    unsigned long calls = 0, wrong = 0, backwards = 0, unflagged_wrong = 0;
+    long unflagged_worst = 0;
+
+    for (int local_masked = 0; local_masked <= 1; local_masked++) {
+        for (unsigned s = 0; s < sizeof steps / sizeof steps[0]; s++) {
+            for (unsigned l = 0; l < sizeof latencies / sizeof latencies[0]; l++) {
+                for (int offset = -AROUND; offset <= AROUND; offset++) {
+                    uint64_t local_start, local_end;
+                    uint32_t local_first, local_second, local_unflagged;
+                    uint64_t local_restart = (uint64_t)(5 + offset % 3) * PERIOD;
+
+                    /* the restart at local_restart is pending at the start when the offset is past it and the
+                     * interrupt had no time to run */
+                    masked = local_masked;
+                    step = steps[s];
+                    latency = latencies[l];
+                    now = local_restart + offset;
+                    ticks = now / PERIOD;
+                    if (offset >= 0 && (masked || (uint32_t)offset < latency)) ticks--;
+
+                    local_start = now;
+                    SERVICE_RTOS_CurrentUSTime(&local_first);
+                    local_end = now;
+                    SERVICE_RTOS_CurrentUSTime(&local_second);
+                    calls++;
+                    wrong += !in_call(local_first, local_start, local_end);
+                    backwards += local_second < local_first;
+
+                    /* the same call without the flag, from the same state */
+                    now = local_start;
+                    ticks = now / PERIOD;
+                    if (offset >= 0 && (masked || (uint32_t)offset < latency)) ticks--;
+                    local_unflagged = unflagged_time();
+                    if (!in_call(local_unflagged, local_start, now)) {
+                        long local_error = (long)(local_start / CYCLES_PER_US) - (long)local_unflagged;
+
+                        unflagged_wrong++;
+                        if (local_error > unflagged_worst) unflagged_worst = local_error;
+                    }
+                }
+            }
+        }
+    }
+
+    printf("rtos_clock_test: %lu calls around a restart, %lu out of the call, %lu going backwards "
+           "(without the flag: %lu out of the call, up to %ld us early)\n",
+           calls, wrong, backwards, unflagged_wrong, unflagged_worst);
+    CHECK(wrong == 0 && backwards == 0, "time out of the call or going backwards around a restart");
+    CHECK(unflagged_wrong > 0, "the sweep never reached a restart with its interrupt pending");
+}
+
+/* ---------------------------------------------------------------- long run */
+
+/* calls from tasks and from ISRs or critical sections holding the tick interrupt back for up to most of a tick */
+static void run(void)
+{
+    unsigned long wrong = 0, backwards = 0, pending = 0;
+    uint32_t last = 0;
+
+    srand(1);
+    now = 0;
+    ticks = 0;
+    latency = 60;
+    masked = 0;
+    for (long n = 0; n < RUN_CALLS; n++) {
+        uint64_t local_start;
+        uint32_t local_time;
+
+        step = 1 + rand() % 20;
+        masked = 0;
+        advance(rand() % (PERIOD / 8));
+        if (0 == rand() % 4) {
+            /* the interrupt is masked some time before the call and the tick in between stays pending */
+            masked = 1;
+            advance(rand() % (PERIOD / 2));
+            pending += ticks < now / PERIOD;
+        }
+        local_start = now;
+        SERVICE_RTOS_CurrentUSTime(&local_time);
+        wrong += !in_call(local_time, local_start, now);
+        backwards += local_time < last;
+        last = local_time;
+    }
+    masked = 0;
+
+    printf("rtos_clock_test: %d calls over %.1f s, %lu with a tick pending, %lu out of the call, %lu going backwards\n",
+           RUN_CALLS, (double)now / configCPU_CLOCK_HZ, pending, wrong, backwards);
+    CHECK(pending > 0 && wrong == 0 && backwards == 0, "time out of the call or going backwards on the long run");
+}
+
+int main(void)
+{
+    sweep();
+    run();
+
+    if (global_failures) {
+        printf("rtos_clock_test: %d failures\n", global_failures);
+        return 1;
+    }
+    printf("rtos_clock_test: OK\n");
+    return 0;
+}
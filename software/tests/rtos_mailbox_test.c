@@ -0,0 +1,300 @@
+/*
+ * rtos_mailbox_test: the latest item mailbox of Service_RTOS_wrapper.c between host threads (refer to host/freertos.c).
+ * a writer publishes items whose every word depends on their sequence number and yields in the middle of them while a
+ * reader checks every item it gets and holds some across a yield; a reader sleeping in SERVICE_RTOS_WaitForMailbox must
+ * be woken by every publish; then the age of the items a reader gets from a mailbox and from a queue with a writer every
+ * ms, with a fast reader and with one slower than the writer as the master task behind the fusion
+ */
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Service_RTOS_wrapper.h"
+
+#define WORDS           (64)        /* 256 bytes, about a collection of the sensors with the IMU batch */
+#define TORN_SECONDS    (1.0)
+#define WAKEUPS         (20000)
+#define AGE_ITEMS       (600)
+
+static int global_failures;
+
+#define CHECK(COND, ...) do { if (!(COND)) { global_failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+typedef struct {
+    uint32_t sequence;
+    uint64_t stampNS;
+    uint32_t words[WORDS];
+} item_t;
+
+static item_t storage[SERVICE_RTOS_MAILBOX_BUFFERS];
+static RTOS_Mailbox_t mailbox;
+static RTOS_QueueHandle_t queue;
+static volatile int stop;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void sleep_ns(uint64_t ns)
+{
+    struct timespec ts = {ns / 1000000000ULL, ns % 1000000000ULL};
+
+    nanosleep(&ts, NULL);
+}
+
+static int compare(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+
+    return x < y ? -1 : x > y;
+}
+
+static void create(void)
+{
+    memset(storage, 0, sizeof storage);
+    SERVICE_RTOS_CreateMailbox(sizeof(item_t), storage, &mailbox);
+}
+
+/* ---------------------------------------------------------------- torn items */
+
+static uint32_t published;
+
+static int intact(const item_t* arg_pItem, uint32_t arg_sequence)
+{
+    if (arg_pItem->sequence != arg_sequence) return 0;
+    for (int i = 0; i < WORDS; i++) {
+        if (arg_pItem->words[i] != arg_sequence * 2654435761u + i) return 0;
+    }
+    return 1;
+}
+
+/* writes in the buffer given by the mailbox and gets preempted in the middle of one item in eight */
+static void* torn_writer(void* arg)
+{
+    unsigned seed = 1;
+    uint32_t sequence = 0;
+
+    host_freertos_task();
+    while (!stop) {
+        item_t* item;
+
+        SERVICE_RTOS_GetMailboxWriteBuffer((void**)&item, &mailbox);
+        sequence++;
+        for (int i = 0; i < WORDS; i++) {
+            item->words[i] = sequence * 2654435761u + i;
+            if (i == WORDS / 2 && 0 == (rand_r(&seed) & 7)) sched_yield();
+        }
+        item->sequence = sequence;
+        SERVICE_RTOS_PublishMailbox(&mailbox);
+    }
+    published = sequence;
+    return NULL;
+}
+
+static void torn_items(void)
+{
+    pthread_t writer;
+    uint64_t reads = 0, torn = 0, torn_held = 0, backwards = 0, overwritten = 0;
+    uint64_t end = now_ns() + (uint64_t)(TORN_SECONDS * 1e9);
+    uint32_t last = 0;
+
+    create();
+    host_freertos_task();
+    stop = 0;
+    pthread_create(&writer, NULL, torn_writer, NULL);
+    while (now_ns() < end) {
+        item_t* item;
+        uint32_t sequence;
+
+        if (SERVICE_RTOS_STAT_OK != SERVICE_RTOS_ReadFromMailbox((void**)&item, &mailbox, &sequence)) continue;
+        reads++;
+        if (sequence <= last) backwards++;
+        else overwritten += sequence - last - 1;
+        last = sequence;
+        torn += !intact(item, sequence);
+        /* the item stays the reader's until its next read, the writer must not touch it meanwhile */
+        if (0 == (reads & 3)) {
+            sched_yield();
+            torn_held += !intact(item, sequence);
+        }
+    }
+    stop = 1;
+    pthread_join(writer, NULL);
+
+    printf("rtos_mailbox_test: %u published, %llu read (%llu overwritten), %llu torn, %llu torn while held, %llu out of order\n",
+           published, (unsigned long long)reads, (unsigned long long)overwritten, (unsigned long long)torn,
+           (unsigned long long)torn_held, (unsigned long long)backwards);
+    CHECK(reads > 0 && torn == 0 && torn_held == 0 && backwards == 0, "torn or out of order items");
+}
+
+/* ---------------------------------------------------------------- wake ups */
+
+static volatile uint32_t acknowledged;
+static uint32_t reader_timeouts;
+
+static void* wakeup_reader(void* arg)
+{
+    host_freertos_task();
+    while (acknowledged < WAKEUPS) {
+        item_t* item;
+        uint32_t sequence;
+
+        if (SERVICE_RTOS_STAT_OK == SERVICE_RTOS_WaitForMailbox(1000, (void**)&item, &mailbox, &sequence))
+            __atomic_store_n(&acknowledged, sequence, __ATOMIC_RELEASE);
+        else
+            reader_timeouts++;
+    }
+    return NULL;
+}
+
+/* one item at a time, published while the reader sleeps or while it's still checking the previous one */
+static void wakeups(void)
+{
+    pthread_t reader;
+    uint32_t lost = 0;
+    uint64_t worst = 0;
+
+    create();
+    host_freertos_task();
+    acknowledged = 0;
+    reader_timeouts = 0;
+    pthread_create(&reader, NULL, wakeup_reader, NULL);
+    for (uint32_t s = 1; s <= WAKEUPS; s++) {
+        item_t* item;
+        uint64_t start;
+
+        SERVICE_RTOS_GetMailboxWriteBuffer((void**)&item, &mailbox);
+        item->sequence = s;
+        start = now_ns();
+        SERVICE_RTOS_PublishMailbox(&mailbox);
+        if (s & 1) sched_yield();
+        while (__atomic_load_n(&acknowledged, __ATOMIC_ACQUIRE) != s) {
+            if (now_ns() - start > 100000000ULL) {
+                lost++;
+                break;
+            }
+            sched_yield();
+        }
+        if (now_ns() - start > worst) worst = now_ns() - start;
+    }
+    acknowledged = WAKEUPS;
+    pthread_join(reader, NULL);
+
+    printf("rtos_mailbox_test: %d items handed one by one, %u lost wake ups, %u reader timeouts, worst handoff %.1f us\n",
+           WAKEUPS, lost, reader_timeouts, worst / 1e3);
+    CHECK(lost == 0 && reader_timeouts == 0, "lost wake ups");
+}
+
+/* ---------------------------------------------------------------- age of the items */
+
+static int use_mailbox;
+static uint64_t work_ns;
+static uint64_t ages[AGE_ITEMS];
+static int age_count;
+
+/* an item every ms, a late writer drops the periods it missed instead of writing a burst */
+static void* age_writer(void* arg)
+{
+    item_t local = {0};
+    uint64_t next = now_ns();
+
+    host_freertos_task();
+    for (uint32_t s = 1; s <= AGE_ITEMS; s++) {
+        next += 1000000;
+        if (next < now_ns()) next = now_ns();
+        while (now_ns() < next) sleep_ns(20000);
+        if (use_mailbox) {
+            item_t* item;
+
+            SERVICE_RTOS_GetMailboxWriteBuffer((void**)&item, &mailbox);
+            item->sequence = s;
+            item->stampNS = now_ns();
+            SERVICE_RTOS_PublishMailbox(&mailbox);
+        } else {
+            local.sequence = s;
+            local.stampNS = now_ns();
+            SERVICE_RTOS_AppendToBlockingQueue(0, &local, queue);
+        }
+    }
+    stop = 1;
+    return NULL;
+}
+
+static void* age_reader(void* arg)
+{
+    item_t local;
+    uint8_t remaining = 0;
+
+    host_freertos_task();
+    age_count = 0;
+    /* the items left in the queue when the writer is done are read too */
+    while (1) {
+        item_t* item = &local;
+        uint32_t sequence;
+        SERVICE_RTOS_ErrStat_t status;
+
+        if (use_mailbox) status = SERVICE_RTOS_WaitForMailbox(20, (void**)&item, &mailbox, &sequence);
+        else status = SERVICE_RTOS_ReadFromBlockingQueue(20, &local, queue, &remaining);
+        if (SERVICE_RTOS_STAT_OK != status) {
+            if (stop) break;
+            continue;
+        }
+        if (age_count < AGE_ITEMS) ages[age_count++] = now_ns() - item->stampNS;
+        if (work_ns) sleep_ns(work_ns);
+    }
+    return NULL;
+}
+
+/* the median age in us */
+static double age(const char* arg_name, int arg_mailbox, uint64_t arg_workNS)
+{
+    pthread_t writer, reader;
+
+    use_mailbox = arg_mailbox;
+    work_ns = arg_workNS;
+    stop = 0;
+    create();
+    SERVICE_RTOS_CreateBlockingQueue(30, sizeof(item_t), &queue);
+    pthread_create(&reader, NULL, age_reader, NULL);
+    sleep_ns(5000000);
+    pthread_create(&writer, NULL, age_writer, NULL);
+    pthread_join(writer, NULL);
+    pthread_join(reader, NULL);
+
+    qsort(ages, age_count, sizeof ages[0], compare);
+    printf("rtos_mailbox_test: %-32s %4d items, age median %8.1f us, p99 %8.1f us\n", arg_name, age_count,
+           ages[age_count / 2] / 1e3, ages[(age_count * 99) / 100] / 1e3);
+    return ages[age_count / 2] / 1e3;
+}
+
+int main(void)
+{
+    double queue_fast, mailbox_fast, queue_slow, mailbox_slow;
+
+    torn_items();
+    wakeups();
+    queue_fast = age("queue, fast reader", 0, 0);
+    mailbox_fast = age("mailbox, fast reader", 1, 0);
+    queue_slow = age("queue, reader taking 1.5 ms", 0, 1500000);
+    mailbox_slow = age("mailbox, reader taking 1.5 ms", 1, 1500000);
+
+    /* a slow reader goes through a full queue of old items, the mailbox gives it the newest one */
+    CHECK(mailbox_fast < 1000 && queue_fast < 1000, "fast reader got items of %.1f and %.1f us", queue_fast, mailbox_fast);
+    CHECK(mailbox_slow < 2000 && queue_slow > 10 * mailbox_slow, "slow reader got items of %.1f us from the mailbox, %.1f from the queue",
+          mailbox_slow, queue_slow);
+
+    if (global_failures) {
+        printf("rtos_mailbox_test: %d failures\n", global_failures);
+        return 1;
+    }
+    printf("rtos_mailbox_test: OK\n");
+    return 0;
+}
@@ -0,0 +1,296 @@
+/*
+ * spi_engine_sim: runs the DMA driven SPI1 engine (MCAL_SPI.c) and the ADXL345 register accesses on it against a model
+ * of the two DMA channels, the SPI shift register and two slaves with their chip selects. one model step moves one
+ * byte, the transfer complete interrupt is taken after a random latency
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "MCAL_SPI.h"
+#include "ADXL345_header.h"
+#include "ADXL345_private.h"
+#include "ADXL345_reg.h"
+
+/* the channels are memory mapped registers on the target, the module is included to point them to the model */
+static DMA_Channel_TypeDef sim_dma_rx, sim_dma_tx;
+#undef MCAL_SPI_DMA_RX_CHANNEL
+#undef MCAL_SPI_DMA_TX_CHANNEL
+#define MCAL_SPI_DMA_RX_CHANNEL (&sim_dma_rx)
+#define MCAL_SPI_DMA_TX_CHANNEL (&sim_dma_tx)
+#include "MCAL_SPI.c"
+
+#define FAIL(...) do { printf("spi_engine_sim: FAIL line %d: ", __LINE__); printf(__VA_ARGS__); printf("\n"); exit(1); } while (0)
+
+#define STEPS_PER_MS    (70)        /* one byte takes 14.2 us at 562.5 kHz */
+
+/* ---------------------------------------------------------------- slaves */
+
+/* slave 0 is an ADXL345 register file, slave 1 answers each byte with its complement */
+static GPIO_TypeDef* const sim_cs_port[2] = {(GPIO_TypeDef*)0x1000, (GPIO_TypeDef*)0x2000};
+static MCAL_CONFIG_SPI_t sim_device[2];
+static int cs_low[2], cs_cycles[2], slave_byte[2];
+static uint8_t adxl_regs[64], adxl_command;
+
+static uint8_t slave_exchange(int slave, uint8_t mosi)
+{
+    uint8_t miso = 0xFF;
+
+    if (slave == 1) {
+        miso = (uint8_t)~mosi;
+    } else if (slave_byte[0] == 0) {
+        adxl_command = mosi;
+    } else {
+        /* the register increments after each byte only with the multiple byte bit */
+        uint8_t reg = (adxl_command & 0x3F) + ((adxl_command & 0x40) ? slave_byte[0] - 1 : 0);
+        if (reg >= 64) FAIL("ADXL345 register 0x%02X out of the map", reg);
+        if (!(adxl_command & 0x40) && slave_byte[0] > 1) FAIL("single byte access of %d bytes", slave_byte[0] + 1);
+        if (adxl_command & 0x80) miso = adxl_regs[reg];
+        else adxl_regs[reg] = mosi;
+    }
+    slave_byte[slave]++;
+    return miso;
+}
+
+static int selected_slave(void)
+{
+    if (cs_low[0] && cs_low[1]) FAIL("both chip selects low");
+    return cs_low[0] ? 0 : (cs_low[1] ? 1 : -1);
+}
+
+void GPIO_ResetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+    for (int i = 0; i < 2; i++) {
+        if (GPIOx == sim_cs_port[i] && !cs_low[i]) {
+            cs_low[i] = 1;
+            cs_cycles[i]++;
+            slave_byte[i] = 0;
+        }
+    }
+}
+
+void GPIO_SetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+    for (int i = 0; i < 2; i++) {
+        if (GPIOx == sim_cs_port[i]) cs_low[i] = 0;
+    }
+}
+
+/* ---------------------------------------------------------------- DMA and SPI model */
+
+static int dma_enabled[2], dma_it_tc, dma_it_te, dma_flags, stuck, inject_error;
+static int stale_byte;      /* a byte left in DR by a polled transfer */
+static unsigned rx_index;
+
+void NVIC_Init(NVIC_InitTypeDef* NVIC_InitStruct) { }
+void DMA_DeInit(DMA_Channel_TypeDef* DMAy_Channelx) { memset(DMAy_Channelx, 0, sizeof *DMAy_Channelx); }
+void DMA_Init(DMA_Channel_TypeDef* DMAy_Channelx, DMA_InitTypeDef* DMA_InitStruct) { DMAy_Channelx->CFGR = DMA_InitStruct->DMA_MemoryInc; }
+void SPI_I2S_DMACmd(SPI_TypeDef* SPIx, uint16_t SPI_I2S_DMAReq, FunctionalState NewState) { }
+void DMA_ClearITPendingBit(uint32_t DMAy_IT) { if (DMAy_IT & DMA1_IT_GL2) dma_flags = 0; }
+ITStatus DMA_GetITStatus(uint32_t DMAy_IT) { return (dma_flags & DMAy_IT) ? SET : RESET; }
+uint16_t SPI_I2S_ReceiveData(SPI_TypeDef* SPIx) { stale_byte = 0; return 0; }
+
+void DMA_ITConfig(DMA_Channel_TypeDef* DMAy_Channelx, uint32_t DMA_IT, FunctionalState NewState)
+{
+    if (DMAy_Channelx != &sim_dma_rx) FAIL("interrupt enabled on the TX channel");
+    dma_it_tc = (DMA_IT & DMA_IT_TC) && NewState;
+    dma_it_te = (DMA_IT & DMA_IT_TE) && NewState;
+}
+
+void DMA_Cmd(DMA_Channel_TypeDef* DMAy_Channelx, FunctionalState NewState)
+{
+    int channel = (DMAy_Channelx == &sim_dma_tx);
+    dma_enabled[channel] = NewState;
+    if (NewState && !channel) rx_index = 0;
+    if (NewState && channel && sim_dma_rx.CNTR != sim_dma_tx.CNTR) FAIL("RX and TX lengths differ");
+}
+
+/* the channels only hold the low 32 bits of the host addresses, they are checked against the transaction on the bus */
+static const uint8_t* tx_source(void)
+{
+    const uint8_t* expected = global_SPICurrent_t->txData ? global_SPICurrent_t->txData : &global_u8SPIZeroTx;
+    if (sim_dma_tx.MADDR != (uint32_t)(uintptr_t)expected) FAIL("TX channel doesn't point to the transaction data");
+    if (!(sim_dma_tx.CFGR & DMA_MemoryInc_Enable) != !global_SPICurrent_t->txData) FAIL("TX memory increment");
+    return expected;
+}
+
+static uint8_t* rx_destination(void)
+{
+    uint8_t* expected = global_SPICurrent_t->rxData ? global_SPICurrent_t->rxData : (uint8_t*)&global_u8SPIDummyRx;
+    if (sim_dma_rx.MADDR != (uint32_t)(uintptr_t)expected) FAIL("RX channel doesn't point to the transaction buffer");
+    if (!(sim_dma_rx.CFGR & DMA_MemoryInc_Enable) != !global_SPICurrent_t->rxData) FAIL("RX memory increment");
+    return expected;
+}
+
+/* one byte on the bus when both channels run */
+static void hw_step(void)
+{
+    if (!dma_enabled[0] || !dma_enabled[1] || stuck || sim_dma_rx.CNTR == 0) return;
+
+    if (inject_error && rx_index == 2) {
+        inject_error = 0;
+        dma_flags |= DMA1_IT_TE2 | DMA1_IT_GL2;
+        dma_enabled[0] = 0;
+        return;
+    }
+
+    int slave = selected_slave();
+    if (slave < 0) FAIL("clock without a chip select");
+    if (stale_byte) FAIL("a stale byte in DR was taken as received");
+
+    const uint8_t* tx = tx_source();
+    uint8_t* rx = rx_destination();
+    unsigned step = (sim_dma_tx.CFGR & DMA_MemoryInc_Enable) ? rx_index : 0;
+    uint8_t miso = slave_exchange(slave, tx[step]);
+
+    rx[(sim_dma_rx.CFGR & DMA_MemoryInc_Enable) ? rx_index : 0] = miso;
+    rx_index++;
+    sim_dma_tx.CNTR--;
+    if (--sim_dma_rx.CNTR == 0) dma_flags |= DMA1_IT_TC2 | DMA1_IT_GL2;
+}
+
+/* ---------------------------------------------------------------- RTOS model */
+
+static uint64_t sim_steps;
+static int notified, in_critical;
+
+static void sim_step(void)
+{
+    sim_steps++;
+    hw_step();
+    if (!in_critical && (rand() % 4) == 0) {
+        if ((dma_it_tc && (dma_flags & DMA1_IT_TC2)) || (dma_it_te && (dma_flags & DMA1_IT_TE2))) DMA1_Channel2_IRQHandler();
+    }
+}
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_EnterCritical(void) { in_critical++; return SERVICE_RTOS_STAT_OK; }
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ExitCritical(void) { in_critical--; return SERVICE_RTOS_STAT_OK; }
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_Notify(RTOS_TaskHandle_t arg_TaskToNotify_t, uint8_t arg_u8IsFromISR) { notified++; return SERVICE_RTOS_STAT_OK; }
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentMSTime(uint32_t* arg_pu32CurrentTime)
+{
+    *arg_pu32CurrentTime = (uint32_t)(sim_steps / STEPS_PER_MS);
+    return SERVICE_RTOS_STAT_OK;
+}
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_WaitForNotification(uint32_t arg_u32TimeoutMS)
+{
+    uint64_t end = sim_steps + (uint64_t)arg_u32TimeoutMS * STEPS_PER_MS + 1;
+    while (!notified && sim_steps < end) sim_step();
+    if (notified) notified--;
+    return SERVICE_RTOS_STAT_OK;
+}
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_GetCurrentTaskHandle(RTOS_TaskHandle_t* arg_pTaskHandle)
+{
+    *arg_pTaskHandle = (RTOS_TaskHandle_t)0x1234;
+    return SERVICE_RTOS_STAT_OK;
+}
+
+/* ---------------------------------------------------------------- test */
+
+static void check_idle(const char* after)
+{
+    for (int i = 0; i < 20; i++) sim_step();
+    if (cs_low[0] || cs_low[1]) FAIL("chip select left low after %s", after);
+    if (global_SPICurrent_t || global_u8SPIQueueCount) FAIL("engine not idle after %s", after);
+}
+
+int main(void)
+{
+    MCAL_SPI_Stats_t stats;
+
+    for (int i = 0; i < 2; i++) {
+        sim_device[i].SPI = MCAL_SPI_PERIPHERAL;
+        sim_device[i].GPIO = sim_cs_port[i];
+        sim_device[i].SlavePin = GPIO_Pin_4;
+    }
+    MCAL_SPI_Init();
+
+    for (int seed = 1; seed <= 200; seed++) {
+        srand(seed);
+
+        /* ADXL345 register accesses, each one is a single chip select cycle */
+        uint8_t offsets[3] = {(uint8_t)rand(), (uint8_t)rand(), (uint8_t)rand()};
+        int cycles = cs_cycles[0];
+        HAL_ADXL345_Write_Mutliple(&sim_device[0], HAL_ADXL345_REG_OFSX, offsets, 3);
+        if (cs_cycles[0] - cycles != 1) FAIL("multiple write took %d chip select cycles", cs_cycles[0] - cycles);
+        if (memcmp(&adxl_regs[HAL_ADXL345_REG_OFSX], offsets, 3)) FAIL("multiple write landed wrong (seed %d)", seed);
+        if (adxl_regs[HAL_ADXL345_REG_OFSX + 3]) FAIL("multiple write went past its length");
+
+        uint8_t value = (uint8_t)rand();
+        HAL_ADXL345_Write_Single(&sim_device[0], HAL_ADXL345_REG_BW_RATE, value);
+        if (adxl_regs[HAL_ADXL345_REG_BW_RATE] != value) FAIL("single write");
+        adxl_regs[HAL_ADXL345_REG_DEVID] = 0xE5;
+        if (HAL_ADXL345_Read_Single(&sim_device[0], HAL_ADXL345_REG_DEVID) != 0xE5) FAIL("single read");
+
+        HAL_ADXL345_Acc_t acc;
+        int16_t x = (int16_t)rand(), y = (int16_t)rand(), z = (int16_t)rand();
+        memcpy(&adxl_regs[HAL_ADXL345_REG_DATAX0], &x, 2);
+        memcpy(&adxl_regs[HAL_ADXL345_REG_DATAX0 + 2], &y, 2);
+        memcpy(&adxl_regs[HAL_ADXL345_REG_DATAX0 + 4], &z, 2);
+        HAL_ADXL345_ReadAcc(&sim_device[0], &acc);
+        if (acc.x != x || acc.y != y || acc.z != z) FAIL("acceleration burst (seed %d)", seed);
+        check_idle("the ADXL345 accesses");
+
+        /* queued transactions on both slaves finish in order, with a NULL buffer on either side */
+        uint8_t tx[4][8], rx[4][8];
+        MCAL_SPI_Transaction_t queued[5];
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 8; j++) tx[i][j] = (uint8_t)rand();
+            memset(rx[i], 0xAA, sizeof rx[i]);
+            MCAL_SPI_Transaction_t t = {&sim_device[1], i == 2 ? NULL : tx[i], i == 3 ? NULL : rx[i], (uint16_t)(1 + i * 2), (RTOS_TaskHandle_t)1, 0};
+            queued[i] = t;
+            if (MCAL_SPI_Submit(&queued[i]) != MCAL_SPI_STAT_OK) FAIL("submit %d", i);
+        }
+        queued[4] = queued[0];
+        if (MCAL_SPI_Submit(&queued[4]) != MCAL_SPI_STAT_QUEUE_FULL) FAIL("queue full not reported");
+        for (int i = 0; i < 4; i++) {
+            if (MCAL_SPI_Wait(&queued[i], 10) != MCAL_SPI_STAT_OK) FAIL("queued transaction %d (seed %d)", i, seed);
+            for (int j = 0; j < queued[i].dataLen && queued[i].rxData; j++) {
+                uint8_t expected = queued[i].txData ? (uint8_t)~tx[i][j] : 0xFF;
+                if (rx[i][j] != expected) FAIL("byte %d of queued transaction %d", j, i);
+            }
+            if (queued[i].rxData && rx[i][queued[i].dataLen] != 0xAA) FAIL("transaction %d wrote past its length", i);
+        }
+        check_idle("the queued transactions");
+    }
+
+    /* a polled transfer left a byte in DR, it must not be taken as the first received byte */
+    {
+        uint8_t data[2] = {0x80 | HAL_ADXL345_REG_DEVID, 0};
+        stale_byte = 1;
+        if (MCAL_SPI_Transfer(&sim_device[0], data, data, 2, 10) != MCAL_SPI_STAT_OK || data[1] != 0xE5) FAIL("read after a polled transfer");
+    }
+
+    /* the bus stops moving: the transaction times out, the chip select is released and the next one runs */
+    {
+        uint8_t a[4] = {1, 2, 3, 4}, b[4] = {5, 6, 7, 8}, rb[4];
+        MCAL_SPI_Transaction_t first = {&sim_device[1], a, NULL, 4, (RTOS_TaskHandle_t)1, 0};
+        MCAL_SPI_Transaction_t second = {&sim_device[1], b, rb, 4, (RTOS_TaskHandle_t)1, 0};
+
+        stuck = 1;
+        MCAL_SPI_Submit(&first);
+        MCAL_SPI_Submit(&second);
+        if (MCAL_SPI_Wait(&first, 5) != MCAL_SPI_STAT_TIMEOUT) FAIL("timeout not reported");
+        stuck = 0;
+        if (MCAL_SPI_Wait(&second, 10) != MCAL_SPI_STAT_OK || rb[0] != (5 ^ 0xFF)) FAIL("transaction after a timeout");
+        check_idle("a timeout");
+    }
+
+    /* DMA transfer error */
+    {
+        uint8_t a[6] = {0};
+        inject_error = 1;
+        if (MCAL_SPI_Transfer(&sim_device[1], a, a, 6, 10) != MCAL_SPI_STAT_DMA_ERR) FAIL("DMA error not reported");
+        check_idle("a DMA error");
+        if (MCAL_SPI_Transfer(&sim_device[1], a, a, 6, 10) != MCAL_SPI_STAT_OK) FAIL("transfer after a DMA error");
+    }
+
+    MCAL_SPI_GetStats(&stats);
+    printf("spi_engine_sim: completed %u (%u bytes), dma errors %u, timeouts %u, chip select cycles %d + %d\n",
+           (unsigned)stats.completed, (unsigned)stats.bytes, (unsigned)stats.dmaErrors, (unsigned)stats.timeouts,
+           cs_cycles[0], cs_cycles[1]);
+    printf("spi_engine_sim: OK\n");
+    return 0;
+}
@@ -0,0 +1,268 @@
+/*
+ * uart_rx_sim: runs the DMA receiver of UART4 (MCAL_UART.c) and the receive loop of the drone board communication task
+ * against a model of the line, the circular DMA channel and the task notification. one model step is one micro second,
+ * a byte takes 87 steps on the line (115200 baud) and the app board sends COBS framed move commands.
+ *
+ * the polling communication task it replaces never blocked, it was always ready above the idle task so the idle share
+ * was 0 by construction. the model measures what the task costs now that it sleeps on the notification: the wake ups
+ * and interrupts per second and the host time spent in the interrupts and the receive loop
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "MCAL_UART.h"
+#include "Service_RTOS_wrapper.h"
+#include "comm_frame.h"
+#include "comm_pack.h"
+
+/* the peripheral and the channels are memory mapped registers on the target, the module is included to point them to the model */
+static USART_TypeDef sim_uart;
+static DMA_Channel_TypeDef sim_dma_rx, sim_dma_tx;
+#undef MCAL_UART_PERIPHERAL
+#undef MCAL_UART_DMA_RX_CHANNEL
+#undef MCAL_UART_DMA_TX_CHANNEL
+#define MCAL_UART_PERIPHERAL        (&sim_uart)
+#define MCAL_UART_DMA_RX_CHANNEL    (&sim_dma_rx)
+#define MCAL_UART_DMA_TX_CHANNEL    (&sim_dma_tx)
+#include "MCAL_UART.c"
+
+#define FAIL(...) do { printf("uart_rx_sim: FAIL line %d: ", __LINE__); printf(__VA_ARGS__); printf("\n"); exit(1); } while (0)
+
+#define BYTE_STEPS      (87)        /* 10 bits at 115200 baud */
+#define CHUNK_LEN       (32)        /* APP_COMM_REC_CHUNK_LEN of the drone board */
+#define MOVE_PERIOD     (10000)     /* a move command every 10 ms */
+#define MAX_LATENCY     (500)       /* the higher priority tasks delay the woken task by up to this */
+
+/* phases of the run in seconds: commands at their period, frames back to back, back to back with the task held */
+#define NORMAL_END      (5)
+#define BURST_END       (7)
+#define STARVED_AT      (7500000)
+#define STARVED_STEPS   (30000)
+#define RUN_END         (8)
+
+/* ---------------------------------------------------------------- RTOS */
+
+static int notified, in_critical;
+static uint32_t now_us;
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_EnterCritical(void) { in_critical++; return SERVICE_RTOS_STAT_OK; }
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_ExitCritical(void) { in_critical--; return SERVICE_RTOS_STAT_OK; }
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_CurrentUSTime(uint32_t* arg_pu32CurrentTime) { *arg_pu32CurrentTime = now_us; return SERVICE_RTOS_STAT_OK; }
+
+SERVICE_RTOS_ErrStat_t SERVICE_RTOS_Notify(RTOS_TaskHandle_t arg_TaskToNotify_t, uint8_t arg_u8IsFromISR)
+{
+    if (arg_TaskToNotify_t != (RTOS_TaskHandle_t)1) FAIL("notified another task");
+    if (!arg_u8IsFromISR) FAIL("notified as from a task");
+    notified = 1;
+    return SERVICE_RTOS_STAT_OK;
+}
+
+/* ---------------------------------------------------------------- UART and DMA model */
+
+static int dma_it, dma_flags;
+static unsigned isr_count;
+static double isr_seconds;
+
+void NVIC_Init(NVIC_InitTypeDef* NVIC_InitStruct) { }
+void USART_DMACmd(USART_TypeDef* USARTx, uint16_t USART_DMAReq, FunctionalState NewState) { }
+void USART_ITConfig(USART_TypeDef* USARTx, uint16_t USART_IT, FunctionalState NewState) { }
+void DMA_DeInit(DMA_Channel_TypeDef* DMAy_Channelx) { memset(DMAy_Channelx, 0, sizeof *DMAy_Channelx); }
+void DMA_Init(DMA_Channel_TypeDef* DMAy_Channelx, DMA_InitTypeDef* DMA_InitStruct) { DMAy_Channelx->CNTR = DMA_InitStruct->DMA_BufferSize; }
+void DMA_Cmd(DMA_Channel_TypeDef* DMAy_Channelx, FunctionalState NewState) { }
+void DMA_ClearITPendingBit(uint32_t DMAy_IT) { dma_flags &= ~DMAy_IT; }
+ITStatus DMA_GetITStatus(uint32_t DMAy_IT) { return (dma_flags & DMAy_IT) ? SET : RESET; }
+uint16_t DMA_GetCurrDataCounter(DMA_Channel_TypeDef* DMAy_Channelx) { return (uint16_t)DMAy_Channelx->CNTR; }
+
+void DMA_ITConfig(DMA_Channel_TypeDef* DMAy_Channelx, uint32_t DMA_IT, FunctionalState NewState)
+{
+    if (DMAy_Channelx == &sim_dma_rx) dma_it = NewState ? (int)DMA_IT : 0;
+}
+
+static double host_seconds(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void run_isr(void (*handler)(void))
+{
+    double start = host_seconds();
+    handler();
+    isr_seconds += host_seconds() - start;
+    isr_count++;
+}
+
+/* the DMA writes at the position given by its counter, the half and full buffer flags raise its interrupt */
+static void line_byte(uint8_t byte)
+{
+    global_u8UARTRxRing[MCAL_UART_RX_RING_LEN - sim_dma_rx.CNTR] = byte;
+    if (--sim_dma_rx.CNTR == 0) {
+        sim_dma_rx.CNTR = MCAL_UART_RX_RING_LEN;
+        if (dma_it & DMA_IT_TC) dma_flags |= MCAL_UART_DMA_RX_IT_TC;
+    } else if (sim_dma_rx.CNTR == MCAL_UART_RX_RING_LEN / 2 && (dma_it & DMA_IT_HT)) {
+        dma_flags |= MCAL_UART_DMA_RX_IT_HT;
+    }
+    if (dma_flags) {
+        run_isr(DMA1_Channel8_IRQHandler);
+        if (dma_flags) FAIL("DMA flags 0x%x left set by the handler", dma_flags);
+    }
+}
+
+/* the handler reads STATR then DATAR which clears the flag on the target, the model clears it after the handler */
+static void line_idle(void)
+{
+    sim_uart.STATR |= USART_FLAG_IDLE;
+    run_isr(UART4_IRQHandler);
+    sim_uart.STATR &= ~USART_FLAG_IDLE;
+}
+
+/* ---------------------------------------------------------------- app board */
+
+static uint8_t line[1 << 12];
+static unsigned line_head, line_tail;
+static LIB_COMM_PACK_Move_t sent[256];      /* by sequence number */
+static unsigned sent_count;
+static uint8_t tx_seq;
+
+static void send_move(void)
+{
+    uint8_t payload[LIB_COMM_PACK_MOVE_LEN], frame[LIB_COMM_FRAME_ENCODED_LEN(LIB_COMM_PACK_MOVE_LEN)];
+    LIB_COMM_PACK_Move_t* move = &sent[tx_seq];
+    uint16_t len;
+
+    move->roll = (rand() % 6001 - 3000) / 100.0f;
+    move->pitch = (rand() % 6001 - 3000) / 100.0f;
+    move->thrust = (rand() % 10001) / 100.0f;
+    move->yaw = (rand() % 36001 - 18000) / 100.0f;
+    move->flags = (uint8_t)(rand() & LIB_COMM_PACK_FLAG_START);
+
+    len = LIB_COMM_FRAME_u16Encode(tx_seq++, payload, LIB_COMM_PACK_u8PackMove(move, payload), frame);
+    for (uint16_t i = 0; i < len; i++) line[line_head++ % sizeof line] = frame[i];
+    sent_count++;
+}
+
+/* ---------------------------------------------------------------- communication task */
+
+static LIB_COMM_FRAME_Decoder_t decoder;
+static unsigned wakeups, received;
+static double task_seconds;
+
+/* the receive loop of UARTReceivedFrames in the drone board main.c, each move is checked against the one sent */
+static void task_receive(void)
+{
+    uint8_t chunk[CHUNK_LEN];
+    uint16_t chunk_len = 0, payload_len = 0;
+    const uint8_t* payload;
+    LIB_COMM_PACK_Move_t move;
+    double start = host_seconds();
+
+    wakeups++;
+    while (MCAL_UART_STAT_OK == MCAL_UART_Read(chunk, sizeof chunk, &chunk_len)) {
+        for (uint16_t i = 0; i < chunk_len; i++) {
+            if (0 == LIB_COMM_FRAME_u8Decode(&decoder, chunk[i])) continue;
+            payload = LIB_COMM_FRAME_pu8Payload(&decoder, &payload_len);
+            if (0 == LIB_COMM_PACK_u8UnpackMove(payload, payload_len, &move)) FAIL("a frame that isn't a move");
+
+            const LIB_COMM_PACK_Move_t* expected = &sent[decoder.lastSeq];
+            if (move.flags != expected->flags || fabsf(move.roll - expected->roll) > 0.006f || fabsf(move.pitch - expected->pitch) > 0.006f ||
+                fabsf(move.thrust - expected->thrust) > 0.006f || fabsf(move.yaw - expected->yaw) > 0.006f)
+                FAIL("move %u received wrong", decoder.lastSeq);
+            received++;
+        }
+    }
+    task_seconds += host_seconds() - start;
+}
+
+/* ---------------------------------------------------------------- run */
+
+typedef struct {
+    unsigned wakeups, interrupts, frames, bytes;
+    double host_seconds;
+} window_t;
+
+static window_t snapshot(void)
+{
+    window_t w = {wakeups, isr_count, received, global_UARTStats_t.bytes, isr_seconds + task_seconds};
+    return w;
+}
+
+int main(void)
+{
+    uint32_t next_move = 0, byte_end = 0, ready_at = 0;
+    int task_pending = 0, idle_armed = 0;
+    unsigned lost_frames_before = 0;
+    window_t start, normal = {0}, burst = {0};
+    MCAL_UART_Stats_t stats;
+
+    srand(13);
+    LIB_COMM_FRAME_vidDecoderInit(&decoder);
+    MCAL_UART_Init();
+    MCAL_UART_SetRxTask((RTOS_TaskHandle_t)1);
+    if (!(dma_it & DMA_IT_HT) || !(dma_it & DMA_IT_TC)) FAIL("half and full buffer interrupts not enabled");
+
+    start = snapshot();
+    for (now_us = 0; now_us < RUN_END * 1000000u; now_us++) {
+        int burst_phase = now_us >= NORMAL_END * 1000000u;
+
+        if (now_us == NORMAL_END * 1000000u) normal = snapshot();
+        if (now_us == BURST_END * 1000000u) {
+            burst = snapshot();
+            lost_frames_before = decoder.stats.lostFrames;
+        }
+
+        /* the app board queues a command at its period, or the next one as soon as the line is free */
+        if ((!burst_phase && now_us >= next_move) || (burst_phase && line_head == line_tail)) {
+            send_move();
+            next_move += MOVE_PERIOD;
+        }
+
+        /* one byte every byte time while there is something to send, the idle line after a byte time without one */
+        if (now_us >= byte_end) {
+            if (line_head != line_tail) {
+                line_byte(line[line_tail++ % sizeof line]);
+                byte_end = now_us + BYTE_STEPS;
+                idle_armed = 1;
+            } else if (idle_armed) {
+                line_idle();
+                idle_armed = 0;
+            }
+        }
+
+        /* a notification makes the task ready, it runs once the higher priority tasks let it */
+        if (notified && !task_pending) {
+            notified = 0;
+            task_pending = 1;
+            ready_at = now_us + rand() % MAX_LATENCY;
+            if (now_us >= STARVED_AT && now_us < STARVED_AT + STARVED_STEPS) ready_at = STARVED_AT + STARVED_STEPS;
+        }
+        if (task_pending && now_us >= ready_at) {
+            task_pending = 0;
+            task_receive();
+        }
+    }
+    if (in_critical) FAIL("critical section left open");
+
+    /* the last frame may still be on the line */
+    MCAL_UART_GetRxStats(&stats);
+    if (normal.frames - start.frames != NORMAL_END * 1000000u / MOVE_PERIOD) FAIL("%u of %u commands received", normal.frames, NORMAL_END * 1000000u / MOVE_PERIOD);
+    if (stats.lost == 0 && burst.frames == received) FAIL("the held task didn't overrun the ring");
+    if (lost_frames_before != 0) FAIL("%u frames lost before the task was held", lost_frames_before);
+    if (decoder.stats.lostFrames == 0) FAIL("the overrun didn't cost a frame");
+    if (received < sent_count - decoder.stats.lostFrames - decoder.stats.crcErrors - decoder.stats.formatErrors - decoder.stats.overflows - 2)
+        FAIL("frames missing after the overrun: received %u of %u", received, sent_count);
+
+    printf("uart_rx_sim: commands every %u ms: %.0f wake ups/s, %.0f interrupts/s, %.1f bytes per wake up, host %.1f us/s in the receive path\n",
+           MOVE_PERIOD / 1000, (normal.wakeups - start.wakeups) / (double)NORMAL_END, (normal.interrupts - start.interrupts) / (double)NORMAL_END,
+           (double)(normal.bytes - start.bytes) / (normal.wakeups - start.wakeups), (normal.host_seconds - start.host_seconds) * 1e6 / NORMAL_END);
+    printf("uart_rx_sim: back to back frames: %.0f wake ups/s, %.0f interrupts/s, %.1f bytes per wake up, host %.1f us/s in the receive path\n",
+           (burst.wakeups - normal.wakeups) / (double)(BURST_END - NORMAL_END), (burst.interrupts - normal.interrupts) / (double)(BURST_END - NORMAL_END),
+           (double)(burst.bytes - normal.bytes) / (burst.wakeups - normal.wakeups), (burst.host_seconds - normal.host_seconds) * 1e6 / (BURST_END - NORMAL_END));
+    printf("uart_rx_sim: task held %u ms: %u bytes lost in the ring, %u frames lost, %u dropped by their CRC, %u of %u frames received\n",
+           STARVED_STEPS / 1000, (unsigned)stats.lost, (unsigned)decoder.stats.lostFrames, (unsigned)decoder.stats.crcErrors, received, sent_count);
+    printf("uart_rx_sim: OK\n");
+    return 0;
+}